@@ -0,0 +1,69 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host tool printing the predicted time of every candidate kernel of 102_dynamic_optimized_matmul.
+// Usage: 102_dynamic_optimized_matmul_cost_model m n k layoutA layoutB [cost model file]
+// No device is needed, the platform is described by the cost model (core_num, l1_size, ...).
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "do_tiling_b16.h"
+#include "select_kernel_b16.h"
+
+int main(int argc, const char **argv)
+{
+    if (argc < 6) {
+        std::cerr << "Usage: " << argv[0] << " m n k layoutA layoutB [cost model file]" << std::endl;
+        return 1;
+    }
+    CostModel costModel;
+    if (argc > 6 && !LoadCostModel(argv[6], costModel)) {
+        return 1;
+    }
+    PlatformInfo platformInfo(costModel);
+
+    uint32_t m = std::atoi(argv[1]);
+    uint32_t n = std::atoi(argv[2]);
+    uint32_t k = std::atoi(argv[3]);
+    LayoutTag layoutTagA = static_cast<LayoutTag>(std::atoi(argv[4]));
+    LayoutTag layoutTagB = static_cast<LayoutTag>(std::atoi(argv[5]));
+    TilingParams tilingParams{m, n, k, layoutTagA, layoutTagB, LayoutTag::TagRowMajor};
+    DoTilingB16[tilingParams.layoutTagA][tilingParams.layoutTagB](tilingParams, platformInfo);
+    std::vector<KernelCandidate> candidates = EstimateKernelCandidates(tilingParams, platformInfo);
+    SelectKernelB16(tilingParams, platformInfo);
+
+    TilingKey &tilingKey = tilingParams.tilingKey;
+    std::cout << "m=" << m << " n=" << n << " k=" << k
+              << " m1=" << tilingParams.m1 << " n1=" << tilingParams.n1 << " k1=" << tilingParams.k1
+              << " splitk=" << tilingParams.splitkFactor << " coreNum=" << platformInfo.coreNum << std::endl;
+    std::cout << std::left << std::setw(26) << "  kernel" << std::right
+              << std::setw(14) << "memory(us)" << std::setw(14) << "compute(us)"
+              << std::setw(14) << "overhead(us)" << std::setw(14) << "predicted(us)" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto &candidate : candidates) {
+        bool selected = candidate.kernelSerial == tilingKey.GetKernelSerial()
+            && candidate.paddingTagA == tilingKey.GetPaddingTagTagA()
+            && candidate.paddingTagB == tilingKey.GetPaddingTagTagB();
+        std::cout << (selected ? "* " : "  ") << std::left << std::setw(24) << candidate.name << std::right
+                  << std::setw(14) << candidate.memoryUs << std::setw(14) << candidate.computeUs
+                  << std::setw(14) << candidate.overheadUs;
+        if (candidate.feasible) {
+            std::cout << std::setw(14) << candidate.predictedUs << std::endl;
+        } else {
+            std::cout << std::setw(14) << "infeasible" << std::endl;
+        }
+    }
+    std::cout << "Selected TilingKey: " << std::hex << tilingKey.value << std::dec
+              << " (paddingTagC " << static_cast<uint32_t>(tilingKey.GetPaddingTagTagC())
+              << ", blockDim " << static_cast<uint32_t>(tilingParams.blockDim) << ")" << std::endl;
+    return 0;
+}
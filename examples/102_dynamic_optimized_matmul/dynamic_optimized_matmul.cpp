@@ -14,11 +14,11 @@
 #include "dynamic_optimized_matmul.h"
 
 void Run(aclrtStream &stream, uint32_t m, uint32_t n, uint32_t k, LayoutTag layoutTagA, LayoutTag layoutTagB,
-    PlatformInfo &platformInfo)
+    PlatformInfo &platformInfo, TilingCache &tilingCache)
 {
     LayoutTag layoutTagC = LayoutTag::TagRowMajor;
     TilingParams tilingParams{m, n, k, layoutTagA, layoutTagB, layoutTagC};
-    DoTilingAndSelectKernel<fp16_t>(tilingParams, platformInfo);
+    DoTilingAndSelectKernel<fp16_t>(tilingParams, platformInfo, tilingCache);
     PrintTilingParams<fp16_t>(tilingParams, platformInfo);
 
     size_t lenA = static_cast<size_t>(m) * k;
@@ -110,14 +110,26 @@ int main(int argc, const char **argv)
     aclrtStream stream;
     ACL_CHECK(aclrtCreateStream(&stream));
 
-    PlatformInfo platformInfo;
+    PlatformInfo platformInfo = GetDevicePlatformInfo();
+
+    // Optional tiling decision file, loaded on start and updated on exit.
+    TilingCache tilingCache;
+    const char *tilingCacheFile = std::getenv("CATLASS_TILING_CACHE_FILE");
+    if (tilingCacheFile != nullptr) {
+        tilingCache.Load(tilingCacheFile, platformInfo);
+    }
 
     uint32_t m = std::atoi(argv[1]);
     uint32_t n = std::atoi(argv[2]);
     uint32_t k = std::atoi(argv[3]);
     LayoutTag layoutTagA = static_cast<LayoutTag>(std::atoi(argv[4]));
     LayoutTag layoutTagB = static_cast<LayoutTag>(std::atoi(argv[5]));
-    Run(stream, m, n, k, layoutTagA, layoutTagB, platformInfo);
+    Run(stream, m, n, k, layoutTagA, layoutTagB, platformInfo, tilingCache);
+
+    PrintTilingCacheStats(tilingCache);
+    if (tilingCacheFile != nullptr && !tilingCache.Save(tilingCacheFile, platformInfo)) {
+        std::cerr << "Save tiling cache file " << tilingCacheFile << " failed." << std::endl;
+    }
 
     ACL_CHECK(aclrtDestroyStream(stream));
     ACL_CHECK(aclrtResetDevice(deviceId));
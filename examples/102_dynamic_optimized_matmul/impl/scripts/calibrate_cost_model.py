@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+# ----------------------------------------------------------------------------
+# This program is free software, you can redistribute it and/or modify.
+# Copyright (c) 2025 Huawei Technologies Co., Ltd.
+# This file is a part of the CANN Open Software.
+# Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+# Please refer to the License for details. You may not use this file except in compliance with the License.
+# THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+# See LICENSE in the root of the software repository for the full text of the License.
+# ----------------------------------------------------------------------------
+
+"""
+Fit the cost model of include/cost_model.h from msTuner profile data.
+
+Usage:
+    python3 calibrate_cost_model.py --core-num 24 --output cost_model.txt results1.csv [results2.csv ...]
+
+Only the keys that can be derived from the CSV are written, the other keys keep the
+defaults of CostModel when the file is loaded through CATLASS_COST_MODEL_FILE.
+"""
+
+import argparse
+import csv
+import math
+import sys
+
+import numpy as np
+
+BYTES_PER_ELEMENT = {"fp16": 2, "bf16": 2}
+# Rows below this count are attenuated by the row curves, keep them out of the d curve fit.
+MIN_FULL_ROWS = 64
+MAX_UNALIGN_DEGREE = 6
+
+
+class ProfileRecord:
+
+    def __init__(self, row):
+        self.duration = float(row["task_duration(us)"])
+        self.m = int(row["m"])
+        self.n = int(row["n"])
+        self.k = int(row["k"])
+        self.dtype_a, self.layout_a = row["A"].split(":")
+        self.dtype_b, self.layout_b = row["B"].split(":")
+        # catlass_{op}_{kernel}_{A}_{B}_{C}_{l1 MxNxK}_{l0 MxNxK}_swizzle{a}x{b}
+        segments = row["description"].split("_")
+        self.m1, self.n1, self.k1 = (int(val) for val in segments[-3].split("x"))
+
+    def is_valid(self):
+        return (self.duration > 0 and self.dtype_a in BYTES_PER_ELEMENT and self.dtype_b in BYTES_PER_ELEMENT
+                and self.layout_a in ("row", "column") and self.layout_b in ("row", "column"))
+
+    def round_max(self, core_num):
+        tasks = math.ceil(self.m / self.m1) * math.ceil(self.n / self.n1)
+        return math.ceil(tasks / core_num)
+
+    def bandwidth(self, core_num):
+        # GB/s of one AIC, same unit as CostModel: time(us) = bytes / band / 1000.
+        actual_m = min(self.m, self.m1)
+        actual_n = min(self.n, self.n1)
+        data_size = self.round_max(core_num) * (actual_m + actual_n) * self.k * BYTES_PER_ELEMENT[self.dtype_a]
+        return data_size / self.duration / 1000
+
+    def tflops(self, core_num):
+        actual_m = min(self.m, self.m1)
+        actual_n = min(self.n, self.n1)
+        flops = 2.0 * self.round_max(core_num) * actual_m * actual_n * self.k
+        return flops / (self.duration * 1e6)
+
+    def a_transfer(self):
+        # (nValue, dValue, srcDValue) of the A tile, as in GetPaddingTag.
+        if self.layout_a == "column":
+            return min(self.k, self.k1), min(self.m, self.m1), self.m
+        return min(self.m, self.m1), min(self.k, self.k1), self.k
+
+
+def load_records(paths):
+    records = []
+    for path in paths:
+        with open(path, newline="") as file:
+            for row in csv.DictReader(file):
+                try:
+                    record = ProfileRecord(row)
+                except (KeyError, ValueError, IndexError):
+                    continue
+                if record.is_valid():
+                    records.append(record)
+    return records
+
+
+def fit_unalign_band(records, core_num):
+    # Best achieved bandwidth per unaligned d, stride alignment boosts are excluded by srcD % 16 != 0.
+    best_band = {}
+    for record in records:
+        n_value, d_value, src_d_value = record.a_transfer()
+        if n_value < MIN_FULL_ROWS or src_d_value % 16 == 0:
+            continue
+        best_band[d_value] = max(best_band.get(d_value, 0.0), record.bandwidth(core_num))
+    if len(best_band) < 4:
+        return None, None
+    d_values = np.array(sorted(best_band), dtype=np.float64)
+    bands = np.array([best_band[d] for d in sorted(best_band)], dtype=np.float64)
+    degree = min(MAX_UNALIGN_DEGREE, len(d_values) - 1)
+    # polyfit returns the highest power first, the model file stores the constant term first.
+    coef = list(reversed(np.polyfit(d_values, bands, degree).tolist()))
+    return coef, float(bands.max())
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Calibrate the dynamic optimized matmul cost model.")
+    parser.add_argument("csv", nargs="+", help="msTuner result csv files")
+    parser.add_argument("--core-num", type=int, required=True, help="number of AIC of the profiled device")
+    parser.add_argument("--l2-size", type=int, default=0, help="L2 cache size in bytes, 0 keeps the default")
+    parser.add_argument("--output", default="cost_model.txt", help="cost model file to write")
+    args = parser.parse_args()
+
+    records = load_records(args.csv)
+    if not records:
+        print("No usable 16 bit matmul record found.", file=sys.stderr)
+        return 1
+
+    lines = [f"# calibrated from {len(records)} records of {', '.join(args.csv)}", f"core_num {args.core_num}"]
+    if args.l2_size > 0:
+        lines.append(f"l2_size {args.l2_size}")
+    unalign_band_coef, max_unalign_band = fit_unalign_band(records, args.core_num)
+    if unalign_band_coef is None:
+        print("Not enough unaligned shapes to fit unalign_band_coef, keep the default.", file=sys.stderr)
+    else:
+        lines.append("unalign_band_coef " + " ".join(f"{coef:.17g}" for coef in unalign_band_coef))
+        lines.append(f"max_unalign_band {max_unalign_band:.17g}")
+    peak_tflops = max(record.tflops(args.core_num) for record in records)
+    lines.append(f"cube_tflops_per_core {peak_tflops:.17g}")
+
+    with open(args.output, "w") as file:
+        file.write("\n".join(lines) + "\n")
+    print(f"Save cost model to {args.output} success")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,276 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef COST_MODEL_H
+#define COST_MODEL_H
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Table-driven performance model used by kernel selection.
+ *
+ * All curves and constants that SelectKernelB16 relies on live here, the defaults are the values fitted
+ * on Atlas A2. A model file (see LoadCostModel) replaces any subset of them, so a new SKU can be calibrated
+ * from msTuner CSV data (impl/scripts/calibrate_cost_model.py) without editing C++.
+ */
+
+// Bandwidth attenuation for short transfers: applied when the inner dimension is a multiple of dAlign
+// and fewer than nLimit rows are moved, factor = sum(coef[i] * rows^i).
+struct RowCurve {
+    uint32_t dAlign;
+    uint32_t nLimit;
+    std::vector<double> coef;
+};
+
+// Bandwidth boost when the source stride is a multiple of srcAlign.
+struct SrcAlignBoost {
+    uint32_t srcAlign;
+    double factor;
+};
+
+struct CostModel {
+    // Optional platform overrides, 0 keeps the value reported by the device.
+    uint32_t coreNum{0};
+    uint64_t ubSize{0};
+    uint64_t l1Size{0};
+    uint64_t l0ASize{0};
+    uint64_t l0BSize{0};
+    uint64_t l0CSize{0};
+
+    // GM->L1 bandwidth of one AIC (GB/s) for an unaligned inner dimension d: sum(unalignBandCoef[i] * d^i).
+    std::vector<double> unalignBandCoef{
+        0.1,
+        0.312849910814454512664184,
+        -0.002146456956750821074703,
+        0.000007301215580838747961,
+        -0.000000006738536427145036,
+        -0.000000000012456944162142,
+        0.000000000000020146121020,
+    };
+    // Contiguous small tiles (d == stride, d <= alignedSmallDMax, d % 16 == 0) reach a fixed bandwidth.
+    double alignedSmallDBand{60};
+    uint32_t alignedSmallDMax{128};
+    // Strides over the DMA stride limit fall back to row-by-row copies.
+    uint64_t strideLimit{65536};
+    double strideLimitBand{1};
+    // Checked in order, the first matching alignment applies.
+    std::vector<SrcAlignBoost> srcAlignBoost{
+        {256, 100.0 / 30},
+        {128, 80.0 / 30},
+        {64, 50.0 / 30},
+        {16, 40.0 / 30},
+    };
+    double maxUnalignBand{80};
+    // Checked in order, the first curve whose dAlign divides d applies; dAlign 1 is the fallback.
+    std::vector<RowCurve> rowCurves{
+        {256, 16, {0.016102868630357251855667, 0.113578920178116271610946, -0.003332381309698882569659}},
+        {32, 32, {0.035130178145161221336945, 0.045309519479127147167929, -0.000298086120946179481978}},
+        {1, 64, {0.003942641759904389614499, 0.038963259596073690493867, -0.000469676727179688081274,
+            0.000001809180573350345869}},
+    };
+
+    // AIC bandwidth of zN data produced by padding, scaled down below paddedFullRows rows.
+    double paddedBand{80};
+    uint32_t paddedFullRows{16};
+    // Per AIV bandwidth of the padding kernels, lower when the matrix does not fit in L2.
+    double aivBand{30};
+    double aivBandOverL2{10};
+    uint64_t l2Size{192ULL * 1024 * 1024};
+    // Launch overhead of the padding kernels (us): base + perCore * blockDim / coreNum.
+    double headCostBase{1};
+    double headCostPerCore{7};
+    double headCostSplitk{1};
+    // Extra overhead (us) when both A and B are padded.
+    double paddingBothExtra{2};
+
+    // Compute roof of one AIC (TFLOPS) for 16 bit inputs, 16x16x16 MACs per cycle at 1.8 GHz.
+    double cubeTflopsPerCore{14.7};
+};
+
+inline double EvalPolynomial(const std::vector<double> &coef, double x)
+{
+    // Evaluated with pow term by term to stay identical to the hand written curves.
+    double result = 0;
+    for (size_t i = coef.size(); i > 0; --i) {
+        size_t power = i - 1;
+        if (power == 0) {
+            result += coef[power];
+        } else if (power == 1) {
+            result += coef[power] * x;
+        } else {
+            result += coef[power] * pow(x, static_cast<double>(power));
+        }
+    }
+    return result;
+}
+
+inline bool ParseDoubles(std::istringstream &ss, std::vector<double> &values)
+{
+    values.clear();
+    double value;
+    while (ss >> value) {
+        values.push_back(value);
+    }
+    return !values.empty();
+}
+
+/**
+ * Load a cost model file. Each non empty line is "<key> <values...>", '#' starts a comment.
+ * Scalar keys replace the default, list keys (src_align_boost, row_curve) replace the whole default list
+ * on their first occurrence and append on the following ones.
+ * On failure the error is printed and model is left unchanged.
+ */
+inline bool LoadCostModel(const std::string &path, CostModel &result)
+{
+    CostModel model = result;
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Open cost model file " << path << " failed." << std::endl;
+        return false;
+    }
+    bool srcAlignBoostCleared = false;
+    bool rowCurvesCleared = false;
+    std::string line;
+    uint32_t lineNo = 0;
+    while (std::getline(file, line)) {
+        ++lineNo;
+        auto comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream ss(line);
+        std::string key;
+        if (!(ss >> key)) {
+            continue;
+        }
+        std::vector<double> values;
+        if (!ParseDoubles(ss, values)) {
+            std::cerr << path << ":" << lineNo << ": missing value for " << key << std::endl;
+            return false;
+        }
+        if (key == "core_num") {
+            model.coreNum = static_cast<uint32_t>(values[0]);
+        } else if (key == "ub_size") {
+            model.ubSize = static_cast<uint64_t>(values[0]);
+        } else if (key == "l1_size") {
+            model.l1Size = static_cast<uint64_t>(values[0]);
+        } else if (key == "l0a_size") {
+            model.l0ASize = static_cast<uint64_t>(values[0]);
+        } else if (key == "l0b_size") {
+            model.l0BSize = static_cast<uint64_t>(values[0]);
+        } else if (key == "l0c_size") {
+            model.l0CSize = static_cast<uint64_t>(values[0]);
+        } else if (key == "unalign_band_coef") {
+            model.unalignBandCoef = values;
+        } else if (key == "aligned_small_d_band") {
+            model.alignedSmallDBand = values[0];
+        } else if (key == "aligned_small_d_max") {
+            model.alignedSmallDMax = static_cast<uint32_t>(values[0]);
+        } else if (key == "stride_limit") {
+            model.strideLimit = static_cast<uint64_t>(values[0]);
+        } else if (key == "stride_limit_band") {
+            model.strideLimitBand = values[0];
+        } else if (key == "src_align_boost" && values.size() == 2) {
+            // srcAlign is used as a divisor by GetBandwidth.
+            if (values[0] < 1) {
+                std::cerr << path << ":" << lineNo << ": src_align_boost alignment must be positive" << std::endl;
+                return false;
+            }
+            if (!srcAlignBoostCleared) {
+                model.srcAlignBoost.clear();
+                srcAlignBoostCleared = true;
+            }
+            model.srcAlignBoost.push_back({static_cast<uint32_t>(values[0]), values[1]});
+        } else if (key == "max_unalign_band") {
+            model.maxUnalignBand = values[0];
+        } else if (key == "row_curve" && values.size() >= 3) {
+            // dAlign is used as a divisor by GetBandwidth.
+            if (values[0] < 1) {
+                std::cerr << path << ":" << lineNo << ": row_curve alignment must be positive" << std::endl;
+                return false;
+            }
+            if (!rowCurvesCleared) {
+                model.rowCurves.clear();
+                rowCurvesCleared = true;
+            }
+            model.rowCurves.push_back({static_cast<uint32_t>(values[0]), static_cast<uint32_t>(values[1]),
+                std::vector<double>(values.begin() + 2, values.end())});
+        } else if (key == "padded_band") {
+            model.paddedBand = values[0];
+        } else if (key == "padded_full_rows") {
+            model.paddedFullRows = static_cast<uint32_t>(values[0]);
+        } else if (key == "aiv_band") {
+            model.aivBand = values[0];
+        } else if (key == "aiv_band_over_l2") {
+            model.aivBandOverL2 = values[0];
+        } else if (key == "l2_size") {
+            model.l2Size = static_cast<uint64_t>(values[0]);
+        } else if (key == "head_cost_base") {
+            model.headCostBase = values[0];
+        } else if (key == "head_cost_per_core") {
+            model.headCostPerCore = values[0];
+        } else if (key == "head_cost_splitk") {
+            model.headCostSplitk = values[0];
+        } else if (key == "padding_both_extra") {
+            model.paddingBothExtra = values[0];
+        } else if (key == "cube_tflops_per_core") {
+            model.cubeTflopsPerCore = values[0];
+        } else {
+            std::cerr << path << ":" << lineNo << ": unknown or malformed key " << key << std::endl;
+            return false;
+        }
+    }
+    result = model;
+    return true;
+}
+
+// Write the model in the format read by LoadCostModel.
+inline void DumpCostModel(std::ostream &os, const CostModel &model)
+{
+    auto precision = os.precision(17);
+    os << "unalign_band_coef";
+    for (double coef : model.unalignBandCoef) {
+        os << " " << coef;
+    }
+    os << "\naligned_small_d_band " << model.alignedSmallDBand
+       << "\naligned_small_d_max " << model.alignedSmallDMax
+       << "\nstride_limit " << model.strideLimit
+       << "\nstride_limit_band " << model.strideLimitBand << "\n";
+    for (const auto &boost : model.srcAlignBoost) {
+        os << "src_align_boost " << boost.srcAlign << " " << boost.factor << "\n";
+    }
+    os << "max_unalign_band " << model.maxUnalignBand << "\n";
+    for (const auto &curve : model.rowCurves) {
+        os << "row_curve " << curve.dAlign << " " << curve.nLimit;
+        for (double coef : curve.coef) {
+            os << " " << coef;
+        }
+        os << "\n";
+    }
+    os << "padded_band " << model.paddedBand
+       << "\npadded_full_rows " << model.paddedFullRows
+       << "\naiv_band " << model.aivBand
+       << "\naiv_band_over_l2 " << model.aivBandOverL2
+       << "\nl2_size " << model.l2Size
+       << "\nhead_cost_base " << model.headCostBase
+       << "\nhead_cost_per_core " << model.headCostPerCore
+       << "\nhead_cost_splitk " << model.headCostSplitk
+       << "\npadding_both_extra " << model.paddingBothExtra
+       << "\ncube_tflops_per_core " << model.cubeTflopsPerCore << std::endl;
+    os.precision(precision);
+}
+
+#endif  // COST_MODEL_H
@@ -0,0 +1,45 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef DEVICE_PLATFORM_INFO_H
+#define DEVICE_PLATFORM_INFO_H
+
+#include <cstdlib>
+#include <iostream>
+#include "tiling/platform/platform_ascendc.h"
+#include "platform_info.h"
+
+/**
+ * Query the platform of the current device. CATLASS_COST_MODEL_FILE replaces the default cost model,
+ * e.g. one calibrated for another SKU; a file that fails to load is reported and the default model is used.
+ */
+inline PlatformInfo GetDevicePlatformInfo()
+{
+    CostModel costModel;
+    const char *costModelFile = std::getenv("CATLASS_COST_MODEL_FILE");
+    if (costModelFile != nullptr && costModelFile[0] != '\0' && !LoadCostModel(costModelFile, costModel)) {
+        std::cerr << "Warning: load cost model file " << costModelFile << " failed, use the default cost model."
+                  << std::endl;
+    }
+    PlatformInfo platformInfo(costModel);
+
+    auto *platform = platform_ascendc::PlatformAscendCManager::GetInstance();
+    platformInfo.coreNum = platform->GetCoreNumAic();
+    platform->GetCoreMemSize(platform_ascendc::CoreMemType::UB, platformInfo.ubSize);
+    platform->GetCoreMemSize(platform_ascendc::CoreMemType::L1, platformInfo.l1Size);
+    platform->GetCoreMemSize(platform_ascendc::CoreMemType::L0_A, platformInfo.l0ASize);
+    platform->GetCoreMemSize(platform_ascendc::CoreMemType::L0_B, platformInfo.l0BSize);
+    platform->GetCoreMemSize(platform_ascendc::CoreMemType::L0_C, platformInfo.l0CSize);
+    // Values given by the cost model file win over the device query.
+    platformInfo.ApplyCostModelOverrides();
+    return platformInfo;
+}
+
+#endif  // DEVICE_PLATFORM_INFO_H
@@ -11,6 +11,8 @@
 #ifndef ADJUST_TILING_B16_H
 #define ADJUST_TILING_B16_H
 
+#include <array>
+
 #include "utils.h"
 #include "tiling_params.h"
 #include "platform_info.h"
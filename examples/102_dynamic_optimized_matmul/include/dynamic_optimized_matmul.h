@@ -16,6 +16,8 @@
 
 #include "do_tiling_b16.h"
 #include "select_kernel_b16.h"
+#include "tiling_cache.h"
+#include "device_platform_info.h"
 #include "launch_map.h"
 
 template <class DType>
@@ -40,6 +42,15 @@ void DoTilingAndSelectKernel(TilingParams &tilingParams, PlatformInfo &platformI
     SelectKernel<DType>(tilingParams, platformInfo);
 }
 
+// Same as above, but repeated shapes reuse the decision stored in tilingCache.
+template <class DType>
+void DoTilingAndSelectKernel(TilingParams &tilingParams, PlatformInfo &platformInfo, TilingCache &tilingCache)
+{
+    tilingCache.GetOrCompute<DType>(tilingParams, [&platformInfo](TilingParams &params) {
+        DoTilingAndSelectKernel<DType>(params, platformInfo);
+    });
+}
+
 size_t DynamicOptimizedMatmulGetWorkspace(TilingParams &tilingParams)
 {
     return getWorkspaceFuncMap[tilingParams.tilingKey.value](tilingParams);
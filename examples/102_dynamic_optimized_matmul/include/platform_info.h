@@ -11,8 +11,10 @@
 #ifndef PLATFORM_INFO_H
 #define PLATFORM_INFO_H
 
-#include "tiling/platform/platform_ascendc.h"
+#include <cstdint>
+#include "cost_model.h"
 
+// Host only, see device_platform_info.h for the values of the current device.
 struct PlatformInfo
 {
     uint32_t coreNum{24};
@@ -21,20 +23,22 @@ struct PlatformInfo
     uint64_t l0ASize{64 * 1024};
     uint64_t l0BSize{64 * 1024};
     uint64_t l0CSize{128 * 1024};
+    CostModel costModel;
 
-    PlatformInfo()
+    // The platform is the Atlas A2 default overridden by the model (core_num, l1_size, ...).
+    explicit PlatformInfo(const CostModel &model) : costModel(model)
     {
-        coreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
-        platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreMemSize(
-            platform_ascendc::CoreMemType::UB, ubSize);
-        platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreMemSize(
-            platform_ascendc::CoreMemType::L1, l1Size);
-        platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreMemSize(
-            platform_ascendc::CoreMemType::L0_A, l0ASize);
-        platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreMemSize(
-            platform_ascendc::CoreMemType::L0_B, l0BSize);
-        platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreMemSize(
-            platform_ascendc::CoreMemType::L0_C, l0CSize);
+        ApplyCostModelOverrides();
+    }
+
+    void ApplyCostModelOverrides()
+    {
+        coreNum = costModel.coreNum ? costModel.coreNum : coreNum;
+        ubSize = costModel.ubSize ? costModel.ubSize : ubSize;
+        l1Size = costModel.l1Size ? costModel.l1Size : l1Size;
+        l0ASize = costModel.l0ASize ? costModel.l0ASize : l0ASize;
+        l0BSize = costModel.l0BSize ? costModel.l0BSize : l0BSize;
+        l0CSize = costModel.l0CSize ? costModel.l0CSize : l0CSize;
     }
 
     ~PlatformInfo() {}
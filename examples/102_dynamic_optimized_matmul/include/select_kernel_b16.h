@@ -11,72 +11,66 @@
 #ifndef SELECT_KERNEL_HALF_H
 #define SELECT_KERNEL_HALF_H
 
+#include <algorithm>
 #include <limits>
+#include <string>
+#include <vector>
+#include "cost_model.h"
 #include "platform_info.h"
 
 enum class PaddingTag : uint8_t { PADDING_NONE = 0, PADDING_ND = 1, PADDING_BLOCK_ND = 2, PADDING_NZ = 3};
 
-double GetBandwidth(uint32_t nValue, uint32_t dValue, uint32_t srcDValue) {
-    double a6 = 0.000000000000020146121020;
-    double a5 = -0.000000000012456944162142;
-    double a4 = -0.000000006738536427145036;
-    double a3 = 0.000007301215580838747961;
-    double a2 = -0.002146456956750821074703;
-    double a1 = 0.312849910814454512664184;
-    double a0 = 0.1;
-    double unalignBand = a6 * pow(static_cast<double>(dValue), 6) + a5 * pow(static_cast<double>(dValue), 5)
-        + a4 * pow(static_cast<double>(dValue), 4) + a3 * pow(static_cast<double>(dValue), 3)
-        + a2 * pow(static_cast<double>(dValue), 2) + a1 * static_cast<double>(dValue) + a0;
-    
-    if (dValue == srcDValue && dValue <= 128) {
+double GetBandwidth(uint32_t nValue, uint32_t dValue, uint32_t srcDValue, const CostModel &model)
+{
+    double unalignBand = EvalPolynomial(model.unalignBandCoef, static_cast<double>(dValue));
+
+    if (dValue == srcDValue && dValue <= model.alignedSmallDMax) {
         if (dValue % 16 == 0) {
-            unalignBand = 60;
+            unalignBand = model.alignedSmallDBand;
         }
     }
-    if (srcDValue >= 65536) {
-        unalignBand = 1;
+    if (srcDValue >= model.strideLimit) {
+        unalignBand = model.strideLimitBand;
     }
 
-    if (srcDValue % 256 == 0) {
-        unalignBand = static_cast<double>(100) / 30 * unalignBand;
-    } else if (srcDValue % 128 == 0) {
-        unalignBand = static_cast<double>(80) / 30 * unalignBand;
-    } else if (srcDValue % 64 == 0) {
-        unalignBand = static_cast<double>(50) / 30 * unalignBand;
-    } else if (srcDValue % 16 == 0) {
-        unalignBand = static_cast<double>(40) / 30 * unalignBand;
+    for (const auto &boost : model.srcAlignBoost) {
+        if (srcDValue % boost.srcAlign == 0) {
+            unalignBand = boost.factor * unalignBand;
+            break;
+        }
     }
 
-    unalignBand = std::min(unalignBand, 80.0);
-
-    if (dValue % 256 == 0) {
-        if (nValue < 16) {
-            double b2 = -0.003332381309698882569659;
-            double b1 = 0.113578920178116271610946;
-            double b0 = 0.016102868630357251855667;
-            unalignBand = unalignBand * (b2 * pow(nValue, 2) + b1 * nValue + b0);
-        }
-    } else if (dValue % 32 == 0) {
-        if (nValue < 32) {
-            double b2 = -0.000298086120946179481978;
-            double b1 = 0.045309519479127147167929;
-            double b0 = 0.035130178145161221336945;
-            unalignBand = unalignBand * (b2 * pow(nValue, 2) + b1 * nValue + b0);
-        }
+    unalignBand = std::min(unalignBand, model.maxUnalignBand);
 
-    } else {
-        if (nValue < 64) {
-            double b3 = 0.000001809180573350345869;
-            double b2 = -0.000469676727179688081274;
-            double b1 = 0.038963259596073690493867;
-            double b0 = 0.003942641759904389614499;
-            unalignBand = unalignBand * (b3 * pow(nValue, 3) + b2 * pow(nValue, 2) + b1 * nValue + b0);
+    for (const auto &curve : model.rowCurves) {
+        if (dValue % curve.dAlign == 0) {
+            if (nValue < curve.nLimit) {
+                unalignBand = unalignBand * EvalPolynomial(curve.coef, static_cast<double>(nValue));
+            }
+            break;
         }
     }
     return unalignBand;
 }
 
-void GetPaddingTag(TilingParams& tilingParams, PlatformInfo& platformInfo) {
+// Predicted cost of the padding options of one tiling, indexed by paddingA * 2 + paddingB (0 none, 1 NZ).
+struct PaddingCostEstimate {
+    double memoryUs[4]{0};   // GM traffic of the busiest AIC plus the padding kernels
+    double overheadUs[4]{0}; // launch overhead of the padding kernels
+    double costUs[4]{0};     // memoryUs + overheadUs, compared by GetPaddingTag
+    double computeUs{0};     // cube roof of the busiest AIC
+    uint32_t blockDimAic{0};
+    uint32_t tasksAivA{0};
+    uint32_t tasksAivB{0};
+    uint64_t outterAxisA{0};
+    uint64_t innerAxisA{0};
+    uint64_t outterAxisB{0};
+    uint64_t innerAxisB{0};
+};
+
+PaddingCostEstimate EstimatePaddingCost(const TilingParams &tilingParams, const PlatformInfo &platformInfo)
+{
+    const CostModel &model = platformInfo.costModel;
     uint32_t m = tilingParams.m;
     uint32_t n = tilingParams.n;
     uint32_t k = tilingParams.k;
@@ -84,6 +78,7 @@ void GetPaddingTag(TilingParams& tilingParams, PlatformInfo& platformInfo) {
     uint32_t n1 = tilingParams.n1;
     uint32_t k1 = tilingParams.k1;
     uint32_t splitkFactor = tilingParams.splitkFactor;
+    PaddingCostEstimate estimate;
 
     uint64_t outterAxisA = m;
     uint64_t innerAxisA = k;
@@ -107,35 +102,35 @@ void GetPaddingTag(TilingParams& tilingParams, PlatformInfo& platformInfo) {
         dValueB = std::min(k, k1);
     }
 
-    double aBandwidthAiv = 30; // single core GB/s
+    double aBandwidthAiv = model.aivBand; // single core GB/s
     size_t matrixASize = static_cast<size_t>(m) * k * 2;
-    if (matrixASize > 192 * 1024 * 1024) { // L2 cache size
-        aBandwidthAiv = 10;
+    if (matrixASize > model.l2Size) {
+        aBandwidthAiv = model.aivBandOverL2;
     }
-    double aBandwidthBeforePaddingAic = GetBandwidth(nValueA, dValueA, innerAxisA);
-    
+    double aBandwidthBeforePaddingAic = GetBandwidth(nValueA, dValueA, innerAxisA, model);
+
     uint32_t tasksAic = CeilDiv(m, m1) * CeilDiv(n, n1) * splitkFactor;
     uint32_t blockDimAic = tasksAic > platformInfo.coreNum ? platformInfo.coreNum : tasksAic;
     if (CeilDiv(m, m1) < blockDimAic / 2 && k <= k1 && CeilDiv(m, m1) <= 2) {
         aBandwidthBeforePaddingAic = aBandwidthBeforePaddingAic / (blockDimAic / CeilDiv(m, m1)) * 1.5;
     }
-    double aBandwidthAfterPaddingAic = 80;
-    if (nValueA < 16) {
-        aBandwidthAfterPaddingAic *= (static_cast<double>(nValueA) / 16);
+    double aBandwidthAfterPaddingAic = model.paddedBand;
+    if (nValueA < model.paddedFullRows) {
+        aBandwidthAfterPaddingAic *= (static_cast<double>(nValueA) / model.paddedFullRows);
     }
 
-    double bBandwidthAiv = 30; // single core GB/s
+    double bBandwidthAiv = model.aivBand; // single core GB/s
     size_t matrixBSize = static_cast<size_t>(k) * n * 2;
-    if (matrixBSize > 192 * 1024 * 1024) { // L2 cache size
-        bBandwidthAiv = 10;
+    if (matrixBSize > model.l2Size) {
+        bBandwidthAiv = model.aivBandOverL2;
     }
-    double bBandwidthBeforePaddingAic = GetBandwidth(nValueB, dValueB, innerAxisB); 
+    double bBandwidthBeforePaddingAic = GetBandwidth(nValueB, dValueB, innerAxisB, model);
     if (CeilDiv(n, n1) < blockDimAic / 2 && k <= k1 && CeilDiv(n, n1) <= 2) {
         bBandwidthBeforePaddingAic = bBandwidthBeforePaddingAic / (blockDimAic / CeilDiv(n, n1)) * 1.5;
     }
-    double bBandwidthAfterPaddingAic = 80;
-    if (nValueB < 16) {
-        bBandwidthAfterPaddingAic *= (static_cast<double>(nValueB) / 16);
+    double bBandwidthAfterPaddingAic = model.paddedBand;
+    if (nValueB < model.paddedFullRows) {
+        bBandwidthAfterPaddingAic *= (static_cast<double>(nValueB) / model.paddedFullRows);
     }
 
     uint32_t actualM = std::min(m, m1);
@@ -179,41 +174,74 @@ void GetPaddingTag(TilingParams& tilingParams, PlatformInfo& platformInfo) {
         bMaxDataSizeAiv = maxTasksPerCore * taskCols * taskRows * 2;
     }
 
-    double headCost = 1 + 7 * static_cast<double>(blockDimAic) / platformInfo.coreNum; // us
+    double headCost = model.headCostBase + model.headCostPerCore * static_cast<double>(blockDimAic)
+        / platformInfo.coreNum; // us
     if (splitkFactor > 1) {
-        headCost = 1;
-    }
-    double t00 = static_cast<double>(aMaxDataSizeAic) / aBandwidthBeforePaddingAic / 1000
-        + static_cast<double>(bMaxDataSizeAic) / bBandwidthBeforePaddingAic / 1000;
-    double t01 = static_cast<double>(aMaxDataSizeAic) / aBandwidthBeforePaddingAic / 1000
-        + static_cast<double>(bMaxDataSizeAic) / bBandwidthAfterPaddingAic / 1000
-        + static_cast<double>(bMaxDataSizeAiv) / bBandwidthAiv / 1000 + headCost;
-    double t10 = static_cast<double>(aMaxDataSizeAic) / aBandwidthAfterPaddingAic / 1000
-        + static_cast<double>(bMaxDataSizeAic) / bBandwidthBeforePaddingAic / 1000
-        + static_cast<double>(aMaxDataSizeAiv) / aBandwidthAiv / 1000 + headCost;
-    double t11 = static_cast<double>(aMaxDataSizeAic) / aBandwidthAfterPaddingAic / 1000
-        + static_cast<double>(bMaxDataSizeAic) / bBandwidthAfterPaddingAic / 1000
-        + static_cast<double>(aMaxDataSizeAiv) / aBandwidthAiv / 1000
-        + static_cast<double>(bMaxDataSizeAiv) / bBandwidthAiv / 1000 + headCost + 2;
-    
+        headCost = model.headCostSplitk;
+    }
+    double aBeforeUs = static_cast<double>(aMaxDataSizeAic) / aBandwidthBeforePaddingAic / 1000;
+    double aAfterUs = static_cast<double>(aMaxDataSizeAic) / aBandwidthAfterPaddingAic / 1000;
+    double bBeforeUs = static_cast<double>(bMaxDataSizeAic) / bBandwidthBeforePaddingAic / 1000;
+    double bAfterUs = static_cast<double>(bMaxDataSizeAic) / bBandwidthAfterPaddingAic / 1000;
+    double aPaddingUs = static_cast<double>(aMaxDataSizeAiv) / aBandwidthAiv / 1000;
+    double bPaddingUs = static_cast<double>(bMaxDataSizeAiv) / bBandwidthAiv / 1000;
+
+    estimate.memoryUs[0] = aBeforeUs + bBeforeUs;
+    estimate.memoryUs[1] = aBeforeUs + bAfterUs + bPaddingUs;
+    estimate.memoryUs[2] = aAfterUs + bBeforeUs + aPaddingUs;
+    estimate.memoryUs[3] = aAfterUs + bAfterUs + aPaddingUs + bPaddingUs;
+    estimate.overheadUs[1] = headCost;
+    estimate.overheadUs[2] = headCost;
+    estimate.overheadUs[3] = headCost + model.paddingBothExtra;
+    // Same summation order as the fitted formula, the extra cost of padding both is added last.
+    estimate.costUs[0] = estimate.memoryUs[0];
+    estimate.costUs[1] = estimate.memoryUs[1] + headCost;
+    estimate.costUs[2] = estimate.memoryUs[2] + headCost;
+    estimate.costUs[3] = estimate.memoryUs[3] + headCost + model.paddingBothExtra;
+
+    double flops = 2.0 * roundMax * actualM * actualN * CeilDiv(k, splitkFactor);
+    estimate.computeUs = flops / (model.cubeTflopsPerCore * 1e6);
+    estimate.blockDimAic = blockDimAic;
+    estimate.tasksAivA = tasksAivA;
+    estimate.tasksAivB = tasksAivB;
+    estimate.outterAxisA = outterAxisA;
+    estimate.innerAxisA = innerAxisA;
+    estimate.outterAxisB = outterAxisB;
+    estimate.innerAxisB = innerAxisB;
+    return estimate;
+}
+
+void GetPaddingTag(TilingParams& tilingParams, PlatformInfo& platformInfo) {
+    uint32_t m = tilingParams.m;
+    uint32_t n = tilingParams.n;
+    uint32_t k = tilingParams.k;
+    uint32_t m1 = tilingParams.m1;
+    uint32_t n1 = tilingParams.n1;
+    PaddingCostEstimate estimate = EstimatePaddingCost(tilingParams, platformInfo);
+    uint64_t outterAxisA = estimate.outterAxisA;
+    uint64_t innerAxisA = estimate.innerAxisA;
+    uint64_t outterAxisB = estimate.outterAxisB;
+    uint64_t innerAxisB = estimate.innerAxisB;
+    uint32_t blockDimAic = estimate.blockDimAic;
+
     double minCost = std::numeric_limits<double>::max();
     PaddingTag paddingTagA = PaddingTag::PADDING_NONE;
     PaddingTag paddingTagB = PaddingTag::PADDING_NONE;
-    if (minCost > t00) {
-        minCost = t00;
+    if (minCost > estimate.costUs[0]) {
+        minCost = estimate.costUs[0];
     }
-    if (minCost > t01) {
-        minCost = t01;
+    if (minCost > estimate.costUs[1]) {
+        minCost = estimate.costUs[1];
         paddingTagA = PaddingTag::PADDING_NONE;
         paddingTagB = PaddingTag::PADDING_NZ;
     }
-    if (minCost > t10) {
-        minCost = t10;
+    if (minCost > estimate.costUs[2]) {
+        minCost = estimate.costUs[2];
         paddingTagA = PaddingTag::PADDING_NZ;
         paddingTagB = PaddingTag::PADDING_NONE;
     }
-    if (minCost > t11) {
-        minCost = t11;
+    if (minCost > estimate.costUs[3]) {
+        minCost = estimate.costUs[3];
         paddingTagA = PaddingTag::PADDING_NZ;
         paddingTagB = PaddingTag::PADDING_NZ;
     }
@@ -229,7 +257,7 @@ void GetPaddingTag(TilingParams& tilingParams, PlatformInfo& platformInfo) {
     if (static_cast<size_t>(m) * n > 2048 * 2048 && n > 256 && (n % 128 != 0)) {
         size_t totalDataSize = static_cast<size_t>(m) * k * CeilDiv(n, n1) * 2
             + static_cast<size_t>(k) * n * CeilDiv(m, m1) * 2 + static_cast<size_t>(m) * n * 2;
-        if (totalDataSize < 192 * 1024 * 1024) { // L2 cache size
+        if (totalDataSize < platformInfo.costModel.l2Size) {
             paddingTagC = PaddingTag::PADDING_ND;
         }
     }
@@ -242,10 +270,10 @@ void GetPaddingTag(TilingParams& tilingParams, PlatformInfo& platformInfo) {
     uint32_t actualTasksAivA{0};
     uint32_t actualTasksAivB{0};
     if (tilingParams.paddingTagA && innerAxisA > 192) {
-        actualTasksAivA = tasksAivA;
+        actualTasksAivA = estimate.tasksAivA;
     }
     if (tilingParams.paddingTagB && innerAxisB > 192) {
-        actualTasksAivB = tasksAivB;
+        actualTasksAivB = estimate.tasksAivB;
     }
     uint32_t actualTasksAiv = std::max(actualTasksAivA, actualTasksAivB);
     uint32_t blockDimAiv = CeilDiv(actualTasksAiv, 2) > platformInfo.coreNum 
@@ -327,4 +355,55 @@ void SelectKernelB16(TilingParams &tilingParams, PlatformInfo& platformInfo)
     tilingParams.layoutTagB = layoutTagBTmp;
 }
 
+// Roofline estimate of one candidate kernel: predictedUs = max(memoryUs, computeUs) + overheadUs.
+struct KernelCandidate {
+    std::string name;
+    uint8_t kernelSerial{0};
+    uint8_t paddingTagA{0};
+    uint8_t paddingTagB{0};
+    bool feasible{true};
+    double memoryUs{0};
+    double computeUs{0};
+    double overheadUs{0};
+    double predictedUs{0};
+};
+
+/**
+ * Predict the time of every kernel SelectKernelB16 can choose for an already tiled problem.
+ * tilingParams must hold the output of DoTiling, the layout adjustment for m=1 or n=1 is applied here too.
+ */
+std::vector<KernelCandidate> EstimateKernelCandidates(const TilingParams &tilingParams, const PlatformInfo &platformInfo)
+{
+    TilingParams params = tilingParams;
+    if (params.m == 1 && static_cast<LayoutTag>(params.layoutTagA) == LayoutTag::TagColumnMajor) {
+        params.layoutTagA = static_cast<uint8_t>(LayoutTag::TagRowMajor);
+    }
+    if (params.n == 1 && static_cast<LayoutTag>(params.layoutTagB) == LayoutTag::TagRowMajor) {
+        params.layoutTagB = static_cast<uint8_t>(LayoutTag::TagColumnMajor);
+    }
+    PaddingCostEstimate estimate = EstimatePaddingCost(params, platformInfo);
+    uint32_t taskBlocks = CeilDiv(params.m, params.m1) * CeilDiv(params.n, params.n1);
+
+    std::vector<KernelCandidate> candidates;
+    auto addCandidate = [&](const char *name, uint8_t kernelSerial, uint32_t paddingIdx, bool feasible) {
+        KernelCandidate candidate;
+        candidate.name = name;
+        candidate.kernelSerial = kernelSerial;
+        candidate.paddingTagA = (paddingIdx & 2) ? static_cast<uint8_t>(PaddingTag::PADDING_NZ) : 0;
+        candidate.paddingTagB = (paddingIdx & 1) ? static_cast<uint8_t>(PaddingTag::PADDING_NZ) : 0;
+        candidate.feasible = feasible;
+        candidate.memoryUs = estimate.memoryUs[paddingIdx];
+        candidate.computeUs = estimate.computeUs;
+        candidate.overheadUs = estimate.overheadUs[paddingIdx];
+        candidate.predictedUs = std::max(candidate.memoryUs, candidate.computeUs) + candidate.overheadUs;
+        candidates.push_back(candidate);
+    };
+    addCandidate("SmallMatmul", 1, 0, taskBlocks <= platformInfo.coreNum && params.k <= params.k1);
+    addCandidate("CommonMatmul", 0, 0, true);
+    addCandidate("PaddingCommonMatmul(B)", 2, 1, true);
+    addCandidate("PaddingCommonMatmul(A)", 2, 2, true);
+    addCandidate("PaddingCommonMatmul(AB)", 2, 3, true);
+    return candidates;
+}
+
 #endif  // SELECT_KERNEL_HALF_H
\ No newline at end of file
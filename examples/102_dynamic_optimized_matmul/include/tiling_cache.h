@@ -0,0 +1,446 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef TILING_CACHE_H
+#define TILING_CACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tiling_params.h"
+#include "platform_info.h"
+
+/*
+ * Cache of finished tiling decisions (TilingParams with blockDim, paddings and TilingKey).
+ *
+ * Lookups go through two tiers:
+ *   1. a read-only table mapped from a file written by Save(), sorted by key and searched without locks;
+ *   2. a sharded LRU filled by the current process, bounded by capacity.
+ * A miss runs the tiling functions once and records the host time they took, so every later hit
+ * adds that time to the saved-microseconds counter.
+ */
+
+struct TilingCacheKey {
+    uint32_t m{0};
+    uint32_t n{0};
+    uint32_t k{0};
+    // layoutTagA | layoutTagB << 8 | layoutTagC << 16 | dtype size << 24
+    uint32_t tags{0};
+    uint64_t strideA{0};
+    uint64_t strideB{0};
+    uint64_t strideC{0};
+
+    TilingCacheKey() {}
+
+    TilingCacheKey(const TilingParams &tilingParams, uint32_t dtypeSize)
+        : m(tilingParams.m), n(tilingParams.n), k(tilingParams.k),
+          tags(static_cast<uint32_t>(tilingParams.layoutTagA) | (static_cast<uint32_t>(tilingParams.layoutTagB) << 8)
+              | (static_cast<uint32_t>(tilingParams.layoutTagC) << 16) | (dtypeSize << 24)),
+          strideA(tilingParams.strideA), strideB(tilingParams.strideB), strideC(tilingParams.strideC)
+    {}
+
+    bool operator==(const TilingCacheKey &other) const
+    {
+        return m == other.m && n == other.n && k == other.k && tags == other.tags &&
+            strideA == other.strideA && strideB == other.strideB && strideC == other.strideC;
+    }
+
+    bool operator<(const TilingCacheKey &other) const
+    {
+        if (m != other.m) return m < other.m;
+        if (n != other.n) return n < other.n;
+        if (k != other.k) return k < other.k;
+        if (tags != other.tags) return tags < other.tags;
+        if (strideA != other.strideA) return strideA < other.strideA;
+        if (strideB != other.strideB) return strideB < other.strideB;
+        return strideC < other.strideC;
+    }
+};
+
+struct TilingCacheKeyHash {
+    size_t operator()(const TilingCacheKey &key) const
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        auto mix = [&hash](uint64_t value) {
+            hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        };
+        mix(key.m);
+        mix(key.n);
+        mix(key.k);
+        mix(key.tags);
+        mix(key.strideA);
+        mix(key.strideB);
+        mix(key.strideC);
+        return static_cast<size_t>(hash);
+    }
+};
+
+// One fixed-size record of the cache file, the file is a header followed by records sorted by key.
+struct TilingCacheRecord {
+    TilingCacheKey key;
+    TilingParams tilingParams;
+    uint64_t tilingNs{0};
+};
+
+struct TilingCacheFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t recordCount;
+    // Platform the decisions were made for, a file recorded on another platform is rejected.
+    uint64_t coreNum;
+    uint64_t ubSize;
+    uint64_t l1Size;
+    uint64_t l0ASize;
+    uint64_t l0BSize;
+    uint64_t l0CSize;
+    // Hash of the cost model the kernels were selected with, see CostModelHash.
+    uint64_t costModelHash;
+};
+
+struct TilingCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t entries{0};
+    uint64_t mappedEntries{0};
+    double savedUs{0};
+    double spentUs{0};
+
+    double HitRate() const
+    {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+};
+
+class TilingCache {
+public:
+    static constexpr char FILE_MAGIC[8] = "CATLTLC";
+    // Bump when the tiling or kernel selection code changes, files of older versions are then rejected.
+    static constexpr uint32_t FILE_VERSION = 2;
+    static constexpr size_t DEFAULT_CAPACITY = 65536;
+    static constexpr uint32_t DEFAULT_SHARD_NUM = 16;
+
+    explicit TilingCache(size_t capacity = DEFAULT_CAPACITY, uint32_t shardNum = DEFAULT_SHARD_NUM)
+        : shards_(std::max(shardNum, 1U))
+    {
+        shardCapacity_ = std::max<size_t>(capacity / shards_.size(), 1);
+    }
+
+    ~TilingCache()
+    {
+        Unmap();
+    }
+
+    TilingCache(const TilingCache &) = delete;
+    TilingCache &operator=(const TilingCache &) = delete;
+
+    /**
+     * Fill tilingParams from the cache, or run compute(tilingParams) and remember its result.
+     * Only the input fields of tilingParams (m, n, k, strides and layout tags) are used as key.
+     */
+    template <class DType, class Func>
+    void GetOrCompute(TilingParams &tilingParams, Func &&compute)
+    {
+        TilingCacheKey key(tilingParams, sizeof(DType));
+        if (LookupMapped(key, tilingParams) || LookupLru(key, tilingParams)) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        compute(tilingParams);
+        uint64_t tilingNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        spentNs_.fetch_add(tilingNs, std::memory_order_relaxed);
+        Insert(key, tilingParams, tilingNs);
+    }
+
+    /**
+     * Map a file written by Save(). Must be called before the cache is shared between threads.
+     */
+    bool Load(const std::string &path, const PlatformInfo &platformInfo)
+    {
+        Unmap();
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < sizeof(TilingCacheFileHeader)) {
+            close(fd);
+            return false;
+        }
+        size_t fileSize = static_cast<size_t>(fileStat.st_size);
+        void *addr = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+
+        const auto *header = static_cast<const TilingCacheFileHeader *>(addr);
+        TilingCacheFileHeader expected = MakeHeader(platformInfo, 0);
+        bool valid = std::memcmp(header->magic, expected.magic, sizeof(expected.magic)) == 0 &&
+            header->version == expected.version && header->recordSize == expected.recordSize &&
+            header->coreNum == expected.coreNum && header->ubSize == expected.ubSize &&
+            header->l1Size == expected.l1Size && header->l0ASize == expected.l0ASize &&
+            header->l0BSize == expected.l0BSize && header->l0CSize == expected.l0CSize &&
+            header->costModelHash == expected.costModelHash &&
+            fileSize == sizeof(TilingCacheFileHeader) + header->recordCount * sizeof(TilingCacheRecord);
+        if (!valid) {
+            munmap(addr, fileSize);
+            std::cerr << "Tiling cache file " << path
+                      << " is invalid or recorded on another platform or cost model, discard it." << std::endl;
+            return false;
+        }
+        mappedAddr_ = addr;
+        mappedSize_ = fileSize;
+        mappedRecords_ = reinterpret_cast<const TilingCacheRecord *>(header + 1);
+        mappedCount_ = header->recordCount;
+        return true;
+    }
+
+    /**
+     * Write mapped and in-process entries to path. The file is written aside and renamed,
+     * so processes mapping the old file keep a consistent view.
+     */
+    bool Save(const std::string &path, const PlatformInfo &platformInfo)
+    {
+        std::vector<TilingCacheRecord> records(mappedRecords_, mappedRecords_ + mappedCount_);
+        for (auto &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto &record : shard.lru) {
+                records.push_back(record);
+            }
+        }
+        // In-process entries were appended last, keep them when a key appears twice.
+        std::stable_sort(records.begin(), records.end(),
+            [](const TilingCacheRecord &lhs, const TilingCacheRecord &rhs) { return lhs.key < rhs.key; });
+        std::vector<TilingCacheRecord> uniqueRecords;
+        uniqueRecords.reserve(records.size());
+        for (const auto &record : records) {
+            if (!uniqueRecords.empty() && uniqueRecords.back().key == record.key) {
+                uniqueRecords.back() = record;
+            } else {
+                uniqueRecords.push_back(record);
+            }
+        }
+        // Copy field by field into zeroed records, so the padding bytes of the file are deterministic.
+        std::vector<TilingCacheRecord> fileRecords(uniqueRecords.size());
+        for (size_t i = 0; i < uniqueRecords.size(); ++i) {
+            MakeFileRecord(uniqueRecords[i], fileRecords[i]);
+        }
+
+        std::string tmpPath = path + ".tmp";
+        FILE *file = fopen(tmpPath.c_str(), "wb");
+        if (file == nullptr) {
+            return false;
+        }
+        TilingCacheFileHeader header = MakeHeader(platformInfo, fileRecords.size());
+        bool success = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(fileRecords.data(), sizeof(TilingCacheRecord), fileRecords.size(), file) == fileRecords.size();
+        success = (fclose(file) == 0) && success;
+        if (!success || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    TilingCacheStats GetStats()
+    {
+        TilingCacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.savedUs = static_cast<double>(savedNs_.load(std::memory_order_relaxed)) / 1000;
+        stats.spentUs = static_cast<double>(spentNs_.load(std::memory_order_relaxed)) / 1000;
+        stats.mappedEntries = mappedCount_;
+        for (auto &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            stats.entries += shard.lru.size();
+        }
+        return stats;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::list<TilingCacheRecord> lru;
+        std::unordered_map<TilingCacheKey, std::list<TilingCacheRecord>::iterator, TilingCacheKeyHash> index;
+    };
+
+    static TilingCacheFileHeader MakeHeader(const PlatformInfo &platformInfo, uint64_t recordCount)
+    {
+        TilingCacheFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+        header.version = FILE_VERSION;
+        header.recordSize = sizeof(TilingCacheRecord);
+        header.recordCount = recordCount;
+        header.coreNum = platformInfo.coreNum;
+        header.ubSize = platformInfo.ubSize;
+        header.l1Size = platformInfo.l1Size;
+        header.l0ASize = platformInfo.l0ASize;
+        header.l0BSize = platformInfo.l0BSize;
+        header.l0CSize = platformInfo.l0CSize;
+        header.costModelHash = CostModelHash(platformInfo.costModel);
+        return header;
+    }
+
+    // FNV-1a of the cost model in its file format, which lists every field with full precision.
+    static uint64_t CostModelHash(const CostModel &costModel)
+    {
+        std::ostringstream ss;
+        DumpCostModel(ss, costModel);
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (char c : ss.str()) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    static void MakeFileRecord(const TilingCacheRecord &record, TilingCacheRecord &fileRecord)
+    {
+        std::memset(static_cast<void *>(&fileRecord), 0, sizeof(fileRecord));
+        fileRecord.key.m = record.key.m;
+        fileRecord.key.n = record.key.n;
+        fileRecord.key.k = record.key.k;
+        fileRecord.key.tags = record.key.tags;
+        fileRecord.key.strideA = record.key.strideA;
+        fileRecord.key.strideB = record.key.strideB;
+        fileRecord.key.strideC = record.key.strideC;
+        const TilingParams &src = record.tilingParams;
+        TilingParams &dst = fileRecord.tilingParams;
+        dst.m = src.m;
+        dst.n = src.n;
+        dst.k = src.k;
+        dst.strideA = src.strideA;
+        dst.strideB = src.strideB;
+        dst.strideC = src.strideC;
+        dst.m1 = src.m1;
+        dst.n1 = src.n1;
+        dst.k1 = src.k1;
+        dst.splitkFactor = src.splitkFactor;
+        dst.layoutTagA = src.layoutTagA;
+        dst.layoutTagB = src.layoutTagB;
+        dst.layoutTagC = src.layoutTagC;
+        dst.paddingTagA = src.paddingTagA;
+        dst.paddingTagB = src.paddingTagB;
+        dst.paddingTagC = src.paddingTagC;
+        dst.blockDim = src.blockDim;
+        dst.tilingKey.value = src.tilingKey.value;
+        fileRecord.tilingNs = record.tilingNs;
+    }
+
+    bool LookupMapped(const TilingCacheKey &key, TilingParams &tilingParams)
+    {
+        if (mappedCount_ == 0) {
+            return false;
+        }
+        const TilingCacheRecord *end = mappedRecords_ + mappedCount_;
+        const TilingCacheRecord *record = std::lower_bound(mappedRecords_, end, key,
+            [](const TilingCacheRecord &lhs, const TilingCacheKey &rhs) { return lhs.key < rhs; });
+        if (record == end || !(record->key == key)) {
+            return false;
+        }
+        tilingParams = record->tilingParams;
+        savedNs_.fetch_add(record->tilingNs, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool LookupLru(const TilingCacheKey &key, TilingParams &tilingParams)
+    {
+        Shard &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        tilingParams = it->second->tilingParams;
+        savedNs_.fetch_add(it->second->tilingNs, std::memory_order_relaxed);
+        return true;
+    }
+
+    void Insert(const TilingCacheKey &key, const TilingParams &tilingParams, uint64_t tilingNs)
+    {
+        Shard &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            // Another thread computed the same shape concurrently.
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            return;
+        }
+        shard.lru.push_front(TilingCacheRecord{key, tilingParams, tilingNs});
+        shard.index.emplace(key, shard.lru.begin());
+        if (shard.lru.size() > shardCapacity_) {
+            shard.index.erase(shard.lru.back().key);
+            shard.lru.pop_back();
+        }
+    }
+
+    Shard &GetShard(const TilingCacheKey &key)
+    {
+        return shards_[TilingCacheKeyHash{}(key) % shards_.size()];
+    }
+
+    void Unmap()
+    {
+        if (mappedAddr_ != nullptr) {
+            munmap(mappedAddr_, mappedSize_);
+        }
+        mappedAddr_ = nullptr;
+        mappedSize_ = 0;
+        mappedRecords_ = nullptr;
+        mappedCount_ = 0;
+    }
+
+    std::vector<Shard> shards_;
+    size_t shardCapacity_{1};
+
+    void *mappedAddr_{nullptr};
+    size_t mappedSize_{0};
+    const TilingCacheRecord *mappedRecords_{nullptr};
+    size_t mappedCount_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> savedNs_{0};
+    std::atomic<uint64_t> spentNs_{0};
+};
+
+inline void PrintTilingCacheStats(TilingCache &tilingCache)
+{
+    TilingCacheStats stats = tilingCache.GetStats();
+    std::cout << std::dec << "Tiling cache: hits " << stats.hits << ", misses " << stats.misses
+              << ", hit rate " << stats.HitRate() * 100 << "%, entries " << stats.entries
+              << " (+" << stats.mappedEntries << " mapped), host tiling saved " << stats.savedUs
+              << " us, spent " << stats.spentUs << " us" << std::endl;
+}
+
+#endif  // TILING_CACHE_H
@@ -134,8 +134,6 @@ static void Run(const Options &options) {
     uint64_t blockTableSize = static_cast<uint64_t>(
         batch * ((maxKvSeqlen + blockSize - 1) / blockSize) * sizeof(int32_t)
     );
-    // ?????
-    uint32_t tilingSize = sizeof(FATilingData);
 
     // Allocate matrices in host and device memory.
     uint8_t *qSeqHost;
@@ -188,33 +186,10 @@ static void Run(const Options &options) {
     ReadFile(dataPath + "/block_table.bin", blockTableHost, blockTableSize);
     ACL_CHECK(aclrtMemcpy(blockTableDevice, blockTableSize, blockTableHost, blockTableSize, ACL_MEMCPY_HOST_TO_DEVICE));
 
-    // Allocate matrices in device memory for workspace.
-    // One base workspace block contains 65536 elements.
-    uint64_t mm1OutSize = aicCoreNum * FAInferTiling::WORKSPACE_BLOCK_SIZE_DB * sizeof(float) * FAInferTiling::NUM3;
-    uint64_t smOnlineOutSize = aicCoreNum * FAInferTiling::WORKSPACE_BLOCK_SIZE_DB * sizeof(fp16_t)
-                               * FAInferTiling::NUM3;
-    uint64_t mm2OutSize = aicCoreNum * FAInferTiling::WORKSPACE_BLOCK_SIZE_DB * sizeof(float) * FAInferTiling::NUM3;
-    uint64_t UpdateSize = aicCoreNum * FAInferTiling::WORKSPACE_BLOCK_SIZE_DB * sizeof(float) * FAInferTiling::NUM3;
-    uint64_t workSpaceSize = mm1OutSize + smOnlineOutSize + mm2OutSize + UpdateSize;
-
-    uint8_t *sDevice;
-    ACL_CHECK(aclrtMalloc((void **)(&sDevice), mm1OutSize, ACL_MEM_MALLOC_HUGE_FIRST));
-    uint8_t *pDevice;
-    ACL_CHECK(aclrtMalloc((void **)(&pDevice), smOnlineOutSize, ACL_MEM_MALLOC_HUGE_FIRST));
-    uint8_t *oTempDevice;
-    ACL_CHECK(aclrtMalloc((void **)(&oTempDevice), mm2OutSize, ACL_MEM_MALLOC_HUGE_FIRST));
-    uint8_t *oUpdateDevice;
-    ACL_CHECK(aclrtMalloc((void **)(&oUpdateDevice), UpdateSize, ACL_MEM_MALLOC_HUGE_FIRST));
-
     uint8_t *oDevice{nullptr};
     ACL_CHECK(aclrtMalloc((void **)(&oDevice), qoSize * 2, ACL_MEM_MALLOC_HUGE_FIRST));
 
-    uint8_t *tilingDevice;
-    ACL_CHECK(aclrtMalloc((void **)(&tilingDevice), tilingSize, ACL_MEM_MALLOC_HUGE_FIRST));
-
     // get tiling
-    void *tilingHost = nullptr;
-    ACL_CHECK(aclrtMallocHost(&tilingHost, tilingSize));
     uint32_t blockDim = aicCoreNum;
 
     FAInferTiling::FAInfo faInfo;
@@ -230,10 +205,28 @@ static void Run(const Options &options) {
     faInfo.kvSeqlenList = reinterpret_cast<int64_t *>(kvSeqHost);
 
     FATilingData faTilingData;
+    vector<uint32_t> taskList;
 
-    FAInferTiling::GetFATilingParam(faInfo, blockDim, faTilingData);
+    FAInferTiling::GetFATilingParam(faInfo, blockDim, faTilingData, taskList);
 
-    tilingHost = reinterpret_cast<void *>(&faTilingData);
+    // the per-core task list follows the tiling data
+    uint32_t taskListSize = taskList.size() * sizeof(uint32_t);
+    uint32_t tilingSize = sizeof(FATilingData) + taskListSize;
+    void *tilingHost = nullptr;
+    ACL_CHECK(aclrtMallocHost(&tilingHost, tilingSize));
+    memcpy(tilingHost, &faTilingData, sizeof(FATilingData));
+    memcpy(reinterpret_cast<uint8_t *>(tilingHost) + sizeof(FATilingData), taskList.data(), taskListSize);
+
+    // The workspace is planned by the tiling, S, P, OTmp and Update are carved from one allocation.
+    uint8_t *workSpaceDevice;
+    ACL_CHECK(aclrtMalloc((void **)(&workSpaceDevice), faTilingData.workSpaceSize, ACL_MEM_MALLOC_HUGE_FIRST));
+    uint8_t *sDevice = workSpaceDevice + faTilingData.mm1OutOffset;
+    uint8_t *pDevice = workSpaceDevice + faTilingData.smOnlineOutOffset;
+    uint8_t *oTempDevice = workSpaceDevice + faTilingData.mm2OutOffset;
+    uint8_t *oUpdateDevice = workSpaceDevice + faTilingData.UpdateOffset;
+
+    uint8_t *tilingDevice;
+    ACL_CHECK(aclrtMalloc((void **)(&tilingDevice), tilingSize, ACL_MEM_MALLOC_HUGE_FIRST));
 
     uint32_t tilingKey = 0;
 
@@ -293,10 +286,7 @@ static void Run(const Options &options) {
     FreeMem(blockTableHost, blockTableDevice);
     aclrtFree(oDevice);
     aclrtFree(tilingDevice);
-    aclrtFree(sDevice);
-    aclrtFree(pDevice);
-    aclrtFree(oTempDevice);
-    aclrtFree(oUpdateDevice);
+    aclrtFree(workSpaceDevice);
     aclrtFreeHost(tilingHost);
     aclrtFreeHost(qNtokens);
 
@@ -31,6 +31,7 @@ template <
     class BlockMmadPVTail,
     class EpilogueOnlineSoftmax,
     class EpilogueRescaleO,
+    class EpilogueCombineO,
     bool PAGED_CACHE_FLAG>
 class FAInferKernel {
   public:
@@ -105,6 +106,10 @@ class FAInferKernel {
         uint32_t maxNumBlocksPerBatch = fATilingData->maxNumBlocksPerBatch;
         uint32_t curTotalTaskNum = fATilingData->firstBatchTaskNum;
         uint32_t totalTaskNum = fATilingData->totalTaskNum;
+        uint32_t taskListCoreNum = fATilingData->taskListCoreNum;
+        uint32_t workspaceSlotNum = fATilingData->workspaceSlotNum;
+        uint32_t sSlotSize = fATilingData->sSlotSize;
+        uint32_t oTmpSlotSize = fATilingData->oTmpSlotSize;
         uint32_t blockSize = fATilingData->blockSize;
         uint32_t maskType = fATilingData->maskType;
         float scaleValue = fATilingData->scaleValue;
@@ -153,13 +158,15 @@ class FAInferKernel {
         preTotalTaskNum = curTotalTaskNum;
         qSeqlen = reinterpret_cast<int64_t>(gActualQseqlen.GetValue(curBatch));
         kvSeqlen = reinterpret_cast<int64_t>(gActualKvseqlen.GetValue(curBatch));
-        curQSBlockTile = GetQSBlockTile(kvSeqlen);
+        curQSBlockTile = GetQSBlockTile();
         curQNBlockTile = GetQNBlockTile(qSeqlen, groupSize);
         qNBlockNumPerGroup = CeilDiv(groupSize, curQNBlockTile);
         curQNBlockNum = qNBlockNumPerGroup * kvHeads;
         curQSBlockNum = CeilDiv(qSeqlen, curQSBlockTile);
         curTotalTaskNum += curQNBlockNum * curQSBlockNum;
-        for (uint32_t taskIdx = coreIdx; taskIdx < totalTaskNum; taskIdx += uint32_t(coreNum)) {
+        for (FATaskIterator taskIter(params.tiling, taskListCoreNum, totalTaskNum, coreIdx, coreNum);
+             taskIter.IsValid(); taskIter.Next()) {
+            uint32_t taskIdx = taskIter.GetTaskIdx();
             while (taskIdx >= curTotalTaskNum) {
                 ++curBatch;
                 preTotalTaskNum = curTotalTaskNum;
@@ -172,7 +179,7 @@ class FAInferKernel {
                 }
                 qSeqlen = reinterpret_cast<int64_t>(gActualQseqlen.GetValue(curBatch));
                 kvSeqlen = reinterpret_cast<int64_t>(gActualKvseqlen.GetValue(curBatch));
-                curQSBlockTile = GetQSBlockTile(kvSeqlen);
+                curQSBlockTile = GetQSBlockTile();
                 curQNBlockTile = GetQNBlockTile(qSeqlen, groupSize);
                 qNBlockNumPerGroup = CeilDiv(groupSize, curQNBlockTile);
                 curQNBlockNum = qNBlockNumPerGroup * kvHeads;
@@ -205,6 +212,26 @@ class FAInferKernel {
                 noMaskKvS = noSkipKvS - qSBlockSize;
                 noMaskTailS = noMaskKvS % pagedBlockSize;
             }
+            // a piece of a split task covers [kvStart, kvEnd) of the kv, only the last piece runs the masked stage
+            uint32_t taskMaskType = maskType;
+            uint32_t kvStart = 0;
+            if (taskIter.GetSplitNum() > 1) {
+                kvStart = taskIter.GetKvStart();
+                uint32_t kvEnd = taskIter.GetKvEnd();
+                if (kvEnd < noSkipKvS) {
+                    taskMaskType = 0;
+                    noSkipKvS = kvEnd;
+                    noMaskKvS = kvEnd;
+                    noMaskTailS = 0;
+                }
+                noSkipKvS -= kvStart;
+                noMaskKvS -= kvStart;
+            }
+            if constexpr (!PAGED_CACHE_FLAG) {
+                gmKOffset += kvStart * strideKV;
+                gmVOffset += kvStart * strideKV;
+            }
+            uint64_t taskBlockOffset = blockBOffset + kvStart / pagedBlockSize;
             uint32_t maskedKvS = qSBlockSize;
             uint32_t kvSLoopNumNoMask = CeilDiv(noMaskKvS, pagedBlockSize);
             uint32_t kvSLoopNumTotal = CeilDiv(noSkipKvS, pagedBlockSize);
@@ -212,8 +239,8 @@ class FAInferKernel {
             uint32_t stackSeqTile;
             uint32_t stackSeqTileRound = blockStackNum * 128;
             int32_t preLaunch = 2;
-            int32_t totalStackSeqNum = (maskType != 0) ? (CeilDiv(noMaskKvS, blockStackNum * pagedBlockSize) + 1)
-                                                       : CeilDiv(noMaskKvS, blockStackNum * pagedBlockSize);
+            int32_t totalStackSeqNum = (taskMaskType != 0) ? (CeilDiv(noMaskKvS, blockStackNum * pagedBlockSize) + 1)
+                                                           : CeilDiv(noMaskKvS, blockStackNum * pagedBlockSize);
             int32_t stackSeqCount = 0;
 
             LayoutQ layoutQTemp(rowNum, embed);
@@ -228,8 +255,8 @@ class FAInferKernel {
                         stackSeqTile = pagedBlockSize * blockStackNum;
                     }
                     uint32_t SWorkSpacePingPongFlag = stackSeqCount % (preLaunch + 1);
-                    uint64_t gmSOffset = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1)
-                                         + SWorkSpacePingPongFlag * WORKSPACE_BLOCK_SIZE_DB;
+                    uint64_t gmSOffset = coreIdx * sSlotSize * workspaceSlotNum
+                                         + SWorkSpacePingPongFlag * sSlotSize;
                     GemmCoord actualBlockShapeQK{rowNum, stackSeqTile, embed};
                     if constexpr (!PAGED_CACHE_FLAG) {
                         blockMmadQK(
@@ -238,7 +265,7 @@ class FAInferKernel {
                         );
                     } else {
                         blockMmadQK(
-                            gQ[gmQOffset], gK[gmKOffset], gS[gmSOffset], gBlockTable[blockBOffset], layoutQTemp,
+                            gQ[gmQOffset], gK[gmKOffset], gS[gmSOffset], gBlockTable[taskBlockOffset], layoutQTemp,
                             layoutKTemp, actualBlockShapeQK, kvSIdx, kvSLoopNumNoMask, pagedBlockSize, noMaskKvS,
                             strideKV
                         );
@@ -253,10 +280,10 @@ class FAInferKernel {
                         stackSeqTile = pagedBlockSize * blockStackNum;
                     }
                     uint32_t PVWorkSpacePingPongFlag = (stackSeqCount - preLaunch) % (preLaunch + 1);
-                    uint64_t gmPOffset = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1)
-                                         + PVWorkSpacePingPongFlag * WORKSPACE_BLOCK_SIZE_DB;
-                    uint64_t gmOTmpOffset = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1)
-                                            + PVWorkSpacePingPongFlag * WORKSPACE_BLOCK_SIZE_DB;
+                    uint64_t gmPOffset = coreIdx * sSlotSize * workspaceSlotNum
+                                         + PVWorkSpacePingPongFlag * sSlotSize;
+                    uint64_t gmOTmpOffset = coreIdx * oTmpSlotSize * workspaceSlotNum
+                                            + PVWorkSpacePingPongFlag * oTmpSlotSize;
                     LayoutP layoutPTemp(rowNum, stackSeqTileRound);
                     GemmCoord actualBlockShapePV{rowNum, embed, stackSeqTile};
                     if constexpr (!PAGED_CACHE_FLAG) {
@@ -267,9 +294,9 @@ class FAInferKernel {
                         );
                     } else {
                         blockMmadPV(
-                            gP[gmPOffset], gV[gmVOffset], gOTmp[gmOTmpOffset], gBlockTable[blockBOffset], layoutPTemp,
-                            layoutVTemp, actualBlockShapePV, nowkvSIdx, kvSLoopNumNoMask, pagedBlockSize, noMaskKvS,
-                            strideKV, softmaxReady
+                            gP[gmPOffset], gV[gmVOffset], gOTmp[gmOTmpOffset], gBlockTable[taskBlockOffset],
+                            layoutPTemp, layoutVTemp, actualBlockShapePV, nowkvSIdx, kvSLoopNumNoMask, pagedBlockSize,
+                            noMaskKvS, strideKV, softmaxReady
                         );
                     }
                     Arch::CrossCoreSetFlag<0x2, PIPE_FIX>(pvReady);
@@ -285,21 +312,23 @@ class FAInferKernel {
              */
 
             // deal secondary loop conditions
-            uint32_t maskedStartIdx = (maskType != 0) ? ((noMaskTailS != 0) ? (kvSLoopNumNoMask - 1) : kvSLoopNumNoMask)
-                                                      : AlignUp(kvSLoopNumNoMask, blockStackNum);
+            uint32_t maskedStartIdx = (taskMaskType != 0)
+                                          ? ((noMaskTailS != 0) ? (kvSLoopNumNoMask - 1) : kvSLoopNumNoMask)
+                                          : AlignUp(kvSLoopNumNoMask, blockStackNum);
             uint32_t noMaskTailInteStackNum = (noMaskKvS / pagedBlockSize) % blockStackNum;
             noMaskTailInteStackNum = (noMaskTailInteStackNum != 0) ? noMaskTailInteStackNum
                                                                    : ((noMaskTailS != 0) ? 0 : blockStackNum);
-            uint32_t preLaunchStackNum = (maskType != 0) ? ((preLaunch - 1) * blockStackNum + noMaskTailInteStackNum)
-                                                         : (preLaunch * blockStackNum);
+            uint32_t preLaunchStackNum = (taskMaskType != 0)
+                                             ? ((preLaunch - 1) * blockStackNum + noMaskTailInteStackNum)
+                                             : (preLaunch * blockStackNum);
 
             // masked kvSeqlen loop
             for (uint32_t kvSIdx = maskedStartIdx; kvSIdx < kvSLoopNumTotal + preLaunchStackNum;) {
                 if ((kvSIdx < kvSLoopNumTotal) && (stackSeqCount <= totalStackSeqNum - 1)) {
                     stackSeqTile = maskedKvS;
                     uint32_t SWorkSpacePingPongFlag = stackSeqCount % (preLaunch + 1);
-                    uint64_t gmSOffset = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1)
-                                         + SWorkSpacePingPongFlag * WORKSPACE_BLOCK_SIZE_DB;
+                    uint64_t gmSOffset = coreIdx * sSlotSize * workspaceSlotNum
+                                         + SWorkSpacePingPongFlag * sSlotSize;
                     GemmCoord actualBlockShapeQK{rowNum, stackSeqTile, embed};
                     if constexpr (!PAGED_CACHE_FLAG) {
                         blockMmadQKTail(
@@ -309,7 +338,7 @@ class FAInferKernel {
                         );
                     } else {
                         blockMmadQKTail(
-                            gQ[gmQOffset], gK[gmKOffset], gS[gmSOffset], gBlockTable[blockBOffset], layoutQTemp,
+                            gQ[gmQOffset], gK[gmKOffset], gS[gmSOffset], gBlockTable[taskBlockOffset], layoutQTemp,
                             layoutKTemp, actualBlockShapeQK, kvSIdx, kvSLoopNumTotal, pagedBlockSize, noSkipKvS,
                             strideKV, noMaskTailS, 1
                         );
@@ -320,7 +349,7 @@ class FAInferKernel {
                 if (kvSIdx >= preLaunchStackNum) {
                     uint32_t delayedKvSIdx = kvSIdx - preLaunchStackNum;
 
-                    if (delayedKvSIdx + blockStackNum > kvSLoopNumTotal - 1 && (maskType != 0)) {
+                    if (delayedKvSIdx + blockStackNum > kvSLoopNumTotal - 1 && (taskMaskType != 0)) {
                         stackSeqTile = maskedKvS;
                     } else if (delayedKvSIdx + blockStackNum > kvSLoopNumNoMask - 1) {
                         stackSeqTile = noMaskKvS - delayedKvSIdx * pagedBlockSize;
@@ -328,14 +357,14 @@ class FAInferKernel {
                         stackSeqTile = pagedBlockSize * blockStackNum;
                     }
                     uint32_t PVWorkSpacePingPongFlag = (stackSeqCount - preLaunch) % (preLaunch + 1);
-                    uint64_t gmPOffset = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1)
-                                         + PVWorkSpacePingPongFlag * WORKSPACE_BLOCK_SIZE_DB;
-                    uint64_t gmOTmpOffset = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1)
-                                            + PVWorkSpacePingPongFlag * WORKSPACE_BLOCK_SIZE_DB;
+                    uint64_t gmPOffset = coreIdx * sSlotSize * workspaceSlotNum
+                                         + PVWorkSpacePingPongFlag * sSlotSize;
+                    uint64_t gmOTmpOffset = coreIdx * oTmpSlotSize * workspaceSlotNum
+                                            + PVWorkSpacePingPongFlag * oTmpSlotSize;
                     LayoutP layoutPTemp(rowNum, stackSeqTileRound);
                     GemmCoord actualBlockShapePV{rowNum, embed, stackSeqTile};
 
-                    if ((stackSeqCount - preLaunch == totalStackSeqNum - 1) && (maskType != 0)) { // 加mask
+                    if ((stackSeqCount - preLaunch == totalStackSeqNum - 1) && (taskMaskType != 0)) { // 加mask
                         if constexpr (!PAGED_CACHE_FLAG) {
                             blockMmadPVTail(
                                 gP[gmPOffset], gV[gmVOffset], gOTmp[gmOTmpOffset], gBlockTable, layoutPTemp,
@@ -344,7 +373,7 @@ class FAInferKernel {
                             );
                         } else {
                             blockMmadPVTail(
-                                gP[gmPOffset], gV[gmVOffset], gOTmp[gmOTmpOffset], gBlockTable[blockBOffset],
+                                gP[gmPOffset], gV[gmVOffset], gOTmp[gmOTmpOffset], gBlockTable[taskBlockOffset],
                                 layoutPTemp, layoutVTemp, actualBlockShapePV, delayedKvSIdx, kvSLoopNumTotal,
                                 pagedBlockSize, noSkipKvS, strideKV, softmaxReady, noMaskTailS, 1
                             );
@@ -358,7 +387,7 @@ class FAInferKernel {
                             );
                         } else {
                             blockMmadPV(
-                                gP[gmPOffset], gV[gmVOffset], gOTmp[gmOTmpOffset], gBlockTable[blockBOffset],
+                                gP[gmPOffset], gV[gmVOffset], gOTmp[gmOTmpOffset], gBlockTable[taskBlockOffset],
                                 layoutPTemp, layoutVTemp, actualBlockShapePV, delayedKvSIdx, kvSLoopNumNoMask,
                                 pagedBlockSize, noMaskKvS, strideKV, softmaxReady
                             );
@@ -366,7 +395,7 @@ class FAInferKernel {
                     }
                     Arch::CrossCoreSetFlag<0x2, PIPE_FIX>(pvReady);
                 }
-                if ((maskType != 0) && (stackSeqCount - preLaunch == totalStackSeqNum - 2)) {
+                if ((taskMaskType != 0) && (stackSeqCount - preLaunch == totalStackSeqNum - 2)) {
                     kvSIdx += noMaskTailInteStackNum;
                 } else {
                     kvSIdx += blockStackNum;
@@ -425,8 +454,14 @@ class FAInferKernel {
         uint32_t maxNumBlocksPerBatch = fATilingData->maxNumBlocksPerBatch;
         uint32_t firstBatchTaskNum = fATilingData->firstBatchTaskNum;
         uint32_t totalTaskNum = fATilingData->totalTaskNum;
+        uint32_t taskListCoreNum = fATilingData->taskListCoreNum;
+        uint32_t workspaceSlotNum = fATilingData->workspaceSlotNum;
+        uint32_t sSlotSize = fATilingData->sSlotSize;
+        uint32_t oTmpSlotSize = fATilingData->oTmpSlotSize;
         uint32_t maskType = fATilingData->maskType;
         float scaleValue = fATilingData->scaleValue;
+        uint32_t partialRowNum = fATilingData->partialRowNum;
+        uint32_t combineTaskNum = fATilingData->combineTaskNum;
         // Get the memory offset address of the input on Global Memory
         AscendC::GlobalTensor<ElementMask> gMask;
         gMask.SetGlobalBuffer((__gm__ ElementMask *)params.mask);
@@ -447,6 +482,8 @@ class FAInferKernel {
 
         uint32_t groupSize = qHeads / kvHeads;
         uint32_t embedRound = RoundUp(embed, BLOCK_SIZE);
+        // the partial outputs of the split tasks, then the lse of their rows
+        uint64_t lseOffset = static_cast<uint64_t>(fATilingData->partialNum) * partialRowNum * embedRound;
 
         EpilogueOnlineSoftmax epilogueOnlineSoftmax(resource, scaleValue);
         EpilogueRescaleO epilogueRescaleO(resource);
@@ -460,14 +497,16 @@ class FAInferKernel {
         uint32_t curQNBlockTile = GetQNBlockTile(qSeqlen, groupSize);
         uint32_t qNBlockNumPerGroup = CeilDiv(groupSize, curQNBlockTile);
         uint32_t curQNBlockNum = qNBlockNumPerGroup * kvHeads;
-        uint32_t curQSBlockTile = GetQSBlockTile(kvSeqlen);
+        uint32_t curQSBlockTile = GetQSBlockTile();
         uint32_t curQSBlockNum = CeilDiv(qSeqlen, curQSBlockTile);
         uint32_t curTotalTaskNum = firstBatchTaskNum;
 
         uint32_t coreIdx = AscendC::GetBlockIdx() / AscendC::GetSubBlockNum();
         uint32_t coreNum = AscendC::GetBlockNum();
         // Go through each task.
-        for (uint32_t taskIdx = coreIdx; taskIdx < totalTaskNum; taskIdx += uint32_t(coreNum)) {
+        for (FATaskIterator taskIter(params.tiling, taskListCoreNum, totalTaskNum, coreIdx, coreNum);
+             taskIter.IsValid(); taskIter.Next()) {
+            uint32_t taskIdx = taskIter.GetTaskIdx();
             // Get the offset of each core on the GM.
             while (taskIdx >= curTotalTaskNum) {
                 curBatch++;
@@ -478,7 +517,7 @@ class FAInferKernel {
                 curQNBlockTile = GetQNBlockTile(qSeqlen, groupSize);
                 qNBlockNumPerGroup = CeilDiv(groupSize, curQNBlockTile);
                 curQNBlockNum = qNBlockNumPerGroup * kvHeads;
-                curQSBlockTile = GetQSBlockTile(kvSeqlen);
+                curQSBlockTile = GetQSBlockTile();
                 curQSBlockNum = CeilDiv(qSeqlen, curQSBlockTile);
                 curTotalTaskNum += curQNBlockNum * curQSBlockNum;
             }
@@ -511,6 +550,26 @@ class FAInferKernel {
                 noMaskKvS = noSkipKvS - qSBlockSize;
                 noMaskTailS = noMaskKvS % pagedBlockSize;
             }
+            // same kv range of the piece as the cube core, the last stack tile of a piece writes its partial output
+            uint32_t taskMaskType = maskType;
+            uint32_t splitNum = taskIter.GetSplitNum();
+            uint64_t gmOffsetPartial = 0;
+            uint64_t gmOffsetLse = 0;
+            if (splitNum > 1) {
+                uint32_t kvStart = taskIter.GetKvStart();
+                uint32_t kvEnd = taskIter.GetKvEnd();
+                if (kvEnd < noSkipKvS) {
+                    taskMaskType = 0;
+                    noSkipKvS = kvEnd;
+                    noMaskKvS = kvEnd;
+                    noMaskTailS = 0;
+                }
+                noSkipKvS -= kvStart;
+                noMaskKvS -= kvStart;
+                uint64_t partialRowOffset = static_cast<uint64_t>(taskIter.GetPartialIdx()) * partialRowNum;
+                gmOffsetPartial = (partialRowOffset + taskIter.GetSplitIdx()) * embedRound;
+                gmOffsetLse = lseOffset + partialRowOffset + taskIter.GetSplitIdx();
+            }
             uint32_t maskedKvS = qSBlockSize;
             uint32_t kvSLoopNumTotal = CeilDiv(noSkipKvS, pagedBlockSize);
             uint32_t kvSLoopNumNoMask = CeilDiv(noMaskKvS, pagedBlockSize);
@@ -518,8 +577,8 @@ class FAInferKernel {
             uint32_t stackSeqTilePad = blockStackNum * pagedBlockSize;
             uint32_t stackSeqTile;
             int32_t preLaunch = 2;
-            int32_t totalStackSeqNum = (maskType != 0) ? (CeilDiv(noMaskKvS, blockStackNum * pagedBlockSize) + 1)
-                                                       : CeilDiv(noMaskKvS, blockStackNum * pagedBlockSize);
+            int32_t totalStackSeqNum = (taskMaskType != 0) ? (CeilDiv(noMaskKvS, blockStackNum * pagedBlockSize) + 1)
+                                                           : CeilDiv(noMaskKvS, blockStackNum * pagedBlockSize);
             int32_t stackSeqCount = 0;
 
             // no mask kvSeqlen loop
@@ -535,8 +594,8 @@ class FAInferKernel {
                 LayoutP layOutP(rowNum, stackSeqTile, stackSeqTilePad);
                 GemmCoord actualBlockShapeQK{rowNum, stackSeqTile, embed};
                 uint32_t curStackTileMod = stackSeqCount % (preLaunch + 1);
-                uint32_t gmOffsetS = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1) + // cube core offset
-                                     curStackTileMod * WORKSPACE_BLOCK_SIZE_DB;            // single cube core db offset
+                uint32_t gmOffsetS = coreIdx * sSlotSize * workspaceSlotNum + // cube core offset
+                                     curStackTileMod * sSlotSize;            // single cube core db offset
                 // vec core offset will be processed within epilogue block
                 uint32_t gmOffsetP = gmOffsetS;
                 // AscendC::printf("stackSeqCount:%d\n", stackSeqCount);
@@ -559,8 +618,8 @@ class FAInferKernel {
                     LayoutOTmp layoutOTmp(rowNum, embed, embedRound);
                     GemmCoord actualBlockShapePV{rowNum, embed, stackSeqTile};
                     uint32_t curStackTileMod = (stackSeqCount - preLaunch) % (preLaunch + 1);
-                    uint32_t gmOffsetOTmp = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1)
-                                            + curStackTileMod * WORKSPACE_BLOCK_SIZE_DB;
+                    uint32_t gmOffsetOTmp = coreIdx * oTmpSlotSize * workspaceSlotNum
+                                            + curStackTileMod * oTmpSlotSize;
                     Arch::CrossCoreWaitFlag(pvReady);
                     // rescale O
                     epilogueRescaleO(
@@ -577,13 +636,15 @@ class FAInferKernel {
              * stage1(Qk^t/SMOnline) of the last (prelaunch+1) base blocks
              */
             // deal secondary loop conditions
-            uint32_t maskedStartIdx = (maskType != 0) ? ((noMaskTailS != 0) ? (kvSLoopNumNoMask - 1) : kvSLoopNumNoMask)
-                                                      : AlignUp(kvSLoopNumNoMask, blockStackNum);
+            uint32_t maskedStartIdx = (taskMaskType != 0)
+                                          ? ((noMaskTailS != 0) ? (kvSLoopNumNoMask - 1) : kvSLoopNumNoMask)
+                                          : AlignUp(kvSLoopNumNoMask, blockStackNum);
             uint32_t noMaskTailInteStackNum = (noMaskKvS / pagedBlockSize) % blockStackNum;
             noMaskTailInteStackNum = (noMaskTailInteStackNum != 0) ? noMaskTailInteStackNum
                                                                    : ((noMaskTailS != 0) ? 0 : blockStackNum);
-            uint32_t preLaunchStackNum = (maskType != 0) ? ((preLaunch - 1) * blockStackNum + noMaskTailInteStackNum)
-                                                         : (preLaunch * blockStackNum);
+            uint32_t preLaunchStackNum = (taskMaskType != 0)
+                                             ? ((preLaunch - 1) * blockStackNum + noMaskTailInteStackNum)
+                                             : (preLaunch * blockStackNum);
             // masked kvSeqlen loop
             for (uint32_t kvSIdx = maskedStartIdx; kvSIdx < kvSLoopNumTotal + preLaunchStackNum;) {
                 if ((kvSIdx < kvSLoopNumTotal) && (stackSeqCount <= totalStackSeqNum - 1)) {
@@ -594,8 +655,8 @@ class FAInferKernel {
                     LayoutMask layOutMask(1024, 1024, 1024);
                     GemmCoord actualBlockShapeQK{rowNum, stackSeqTile, embed};
                     uint32_t curStackTileMod = stackSeqCount % (preLaunch + 1);
-                    uint32_t gmOffsetS = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1) + // cube core offset
-                                         curStackTileMod * WORKSPACE_BLOCK_SIZE_DB; // single cube core db offset
+                    uint32_t gmOffsetS = coreIdx * sSlotSize * workspaceSlotNum + // cube core offset
+                                         curStackTileMod * sSlotSize; // single cube core db offset
                     // vec core offset will be processed within epilogue block
                     uint32_t gmOffsetP = gmOffsetS;
                     // online softmax
@@ -607,7 +668,7 @@ class FAInferKernel {
                 }
                 if (kvSIdx >= preLaunchStackNum) {
                     uint32_t delayedKvSIdx = kvSIdx - preLaunchStackNum;
-                    if (delayedKvSIdx + blockStackNum > kvSLoopNumTotal - 1 && (maskType != 0)) {
+                    if (delayedKvSIdx + blockStackNum > kvSLoopNumTotal - 1 && (taskMaskType != 0)) {
                         stackSeqTile = maskedKvS;
                     } else if (delayedKvSIdx + blockStackNum > kvSLoopNumNoMask - 1) {
                         stackSeqTile = noMaskKvS - delayedKvSIdx * pagedBlockSize;
@@ -618,17 +679,17 @@ class FAInferKernel {
                     LayoutOTmp layoutOTmp(rowNum, embed, embedRound);
                     GemmCoord actualBlockShapePV{rowNum, embed, stackSeqTile};
                     uint32_t curStackTileMod = (stackSeqCount - preLaunch) % (preLaunch + 1);
-                    uint32_t gmOffsetOTmp = coreIdx * WORKSPACE_BLOCK_SIZE_DB * (preLaunch + 1)
-                                            + curStackTileMod * WORKSPACE_BLOCK_SIZE_DB;
+                    uint32_t gmOffsetOTmp = coreIdx * oTmpSlotSize * workspaceSlotNum
+                                            + curStackTileMod * oTmpSlotSize;
                     Arch::CrossCoreWaitFlag(pvReady);
                     // rescale O
                     epilogueRescaleO(
-                        gO[gmOffsetO], gOTmp[gmOffsetOTmp], layoutO, layoutOTmp, actualBlockShapePV, qSBlockSize,
-                        qNBlockSize, (stackSeqCount - preLaunch == 0),
-                        (stackSeqCount - preLaunch == totalStackSeqNum - 1), curStackTileMod
+                        gO[gmOffsetO], gOTmp[gmOffsetOTmp], gOUpdate[gmOffsetPartial], gOUpdate[gmOffsetLse], layoutO,
+                        layoutOTmp, actualBlockShapePV, qSBlockSize, qNBlockSize, (stackSeqCount - preLaunch == 0),
+                        (stackSeqCount - preLaunch == totalStackSeqNum - 1), curStackTileMod, splitNum
                     );
                 }
-                if ((maskType != 0) && (stackSeqCount - preLaunch == totalStackSeqNum - 2)) {
+                if ((taskMaskType != 0) && (stackSeqCount - preLaunch == totalStackSeqNum - 2)) {
                     kvSIdx += noMaskTailInteStackNum;
                 } else {
                     kvSIdx += blockStackNum;
@@ -649,6 +710,68 @@ class FAInferKernel {
         AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID1);
         AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID2);
         AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID3);
+
+        // combine the pieces of the split tasks once every core wrote its partial outputs
+        if (taskListCoreNum == coreNum && combineTaskNum != 0) {
+            Catlass::Arch::CrossCoreBarrier<0x0, PIPE_MTE3>();
+
+            AscendC::SetAtomicNone();
+            AscendC::SetMaskNorm();
+            AscendC::SetVectorMask<int8_t>((uint64_t)-1, (uint64_t)-1);
+
+            EpilogueCombineO epilogueCombineO(resource);
+            AscendC::GlobalTensor<uint32_t> gCombineList;
+            gCombineList.SetGlobalBuffer(
+                reinterpret_cast<__gm__ uint32_t *>(params.tiling + sizeof(FATilingData))
+                + GetFACombineListOffset(taskListCoreNum, fATilingData->taskItemNum)
+            );
+            uint32_t aivNum = AscendC::GetBlockNum() * AscendC::GetSubBlockNum();
+            uint32_t aivId = AscendC::GetBlockIdx();
+
+            curBatch = 0;
+            oBatchOffset = 0;
+            preTotalTaskNum = 0;
+            qSeqlen = static_cast<uint32_t>(gActualQseqlen.GetValue(curBatch));
+            curQNBlockTile = GetQNBlockTile(qSeqlen, groupSize);
+            qNBlockNumPerGroup = CeilDiv(groupSize, curQNBlockTile);
+            curQNBlockNum = qNBlockNumPerGroup * kvHeads;
+            curQSBlockNum = CeilDiv(qSeqlen, curQSBlockTile);
+            curTotalTaskNum = firstBatchTaskNum;
+            // the combine list is in task order, so each vector core still walks the batches forward
+            for (uint32_t combineIdx = aivId; combineIdx < combineTaskNum; combineIdx += aivNum) {
+                uint32_t taskIdx = gCombineList.GetValue(combineIdx * FA_COMBINE_ITEM_WORDS);
+                uint32_t splitNum = gCombineList.GetValue(combineIdx * FA_COMBINE_ITEM_WORDS + 1);
+                uint32_t partialIdx = gCombineList.GetValue(combineIdx * FA_COMBINE_ITEM_WORDS + 2);
+                while (taskIdx >= curTotalTaskNum) {
+                    curBatch++;
+                    oBatchOffset += qSeqlen * qHeads * embed;
+                    preTotalTaskNum = curTotalTaskNum;
+                    qSeqlen = static_cast<uint32_t>(gActualQseqlen.GetValue(curBatch));
+                    curQNBlockTile = GetQNBlockTile(qSeqlen, groupSize);
+                    qNBlockNumPerGroup = CeilDiv(groupSize, curQNBlockTile);
+                    curQNBlockNum = qNBlockNumPerGroup * kvHeads;
+                    curQSBlockNum = CeilDiv(qSeqlen, curQSBlockTile);
+                    curTotalTaskNum += curQNBlockNum * curQSBlockNum;
+                }
+                uint32_t taskIdxCurBatch = taskIdx - preTotalTaskNum;
+                uint32_t qSBlockIdx = taskIdxCurBatch / curQNBlockNum;
+                uint32_t qNBlockIdx = taskIdxCurBatch % curQNBlockNum;
+                uint32_t qNBlockIdxCurGroup = qNBlockIdx % qNBlockNumPerGroup;
+                uint32_t kvNIdx = qNBlockIdx / qNBlockNumPerGroup;
+                uint32_t qStartNIdx = kvNIdx * groupSize + qNBlockIdxCurGroup * curQNBlockTile;
+                uint32_t gmOffsetO = oBatchOffset + qSBlockIdx * curQSBlockTile * qHeads * embed + qStartNIdx * embed;
+                uint32_t qSBlockSize = (qSBlockIdx == (curQSBlockNum - 1)) ? (qSeqlen - qSBlockIdx * curQSBlockTile)
+                                                                           : curQSBlockTile;
+                uint32_t qNBlockSize = (qNBlockIdxCurGroup == (qNBlockNumPerGroup - 1))
+                                           ? (groupSize - qNBlockIdxCurGroup * curQNBlockTile)
+                                           : curQNBlockTile;
+                uint64_t partialRowOffset = static_cast<uint64_t>(partialIdx) * partialRowNum;
+                epilogueCombineO(
+                    gO[gmOffsetO], gOUpdate[partialRowOffset * embedRound], gOUpdate[lseOffset + partialRowOffset],
+                    qSBlockSize, qNBlockSize, embed, qHeads * embed, splitNum
+                );
+            }
+        }
     }
 
   private:
@@ -739,8 +862,13 @@ CATLASS_GLOBAL void FAInferFp16(
 
     // Kernel level
     // using FAInferKernel = FAInferKernel<BlockMmadQK, BlockMmadPV, EpilogueOnlineSoftmax, EpilogueRescaleO, true>;
+    // Epilogue Block模块，合并沿kv切分的任务的部分输出
+    constexpr uint32_t ComputeEleNum = 4096;
+    using EpilogueCombineO =
+        Epilogue::Block::BlockEpilogue<Epilogue::EpilogueAtlasA2CombineO<ComputeEleNum>, OType, OTmpType>;
     using FAInferKernel = FAInferKernel<
-        BlockMmadQK, BlockMmadPV, BlockMmadQKTail, BlockMmadPVTail, EpilogueOnlineSoftmax, EpilogueRescaleO, true>;
+        BlockMmadQK, BlockMmadPV, BlockMmadQKTail, BlockMmadPVTail, EpilogueOnlineSoftmax, EpilogueRescaleO,
+        EpilogueCombineO, true>;
     FAIKernelParams params{q, k, v, mask, blockTables, actualQseqlen, actualKvseqlen, o, s, p, oTemp, oUpdate, tiling};
 
     // call kernel
@@ -829,8 +957,13 @@ CATLASS_GLOBAL void FAInferBf16(
 
     // Kernel level
     // using FAInferKernel = FAInferKernel<BlockMmadQK, BlockMmadPV, EpilogueOnlineSoftmax, EpilogueRescaleO, true>;
+    // Epilogue Block模块，合并沿kv切分的任务的部分输出
+    constexpr uint32_t ComputeEleNum = 4096;
+    using EpilogueCombineO =
+        Epilogue::Block::BlockEpilogue<Epilogue::EpilogueAtlasA2CombineO<ComputeEleNum>, OType, OTmpType>;
     using FAInferKernel = FAInferKernel<
-        BlockMmadQK, BlockMmadPV, BlockMmadQKTail, BlockMmadPVTail, EpilogueOnlineSoftmax, EpilogueRescaleO, true>;
+        BlockMmadQK, BlockMmadPV, BlockMmadQKTail, BlockMmadPVTail, EpilogueOnlineSoftmax, EpilogueRescaleO,
+        EpilogueCombineO, true>;
     FAIKernelParams params{q, k, v, mask, blockTables, actualQseqlen, actualKvseqlen, o, s, p, oTemp, oUpdate, tiling};
 
     // call kernel
@@ -0,0 +1,260 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef FAI_TASK_PLAN_HPP
+#define FAI_TASK_PLAN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace FAInferTiling {
+
+// Q rows of one task, split between the two vector cores of a cube core
+constexpr uint32_t Q_ROW_NUM_CEIL = 128;
+// kv blocks stacked in one QK^T / PV stage of the kernel
+constexpr uint32_t KV_BLOCK_STACK_NUM = 4;
+// Cost of loading Q and filling the preLaunch stages of a task, in kv tokens
+constexpr uint32_t TASK_FIXED_KV = 512;
+// Extra cost of the masked stage, which loads the mask and runs the tail QK^T / PV kernels
+constexpr uint32_t MASK_FIXED_KV = 128;
+// Cost of merging one partial output row of a split task, in kv tokens
+constexpr uint32_t COMBINE_FIXED_KV = 64;
+// Most pieces a task is split into along kv, the lse of all pieces of a row fit one vector repeat of the combine
+constexpr uint32_t KV_SPLIT_MAX = 64;
+
+inline uint32_t GetQNBlockTile(int64_t qSeqlen, uint32_t groupSize) {
+    uint32_t qRowNumCeil = Q_ROW_NUM_CEIL;
+    // A trick is used to ensure the qN tile is a even number,
+    // thus most tasks have balanced workload between two vec cores,
+    // and each vec core possess no more than 64 rows when all-rounded row num is no larger than 128,
+    // aiding the coding of rescale block
+    uint32_t qNBlockTile = (qRowNumCeil / qSeqlen) / 2 * 2;
+    qNBlockTile = std::min(qNBlockTile, groupSize);
+    qNBlockTile = std::max(qNBlockTile, static_cast<uint32_t>(1));
+    return qNBlockTile;
+}
+
+// The rows of a task are bounded by the L1 tile of the kernel and do not depend on the kv length, a task with long
+// kv is split along kv by the task plan instead
+inline uint32_t GetQSBlockTile() {
+    return Q_ROW_NUM_CEIL;
+}
+
+// Problem the tasks of FAInferKernel are enumerated from
+struct FATaskPlanInfo {
+    uint32_t batch = 0;
+    uint32_t numHeads = 0;
+    uint32_t kvHeads = 0;
+    uint32_t blockSize = 0;
+    bool masked = false;
+    const int64_t *qSeqlenList{nullptr};
+    const int64_t *kvSeqlenList{nullptr};
+    uint32_t coreNum = 0;
+    // Most pieces a task is split into along kv, 1 disables split-KV
+    uint32_t kvSplitMax = KV_SPLIT_MAX;
+};
+
+struct FATask {
+    uint32_t taskIdx = 0;   // index in the task order of the kernel: batch, q seq block, q head block
+    uint32_t batchIdx = 0;
+    uint32_t rowNum = 0;    // q rows, qSBlockSize * qNBlockSize
+    uint32_t kvStart = 0;   // kv range of the piece, an unsplit task covers [0, noSkipKvS) of the kernel
+    uint32_t kvEnd = 0;
+    uint32_t splitIdx = 0;
+    uint32_t splitNum = 1;  // pieces of the task, their partial outputs are merged by the combine step
+    uint32_t partialIdx = 0;  // first partial output slot of a split task, which owns splitNum consecutive slots
+    bool masked = false;    // the piece holds the masked stage
+    uint64_t cost = 0;
+};
+
+struct FATaskPlan {
+    uint32_t coreNum = 0;
+    uint32_t taskNum = 0;                 // tasks of the kernel before split-KV
+    uint32_t partialNum = 0;              // partial output slots, one per piece of the split tasks
+    uint32_t partialRowNum = 0;           // rows of a partial output slot, the most rows of a split task rounded
+    uint64_t combineCost = 0;
+    std::vector<uint32_t> coreOffsets;    // pieces of core i are tasks[coreOffsets[i], coreOffsets[i + 1])
+    std::vector<FATask> tasks;            // in ascending task order, then piece order, on each core
+    std::vector<FATask> splitTasks;       // the split tasks in task order, each with its first slot
+    std::vector<uint64_t> coreCosts;
+
+    // The combine step runs on all cores after the pieces are done
+    uint64_t GetMakespan() const {
+        if (coreNum == 0) {
+            return 0;
+        }
+        uint64_t maxCoreCost = coreCosts.empty() ? 0 : *std::max_element(coreCosts.begin(), coreCosts.end());
+        return maxCoreCost + (combineCost + coreNum - 1) / coreNum;
+    }
+};
+
+// Cost of a piece covering kvLen tokens: cube and vector work grow with the rows rounded to the fractal and the kv
+// tokens, plus the fixed cost of a task.
+inline uint64_t GetFATaskCost(uint32_t rowNum, uint32_t kvLen, bool masked) {
+    uint64_t rowNumRound = (rowNum + 15) / 16 * 16;
+    return rowNumRound * (kvLen + TASK_FIXED_KV + (masked ? MASK_FIXED_KV : 0));
+}
+
+// Tasks in the order FAInferKernel walks them, with the kv length each one really reads.
+inline std::vector<FATask> GetFATasks(const FATaskPlanInfo &info) {
+    std::vector<FATask> tasks;
+    uint32_t groupSize = info.numHeads / info.kvHeads;
+    uint32_t taskIdx = 0;
+    for (uint32_t batchIdx = 0; batchIdx < info.batch; batchIdx++) {
+        int64_t qSeqlen = info.qSeqlenList[batchIdx];
+        int64_t kvSeqlen = info.kvSeqlenList[batchIdx];
+        uint32_t curQNBlockTile = GetQNBlockTile(qSeqlen, groupSize);
+        uint32_t qNBlockNumPerGroup = (groupSize + curQNBlockTile - 1) / curQNBlockTile;
+        uint32_t curQNBlockNum = qNBlockNumPerGroup * info.kvHeads;
+        uint32_t curQSBlockTile = GetQSBlockTile();
+        uint32_t curQSBlockNum = (qSeqlen + curQSBlockTile - 1) / curQSBlockTile;
+        for (uint32_t qSBlockIdx = 0; qSBlockIdx < curQSBlockNum; qSBlockIdx++) {
+            uint32_t qSBlockSize = (qSBlockIdx == curQSBlockNum - 1) ? (qSeqlen - qSBlockIdx * curQSBlockTile)
+                                                                     : curQSBlockTile;
+            // q rows near the start of a masked batch see only the kv before them, none when qSeqlen exceeds
+            // kvSeqlen by more than the rows of the block
+            uint32_t noSkipKvS = kvSeqlen;
+            if (info.masked) {
+                int64_t visibleKvS = static_cast<int64_t>(qSBlockIdx + 1) * curQSBlockTile + kvSeqlen - qSeqlen;
+                noSkipKvS = static_cast<uint32_t>(std::max<int64_t>(std::min(kvSeqlen, visibleKvS), 0));
+            }
+            for (uint32_t qNBlockIdx = 0; qNBlockIdx < curQNBlockNum; qNBlockIdx++) {
+                uint32_t qNBlockIdxCurGroup = qNBlockIdx % qNBlockNumPerGroup;
+                uint32_t qNBlockSize = (qNBlockIdxCurGroup == qNBlockNumPerGroup - 1)
+                                           ? (groupSize - qNBlockIdxCurGroup * curQNBlockTile)
+                                           : curQNBlockTile;
+                FATask task;
+                task.taskIdx = taskIdx++;
+                task.batchIdx = batchIdx;
+                task.rowNum = qSBlockSize * qNBlockSize;
+                task.kvEnd = noSkipKvS;
+                task.masked = info.masked;
+                task.cost = GetFATaskCost(task.rowNum, noSkipKvS, task.masked);
+                tasks.push_back(task);
+            }
+        }
+    }
+    return tasks;
+}
+
+// Split the tasks costing more than a core's share of the work into pieces of whole kv stacks. Only the last piece
+// holds the masked stage, it keeps the partial stack at the end so it is never shorter than the masked stage and the
+// other pieces end before the masked kv. A split task gets a partial output slot per piece.
+inline std::vector<FATask> SplitFATasks(const std::vector<FATask> &tasks, const FATaskPlanInfo &info,
+    FATaskPlan &plan) {
+    uint64_t totalCost = 0;
+    for (const FATask &task : tasks) {
+        totalCost += task.cost;
+    }
+    uint64_t targetCost = (totalCost + info.coreNum - 1) / info.coreNum;
+    uint32_t stackKvS = KV_BLOCK_STACK_NUM * info.blockSize;
+    uint32_t kvSplitMax = std::min({info.kvSplitMax, KV_SPLIT_MAX, info.coreNum});
+
+    std::vector<FATask> pieces;
+    uint32_t maxSplitRowNum = 0;
+    for (const FATask &task : tasks) {
+        uint32_t stackNum = task.kvEnd / stackKvS;
+        uint32_t splitNum = static_cast<uint32_t>((task.cost + targetCost - 1) / targetCost);
+        splitNum = std::min({splitNum, kvSplitMax, stackNum});
+        if (splitNum <= 1) {
+            pieces.push_back(task);
+            continue;
+        }
+        FATask splitTask = task;
+        splitTask.splitNum = splitNum;
+        splitTask.partialIdx = plan.partialNum;
+        plan.splitTasks.push_back(splitTask);
+        plan.partialNum += splitNum;
+        plan.combineCost += static_cast<uint64_t>(task.rowNum) * splitNum * COMBINE_FIXED_KV;
+        maxSplitRowNum = std::max(maxSplitRowNum, task.rowNum);
+        for (uint32_t splitIdx = 0; splitIdx < splitNum; splitIdx++) {
+            FATask piece = splitTask;
+            piece.splitIdx = splitIdx;
+            piece.kvStart = stackNum * splitIdx / splitNum * stackKvS;
+            piece.kvEnd = (splitIdx == splitNum - 1) ? task.kvEnd : stackNum * (splitIdx + 1) / splitNum * stackKvS;
+            piece.masked = task.masked && (splitIdx == splitNum - 1);
+            piece.cost = GetFATaskCost(piece.rowNum, piece.kvEnd - piece.kvStart, piece.masked);
+            pieces.push_back(piece);
+        }
+    }
+    plan.partialRowNum = (maxSplitRowNum + 15) / 16 * 16;
+    return pieces;
+}
+
+// Plan the tasks of FAInferKernel on info.coreNum cores: split the long tasks along kv when allowed, then give the
+// costliest piece left to the least loaded core. Each core walks its pieces in the kernel order, so it still moves
+// through the batches forward only. Without cores the plan is empty.
+inline FATaskPlan GetFATaskPlan(const FATaskPlanInfo &info) {
+    FATaskPlan plan;
+    plan.coreNum = info.coreNum;
+    plan.coreOffsets.push_back(0);
+    if (info.coreNum == 0) {
+        return plan;
+    }
+    std::vector<FATask> tasks = GetFATasks(info);
+    plan.taskNum = static_cast<uint32_t>(tasks.size());
+    if (info.kvSplitMax > 1) {
+        tasks = SplitFATasks(tasks, info, plan);
+    }
+
+    std::vector<uint32_t> order(tasks.size());
+    for (uint32_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&tasks](uint32_t a, uint32_t b) {
+        return tasks[a].cost > tasks[b].cost;
+    });
+    using CoreLoad = std::pair<uint64_t, uint32_t>;
+    std::priority_queue<CoreLoad, std::vector<CoreLoad>, std::greater<CoreLoad>> coreLoads;
+    for (uint32_t coreIdx = 0; coreIdx < info.coreNum; coreIdx++) {
+        coreLoads.push({0, coreIdx});
+    }
+    std::vector<std::vector<uint32_t>> coreTasks(info.coreNum);
+    plan.coreCosts.assign(info.coreNum, 0);
+    for (uint32_t i : order) {
+        CoreLoad coreLoad = coreLoads.top();
+        coreLoads.pop();
+        coreTasks[coreLoad.second].push_back(i);
+        coreLoad.first += tasks[i].cost;
+        plan.coreCosts[coreLoad.second] = coreLoad.first;
+        coreLoads.push(coreLoad);
+    }
+
+    for (std::vector<uint32_t> &curTasks : coreTasks) {
+        // pieces of a task are consecutive in tasks, so the index order is the kernel order
+        std::sort(curTasks.begin(), curTasks.end());
+        for (uint32_t i : curTasks) {
+            plan.tasks.push_back(tasks[i]);
+        }
+        plan.coreOffsets.push_back(static_cast<uint32_t>(plan.tasks.size()));
+    }
+    return plan;
+}
+
+// Makespan of the round-robin order the kernel falls back to without a task list
+inline uint64_t GetRoundRobinMakespan(const FATaskPlanInfo &info) {
+    if (info.coreNum == 0) {
+        return 0;
+    }
+    std::vector<FATask> tasks = GetFATasks(info);
+    std::vector<uint64_t> coreCosts(info.coreNum, 0);
+    for (const FATask &task : tasks) {
+        coreCosts[task.taskIdx % info.coreNum] += task.cost;
+    }
+    return coreCosts.empty() ? 0 : *std::max_element(coreCosts.begin(), coreCosts.end());
+}
+
+} // namespace FAInferTiling
+
+#endif // FAI_TASK_PLAN_HPP
@@ -17,6 +17,9 @@
 #include <string>
 #include <vector>
 
+#include "fai_task_plan.hpp"
+#include "fai_workspace_plan.hpp"
+
 using namespace std;
 namespace FAInferTiling {
 const int32_t NUM0 = 0;
@@ -46,7 +49,6 @@ const int32_t NUM64 = 64;
 const int32_t NUM128 = 128;
 const int32_t NUM256 = 256;
 const int32_t NUM512 = 512;
-const int32_t WORKSPACE_BLOCK_SIZE_DB = 131072;
 
 enum class MaskType {
     NO_MASK = 0,
@@ -83,33 +85,15 @@ void FillBasicTilingData(const FAInfo &faInfo, FATilingData &faTilingData, int64
     faTilingData.scaleValue = scaleValue;
 }
 
-uint32_t GetQNBlockTile(int64_t qSeqlen, uint32_t groupSize) {
-    uint32_t qRowNumCeil = 128;
-    // A trick is used to ensure the qN tile is a even number,
-    // thus most tasks have balanced workload between two vec cores,
-    // and each vec core possess no more than 64 rows when all-rounded row num is no larger than 128,
-    // aiding the coding of rescale block
-    uint32_t qNBlockTile = (qRowNumCeil / qSeqlen) / 2 * 2;
-    qNBlockTile = std::min(qNBlockTile, groupSize);
-    qNBlockTile = std::max(qNBlockTile, static_cast<uint32_t>(1));
-    return qNBlockTile;
-}
-
-uint32_t GetQSBlockTile(int64_t kvSeqlen) {
-    uint32_t qSBlockTile = 128;
-    return qSBlockTile;
-}
-
 void FillSplitCoreTilingData(const FAInfo &faInfo, FATilingData &faTilingData) {
     uint32_t totalTaskNum = 0;
     uint32_t groupSize = faInfo.numHeads / faInfo.kvHeads;
     for (int32_t batchIdx = 0; batchIdx < faInfo.batch; batchIdx++) {
         int64_t qSeqlen = *(faInfo.qSeqlenList + batchIdx);
-        int64_t kvSeqlen = *(faInfo.kvSeqlenList + batchIdx);
         uint32_t curQNBlockTile = GetQNBlockTile(qSeqlen, groupSize);
         uint32_t qNBlockNumPerGroup = (groupSize + curQNBlockTile - 1) / curQNBlockTile;
         uint32_t curQNBlockNum = qNBlockNumPerGroup * faInfo.kvHeads;
-        uint32_t curQSBlockTile = GetQSBlockTile(kvSeqlen);
+        uint32_t curQSBlockTile = GetQSBlockTile();
         uint32_t curQSBlockNum = (qSeqlen + curQSBlockTile - 1) / curQSBlockTile;
         uint32_t curTaskNum = curQNBlockNum * curQSBlockNum;
         if (batchIdx == 0) {
@@ -120,20 +104,64 @@ void FillSplitCoreTilingData(const FAInfo &faInfo, FATilingData &faTilingData) {
     faTilingData.totalTaskNum = totalTaskNum;
 }
 
-void FillWorkSpaceTilingData(uint32_t blockDim, FATilingData &faTilingData) {
-    uint64_t mm1OutSize = blockDim * WORKSPACE_BLOCK_SIZE_DB * NUM4 * NUM3;
-    uint64_t smOnlineOutSize = blockDim * WORKSPACE_BLOCK_SIZE_DB * NUM2 * NUM3;
-    uint64_t mm2OutSize = blockDim * WORKSPACE_BLOCK_SIZE_DB * NUM4 * NUM3;
-    uint64_t UpdateSize = blockDim * WORKSPACE_BLOCK_SIZE_DB * NUM4 * NUM3;
-    uint64_t workSpaceSize = mm1OutSize + smOnlineOutSize + mm2OutSize + UpdateSize;
-    faTilingData.mm1OutSize = mm1OutSize;
-    faTilingData.smOnlineOutSize = smOnlineOutSize;
-    faTilingData.mm2OutSize = mm2OutSize;
-    faTilingData.UpdateSize = UpdateSize;
-    faTilingData.workSpaceSize = workSpaceSize;
+FATaskPlanInfo GetFATaskPlanInfo(const FAInfo &faInfo, uint32_t blockDim) {
+    FATaskPlanInfo planInfo;
+    planInfo.batch = static_cast<uint32_t>(faInfo.batch);
+    planInfo.numHeads = static_cast<uint32_t>(faInfo.numHeads);
+    planInfo.kvHeads = static_cast<uint32_t>(faInfo.kvHeads);
+    planInfo.blockSize = static_cast<uint32_t>(faInfo.blockSize);
+    planInfo.masked = (faInfo.maskType != MaskType::NO_MASK);
+    planInfo.qSeqlenList = faInfo.qSeqlenList;
+    planInfo.kvSeqlenList = faInfo.kvSeqlenList;
+    planInfo.coreNum = blockDim;
+    return planInfo;
+}
+
+// The cost balanced task list is placed right after the tiling data: taskListCoreNum + 1 offsets into the pieces,
+// the pieces of every core in ascending task order, then the split tasks the combine step merges. See
+// kernel_common.hpp for the words of each entry.
+void FillTaskListTilingData(const FAInfo &faInfo, uint32_t blockDim, FATilingData &faTilingData,
+    vector<uint32_t> &taskList) {
+    FATaskPlanInfo planInfo = GetFATaskPlanInfo(faInfo, blockDim);
+    FATaskPlan plan = GetFATaskPlan(planInfo);
+
+    taskList.clear();
+    taskList.insert(taskList.end(), plan.coreOffsets.begin(), plan.coreOffsets.end());
+    for (const FATask &task : plan.tasks) {
+        taskList.insert(taskList.end(),
+            {task.taskIdx, task.kvStart, task.kvEnd, task.splitIdx, task.splitNum, task.partialIdx});
+    }
+    for (const FATask &task : plan.splitTasks) {
+        taskList.insert(taskList.end(), {task.taskIdx, task.splitNum, task.partialIdx});
+    }
+    faTilingData.taskListCoreNum = blockDim;
+    faTilingData.taskItemNum = static_cast<uint32_t>(plan.tasks.size());
+    faTilingData.combineTaskNum = static_cast<uint32_t>(plan.splitTasks.size());
+}
+
+// The workspace is sized from the tasks of the kernel and its buffers are laid out one after another, see
+// fai_workspace_plan.hpp. S and OTmp are float, P has the 2-byte element of Q.
+void FillWorkSpaceTilingData(const FAInfo &faInfo, uint32_t blockDim, FATilingData &faTilingData) {
+    FATaskPlanInfo planInfo = GetFATaskPlanInfo(faInfo, blockDim);
+    FAWorkspacePlan plan = GetFAWorkspacePlan(planInfo, faInfo.embeddingSize, NUM4, NUM2, NUM4);
+    faTilingData.workspaceSlotNum = plan.slotNum;
+    faTilingData.sSlotSize = plan.sSlotSize;
+    faTilingData.oTmpSlotSize = plan.oTmpSlotSize;
+    faTilingData.partialNum = plan.partialNum;
+    faTilingData.partialRowNum = plan.partialRowNum;
+    faTilingData.mm1OutSize = plan.buffers[FA_WORKSPACE_S].size;
+    faTilingData.smOnlineOutSize = plan.buffers[FA_WORKSPACE_P].size;
+    faTilingData.mm2OutSize = plan.buffers[FA_WORKSPACE_O_TMP].size;
+    faTilingData.UpdateSize = plan.buffers[FA_WORKSPACE_O_UPDATE].size;
+    faTilingData.mm1OutOffset = plan.buffers[FA_WORKSPACE_S].offset;
+    faTilingData.smOnlineOutOffset = plan.buffers[FA_WORKSPACE_P].offset;
+    faTilingData.mm2OutOffset = plan.buffers[FA_WORKSPACE_O_TMP].offset;
+    faTilingData.UpdateOffset = plan.buffers[FA_WORKSPACE_O_UPDATE].offset;
+    faTilingData.workSpaceSize = plan.workSpaceSize;
 }
 
-int32_t GetFATilingParam(const FAInfo &faInfo, uint32_t blockDim, FATilingData &faTilingData) {
+int32_t GetFATilingParam(const FAInfo &faInfo, uint32_t blockDim, FATilingData &faTilingData,
+    vector<uint32_t> &taskList) {
     if (faInfo.qSeqlenList == nullptr || faInfo.kvSeqlenList == nullptr) {
         cerr << "[ERROR] pointer tilingData or seq is nullptr." << endl;
         return -1;
@@ -150,7 +178,8 @@ int32_t GetFATilingParam(const FAInfo &faInfo, uint32_t blockDim, FATilingData &
     }
     FillBasicTilingData(faInfo, faTilingData, maxKvSeqlen);
     FillSplitCoreTilingData(faInfo, faTilingData);
-    FillWorkSpaceTilingData(blockDim, faTilingData);
+    FillTaskListTilingData(faInfo, blockDim, faTilingData, taskList);
+    FillWorkSpaceTilingData(faInfo, blockDim, faTilingData);
     return 0;
 }
 } // namespace FAInferTiling
\ No newline at end of file
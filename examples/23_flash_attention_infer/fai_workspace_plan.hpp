@@ -0,0 +1,104 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef FAI_WORKSPACE_PLAN_HPP
+#define FAI_WORKSPACE_PLAN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "fai_task_plan.hpp"
+
+namespace FAInferTiling {
+
+// Stages the cube core runs ahead of the vector cores in FAInferKernel, each workspace ring has one slot more
+constexpr uint32_t PRE_LAUNCH = 2;
+// Rows of a workspace slot are rounded to the fractal
+constexpr uint32_t WORKSPACE_ROW_ALIGN = 16;
+// Offsets of the buffers in the workspace are aligned for the MTE
+constexpr uint64_t WORKSPACE_ALIGN = 512;
+
+// A buffer of the workspace at offset, in bytes
+struct WorkspaceBuffer {
+    uint64_t size = 0;
+    uint64_t offset = 0;
+};
+
+enum FAWorkspaceBufferIdx : uint32_t {
+    FA_WORKSPACE_S = 0,          // QK^T, ElementS
+    FA_WORKSPACE_P,              // softmax of S, ElementP
+    FA_WORKSPACE_O_TMP,          // PV, ElementOTmp
+    FA_WORKSPACE_O_UPDATE,       // partial outputs of the split tasks, ElementOTmp
+    FA_WORKSPACE_BUFFER_NUM
+};
+
+struct FAWorkspacePlan {
+    uint32_t slotNum = 0;        // slots of each ring, stages in flight on a core
+    uint32_t sSlotSize = 0;      // elements of a slot of S and P
+    uint32_t oTmpSlotSize = 0;   // elements of a slot of OTmp
+    uint32_t partialNum = 0;     // partial output slots of O_UPDATE
+    uint32_t partialRowNum = 0;  // rows of a partial output slot
+    std::vector<WorkspaceBuffer> buffers;
+    uint64_t workSpaceSize = 0;
+};
+
+// Sizes the workspace of FAInferKernel from its tasks. Each core owns a ring of slots in S, P and OTmp, a slot holds
+// the stacked kv blocks of one stage for the most q rows of a task, and a ring has one slot per stage in flight.
+// O_UPDATE holds a partial slot per piece of the split tasks of the task plan: the normalized output rows with the
+// embedding rounded, then the lse of every row of every slot.
+inline FAWorkspacePlan GetFAWorkspacePlan(const FATaskPlanInfo &info, uint32_t embeddingSize, uint32_t elementSizeS,
+    uint32_t elementSizeP, uint32_t elementSizeOTmp) {
+    FAWorkspacePlan plan;
+    uint32_t stackKvS = KV_BLOCK_STACK_NUM * info.blockSize;
+    uint32_t maxRowNum = 0;
+    uint32_t maxStageNum = 0;
+    for (const FATask &task : GetFATasks(info)) {
+        maxRowNum = std::max(maxRowNum, task.rowNum);
+        // the masked stage is one stage more, upper bound of totalStackSeqNum of the kernel
+        uint32_t stageNum = (task.kvEnd + stackKvS - 1) / stackKvS + (task.masked ? 1 : 0);
+        stageNum = std::max(stageNum, 1U);
+        maxStageNum = std::max(maxStageNum, stageNum);
+    }
+    plan.buffers.resize(FA_WORKSPACE_BUFFER_NUM);
+    if (maxRowNum == 0 || info.coreNum == 0) {
+        return plan;
+    }
+    uint32_t rowNumRound = (maxRowNum + WORKSPACE_ROW_ALIGN - 1) / WORKSPACE_ROW_ALIGN * WORKSPACE_ROW_ALIGN;
+    uint32_t embedRound = (embeddingSize + WORKSPACE_ROW_ALIGN - 1) / WORKSPACE_ROW_ALIGN * WORKSPACE_ROW_ALIGN;
+    plan.slotNum = std::min(PRE_LAUNCH + 1, maxStageNum);
+    plan.sSlotSize = rowNumRound * stackKvS;
+    plan.oTmpSlotSize = rowNumRound * embedRound;
+
+    uint64_t ringNum = static_cast<uint64_t>(info.coreNum) * plan.slotNum;
+    plan.buffers[FA_WORKSPACE_S].size = ringNum * plan.sSlotSize * elementSizeS;
+    plan.buffers[FA_WORKSPACE_P].size = ringNum * plan.sSlotSize * elementSizeP;
+    plan.buffers[FA_WORKSPACE_O_TMP].size = ringNum * plan.oTmpSlotSize * elementSizeOTmp;
+    FATaskPlan taskPlan = GetFATaskPlan(info);
+    plan.partialNum = taskPlan.partialNum;
+    plan.partialRowNum = taskPlan.partialRowNum;
+    plan.buffers[FA_WORKSPACE_O_UPDATE].size = static_cast<uint64_t>(plan.partialNum) * plan.partialRowNum *
+        (embedRound + 1) * elementSizeOTmp;
+
+    // No two buffers can share space, so they are laid out one after another. The cube core writes a slot of S
+    // while the vector cores still read P and OTmp of the stages before, and a ring is reused every slotNum stages,
+    // so the rings of a core are all live through its whole task loop, and all cores run their task loops at once.
+    // The pieces of a split task write O_UPDATE during the task loop and the combine step reads it after all cores
+    // are done.
+    for (WorkspaceBuffer &buffer : plan.buffers) {
+        buffer.offset = plan.workSpaceSize;
+        plan.workSpaceSize += (buffer.size + WORKSPACE_ALIGN - 1) / WORKSPACE_ALIGN * WORKSPACE_ALIGN;
+    }
+    return plan;
+}
+
+} // namespace FAInferTiling
+
+#endif // FAI_WORKSPACE_PLAN_HPP
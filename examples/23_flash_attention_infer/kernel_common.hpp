@@ -15,7 +15,6 @@ constexpr uint32_t QK_READY_ID = 1;
 constexpr uint32_t SOFTMAX_READY_ID = 2;
 constexpr uint32_t PV_READY_ID = 3;
 constexpr uint32_t BLOCK_SIZE = 16;
-constexpr uint32_t WORKSPACE_BLOCK_SIZE_DB = 131072;
 constexpr uint32_t TMP_SIZE_DECODER = 32768;
 
 constexpr int32_t TILING_BATCH = 0;
@@ -53,6 +52,11 @@ constexpr uint32_t FLOAT_VECTOR_SIZE = 64;
 
 constexpr uint32_t UNIT_BLOCK_STACK_NUM = 4;
 
+// Words of a piece in the task list: taskIdx, kvStart, kvEnd, splitIdx, splitNum, partialIdx
+constexpr uint32_t FA_TASK_ITEM_WORDS = 6;
+// Words of a split task in the combine list: taskIdx, splitNum, partialIdx
+constexpr uint32_t FA_COMBINE_ITEM_WORDS = 3;
+
 template <typename T>
 CATLASS_DEVICE T AlignUp(T a, T b) {
     return (b == 0) ? 0 : (a + b - 1) / b * b;
@@ -81,8 +85,9 @@ uint32_t GetQNBlockTile(uint32_t qSeqlen, uint32_t groupSize) {
     return qNBlockTile;
 }
 
+// Same as the host tiling, the q rows of a task do not depend on the kv length
 CATLASS_DEVICE
-uint32_t GetQSBlockTile(uint32_t kvSeqlen) {
+uint32_t GetQSBlockTile() {
     uint32_t qSBlockTile = 128;
     return qSBlockTile;
 }
@@ -105,6 +110,104 @@ struct FATilingData {
     uint64_t UpdateSize = 0;
     uint64_t workSpaceSize = 0;
     float scaleValue = 0.0;
+    uint32_t taskListCoreNum = 0;
+    uint32_t workspaceSlotNum = 0;
+    uint32_t sSlotSize = 0;
+    uint32_t oTmpSlotSize = 0;
+    uint64_t mm1OutOffset = 0;
+    uint64_t smOnlineOutOffset = 0;
+    uint64_t mm2OutOffset = 0;
+    uint64_t UpdateOffset = 0;
+    uint32_t taskItemNum = 0;
+    uint32_t combineTaskNum = 0;
+    uint32_t partialNum = 0;
+    uint32_t partialRowNum = 0;
+};
+
+// The task list placed after the tiling data, planned for taskListCoreNum cores:
+//   coreOffsets[taskListCoreNum + 1], pieces of core i are items [coreOffsets[i], coreOffsets[i + 1])
+//   items[taskItemNum][FA_TASK_ITEM_WORDS], a split task is cut along kv into splitNum pieces that write their
+//     normalized output and the lse of their rows to the splitNum partial slots from partialIdx, row r of piece
+//     splitIdx at row r * splitNum + splitIdx
+//   combines[combineTaskNum][FA_COMBINE_ITEM_WORDS], the split tasks whose partial slots the combine step merges
+CATLASS_DEVICE
+uint32_t GetFACombineListOffset(uint32_t taskListCoreNum, uint32_t taskItemNum) {
+    return taskListCoreNum + 1 + taskItemNum * FA_TASK_ITEM_WORDS;
+}
+
+// Walks the pieces of one core: the cost balanced task list when it was planned for the launched cores, otherwise
+// every coreNum-th whole task. Either way the task indexes never descend.
+struct FATaskIterator {
+    CATLASS_DEVICE
+    FATaskIterator(
+        GM_ADDR tiling, uint32_t taskListCoreNum, uint32_t totalTaskNum, uint32_t coreIdx, uint32_t coreNum
+    ) {
+        if (taskListCoreNum == coreNum) {
+            taskList.SetGlobalBuffer(reinterpret_cast<__gm__ uint32_t *>(tiling + sizeof(FATilingData)));
+            taskBase = taskListCoreNum + 1;
+            pos = taskList.GetValue(coreIdx);
+            end = taskList.GetValue(coreIdx + 1);
+            step = 1;
+            useTaskList = true;
+        } else {
+            pos = coreIdx;
+            end = totalTaskNum;
+            step = coreNum;
+        }
+    }
+
+    CATLASS_DEVICE
+    bool IsValid() const {
+        return pos < end;
+    }
+
+    CATLASS_DEVICE
+    uint32_t GetTaskIdx() {
+        return useTaskList ? GetItemWord(0) : pos;
+    }
+
+    // kv range of the piece, only meaningful when GetSplitNum() > 1
+    CATLASS_DEVICE
+    uint32_t GetKvStart() {
+        return useTaskList ? GetItemWord(1) : 0;
+    }
+
+    CATLASS_DEVICE
+    uint32_t GetKvEnd() {
+        return useTaskList ? GetItemWord(2) : UINT32_MAX;
+    }
+
+    CATLASS_DEVICE
+    uint32_t GetSplitIdx() {
+        return useTaskList ? GetItemWord(3) : 0;
+    }
+
+    CATLASS_DEVICE
+    uint32_t GetSplitNum() {
+        return useTaskList ? GetItemWord(4) : 1;
+    }
+
+    CATLASS_DEVICE
+    uint32_t GetPartialIdx() {
+        return useTaskList ? GetItemWord(5) : 0;
+    }
+
+    CATLASS_DEVICE
+    void Next() {
+        pos += step;
+    }
+
+    CATLASS_DEVICE
+    uint32_t GetItemWord(uint32_t word) {
+        return taskList.GetValue(taskBase + pos * FA_TASK_ITEM_WORDS + word);
+    }
+
+    AscendC::GlobalTensor<uint32_t> taskList;
+    uint32_t taskBase = 0;
+    uint32_t pos = 0;
+    uint32_t end = 0;
+    uint32_t step = 1;
+    bool useTaskList = false;
 };
 
 struct FAIKernelParams {
@@ -18,6 +18,7 @@
 #include "catlass/catlass.hpp"
 #include "catlass/conv/block/block_conv.hpp"
 #include "catlass/conv/block/block_swizzle.hpp"
+#include "catlass/conv/conv_tile_planner.hpp"
 #include "catlass/conv/device/device_conv.hpp"
 #include "catlass/conv/dispatch_policy.hpp"
 #include "catlass/conv/kernel/conv3d_bias.hpp"
@@ -174,65 +175,71 @@ static void Run(const Options &options) {
     // Get the number of cube cores of the current hardware
     auto aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
 
-    constexpr uint32_t l1AStages = 1;
-    constexpr uint32_t l1BStages = 1;
-    constexpr uint32_t l0AStages = 2;
-    constexpr uint32_t l0BStages = 2;
-    constexpr uint32_t l0CStages = 1;
-    constexpr bool enableUnitFlag = true;
-    using ArchTag = Arch::AtlasA2;
-    using DispatchPolicy =
-        Conv::ConvAtlasA2Pingpong<l1AStages, l1BStages, l0AStages, l0BStages, l0CStages, enableUnitFlag>;
-
-    using FmapType = Gemm::GemmType<half, LayoutFmap>;
-    using FilterType = Gemm::GemmType<half, LayoutFilter>;
-    using BiasType = Gemm::GemmType<half, LayoutBias>;
-    using OutType = Gemm::GemmType<half, LayoutOut>;
-
-    using CoreTileShape = ConvCoreShape<2, 2, 2, 2>;       // nDim, dDim, c1Dim, hwDim
-    using FmapL1TileShape = ConvFmapL1Shape<16, 1, 1>;     // mAL1, kd, c1
-    using FilterL1TileShape = ConvFilterL1Shape<1, 1, 16>; // kd, c1, nBL1
-    using L0TileShape = ConvL0Shape<16, 16, 16>;           // mL0 kL0 nL0
-
-    using BlockConv = Conv::Block::BlockConv<
-        DispatchPolicy, CoreTileShape, FmapL1TileShape, FilterL1TileShape, L0TileShape, FmapType, FilterType, OutType,
-        BiasType>;
-    using BlockEpilogue = void;
-
-    // Swizzle offset is 3 and direction is 0.
-    using BlockScheduler = typename Conv::Block::Conv3dIdentityBlockSwizzle<3, 0>;
-
-    // kernel level
-    using ConvKernel = Conv::Kernel::ConvBias<BlockConv, BlockEpilogue, BlockScheduler>;
-
-    using ConvAdapter = Conv::Device::DeviceConv<ConvKernel>;
-    ConvKernel::Arguments arguments{problemShape, deviceFmap, deviceFilter, deviceOut, deviceBias};
-    ConvAdapter conv_op;
-    conv_op.CanImplement(arguments);
-    size_t sizeWorkspace = conv_op.GetWorkspaceSize(arguments);
-    uint8_t *deviceWorkspace = nullptr;
-    if (sizeWorkspace > 0) {
-        ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceWorkspace), sizeWorkspace, ACL_MEM_MALLOC_HUGE_FIRST));
-    }
-    conv_op.Initialize(arguments, deviceWorkspace);
-    conv_op(stream, aicCoreNum);
-    ACL_CHECK(aclrtSynchronizeStream(stream));
-    if (sizeWorkspace > 0) {
-        ACL_CHECK(aclrtFree(deviceWorkspace));
-    }
-
-    std::vector<fp16_t> hostOut(lenOut);
-    ACL_CHECK(aclrtMemcpy(hostOut.data(), sizeOut, deviceOut, sizeOut, ACL_MEMCPY_DEVICE_TO_HOST));
-
-    std::vector<float> hostGolden(lenOut);
-    const size_t goldenSize = sizeOut * 2;
-    ReadFile("./data/golden.bin", hostGolden.data(), goldenSize);
-
-    std::vector<uint64_t> errorIndices = golden::CompareData(hostOut, hostGolden, kdc1khkw * cin0);
-    if (errorIndices.empty()) {
-        std::cout << "Compare success." << std::endl;
+    // Pick the tile shapes of the layer among those instantiated by the menu
+    using TileMenu = Conv::Conv3dTileMenuAtlasA2;
+    auto tileShapes = TileMenu::GetShapes();
+    Conv::ConvCostModel costModel;
+    costModel.coreNum = aicCoreNum;
+    Conv::ConvTilePlan plan = Conv::PlanConv3dTile(problemShape, tileShapes.data(), TileMenu::SIZE, costModel);
+    if (plan.index < 0) {
+        std::cerr << "No tile shape of the menu fits the problem." << std::endl;
     } else {
-        std::cerr << "Compare failed. Error count: " << errorIndices.size() << std::endl;
+        Conv::Conv3dTileShape const &tile = tileShapes[plan.index];
+        std::cout << "Tile shape " << plan.index << ": core (" << tile.coreN << ", " << tile.coreD << ", "
+                  << tile.coreC1 << ", " << tile.coreHw << "), fmap (" << tile.mAL1 << ", " << tile.fmapKd << ", "
+                  << tile.fmapCi1 << "), filter (" << tile.filterKd << ", " << tile.filterCi1 << ", " << tile.nBL1
+                  << "), L0 (" << tile.mL0 << ", " << tile.kL0 << ", " << tile.nL0
+                  << "), estimated cube utilisation " << plan.estimate.cubeUtilisation << std::endl;
+
+        using FmapType = Gemm::GemmType<half, LayoutFmap>;
+        using FilterType = Gemm::GemmType<half, LayoutFilter>;
+        using BiasType = Gemm::GemmType<half, LayoutBias>;
+        using OutType = Gemm::GemmType<half, LayoutOut>;
+
+        TileMenu::Dispatch(plan.index, [&](auto config) {
+            using Config = decltype(config);
+            using BlockConv = Conv::Block::BlockConv<typename Config::DispatchPolicy, typename Config::CoreTileShape,
+                typename Config::FmapL1TileShape, typename Config::FilterL1TileShape, typename Config::L0TileShape,
+                FmapType, FilterType, OutType, BiasType>;
+            using BlockEpilogue = void;
+
+            // Swizzle offset is 3 and direction is 0.
+            using BlockScheduler = typename Conv::Block::Conv3dIdentityBlockSwizzle<3, 0>;
+
+            // kernel level
+            using ConvKernel = Conv::Kernel::ConvBias<BlockConv, BlockEpilogue, BlockScheduler>;
+
+            using ConvAdapter = Conv::Device::DeviceConv<ConvKernel>;
+            typename ConvKernel::Arguments arguments{problemShape, deviceFmap, deviceFilter, deviceOut, deviceBias};
+            ConvAdapter conv_op;
+            conv_op.CanImplement(arguments);
+            size_t sizeWorkspace = conv_op.GetWorkspaceSize(arguments);
+            uint8_t *deviceWorkspace = nullptr;
+            if (sizeWorkspace > 0) {
+                ACL_CHECK(aclrtMalloc(
+                    reinterpret_cast<void **>(&deviceWorkspace), sizeWorkspace, ACL_MEM_MALLOC_HUGE_FIRST));
+            }
+            conv_op.Initialize(arguments, deviceWorkspace);
+            conv_op(stream, aicCoreNum);
+            ACL_CHECK(aclrtSynchronizeStream(stream));
+            if (sizeWorkspace > 0) {
+                ACL_CHECK(aclrtFree(deviceWorkspace));
+            }
+        });
+
+        std::vector<fp16_t> hostOut(lenOut);
+        ACL_CHECK(aclrtMemcpy(hostOut.data(), sizeOut, deviceOut, sizeOut, ACL_MEMCPY_DEVICE_TO_HOST));
+
+        std::vector<float> hostGolden(lenOut);
+        const size_t goldenSize = sizeOut * 2;
+        ReadFile("./data/golden.bin", hostGolden.data(), goldenSize);
+
+        std::vector<uint64_t> errorIndices = golden::CompareData(hostOut, hostGolden, kdc1khkw * cin0);
+        if (errorIndices.empty()) {
+            std::cout << "Compare success." << std::endl;
+        } else {
+            std::cerr << "Compare failed. Error count: " << errorIndices.size() << std::endl;
+        }
     }
 
     ACL_CHECK(aclrtFree(deviceFmap));
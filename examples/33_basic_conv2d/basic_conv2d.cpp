@@ -20,6 +20,7 @@
 #include "catlass/catlass.hpp"
 #include "catlass/conv/block/block_conv.hpp"
 #include "catlass/conv/block/block_swizzle.hpp"
+#include "catlass/conv/conv_tile_planner.hpp"
 #include "catlass/conv/device/device_conv.hpp"
 #include "catlass/conv/dispatch_policy.hpp"
 #include "catlass/conv_coord.hpp"
@@ -164,62 +165,71 @@ void Run(Options const &options)
     // Get the number of cube cores of the current hardware
     auto aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
 
-    using ArchTag = Arch::AtlasA2;
-    constexpr uint32_t L1A_STAGES = 2;
-    constexpr uint32_t L1B_STAGES = 2;
-    constexpr uint32_t L0A_STAGES = 2;
-    constexpr uint32_t L0B_STAGES = 2;
-    constexpr uint32_t L0C_STAGES = 1;
-    constexpr bool ENABLE_UNIT_FLAG = false;
-    using DispatchPolicy =
-        Conv::ConvAtlasA2Pingpong<L1A_STAGES, L1B_STAGES, L0A_STAGES, L0B_STAGES, L0C_STAGES, ENABLE_UNIT_FLAG>;
-    using FmapL1TileShape = Catlass::Conv2dFmapL1Shape<8, 12, 8>;  // (hoBlock, woBlock, cin1BlockSmall)
-    using FilterL1TileShape = Catlass::Conv2dFilterL1Shape<96, 8>; // (coutBlock, cin1BlockBig)
-    using L0TileShape = Catlass::Conv2dL0Shape<16, 96, 16>;        // (mL0, nL0, kL0)
-
-    using FmapType = Gemm::GemmType<half, LayoutFmap>;
-    using FilterType = Gemm::GemmType<half, LayoutFilter>;
-    using OutputType = Gemm::GemmType<half, LayoutOutput>;
-
-    using BlockConv2d = Conv::Block::BlockConv2d<
-        DispatchPolicy, FmapL1TileShape, FilterL1TileShape, L0TileShape, FmapType, FilterType, OutputType>;
-    using BlockEpilogue = void;
-
-    // Swizzle offset is 3 and direction is 0.
-    using BlockScheduler = typename Conv::Block::Conv2dIdentityBlockSwizzle<3, 0>;
-
-    // kernel level
-    using Conv2dKernel = Conv::Kernel::BasicConv2d<BlockConv2d, BlockEpilogue, BlockScheduler>;
-
-    using Conv2dAdapter = Conv::Device::DeviceConv<Conv2dKernel>;
-    Conv2dKernel::Arguments arguments{options.problemParams, deviceFmap, deviceFilter, deviceOutput};
-    Conv2dAdapter conv2d_op;
-    conv2d_op.CanImplement(arguments);
-    size_t sizeWorkspace = conv2d_op.GetWorkspaceSize(arguments);
-    uint8_t *deviceWorkspace = nullptr;
-    if (sizeWorkspace > 0) {
-        ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceWorkspace), sizeWorkspace, ACL_MEM_MALLOC_HUGE_FIRST));
-    }
-    conv2d_op.Initialize(arguments, deviceWorkspace);
-    conv2d_op(stream, aicCoreNum);
-    ACL_CHECK(aclrtSynchronizeStream(stream));
-    if (sizeWorkspace > 0) {
-        ACL_CHECK(aclrtFree(deviceWorkspace));
-    }
-
-    std::vector<fp16_t> hostOutput(lenOutput);
-    ACL_CHECK(aclrtMemcpy(hostOutput.data(), sizeOutput, deviceOutput, sizeOutput, ACL_MEMCPY_DEVICE_TO_HOST));
-
-    std::vector<float> hostGolden(lenOutput);
-    golden::ComputeConv2d(
-        options.problemParams, hostFmap, layoutFmap, hostFilter, layoutFilter, hostGolden, layoutOutput
-    );
-
-    std::vector<uint64_t> errorIndices = golden::CompareData(hostOutput, hostGolden, cin1 * kh * kw * c0);
-    if (errorIndices.empty()) {
-        std::cout << "Compare success." << std::endl;
+    // Pick the tile shapes of the layer among those instantiated by the menu
+    using TileMenu = Conv::Conv2dTileMenuAtlasA2;
+    auto tileShapes = TileMenu::GetShapes();
+    Conv::ConvCostModel costModel;
+    costModel.coreNum = aicCoreNum;
+    Conv::ConvTilePlan plan = Conv::PlanConv2dTile(options.problemParams, tileShapes.data(), TileMenu::SIZE, costModel);
+    if (plan.index < 0) {
+        std::cerr << "No tile shape of the menu fits the problem." << std::endl;
     } else {
-        std::cerr << "Compare failed. Error count: " << errorIndices.size() << std::endl;
+        Conv::Conv2dTileShape const &tile = tileShapes[plan.index];
+        std::cout << "Tile shape " << plan.index << ": fmap (" << tile.fmapHo << ", " << tile.fmapWo << ", "
+                  << tile.fmapCin1 << "), filter (" << tile.filterCout << ", " << tile.filterCin1 << "), L0 ("
+                  << tile.l0M << ", " << tile.l0N << ", " << tile.l0K << "), estimated cube utilisation "
+                  << plan.estimate.cubeUtilisation << std::endl;
+
+        using FmapType = Gemm::GemmType<half, LayoutFmap>;
+        using FilterType = Gemm::GemmType<half, LayoutFilter>;
+        using OutputType = Gemm::GemmType<half, LayoutOutput>;
+
+        TileMenu::Dispatch(plan.index, [&](auto config) {
+            using Config = decltype(config);
+            using BlockConv2d = Conv::Block::BlockConv2d<typename Config::DispatchPolicy,
+                typename Config::FmapL1TileShape, typename Config::FilterL1TileShape, typename Config::L0TileShape,
+                FmapType, FilterType, OutputType>;
+            using BlockEpilogue = void;
+
+            // Swizzle offset is 3 and direction is 0.
+            using BlockScheduler = typename Conv::Block::Conv2dIdentityBlockSwizzle<3, 0>;
+
+            // kernel level
+            using Conv2dKernel = Conv::Kernel::BasicConv2d<BlockConv2d, BlockEpilogue, BlockScheduler>;
+
+            using Conv2dAdapter = Conv::Device::DeviceConv<Conv2dKernel>;
+            typename Conv2dKernel::Arguments arguments{
+                options.problemParams, deviceFmap, deviceFilter, deviceOutput};
+            Conv2dAdapter conv2d_op;
+            conv2d_op.CanImplement(arguments);
+            size_t sizeWorkspace = conv2d_op.GetWorkspaceSize(arguments);
+            uint8_t *deviceWorkspace = nullptr;
+            if (sizeWorkspace > 0) {
+                ACL_CHECK(aclrtMalloc(
+                    reinterpret_cast<void **>(&deviceWorkspace), sizeWorkspace, ACL_MEM_MALLOC_HUGE_FIRST));
+            }
+            conv2d_op.Initialize(arguments, deviceWorkspace);
+            conv2d_op(stream, aicCoreNum);
+            ACL_CHECK(aclrtSynchronizeStream(stream));
+            if (sizeWorkspace > 0) {
+                ACL_CHECK(aclrtFree(deviceWorkspace));
+            }
+        });
+
+        std::vector<fp16_t> hostOutput(lenOutput);
+        ACL_CHECK(aclrtMemcpy(hostOutput.data(), sizeOutput, deviceOutput, sizeOutput, ACL_MEMCPY_DEVICE_TO_HOST));
+
+        std::vector<float> hostGolden(lenOutput);
+        golden::ComputeConv2d(
+            options.problemParams, hostFmap, layoutFmap, hostFilter, layoutFilter, hostGolden, layoutOutput
+        );
+
+        std::vector<uint64_t> errorIndices = golden::CompareData(hostOutput, hostGolden, cin1 * kh * kw * c0);
+        if (errorIndices.empty()) {
+            std::cout << "Compare success." << std::endl;
+        } else {
+            std::cerr << "Compare failed. Error count: " << errorIndices.size() << std::endl;
+        }
     }
 
     ACL_CHECK(aclrtFree(deviceFmap));
@@ -0,0 +1,241 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// By setting the K_MAX_SHAPE_DIM macro, the dimension of the AscendC Tensor's ShapeInfo is configured to 0,
+// optimizing stack space. If you need to use the ShapeInfo of the AscendC Tensor, please undefine this macro.
+#ifndef K_MAX_SHAPE_DIM
+#define K_MAX_SHAPE_DIM 0
+#endif
+
+#include "catlass/gemm/kernel/prepacked_weight_matmul.hpp"
+
+#include "catlass/arch/arch.hpp"
+#include "catlass/catlass.hpp"
+#include "catlass/gemm/block/block_mmad.hpp"
+#include "catlass/gemm/block/block_swizzle.hpp"
+#include "catlass/gemm/device/device_gemm.hpp"
+#include "catlass/gemm/dispatch_policy.hpp"
+#include "catlass/gemm/gemm_type.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/status.hpp"
+
+#include "golden.hpp"
+#include "helper.hpp"
+#include "weight_prepack.hpp"
+
+using namespace Catlass;
+
+using Options = GemmOptions;
+
+using ArchTag = Arch::AtlasA2;
+using LayoutA = layout::RowMajor;
+using LayoutWeight = layout::RowMajor;
+using LayoutB = prepack::PackedLayout<LayoutWeight>;
+using LayoutC = layout::RowMajor;
+
+template <class MatmulKernel>
+static void Launch(aclrtStream stream, uint32_t aicCoreNum, typename MatmulKernel::Arguments const &arguments)
+{
+    using MatmulAdapter = Gemm::Device::DeviceGemm<MatmulKernel>;
+    MatmulAdapter matmulOp;
+    if (matmulOp.CanImplement(arguments) != Status::kSuccess) {
+        std::cerr << "The packed B does not match the problem shape." << std::endl;
+        return;
+    }
+    // a prepacked B needs no workspace
+    matmulOp.Initialize(arguments, nullptr);
+    matmulOp(stream, aicCoreNum);
+    ACL_CHECK(aclrtSynchronizeStream(stream));
+}
+
+template <class Element>
+static uint8_t *CopyToDevice(std::vector<Element> const &host)
+{
+    size_t size = host.size() * sizeof(Element);
+    uint8_t *device{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&device), size, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(device, size, host.data(), size, ACL_MEMCPY_HOST_TO_DEVICE));
+    return device;
+}
+
+// int8 A and int4 B, B widened to int8 once on the host, C = scalar * A * B in half
+static void RunW4A8(Options const &options, aclrtStream stream, uint32_t aicCoreNum)
+{
+    uint32_t m = options.problemShape.m();
+    uint32_t n = options.problemShape.n();
+    uint32_t k = options.problemShape.k();
+    float scalar = 1.5;
+
+    LayoutA layoutA{m, k};
+    // two int4 in a byte, every row starts at a byte, as W4A8Matmul reads B
+    LayoutWeight layoutWeight{k, n, (n + 1) / 2 * 2};
+    LayoutC layoutC{m, n};
+
+    std::vector<int8_t> hostA(layoutA.Capacity());
+    std::vector<int8_t> hostWeightInt8(layoutWeight.Capacity());
+    golden::FillRandomData<int8_t>(hostA, -16, 16);
+    golden::FillRandomData<int8_t>(hostWeightInt8, -8, 7);
+    std::vector<uint8_t> hostWeight(layoutWeight.Capacity() / 2);
+    for (size_t i = 0; i < hostWeightInt8.size(); ++i) {
+        hostWeight[i / 2] |= static_cast<uint8_t>((hostWeightInt8[i] & 0xF) << ((i % 2) * 4));
+    }
+
+    // done once when the weights are loaded
+    LayoutB layoutB = prepack::MakePackedLayout<int8_t, LayoutWeight>(k, n);
+    std::vector<int8_t> hostB(layoutB.Capacity());
+    prepack::PackInt4ToInt8(hostWeight.data(), layoutWeight, hostB.data(), layoutB);
+
+    uint8_t *deviceA = CopyToDevice(hostA);
+    uint8_t *deviceB = CopyToDevice(hostB);
+    size_t sizeC = layoutC.Capacity() * sizeof(fp16_t);
+    uint8_t *deviceC{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceC), sizeC, ACL_MEM_MALLOC_HUGE_FIRST));
+
+    using AType = Gemm::GemmType<int8_t, LayoutA>;
+    using BType = Gemm::GemmType<int8_t, LayoutB>;
+    using CType = Gemm::GemmType<half, LayoutC>;
+    using DispatchPolicy = Gemm::MmadAtlasA2PingPongWithPrologue<false>;
+    using L1TileShape = GemmShape<128, 256, 512>;
+    using L0TileShape = GemmShape<128, 256, 128>;
+    using TileCopy = Gemm::Tile::TileCopyWithPrologueDeqPerTensor<ArchTag, AType, BType, CType, void, void>;
+    using BlockMmad = Gemm::Block::BlockMmad<DispatchPolicy, L1TileShape, L0TileShape, AType, BType, CType, void,
+        TileCopy>;
+    using BlockScheduler = typename Gemm::Block::GemmIdentityBlockSwizzle<3, 0>;
+    using MatmulKernel = Gemm::Kernel::PrepackedWeightMatmul<BlockMmad, BlockScheduler>;
+    typename MatmulKernel::Arguments arguments{
+        options.problemShape,
+        deviceA, layoutA,
+        deviceB, layoutB,
+        deviceC, layoutC,
+        scalar
+    };
+    Launch<MatmulKernel>(stream, aicCoreNum, arguments);
+
+    std::vector<fp16_t> hostC(layoutC.Capacity());
+    ACL_CHECK(aclrtMemcpy(hostC.data(), sizeC, deviceC, sizeC, ACL_MEMCPY_DEVICE_TO_HOST));
+
+    std::vector<float> scale(n, scalar);
+    std::vector<float> perTokenScale(m, 1.0f);
+    std::vector<float> hostGolden(layoutC.Capacity());
+    golden::QuantMatmul(options.problemShape, hostA, layoutA, hostWeightInt8, LayoutWeight{k, n, (n + 1) / 2 * 2},
+        scale, layout::VectorLayout{n}, perTokenScale, layout::VectorLayout{m}, hostGolden, layoutC);
+
+    std::vector<uint64_t> errorIndices = golden::CompareData(hostC, hostGolden, k);
+    if (errorIndices.empty()) {
+        std::cout << "[W4A8] Compare success." << std::endl;
+    } else {
+        std::cerr << "[W4A8] Compare failed. Error count: " << errorIndices.size() << std::endl;
+    }
+
+    ACL_CHECK(aclrtFree(deviceA));
+    ACL_CHECK(aclrtFree(deviceB));
+    ACL_CHECK(aclrtFree(deviceC));
+}
+
+// half A and int8 B with a scale per channel, B dequantized to half once on the host
+static void RunW8A16(Options const &options, aclrtStream stream, uint32_t aicCoreNum)
+{
+    uint32_t m = options.problemShape.m();
+    uint32_t n = options.problemShape.n();
+    uint32_t k = options.problemShape.k();
+
+    LayoutA layoutA{m, k};
+    LayoutWeight layoutWeight{k, n};
+    LayoutC layoutC{m, n};
+
+    std::vector<fp16_t> hostA(layoutA.Capacity());
+    std::vector<int8_t> hostWeight(layoutWeight.Capacity());
+    golden::FillRandomData<fp16_t>(hostA, -5.0f, 5.0f);
+    golden::FillRandomData<int8_t>(hostWeight, -8, 8);
+
+    prepack::DequantParams deqParams;
+    deqParams.granularity = prepack::DequantGranularity::PER_CHANNEL;
+    deqParams.scale.resize(n);
+    deqParams.zeroPoint.resize(n);
+    golden::FillRandomData<float>(deqParams.scale, 0.5f, 2.0f);
+    golden::FillRandomData<float>(deqParams.zeroPoint, -0.5f, 0.5f);
+
+    // done once when the weights are loaded
+    LayoutB layoutB = prepack::MakePackedLayout<fp16_t, LayoutWeight>(k, n);
+    std::vector<fp16_t> hostB(layoutB.Capacity());
+    prepack::PackInt8ToFp16(hostWeight.data(), layoutWeight, deqParams, hostB.data(), layoutB);
+
+    uint8_t *deviceA = CopyToDevice(hostA);
+    uint8_t *deviceB = CopyToDevice(hostB);
+    size_t sizeC = layoutC.Capacity() * sizeof(fp16_t);
+    uint8_t *deviceC{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceC), sizeC, ACL_MEM_MALLOC_HUGE_FIRST));
+
+    using AType = Gemm::GemmType<half, LayoutA>;
+    using BType = Gemm::GemmType<half, LayoutB>;
+    using CType = Gemm::GemmType<half, LayoutC>;
+    using DispatchPolicy = Gemm::MmadAtlasA2PingPongWithPrologue<true>;
+    using L1TileShape = GemmShape<128, 256, 256>;
+    using L0TileShape = GemmShape<128, 256, 64>;
+    using TileCopy = Gemm::Tile::TileCopyWithProligue<ArchTag, AType, BType, CType, void, void>;
+    using BlockMmad = Gemm::Block::BlockMmad<DispatchPolicy, L1TileShape, L0TileShape, AType, BType, CType, void,
+        TileCopy>;
+    using BlockScheduler = typename Gemm::Block::GemmIdentityBlockSwizzle<3, 0>;
+    using MatmulKernel = Gemm::Kernel::PrepackedWeightMatmul<BlockMmad, BlockScheduler>;
+    typename MatmulKernel::Arguments arguments{
+        options.problemShape,
+        deviceA, layoutA,
+        deviceB, layoutB,
+        deviceC, layoutC
+    };
+    Launch<MatmulKernel>(stream, aicCoreNum, arguments);
+
+    std::vector<fp16_t> hostC(layoutC.Capacity());
+    ACL_CHECK(aclrtMemcpy(hostC.data(), sizeC, deviceC, sizeC, ACL_MEMCPY_DEVICE_TO_HOST));
+
+    // the golden reads the dequantized B through its packed layout
+    std::vector<float> hostGolden(layoutC.Capacity());
+    golden::ComputeMatmul(options.problemShape, hostA, layoutA, hostB, layoutB, hostGolden, layoutC);
+
+    std::vector<uint64_t> errorIndices = golden::CompareData(hostC, hostGolden, k);
+    if (errorIndices.empty()) {
+        std::cout << "[W8A16] Compare success." << std::endl;
+    } else {
+        std::cerr << "[W8A16] Compare failed. Error count: " << errorIndices.size() << std::endl;
+    }
+
+    ACL_CHECK(aclrtFree(deviceA));
+    ACL_CHECK(aclrtFree(deviceB));
+    ACL_CHECK(aclrtFree(deviceC));
+}
+
+static void Run(Options const &options)
+{
+    aclrtStream stream{nullptr};
+
+    ACL_CHECK(aclInit(nullptr));
+    ACL_CHECK(aclrtSetDevice(options.deviceId));
+    ACL_CHECK(aclrtCreateStream(&stream));
+
+    // Get the number of cube cores of the current hardware
+    auto aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
+
+    RunW4A8(options, stream, aicCoreNum);
+    RunW8A16(options, stream, aicCoreNum);
+
+    ACL_CHECK(aclrtDestroyStream(stream));
+    ACL_CHECK(aclrtResetDevice(options.deviceId));
+    ACL_CHECK(aclFinalize());
+}
+
+int main(int argc, const char **argv)
+{
+    Options options;
+    if (options.Parse(argc, argv) != 0) {
+        return -1;
+    }
+    Run(options);
+    return 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// By setting the K_MAX_SHAPE_DIM macro, the dimension of the AscendC Tensor's ShapeInfo is configured to 0,
+// optimizing stack space. If you need to use the ShapeInfo of the AscendC Tensor, please undefine this macro.
+#ifndef K_MAX_SHAPE_DIM
+#define K_MAX_SHAPE_DIM 0
+#endif
+
+#include "catlass/arch/arch.hpp"
+#include "catlass/catlass.hpp"
+#include "catlass/epilogue/block/block_epilogue.hpp"
+#include "catlass/epilogue/dispatch_policy.hpp"
+#include "catlass/epilogue/tile/tile_copy.hpp"
+#include "catlass/epilogue/tile/tile_elemwise_add.hpp"
+#include "catlass/epilogue/tile/tile_elemwise_muls.hpp"
+#include "catlass/gemm/block/block_mmad.hpp"
+#include "catlass/gemm/block/block_swizzle.hpp"
+#include "catlass/gemm/dispatch_policy.hpp"
+#include "catlass/gemm/gemm_type.hpp"
+#include "catlass/gemv/batched_gemv_dispatch.hpp"
+#include "catlass/gemv/block/block_gemv.hpp"
+#include "catlass/gemv/device/device_gemv.hpp"
+#include "catlass/gemv/kernel/kernel_batched_gemv_aic.hpp"
+#include "catlass/gemv/kernel/kernel_batched_gemv_aiv.hpp"
+#include "catlass/gemv/tile/tile_batched_vmad.hpp"
+#include "catlass/gemv/tile/tile_copy.hpp"
+#include "catlass/gemv/tile/tile_vmuls.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/status.hpp"
+
+#include "golden.hpp"
+#include "helper.hpp"
+
+using namespace Catlass;
+
+using ScalarType = float;
+
+using Options = BatchedGemvOptions;
+
+template <class ElementRandom>
+void FillRandomScalarData(ElementRandom &scalarData, ElementRandom low, ElementRandom high) {
+    scalarData = static_cast<ElementRandom>(
+        low + (static_cast<ElementRandom>(rand()) / static_cast<ElementRandom>(RAND_MAX)) * (high - low)
+    );
+}
+
+using ArchTag = Arch::AtlasA2;
+using LayoutA = layout::RowMajor;
+using LayoutVector = layout::VectorLayout;
+
+// Batched gemv on AIV, every tile of A in UB is applied to up to MAX_BATCH vectors
+constexpr uint32_t MAX_BATCH = 16;
+using AivUBTileShape = GemvShape<32, 512>;
+using AivDispatchPolicy = Gemm::BatchedGemvAtlasA2<MAX_BATCH>;
+using AivAType = Gemm::GemmType<half, LayoutA>;
+using AivXType = Gemm::GemmType<half, LayoutVector>;
+using AivYType = Gemm::GemmType<half, LayoutVector>;
+using AivTileCopy = Gemv::Tile::TileCopyGemvAiv<ArchTag, AivAType, AivXType, AivYType, void>;
+using AivTileVmad = Gemv::Tile::TileBatchedVmad<ArchTag, AivAType, AivXType, AivYType>;
+using AivTileVmuls = Gemv::Tile::TileVmuls<ArchTag, AivXType>;
+using AivBlockGemv = Gemv::Block::BlockGemv<
+    AivDispatchPolicy, AivUBTileShape, AivAType, AivXType, AivYType, void, AivTileCopy, AivTileVmad, AivTileVmuls>;
+using AivKernel = Gemv::Kernel::KernelBatchedGemvAiv<AivBlockGemv, void>;
+
+// Batched gemv on AIC, the batch is the m of the matmul X * A^T
+using AicDispatchPolicy = Gemm::MmadAtlasA2Pingpong<true>;
+using AicL1TileShape = GemmShape<MAX_BATCH, 256, 256>;
+using AicL0TileShape = GemmShape<MAX_BATCH, 256, 64>;
+using AicXType = Gemm::GemmType<half, layout::RowMajor>;
+using AicATType = Gemm::GemmType<half, layout::ColumnMajor>;
+using AicWType = Gemm::GemmType<float, layout::RowMajor>;
+using AicBlockMmad = Gemm::Block::BlockMmad<
+    AicDispatchPolicy, AicL1TileShape, AicL0TileShape, AicXType, AicATType, AicWType>;
+using AicBlockScheduler = typename Gemm::Block::GemmIdentityBlockSwizzle<3, 0>;
+
+using EpilogueDispatchPolicy = Epilogue::EpilogueAtlasA2Gemv;
+using AXType = Gemm::GemmType<float, LayoutVector>;
+using YType = Gemm::GemmType<half, LayoutVector>;
+using ZType = Gemm::GemmType<half, LayoutVector>;
+constexpr uint32_t computeLength = 8192;
+using TileElemWiseAddGemv = Epilogue::Tile::TileElemWiseAdd<ArchTag, AXType, computeLength>;
+using TileElemWiseMulsGemv = Epilogue::Tile::TileElemWiseMuls<ArchTag, AXType, computeLength>;
+using EpilogueTileCopy = Epilogue::Tile::TileCopy<ArchTag, YType, AXType, ZType>;
+using AicBlockEpilogue = Epilogue::Block::BlockEpilogue<
+    EpilogueDispatchPolicy, AXType, YType, ZType, TileElemWiseAddGemv, TileElemWiseMulsGemv, EpilogueTileCopy>;
+using AicKernel = Gemv::Kernel::KernelBatchedGemvAic<AicBlockMmad, AicBlockEpilogue, AicBlockScheduler>;
+
+static void CheckResult(const char *tag, uint8_t *deviceZ, size_t sizeZ, const std::vector<float> &hostGolden,
+    uint32_t computeNum)
+{
+    std::vector<fp16_t> hostRes(hostGolden.size());
+    ACL_CHECK(aclrtMemcpy(hostRes.data(), sizeZ, deviceZ, sizeZ, ACL_MEMCPY_DEVICE_TO_HOST));
+    std::vector<uint64_t> errorIndices = golden::CompareData(hostRes, hostGolden, computeNum);
+    if (errorIndices.empty()) {
+        std::cout << "[" << tag << "] Compare success." << std::endl;
+    } else {
+        std::cerr << "[" << tag << "] Compare failed. Error count: " << errorIndices.size() << std::endl;
+    }
+}
+
+static void Run(Options options) {
+    aclrtStream stream{nullptr};
+    ACL_CHECK(aclInit(nullptr));
+    ACL_CHECK(aclrtSetDevice(options.deviceId));
+    ACL_CHECK(aclrtCreateStream(&stream));
+
+    uint32_t batch = options.batch;
+    uint32_t m = options.problemShape.m();
+    uint32_t n = options.problemShape.n();
+
+    size_t lenA = static_cast<size_t>(m) * n;
+    size_t lenX = static_cast<size_t>(batch) * n;
+    size_t lenY = static_cast<size_t>(batch) * m;
+
+    size_t sizeA = lenA * sizeof(fp16_t);
+    size_t sizeX = lenX * sizeof(fp16_t);
+    size_t sizeY = lenY * sizeof(fp16_t);
+
+    LayoutA layoutA{m, n};
+    layout::RowMajor layoutX{batch, n};
+    layout::RowMajor layoutY{batch, m};
+
+    ScalarType alpha{0};
+    ScalarType beta{0};
+    FillRandomScalarData(alpha, -1.0f, 1.0f);
+    FillRandomScalarData(beta, -1.0f, 1.0f);
+
+    std::vector<fp16_t> hostA(lenA);
+    std::vector<fp16_t> hostX(lenX);
+    std::vector<fp16_t> hostY(lenY);
+    golden::FillRandomData<fp16_t>(hostA, -1.0f, 1.0f);
+    golden::FillRandomData<fp16_t>(hostX, -1.0f, 1.0f);
+    golden::FillRandomData<fp16_t>(hostY, -1.0f, 1.0f);
+
+    uint8_t *deviceA{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceA), sizeA, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(deviceA, sizeA, hostA.data(), sizeA, ACL_MEMCPY_HOST_TO_DEVICE));
+
+    uint8_t *deviceX{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceX), sizeX, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(deviceX, sizeX, hostX.data(), sizeX, ACL_MEMCPY_HOST_TO_DEVICE));
+
+    uint8_t *deviceY{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceY), sizeY, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(deviceY, sizeY, hostY.data(), sizeY, ACL_MEMCPY_HOST_TO_DEVICE));
+
+    uint8_t *deviceZ{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceZ), sizeY, ACL_MEM_MALLOC_HUGE_FIRST));
+
+    // Prepare FFTS address
+    uint64_t fftsAddr{0};
+    uint32_t fftsLen{0};
+    RT_CHECK(rtGetC2cCtrlAddr(&fftsAddr, &fftsLen));
+
+    auto aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
+
+    std::vector<float> hostGolden(lenY);
+    golden::ComputeGemvBatch(
+        options.problemShape, batch, alpha, beta, hostA, layoutA, hostX, layoutX, hostY, layoutY, hostGolden, layoutY
+    );
+
+    Gemv::BatchedGemvEstimate estimate = Gemv::EstimateBatchedGemv(options.problemShape, batch, sizeof(fp16_t));
+    std::cout << "Estimated cycles, AIV: " << estimate.aivCycles << ", AIC: " << estimate.aicCycles
+              << ", selected: " << ((estimate.core == Gemv::BatchedGemvCore::AIC) ? "AIC" : "AIV") << std::endl;
+
+    // Both kernels are run here to check them, a caller would run the selected one only
+    {
+        AivKernel::Arguments arguments{options.problemShape, batch, deviceA, deviceX, deviceY, deviceZ, alpha, beta};
+        Gemv::Device::DeviceGemv<AivKernel> gemvOp;
+        gemvOp.CanImplement(arguments);
+        RunAdapter(gemvOp, arguments, stream, aicCoreNum);
+        CheckResult("AIV", deviceZ, sizeY, hostGolden, n);
+    }
+    {
+        AicKernel::Arguments arguments{options.problemShape, batch, alpha, beta, deviceX, deviceA, deviceY, deviceZ};
+        Gemv::Device::DeviceGemv<AicKernel> gemvOp;
+        gemvOp.CanImplement(arguments);
+        RunAdapter(gemvOp, arguments, stream, aicCoreNum, fftsAddr);
+        CheckResult("AIC", deviceZ, sizeY, hostGolden, n);
+    }
+
+    ACL_CHECK(aclrtFree(deviceA));
+    ACL_CHECK(aclrtFree(deviceX));
+    ACL_CHECK(aclrtFree(deviceY));
+    ACL_CHECK(aclrtFree(deviceZ));
+
+    ACL_CHECK(aclrtDestroyStream(stream));
+    ACL_CHECK(aclrtResetDevice(options.deviceId));
+    ACL_CHECK(aclFinalize());
+}
+
+int main(int argc, const char **argv) {
+    Options options;
+    if (options.Parse(argc, argv) != 0) {
+        return -1;
+    }
+    Run(options);
+    return 0;
+}
@@ -0,0 +1,253 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// By setting the K_MAX_SHAPE_DIM macro, the dimension of the AscendC Tensor's ShapeInfo is configured to 0,
+// optimizing stack space. If you need to use the ShapeInfo of the AscendC Tensor, please undefine this macro.
+#ifndef K_MAX_SHAPE_DIM
+#define K_MAX_SHAPE_DIM 0
+#endif
+
+#include "catlass/arch/arch.hpp"
+#include "catlass/catlass.hpp"
+#include "catlass/epilogue/block/block_epilogue.hpp"
+#include "catlass/epilogue/dispatch_policy.hpp"
+#include "catlass/epilogue/tile/tile_broadcast_mul.hpp"
+#include "catlass/epilogue/tile/tile_broadcast_one_blk.hpp"
+#include "catlass/epilogue/tile/tile_swizzle.hpp"
+#include "catlass/gemm/block/block_mmad.hpp"
+#include "catlass/gemm/block/block_swizzle.hpp"
+#include "catlass/gemm/device/device_gemm.hpp"
+#include "catlass/gemm/dispatch_policy.hpp"
+#include "catlass/gemm/gemm_type.hpp"
+#include "catlass/gemm/tile/tile_copy.hpp"
+#include "catlass/gemm/kernel/grouped_matmul_slice_m_per_token_dequant_moe.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/status.hpp"
+
+#include "golden.hpp"
+#include "helper.hpp"
+
+using namespace Catlass;
+
+using Options = GroupedGemmOptions;
+
+// Number of experts every token is routed to
+constexpr uint32_t TOP_K = 8;
+
+static void Run(const Options &options) {
+    aclrtStream stream{nullptr};
+    ACL_CHECK(aclInit(nullptr));
+    ACL_CHECK(aclrtSetDevice(options.deviceId));
+    ACL_CHECK(aclrtCreateStream(&stream));
+
+    // problemCount is the number of experts and m the number of tokens. The grouped matmul has one row per
+    // (token, expert) pair, i.e. m * TOP_K rows sorted by expert.
+    uint32_t problemCount = options.problemCount;
+    uint32_t tokenCount = options.problemShape.m();
+    uint32_t n = options.problemShape.n();
+    uint32_t k = options.problemShape.k();
+    uint32_t topK = (problemCount < TOP_K) ? problemCount : TOP_K;
+    uint32_t m = tokenCount * topK;
+    GemmCoord problemShape{m, n, k};
+
+    size_t lenA = static_cast<size_t>(tokenCount) * k;
+    size_t lenB = static_cast<size_t>(k) * n * problemCount;
+    size_t lenScale = static_cast<size_t>(n) * problemCount;
+    size_t lenPerTokenScale = static_cast<size_t>(tokenCount);
+    size_t lenD = static_cast<size_t>(tokenCount) * n;
+
+    size_t sizeA = lenA * sizeof(int8_t);
+    size_t sizeB = lenB * sizeof(int8_t);
+    size_t sizeScale = lenScale * sizeof(float);
+    size_t sizePerTokenScale = lenPerTokenScale * sizeof(float);
+    size_t sizeTokenIndex = static_cast<size_t>(m) * sizeof(int32_t);
+    size_t sizeRoutingWeight = static_cast<size_t>(m) * sizeof(float);
+    size_t sizeD = lenD * sizeof(fp16_t);
+
+    std::vector<int8_t> hostA(lenA);
+    std::vector<int8_t> hostB(lenB);
+    std::vector<float> hostScale(lenScale);
+    std::vector<float> hostPerTokenScale(lenPerTokenScale);
+    golden::FillRandomData(hostA, -16, 16);
+    golden::FillRandomData(hostB, -16, 16);
+    golden::FillRandomData(hostScale, 0.0, 1.0);
+    golden::FillRandomData(hostPerTokenScale, 0.0, 1.0);
+    auto routing = golden::GenerateMoeRouting(tokenCount, topK, problemCount);
+
+    size_t sizeGroupList = problemCount * sizeof(uint32_t);
+    uint8_t *deviceGroupList{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceGroupList), sizeGroupList, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(
+        deviceGroupList, sizeGroupList, routing.groupList.data(), sizeGroupList, ACL_MEMCPY_HOST_TO_DEVICE
+    ));
+
+    uint8_t *deviceTokenIndex{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceTokenIndex), sizeTokenIndex, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(
+        deviceTokenIndex, sizeTokenIndex, routing.tokenIndex.data(), sizeTokenIndex, ACL_MEMCPY_HOST_TO_DEVICE
+    ));
+
+    uint8_t *deviceRoutingWeight{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceRoutingWeight), sizeRoutingWeight,
+        ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(
+        deviceRoutingWeight, sizeRoutingWeight, routing.routingWeight.data(), sizeRoutingWeight,
+        ACL_MEMCPY_HOST_TO_DEVICE
+    ));
+
+    uint8_t *deviceA{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceA), sizeA, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(deviceA, sizeA, hostA.data(), sizeA, ACL_MEMCPY_HOST_TO_DEVICE));
+
+    uint8_t *deviceB{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceB), sizeB, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(deviceB, sizeB, hostB.data(), sizeB, ACL_MEMCPY_HOST_TO_DEVICE));
+
+    uint8_t *deviceScale{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceScale), sizeScale, ACL_MEM_MALLOC_HUGE_FIRST));
+    ACL_CHECK(aclrtMemcpy(deviceScale, sizeScale, hostScale.data(), sizeScale, ACL_MEMCPY_HOST_TO_DEVICE));
+
+    uint8_t *devicePerTokenScale{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&devicePerTokenScale), sizePerTokenScale, ACL_MEM_MALLOC_HUGE_FIRST)
+    );
+    ACL_CHECK(aclrtMemcpy(
+        devicePerTokenScale, sizePerTokenScale, hostPerTokenScale.data(), sizePerTokenScale, ACL_MEMCPY_HOST_TO_DEVICE
+    ));
+
+    // D is written by the kernel once the top k rows of every token are combined, it needs no init
+    uint8_t *deviceD{nullptr};
+    ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceD), sizeD, ACL_MEM_MALLOC_HUGE_FIRST));
+
+    using LayoutA = layout::RowMajor;
+    using LayoutB = layout::RowMajor;
+    using LayoutD = layout::RowMajor;
+
+    LayoutA layoutA{tokenCount, k};
+    LayoutB layoutB{k, n};
+    LayoutD layoutD{tokenCount, n};
+
+    // Prepare FFTS address
+    uint64_t fftsAddr{0};
+    uint32_t fftsLen{0};
+    RT_CHECK(rtGetC2cCtrlAddr(&fftsAddr, &fftsLen));
+
+    auto aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
+
+    using ArchTag = Arch::AtlasA2;
+    constexpr uint32_t preloadStages = 1;
+    constexpr uint32_t l1Stages = 2;
+    constexpr uint32_t l0AStages = 2;
+    constexpr uint32_t l0BStages = 4;
+    constexpr uint32_t l0CStages = 1;
+    constexpr bool enableUnitFlag = false;
+    constexpr bool enableShuffleK = true;
+    using DispatchPolicy = Gemm::MmadAtlasA2PreloadAsync<
+        preloadStages, l1Stages, l0AStages, l0BStages, l0CStages, enableUnitFlag, enableShuffleK>;
+    using L1TileShape = GemmShape<128, 256, 256>;
+    using L0TileShape = GemmShape<128, 256, 64>;
+
+    using AType = Gemm::GemmType<int8_t, layout::RowMajor>;
+    using BType = Gemm::GemmType<int8_t, LayoutB>;
+    using CType = Gemm::GemmType<int32_t, layout::RowMajor>;
+
+    // The rows of A are gathered by token while they are loaded into L1
+    using TileCopyMmad = Gemm::Tile::TileCopyGatherA<ArchTag, AType, BType, CType>;
+    using BlockMmad = Gemm::Block::BlockMmad<
+        DispatchPolicy, L1TileShape, L0TileShape, AType, BType, CType, void, TileCopyMmad>;
+
+    constexpr uint32_t ubStages = 2;
+    using EpilogueDispatchPolicy = Epilogue::EpilogueAtlasA2PerTokenDequantMoeCombine<ubStages>;
+    using ScaleType = Gemm::GemmType<float, layout::VectorLayout>;
+    using PerTokenScaleType = Gemm::GemmType<float, layout::VectorLayout>;
+    // The weighted rows are added into an fp32 combine buffer in the workspace
+    using DType = Gemm::GemmType<float, layout::RowMajor>;
+
+    using RowBroadcastMulType = Gemm::GemmType<float, layout::RowMajor>;
+    using BroadcastOneBlkType = Gemm::GemmType<float, layout::RowMajor>;
+    using OneBlkColumnBroadcastMulType = Gemm::GemmType<float, layout::RowMajor>;
+
+    using EpilogueTileShape = MatrixShape<32, 256>;
+    using TileRowBroadcastMul = Epilogue::Tile::TileRowBroadcastMul<ArchTag, RowBroadcastMulType, EpilogueTileShape>;
+    using TileBroadcastOneBlk =
+        Epilogue::Tile::TileBroadcastOneBlk<ArchTag, BroadcastOneBlkType, EpilogueTileShape::ROW>;
+    using TileOneBlkColumnBroadcastMul =
+        Epilogue::Tile::TileOneBlkColumnBroadcastMul<ArchTag, OneBlkColumnBroadcastMulType, EpilogueTileShape>;
+    using TileCopy = Epilogue::Tile::TileCopy<ArchTag, CType, ScaleType, PerTokenScaleType, DType>;
+    using TileScheduler = Epilogue::Tile::EpilogueHorizontalTileSwizzle;
+
+    using BlockEpilogue = Epilogue::Block::BlockEpilogue<
+        EpilogueDispatchPolicy, CType, ScaleType, PerTokenScaleType, DType, TileRowBroadcastMul, TileBroadcastOneBlk,
+        TileOneBlkColumnBroadcastMul, TileCopy, TileScheduler>;
+
+    using BlockScheduler = typename Gemm::Block::GemmIdentityBlockSwizzle<3, 0>;
+
+    // The combine buffer is cast to fp16 D once every token is complete
+    constexpr uint32_t computeLength = 32 * 1024 / sizeof(float);
+    using ReduceAdd = Gemm::Kernel::ReduceAdd<ArchTag, float, half, computeLength>;
+
+    // kernel level
+    using MatmulKernel = Gemm::Kernel::GroupedMatmulSliceMPerTokenDequantMoe<
+        BlockMmad, BlockEpilogue, BlockScheduler, ReduceAdd, int32_t>;
+
+    using MatmulAdapter = Gemm::Device::DeviceGemm<MatmulKernel>;
+    MatmulKernel::Arguments arguments{problemShape, problemCount, tokenCount, deviceGroupList,
+        deviceA, deviceTokenIndex, deviceB, deviceScale, devicePerTokenScale, deviceRoutingWeight, deviceD};
+    MatmulAdapter matmulOp;
+    // judge arguments can run
+    matmulOp.CanImplement(arguments);
+    // get workspace
+    size_t sizeWorkspace = matmulOp.GetWorkspaceSize(arguments);
+    uint8_t *deviceWorkspace{nullptr};
+    if (sizeWorkspace > 0) {
+        ACL_CHECK(aclrtMalloc(reinterpret_cast<void **>(&deviceWorkspace), sizeWorkspace, ACL_MEM_MALLOC_HUGE_FIRST));
+    }
+    matmulOp.Initialize(arguments, deviceWorkspace);
+    matmulOp(stream, aicCoreNum, fftsAddr);
+
+    ACL_CHECK(aclrtSynchronizeStream(stream));
+
+    std::vector<fp16_t> hostD(lenD);
+    ACL_CHECK(aclrtMemcpy(hostD.data(), sizeD, deviceD, sizeD, ACL_MEMCPY_DEVICE_TO_HOST));
+
+    std::vector<float> hostGolden(lenD);
+    golden::ComputeMoeFfnPerTokenDequant(
+        options.problemShape, topK, routing.tokenExpert, routing.tokenWeight, hostA, layoutA, hostB, layoutB,
+        hostScale, hostPerTokenScale, hostGolden, layoutD
+    );
+
+    std::vector<uint64_t> errorIndices = golden::CompareData(hostD, hostGolden, k);
+    if (errorIndices.empty()) {
+        std::cout << "Compare success." << std::endl;
+    } else {
+        std::cerr << "Compare failed. Error count: " << errorIndices.size() << std::endl;
+    }
+
+    ACL_CHECK(aclrtFree(deviceA));
+    ACL_CHECK(aclrtFree(deviceB));
+    ACL_CHECK(aclrtFree(deviceScale));
+    ACL_CHECK(aclrtFree(devicePerTokenScale));
+    ACL_CHECK(aclrtFree(deviceTokenIndex));
+    ACL_CHECK(aclrtFree(deviceRoutingWeight));
+    ACL_CHECK(aclrtFree(deviceD));
+    ACL_CHECK(aclrtFree(deviceWorkspace));
+    ACL_CHECK(aclrtFree(deviceGroupList));
+
+    ACL_CHECK(aclrtDestroyStream(stream));
+    ACL_CHECK(aclrtResetDevice(options.deviceId));
+    ACL_CHECK(aclFinalize());
+}
+
+int main(int argc, const char **argv) {
+    Options options;
+    if (options.Parse(argc, argv) == 0) {
+        Run(options);
+    }
+    return 0;
+}
\ No newline at end of file
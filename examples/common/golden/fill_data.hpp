@@ -15,6 +15,7 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <utility>
 
 namespace Catlass::golden {
 
@@ -92,6 +93,63 @@ std::vector<T> GenerateGroupList(uint32_t m, uint32_t problemCount)
     return groupList;
 }
 
+// Routing of a MoE layer. tokenExpert/tokenWeight hold the top k experts of every token and their weights, in token
+// order. tokenIndex/routingWeight hold the same (token, expert) pairs sorted by expert, which are the rows of the
+// grouped matmul, and groupList is the cumulative number of rows of each expert.
+template <typename T = int32_t>
+struct MoeRouting {
+    std::vector<T> tokenExpert;
+    std::vector<float> tokenWeight;
+    std::vector<T> groupList;
+    std::vector<T> tokenIndex;
+    std::vector<float> routingWeight;
+};
+
+// Route every token to topK (at most expertCount) distinct random experts with weights that sum to 1
+template <typename T = int32_t>
+MoeRouting<T> GenerateMoeRouting(uint32_t tokenCount, uint32_t topK, uint32_t expertCount)
+{
+    MoeRouting<T> routing;
+    size_t rowCount = static_cast<size_t>(tokenCount) * topK;
+    routing.tokenExpert.resize(rowCount);
+    routing.tokenWeight.resize(rowCount);
+    std::vector<T> experts(expertCount);
+    for (uint32_t t = 0; t < tokenCount; ++t) {
+        for (uint32_t e = 0; e < expertCount; ++e) {
+            experts[e] = static_cast<T>(e);
+        }
+        float weightSum = 0.0f;
+        for (uint32_t s = 0; s < topK; ++s) {
+            std::swap(experts[s], experts[s + rand() % (expertCount - s)]);
+            float weight = static_cast<float>(rand() % 1000 + 1);
+            routing.tokenExpert[t * topK + s] = experts[s];
+            routing.tokenWeight[t * topK + s] = weight;
+            weightSum += weight;
+        }
+        for (uint32_t s = 0; s < topK; ++s) {
+            routing.tokenWeight[t * topK + s] /= weightSum;
+        }
+    }
+
+    // Counting sort by expert, the tokens of an expert stay in token order
+    std::vector<size_t> rowStart(expertCount + 1, 0);
+    for (size_t i = 0; i < rowCount; ++i) {
+        ++rowStart[routing.tokenExpert[i] + 1];
+    }
+    for (uint32_t e = 0; e < expertCount; ++e) {
+        rowStart[e + 1] += rowStart[e];
+    }
+    routing.groupList.assign(rowStart.begin() + 1, rowStart.end());
+    routing.tokenIndex.resize(rowCount);
+    routing.routingWeight.resize(rowCount);
+    for (size_t i = 0; i < rowCount; ++i) {
+        size_t row = rowStart[routing.tokenExpert[i]]++;
+        routing.tokenIndex[row] = static_cast<T>(i / topK);
+        routing.routingWeight[row] = routing.tokenWeight[i];
+    }
+    return routing;
+}
+
 } // namespace Catlass::golden
 
 #endif // EXAMPLES_COMMON_GOLDEN_FILL_DATA_HPP
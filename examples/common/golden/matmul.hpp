@@ -11,17 +11,24 @@
 #ifndef EXAMPLES_COMMON_GOLDEN_MATMUL_HPP
 #define EXAMPLES_COMMON_GOLDEN_MATMUL_HPP
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 #include "catlass/layout/layout.hpp"
 #include "catlass/gemm_coord.hpp"
 #include "catlass/gemv_coord.hpp"
 
+#include "matmul_engine.hpp"
+
 namespace Catlass::golden {
 
+// Reference loops. The Compute* entry points below dispatch to the blocked engine in matmul_engine.hpp
+// for fp32 golden data and fall back to these otherwise; they are also the baseline of the golden benchmark.
+
 // simple matmul
 template<class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementGolden, class LayoutGolden>
-void ComputeMatmul(
+void ReferenceMatmul(
     const GemmCoord &problemShape,
     const std::vector<ElementA> &dataA, const LayoutA &layoutA,
     const std::vector<ElementB> &dataB, const LayoutB &layoutB,
@@ -46,7 +53,7 @@ void ComputeMatmul(
 // new add
 // simple gemm
 template<typename Element, class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementC, class LayoutC, class ElementGolden, class LayoutGolden>
-void ComputeGemm(
+void ReferenceGemm(
     const GemmCoord &problemShape,
     Element alpha, Element beta,
     const std::vector<ElementA> &dataA, const LayoutA &layoutA,
@@ -96,9 +103,38 @@ void ComputeGemv(
     }
 }
 
+// batched gemv sharing A, row b of X, Y and Golden is the vector b: golden[b] = alpha * A * x[b] + beta * y[b]
+template<typename Element, class ElementA, class LayoutA, class ElementX, class ElementY, class ElementGolden>
+void ComputeGemvBatch(
+    const Catlass::GemvCoord &problemShape, uint32_t batch,
+    Element alpha, Element beta,
+    const std::vector<ElementA> &dataA, const LayoutA &layoutA,
+    const std::vector<ElementX> &dataX, const layout::RowMajor &layoutX,
+    const std::vector<ElementY> &dataY, const layout::RowMajor &layoutY,
+    std::vector<ElementGolden> &dataGolden, const layout::RowMajor &layoutGolden
+)
+{
+    for (uint32_t b = 0; b < batch; ++b) {
+        for (uint32_t i = 0; i < problemShape.m(); ++i) {
+            ElementGolden accumulator = 0;
+            for (uint32_t k = 0; k < problemShape.n(); ++k) {
+                size_t offsetA = layoutA.GetOffset(MakeCoord(i, k));
+                size_t offsetX = layoutX.GetOffset(MakeCoord(b, k));
+                accumulator += static_cast<ElementGolden>(alpha) *
+                              static_cast<ElementGolden>(dataA[offsetA]) *
+                              static_cast<ElementGolden>(dataX[offsetX]);
+            }
+            size_t offsetY = layoutY.GetOffset(MakeCoord(b, i));
+            dataGolden[layoutGolden.GetOffset(MakeCoord(b, i))] = static_cast<ElementGolden>(beta) *
+                                                                  static_cast<ElementGolden>(dataY[offsetY]) +
+                                                                  static_cast<ElementGolden>(accumulator);
+        }
+    }
+}
+
 // simple grouped gemm
 template<typename Element, class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementC, class LayoutC, class ElementGolden, class LayoutGolden>
-void ComputeGroupGemm(
+void ReferenceGroupGemm(
     uint32_t problemCount,
     const std::vector<GemmCoord> &problemShapeList,
     const std::vector<Element> &alphaList,
@@ -145,7 +181,7 @@ void ComputeGroupGemm(
 
 // simple batched matmul
 template<class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementGolden, class LayoutGolden>
-void ComputeBatchedMatmul(
+void ReferenceBatchedMatmul(
     const uint32_t batchedCount, const GemmCoord &problemShape,
     const std::vector<ElementA> &dataA, const LayoutA &layoutA,
     const std::vector<ElementB> &dataB, const LayoutB &layoutB,
@@ -174,7 +210,7 @@ void ComputeBatchedMatmul(
 
 // simple grouped matmul
 template<class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementGolden, class LayoutGolden>
-void ComputeGroupedMatmul(
+void ReferenceGroupedMatmul(
     uint32_t problemCount,
     const std::vector<GemmCoord> &problemShapeList,
     const std::vector<ElementA> &dataA, const std::vector<LayoutA> &layoutAList,
@@ -206,6 +242,172 @@ void ComputeGroupedMatmul(
     }
 }
 
+// blocked matmul
+template<class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementGolden, class LayoutGolden>
+void ComputeMatmul(
+    const GemmCoord &problemShape,
+    const std::vector<ElementA> &dataA, const LayoutA &layoutA,
+    const std::vector<ElementB> &dataB, const LayoutB &layoutB,
+    std::vector<ElementGolden> &dataGolden, const LayoutGolden &layoutGolden
+)
+{
+    if constexpr (!std::is_same_v<ElementGolden, float>) {
+        ReferenceMatmul(problemShape, dataA, layoutA, dataB, layoutB, dataGolden, layoutGolden);
+    } else {
+        detail::BlockedMatmul({problemShape},
+            [&](uint32_t, uint32_t i, uint32_t k) {
+                return static_cast<float>(dataA[layoutA.GetOffset(MakeCoord(i, k))]);
+            },
+            [&](uint32_t, uint32_t k, uint32_t j) {
+                return static_cast<float>(dataB[layoutB.GetOffset(MakeCoord(k, j))]);
+            },
+            [&](uint32_t, uint32_t i, uint32_t j, float accumulator) {
+                dataGolden[layoutGolden.GetOffset(MakeCoord(i, j))] = accumulator;
+            });
+    }
+}
+
+// blocked gemm, alpha is folded into A while packing to keep the reference order (alpha * a) * b
+template<typename Element, class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementC, class LayoutC, class ElementGolden, class LayoutGolden>
+void ComputeGemm(
+    const GemmCoord &problemShape,
+    Element alpha, Element beta,
+    const std::vector<ElementA> &dataA, const LayoutA &layoutA,
+    const std::vector<ElementB> &dataB, const LayoutB &layoutB,
+    const std::vector<ElementC> &dataC, const LayoutC &layoutC,
+    std::vector<ElementGolden> &dataGolden, const LayoutGolden &layoutGolden
+)
+{
+    if constexpr (!std::is_same_v<ElementGolden, float>) {
+        ReferenceGemm(problemShape, alpha, beta, dataA, layoutA, dataB, layoutB, dataC, layoutC,
+            dataGolden, layoutGolden);
+    } else {
+        float alphaGolden = static_cast<float>(alpha);
+        float betaGolden = static_cast<float>(beta);
+        detail::BlockedMatmul({problemShape},
+            [&](uint32_t, uint32_t i, uint32_t k) {
+                return alphaGolden * static_cast<float>(dataA[layoutA.GetOffset(MakeCoord(i, k))]);
+            },
+            [&](uint32_t, uint32_t k, uint32_t j) {
+                return static_cast<float>(dataB[layoutB.GetOffset(MakeCoord(k, j))]);
+            },
+            [&](uint32_t, uint32_t i, uint32_t j, float accumulator) {
+                size_t offsetGolden = layoutGolden.GetOffset(MakeCoord(i, j));
+                dataGolden[offsetGolden] = betaGolden * static_cast<float>(dataC[offsetGolden]) + accumulator;
+            });
+    }
+}
+
+// blocked grouped gemm
+template<typename Element, class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementC, class LayoutC, class ElementGolden, class LayoutGolden>
+void ComputeGroupGemm(
+    uint32_t problemCount,
+    const std::vector<GemmCoord> &problemShapeList,
+    const std::vector<Element> &alphaList,
+    const std::vector<Element> &betaList,
+    const std::vector<ElementA> &dataA, const std::vector<LayoutA> &layoutAList,
+    const std::vector<ElementB> &dataB, const std::vector<LayoutB> &layoutBList,
+    const std::vector<ElementC> &dataC, const std::vector<LayoutC> &layoutCList,
+    std::vector<ElementGolden> &dataGolden, const std::vector<LayoutGolden> &layoutGoldenList
+)
+{
+    if constexpr (!std::is_same_v<ElementGolden, float>) {
+        ReferenceGroupGemm(problemCount, problemShapeList, alphaList, betaList, dataA, layoutAList,
+            dataB, layoutBList, dataC, layoutCList, dataGolden, layoutGoldenList);
+    } else {
+        std::vector<GemmCoord> shapeList(problemShapeList.begin(), problemShapeList.begin() + problemCount);
+        std::vector<size_t> offsetA(problemCount, 0);
+        std::vector<size_t> offsetB(problemCount, 0);
+        std::vector<size_t> offsetC(problemCount, 0);
+        for (uint32_t inGroupId = 1; inGroupId < problemCount; ++inGroupId) {
+            const GemmCoord &prevShape = shapeList[inGroupId - 1];
+            offsetA[inGroupId] = offsetA[inGroupId - 1] + static_cast<size_t>(prevShape.m()) * prevShape.k();
+            offsetB[inGroupId] = offsetB[inGroupId - 1] + static_cast<size_t>(prevShape.k()) * prevShape.n();
+            offsetC[inGroupId] = offsetC[inGroupId - 1] + static_cast<size_t>(prevShape.m()) * prevShape.n();
+        }
+        detail::BlockedMatmul(shapeList,
+            [&](uint32_t g, uint32_t i, uint32_t k) {
+                return static_cast<float>(alphaList[g]) *
+                    static_cast<float>(dataA[offsetA[g] + layoutAList[g].GetOffset(MakeCoord(i, k))]);
+            },
+            [&](uint32_t g, uint32_t k, uint32_t j) {
+                return static_cast<float>(dataB[offsetB[g] + layoutBList[g].GetOffset(MakeCoord(k, j))]);
+            },
+            [&](uint32_t g, uint32_t i, uint32_t j, float accumulator) {
+                size_t offsetGolden = offsetC[g] + layoutGoldenList[g].GetOffset(MakeCoord(i, j));
+                size_t offsetDataC = offsetC[g] + layoutCList[g].GetOffset(MakeCoord(i, j));
+                dataGolden[offsetGolden] = static_cast<float>(betaList[g]) * static_cast<float>(dataC[offsetDataC]) +
+                    accumulator;
+            });
+    }
+}
+
+// blocked batched matmul, all batches share one task list
+template<class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementGolden, class LayoutGolden>
+void ComputeBatchedMatmul(
+    const uint32_t batchedCount, const GemmCoord &problemShape,
+    const std::vector<ElementA> &dataA, const LayoutA &layoutA,
+    const std::vector<ElementB> &dataB, const LayoutB &layoutB,
+    std::vector<ElementGolden> &dataC, const LayoutGolden &layoutGolden
+)
+{
+    if constexpr (!std::is_same_v<ElementGolden, float>) {
+        ReferenceBatchedMatmul(batchedCount, problemShape, dataA, layoutA, dataB, layoutB, dataC, layoutGolden);
+    } else {
+        size_t batchStrideA = static_cast<size_t>(problemShape.m()) * problemShape.k();
+        size_t batchStrideB = static_cast<size_t>(problemShape.k()) * problemShape.n();
+        size_t batchStrideGolden = static_cast<size_t>(problemShape.m()) * problemShape.n();
+        detail::BlockedMatmul(std::vector<GemmCoord>(batchedCount, problemShape),
+            [&](uint32_t batchId, uint32_t i, uint32_t k) {
+                return static_cast<float>(dataA[batchStrideA * batchId + layoutA.GetOffset(MakeCoord(i, k))]);
+            },
+            [&](uint32_t batchId, uint32_t k, uint32_t j) {
+                return static_cast<float>(dataB[batchStrideB * batchId + layoutB.GetOffset(MakeCoord(k, j))]);
+            },
+            [&](uint32_t batchId, uint32_t i, uint32_t j, float accumulator) {
+                dataC[batchStrideGolden * batchId + layoutGolden.GetOffset(MakeCoord(i, j))] = accumulator;
+            });
+    }
+}
+
+// blocked grouped matmul, all groups share one task list
+template<class ElementA, class LayoutA, class ElementB, class LayoutB, class ElementGolden, class LayoutGolden>
+void ComputeGroupedMatmul(
+    uint32_t problemCount,
+    const std::vector<GemmCoord> &problemShapeList,
+    const std::vector<ElementA> &dataA, const std::vector<LayoutA> &layoutAList,
+    const std::vector<ElementB> &dataB, const std::vector<LayoutB> &layoutBList,
+    std::vector<ElementGolden> &dataGolden, const std::vector<LayoutGolden> &layoutGoldenList
+)
+{
+    if constexpr (!std::is_same_v<ElementGolden, float>) {
+        ReferenceGroupedMatmul(problemCount, problemShapeList, dataA, layoutAList, dataB, layoutBList,
+            dataGolden, layoutGoldenList);
+    } else {
+        std::vector<GemmCoord> shapeList(problemShapeList.begin(), problemShapeList.begin() + problemCount);
+        std::vector<size_t> offsetA(problemCount, 0);
+        std::vector<size_t> offsetB(problemCount, 0);
+        std::vector<size_t> offsetGolden(problemCount, 0);
+        for (uint32_t inGroupId = 1; inGroupId < problemCount; ++inGroupId) {
+            const GemmCoord &prevShape = shapeList[inGroupId - 1];
+            offsetA[inGroupId] = offsetA[inGroupId - 1] + static_cast<size_t>(prevShape.m()) * prevShape.k();
+            offsetB[inGroupId] = offsetB[inGroupId - 1] + static_cast<size_t>(prevShape.k()) * prevShape.n();
+            offsetGolden[inGroupId] = offsetGolden[inGroupId - 1] +
+                static_cast<size_t>(prevShape.m()) * prevShape.n();
+        }
+        detail::BlockedMatmul(shapeList,
+            [&](uint32_t g, uint32_t i, uint32_t k) {
+                return static_cast<float>(dataA[offsetA[g] + layoutAList[g].GetOffset(MakeCoord(i, k))]);
+            },
+            [&](uint32_t g, uint32_t k, uint32_t j) {
+                return static_cast<float>(dataB[offsetB[g] + layoutBList[g].GetOffset(MakeCoord(k, j))]);
+            },
+            [&](uint32_t g, uint32_t i, uint32_t j, float accumulator) {
+                dataGolden[offsetGolden[g] + layoutGoldenList[g].GetOffset(MakeCoord(i, j))] = accumulator;
+            });
+    }
+}
+
 // matmul add
 template<
     class ElementA, class LayoutA,
@@ -272,6 +474,50 @@ void ComputeGroupedMatmulPerTokenDequant(
     }
 }
 
+// MoE expert projection with per token dequant and the combine, computed token by token from the routing in token
+// order, so it does not depend on the rows sorted by expert:
+// golden[t][j] = sum over the top k experts e of token t of
+//     weight(t, e) * (A[t] . B[e][:, j]) * scale[e][j] * perTokenScale[t]
+template <
+    class ElementExpert, class ElementScale, class LayoutB
+>
+void ComputeMoeFfnPerTokenDequant(
+    const GemmCoord &problemShape, uint32_t topK,
+    const std::vector<ElementExpert> &tokenExpert, const std::vector<float> &tokenWeight,
+    const std::vector<int8_t> &dataA, const layout::RowMajor &layoutA,
+    const std::vector<int8_t> &dataB, const LayoutB &layoutB,
+    const std::vector<ElementScale> &dataScale,
+    const std::vector<ElementScale> &dataPerTokenScale,
+    std::vector<float> &dataGolden, const layout::RowMajor &layoutGolden
+)
+{
+    std::vector<int32_t> accumulator(problemShape.n());
+    for (uint32_t t = 0; t < problemShape.m(); ++t) {
+        for (uint32_t j = 0; j < problemShape.n(); ++j) {
+            dataGolden[layoutGolden.GetOffset(MakeCoord(t, j))] = 0.0f;
+        }
+        for (uint32_t s = 0; s < topK; ++s) {
+            size_t expert = static_cast<size_t>(tokenExpert[static_cast<size_t>(t) * topK + s]);
+            float weight = tokenWeight[static_cast<size_t>(t) * topK + s];
+            size_t expertOffsetB = expert * problemShape.k() * problemShape.n();
+            size_t expertOffsetScale = expert * problemShape.n();
+            // Accumulate along k in the outer loop, every token goes through topK experts
+            std::fill(accumulator.begin(), accumulator.end(), 0);
+            for (uint32_t k = 0; k < problemShape.k(); ++k) {
+                int32_t valueA = static_cast<int32_t>(dataA[layoutA.GetOffset(MakeCoord(t, k))]);
+                for (uint32_t j = 0; j < problemShape.n(); ++j) {
+                    size_t offsetB = expertOffsetB + layoutB.GetOffset(MakeCoord(k, j));
+                    accumulator[j] += valueA * static_cast<int32_t>(dataB[offsetB]);
+                }
+            }
+            for (uint32_t j = 0; j < problemShape.n(); ++j) {
+                dataGolden[layoutGolden.GetOffset(MakeCoord(t, j))] += weight * static_cast<float>(accumulator[j]) *
+                    static_cast<float>(dataScale[expertOffsetScale + j]) * static_cast<float>(dataPerTokenScale[t]);
+            }
+        }
+    }
+}
+
 template <
     class LayoutA,
     class LayoutB,
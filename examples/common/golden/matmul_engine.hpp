@@ -0,0 +1,220 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef EXAMPLES_COMMON_GOLDEN_MATMUL_ENGINE_HPP
+#define EXAMPLES_COMMON_GOLDEN_MATMUL_ENGINE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "catlass/gemm_coord.hpp"
+
+// Cache-blocked, multithreaded fp32-accumulate matmul engine used by the golden functions.
+//
+// Each output element is still accumulated as `acc += a * b` over k in ascending order, starting from zero,
+// exactly like the reference loops. Operands are converted to float once while being packed into panels and
+// the micro-kernel vectorizes across the N dimension only, so every lane performs the same scalar sequence
+// as the reference and the result is bit-identical to it.
+namespace Catlass::golden::detail {
+
+#if defined(__AVX512F__)
+constexpr uint32_t GOLDEN_SIMD_BYTES = 64;
+#elif defined(__AVX__)
+constexpr uint32_t GOLDEN_SIMD_BYTES = 32;
+#else
+// SSE on x86 and NEON on aarch64
+constexpr uint32_t GOLDEN_SIMD_BYTES = 16;
+#endif
+
+// GCC/Clang vector extension, lowered to AVX-512/AVX2/NEON registers depending on the host target.
+// Element-wise operators keep the same floating point contraction rules as the scalar reference.
+typedef float GoldenVec __attribute__((vector_size(GOLDEN_SIMD_BYTES)));
+
+constexpr uint32_t GOLDEN_VEC_LEN = GOLDEN_SIMD_BYTES / sizeof(float);
+// Register block of the micro-kernel: MR rows x NR columns of accumulators.
+constexpr uint32_t GOLDEN_MR = 6;
+constexpr uint32_t GOLDEN_NR_VEC = 2;
+constexpr uint32_t GOLDEN_NR = GOLDEN_NR_VEC * GOLDEN_VEC_LEN;
+// Cache block sizes: A panel MC x KC stays in L2, B panel KC x NC is shared by all A panels of one tile.
+constexpr uint32_t GOLDEN_MC = GOLDEN_MR * 16;
+constexpr uint32_t GOLDEN_NC = 256;
+constexpr uint32_t GOLDEN_KC = 256;
+
+static_assert(GOLDEN_NC % GOLDEN_NR == 0, "GOLDEN_NC must be a multiple of GOLDEN_NR");
+
+inline uint32_t GetGoldenThreadNum()
+{
+    // CATLASS_GOLDEN_THREAD_NUM overrides the number of worker threads, 1 disables multithreading.
+    const char *env = std::getenv("CATLASS_GOLDEN_THREAD_NUM");
+    if (env != nullptr) {
+        long threadNum = std::strtol(env, nullptr, 10);
+        if (threadNum > 0) {
+            return static_cast<uint32_t>(threadNum);
+        }
+    }
+    uint32_t hardwareThreadNum = std::thread::hardware_concurrency();
+    return hardwareThreadNum == 0 ? 1 : hardwareThreadNum;
+}
+
+// Run func(taskIdx) for every task in [0, taskNum) on a pool of worker threads draining a shared counter.
+template <class Func>
+void ParallelFor(uint32_t taskNum, Func &&func)
+{
+    uint32_t threadNum = std::min(GetGoldenThreadNum(), taskNum);
+    std::atomic<uint32_t> nextTask{0};
+    auto worker = [&]() {
+        for (uint32_t taskIdx = nextTask.fetch_add(1); taskIdx < taskNum; taskIdx = nextTask.fetch_add(1)) {
+            func(taskIdx);
+        }
+    };
+    if (threadNum <= 1) {
+        worker();
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(threadNum - 1);
+    for (uint32_t i = 0; i + 1 < threadNum; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+inline GoldenVec LoadVec(const float *ptr)
+{
+    GoldenVec vec;
+    std::memcpy(&vec, ptr, sizeof(GoldenVec));
+    return vec;
+}
+
+inline void StoreVec(float *ptr, const GoldenVec &vec)
+{
+    std::memcpy(ptr, &vec, sizeof(GoldenVec));
+}
+
+// C[MR x NR] += packedA[MR x kLen] * packedB[kLen x NR], with k visited in ascending order.
+inline void MicroKernel(uint32_t kLen, const float *packedA, const float *packedB, float *accum, uint32_t ldAccum)
+{
+    GoldenVec c[GOLDEN_MR][GOLDEN_NR_VEC];
+    for (uint32_t i = 0; i < GOLDEN_MR; ++i) {
+        for (uint32_t v = 0; v < GOLDEN_NR_VEC; ++v) {
+            c[i][v] = LoadVec(accum + i * ldAccum + v * GOLDEN_VEC_LEN);
+        }
+    }
+    for (uint32_t k = 0; k < kLen; ++k) {
+        GoldenVec b[GOLDEN_NR_VEC];
+        for (uint32_t v = 0; v < GOLDEN_NR_VEC; ++v) {
+            b[v] = LoadVec(packedB + k * GOLDEN_NR + v * GOLDEN_VEC_LEN);
+        }
+        for (uint32_t i = 0; i < GOLDEN_MR; ++i) {
+            float a = packedA[k * GOLDEN_MR + i];
+            for (uint32_t v = 0; v < GOLDEN_NR_VEC; ++v) {
+                c[i][v] += a * b[v];
+            }
+        }
+    }
+    for (uint32_t i = 0; i < GOLDEN_MR; ++i) {
+        for (uint32_t v = 0; v < GOLDEN_NR_VEC; ++v) {
+            StoreVec(accum + i * ldAccum + v * GOLDEN_VEC_LEN, c[i][v]);
+        }
+    }
+}
+
+/**
+ * Compute one or more independent fp32-accumulate matmuls.
+ *
+ * loadA(problemIdx, i, k) and loadB(problemIdx, k, j) return operands already converted to float,
+ * store(problemIdx, i, j, accumulator) writes the finished accumulator of one output element.
+ * The output tiles of all problems are flattened into one task list, so small groups or batches
+ * share the worker threads instead of being processed one after another.
+ */
+template <class LoadA, class LoadB, class Store>
+void BlockedMatmul(const std::vector<GemmCoord> &problemShapeList, LoadA &&loadA, LoadB &&loadB, Store &&store)
+{
+    struct TileTask {
+        uint32_t problemIdx;
+        uint32_t mStart;
+        uint32_t nStart;
+    };
+    std::vector<TileTask> tasks;
+    for (uint32_t problemIdx = 0; problemIdx < problemShapeList.size(); ++problemIdx) {
+        const GemmCoord &problemShape = problemShapeList[problemIdx];
+        for (uint32_t mStart = 0; mStart < problemShape.m(); mStart += GOLDEN_MC) {
+            for (uint32_t nStart = 0; nStart < problemShape.n(); nStart += GOLDEN_NC) {
+                tasks.push_back({problemIdx, mStart, nStart});
+            }
+        }
+    }
+
+    ParallelFor(static_cast<uint32_t>(tasks.size()), [&](uint32_t taskIdx) {
+        thread_local std::vector<float> packedA(GOLDEN_MC * GOLDEN_KC);
+        thread_local std::vector<float> packedB(GOLDEN_KC * GOLDEN_NC);
+        thread_local std::vector<float> accum(GOLDEN_MC * GOLDEN_NC);
+
+        const TileTask &task = tasks[taskIdx];
+        const GemmCoord &problemShape = problemShapeList[task.problemIdx];
+        uint32_t mLen = std::min(GOLDEN_MC, problemShape.m() - task.mStart);
+        uint32_t nLen = std::min(GOLDEN_NC, problemShape.n() - task.nStart);
+        uint32_t mPanelNum = (mLen + GOLDEN_MR - 1) / GOLDEN_MR;
+        uint32_t nPanelNum = (nLen + GOLDEN_NR - 1) / GOLDEN_NR;
+        std::fill(accum.begin(), accum.end(), 0.0f);
+
+        for (uint32_t kStart = 0; kStart < problemShape.k(); kStart += GOLDEN_KC) {
+            uint32_t kLen = std::min(GOLDEN_KC, problemShape.k() - kStart);
+            // Pack B into NR-wide column panels, zero padding the tail columns.
+            for (uint32_t panel = 0; panel < nPanelNum; ++panel) {
+                float *dst = packedB.data() + panel * kLen * GOLDEN_NR;
+                for (uint32_t k = 0; k < kLen; ++k) {
+                    for (uint32_t j = 0; j < GOLDEN_NR; ++j) {
+                        uint32_t col = panel * GOLDEN_NR + j;
+                        dst[k * GOLDEN_NR + j] = col < nLen ?
+                            loadB(task.problemIdx, kStart + k, task.nStart + col) : 0.0f;
+                    }
+                }
+            }
+            // Pack A into MR-high row panels, zero padding the tail rows.
+            for (uint32_t panel = 0; panel < mPanelNum; ++panel) {
+                float *dst = packedA.data() + panel * kLen * GOLDEN_MR;
+                for (uint32_t k = 0; k < kLen; ++k) {
+                    for (uint32_t i = 0; i < GOLDEN_MR; ++i) {
+                        uint32_t row = panel * GOLDEN_MR + i;
+                        dst[k * GOLDEN_MR + i] = row < mLen ?
+                            loadA(task.problemIdx, task.mStart + row, kStart + k) : 0.0f;
+                    }
+                }
+            }
+            for (uint32_t mPanel = 0; mPanel < mPanelNum; ++mPanel) {
+                for (uint32_t nPanel = 0; nPanel < nPanelNum; ++nPanel) {
+                    MicroKernel(kLen,
+                        packedA.data() + mPanel * kLen * GOLDEN_MR,
+                        packedB.data() + nPanel * kLen * GOLDEN_NR,
+                        accum.data() + mPanel * GOLDEN_MR * GOLDEN_NC + nPanel * GOLDEN_NR, GOLDEN_NC);
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < mLen; ++i) {
+            for (uint32_t j = 0; j < nLen; ++j) {
+                store(task.problemIdx, task.mStart + i, task.nStart + j, accum[i * GOLDEN_NC + j]);
+            }
+        }
+    });
+}
+
+} // namespace Catlass::golden::detail
+
+#endif // EXAMPLES_COMMON_GOLDEN_MATMUL_ENGINE_HPP
@@ -0,0 +1,57 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef EXAMPLES_COMMON_HOST_PARALLEL_HPP
+#define EXAMPLES_COMMON_HOST_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "catlass/catlass.hpp"
+
+namespace Catlass::host {
+
+// Threads for tasks over elements: threadNum, or the hardware threads for 0, bounded by the tasks and by the work.
+inline uint32_t ResolveThreadNum(uint32_t threadNum, uint32_t tasks, size_t elements)
+{
+    // below this the threads cost more than they save
+    constexpr size_t MIN_ELEMENTS_PER_THREAD = 1 << 16;
+    if (threadNum == 0) {
+        threadNum = std::max(1u, std::thread::hardware_concurrency());
+    }
+    auto byWork = static_cast<uint32_t>(std::max<size_t>(1, elements / MIN_ELEMENTS_PER_THREAD));
+    return std::max(1u, std::min({threadNum, tasks, byWork}));
+}
+
+// Calls run(begin, end) on contiguous ranges of tasks, one per thread
+template <class Run>
+void ParallelFor(uint32_t tasks, size_t elements, uint32_t threadNum, Run const &run)
+{
+    threadNum = ResolveThreadNum(threadNum, tasks, elements);
+    if (threadNum == 1) {
+        run(0u, tasks);
+        return;
+    }
+    uint32_t perThread = CeilDiv(tasks, threadNum);
+    std::vector<std::thread> threads;
+    for (uint32_t begin = 0; begin < tasks; begin += perThread) {
+        threads.emplace_back(run, begin, std::min(tasks, begin + perThread));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace Catlass::host
+
+#endif // EXAMPLES_COMMON_HOST_PARALLEL_HPP
@@ -0,0 +1,596 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef EXAMPLES_COMMON_LAYOUT_CONVERT_HPP
+#define EXAMPLES_COMMON_LAYOUT_CONVERT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "catlass/catlass.hpp"
+#include "catlass/layout/layout.hpp"
+
+#include "host_parallel.hpp"
+
+namespace Catlass::convert {
+
+// Host conversion of data between the plain layouts of frameworks and the private layouts of the cube, for inputs
+// and weights prepared at load time.
+//
+// - Matrices: RowMajor or ColumnMajor to and from zN, nZ, zZ and nN made by their MakeLayout<Element>.
+// - Feature maps: NCHW to and from NC1HWC0, NCDHW to and from NDC1HWC0.
+// - Filters: KCRS (cout, cin, kh, kw) to and from the CI1KHKWCOCI0 fractal Z of conv2d, KCDRS to and from the
+//   KDC1KHKWN1N0C0 one of conv3d.
+//
+// Every private layout is a sequence of lines of C0 contiguous elements, a fractal being 16 of them. A conversion is
+// then a copy of lines when the plain layout is contiguous along C0 and a transpose of 16 x C0 blocks otherwise.
+// Blocks are visited by tiles of a few fractals so that a cache line of the plain side is used whole before it is
+// evicted, and the tiles are split over threads. A whole line is moved as one 32 byte block (a memcpy of constant size,
+// two 16 byte or one 32 byte vector move), the transposes are left to the compiler. No intrinsics are used, so that
+// the helpers build wherever the examples do. tests/layout_convert measures them, about 1-3.5 GB/s on one x86 core.
+// Padding of the private layout is written as zeros and skipped on the way back. Functions return false when the
+// layouts do not describe the same tensor.
+
+namespace detail {
+
+// The plain side is read when packing and written when unpacking, the private side the other way round
+template <bool PACK, class Element>
+using PlainPtr = std::conditional_t<PACK, Element const, Element> *;
+
+template <bool PACK, class Element>
+using PrivatePtr = std::conditional_t<PACK, Element, Element const> *;
+
+// A whole line of C0 elements, 32 bytes, as one block move
+template <uint32_t C0, class Element>
+inline void CopyLine(Element const *src, Element *dst)
+{
+    static_assert(std::is_trivially_copyable_v<Element>, "Lines are moved as bytes");
+    std::memcpy(dst, src, C0 * sizeof(Element));
+}
+
+// Lines of C0 elements in and out of the private layout. A line o of dst starts at o * dstStride, element i of it
+// is src[o * srcOuter + i * srcInner] for i < validInner and zero up to C0.
+template <uint32_t C0, class Element>
+void PackLines(Element const *src, int64_t srcOuter, int64_t srcInner, uint32_t outer, uint32_t validInner,
+    Element *dst, int64_t dstStride)
+{
+    if (srcInner == 1) {
+        for (uint32_t o = 0; o < outer; ++o) {
+            Element const *in = src + o * srcOuter;
+            Element *out = dst + o * dstStride;
+            if (validInner == C0) {
+                CopyLine<C0>(in, out);
+            } else {
+                std::copy_n(in, validInner, out);
+                std::fill(out + validInner, out + C0, Element(0));
+            }
+        }
+        return;
+    }
+    // the lines are read across, go along the rows of src so that its cache lines are used whole
+    for (uint32_t i = 0; i < validInner; ++i) {
+        Element const *in = src + i * srcInner;
+        for (uint32_t o = 0; o < outer; ++o) {
+            dst[o * dstStride + i] = in[o * srcOuter];
+        }
+    }
+    for (uint32_t o = 0; (validInner < C0) && (o < outer); ++o) {
+        std::fill(dst + o * dstStride + validInner, dst + o * dstStride + C0, Element(0));
+    }
+}
+
+template <uint32_t C0, class Element>
+void UnpackLines(Element const *src, int64_t srcStride, uint32_t outer, uint32_t validInner,
+    Element *dst, int64_t dstOuter, int64_t dstInner)
+{
+    if (dstInner == 1) {
+        for (uint32_t o = 0; o < outer; ++o) {
+            Element const *in = src + o * srcStride;
+            Element *out = dst + o * dstOuter;
+            if (validInner == C0) {
+                CopyLine<C0>(in, out);
+            } else {
+                std::copy_n(in, validInner, out);
+            }
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < validInner; ++i) {
+        Element *out = dst + i * dstInner;
+        for (uint32_t o = 0; o < outer; ++o) {
+            out[o * dstOuter] = src[o * srcStride + i];
+        }
+    }
+}
+
+// Fractal layouts seen as 16 lines of C0 per fractal. Inside a zN or zZ fractal a line is a row, inside an nZ or nN
+// one it is a column; outer counts the lines and inner the elements of a line in the coordinates of the matrix.
+template <class Layout>
+struct FractalTraits {
+    static_assert(DEPENDENT_FALSE<Layout>, "Unsupported fractal layout, only zN, nZ, zZ and nN");
+};
+
+template <>
+struct FractalTraits<layout::zN> {
+    static constexpr bool LINE_IS_ROW = true;
+};
+
+template <>
+struct FractalTraits<layout::zZ> {
+    static constexpr bool LINE_IS_ROW = true;
+};
+
+template <>
+struct FractalTraits<layout::nZ> {
+    static constexpr bool LINE_IS_ROW = false;
+};
+
+template <>
+struct FractalTraits<layout::nN> {
+    static constexpr bool LINE_IS_ROW = false;
+};
+
+struct FractalView {
+    uint32_t outer{0};
+    uint32_t inner{0};
+    uint32_t outerFractals{0};
+    uint32_t innerFractals{0};
+    int64_t strideOuterFractal{0};
+    int64_t strideInnerFractal{0};
+    // strides of the plain matrix along outer and inner
+    int64_t srcOuter{0};
+    int64_t srcInner{0};
+};
+
+template <class Layout>
+struct NdTraits {
+    static_assert(DEPENDENT_FALSE<Layout>, "Unsupported plain layout, only RowMajor and ColumnMajor");
+};
+
+template <>
+struct NdTraits<layout::RowMajor> {
+    static int64_t RowStride(layout::RowMajor const &layout)
+    {
+        return layout.stride(0);
+    }
+    static int64_t ColStride(layout::RowMajor const &)
+    {
+        return 1;
+    }
+};
+
+template <>
+struct NdTraits<layout::ColumnMajor> {
+    static int64_t RowStride(layout::ColumnMajor const &)
+    {
+        return 1;
+    }
+    static int64_t ColStride(layout::ColumnMajor const &layout)
+    {
+        return layout.stride(1);
+    }
+};
+
+// Fails if the fractal layout is not the one MakeLayout<Element> makes for the shape of the plain one
+template <class Element, class LayoutNd, class LayoutFractal>
+bool MakeFractalView(LayoutNd const &layoutNd, LayoutFractal const &layoutFractal, FractalView &view)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    constexpr bool LINE_IS_ROW = FractalTraits<LayoutFractal>::LINE_IS_ROW;
+    uint32_t rows = layoutNd.shape(0);
+    uint32_t cols = layoutNd.shape(1);
+    if ((layoutFractal.orgShape(0) != rows) || (layoutFractal.orgShape(1) != cols)) {
+        return false;
+    }
+    auto expected = LayoutFractal::template MakeLayout<Element>(rows, cols);
+    for (int i = 0; i < 4; ++i) {
+        if ((layoutFractal.shape(i) != expected.shape(i)) || (layoutFractal.stride(i) != expected.stride(i))) {
+            return false;
+        }
+    }
+    // the shape of a fractal is (rows in, rows by, cols in, cols by), lines of C0 along the contiguous side
+    uint32_t lineIndex = LINE_IS_ROW ? 0 : 2;
+    uint32_t elementIndex = LINE_IS_ROW ? 2 : 0;
+    if ((layoutFractal.shape(lineIndex) != C0_NUM_PER_FRACTAL) ||
+        (layoutFractal.shape(elementIndex) != ELE_NUM_PER_C0)) {
+        return false;
+    }
+    view.outer = LINE_IS_ROW ? rows : cols;
+    view.inner = LINE_IS_ROW ? cols : rows;
+    view.outerFractals = layoutFractal.shape(lineIndex + 1);
+    view.innerFractals = layoutFractal.shape(elementIndex + 1);
+    view.strideOuterFractal = layoutFractal.stride(lineIndex + 1);
+    view.strideInnerFractal = layoutFractal.stride(elementIndex + 1);
+    int64_t rowStride = NdTraits<LayoutNd>::RowStride(layoutNd);
+    int64_t colStride = NdTraits<LayoutNd>::ColStride(layoutNd);
+    view.srcOuter = LINE_IS_ROW ? rowStride : colStride;
+    view.srcInner = LINE_IS_ROW ? colStride : rowStride;
+    return true;
+}
+
+// Fractals per tile along outer and inner, a tile reads 64 lines of 4 x C0 or 4 x C0 lines of 64 of the plain side
+constexpr uint32_t TILE_OUTER_FRACTALS = 4;
+constexpr uint32_t TILE_INNER_FRACTALS = 4;
+
+template <bool PACK, class Element>
+void ConvertFractals(FractalView const &view, PlainPtr<PACK, Element> plain, PrivatePtr<PACK, Element> fractal,
+    uint32_t threadNum)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    uint32_t outerTiles = CeilDiv(view.outerFractals, TILE_OUTER_FRACTALS);
+    uint32_t innerTiles = CeilDiv(view.innerFractals, TILE_INNER_FRACTALS);
+    size_t elements = static_cast<size_t>(view.outerFractals) * view.innerFractals * C0_NUM_PER_FRACTAL *
+        ELE_NUM_PER_C0;
+
+    auto runTiles = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t tile = begin; tile < end; ++tile) {
+            uint32_t foBegin = (tile % outerTiles) * TILE_OUTER_FRACTALS;
+            uint32_t fiBegin = (tile / outerTiles) * TILE_INNER_FRACTALS;
+            uint32_t foEnd = std::min(view.outerFractals, foBegin + TILE_OUTER_FRACTALS);
+            uint32_t fiEnd = std::min(view.innerFractals, fiBegin + TILE_INNER_FRACTALS);
+            for (uint32_t fi = fiBegin; fi < fiEnd; ++fi) {
+                uint32_t i0 = fi * ELE_NUM_PER_C0;
+                uint32_t validInner = (i0 < view.inner) ? std::min(ELE_NUM_PER_C0, view.inner - i0) : 0;
+                for (uint32_t fo = foBegin; fo < foEnd; ++fo) {
+                    uint32_t o0 = fo * C0_NUM_PER_FRACTAL;
+                    uint32_t validOuter = (o0 < view.outer) ? std::min(C0_NUM_PER_FRACTAL, view.outer - o0) : 0;
+                    PrivatePtr<PACK, Element> frac =
+                        fractal + fo * view.strideOuterFractal + fi * view.strideInnerFractal;
+                    if ((validOuter == 0) || (validInner == 0)) {
+                        // a fractal of padding only, no element of the plain side is in it
+                        if constexpr (PACK) {
+                            std::fill(frac, frac + C0_NUM_PER_FRACTAL * ELE_NUM_PER_C0, Element(0));
+                        }
+                        continue;
+                    }
+                    PlainPtr<PACK, Element> nd = plain + o0 * view.srcOuter + i0 * view.srcInner;
+                    if constexpr (PACK) {
+                        PackLines<ELE_NUM_PER_C0>(nd, view.srcOuter, view.srcInner, validOuter, validInner,
+                            frac, ELE_NUM_PER_C0);
+                        std::fill(frac + validOuter * ELE_NUM_PER_C0, frac + C0_NUM_PER_FRACTAL * ELE_NUM_PER_C0,
+                            Element(0));
+                    } else {
+                        UnpackLines<ELE_NUM_PER_C0>(frac, ELE_NUM_PER_C0, validOuter, validInner,
+                            nd, view.srcOuter, view.srcInner);
+                    }
+                }
+            }
+        }
+    };
+    host::ParallelFor(outerTiles * innerTiles, elements, threadNum, runTiles);
+}
+
+// Feature maps: C0 channels of a plane of the plain layout, hw apart, become hw lines of C0
+struct FmapView {
+    uint32_t batch{0};
+    uint32_t channels{0};
+    uint32_t depth{1};
+    uint32_t hw{0};
+    uint32_t c1{0};
+    // strides of the private layout between batches, depths and c1
+    int64_t strideBatch{0};
+    int64_t strideDepth{0};
+    int64_t strideC1{0};
+};
+
+// hw elements per task, a task reads C0 runs of HW_TILE of the plain side
+constexpr uint32_t HW_TILE = 1024;
+
+template <bool PACK, class Element>
+void ConvertFmap(FmapView const &view, PlainPtr<PACK, Element> plain, PrivatePtr<PACK, Element> packed,
+    uint32_t threadNum)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    uint32_t hwTiles = CeilDiv(view.hw, HW_TILE);
+    uint32_t planes = view.batch * view.depth * view.c1;
+    size_t elements = static_cast<size_t>(planes) * view.hw * ELE_NUM_PER_C0;
+    // plain strides of a channel and a depth of NC(D)HW
+    int64_t channelStride = static_cast<int64_t>(view.depth) * view.hw;
+    int64_t depthStride = view.hw;
+
+    auto runTiles = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t task = begin; task < end; ++task) {
+            uint32_t hwBegin = (task % hwTiles) * HW_TILE;
+            uint32_t plane = task / hwTiles;
+            uint32_t c1 = plane % view.c1;
+            uint32_t d = (plane / view.c1) % view.depth;
+            uint32_t n = plane / (view.c1 * view.depth);
+            uint32_t outer = std::min(HW_TILE, view.hw - hwBegin);
+            uint32_t c = c1 * ELE_NUM_PER_C0;
+            uint32_t validInner = std::min(ELE_NUM_PER_C0, view.channels - c);
+            PlainPtr<PACK, Element> nd = plain + (static_cast<int64_t>(n) * view.channels + c) * channelStride +
+                d * depthStride + hwBegin;
+            PrivatePtr<PACK, Element> lines = packed + n * view.strideBatch + d * view.strideDepth + c1 * view.strideC1 +
+                static_cast<int64_t>(hwBegin) * ELE_NUM_PER_C0;
+            if constexpr (PACK) {
+                PackLines<ELE_NUM_PER_C0>(nd, 1, channelStride, outer, validInner, lines, ELE_NUM_PER_C0);
+            } else {
+                UnpackLines<ELE_NUM_PER_C0>(lines, ELE_NUM_PER_C0, outer, validInner, nd, 1, channelStride);
+            }
+        }
+    };
+    host::ParallelFor(planes * hwTiles, elements, threadNum, runTiles);
+}
+
+// Filters: for a cout and C0 input channels, the kd * kh * kw taps become lines of C0, cout lines apart
+struct FilterView {
+    uint32_t cout{0};
+    uint32_t cin{0};
+    uint32_t kd{1};
+    uint32_t khkw{0};
+    uint32_t c1{0};
+    // couts of the private layout, cout padded to a fractal for conv3d
+    uint32_t coutPad{0};
+};
+
+// couts per task
+constexpr uint32_t COUT_TILE = 64;
+
+template <bool PACK, class Element, class RowOffset>
+void ConvertFilter(FilterView const &view, PlainPtr<PACK, Element> plain, PrivatePtr<PACK, Element> packed,
+    RowOffset const &rowOffset, uint32_t threadNum)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    uint32_t coutTiles = CeilDiv(view.coutPad, COUT_TILE);
+    uint32_t groups = view.c1 * view.kd;
+    size_t elements = static_cast<size_t>(groups) * view.khkw * view.coutPad * ELE_NUM_PER_C0;
+    int64_t tapStride = static_cast<int64_t>(view.kd) * view.khkw;
+    int64_t coutStride = static_cast<int64_t>(view.cin) * tapStride;
+    int64_t lineStride = static_cast<int64_t>(view.coutPad) * ELE_NUM_PER_C0;
+
+    auto runTiles = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t task = begin; task < end; ++task) {
+            uint32_t coBegin = (task % coutTiles) * COUT_TILE;
+            uint32_t group = task / coutTiles;
+            uint32_t c1 = group % view.c1;
+            uint32_t d = group / view.c1;
+            uint32_t coEnd = std::min(view.coutPad, coBegin + COUT_TILE);
+            uint32_t c = c1 * ELE_NUM_PER_C0;
+            uint32_t validInner = std::min(ELE_NUM_PER_C0, view.cin - c);
+            PrivatePtr<PACK, Element> lines = packed + rowOffset(d, c1);
+            for (uint32_t co = coBegin; co < coEnd; ++co) {
+                PrivatePtr<PACK, Element> out = lines + static_cast<int64_t>(co) * ELE_NUM_PER_C0;
+                if (co >= view.cout) {
+                    if constexpr (PACK) {
+                        for (uint32_t t = 0; t < view.khkw; ++t) {
+                            std::fill(out + t * lineStride, out + t * lineStride + ELE_NUM_PER_C0, Element(0));
+                        }
+                    }
+                    continue;
+                }
+                // the taps of a channel are contiguous in the plain layout
+                PlainPtr<PACK, Element> nd = plain + co * coutStride + c * tapStride + static_cast<int64_t>(d) * view.khkw;
+                if constexpr (PACK) {
+                    PackLines<ELE_NUM_PER_C0>(nd, 1, tapStride, view.khkw, validInner, out, lineStride);
+                } else {
+                    UnpackLines<ELE_NUM_PER_C0>(out, lineStride, view.khkw, validInner, nd, 1, tapStride);
+                }
+            }
+        }
+    };
+    host::ParallelFor(groups * coutTiles, elements, threadNum, runTiles);
+}
+
+} // namespace detail
+
+/////////////////// Matrices ///////////////////
+
+// Converts a RowMajor or ColumnMajor matrix to layoutDst, a zN, nZ, zZ or nN of MakeLayout<Element> for the same
+// shape. dst holds the whole fractal layout, its padding is zeroed.
+template <class Element, class LayoutSrc, class LayoutDst>
+bool NdToFractal(Element const *src, LayoutSrc const &layoutSrc, Element *dst, LayoutDst const &layoutDst,
+    uint32_t threadNum = 0)
+{
+    detail::FractalView view;
+    if (!detail::MakeFractalView<Element>(layoutSrc, layoutDst, view)) {
+        return false;
+    }
+    detail::ConvertFractals<true, Element>(view, src, dst, threadNum);
+    return true;
+}
+
+// Converts a zN, nZ, zZ or nN matrix back to RowMajor or ColumnMajor, the padding is dropped
+template <class Element, class LayoutSrc, class LayoutDst>
+bool FractalToNd(Element const *src, LayoutSrc const &layoutSrc, Element *dst, LayoutDst const &layoutDst,
+    uint32_t threadNum = 0)
+{
+    detail::FractalView view;
+    if (!detail::MakeFractalView<Element>(layoutDst, layoutSrc, view)) {
+        return false;
+    }
+    detail::ConvertFractals<false, Element>(view, dst, src, threadNum);
+    return true;
+}
+
+/////////////////// Feature maps ///////////////////
+
+namespace detail {
+
+template <class Element>
+bool MakeFmapView(uint32_t n, uint32_t c, uint32_t h, uint32_t w, layout::NC1HWC0 const &layout, FmapView &view)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    if ((layout.shape(0) != n) || (layout.shape(1) != CeilDiv(c, ELE_NUM_PER_C0)) || (layout.shape(2) != h) ||
+        (layout.shape(3) != w) || (layout.shape(4) != ELE_NUM_PER_C0) || (layout.stride(4) != 1) ||
+        (layout.stride(3) != ELE_NUM_PER_C0) || (layout.stride(2) != static_cast<int64_t>(w) * ELE_NUM_PER_C0)) {
+        return false;
+    }
+    view = FmapView{n, c, 1, h * w, layout.shape(1), layout.stride(0), 0, layout.stride(1)};
+    return true;
+}
+
+template <class Element>
+bool MakeFmapView(uint32_t n, uint32_t c, uint32_t d, uint32_t h, uint32_t w, layout::NDC1HWC0 const &layout,
+    FmapView &view)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    // orgShape is (n, d, c1, h, w, c0), stride (c0, hw, c1, d, n)
+    if ((layout.orgShape(0) != n) || (layout.orgShape(1) != d) ||
+        (layout.orgShape(2) != CeilDiv(c, ELE_NUM_PER_C0)) || (layout.orgShape(3) != h) ||
+        (layout.orgShape(4) != w) || (layout.orgShape(5) != ELE_NUM_PER_C0) || (layout.stride(0) != 1) ||
+        (layout.stride(1) != ELE_NUM_PER_C0)) {
+        return false;
+    }
+    view = FmapView{n, c, d, h * w, layout.orgShape(2), layout.stride(4), layout.stride(3), layout.stride(2)};
+    return true;
+}
+
+} // namespace detail
+
+// NCHW to NC1HWC0, the channels are padded with zeros to a whole C1
+template <class Element>
+bool NchwToNc1hwc0(Element const *src, uint32_t n, uint32_t c, uint32_t h, uint32_t w,
+    Element *dst, layout::NC1HWC0 const &layoutDst, uint32_t threadNum = 0)
+{
+    detail::FmapView view;
+    if (!detail::MakeFmapView<Element>(n, c, h, w, layoutDst, view)) {
+        return false;
+    }
+    detail::ConvertFmap<true, Element>(view, src, dst, threadNum);
+    return true;
+}
+
+template <class Element>
+bool Nc1hwc0ToNchw(Element const *src, layout::NC1HWC0 const &layoutSrc,
+    Element *dst, uint32_t n, uint32_t c, uint32_t h, uint32_t w, uint32_t threadNum = 0)
+{
+    detail::FmapView view;
+    if (!detail::MakeFmapView<Element>(n, c, h, w, layoutSrc, view)) {
+        return false;
+    }
+    detail::ConvertFmap<false, Element>(view, dst, src, threadNum);
+    return true;
+}
+
+// NCDHW to NDC1HWC0, the channels are padded with zeros to a whole C1
+template <class Element>
+bool NcdhwToNdc1hwc0(Element const *src, uint32_t n, uint32_t c, uint32_t d, uint32_t h, uint32_t w,
+    Element *dst, layout::NDC1HWC0 const &layoutDst, uint32_t threadNum = 0)
+{
+    detail::FmapView view;
+    if (!detail::MakeFmapView<Element>(n, c, d, h, w, layoutDst, view)) {
+        return false;
+    }
+    detail::ConvertFmap<true, Element>(view, src, dst, threadNum);
+    return true;
+}
+
+template <class Element>
+bool Ndc1hwc0ToNcdhw(Element const *src, layout::NDC1HWC0 const &layoutSrc,
+    Element *dst, uint32_t n, uint32_t c, uint32_t d, uint32_t h, uint32_t w, uint32_t threadNum = 0)
+{
+    detail::FmapView view;
+    if (!detail::MakeFmapView<Element>(n, c, d, h, w, layoutSrc, view)) {
+        return false;
+    }
+    detail::ConvertFmap<false, Element>(view, dst, src, threadNum);
+    return true;
+}
+
+/////////////////// Filters ///////////////////
+
+namespace detail {
+
+template <class Element>
+bool CheckFilterLayout(uint32_t cout, uint32_t cin, uint32_t kh, uint32_t kw, layout::CI1KHKWCOCI0 const &layout)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    return (layout.shape(0) == CeilDiv(cin, ELE_NUM_PER_C0)) && (layout.shape(1) == kh) && (layout.shape(2) == kw) &&
+        (layout.shape(3) >= cout) && (layout.shape(4) == ELE_NUM_PER_C0) && (layout.stride(4) == 1) &&
+        (layout.stride(3) == ELE_NUM_PER_C0) && (layout.stride(2) == static_cast<int64_t>(layout.shape(3)) *
+        ELE_NUM_PER_C0) && (layout.stride(1) == kw * layout.stride(2));
+}
+
+template <class Element>
+bool CheckFilterLayout(uint32_t cout, uint32_t cin, uint32_t kd, uint32_t kh, uint32_t kw,
+    layout::KDC1KHKWN1N0C0 const &layout)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    // orgShape is (kd * c1 * kh * kw, n1, n0, c0), stride (c0, n0, n1, kd * c1 * kh * kw)
+    uint32_t coutPad = layout.orgShape(1) * layout.orgShape(2);
+    return (layout.orgShape(0) == kd * CeilDiv(cin, ELE_NUM_PER_C0) * kh * kw) && (coutPad >= cout) &&
+        (layout.orgShape(3) == ELE_NUM_PER_C0) && (layout.stride(0) == 1) && (layout.stride(1) == ELE_NUM_PER_C0) &&
+        (layout.stride(2) == static_cast<int64_t>(layout.orgShape(2)) * ELE_NUM_PER_C0) &&
+        (layout.stride(3) == static_cast<int64_t>(coutPad) * ELE_NUM_PER_C0);
+}
+
+} // namespace detail
+
+// KCRS (cout, cin, kh, kw) to the CI1KHKWCOCI0 fractal Z of conv2d. The cin are padded with zeros to a whole C1, and
+// so are the couts of layoutDst past cout.
+template <class Element>
+bool KcrsToFracZ(Element const *src, uint32_t cout, uint32_t cin, uint32_t kh, uint32_t kw,
+    Element *dst, layout::CI1KHKWCOCI0 const &layoutDst, uint32_t threadNum = 0)
+{
+    if (!detail::CheckFilterLayout<Element>(cout, cin, kh, kw, layoutDst)) {
+        return false;
+    }
+    detail::FilterView view{cout, cin, 1, kh * kw, layoutDst.shape(0), layoutDst.shape(3)};
+    auto rowOffset = [&](uint32_t, uint32_t c1) {
+        return c1 * layoutDst.stride(0);
+    };
+    detail::ConvertFilter<true, Element>(view, src, dst, rowOffset, threadNum);
+    return true;
+}
+
+template <class Element>
+bool FracZToKcrs(Element const *src, layout::CI1KHKWCOCI0 const &layoutSrc,
+    Element *dst, uint32_t cout, uint32_t cin, uint32_t kh, uint32_t kw, uint32_t threadNum = 0)
+{
+    if (!detail::CheckFilterLayout<Element>(cout, cin, kh, kw, layoutSrc)) {
+        return false;
+    }
+    detail::FilterView view{cout, cin, 1, kh * kw, layoutSrc.shape(0), layoutSrc.shape(3)};
+    auto rowOffset = [&](uint32_t, uint32_t c1) {
+        return c1 * layoutSrc.stride(0);
+    };
+    detail::ConvertFilter<false, Element>(view, dst, src, rowOffset, threadNum);
+    return true;
+}
+
+// KCDRS (cout, cin, kd, kh, kw) to the KDC1KHKWN1N0C0 fractal Z of conv3d, the cin and the couts past cout are
+// padded with zeros
+template <class Element>
+bool KcdrsToFracZ3d(Element const *src, uint32_t cout, uint32_t cin, uint32_t kd, uint32_t kh, uint32_t kw,
+    Element *dst, layout::KDC1KHKWN1N0C0 const &layoutDst, uint32_t threadNum = 0)
+{
+    if (!detail::CheckFilterLayout<Element>(cout, cin, kd, kh, kw, layoutDst)) {
+        return false;
+    }
+    uint32_t c1 = layoutDst.orgShape(0) / (kd * kh * kw);
+    detail::FilterView view{cout, cin, kd, kh * kw, c1, layoutDst.orgShape(1) * layoutDst.orgShape(2)};
+    auto rowOffset = [&](uint32_t d, uint32_t c) {
+        return static_cast<int64_t>(d * c1 + c) * kh * kw * layoutDst.stride(3);
+    };
+    detail::ConvertFilter<true, Element>(view, src, dst, rowOffset, threadNum);
+    return true;
+}
+
+template <class Element>
+bool FracZ3dToKcdrs(Element const *src, layout::KDC1KHKWN1N0C0 const &layoutSrc,
+    Element *dst, uint32_t cout, uint32_t cin, uint32_t kd, uint32_t kh, uint32_t kw, uint32_t threadNum = 0)
+{
+    if (!detail::CheckFilterLayout<Element>(cout, cin, kd, kh, kw, layoutSrc)) {
+        return false;
+    }
+    uint32_t c1 = layoutSrc.orgShape(0) / (kd * kh * kw);
+    detail::FilterView view{cout, cin, kd, kh * kw, c1, layoutSrc.orgShape(1) * layoutSrc.orgShape(2)};
+    auto rowOffset = [&](uint32_t d, uint32_t c) {
+        return static_cast<int64_t>(d * c1 + c) * kh * kw * layoutSrc.stride(3);
+    };
+    detail::ConvertFilter<false, Element>(view, dst, src, rowOffset, threadNum);
+    return true;
+}
+
+} // namespace Catlass::convert
+
+#endif // EXAMPLES_COMMON_LAYOUT_CONVERT_HPP
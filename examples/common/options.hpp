@@ -98,6 +98,45 @@ struct GemvOptions {
     }
 };
 
+/**
+ * @struct BatchedGemvOptions
+ * @brief Options structuture for batched gemv examples, batch vectors share the same matrix.
+ * @brief Arguments: `example_name batch m n [device_id]`
+ */
+struct BatchedGemvOptions {
+    const std::string HELPER = "batch m n [device_id]";
+
+    Catlass::GemvCoord problemShape{128, 128};
+    uint32_t batch{1};
+    int32_t deviceId{0};
+
+    BatchedGemvOptions() = default;
+
+    int Parse(int argc, const char **argv) {
+        enum class ArgsIndex {
+            BATCH_INDEX = 1,
+            M_INDEX,
+            N_INDEX,
+            DEVICE_ID_INDEX,
+            ARGS_MAX
+        };
+
+        if (argc > static_cast<uint32_t>(ArgsIndex::ARGS_MAX)
+            || argc < static_cast<uint32_t>(ArgsIndex::DEVICE_ID_INDEX)) {
+            std::cerr << TOSTRING(CATLASS_EXAMPLE_NAME) << " " << HELPER << std::endl;
+            return -1;
+        }
+
+        batch = std::atoi(argv[static_cast<uint32_t>(ArgsIndex::BATCH_INDEX)]);
+        problemShape.m() = std::atoi(argv[static_cast<uint32_t>(ArgsIndex::M_INDEX)]);
+        problemShape.n() = std::atoi(argv[static_cast<uint32_t>(ArgsIndex::N_INDEX)]);
+        if (argc == static_cast<uint32_t>(ArgsIndex::ARGS_MAX)) {
+            deviceId = std::atoi(argv[static_cast<uint32_t>(ArgsIndex::DEVICE_ID_INDEX)]);
+        }
+        return 0;
+    }
+};
+
 /**
  * @struct GroupedGemmOptions
  * @brief Options structuture for grouped/batched gemm examples.
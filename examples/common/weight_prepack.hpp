@@ -0,0 +1,243 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef EXAMPLES_COMMON_WEIGHT_PREPACK_HPP
+#define EXAMPLES_COMMON_WEIGHT_PREPACK_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "catlass/catlass.hpp"
+#include "catlass/layout/layout.hpp"
+
+#include "host_parallel.hpp"
+#include "layout_convert.hpp"
+
+namespace Catlass::prepack {
+
+// Offline packing of the quantized B of W4A8 and W8A16 matmuls for Gemm::Kernel::PrepackedWeightMatmul.
+//
+// W4A8Matmul and W8A16Matmul cast B on the AIV at every launch and stage it through a workspace. Weights that do
+// not change are packed once on the host instead: int4 is widened to int8, int8 is dequantized to fp16, and the
+// result is written in the fractal layout B has in L1, zN for a row major B and nZ for a column major one, padded
+// with zeros to whole fractals. Moving B to L1 is then a plain block copy and the kernel runs on the AIC only.
+//
+// Packing converts the lines of B, rows of a row major B and columns of a column major one, into a plain buffer of the
+// packed element split over threads, then moves it to the fractal layout with convert::NdToFractal.
+
+template <class LayoutSrc>
+struct PackedLayoutSelector {
+    static_assert(DEPENDENT_FALSE<LayoutSrc>, "Unsupported layout of B, only RowMajor and ColumnMajor");
+};
+
+template <>
+struct PackedLayoutSelector<layout::RowMajor> {
+    using Layout = layout::zN;
+};
+
+template <>
+struct PackedLayoutSelector<layout::ColumnMajor> {
+    using Layout = layout::nZ;
+};
+
+template <class LayoutSrc>
+using PackedLayout = typename PackedLayoutSelector<LayoutSrc>::Layout;
+
+// Layout of a packed k x n B of Element, its Capacity() is the element count of the packed buffer.
+template <class Element, class LayoutSrc>
+PackedLayout<LayoutSrc> MakePackedLayout(uint32_t k, uint32_t n)
+{
+    return PackedLayout<LayoutSrc>::template MakeLayout<Element>(k, n);
+}
+
+enum class DequantGranularity {
+    PER_TENSOR,
+    PER_CHANNEL,
+    PER_GROUP
+};
+
+// Dequantization of int8 B to fp16, b = (q + zeroPoint) * scale with every step rounded to fp16, as
+// TileCastInt8ToFp16Dequant computes it. A channel is a column of B, a group is groupSize rows of k within a channel.
+struct DequantParams {
+    DequantGranularity granularity{DequantGranularity::PER_TENSOR};
+    uint32_t groupSize{0};
+    // 1, n or CeilDiv(k, groupSize) * n values, the scales of a group are consecutive
+    std::vector<float> scale;
+    // as many values as scale, or empty for no zero point
+    std::vector<float> zeroPoint;
+};
+
+namespace detail {
+
+// B is walked as a row major view: a column major k x n B is a row major n x k one. Rows and columns below are those
+// of the view, a row of it is a line of B along its contiguous side.
+struct PackView {
+    uint32_t rows{0};
+    uint32_t cols{0};
+    int64_t ldSrc{0};
+    bool transposed{false};
+};
+
+template <class LayoutSrc>
+PackView MakeView(LayoutSrc const &layoutSrc)
+{
+    if constexpr (std::is_same_v<LayoutSrc, layout::RowMajor>) {
+        return {layoutSrc.shape(0), layoutSrc.shape(1), layoutSrc.stride(0), false};
+    } else {
+        static_assert(std::is_same_v<LayoutSrc, layout::ColumnMajor>,
+            "Unsupported layout of B, only RowMajor and ColumnMajor");
+        return {layoutSrc.shape(1), layoutSrc.shape(0), layoutSrc.stride(1), true};
+    }
+}
+
+// layoutDst is the packed layout of the view for Element
+template <class Element, class LayoutDst>
+bool IsPackedLayoutOf(PackView const &view, LayoutDst const &layoutDst)
+{
+    constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+    uint32_t k = view.transposed ? view.cols : view.rows;
+    uint32_t n = view.transposed ? view.rows : view.cols;
+    uint32_t c0 = view.transposed ? layoutDst.shape(0) : layoutDst.shape(2);
+    return layoutDst.orgShape(0) == k && layoutDst.orgShape(1) == n && c0 == ELE_NUM_PER_C0;
+}
+
+// Converts the rows of the view to ElementDst with convertRow(r, out), which writes the cols elements of row r, and
+// packs the result to layoutDst.
+template <class ElementDst, class LayoutSrc, class ConvertRow>
+bool PackRows(PackView const &view, ElementDst *dst, PackedLayout<LayoutSrc> const &layoutDst, uint32_t threadNum,
+    ConvertRow const &convertRow)
+{
+    std::vector<ElementDst> plain(static_cast<size_t>(view.rows) * view.cols);
+    host::ParallelFor(view.rows, plain.size(), threadNum, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t r = begin; r < end; ++r) {
+            convertRow(r, plain.data() + static_cast<size_t>(r) * view.cols);
+        }
+    });
+    // the plain buffer is B of the layout of the source without its padding
+    uint32_t k = view.transposed ? view.cols : view.rows;
+    uint32_t n = view.transposed ? view.rows : view.cols;
+    return convert::NdToFractal(plain.data(), LayoutSrc{k, n}, dst, layoutDst, threadNum);
+}
+
+} // namespace detail
+
+// Widens an int4 B to int8 in its packed layout, the prologue of W4A8Matmul done once. Two int4 share a byte with
+// the element of the lower offset in the low nibble, layoutSrc counts int4 elements and every row (column of a
+// column major B) starts at a byte. dst holds layoutDst.Capacity() elements. Returns false if layoutDst is not the
+// packed layout of B or a row of B does not start at a byte.
+template <class LayoutSrc>
+bool PackInt4ToInt8(
+    uint8_t const *src, LayoutSrc const &layoutSrc,
+    int8_t *dst, PackedLayout<LayoutSrc> const &layoutDst,
+    uint32_t threadNum = 0
+)
+{
+    auto view = detail::MakeView(layoutSrc);
+    if (!detail::IsPackedLayoutOf<int8_t>(view, layoutDst)) {
+        return false;
+    }
+    if (view.ldSrc % 2 != 0) {
+        return false;
+    }
+    // sign extend the 4 bits
+    auto widen = [](uint8_t nibble) {
+        return static_cast<int8_t>(static_cast<int8_t>(nibble << 4) >> 4);
+    };
+    return detail::PackRows<int8_t, LayoutSrc>(view, dst, layoutDst, threadNum, [&](uint32_t r, int8_t *out) {
+        // a row is whole bytes, the last one holds a single element when cols is odd
+        uint8_t const *in = src + r * view.ldSrc / 2;
+        uint32_t pairNum = view.cols / 2;
+        for (uint32_t i = 0; i < pairNum; ++i) {
+            uint8_t byte = in[i];
+            out[2 * i] = widen(byte & 0xF);
+            out[2 * i + 1] = widen(byte >> 4);
+        }
+        if (view.cols % 2 != 0) {
+            out[view.cols - 1] = widen(in[pairNum] & 0xF);
+        }
+    });
+}
+
+// Dequantizes an int8 B to fp16 in its packed layout, the prologue of W8A16Matmul done once, with scales by tensor,
+// by channel or by group of k. ElementDst is the host fp16 type, such as op::fp16_t. dst holds layoutDst.Capacity()
+// elements. Returns false if layoutDst is not the packed layout of B or the scales do not match the granularity.
+template <class ElementDst, class LayoutSrc>
+bool PackInt8ToFp16(
+    int8_t const *src, LayoutSrc const &layoutSrc, DequantParams const &params,
+    ElementDst *dst, PackedLayout<LayoutSrc> const &layoutDst,
+    uint32_t threadNum = 0
+)
+{
+    auto view = detail::MakeView(layoutSrc);
+    if (!detail::IsPackedLayoutOf<ElementDst>(view, layoutDst)) {
+        return false;
+    }
+    uint32_t k = view.transposed ? view.cols : view.rows;
+    uint32_t n = view.transposed ? view.rows : view.cols;
+    size_t scaleNum = 1;
+    if (params.granularity == DequantGranularity::PER_CHANNEL) {
+        scaleNum = n;
+    } else if (params.granularity == DequantGranularity::PER_GROUP) {
+        if (params.groupSize == 0) {
+            return false;
+        }
+        scaleNum = static_cast<size_t>(CeilDiv(k, params.groupSize)) * n;
+    }
+    if (params.scale.size() != scaleNum || (!params.zeroPoint.empty() && params.zeroPoint.size() != scaleNum)) {
+        return false;
+    }
+
+    // scales and zero points are fp16 on the device, round them once
+    auto round = [](float value) {
+        return static_cast<float>(static_cast<ElementDst>(value));
+    };
+    std::vector<float> scale(scaleNum);
+    std::vector<float> zeroPoint(scaleNum, 0.0f);
+    std::transform(params.scale.begin(), params.scale.end(), scale.begin(), round);
+    std::transform(params.zeroPoint.begin(), params.zeroPoint.end(), zeroPoint.begin(), round);
+
+    return detail::PackRows<ElementDst, LayoutSrc>(view, dst, layoutDst, threadNum, [&](uint32_t r, ElementDst *out) {
+        for (uint32_t c = 0; c < view.cols; ++c) {
+            uint32_t row = view.transposed ? c : r;
+            uint32_t col = view.transposed ? r : c;
+            size_t s = 0;
+            if (params.granularity == DequantGranularity::PER_CHANNEL) {
+                s = col;
+            } else if (params.granularity == DequantGranularity::PER_GROUP) {
+                s = static_cast<size_t>(row / params.groupSize) * n + col;
+            }
+            float q = src[r * view.ldSrc + c];
+            // float is wide enough that a sum or product of two fp16 rounded to it and then to fp16 is the fp16
+            // result
+            auto shifted = static_cast<ElementDst>(q + zeroPoint[s]);
+            out[c] = static_cast<ElementDst>(static_cast<float>(shifted) * scale[s]);
+        }
+    });
+}
+
+// Reads a packed B back into layoutDst, to check or debug packed weights.
+template <class Element, class LayoutDst>
+void Unpack(
+    Element const *src, PackedLayout<LayoutDst> const &layoutSrc,
+    Element *dst, LayoutDst const &layoutDst
+)
+{
+    for (uint32_t r = 0; r < layoutSrc.orgShape(0); ++r) {
+        for (uint32_t c = 0; c < layoutSrc.orgShape(1); ++c) {
+            dst[layoutDst.GetOffset(MakeCoord(r, c))] = src[layoutSrc.GetOffset(MakeCoord(r, c))];
+        }
+    }
+}
+
+} // namespace Catlass::prepack
+
+#endif // EXAMPLES_COMMON_WEIGHT_PREPACK_HPP
@@ -32,6 +32,8 @@ enum class TransposeStatus : uint32_t {
 };
 
 TransposeStatus GetTransposeStatus(const at::Tensor &mat);
+// AI cube cores of the soc, queried from the platform once per process
+uint32_t GetAicCoreNum();
 } // namespace CatlassKernelWrapper
 
 #endif
\ No newline at end of file
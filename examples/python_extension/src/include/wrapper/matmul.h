@@ -22,5 +22,8 @@ using OutputType = at::Tensor;
 
 OutputType AllocOutput(KernelInfo &kernelInfo);
 KernelInfo GetKernelInfo(const at::Tensor &mat1, const at::Tensor &mat2, const std::string &outDType);
+// fills kernelInfo in place, a kernelInfo reused across calls keeps its address vectors
+void GetKernelInfo(const at::Tensor &mat1, const at::Tensor &mat2, const std::string &outDType,
+                   KernelInfo &kernelInfo);
 } // namespace CatlassKernelWrapper::MatmulLike
 #endif
\ No newline at end of file
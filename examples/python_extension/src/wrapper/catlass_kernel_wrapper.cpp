@@ -10,7 +10,6 @@
 
 #include "wrapper/catlass_kernel_wrapper.h"
 
-#include <tiling/platform/platform_ascendc.h>
 #include <torch/torch.h>
 #include <torch_npu/csrc/core/npu/DeviceUtils.h>
 #include <torch_npu/csrc/core/npu/NPUFormat.h>
@@ -23,6 +22,7 @@
 #include <unordered_map>
 
 #include "catlass_kernel.h"
+#include "wrapper/common.h"
 #include "wrapper/grouped_matmul.h"
 #include "wrapper/matmul.h"
 #include "wrapper/conv.h"
@@ -32,13 +32,15 @@ using namespace CatlassKernel;
 
 namespace CatlassKernelWrapper {
 
+// The matmuls launch straight away on repeated shapes: the kernels of the shared library cache their launch plans,
+// the core count is queried once and kernelInfo of the calling thread is reused.
 at::Tensor RunBasicMatmul(const at::Tensor &mat1, const at::Tensor &mat2, const std::string &outDType)
 {
-    KernelInfo kernelInfo = MatmulLike::GetKernelInfo(mat1, mat2, outDType);
+    thread_local KernelInfo kernelInfo;
+    MatmulLike::GetKernelInfo(mat1, mat2, outDType, kernelInfo);
     at::Tensor output = MatmulLike::AllocOutput(kernelInfo);
     aclrtStream stream = c10_npu::getCurrentNPUStream().stream(false);
-    uint32_t aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
-    BasicMatmul(aicCoreNum, stream, kernelInfo);
+    BasicMatmul(GetAicCoreNum(), stream, kernelInfo);
     return output;
 }
 
@@ -53,18 +55,17 @@ at::Tensor RunGroupedMatmul(const at::Tensor &mat1,
     KernelInfo kernelInfo = GroupedMatmulLike::GetKernelInfo(mat1, mat2, groupList, outDType, transA, transB, splitK);
     at::Tensor output = GroupedMatmulLike::AllocOutput(kernelInfo);
     aclrtStream stream = c10_npu::getCurrentNPUStream().stream(false);
-    uint32_t aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
-    GroupedMatmul(aicCoreNum, stream, kernelInfo);
+    GroupedMatmul(GetAicCoreNum(), stream, kernelInfo);
     return output;
 }
 
 at::Tensor RunOptimizedMatmul(const at::Tensor &mat1, const at::Tensor &mat2, const std::string &outDType)
 {
-    KernelInfo kernelInfo = MatmulLike::GetKernelInfo(mat1, mat2, outDType);
+    thread_local KernelInfo kernelInfo;
+    MatmulLike::GetKernelInfo(mat1, mat2, outDType, kernelInfo);
     at::Tensor output = MatmulLike::AllocOutput(kernelInfo);
     aclrtStream stream = c10_npu::getCurrentNPUStream().stream(false);
-    uint32_t aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
-    OptimizedMatmul(aicCoreNum, stream, kernelInfo);
+    OptimizedMatmul(GetAicCoreNum(), stream, kernelInfo);
     return output;
 }
 
@@ -77,8 +78,7 @@ at::Tensor RunConvBias(const at::Tensor &fmap, const at::Tensor &filter, const a
                                                         outDType);
     at::Tensor output = ConvLike::AllocOutput(kernelInfo);
     aclrtStream stream = c10_npu::getCurrentNPUStream().stream(false);
-    uint32_t aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
-    ConvBias(aicCoreNum, stream, kernelInfo);
+    ConvBias(GetAicCoreNum(), stream, kernelInfo);
     return output;
 }
 } // namespace CatlassKernelWrapper
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include <acl/acl.h>
 
+#include <tiling/platform/platform_ascendc.h>
 #include <torch/torch.h>
 #include <torch_npu/csrc/core/npu/DeviceUtils.h>
 #include <torch_npu/csrc/core/npu/NPUFormat.h>
@@ -81,4 +82,10 @@ TransposeStatus GetTransposeStatus(const at::Tensor &mat)
     }
     return TransposeStatus::NON_CONTINUOUS;
 }
+
+uint32_t GetAicCoreNum()
+{
+    static const uint32_t aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
+    return aicCoreNum;
+}
 } // namespace CatlassKernelWrapper
\ No newline at end of file
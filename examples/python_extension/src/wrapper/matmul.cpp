@@ -28,6 +28,13 @@ OutputType AllocOutput(KernelInfo &kernelInfo)
 KernelInfo GetKernelInfo(const at::Tensor &mat1, const at::Tensor &mat2, const std::string &outDType)
 {
     KernelInfo kernelInfo;
+    GetKernelInfo(mat1, mat2, outDType, kernelInfo);
+    return kernelInfo;
+}
+
+void GetKernelInfo(const at::Tensor &mat1, const at::Tensor &mat2, const std::string &outDType,
+                   KernelInfo &kernelInfo)
+{
     kernelInfo.inputAddr.resize(2);
     kernelInfo.inputAddr[0] = static_cast<uint8_t *>(const_cast<void *>(mat1.storage().data()));
     kernelInfo.inputAddr[1] = static_cast<uint8_t *>(const_cast<void *>(mat2.storage().data()));
@@ -56,6 +63,5 @@ KernelInfo GetKernelInfo(const at::Tensor &mat1, const at::Tensor &mat2, const s
     }
     kernelInfo.transA = static_cast<bool>(transposeStatus1);
     kernelInfo.transB = static_cast<bool>(transposeStatus2);
-    return kernelInfo;
 }
 } // namespace CatlassKernelWrapper::MatmulLike
\ No newline at end of file
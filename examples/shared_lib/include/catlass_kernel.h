@@ -61,6 +61,9 @@ void BasicMatmul(const uint32_t blockNum, aclrtStream stream, const KernelInfo &
 void GroupedMatmul(const uint32_t blockNum, aclrtStream stream, const KernelInfo &kernelInfo);
 void OptimizedMatmul(const uint32_t blockNum, aclrtStream stream, const KernelInfo &kernelInfo);
 void ConvBias(uint32_t blockNum, aclrtStream stream, ConvKernelInfo kernelInfo);
+// Kernels return right after launching, workspaces stay cached for later launches. Frees the cached workspaces
+// no launched kernel uses anymore, e.g. before aclFinalize or when device memory runs short.
+void EmptyWorkspaceCache();
 } // namespace CatlassKernel
 
 #endif // SHARED_LIB_CATLASS_KERNEL_H
\ No newline at end of file
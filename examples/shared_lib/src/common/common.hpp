@@ -16,6 +16,9 @@
 #include "catlass/debug.hpp"
 #include "catlass/detail/dependent_false.hpp"
 #include "catlass/layout/layout.hpp"
+#include "catlass_kernel.h"
+#include "launch_plan_cache.hpp"
+#include "workspace_pool.hpp"
 
 namespace CatlassKernel {
 using namespace Catlass;
@@ -53,25 +56,115 @@ struct Transpose2Layout {
     using layout = std::conditional_t<IS_TRANSPOSE, Catlass::layout::ColumnMajor, Catlass::layout::RowMajor>;
 };
 
+class AclWorkspaceAllocator : public WorkspaceAllocator {
+public:
+    void *Malloc(size_t size) override {
+        void *ptr = nullptr;
+        if (aclrtMalloc(&ptr, size, ACL_MEM_MALLOC_HUGE_FIRST) != ACL_SUCCESS) {
+            return nullptr;
+        }
+        return ptr;
+    }
+
+    void Free(void *ptr) override {
+        aclCheck(aclrtFree(ptr));
+    }
+
+    Event CreateEvent() override {
+        aclrtEvent event = nullptr;
+        aclCheck(aclrtCreateEvent(&event));
+        return event;
+    }
+
+    void DestroyEvent(Event event) override {
+        aclCheck(aclrtDestroyEvent(static_cast<aclrtEvent>(event)));
+    }
+
+    void RecordEvent(Event event, Stream stream) override {
+        aclCheck(aclrtRecordEvent(static_cast<aclrtEvent>(event), static_cast<aclrtStream>(stream)));
+    }
+
+    bool QueryEvent(Event event) override {
+        aclrtEventRecordedStatus status = ACL_EVENT_RECORDED_STATUS_NOT_READY;
+        aclCheck(aclrtQueryEventStatus(static_cast<aclrtEvent>(event), &status));
+        return status == ACL_EVENT_RECORDED_STATUS_COMPLETE;
+    }
+};
+
+// Workspaces of all kernels of the library, shared by the streams of the process.
+inline WorkspacePool &GetWorkspacePool() {
+    static AclWorkspaceAllocator allocator;
+    static WorkspacePool pool(allocator);
+    return pool;
+}
+
+// Launches the kernel without waiting for it, the caller synchronizes the stream before reading the outputs.
+// The workspace is handed back to the pool right after the launch, kernels launched later on the same stream
+// reuse it in stream order.
 template <class Adapter>
-void RunAdapter(
+void LaunchAdapter(
     Adapter matmulOp,
     typename Adapter::Arguments args,
     aclrtStream stream,
     uint32_t aicCoreNum,
-    uint64_t fftsAddr = 0
+    uint64_t fftsAddr,
+    size_t sizeWorkspace
 ) {
-    size_t sizeWorkspace = matmulOp.GetWorkspaceSize(args);
     uint8_t *deviceWorkspace = nullptr;
     if (sizeWorkspace > 0) {
-        aclCheck(aclrtMalloc(reinterpret_cast<void **>(&deviceWorkspace), sizeWorkspace, ACL_MEM_MALLOC_HUGE_FIRST));
+        deviceWorkspace = GetWorkspacePool().Allocate(sizeWorkspace, stream);
+        if (deviceWorkspace == nullptr) {
+            aclCheck(ACL_ERROR_BAD_ALLOC);
+            return;
+        }
     }
     matmulOp.Initialize(args, deviceWorkspace);
     matmulOp(stream, aicCoreNum, fftsAddr);
-    aclCheck(aclrtSynchronizeStream(stream));
-    if (sizeWorkspace > 0) {
-        aclCheck(aclrtFree(deviceWorkspace));
-    }
+    GetWorkspacePool().Release(deviceWorkspace, stream);
+}
+
+template <class Adapter>
+void RunAdapter(
+    Adapter matmulOp,
+    typename Adapter::Arguments args,
+    aclrtStream stream,
+    uint32_t aicCoreNum,
+    uint64_t fftsAddr = 0
+) {
+    size_t sizeWorkspace = matmulOp.GetWorkspaceSize(args);
+    LaunchAdapter(matmulOp, args, stream, aicCoreNum, fftsAddr, sizeWorkspace);
+}
+
+// Everything a launch needs besides the tensors, resolved on the first call of a problem.
+struct LaunchPlan {
+    using LaunchFunc = void (*)(const LaunchPlan &plan, aclrtStream stream, const KernelInfo &kernelInfo);
+    LaunchFunc launch{nullptr};   // instantiation of the selected tiling, layouts and padding
+    size_t workspaceSize{0};
+    uint64_t fftsAddr{0};
+    uint32_t blockNum{0};
+};
+
+inline LaunchPlanKey GetLaunchPlanKey(const KernelInfo &kernelInfo, uint32_t blockNum) {
+    int32_t deviceId = 0;
+    aclCheck(aclrtGetDevice(&deviceId));
+    return {kernelInfo.m, kernelInfo.n, kernelInfo.k, kernelInfo.b,
+        static_cast<int32_t>(kernelInfo.inputDataType), static_cast<int32_t>(kernelInfo.outputDataType),
+        deviceId, blockNum, kernelInfo.transA, kernelInfo.transB};
+}
+
+// Instance has the Adapter of a kernel and makes its Arguments with GetArguments(kernelInfo).
+template <class Instance>
+void LaunchInstance(const LaunchPlan &plan, aclrtStream stream, const KernelInfo &kernelInfo) {
+    typename Instance::Adapter adapter;
+    LaunchAdapter(adapter, Instance::GetArguments(kernelInfo), stream, plan.blockNum, plan.fftsAddr,
+        plan.workspaceSize);
+}
+
+template <class Instance>
+LaunchPlan MakeLaunchPlan(const KernelInfo &kernelInfo, uint32_t blockNum, uint64_t fftsAddr = 0) {
+    using Adapter = typename Instance::Adapter;
+    return {&LaunchInstance<Instance>, Adapter::GetWorkspaceSize(Instance::GetArguments(kernelInfo)), fftsAddr,
+        blockNum};
 }
 
 inline bool IsNeedPadding(layout::RowMajor layout, uint32_t align) {
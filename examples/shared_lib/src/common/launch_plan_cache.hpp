@@ -0,0 +1,124 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef SHARED_LIB_COMMON_LAUNCH_PLAN_CACHE_HPP
+#define SHARED_LIB_COMMON_LAUNCH_PLAN_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace CatlassKernel {
+
+// Problem a launch plan is resolved for. Tensor addresses are not part of it, a plan holds for any tensors of the
+// same shapes, dtypes and layouts on the same device.
+struct LaunchPlanKey {
+    uint32_t m{0};
+    uint32_t n{0};
+    uint32_t k{0};
+    uint32_t b{0};
+    int32_t inputDataType{0};
+    int32_t outputDataType{0};
+    int32_t deviceId{0};
+    uint32_t blockNum{0};
+    bool transA{false};
+    bool transB{false};
+
+    bool operator==(const LaunchPlanKey &other) const {
+        return m == other.m && n == other.n && k == other.k && b == other.b &&
+               inputDataType == other.inputDataType && outputDataType == other.outputDataType &&
+               deviceId == other.deviceId && blockNum == other.blockNum && transA == other.transA &&
+               transB == other.transB;
+    }
+};
+
+struct LaunchPlanKeyHash {
+    size_t operator()(const LaunchPlanKey &key) const {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        auto mix = [&h](uint64_t v) {
+            h ^= v;
+            h *= 0x100000001b3ULL;
+        };
+        mix(key.m);
+        mix(key.n);
+        mix(key.k);
+        mix(key.b);
+        mix(static_cast<uint64_t>(static_cast<uint32_t>(key.inputDataType)) << 32 |
+            static_cast<uint32_t>(key.outputDataType));
+        mix(static_cast<uint64_t>(static_cast<uint32_t>(key.deviceId)) << 32 | key.blockNum);
+        mix(static_cast<uint64_t>(key.transA) << 1 | static_cast<uint64_t>(key.transB));
+        return static_cast<size_t>(h);
+    }
+};
+
+struct LaunchPlanCacheStats {
+    size_t hits{0};
+    size_t misses{0};   // plans built
+    size_t plans{0};    // plans cached now
+};
+
+// Plans of one kernel by problem, shared by the threads of the process.
+//
+// The first call of a problem builds its plan: tuning lookup, tiling selection, padding branches, workspace size and
+// FFTS address. Later calls copy the plan out under a shared lock and launch right away. Plans are small and copied,
+// so no caller holds a reference into the map. When capacity plans are cached the cache starts over, a workload of
+// endless dynamic shapes only costs a rebuild now and then.
+template <class Plan>
+class LaunchPlanCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    explicit LaunchPlanCache(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity) {}
+
+    // the plan of key, built by build() if it is not cached, two threads may both build a new plan
+    template <class Build>
+    Plan Get(const LaunchPlanKey &key, Build &&build) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            if (auto it = plans_.find(key); it != plans_.end()) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return it->second;
+            }
+        }
+        // built outside of the lock, building may take long and launch other kernels
+        Plan plan = std::invoke(std::forward<Build>(build));
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (plans_.size() >= capacity_) {
+            plans_.clear();
+        }
+        plans_.insert_or_assign(key, plan);
+        return plan;
+    }
+
+    void Clear() {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        plans_.clear();
+    }
+
+    LaunchPlanCacheStats GetStats() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return {hits_.load(std::memory_order_relaxed), misses_.load(std::memory_order_relaxed), plans_.size()};
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<LaunchPlanKey, Plan, LaunchPlanKeyHash> plans_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+    size_t capacity_;
+};
+
+} // namespace CatlassKernel
+#endif // SHARED_LIB_COMMON_LAUNCH_PLAN_CACHE_HPP
@@ -0,0 +1,140 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef SHARED_LIB_COMMON_TUNING_HPP
+#define SHARED_LIB_COMMON_TUNING_HPP
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <acl/acl.h>
+
+#include "catlass/library/tuning_db.h"
+#include "catlass_kernel.h"
+
+namespace CatlassKernel {
+
+// Tiling a kernel of the shared library is instantiated with, L1TileShape and L0TileShape are GemmShape.
+template <class L1TileShape_, class L0TileShape_, uint32_t SWIZZLE_DIRECTION_>
+struct TileConfig {
+    using L1TileShape = L1TileShape_;
+    using L0TileShape = L0TileShape_;
+    static constexpr uint32_t SWIZZLE_DIRECTION = SWIZZLE_DIRECTION_;
+};
+
+// Tuning database given by CATLASS_TUNING_DB, generated by mstuner_catlass --tuning_db. Loaded once per process.
+inline const Catlass::Library::TuningDatabase &GetTuningDatabase() {
+    static const Catlass::Library::TuningDatabase database = [] {
+        Catlass::Library::TuningDatabase db;
+        const char *path = std::getenv("CATLASS_TUNING_DB");
+        if (path != nullptr && !db.Load(path)) {
+            std::cerr << "Load tuning database " << path << " failed: " << db.Error()
+                      << ", use the default tiling" << std::endl;
+            return Catlass::Library::TuningDatabase{};
+        }
+        return db;
+    }();
+    return database;
+}
+
+// dtype:layout string of the tuning database, same as the --A/--B/--C options of mstuner_catlass
+inline std::string GetTensorStr(aclDataType dataType, bool trans) {
+    std::string str;
+    switch (dataType) {
+        case ACL_FLOAT16:
+            str = "fp16";
+            break;
+        case ACL_BF16:
+            str = "bf16";
+            break;
+        case ACL_FLOAT:
+            str = "fp32";
+            break;
+        case ACL_INT8:
+            str = "int8";
+            break;
+        case ACL_INT32:
+            str = "int32";
+            break;
+        default:
+            return str;
+    }
+    return str + (trans ? ":column" : ":row");
+}
+
+// Tuned tiling of the kernel for the problem shape, nullptr when nothing near the shape is tuned.
+inline const Catlass::Library::TuningRecord *LookupTuning(const std::string &kernel, const KernelInfo &kernelInfo) {
+    const Catlass::Library::TuningDatabase &db = GetTuningDatabase();
+    if (db.Size() == 0) {
+        return nullptr;
+    }
+    static const std::string device = [] {
+        const char *soc = aclrtGetSocName();
+        return std::string(soc != nullptr ? soc : "");
+    }();
+    return db.Lookup(kernel, GetTensorStr(kernelInfo.inputDataType, kernelInfo.transA),
+        GetTensorStr(kernelInfo.inputDataType, kernelInfo.transB), GetTensorStr(kernelInfo.outputDataType, false),
+        device, kernelInfo.m, kernelInfo.n, kernelInfo.k);
+}
+
+template <class TileConfig>
+double TileConfigDistance(const Catlass::Library::TuningRecord &record) {
+    using L1TileShape = typename TileConfig::L1TileShape;
+    using L0TileShape = typename TileConfig::L0TileShape;
+    auto dist = [](uint32_t lhs, uint32_t rhs) {
+        return std::fabs(std::log2(static_cast<double>(lhs) / rhs));
+    };
+    double distance = dist(L1TileShape::M, record.l1TileShape[0]) + dist(L1TileShape::N, record.l1TileShape[1]) +
+                      dist(L1TileShape::K, record.l1TileShape[2]) + dist(L0TileShape::K, record.l0TileShape[2]);
+    // a different swizzle direction weighs less than any different tile size
+    constexpr double SWIZZLE_MISMATCH = 0.5;
+    return distance + (TileConfig::SWIZZLE_DIRECTION == record.swizzleDirection ? 0 : SWIZZLE_MISMATCH);
+}
+
+template <class TileConfigs, size_t... I>
+size_t SelectTileConfigImpl(const Catlass::Library::TuningRecord &record, std::index_sequence<I...>) {
+    const double distances[] = {TileConfigDistance<std::tuple_element_t<I, TileConfigs>>(record)...};
+    size_t best = 0;
+    for (size_t i = 1; i < sizeof...(I); ++i) {
+        if (distances[i] < distances[best]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Index of the instantiated config nearest to the tuned tiling, defaultIdx when the shape is not tuned.
+template <class TileConfigs>
+size_t SelectTileConfig(const Catlass::Library::TuningRecord *record, size_t defaultIdx) {
+    if (record == nullptr || record->l1TileShape[0] == 0 || record->l1TileShape[1] == 0 ||
+        record->l1TileShape[2] == 0 || record->l0TileShape[2] == 0) {
+        return defaultIdx;
+    }
+    return SelectTileConfigImpl<TileConfigs>(*record, std::make_index_sequence<std::tuple_size_v<TileConfigs>>{});
+}
+
+// Call func with the idx-th config of TileConfigs, e.g. func(TileConfig<...>{}).
+template <class TileConfigs, class Func, size_t... I>
+void DispatchTileConfigImpl(size_t idx, Func &&func, std::index_sequence<I...>) {
+    ((idx == I ? func(std::tuple_element_t<I, TileConfigs>{}) : void()), ...);
+}
+
+template <class TileConfigs, class Func>
+void DispatchTileConfig(size_t idx, Func &&func) {
+    DispatchTileConfigImpl<TileConfigs>(idx, std::forward<Func>(func),
+        std::make_index_sequence<std::tuple_size_v<TileConfigs>>{});
+}
+
+} // namespace CatlassKernel
+#endif // SHARED_LIB_COMMON_TUNING_HPP
@@ -0,0 +1,213 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef SHARED_LIB_COMMON_WORKSPACE_POOL_HPP
+#define SHARED_LIB_COMMON_WORKSPACE_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace CatlassKernel {
+
+// Device memory and events the workspace pool is built on, acl in the shared library and a fake device in host
+// tests. Streams and events are opaque handles, as aclrtStream and aclrtEvent are.
+class WorkspaceAllocator {
+public:
+    using Stream = void *;
+    using Event = void *;
+
+    virtual ~WorkspaceAllocator() = default;
+    // nullptr when out of memory
+    virtual void *Malloc(size_t size) = 0;
+    virtual void Free(void *ptr) = 0;
+    virtual Event CreateEvent() = 0;
+    virtual void DestroyEvent(Event event) = 0;
+    // event completes once the work queued on stream so far is done
+    virtual void RecordEvent(Event event, Stream stream) = 0;
+    virtual bool QueryEvent(Event event) = 0;
+};
+
+struct WorkspacePoolStats {
+    size_t mallocs{0};          // blocks allocated from the device
+    size_t frees{0};            // blocks returned to the device
+    size_t sameStreamHits{0};   // reused right away by the stream that released them
+    size_t crossStreamHits{0};  // reused by another stream after their event completed
+    size_t cachedBytes{0};      // bytes of the free blocks
+    size_t allocatedBytes{0};   // bytes of all blocks
+};
+
+// Stream ordered caching allocator of kernel workspaces.
+//
+// A workspace is released right after the kernel using it is launched, without waiting for the kernel. Work on one
+// stream runs in order, so the next launch on that stream can take the block at once; another stream only takes it
+// once the event recorded at release completes. Sizes are rounded up to size classes so that blocks fit the
+// workspaces of many shapes, and blocks stay cached until EmptyCache.
+class WorkspacePool {
+public:
+    using Stream = WorkspaceAllocator::Stream;
+    using Event = WorkspaceAllocator::Event;
+
+    explicit WorkspacePool(WorkspaceAllocator &allocator) : allocator_(allocator) {}
+    WorkspacePool(const WorkspacePool &) = delete;
+    WorkspacePool &operator=(const WorkspacePool &) = delete;
+
+    // Cached blocks are not freed here: a static pool outlives aclFinalize, the device frees them with the context.
+    ~WorkspacePool() = default;
+
+    // Small workspaces are rounded up to a power of 2, large ones to whole huge pages.
+    static size_t GetSizeClass(size_t size) {
+        constexpr size_t MIN_BLOCK_SIZE = 512;
+        constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+        if (size >= HUGE_PAGE_SIZE) {
+            return (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+        size_t sizeClass = MIN_BLOCK_SIZE;
+        while (sizeClass < size) {
+            sizeClass *= 2;
+        }
+        return sizeClass;
+    }
+
+    // Workspace of at least size bytes for kernels launched on stream, nullptr for size 0 or out of memory.
+    uint8_t *Allocate(size_t size, Stream stream) {
+        if (size == 0) {
+            return nullptr;
+        }
+        size_t sizeClass = GetSizeClass(size);
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (uint8_t *ptr = TakeCached(sizeClass, stream); ptr != nullptr) {
+            return ptr;
+        }
+        void *ptr = allocator_.Malloc(sizeClass);
+        if (ptr == nullptr) {
+            // out of memory, give back the blocks no stream uses anymore and retry once
+            ReleaseCompleted();
+            ptr = allocator_.Malloc(sizeClass);
+            if (ptr == nullptr) {
+                return nullptr;
+            }
+        }
+        ++stats_.mallocs;
+        stats_.allocatedBytes += sizeClass;
+        Block &block = blocks_[static_cast<uint8_t *>(ptr)];
+        block.size = sizeClass;
+        block.stream = stream;
+        block.inUse = true;
+        return static_cast<uint8_t *>(ptr);
+    }
+
+    // Give back a workspace once the last kernel using it is launched on stream, the kernel may still be running.
+    void Release(uint8_t *ptr, Stream stream) {
+        if (ptr == nullptr) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = blocks_.find(ptr);
+        if (it == blocks_.end() || !it->second.inUse) {
+            return;
+        }
+        Block &block = it->second;
+        if (block.event == nullptr) {
+            block.event = allocator_.CreateEvent();
+        }
+        allocator_.RecordEvent(block.event, stream);
+        block.stream = stream;
+        block.inUse = false;
+        freeBlocks_[block.size].push_back(ptr);
+        stats_.cachedBytes += block.size;
+    }
+
+    // Free the cached blocks whose last kernel completed.
+    void EmptyCache() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        ReleaseCompleted();
+    }
+
+    WorkspacePoolStats GetStats() const {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return stats_;
+    }
+
+private:
+    struct Block {
+        size_t size{0};
+        Stream stream{nullptr};     // stream of the last use
+        Event event{nullptr};       // recorded on stream at the last release
+        bool inUse{false};
+    };
+
+    // Prefer the latest block released by the same stream, then any block whose last use completed.
+    uint8_t *TakeCached(size_t sizeClass, Stream stream) {
+        auto it = freeBlocks_.find(sizeClass);
+        if (it == freeBlocks_.end() || it->second.empty()) {
+            return nullptr;
+        }
+        std::vector<uint8_t *> &candidates = it->second;
+        size_t found = candidates.size();
+        for (size_t i = candidates.size(); i > 0; --i) {
+            if (blocks_[candidates[i - 1]].stream == stream) {
+                found = i - 1;
+                ++stats_.sameStreamHits;
+                break;
+            }
+        }
+        if (found == candidates.size()) {
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (allocator_.QueryEvent(blocks_[candidates[i]].event)) {
+                    found = i;
+                    ++stats_.crossStreamHits;
+                    break;
+                }
+            }
+        }
+        if (found == candidates.size()) {
+            return nullptr;
+        }
+        uint8_t *ptr = candidates[found];
+        candidates.erase(candidates.begin() + found);
+        Block &block = blocks_[ptr];
+        block.stream = stream;
+        block.inUse = true;
+        stats_.cachedBytes -= block.size;
+        return ptr;
+    }
+
+    void ReleaseCompleted() {
+        for (auto &[sizeClass, candidates] : freeBlocks_) {
+            std::vector<uint8_t *> pending;
+            for (uint8_t *ptr : candidates) {
+                auto it = blocks_.find(ptr);
+                if (!allocator_.QueryEvent(it->second.event)) {
+                    pending.push_back(ptr);
+                    continue;
+                }
+                allocator_.DestroyEvent(it->second.event);
+                allocator_.Free(ptr);
+                ++stats_.frees;
+                stats_.cachedBytes -= sizeClass;
+                stats_.allocatedBytes -= sizeClass;
+                blocks_.erase(it);
+            }
+            candidates.swap(pending);
+        }
+    }
+
+    WorkspaceAllocator &allocator_;
+    mutable std::mutex mtx_;
+    std::unordered_map<uint8_t *, Block> blocks_;
+    std::unordered_map<size_t, std::vector<uint8_t *>> freeBlocks_;
+    WorkspacePoolStats stats_;
+};
+
+} // namespace CatlassKernel
+#endif // SHARED_LIB_COMMON_WORKSPACE_POOL_HPP
@@ -24,22 +24,29 @@
 
 #include "catlass_kernel.h"
 #include "common.hpp"
+#include "tuning.hpp"
 
 namespace CatlassKernel {
 using namespace Catlass;
 
-template <class LayoutA, class LayoutB, class LayoutC, class InDType, class OutDType>
-void BasicMatmulImpl(const uint32_t blockNum, aclrtStream stream, const KernelInfo &kernelInfo) {
-    GemmCoord problemShape{kernelInfo.m, kernelInfo.n, kernelInfo.k};
-    uint8_t *deviceA = kernelInfo.inputAddr.at(0);
-    uint8_t *deviceB = kernelInfo.inputAddr.at(1);
-    uint8_t *deviceC = kernelInfo.outputAddr.at(0);
+// Tilings instantiated for BasicMatmul, the first one is used when the shape is not in the tuning database.
+using BasicMatmulTileConfigs = std::tuple<
+    TileConfig<GemmShape<128, 256, 256>, GemmShape<128, 256, 64>, 0>,
+    TileConfig<GemmShape<128, 256, 256>, GemmShape<128, 256, 64>, 1>,
+    TileConfig<GemmShape<256, 128, 256>, GemmShape<256, 128, 64>, 0>,
+    TileConfig<GemmShape<256, 128, 256>, GemmShape<256, 128, 64>, 1>,
+    TileConfig<GemmShape<128, 128, 256>, GemmShape<128, 128, 64>, 0>,
+    TileConfig<GemmShape<128, 128, 256>, GemmShape<128, 128, 64>, 1>,
+    TileConfig<GemmShape<64, 256, 256>, GemmShape<64, 256, 64>, 0>,
+    TileConfig<GemmShape<64, 256, 256>, GemmShape<64, 256, 64>, 1>>;
 
+template <class LayoutA, class LayoutB, class LayoutC, class InDType, class OutDType, class Config>
+struct BasicMatmulInstance {
     using ArchTag = Arch::AtlasA2;
     using DispatchPolicy = Gemm::MmadAtlasA2Pingpong<true>;
 
-    using L1TileShape = GemmShape<128, 256, 256>;
-    using L0TileShape = GemmShape<128, 256, 64>;
+    using L1TileShape = typename Config::L1TileShape;
+    using L0TileShape = typename Config::L0TileShape;
 
     using AType = Gemm::GemmType<InDType, LayoutA>;
     using BType = Gemm::GemmType<InDType, LayoutB>;
@@ -48,22 +55,39 @@ void BasicMatmulImpl(const uint32_t blockNum, aclrtStream stream, const KernelIn
     using BlockMmad = Gemm::Block::BlockMmad<DispatchPolicy, L1TileShape, L0TileShape, AType, BType, CType>;
     using BlockEpilogue = void;
 
-    // Swizzle offset is 3 and direction is 0.
-    using BlockScheduler = typename Gemm::Block::GemmIdentityBlockSwizzle<3, 0>;
+    // Swizzle offset is 3, direction is given by the tile config.
+    using BlockScheduler = typename Gemm::Block::GemmIdentityBlockSwizzle<3, Config::SWIZZLE_DIRECTION>;
 
     // kernel level
     using MatmulKernel = typename Gemm::Kernel::BasicMatmul<BlockMmad, BlockEpilogue, BlockScheduler>;
-    using MatmulAdapter = typename Gemm::Device::DeviceGemm<MatmulKernel>;
+    using Adapter = typename Gemm::Device::DeviceGemm<MatmulKernel>;
 
-    typename MatmulKernel::Arguments arguments{problemShape, deviceA, deviceB, deviceC};
-    MatmulAdapter matmulOp;
-    RunAdapter<MatmulAdapter>(matmulOp, arguments, stream, blockNum);
-}
+    static typename MatmulKernel::Arguments GetArguments(const KernelInfo &kernelInfo) {
+        GemmCoord problemShape{kernelInfo.m, kernelInfo.n, kernelInfo.k};
+        uint8_t *deviceA = kernelInfo.inputAddr.at(0);
+        uint8_t *deviceB = kernelInfo.inputAddr.at(1);
+        uint8_t *deviceC = kernelInfo.outputAddr.at(0);
+        return {problemShape, deviceA, deviceB, deviceC};
+    }
+};
 
 void BasicMatmul(const uint32_t blockNum, aclrtStream stream, const KernelInfo &kernelInfo) {
     if (kernelInfo.inputDataType == ACL_FLOAT16 && kernelInfo.outputDataType == ACL_FLOAT16 && !kernelInfo.transA
         && !kernelInfo.transB) {
-        BasicMatmulImpl<layout::RowMajor, layout::RowMajor, layout::RowMajor, half, half>(blockNum, stream, kernelInfo);
+        static LaunchPlanCache<LaunchPlan> plans;
+        LaunchPlan plan = plans.Get(GetLaunchPlanKey(kernelInfo, blockNum), [&] {
+            // Pick the instantiated tiling nearest to the tuned one of CATLASS_TUNING_DB.
+            size_t configIdx =
+                SelectTileConfig<BasicMatmulTileConfigs>(LookupTuning("basic_matmul", kernelInfo), 0);
+            LaunchPlan built;
+            DispatchTileConfig<BasicMatmulTileConfigs>(configIdx, [&](auto tileConfig) {
+                using Config = decltype(tileConfig);
+                built = MakeLaunchPlan<BasicMatmulInstance<layout::RowMajor, layout::RowMajor, layout::RowMajor,
+                    half, half, Config>>(kernelInfo, blockNum);
+            });
+            return built;
+        });
+        plan.launch(plan, stream, kernelInfo);
     }
     // If more conditions are needed, add branches manually.
 }
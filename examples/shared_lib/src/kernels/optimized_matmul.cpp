@@ -25,6 +25,7 @@
 
 #include "catlass_kernel.h"
 #include "common.hpp"
+#include "tuning.hpp"
 
 namespace Catlass {
 template <
@@ -66,124 +67,117 @@ struct TileCopyOpt : public Catlass::Gemm::Tile::TileCopy<ArchTag, AType, BType,
 
 namespace CatlassKernel {
 using namespace Catlass;
-template <class LayoutA, class LayoutB, class LayoutC, class InDType, class OutDType, bool M_GT_N>
-void OptimizedMatmulImpl(const uint32_t blockNum, aclrtStream stream, const KernelInfo &kernelInfo) {
+// Tilings instantiated for OptimizedMatmul, selected by the tuning database or by the problem shape.
+// If LayoutA and LayoutB are both ColumnMajor, the default should be GemmShape<256, 128, 256> (index 2 and 3).
+using OptimizedMatmulTileConfigs = std::tuple<
+    TileConfig<GemmShape<128, 256, 256>, GemmShape<128, 256, 64>, 0>,
+    TileConfig<GemmShape<128, 256, 256>, GemmShape<128, 256, 64>, 1>,
+    TileConfig<GemmShape<256, 128, 256>, GemmShape<256, 128, 64>, 0>,
+    TileConfig<GemmShape<256, 128, 256>, GemmShape<256, 128, 64>, 1>>;
+
+template <class LayoutA, class LayoutB, class LayoutC, class InDType, class OutDType, class Config, bool PADDING_A,
+    bool PADDING_B>
+struct OptimizedMatmulInstance {
     using ArchTag = Arch::AtlasA2;
-    constexpr uint32_t alignByByte = 512;
-    constexpr uint32_t alignByElement = alignByByte / sizeof(InDType);
-    constexpr bool ENABLE_UNIT_FLAG = true;
-    constexpr bool ENABLE_SHUFFLE_K = true;
+    static constexpr bool ENABLE_UNIT_FLAG = true;
+    static constexpr bool ENABLE_SHUFFLE_K = true;
     using ElementA = InDType;
     using ElementB = InDType;
     using ElementC = OutDType;
-    using AType = Gemm::GemmType<ElementA, LayoutA>;
-    using BType = Gemm::GemmType<ElementB, LayoutB>;
     using CType = Gemm::GemmType<ElementC, LayoutC>;
     using DispatchPolicy = Gemm::MmadAtlasA2Preload<ENABLE_UNIT_FLAG, ENABLE_SHUFFLE_K>;
     using PaddingTag = Catlass::Gemm::Kernel::PaddingTag;
     // Layout zN or layout nZ does not require padding operation.
-    constexpr PaddingTag paddingTagA = (std::is_same_v<LayoutA, layout::zN> || std::is_same_v<LayoutA, layout::nZ>)
-                                           ? PaddingTag::NO_PADDING
-                                           : PaddingTag::PADDING_BLOCK_ND;
-    constexpr PaddingTag paddingTagB = (std::is_same_v<LayoutB, layout::zN> || std::is_same_v<LayoutB, layout::nZ>)
-                                           ? PaddingTag::NO_PADDING
-                                           : PaddingTag::PADDING_BLOCK_ND;
+    static constexpr PaddingTag paddingTagA = (std::is_same_v<LayoutA, layout::zN> ||
+                                               std::is_same_v<LayoutA, layout::nZ>)
+                                                  ? PaddingTag::NO_PADDING
+                                                  : PaddingTag::PADDING_BLOCK_ND;
+    static constexpr PaddingTag paddingTagB = (std::is_same_v<LayoutB, layout::zN> ||
+                                               std::is_same_v<LayoutB, layout::nZ>)
+                                                  ? PaddingTag::NO_PADDING
+                                                  : PaddingTag::PADDING_BLOCK_ND;
     static const uint32_t COMPUTE_LENGTH_A = 96 * 1024 / sizeof(ElementA);
     using PaddingBuilderA = Catlass::Gemm::Kernel::PaddingBuilder<
         paddingTagA, ArchTag, ElementA, LayoutA, COMPUTE_LENGTH_A>;
-    using GlobalPaddingA = typename PaddingBuilderA::Padding;
     static const uint32_t COMPUTE_LENGTH_B = 96 * 1024 / sizeof(ElementB);
     using PaddingBuilderB = Catlass::Gemm::Kernel::PaddingBuilder<
         paddingTagB, ArchTag, ElementB, LayoutB, COMPUTE_LENGTH_B>;
-    using GlobalPaddingB = typename PaddingBuilderB::Padding;
+
+    // A and B are padded in the workspace when their strides are not aligned
+    using GlobalPaddingA = std::conditional_t<PADDING_A, typename PaddingBuilderA::Padding, void>;
+    using GlobalPaddingB = std::conditional_t<PADDING_B, typename PaddingBuilderB::Padding, void>;
+    using LayoutMmadA = std::conditional_t<PADDING_A, typename PaddingBuilderA::LayoutAfterPadding, LayoutA>;
+    using LayoutMmadB = std::conditional_t<PADDING_B, typename PaddingBuilderB::LayoutAfterPadding, LayoutB>;
+    using ATypeMmad = Gemm::GemmType<ElementA, LayoutMmadA>;
+    using BTypeMmad = Gemm::GemmType<ElementB, LayoutMmadB>;
+
+    using L1TileShape = typename Config::L1TileShape;
+    using L0TileShape = typename Config::L0TileShape;
+
+    using BlockScheduler = Catlass::Gemm::Block::GemmIdentityBlockSwizzle<3, Config::SWIZZLE_DIRECTION>;
+    using BlockEpilogue = void;
+    using TileCopy = TileCopyOpt<ArchTag, ATypeMmad, BTypeMmad, CType>;
+    using BlockMmadOpt = Gemm::Block::BlockMmad<DispatchPolicy, L1TileShape, L0TileShape, ATypeMmad, BTypeMmad,
+                                                CType, void, TileCopy>;
+    using MatmulKernel =
+        Gemm::Kernel::OptimizedMatmul<GlobalPaddingA, GlobalPaddingB, BlockMmadOpt, BlockEpilogue, BlockScheduler>;
+    using Adapter = Gemm::Device::DeviceGemm<MatmulKernel>;
+
+    static typename MatmulKernel::Arguments GetArguments(const KernelInfo &kernelInfo) {
+        GemmCoord problemShape{kernelInfo.m, kernelInfo.n, kernelInfo.k};
+        uint8_t *deviceA = kernelInfo.inputAddr.at(0);
+        uint8_t *deviceB = kernelInfo.inputAddr.at(1);
+        uint8_t *deviceC = kernelInfo.outputAddr.at(0);
+        return {problemShape, deviceA, deviceB, deviceC};
+    }
+};
+
+template <class LayoutA, class LayoutB, class LayoutC, class InDType, class OutDType, class Config>
+LaunchPlan OptimizedMatmulPlan(const uint32_t blockNum, const KernelInfo &kernelInfo) {
+    constexpr uint32_t alignByByte = 512;
+    constexpr uint32_t alignByElement = alignByByte / sizeof(InDType);
     // Prepare FFTS address
     uint32_t fftsLen{0};
     uint64_t fftsAddr{0};
     rtCheck(rtGetC2cCtrlAddr(&fftsAddr, &fftsLen));
-    GemmCoord problemShape{kernelInfo.m, kernelInfo.n, kernelInfo.k};
     LayoutA layoutA{kernelInfo.m, kernelInfo.k};
     LayoutB layoutB{kernelInfo.k, kernelInfo.n};
-    LayoutC layoutC{kernelInfo.m, kernelInfo.n};
-    uint8_t *deviceA = kernelInfo.inputAddr.at(0);
-    uint8_t *deviceB = kernelInfo.inputAddr.at(1);
-    uint8_t *deviceC = kernelInfo.outputAddr.at(0);
-
-    // if LayoutA and LayoutB is both ColumnMajor,
-    // L1TileShape using GemmShape<256, 128, 256> can achieve better performance.
-    using L1TileShape =
-        std::conditional_t<std::is_same_v<LayoutA, layout::ColumnMajor> && std::is_same_v<LayoutB, layout::ColumnMajor>,
-                           GemmShape<256, 128, 256>, GemmShape<128, 256, 256>>;
-    using L0TileShape =
-        std::conditional_t<std::is_same_v<LayoutA, layout::ColumnMajor> && std::is_same_v<LayoutB, layout::ColumnMajor>,
-                           GemmShape<256, 128, 64>, GemmShape<128, 256, 64>>;
-
-    using BlockScheduler = std::conditional_t<M_GT_N, Catlass::Gemm::Block::GemmIdentityBlockSwizzle<3, 0>,
-                                              Catlass::Gemm::Block::GemmIdentityBlockSwizzle<3, 1>>;
-    using BlockEpilogue = void;
     bool isNeedPaddingA = IsNeedPadding(layoutA, alignByElement);
     bool isNeedPaddingB = IsNeedPadding(layoutB, alignByElement);
 
     if (isNeedPaddingA && isNeedPaddingB) {
-        using LayoutMmadA = typename PaddingBuilderA::LayoutAfterPadding;
-        using LayoutMmadB = typename PaddingBuilderB::LayoutAfterPadding;
-        using ATypeMmad = Gemm::GemmType<ElementA, LayoutMmadA>;
-        using BTypeMmad = Gemm::GemmType<ElementB, LayoutMmadB>;
-        using TileCopy = TileCopyOpt<ArchTag, ATypeMmad, BTypeMmad, CType>;
-        using BlockMmadOpt = Gemm::Block::BlockMmad<DispatchPolicy, L1TileShape, L0TileShape, ATypeMmad, BTypeMmad,
-                                                    CType, void, TileCopy>;
-        using MatmulKernel =
-            Gemm::Kernel::OptimizedMatmul<GlobalPaddingA, GlobalPaddingB, BlockMmadOpt, BlockEpilogue, BlockScheduler>;
-        typename MatmulKernel::Arguments arguments{problemShape, deviceA, deviceB, deviceC};
-        using MatmulAdapter = Gemm::Device::DeviceGemm<MatmulKernel>;
-        MatmulAdapter matmulOp;
-        RunAdapter(matmulOp, arguments, stream, blockNum, fftsAddr);
+        return MakeLaunchPlan<OptimizedMatmulInstance<LayoutA, LayoutB, LayoutC, InDType, OutDType, Config, true,
+            true>>(kernelInfo, blockNum, fftsAddr);
     } else if (isNeedPaddingA) {
-        using LayoutMmadA = typename PaddingBuilderA::LayoutAfterPadding;
-        using ATypeMmad = Gemm::GemmType<ElementA, LayoutMmadA>;
-        using TileCopy = TileCopyOpt<ArchTag, ATypeMmad, BType, CType>;
-        using BlockMmadOpt =
-            Gemm::Block::BlockMmad<DispatchPolicy, L1TileShape, L0TileShape, ATypeMmad, BType, CType, void, TileCopy>;
-        using MatmulKernel =
-            Gemm::Kernel::OptimizedMatmul<GlobalPaddingA, void, BlockMmadOpt, BlockEpilogue, BlockScheduler>;
-        typename MatmulKernel::Arguments arguments{problemShape, deviceA, deviceB, deviceC};
-        using MatmulAdapter = Gemm::Device::DeviceGemm<MatmulKernel>;
-        MatmulAdapter matmulOp;
-        RunAdapter(matmulOp, arguments, stream, blockNum, fftsAddr);
+        return MakeLaunchPlan<OptimizedMatmulInstance<LayoutA, LayoutB, LayoutC, InDType, OutDType, Config, true,
+            false>>(kernelInfo, blockNum, fftsAddr);
     } else if (isNeedPaddingB) {
-        using LayoutMmadB = typename PaddingBuilderB::LayoutAfterPadding;
-        using BTypeMmad = Gemm::GemmType<ElementB, LayoutMmadB>;
-        using TileCopy = TileCopyOpt<ArchTag, AType, BTypeMmad, CType>;
-        using BlockMmadOpt =
-            Gemm::Block::BlockMmad<DispatchPolicy, L1TileShape, L0TileShape, AType, BTypeMmad, CType, void, TileCopy>;
-        using MatmulKernel =
-            Gemm::Kernel::OptimizedMatmul<void, GlobalPaddingB, BlockMmadOpt, BlockEpilogue, BlockScheduler>;
-        typename MatmulKernel::Arguments arguments{problemShape, deviceA, deviceB, deviceC};
-        using MatmulAdapter = Gemm::Device::DeviceGemm<MatmulKernel>;
-        MatmulAdapter matmulOp;
-        RunAdapter(matmulOp, arguments, stream, blockNum, fftsAddr);
+        return MakeLaunchPlan<OptimizedMatmulInstance<LayoutA, LayoutB, LayoutC, InDType, OutDType, Config, false,
+            true>>(kernelInfo, blockNum, fftsAddr);
     } else {
-        using TileCopy = TileCopyOpt<ArchTag, AType, BType, CType>;
-        using BlockMmadOpt =
-            Gemm::Block::BlockMmad<DispatchPolicy, L1TileShape, L0TileShape, AType, BType, CType, void, TileCopy>;
-        using MatmulKernel = Gemm::Kernel::OptimizedMatmul<void, void, BlockMmadOpt, BlockEpilogue, BlockScheduler>;
-        typename MatmulKernel::Arguments arguments{problemShape, deviceA, deviceB, deviceC};
-        using MatmulAdapter = Gemm::Device::DeviceGemm<MatmulKernel>;
-        MatmulAdapter matmulOp;
-        RunAdapter(matmulOp, arguments, stream, blockNum, fftsAddr);
+        return MakeLaunchPlan<OptimizedMatmulInstance<LayoutA, LayoutB, LayoutC, InDType, OutDType, Config, false,
+            false>>(kernelInfo, blockNum, fftsAddr);
     }
 }
+
 void OptimizedMatmul(const uint32_t blockNum, aclrtStream stream, const KernelInfo &kernelInfo) {
     if (!kernelInfo.transA && !kernelInfo.transB && kernelInfo.inputDataType == ACL_FLOAT16
         && kernelInfo.outputDataType == ACL_FLOAT16) {
-        if (kernelInfo.m > kernelInfo.n) {
-            OptimizedMatmulImpl<layout::RowMajor, layout::RowMajor, layout::RowMajor, half, half, true>(blockNum,
-                                                                                                        stream,
-                                                                                                        kernelInfo);
-        } else {
-            OptimizedMatmulImpl<layout::RowMajor, layout::RowMajor, layout::RowMajor, half, half, false>(blockNum,
-                                                                                                         stream,
-                                                                                                         kernelInfo);
-        }
+        static LaunchPlanCache<LaunchPlan> plans;
+        LaunchPlan plan = plans.Get(GetLaunchPlanKey(kernelInfo, blockNum), [&] {
+            // Without a tuned tiling, swizzle along the longer one of m and n.
+            size_t defaultIdx = kernelInfo.m > kernelInfo.n ? 0 : 1;
+            size_t configIdx = SelectTileConfig<OptimizedMatmulTileConfigs>(
+                LookupTuning("optimized_matmul", kernelInfo), defaultIdx);
+            LaunchPlan built;
+            DispatchTileConfig<OptimizedMatmulTileConfigs>(configIdx, [&](auto tileConfig) {
+                using Config = decltype(tileConfig);
+                built = OptimizedMatmulPlan<layout::RowMajor, layout::RowMajor, layout::RowMajor, half, half, Config>(
+                    blockNum, kernelInfo);
+            });
+            return built;
+        });
+        plan.launch(plan, stream, kernelInfo);
     }
     // If more conditions are needed, add branches manually.
 }
@@ -25,6 +25,7 @@ struct AtlasA2 {
     static constexpr uint32_t L0C_SIZE = 128 * 1024;
 };
 
+#if defined(__CCE__)
 template <AscendC::TPosition POS>
 using PositionType = std::integral_constant<AscendC::TPosition, POS>;
 
@@ -34,6 +35,7 @@ using PositionL0A = PositionType<AscendC::TPosition::A2>;
 using PositionL0B = PositionType<AscendC::TPosition::B2>;
 using PositionL0C = PositionType<AscendC::TPosition::CO1>;
 using PositionUB = PositionType<AscendC::TPosition::VECCALC>;
+#endif
 
 } // namespace Catlass::Arch
 
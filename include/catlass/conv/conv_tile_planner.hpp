@@ -0,0 +1,459 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_CONV_CONV_TILE_PLANNER_HPP
+#define CATLASS_CONV_CONV_TILE_PLANNER_HPP
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/arch.hpp"
+#include "catlass/conv/dispatch_policy.hpp"
+#include "catlass/conv_coord.hpp"
+
+namespace Catlass::Conv {
+
+// Host side choice of the L1/L0 tile shapes of BasicConv2d and ConvBias per layer.
+//
+// The tile shapes are template arguments, so a kernel is instantiated for every shape of a menu (Conv2dTileMenu,
+// Conv3dTileMenu) and the planner picks one of them per problem: the shapes that do not fit L1, L0A, L0B, L0C (and
+// the bias table for conv3d) with the buffers BlockConv2d and BlockConv allocate are dropped, the others are ranked
+// by a rough cycle estimate. Neither kernel uses UB, the output goes from L0C to GM directly.
+
+// Rough figures of the cube cores of Atlas A2, in cycles and bytes per cycle
+struct ConvCostModel {
+    uint32_t coreNum{20};
+    // multiply-adds of a cube core per cycle on 16 bit inputs
+    double macPerCycle{4096};
+    // issue cost of one mmad, what makes many small L0 tiles slower than a few large ones
+    double mmadFixedCycles{32};
+    // setup of a block: scheduler, pads, first loads not hidden behind the mmads
+    double blockFixedCycles{600};
+    // bandwidth of GM shared by all cores, and the part one core can draw
+    double gmBytesPerCycle{800};
+    double coreGmBytesPerCycle{64};
+};
+
+// Bytes of each buffer a tile shape takes on a problem
+struct ConvTileFootprint {
+    uint32_t l1Bytes{0};
+    uint32_t l0aBytes{0};
+    uint32_t l0bBytes{0};
+    uint32_t l0cBytes{0};
+    uint32_t btBytes{0};
+};
+
+struct ConvTileEstimate {
+    bool fits{false};
+    ConvTileFootprint footprint;
+    uint32_t blocks{0};
+    double cycles{0};
+    // multiply-adds of the problem over those the cores could do in the estimated cycles
+    double cubeUtilisation{0};
+    double l1Utilisation{0};
+};
+
+struct ConvTilePlan {
+    // position in the menu, -1 if no shape of the menu fits the problem
+    int32_t index{-1};
+    ConvTileEstimate estimate;
+};
+
+namespace detail {
+
+inline double ConvMoveCycles(double bytes, uint32_t activeCores, ConvCostModel const &model)
+{
+    double perCore = std::min(model.coreGmBytesPerCycle, model.gmBytesPerCycle / std::max(1u, activeCores));
+    return bytes / perCore;
+}
+
+inline bool ConvFootprintFits(ConvTileFootprint const &footprint, uint32_t l0aLimit, uint32_t l0bLimit)
+{
+    using ArchTag = Arch::AtlasA2;
+    return (footprint.l1Bytes <= ArchTag::L1_SIZE) && (footprint.l0aBytes <= l0aLimit) &&
+        (footprint.l0bBytes <= l0bLimit) && (footprint.l0cBytes <= ArchTag::L0C_SIZE) &&
+        (footprint.btBytes <= ArchTag::BIAS_SIZE);
+}
+
+} // namespace detail
+
+/////////////////// Conv2d ///////////////////
+
+// Runtime copy of the template arguments of BlockConv2d<ConvAtlasA2Pingpong, ...>
+struct Conv2dTileShape {
+    uint32_t fmapHo{1};
+    uint32_t fmapWo{1};
+    uint32_t fmapCin1{1};
+    uint32_t filterCout{16};
+    uint32_t filterCin1{1};
+    uint32_t l0M{16};
+    uint32_t l0N{16};
+    uint32_t l0K{16};
+    uint32_t l1AStages{1};
+    uint32_t l1BStages{1};
+    uint32_t l0AStages{1};
+    uint32_t l0BStages{1};
+};
+
+// One entry of a Conv2dTileMenu, the arguments of a BlockConv2d instantiation
+template <class DispatchPolicy_, class FmapL1TileShape_, class FilterL1TileShape_, class L0TileShape_>
+struct Conv2dTileConfig {
+    using DispatchPolicy = DispatchPolicy_;
+    using FmapL1TileShape = FmapL1TileShape_;
+    using FilterL1TileShape = FilterL1TileShape_;
+    using L0TileShape = L0TileShape_;
+
+    static constexpr Conv2dTileShape ToShape()
+    {
+        return Conv2dTileShape{FmapL1TileShape::Ho, FmapL1TileShape::Wo, FmapL1TileShape::Cin1,
+            FilterL1TileShape::Cout, FilterL1TileShape::Cin1, L0TileShape::M, L0TileShape::N, L0TileShape::K,
+            DispatchPolicy::L1A_STAGES, DispatchPolicy::L1B_STAGES, DispatchPolicy::L0A_STAGES,
+            DispatchPolicy::L0B_STAGES};
+    }
+};
+
+/// Buffers BlockConv2d takes for its largest block of params, elementBytes is the size of fmap and filter elements
+inline ConvTileFootprint GetConv2dTileFootprint(
+    Conv2dParams const &params, Conv2dTileShape const &tile, uint32_t elementBytes = 2)
+{
+    constexpr uint32_t MAX_STAGES = 2;
+    uint32_t kh = params.kh();
+    uint32_t kw = params.kw();
+    uint32_t c0 = BYTE_PER_C0 / elementBytes;
+
+    // L1 is carved for a whole tile whatever the problem
+    uint32_t hiBlock = (tile.fmapHo - 1) * params.strideH() + (kh - 1) * params.dilationH() + 1;
+    uint32_t wiBlock = (tile.fmapWo - 1) * params.strideW() + (kw - 1) * params.dilationW() + 1;
+    uint32_t l1ASize = tile.fmapCin1 * hiBlock * wiBlock * BYTE_PER_C0;
+    uint32_t l1BSize = tile.filterCin1 * kh * kw * tile.filterCout * BYTE_PER_C0;
+
+    // L0 holds the block as it is, the first block is the largest
+    uint32_t howoRound = RoundUp<C0_NUM_PER_FRACTAL>(std::min(tile.fmapHo, params.ho()) *
+        std::min(tile.fmapWo, params.wo()));
+    uint32_t coutRound = RoundUp<C0_NUM_PER_FRACTAL>(std::min(tile.filterCout, params.cout()));
+    uint32_t nL0 = std::min(RoundUp<C0_NUM_PER_FRACTAL>(tile.l0N), coutRound);
+    uint32_t cin1L0Tile = std::max(tile.l0K / (kh * kw * c0), 1u);
+    uint32_t cin1Part = std::min(cin1L0Tile, std::min(params.cin1(), tile.fmapCin1));
+    uint32_t kPart = cin1Part * kh * kw * c0;
+
+    ConvTileFootprint footprint;
+    footprint.l1Bytes = l1ASize * std::min(tile.l1AStages, MAX_STAGES) +
+        l1BSize * std::min(tile.l1BStages, MAX_STAGES);
+    footprint.l0aBytes = howoRound * kPart * elementBytes;
+    footprint.l0bBytes = kPart * nL0 * elementBytes;
+    footprint.l0cBytes = howoRound * coutRound * sizeof(float);
+    return footprint;
+}
+
+/// Whether BlockConv2d can run the tile shape on params
+inline bool Conv2dTileFits(Conv2dParams const &params, Conv2dTileShape const &tile, uint32_t elementBytes = 2)
+{
+    constexpr uint32_t MAX_STAGES = 2;
+    using ArchTag = Arch::AtlasA2;
+    // static requirements of BlockConv2d and of the offsets of BasicConv2d
+    if ((tile.filterCin1 % tile.fmapCin1 != 0) || (tile.filterCout % C0_NUM_PER_FRACTAL != 0) ||
+        (tile.l0K * tile.l0N * elementBytes * std::min(tile.l0BStages, MAX_STAGES) > ArchTag::L0B_SIZE)) {
+        return false;
+    }
+    ConvTileFootprint footprint = GetConv2dTileFootprint(params, tile, elementBytes);
+    return detail::ConvFootprintFits(footprint, ArchTag::L0A_SIZE / std::min(tile.l0AStages, MAX_STAGES),
+        ArchTag::L0B_SIZE / std::min(tile.l0BStages, MAX_STAGES));
+}
+
+inline ConvTileEstimate EstimateConv2dTile(Conv2dParams const &params, Conv2dTileShape const &tile,
+    ConvCostModel const &model = ConvCostModel{}, uint32_t elementBytes = 2)
+{
+    ConvTileEstimate estimate;
+    estimate.footprint = GetConv2dTileFootprint(params, tile, elementBytes);
+    estimate.fits = Conv2dTileFits(params, tile, elementBytes);
+    estimate.l1Utilisation = static_cast<double>(estimate.footprint.l1Bytes) / Arch::AtlasA2::L1_SIZE;
+
+    uint32_t kh = params.kh();
+    uint32_t kw = params.kw();
+    uint32_t c0 = BYTE_PER_C0 / elementBytes;
+    estimate.blocks = params.batch() * CeilDiv(params.ho(), tile.fmapHo) * CeilDiv(params.wo(), tile.fmapWo) *
+        CeilDiv(params.cout(), tile.filterCout);
+
+    // cost of the first, largest block, the others are taken as long
+    uint32_t hoBlock = std::min(tile.fmapHo, params.ho());
+    uint32_t woBlock = std::min(tile.fmapWo, params.wo());
+    uint32_t howoRound = RoundUp<C0_NUM_PER_FRACTAL>(hoBlock * woBlock);
+    uint32_t coutRound = RoundUp<C0_NUM_PER_FRACTAL>(std::min(tile.filterCout, params.cout()));
+    uint32_t nL0 = std::min(RoundUp<C0_NUM_PER_FRACTAL>(tile.l0N), coutRound);
+    uint32_t cin1L0Tile = std::max(tile.l0K / (kh * kw * c0), 1u);
+    double k = static_cast<double>(params.cin1()) * kh * kw * c0;
+    double mmads = static_cast<double>(CeilDiv(params.cin1(), tile.fmapCin1)) *
+        CeilDiv(std::min(params.cin1(), tile.fmapCin1), cin1L0Tile) * CeilDiv(coutRound, nL0);
+    double mmadCycles = howoRound * coutRound * k / model.macPerCycle + mmads * model.mmadFixedCycles;
+
+    uint32_t hiBlock = std::min<uint32_t>((hoBlock - 1) * params.strideH() + (kh - 1) * params.dilationH() + 1,
+        params.hi());
+    uint32_t wiBlock = std::min<uint32_t>((woBlock - 1) * params.strideW() + (kw - 1) * params.dilationW() + 1,
+        params.wi());
+    double bytes = static_cast<double>(params.cin1()) * hiBlock * wiBlock * BYTE_PER_C0 +
+        static_cast<double>(params.cin1()) * kh * kw * coutRound * BYTE_PER_C0 +
+        static_cast<double>(hoBlock) * woBlock * coutRound * elementBytes;
+    uint32_t activeCores = std::min(estimate.blocks, model.coreNum);
+    double blockCycles = std::max(mmadCycles, detail::ConvMoveCycles(bytes, activeCores, model)) +
+        model.blockFixedCycles;
+    estimate.cycles = CeilDiv(estimate.blocks, model.coreNum) * blockCycles;
+
+    double macs = static_cast<double>(params.batch()) * params.ho() * params.wo() * params.cout() * k;
+    estimate.cubeUtilisation = macs / (estimate.cycles * model.coreNum * model.macPerCycle);
+    return estimate;
+}
+
+/// Picks the fitting shape of lowest estimated cycles among count shapes
+inline ConvTilePlan PlanConv2dTile(Conv2dParams const &params, Conv2dTileShape const *shapes, uint32_t count,
+    ConvCostModel const &model = ConvCostModel{}, uint32_t elementBytes = 2)
+{
+    ConvTilePlan plan;
+    for (uint32_t i = 0; i < count; ++i) {
+        ConvTileEstimate estimate = EstimateConv2dTile(params, shapes[i], model, elementBytes);
+        if (estimate.fits && ((plan.index < 0) || (estimate.cycles < plan.estimate.cycles))) {
+            plan.index = static_cast<int32_t>(i);
+            plan.estimate = estimate;
+        }
+    }
+    return plan;
+}
+
+/////////////////// Conv3d ///////////////////
+
+// Runtime copy of the template arguments of BlockConv<ConvAtlasA2Pingpong, ...> of ConvBias
+struct Conv3dTileShape {
+    uint32_t coreN{1};
+    uint32_t coreD{1};
+    uint32_t coreC1{1};
+    uint32_t coreHw{1};
+    uint32_t mAL1{16};
+    uint32_t fmapKd{1};
+    uint32_t fmapCi1{1};
+    uint32_t filterKd{1};
+    uint32_t filterCi1{1};
+    uint32_t nBL1{16};
+    uint32_t mL0{16};
+    uint32_t kL0{16};
+    uint32_t nL0{16};
+    uint32_t l1AStages{1};
+    uint32_t l1BStages{1};
+    uint32_t l0AStages{2};
+    uint32_t l0BStages{2};
+    uint32_t l0CStages{1};
+};
+
+// One entry of a Conv3dTileMenu, the arguments of a BlockConv instantiation of ConvBias
+template <class DispatchPolicy_, class CoreTileShape_, class FmapL1TileShape_, class FilterL1TileShape_,
+    class L0TileShape_>
+struct Conv3dTileConfig {
+    using DispatchPolicy = DispatchPolicy_;
+    using CoreTileShape = CoreTileShape_;
+    using FmapL1TileShape = FmapL1TileShape_;
+    using FilterL1TileShape = FilterL1TileShape_;
+    using L0TileShape = L0TileShape_;
+
+    static constexpr Conv3dTileShape ToShape()
+    {
+        return Conv3dTileShape{CoreTileShape::noCnt, CoreTileShape::doCnt, CoreTileShape::co1Cnt,
+            CoreTileShape::howoCnt, FmapL1TileShape::mAL1, FmapL1TileShape::Kd, FmapL1TileShape::Ci1,
+            FilterL1TileShape::Kd, FilterL1TileShape::Ci1, FilterL1TileShape::nBL1, L0TileShape::mL0,
+            L0TileShape::kL0, L0TileShape::nL0, DispatchPolicy::L1A_STAGES, DispatchPolicy::L1B_STAGES,
+            DispatchPolicy::L0A_STAGES, DispatchPolicy::L0B_STAGES, DispatchPolicy::L0C_STAGES};
+    }
+};
+
+/// Buffers BlockConv of ConvBias takes for params, the rows of the fmap are loaded whole
+inline ConvTileFootprint GetConv3dTileFootprint(
+    Conv3dParams const &params, Conv3dTileShape const &tile, uint32_t elementBytes = 2)
+{
+    uint64_t hoAL1Max = tile.mAL1 / params.wo() + 2;
+    uint64_t hiAL1Max = (hoAL1Max - 1) * params.sH() + params.dilatedKernelH();
+    hiAL1Max = std::min<uint64_t>(hiAL1Max, params.hi());
+    uint64_t al1Size = static_cast<uint64_t>(tile.fmapKd) * tile.fmapCi1 * hiAL1Max * params.wicin0() * elementBytes;
+    uint64_t bl1Size = static_cast<uint64_t>(tile.filterKd) * tile.filterCi1 * params.khkwcin0() * tile.nBL1 *
+        elementBytes;
+    // the bias is staged in L1 at the width of the bias table
+    uint64_t biasL1Size = static_cast<uint64_t>(tile.nL0) * sizeof(float);
+    uint64_t l1Bytes = al1Size * tile.l1AStages + bl1Size * tile.l1BStages + biasL1Size;
+
+    ConvTileFootprint footprint;
+    footprint.l1Bytes = static_cast<uint32_t>(std::min<uint64_t>(l1Bytes, UINT32_MAX));
+    footprint.l0aBytes = tile.mL0 * tile.kL0 * elementBytes * tile.l0AStages;
+    footprint.l0bBytes = tile.kL0 * tile.nL0 * elementBytes * tile.l0BStages;
+    footprint.l0cBytes = tile.mL0 * tile.nL0 * sizeof(float) * tile.l0CStages;
+    footprint.btBytes = tile.nL0 * sizeof(float);
+    return footprint;
+}
+
+/// Whether BlockConv of ConvBias can run the tile shape on params
+inline bool Conv3dTileFits(Conv3dParams const &params, Conv3dTileShape const &tile, uint32_t elementBytes = 2)
+{
+    using ArchTag = Arch::AtlasA2;
+    // static requirements of BlockConv, and the L1 tiles of both sides are whole numbers of L0 tiles
+    uint32_t kAL1 = tile.fmapKd * tile.fmapCi1 * params.khkwcin0();
+    uint32_t kBL1 = tile.filterKd * tile.filterCi1 * params.khkwcin0();
+    if ((tile.l0AStages != 2) || (tile.l0BStages != 2) || (tile.l0CStages != 1) ||
+        (tile.mL0 % C0_NUM_PER_FRACTAL != 0) || (tile.nL0 % C0_NUM_PER_FRACTAL != 0) ||
+        (tile.kL0 % C0_NUM_PER_FRACTAL != 0) || (tile.mAL1 % tile.mL0 != 0) || (tile.nBL1 % tile.nL0 != 0) ||
+        (kAL1 % tile.kL0 != 0) || (kBL1 % tile.kL0 != 0)) {
+        return false;
+    }
+    return detail::ConvFootprintFits(GetConv3dTileFootprint(params, tile, elementBytes), ArchTag::L0A_SIZE,
+        ArchTag::L0B_SIZE);
+}
+
+inline ConvTileEstimate EstimateConv3dTile(Conv3dParams const &params, Conv3dTileShape const &tile,
+    ConvCostModel const &model = ConvCostModel{}, uint32_t elementBytes = 2)
+{
+    ConvTileEstimate estimate;
+    estimate.footprint = GetConv3dTileFootprint(params, tile, elementBytes);
+    estimate.fits = Conv3dTileFits(params, tile, elementBytes);
+    estimate.l1Utilisation = static_cast<double>(estimate.footprint.l1Bytes) / Arch::AtlasA2::L1_SIZE;
+
+    // the core split is clamped to the output as in Conv3dIdentityBlockSwizzle
+    uint32_t loopsN = std::min(params.batch(), tile.coreN);
+    uint32_t loopsD = std::min(params.dout(), tile.coreD);
+    uint32_t loopsC1 = std::min(params.cout1(), tile.coreC1);
+    uint32_t loopsHw = std::min(params.howo(), tile.coreHw);
+    estimate.blocks = loopsN * loopsD * loopsC1 * loopsHw;
+    uint32_t batches = CeilDiv(params.batch(), loopsN) * CeilDiv(params.dout(), loopsD);
+    uint32_t m = CeilDiv(params.howo(), loopsHw);
+    uint32_t n = CeilDiv(params.cout1(), loopsC1) * params.cout0();
+    double k = params.alignCinKhKwKd();
+
+    uint32_t mTiles = CeilDiv(m, tile.mAL1);
+    uint32_t nTiles = CeilDiv(n, tile.nBL1);
+    double mmads = static_cast<double>(mTiles) * CeilDiv(tile.mAL1, tile.mL0) * nTiles *
+        CeilDiv(tile.nBL1, tile.nL0) * CeilDiv(static_cast<uint32_t>(k), tile.kL0);
+    double mmadCycles = RoundUp(m, tile.mL0) * RoundUp(n, tile.nL0) * k / model.macPerCycle +
+        mmads * model.mmadFixedCycles;
+
+    // A is reloaded for every n tile unless all of K stays in L1, B for every m tile likewise
+    bool kAL1FullLoad = params.kdcin1() == tile.fmapKd * tile.fmapCi1;
+    bool kBL1FullLoad = params.kdcin1() == tile.filterKd * tile.filterCi1;
+    uint64_t hoAL1Max = tile.mAL1 / params.wo() + 2;
+    uint64_t hiAL1Max = std::min<uint64_t>((hoAL1Max - 1) * params.sH() + params.dilatedKernelH(), params.hi());
+    double aBytes = static_cast<double>(params.kdcin1()) * hiAL1Max * params.wicin0() * elementBytes;
+    double bBytes = k * tile.nBL1 * elementBytes;
+    double bytes = mTiles * (kAL1FullLoad ? 1 : nTiles) * aBytes + (kBL1FullLoad ? 1 : mTiles) * nTiles * bBytes +
+        static_cast<double>(m) * n * elementBytes;
+
+    uint32_t activeCores = std::min(estimate.blocks, model.coreNum);
+    double blockCycles = batches * std::max(mmadCycles, detail::ConvMoveCycles(bytes, activeCores, model)) +
+        model.blockFixedCycles;
+    estimate.cycles = CeilDiv(estimate.blocks, model.coreNum) * blockCycles;
+
+    double macs = static_cast<double>(params.batch()) * params.dout() * params.howo() * params.cout() * k;
+    estimate.cubeUtilisation = macs / (estimate.cycles * model.coreNum * model.macPerCycle);
+    return estimate;
+}
+
+/// Picks the fitting shape of lowest estimated cycles among count shapes
+inline ConvTilePlan PlanConv3dTile(Conv3dParams const &params, Conv3dTileShape const *shapes, uint32_t count,
+    ConvCostModel const &model = ConvCostModel{}, uint32_t elementBytes = 2)
+{
+    ConvTilePlan plan;
+    for (uint32_t i = 0; i < count; ++i) {
+        ConvTileEstimate estimate = EstimateConv3dTile(params, shapes[i], model, elementBytes);
+        if (estimate.fits && ((plan.index < 0) || (estimate.cycles < plan.estimate.cycles))) {
+            plan.index = static_cast<int32_t>(i);
+            plan.estimate = estimate;
+        }
+    }
+    return plan;
+}
+
+/////////////////// Menus ///////////////////
+
+// A list of tile configs with a kernel instantiated for each. Dispatch(index, runner) calls runner(Config{}) with
+// the index-th config, a generic lambda then builds the kernel from the types of its argument.
+template <class Shape, class... Configs>
+struct ConvTileMenu {
+    static constexpr uint32_t SIZE = sizeof...(Configs);
+
+    static std::array<Shape, SIZE> GetShapes()
+    {
+        return {Configs::ToShape()...};
+    }
+
+    template <class Runner>
+    static bool Dispatch(uint32_t index, Runner &&runner)
+    {
+        return DispatchImpl(index, runner, std::index_sequence_for<Configs...>{});
+    }
+
+private:
+    template <class Runner, size_t... I>
+    static bool DispatchImpl(uint32_t index, Runner &runner, std::index_sequence<I...>)
+    {
+        return ((index == I ? (runner(Configs{}), true) : false) || ...);
+    }
+};
+
+template <class... Configs>
+using Conv2dTileMenu = ConvTileMenu<Conv2dTileShape, Configs...>;
+
+template <class... Configs>
+using Conv3dTileMenu = ConvTileMenu<Conv3dTileShape, Configs...>;
+
+// Shapes pre-instantiated by examples/33_basic_conv2d, for fp16 and bf16
+using Conv2dTilePolicyAtlasA2 = ConvAtlasA2Pingpong<2, 2, 2, 2, 1, false>;
+using Conv2dTileMenuAtlasA2 = Conv2dTileMenu<
+    // 3x3 on mid-sized maps, the shape the example used to hardcode
+    Conv2dTileConfig<Conv2dTilePolicyAtlasA2,
+        Conv2dFmapL1Shape<8, 12, 8>, Conv2dFilterL1Shape<96, 8>, Conv2dL0Shape<16, 96, 16>>,
+    // wide maps with few channels, long rows of wo and a narrow cout
+    Conv2dTileConfig<Conv2dTilePolicyAtlasA2,
+        Conv2dFmapL1Shape<7, 16, 4>, Conv2dFilterL1Shape<64, 4>, Conv2dL0Shape<16, 64, 16>>,
+    // small maps with many channels, the whole map in a block and deeper cin tiles of the filter
+    Conv2dTileConfig<Conv2dTilePolicyAtlasA2,
+        Conv2dFmapL1Shape<7, 7, 4>, Conv2dFilterL1Shape<64, 8>, Conv2dL0Shape<16, 64, 16>>,
+    // 1x1, the filter is small enough in L1 for deep cin tiles and wide cout
+    Conv2dTileConfig<Conv2dTilePolicyAtlasA2,
+        Conv2dFmapL1Shape<8, 14, 32>, Conv2dFilterL1Shape<128, 32>, Conv2dL0Shape<16, 128, 64>>,
+    // large kernels as 7x7 stems, kh * kw * C0 fills L0 on its own
+    Conv2dTileConfig<Conv2dTilePolicyAtlasA2,
+        Conv2dFmapL1Shape<2, 8, 1>, Conv2dFilterL1Shape<64, 1>, Conv2dL0Shape<16, 16, 16>>
+>;
+
+// Shapes pre-instantiated by examples/24_conv_bias, for fp16 and bf16
+using Conv3dTilePolicyAtlasA2 = ConvAtlasA2Pingpong<1, 1, 2, 2, 1, true>;
+using Conv3dTileMenuAtlasA2 = Conv3dTileMenu<
+    // the shape the example used to hardcode
+    Conv3dTileConfig<Conv3dTilePolicyAtlasA2, ConvCoreShape<2, 2, 2, 2>,
+        ConvFmapL1Shape<16, 1, 1>, ConvFilterL1Shape<1, 1, 16>, ConvL0Shape<16, 16, 16>>,
+    // all cores on the output plane and cout, for a single batch and depth
+    Conv3dTileConfig<Conv3dTilePolicyAtlasA2, ConvCoreShape<1, 1, 4, 5>,
+        ConvFmapL1Shape<16, 1, 1>, ConvFilterL1Shape<1, 1, 16>, ConvL0Shape<16, 16, 16>>,
+    // larger m and n tiles on wide outputs
+    Conv3dTileConfig<Conv3dTilePolicyAtlasA2, ConvCoreShape<1, 1, 2, 10>,
+        ConvFmapL1Shape<64, 1, 1>, ConvFilterL1Shape<1, 1, 64>, ConvL0Shape<64, 16, 64>>,
+    // batches over cores, two cin1 per L1 tile
+    Conv3dTileConfig<Conv3dTilePolicyAtlasA2, ConvCoreShape<4, 1, 1, 5>,
+        ConvFmapL1Shape<32, 1, 2>, ConvFilterL1Shape<1, 2, 32>, ConvL0Shape<32, 32, 32>>,
+    // The shapes above take a few percent of L1 at most, those below are sized to a larger part of it: long m tiles
+    // read the halo rows of the fmap fewer times, and four cin1 or a whole kd x cin1 of K per L1 tile keep the
+    // filter loaded across m.
+    // depth and output plane over cores, 3x3x3 kernels with a few cin1
+    Conv3dTileConfig<Conv3dTilePolicyAtlasA2, ConvCoreShape<1, 4, 1, 5>,
+        ConvFmapL1Shape<256, 1, 4>, ConvFilterL1Shape<1, 4, 64>, ConvL0Shape<64, 64, 64>>,
+    // one batch per core for 1x1 on many batches, the whole K of four cin1 in L1
+    Conv3dTileConfig<Conv3dTilePolicyAtlasA2, ConvCoreShape<20, 1, 1, 1>,
+        ConvFmapL1Shape<512, 1, 4>, ConvFilterL1Shape<1, 4, 32>, ConvL0Shape<32, 32, 32>>,
+    // a kd of 3 with its cin1 in L1, an L0 K of a whole 3x3 tap
+    Conv3dTileConfig<Conv3dTilePolicyAtlasA2, ConvCoreShape<1, 4, 1, 5>,
+        ConvFmapL1Shape<256, 3, 2>, ConvFilterL1Shape<3, 2, 64>, ConvL0Shape<64, 144, 64>>
+>;
+
+} // namespace Catlass::Conv
+
+#endif // CATLASS_CONV_CONV_TILE_PLANNER_HPP
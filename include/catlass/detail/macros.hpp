@@ -15,10 +15,12 @@
 #include <kernel_operator.h>
 #endif
 
-#define CATLASS_DEVICE __forceinline__ __aicore__
 #ifdef __CCE__
+#define CATLASS_DEVICE __forceinline__ __aicore__
 #define CATLASS_HOST_DEVICE __forceinline__ [host, aicore]
 #else
+// host compilers, e.g. tools that replay block schedulers on the host
+#define CATLASS_DEVICE inline
 #define CATLASS_HOST_DEVICE
 #endif
 #define CATLASS_GLOBAL __global__ __aicore__
@@ -0,0 +1,319 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_EPILOGUE_BLOCK_BLOCK_EPILOGUE_COMBINE_O_HPP
+#define CATLASS_EPILOGUE_BLOCK_BLOCK_EPILOGUE_COMBINE_O_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/epilogue/dispatch_policy.hpp"
+#include "catlass/epilogue/tile/tile_copy.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/matrix_coord.hpp"
+
+namespace Catlass::Epilogue::Block {
+
+template <
+    class OutputType_,
+    class InputType_,
+    uint32_t ComputeEleNum_>
+class BlockEpilogue<
+    EpilogueAtlasA2CombineO<ComputeEleNum_>,
+    OutputType_,
+    InputType_>
+{
+public:
+    // Type aliases
+    using DispatchPolicy = EpilogueAtlasA2CombineO<ComputeEleNum_>;
+    using ArchTag = typename DispatchPolicy::ArchTag;
+    using ElementOutput = typename OutputType_::Element;
+    using ElementInput = typename InputType_::Element;
+    using LayoutOutput = typename OutputType_::Layout;
+    using LayoutInput = typename InputType_::Layout;
+
+    static constexpr uint32_t KV_SPLIT_MAX = DispatchPolicy::KV_SPLIT_MAX;
+    static constexpr uint32_t ROWS_PROCESS_MAX = DispatchPolicy::ROWS_PROCESS_MAX;
+    static constexpr uint32_t COMPUTE_ELE_NUM = DispatchPolicy::COMPUTE_ELE_NUM;
+    static constexpr uint32_t FLOAT_ELENUM_PER_VECCALC = 64;
+    static constexpr uint32_t FLOAT_BLOCK_SIZE = 8;
+    static constexpr uint32_t EMBED_ALIGN = 16;
+    static constexpr uint32_t STAGES = 2;
+
+    CATLASS_DEVICE
+    BlockEpilogue(Arch::Resource<ArchTag> &resource)
+    {
+        uint32_t ubOffset = 0;
+        oIn[0] = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += COMPUTE_ELE_NUM * sizeof(float);
+        oIn[1] = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += COMPUTE_ELE_NUM * sizeof(float);
+        oTemp[0] = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += COMPUTE_ELE_NUM * sizeof(float);
+        oTemp[1] = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += COMPUTE_ELE_NUM * sizeof(float);
+        oSum = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += COMPUTE_ELE_NUM * sizeof(float);
+        out = resource.ubBuf.template GetBufferByByte<ElementOutput>(ubOffset);
+        ubOffset += COMPUTE_ELE_NUM * sizeof(ElementOutput);
+        lIn = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += KV_SPLIT_MAX * ROWS_PROCESS_MAX * sizeof(float);
+        lExp = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += KV_SPLIT_MAX * ROWS_PROCESS_MAX * sizeof(float);
+        lMax = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += ROWS_PROCESS_MAX * sizeof(float);
+        lSum = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += ROWS_PROCESS_MAX * sizeof(float);
+        lBrcb[0] = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += ROWS_PROCESS_MAX * FLOAT_BLOCK_SIZE * sizeof(float);
+        lBrcb[1] = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID0);
+        AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID0);
+        AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID1);
+        AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID2);
+    }
+    CATLASS_DEVICE
+    ~BlockEpilogue()
+    {
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID1);
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID2);
+    }
+
+    CATLASS_DEVICE
+    void SetMask(int32_t len)
+    {
+        constexpr int32_t MAX_MASK_LEN = 128;
+        constexpr int32_t HALF_MASK_LEN = 64;
+        if (len >= MAX_MASK_LEN) {
+            AscendC::SetVectorMask<int8_t>((uint64_t)-1, (uint64_t)-1);
+            return;
+        }
+        int32_t highMask = len - HALF_MASK_LEN > 0 ? len - HALF_MASK_LEN : 0;
+        int32_t lowMask = len - HALF_MASK_LEN >= 0 ? HALF_MASK_LEN : len;
+        if (len < HALF_MASK_LEN) {
+            AscendC::SetVectorMask<int8_t>(0x0, ((uint64_t)1 << lowMask) - 1);
+        } else {
+            AscendC::SetVectorMask<int8_t>(((uint64_t)1 << highMask) - 1, 0xffffffffffffffff);
+        }
+    }
+
+    // Weights of the pieces of each row, exp(lse_i - lse) with lse the log-sum-exp of the lse of all pieces
+    CATLASS_DEVICE
+    void CalcSplitWeights(AscendC::GlobalTensor<ElementInput> gLse, uint32_t rowNum, uint32_t splitNum)
+    {
+        uint32_t splitRound = (splitNum + FLOAT_BLOCK_SIZE - 1) / FLOAT_BLOCK_SIZE * FLOAT_BLOCK_SIZE;
+        uint32_t rowRound = (rowNum + FLOAT_BLOCK_SIZE - 1) / FLOAT_BLOCK_SIZE * FLOAT_BLOCK_SIZE;
+
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID2);
+        AscendC::DataCopyPad(
+            lIn, gLse,
+            AscendC::DataCopyExtParams(
+                rowNum, splitNum * sizeof(ElementInput), 0, (KV_SPLIT_MAX - splitNum) / FLOAT_BLOCK_SIZE, 0),
+            AscendC::DataCopyPadExtParams<ElementInput>(false, 0, 0, 0));
+        AscendC::SetFlag<AscendC::HardEvent::MTE2_V>(EVENT_ID2);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>(EVENT_ID2);
+
+        SetMask(splitNum);
+        AscendC::WholeReduceMax<float, false>(
+            lMax, lIn, (int32_t)0, rowNum, 1, 1, 8,
+            AscendC::ReduceOrder::ORDER_ONLY_VALUE);
+        AscendC::PipeBarrier<PIPE_V>();
+
+        for (uint32_t i = 0; i < splitRound / FLOAT_BLOCK_SIZE; i++) {
+            AscendC::Brcb(
+                lExp[i * FLOAT_BLOCK_SIZE], lMax, rowRound / FLOAT_BLOCK_SIZE,
+                AscendC::BrcbRepeatParams(KV_SPLIT_MAX / FLOAT_BLOCK_SIZE, 8 * KV_SPLIT_MAX / FLOAT_BLOCK_SIZE));
+        }
+        AscendC::PipeBarrier<PIPE_V>();
+
+        SetMask(splitNum);
+        AscendC::Sub<float, false>(
+            lExp, lIn, lExp, (uint64_t)0, rowNum, AscendC::BinaryRepeatParams(1, 1, 1, 8, 8, 8));
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Exp<float, false>(lExp, lExp, (uint64_t)0, rowNum, AscendC::UnaryRepeatParams(1, 1, 8, 8));
+        AscendC::PipeBarrier<PIPE_V>();
+
+        AscendC::RepeatReduceSum<float, false>(lSum, lExp, rowNum, 0, 0, 1, 1, 8);
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Ln(lSum, lSum, rowRound);
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Add(lSum, lSum, lMax, rowRound);
+        AscendC::PipeBarrier<PIPE_V>();
+
+        for (uint32_t i = 0; i < splitRound / FLOAT_BLOCK_SIZE; i++) {
+            AscendC::Brcb(
+                lExp[i * FLOAT_BLOCK_SIZE], lSum, rowRound / FLOAT_BLOCK_SIZE,
+                AscendC::BrcbRepeatParams(KV_SPLIT_MAX / FLOAT_BLOCK_SIZE, 8 * KV_SPLIT_MAX / FLOAT_BLOCK_SIZE));
+        }
+        AscendC::PipeBarrier<PIPE_V>();
+
+        SetMask(splitNum);
+        AscendC::Sub<float, false>(
+            lExp, lIn, lExp, (uint64_t)0, rowNum, AscendC::BinaryRepeatParams(1, 1, 1, 8, 8, 8));
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID2);
+        AscendC::Exp<float, false>(lExp, lExp, (uint64_t)0, rowNum, AscendC::UnaryRepeatParams(1, 1, 8, 8));
+        AscendC::PipeBarrier<PIPE_V>();
+    }
+
+    CATLASS_DEVICE
+    void CopyPartialOToUb(
+        AscendC::LocalTensor<float> oUb, AscendC::GlobalTensor<ElementInput> gPartial,
+        uint32_t rowNum, uint32_t embedRound, uint32_t splitNum)
+    {
+        AscendC::DataCopyPad(
+            oUb, gPartial,
+            AscendC::DataCopyExtParams(
+                rowNum, embedRound * sizeof(ElementInput), (splitNum - 1) * embedRound * sizeof(ElementInput), 0, 0),
+            AscendC::DataCopyPadExtParams<ElementInput>(false, 0, 0, 0));
+    }
+
+    // oDst = o * weight of the row, only the embed columns of each row of embedRound
+    CATLASS_DEVICE
+    void MulRowWeight(
+        AscendC::LocalTensor<float> oDst, AscendC::LocalTensor<float> oSrc, AscendC::LocalTensor<float> weight,
+        uint32_t rowNum, uint32_t embed, uint32_t embedRound)
+    {
+        uint32_t loops = (embed + FLOAT_ELENUM_PER_VECCALC - 1) / FLOAT_ELENUM_PER_VECCALC;
+        for (uint32_t j = 0; j < loops; j++) {
+            uint32_t colNum = (j == loops - 1) ? (embed - j * FLOAT_ELENUM_PER_VECCALC) : FLOAT_ELENUM_PER_VECCALC;
+            SetMask(colNum);
+            AscendC::Mul<float, false>(
+                oDst[j * FLOAT_ELENUM_PER_VECCALC], weight, oSrc[j * FLOAT_ELENUM_PER_VECCALC], (uint64_t)0,
+                rowNum,
+                AscendC::BinaryRepeatParams(1, 0, 1, embedRound / FLOAT_BLOCK_SIZE, 1, embedRound / FLOAT_BLOCK_SIZE));
+        }
+        SetMask(FLOAT_ELENUM_PER_VECCALC);
+    }
+
+    CATLASS_DEVICE
+    void CombineRows(
+        AscendC::GlobalTensor<ElementInput> gPartial, AscendC::GlobalTensor<ElementInput> gLse,
+        uint32_t rowNum, uint32_t embed, uint32_t embedRound, uint32_t splitNum)
+    {
+        CalcSplitWeights(gLse, rowNum, splitNum);
+
+        // preload
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID0);
+        CopyPartialOToUb(oIn[0], gPartial, rowNum, embedRound, splitNum);
+        AscendC::SetFlag<AscendC::HardEvent::MTE2_V>(EVENT_ID0);
+
+        AscendC::SetFlag<AscendC::HardEvent::V_S>(EVENT_ID2);
+        AscendC::WaitFlag<AscendC::HardEvent::V_S>(EVENT_ID2);
+
+        SetMask(FLOAT_ELENUM_PER_VECCALC);
+        uint32_t bufferId = 0;
+        for (uint32_t i = 0; i < splitNum; i++) {
+            // load the next piece
+            if (i < splitNum - 1) {
+                uint32_t nextBufferId = 1 - bufferId;
+                AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(oInEventList[nextBufferId]);
+                CopyPartialOToUb(oIn[nextBufferId], gPartial[(i + 1) * embedRound], rowNum, embedRound, splitNum);
+                AscendC::SetFlag<AscendC::HardEvent::MTE2_V>(oInEventList[nextBufferId]);
+            }
+
+            AscendC::PipeBarrier<PIPE_V>();
+            for (uint32_t j = 0; j < rowNum; j++) {
+                float a = lExp[j * KV_SPLIT_MAX + i].GetValue(0);
+                AscendC::SetFlag<AscendC::HardEvent::S_V>(oTempEventList[bufferId]);
+                AscendC::WaitFlag<AscendC::HardEvent::S_V>(oTempEventList[bufferId]);
+                AscendC::Duplicate<float, false>(
+                    lBrcb[bufferId][j * FLOAT_BLOCK_SIZE], a, uint64_t(0), 1, 0, 0);
+            }
+            AscendC::PipeBarrier<PIPE_V>();
+
+            // weight the current piece
+            AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>(oInEventList[bufferId]);
+            MulRowWeight((i > 0) ? oTemp[bufferId] : oSum, oIn[bufferId], lBrcb[bufferId], rowNum, embed, embedRound);
+            AscendC::PipeBarrier<PIPE_V>();
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(oInEventList[bufferId]);
+
+            if (i > 0) {
+                AscendC::Add(oSum, oSum, oTemp[bufferId], rowNum * embedRound);
+            }
+            AscendC::PipeBarrier<PIPE_V>();
+            bufferId = 1 - bufferId;
+        }
+    }
+
+    // Row h * qSBlockSize + s of the task goes to s * oHiddenSize + h * embed of gOutput
+    CATLASS_DEVICE
+    void CopyOToGm(
+        AscendC::GlobalTensor<ElementOutput> gOutput, uint32_t rowStart, uint32_t rowNum,
+        uint32_t qSBlockSize, uint32_t embed, uint32_t embedRound, uint32_t oHiddenSize)
+    {
+        if (qSBlockSize == 1) {
+            AscendC::DataCopyPad(
+                gOutput[rowStart * embed], out,
+                AscendC::DataCopyExtParams(rowNum, embed * sizeof(ElementOutput), 0, 0, 0));
+            return;
+        }
+        for (uint32_t rowIdx = 0; rowIdx < rowNum;) {
+            uint32_t qNIdx = (rowStart + rowIdx) / qSBlockSize;
+            uint32_t qSIdx = (rowStart + rowIdx) % qSBlockSize;
+            uint32_t copyRowNum = (qSBlockSize - qSIdx < rowNum - rowIdx) ? (qSBlockSize - qSIdx) : (rowNum - rowIdx);
+            AscendC::DataCopyPad(
+                gOutput[qSIdx * oHiddenSize + qNIdx * embed], out[rowIdx * embedRound],
+                AscendC::DataCopyExtParams(
+                    copyRowNum, embed * sizeof(ElementOutput), 0, (oHiddenSize - embed) * sizeof(ElementOutput), 0));
+            rowIdx += copyRowNum;
+        }
+    }
+
+    // Merges the partial outputs of a task split along kv into splitNum pieces. Row r of piece i is row
+    // r * splitNum + i of gPartial, rows of the embedding rounded, and element r * splitNum + i of gLse.
+    CATLASS_DEVICE
+    void operator()(
+        AscendC::GlobalTensor<ElementOutput> gOutput,
+        AscendC::GlobalTensor<ElementInput> gPartial,
+        AscendC::GlobalTensor<ElementInput> gLse,
+        uint32_t qSBlockSize, uint32_t qNBlockSize, uint32_t embed, uint32_t oHiddenSize, uint32_t splitNum)
+    {
+        uint32_t rowNum = qSBlockSize * qNBlockSize;
+        uint32_t embedRound = (embed + EMBED_ALIGN - 1) / EMBED_ALIGN * EMBED_ALIGN;
+        uint32_t rowsProcess = (COMPUTE_ELE_NUM / embedRound) > ROWS_PROCESS_MAX ? ROWS_PROCESS_MAX
+                                                                                 : (COMPUTE_ELE_NUM / embedRound);
+        for (uint32_t rowStart = 0; rowStart < rowNum; rowStart += rowsProcess) {
+            uint32_t actualRows = (rowNum - rowStart < rowsProcess) ? (rowNum - rowStart) : rowsProcess;
+            CombineRows(
+                gPartial[rowStart * splitNum * embedRound], gLse[rowStart * splitNum], actualRows, embed, embedRound,
+                splitNum);
+
+            AscendC::WaitFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID0);
+            if (std::is_same<ElementOutput, bfloat16_t>::value) {
+                AscendC::Cast(out, oSum, AscendC::RoundMode::CAST_RINT, actualRows * embedRound);
+            } else {
+                AscendC::Cast(out, oSum, AscendC::RoundMode::CAST_NONE, actualRows * embedRound);
+            }
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE3>(EVENT_ID0);
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE3>(EVENT_ID0);
+            CopyOToGm(gOutput, rowStart, actualRows, qSBlockSize, embed, embedRound, oHiddenSize);
+            AscendC::SetFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID0);
+        }
+    }
+
+private:
+    AscendC::LocalTensor<ElementOutput> out;
+    AscendC::LocalTensor<float> oIn[STAGES];
+    AscendC::LocalTensor<float> oTemp[STAGES];
+    AscendC::LocalTensor<float> lBrcb[STAGES];
+    AscendC::LocalTensor<float> oSum;
+    AscendC::LocalTensor<float> lIn;
+    AscendC::LocalTensor<float> lExp;
+    AscendC::LocalTensor<float> lMax;
+    AscendC::LocalTensor<float> lSum;
+
+    int32_t oTempEventList[STAGES] = {0, 1};
+    int32_t oInEventList[STAGES] = {0, 1};
+};
+} // namespace Catlass::Epilogue::Block
+#endif // CATLASS_EPILOGUE_BLOCK_BLOCK_EPILOGUE_COMBINE_O_HPP
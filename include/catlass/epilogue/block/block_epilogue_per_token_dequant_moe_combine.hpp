@@ -0,0 +1,345 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_EPILOGUE_BLOCK_EPILOGUE_PER_TOKEN_DEQUANT_MOE_COMBINE_HPP
+#define CATLASS_EPILOGUE_BLOCK_EPILOGUE_PER_TOKEN_DEQUANT_MOE_COMBINE_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/epilogue/dispatch_policy.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/gemm/gemm_type.hpp"
+#include "catlass/matrix_coord.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/detail/callback.hpp"
+
+namespace Catlass::Epilogue::Block {
+
+/// Per token dequant of the rows of an expert, which are sorted by expert, followed by the MoE combine.
+/// Row i of the block belongs to token tokenIndex[i]: it is scaled by perTokenScale[tokenIndex[i]] * routingWeight[i]
+/// and atomically added to row tokenIndex[i] of D. D is the fp32 combine buffer of the kernel, the top k rows of a
+/// token are summed in fp32 and rounded once when the kernel casts D to its output; it must be zero-filled before the
+/// first row is added.
+template <
+    uint32_t UB_STAGES_,
+    class CType_,
+    class ScaleType_,
+    class PerTokenScaleType_,
+    class DType_,
+    class TileRowBroadcastMul_,
+    class TileBroadcastOneBlk_,
+    class TileOneBlkColumnBroadcastMul_,
+    class TileCopy_,
+    class EpilogueTileSwizzle_
+>
+class BlockEpilogue <
+    EpilogueAtlasA2PerTokenDequantMoeCombine<UB_STAGES_>,
+    CType_,
+    ScaleType_,
+    PerTokenScaleType_,
+    DType_,
+    TileRowBroadcastMul_,
+    TileBroadcastOneBlk_,
+    TileOneBlkColumnBroadcastMul_,
+    TileCopy_,
+    EpilogueTileSwizzle_
+> {
+public:
+    using DispatchPolicy = EpilogueAtlasA2PerTokenDequantMoeCombine<UB_STAGES_>;
+    using ArchTag = typename DispatchPolicy::ArchTag;
+    static constexpr uint32_t UB_STAGES = UB_STAGES_;
+
+    // Data infos
+    using ElementC = typename CType_::Element;
+    using LayoutC = typename CType_::Layout;
+    using ElementScale = typename ScaleType_::Element;
+    using LayoutScale = typename ScaleType_::Layout;
+    using ElementPerTokenScale = typename PerTokenScaleType_::Element;
+    using LayoutPerTokenScale = typename PerTokenScaleType_::Layout;
+    using ElementD = typename DType_::Element;
+    using LayoutD = typename DType_::Layout;
+    using ElementTokenIndex = int32_t;
+    using ElementRoutingWeight = float;
+
+    // Check data infos
+    static_assert(
+        std::is_same_v<ElementC, int32_t> && std::is_same_v<ElementD, float> &&
+            std::is_same_v<ElementScale, float> && std::is_same_v<ElementPerTokenScale, float>,
+        "The element type template parameters of BlockEpilogue are wrong"
+    );
+    static_assert(
+        std::is_same_v<LayoutC, layout::RowMajor> && std::is_same_v<LayoutScale, layout::VectorLayout> &&
+            std::is_same_v<LayoutPerTokenScale, layout::VectorLayout> && std::is_same_v<LayoutD, layout::RowMajor>,
+        "The layout template parameters of BlockEpilogue are wrong"
+    );
+
+    // Tile compute ops
+    using TileRowBroadcastMul = TileRowBroadcastMul_;
+    using TileBroadcastOneBlk = TileBroadcastOneBlk_;
+    using TileOneBlkColumnBroadcastMul = TileOneBlkColumnBroadcastMul_;
+
+    // Tile copy
+    using CopyGmToUbC = typename TileCopy_::CopyGmToUbC;
+    using CopyGmToUbScale = typename TileCopy_::CopyGmToUbX;
+    using CopyUbToGmD = typename TileCopy_::CopyUbToGmD;
+
+    using EpilogueTileSwizzle = EpilogueTileSwizzle_;
+
+    using TileShape = typename TileRowBroadcastMul::TileShape;
+
+    static_assert(
+        TileShape::ROW == TileBroadcastOneBlk::COMPUTE_LENGTH &&
+        std::is_same_v<TileShape, typename TileOneBlkColumnBroadcastMul::TileShape>,
+        "TileShape must be consistent for all tile compute ops"
+    );
+
+    static_assert(
+        (UB_STAGES * (TileShape::COUNT * sizeof(ElementC) + TileShape::COLUMN * sizeof(ElementScale)
+                + TileShape::ROW * sizeof(float) + TileShape::COUNT * sizeof(ElementD))
+            + TileShape::COUNT * sizeof(float)
+            + TileShape::ROW * BYTE_PER_BLK)
+        <= ArchTag::UB_SIZE,
+        "TileShape is too large to fit in UB"
+    );
+
+    struct Params {
+        __gm__ ElementScale *ptrScale{nullptr};
+        LayoutScale layoutScale{};
+        __gm__ ElementPerTokenScale *ptrPerTokenScale{nullptr};
+        LayoutPerTokenScale layoutPerTokenScale{};
+        __gm__ ElementTokenIndex *ptrTokenIndex{nullptr};
+        __gm__ ElementRoutingWeight *ptrRoutingWeight{nullptr};
+        __gm__ ElementD *ptrD{nullptr};
+        LayoutD layoutD{};
+
+        CATLASS_DEVICE
+        Params() {};
+
+        /// ptrPerTokenScale and ptrD are indexed by token, ptrTokenIndex and ptrRoutingWeight by the rows of C
+        CATLASS_DEVICE
+        Params(
+            __gm__ ElementScale *ptrScale_, LayoutScale const &layoutScale_,
+            __gm__ ElementPerTokenScale *ptrPerTokenScale_, LayoutPerTokenScale const &layoutPerTokenScale_,
+            __gm__ ElementTokenIndex *ptrTokenIndex_, __gm__ ElementRoutingWeight *ptrRoutingWeight_,
+            __gm__ ElementD *ptrD_, LayoutD const &layoutD_
+        ) : ptrScale(ptrScale_), layoutScale(layoutScale_),
+            ptrPerTokenScale(ptrPerTokenScale_), layoutPerTokenScale(layoutPerTokenScale_),
+            ptrTokenIndex(ptrTokenIndex_), ptrRoutingWeight(ptrRoutingWeight_),
+            ptrD(ptrD_), layoutD(layoutD_) {}
+    };
+
+    CATLASS_DEVICE
+    BlockEpilogue(Arch::Resource<ArchTag> const &resource, Params const &params = Params{}) : params(params)
+    {
+        size_t ubOffset = 0;
+        int32_t eventVMTE2 = 0;
+        int32_t eventMTE2V = 0;
+        int32_t eventMTE3V = 0;
+        int32_t eventVMTE3 = 0;
+        int32_t eventVS = 0;
+        int32_t eventSV = 0;
+        for (uint32_t i = 0; i < UB_STAGES; ++i) {
+            ubCList[i] = resource.ubBuf.template GetBufferByByte<ElementC>(ubOffset);
+            ubOffset += TileShape::COUNT * sizeof(ElementC);
+            ubScaleList[i] = resource.ubBuf.template GetBufferByByte<ElementScale>(ubOffset);
+            ubOffset += TileShape::COLUMN * sizeof(ElementScale);
+            ubRowScaleList[i] = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+            ubOffset += TileShape::ROW * sizeof(float);
+            ubDList[i] = resource.ubBuf.template GetBufferByByte<ElementD>(ubOffset);
+            ubOffset += TileShape::COUNT * sizeof(ElementD);
+
+            eventUbCVMTE2List[i] = eventVMTE2++;
+            eventUbCMTE2VList[i] = eventMTE2V++;
+            eventUbScaleVMTE2List[i] = eventVMTE2++;
+            eventUbScaleMTE2VList[i] = eventMTE2V++;
+            eventUbRowScaleVSList[i] = eventVS++;
+            eventUbRowScaleSVList[i] = eventSV++;
+            eventUbDMTE3VList[i] = eventMTE3V++;
+            eventUbDVMTE3List[i] = eventVMTE3++;
+
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(eventUbCVMTE2List[i]);
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(eventUbScaleVMTE2List[i]);
+            AscendC::SetFlag<AscendC::HardEvent::V_S>(eventUbRowScaleVSList[i]);
+            AscendC::SetFlag<AscendC::HardEvent::MTE3_V>(eventUbDMTE3VList[i]);
+        }
+        ubCFp32 = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += TileShape::COUNT * sizeof(float);
+        ubRowScaleBrcb = resource.ubBuf.template GetBufferByByte<float>(ubOffset);
+        ubOffset += TileShape::ROW * BYTE_PER_BLK;
+    }
+
+    CATLASS_DEVICE
+    ~BlockEpilogue()
+    {
+        for (uint32_t i = 0; i < UB_STAGES; ++i) {
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(eventUbCVMTE2List[i]);
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(eventUbScaleVMTE2List[i]);
+            AscendC::WaitFlag<AscendC::HardEvent::V_S>(eventUbRowScaleVSList[i]);
+            AscendC::WaitFlag<AscendC::HardEvent::MTE3_V>(eventUbDMTE3VList[i]);
+        }
+    }
+
+    CATLASS_DEVICE
+    void UpdateParams(Params const &params_)
+    {
+        params = params_;
+    }
+
+    CATLASS_DEVICE
+    void operator() (
+        GemmCoord const &blockShapeMNK,
+        GemmCoord const &blockCoordMNK,
+        GemmCoord const &actualBlockShapeMNK,
+        AscendC::GlobalTensor<ElementC> const &gmBlockC,
+        LayoutC const &layoutBlockC, Callback &&callback = Callback{}
+    )
+    {
+        if (actualBlockShapeMNK.k() == 0) {
+            return;
+        }
+        callback();
+        // Calculate the offset of the current block
+        MatrixCoord blockShape = blockShapeMNK.GetCoordMN();
+        MatrixCoord blockCoord = blockCoordMNK.GetCoordMN();
+        MatrixCoord actualBlockShape = actualBlockShapeMNK.GetCoordMN();
+        MatrixCoord blockOffset = blockCoord * blockShape;
+
+        AscendC::GlobalTensor<ElementScale> gmScale;
+        gmScale.SetGlobalBuffer(params.ptrScale);
+        AscendC::GlobalTensor<ElementPerTokenScale> gmPerTokenScale;
+        gmPerTokenScale.SetGlobalBuffer(params.ptrPerTokenScale);
+        AscendC::GlobalTensor<ElementTokenIndex> gmTokenIndex;
+        gmTokenIndex.SetGlobalBuffer(params.ptrTokenIndex);
+        AscendC::GlobalTensor<ElementRoutingWeight> gmRoutingWeight;
+        gmRoutingWeight.SetGlobalBuffer(params.ptrRoutingWeight);
+        AscendC::GlobalTensor<ElementD> gmD;
+        gmD.SetGlobalBuffer(params.ptrD);
+
+        auto ubTileStride = MakeCoord(static_cast<int64_t>(TileShape::COLUMN), 1L);
+        auto tileShape = TileShape::ToCoord();
+        EpilogueTileSwizzle epilogueTileSwizzle(actualBlockShape, tileShape);
+        uint32_t tileLoops = epilogueTileSwizzle.GetLoops();
+        uint32_t subblockIdx = AscendC::GetSubBlockIdx();
+        uint32_t subblockNum = AscendC::GetSubBlockNum();
+        ElementTokenIndex tokenIndexList[TileShape::ROW];
+        for (uint32_t loopIdx = subblockIdx; loopIdx < tileLoops; loopIdx += subblockNum) {
+            auto tileCoord = epilogueTileSwizzle.GetTileCoord(loopIdx);
+            auto actualTileShape = epilogueTileSwizzle.GetActualTileShape(tileCoord);
+            auto tileOffsetInBlock = tileCoord * tileShape;
+            auto tileOffset = blockOffset + tileOffsetInBlock;
+
+            auto gmTileC = gmBlockC[layoutBlockC.GetOffset(tileOffsetInBlock)];
+            auto layoutGmTileC = layoutBlockC.GetTileLayout(actualTileShape);
+
+            auto &ubC = ubCList[ubListId];
+            LayoutC layoutUbC{actualTileShape, ubTileStride};
+
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(eventUbCVMTE2List[ubListId]);
+            copyGmToUbC(ubC, gmTileC, layoutUbC, layoutGmTileC);
+            AscendC::SetFlag<AscendC::HardEvent::MTE2_V>(eventUbCMTE2VList[ubListId]);
+
+            auto scaleTileOffset = tileOffset.template GetCoordByAxis<1>();
+            auto scaleTileShape = actualTileShape.template GetCoordByAxis<1>();
+
+            auto gmTileScale = gmScale[params.layoutScale.GetOffset(scaleTileOffset)];
+            auto layoutGmTileScale = params.layoutScale.GetTileLayout(scaleTileShape);
+
+            auto &ubScale = ubScaleList[ubListId];
+            auto layoutUbScale = LayoutScale::template MakeLayoutInUb<ElementScale>(scaleTileShape);
+
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(eventUbScaleVMTE2List[ubListId]);
+            copyGmToUbScale(ubScale, gmTileScale, layoutUbScale, layoutGmTileScale);
+            AscendC::SetFlag<AscendC::HardEvent::MTE2_V>(eventUbScaleMTE2VList[ubListId]);
+
+            // The per token scale is gathered by token, so the row scales are written by the scalar unit while the
+            // copies of C and scale are in flight
+            auto &ubRowScale = ubRowScaleList[ubListId];
+            AscendC::WaitFlag<AscendC::HardEvent::V_S>(eventUbRowScaleVSList[ubListId]);
+            for (uint32_t rowIdx = 0; rowIdx < actualTileShape.row(); ++rowIdx) {
+                uint32_t row = tileOffset.row() + rowIdx;
+                ElementTokenIndex tokenIdx = gmTokenIndex.GetValue(row);
+                tokenIndexList[rowIdx] = tokenIdx;
+                ubRowScale.SetValue(rowIdx, gmPerTokenScale.GetValue(tokenIdx) * gmRoutingWeight.GetValue(row));
+            }
+            AscendC::SetFlag<AscendC::HardEvent::S_V>(eventUbRowScaleSVList[ubListId]);
+
+            AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>(eventUbCMTE2VList[ubListId]);
+            AscendC::Cast(ubCFp32, ubC, AscendC::RoundMode::CAST_RINT, TileShape::COUNT);
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(eventUbCVMTE2List[ubListId]);
+
+            AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>(eventUbScaleMTE2VList[ubListId]);
+            // in place, an element only depends on itself and its column scale
+            AscendC::PipeBarrier<PIPE_V>();
+            tileRowBroadcastMul(ubCFp32, ubCFp32, ubScale);
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(eventUbScaleVMTE2List[ubListId]);
+
+            AscendC::WaitFlag<AscendC::HardEvent::S_V>(eventUbRowScaleSVList[ubListId]);
+            tileBroadcastOneBlk(ubRowScaleBrcb, ubRowScale);
+            AscendC::SetFlag<AscendC::HardEvent::V_S>(eventUbRowScaleVSList[ubListId]);
+
+            auto &ubD = ubDList[ubListId];
+            LayoutD layoutUbRowD{MatrixCoord{1U, actualTileShape.column()}, ubTileStride};
+            auto layoutGmRowD = params.layoutD.GetTileLayout(MatrixCoord{1U, actualTileShape.column()});
+
+            AscendC::WaitFlag<AscendC::HardEvent::MTE3_V>(eventUbDMTE3VList[ubListId]);
+            AscendC::PipeBarrier<PIPE_V>();
+            tileOneBlkColumnBroadcastMul(ubD, ubCFp32, ubRowScaleBrcb);
+            AscendC::PipeBarrier<PIPE_V>();
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE3>(eventUbDVMTE3List[ubListId]);
+
+            // Scatter the rows back to their tokens, the top k experts of a token add into the same row of D
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE3>(eventUbDVMTE3List[ubListId]);
+            AscendC::SetAtomicAdd<ElementD>();
+            for (uint32_t rowIdx = 0; rowIdx < actualTileShape.row(); ++rowIdx) {
+                MatrixCoord rowOffsetD{static_cast<uint32_t>(tokenIndexList[rowIdx]), tileOffset.column()};
+                copyUbToGmD(gmD[params.layoutD.GetOffset(rowOffsetD)], ubD[rowIdx * TileShape::COLUMN],
+                    layoutGmRowD, layoutUbRowD);
+            }
+            AscendC::SetAtomicNone();
+            AscendC::SetFlag<AscendC::HardEvent::MTE3_V>(eventUbDMTE3VList[ubListId]);
+
+            ubListId = (ubListId + 1 < UB_STAGES) ? (ubListId + 1) : 0;
+        }
+    }
+
+private:
+    Params params;
+
+    AscendC::LocalTensor<ElementC> ubCList[UB_STAGES];
+    AscendC::LocalTensor<ElementScale> ubScaleList[UB_STAGES];
+    AscendC::LocalTensor<float> ubRowScaleList[UB_STAGES];
+    AscendC::LocalTensor<ElementD> ubDList[UB_STAGES];
+
+    int32_t eventUbCVMTE2List[UB_STAGES];
+    int32_t eventUbCMTE2VList[UB_STAGES];
+    int32_t eventUbScaleVMTE2List[UB_STAGES];
+    int32_t eventUbScaleMTE2VList[UB_STAGES];
+    int32_t eventUbRowScaleVSList[UB_STAGES];
+    int32_t eventUbRowScaleSVList[UB_STAGES];
+    int32_t eventUbDMTE3VList[UB_STAGES];
+    int32_t eventUbDVMTE3List[UB_STAGES];
+
+    uint32_t ubListId{0};
+
+    AscendC::LocalTensor<float> ubCFp32;
+    AscendC::LocalTensor<float> ubRowScaleBrcb;
+
+    TileRowBroadcastMul tileRowBroadcastMul;
+    TileBroadcastOneBlk tileBroadcastOneBlk;
+    TileOneBlkColumnBroadcastMul tileOneBlkColumnBroadcastMul;
+
+    CopyGmToUbC copyGmToUbC;
+    CopyGmToUbScale copyGmToUbScale;
+    CopyUbToGmD copyUbToGmD;
+};
+
+}  // namespace Catlass::Epilogue::Block
+
+#endif  // CATLASS_EPILOGUE_BLOCK_EPILOGUE_PER_TOKEN_DEQUANT_MOE_COMBINE_HPP
@@ -70,6 +70,7 @@
          constexpr uint32_t TV_UB_TENSOR_OFFSET = 10 * UB_UINT8_BLOCK_SIZE;
          
          constexpr uint32_t HM_UB_TENSOR_OFFSET = 10 * UB_UINT8_BLOCK_SIZE + 9 * UB_UINT8_VECTOR_SIZE;
+         constexpr uint32_t GM_UB_TENSOR_OFFSET = 10 * UB_UINT8_BLOCK_SIZE + 10 * UB_UINT8_VECTOR_SIZE;
          constexpr uint32_t GL_UB_TENSOR_OFFSET = 10 * UB_UINT8_BLOCK_SIZE + 12 * UB_UINT8_VECTOR_SIZE;
          constexpr uint32_t DM_UB_TENSOR_OFFSET = 10 * UB_UINT8_BLOCK_SIZE + 13 * UB_UINT8_VECTOR_SIZE;
  
@@ -80,6 +81,7 @@
          goUbTensor16 = resource.ubBuf.template GetBufferByByte<ElementOutput>(GO_UB_TENSOR_OFFSET);
          goUbTensor32 = resource.ubBuf.template GetBufferByByte<float>(GO_UB_TENSOR_OFFSET);
          hmUbTensor = resource.ubBuf.template GetBufferByByte<float>(HM_UB_TENSOR_OFFSET);
+         gmUbTensor = resource.ubBuf.template GetBufferByByte<float>(GM_UB_TENSOR_OFFSET);
      }
  
      CATLASS_DEVICE
@@ -127,14 +129,51 @@
          }
      }
  
+     // A piece of a split task keeps its normalized output in fp32 and the lse of its rows, the row r of piece i is
+     // at r * splitNum + i, so the combine step reads the lse of a row in one burst
+     CATLASS_DEVICE
+     void CopyPartialToGm(
+         AscendC::GlobalTensor<ElementInput> gPartial,
+         AscendC::GlobalTensor<ElementInput> gLse,
+         uint32_t curRowNum, uint32_t curRowNumRound, uint32_t embedRound, uint32_t splitNum)
+     {
+         // *** lse = ln(gl) + gm, one row per block in tv after the expanded rows
+         AscendC::Ln(tvUbTensor, glUbTensor, curRowNumRound);
+         AscendC::PipeBarrier<PIPE_V>();
+         AscendC::Add(tvUbTensor, tvUbTensor, gmUbTensor, curRowNumRound);
+         AscendC::PipeBarrier<PIPE_V>();
+         AscendC::Brcb(tvUbTensor[MAX_ROW_NUM_SUB_CORE].ReinterpretCast<uint32_t>(),
+                       tvUbTensor.ReinterpretCast<uint32_t>(),
+                       curRowNumRound / FLOAT_BLOCK_SIZE,
+                       AscendC::BrcbRepeatParams(1, 8));
+         AscendC::SetFlag<AscendC::HardEvent::V_MTE3>(EVENT_ID0);
+         AscendC::WaitFlag<AscendC::HardEvent::V_MTE3>(EVENT_ID0);
+ 
+         AscendC::DataCopyPad(
+             gPartial,
+             goUbTensor32,
+             AscendC::DataCopyExtParams(curRowNum, embedRound * 4, 0, (splitNum - 1) * embedRound * 4, 0));
+         AscendC::DataCopyPad(
+             gLse,
+             tvUbTensor[MAX_ROW_NUM_SUB_CORE],
+             AscendC::DataCopyExtParams(curRowNum, 4, 0, (splitNum - 1) * 4, 0));
+         // tv and go are rewritten by the next task
+         AscendC::SetFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID3);
+         AscendC::WaitFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID3);
+         AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
+         AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
+     }
+ 
      CATLASS_DEVICE
      void SubCoreCompute(
          AscendC::GlobalTensor<ElementOutput> gOutput,
          AscendC::GlobalTensor<ElementInput> gInput,
+         AscendC::GlobalTensor<ElementInput> gPartial,
+         AscendC::GlobalTensor<ElementInput> gLse,
          const LayoutOutput &layoutOutput,
          const LayoutInput &layoutInput,
          uint32_t qNThisSubBlock,
-         uint32_t isFirstStackTile, uint32_t isLastStackTile, uint32_t curStackTileMod)
+         uint32_t isFirstStackTile, uint32_t isLastStackTile, uint32_t curStackTileMod, uint32_t splitNum)
      {
          uint32_t curRowNum = layoutInput.shape(0);
          uint32_t embed = layoutInput.shape(1);
@@ -222,6 +261,11 @@
              }
              AscendC::PipeBarrier<PIPE_V>();
  
+             if (splitNum > 1) {
+                 CopyPartialToGm(gPartial, gLse, curRowNum, curRowNumRound, embedRound, splitNum);
+                 return;
+             }
+ 
              // *** go = castfp32to16(go)
              if (std::is_same<ElementOutput, bfloat16_t>::value) {
                  AscendC::Cast<ElementOutput, float, false>(
@@ -255,6 +299,26 @@
          GemmCoord actualBlockShape,
          uint32_t qSBlockSize, uint32_t qNBlockSize,
          uint32_t isFirstStackTile, uint32_t isLastStackTile, uint32_t curStackTileMod)
+     {
+         AscendC::GlobalTensor<ElementInput> gPartial;
+         AscendC::GlobalTensor<ElementInput> gLse;
+         (*this)(gOutput, gInput, gPartial, gLse, layoutOutput, layoutInput, actualBlockShape, qSBlockSize, qNBlockSize,
+                 isFirstStackTile, isLastStackTile, curStackTileMod, 1);
+     }
+ 
+     // For a piece of a task split along kv into splitNum pieces, the last stack tile writes the partial output of the
+     // piece to gPartial and gLse instead of gOutput, both already offset to the piece
+     CATLASS_DEVICE
+     void operator()(
+         AscendC::GlobalTensor<ElementOutput> gOutput,
+         AscendC::GlobalTensor<ElementInput> gInput,
+         AscendC::GlobalTensor<ElementInput> gPartial,
+         AscendC::GlobalTensor<ElementInput> gLse,
+         const LayoutOutput &layoutOutput,
+         const LayoutInput &layoutInput,
+         GemmCoord actualBlockShape,
+         uint32_t qSBlockSize, uint32_t qNBlockSize,
+         uint32_t isFirstStackTile, uint32_t isLastStackTile, uint32_t curStackTileMod, uint32_t splitNum)
      {
          uint32_t rowNum = actualBlockShape.m();
          uint32_t embed = actualBlockShape.n();
@@ -285,12 +349,15 @@
              int64_t offsetInput = layoutInput.GetOffset(MatrixCoord(inRowOffsetThisSubBlock, 0));
              auto gInputThisSubBlock = gInput[offsetInput];
              auto layoutInputThisSubBlock = layoutInput.GetTileLayout(MatrixCoord(inRowActualThisSubBlock, embed));
+             uint32_t embedRound = layoutInput.stride(0);
              SubCoreCompute(
                  gOutputThisSubBlock,
                  gInputThisSubBlock,
+                 gPartial[inRowOffsetThisSubBlock * splitNum * embedRound],
+                 gLse[inRowOffsetThisSubBlock * splitNum],
                  layoutOutputThisSubBlock,
                  layoutInputThisSubBlock,
-                 qNThisSubBlock, isFirstStackTile, isLastStackTile, curStackTileMod);
+                 qNThisSubBlock, isFirstStackTile, isLastStackTile, curStackTileMod, splitNum);
          }
      }
  
@@ -298,6 +365,7 @@
      AscendC::LocalTensor<float> loUbTensor;
      AscendC::LocalTensor<float> dmUbTensor;
      AscendC::LocalTensor<float> hmUbTensor;
+     AscendC::LocalTensor<float> gmUbTensor;
      AscendC::LocalTensor<float> glUbTensor;
      AscendC::LocalTensor<float> tvUbTensor;
      AscendC::LocalTensor<ElementOutput> goUbTensor16;
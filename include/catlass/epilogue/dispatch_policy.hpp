@@ -54,6 +54,15 @@ struct EpilogueAtlasA2RescaleO {
     using ArchTag = Arch::AtlasA2;
 };
 
+// For AtlasA2, FA Infer combine of the tasks split along kv
+template <uint32_t COMPUTE_ELE_NUM_>
+struct EpilogueAtlasA2CombineO {
+    using ArchTag = Arch::AtlasA2;
+    static constexpr uint32_t KV_SPLIT_MAX = 64;
+    static constexpr uint32_t ROWS_PROCESS_MAX = 32;
+    static constexpr uint32_t COMPUTE_ELE_NUM = COMPUTE_ELE_NUM_;
+};
+
 // For AtlasA2, MLA RescaleO
 struct EpilogueAtlasA2MLARescaleO {
     using ArchTag = Arch::AtlasA2;
@@ -84,6 +93,13 @@ struct EpilogueAtlasA2PerTokenDequant {
     using ArchTag = Arch::AtlasA2;
     static constexpr uint32_t UB_STAGES = UB_STAGES_;
 };
+
+// For AtlasA2, per token dequant, then weighted fp32 scatter-add of the rows into the MoE combine buffer
+template <uint32_t UB_STAGES_>
+struct EpilogueAtlasA2PerTokenDequantMoeCombine {
+    using ArchTag = Arch::AtlasA2;
+    static constexpr uint32_t UB_STAGES = UB_STAGES_;
+};
 ////////////////////////////
 /// new add
 // For AtlasA2, GEMM
@@ -169,6 +169,44 @@ public:
         AscendC::GlobalTensor<ElementC> const &gmBlockC, LayoutC const &layoutC,
         GemmCoord const &actualShape, Callback &&callback = Callback{}
     )
+    {
+        LoadTiles(gmBlockA, layoutA, gmBlockB, layoutB, gmBlockC, layoutC, actualShape, callback);
+    }
+
+    /// Row i of the A block is row gmBlockRowIndexA[i] of gmBlockA. CopyGmToL1A must take the row index list as its
+    /// last argument, e.g. Tile::CopyGmToL1Gather.
+    template <class ElementIndex>
+    CATLASS_DEVICE
+    void operator()(
+        AscendC::GlobalTensor<ElementA> const &gmBlockA, LayoutA const &layoutA,
+        AscendC::GlobalTensor<ElementIndex> const &gmBlockRowIndexA,
+        AscendC::GlobalTensor<ElementB> const &gmBlockB, LayoutB const &layoutB,
+        AscendC::GlobalTensor<ElementC> const &gmBlockC, LayoutC const &layoutC,
+        GemmCoord const &actualShape, Callback &&callback = Callback{}
+    )
+    {
+        LoadTiles(gmBlockA, layoutA, gmBlockB, layoutB, gmBlockC, layoutC, actualShape, callback, gmBlockRowIndexA);
+    }
+
+    CATLASS_DEVICE
+    void SynchronizeBlock()
+    {
+        while (preloadCount > 0) {
+            L1TileMmad(l1TileMmadParamsList[l1TileMmadParamsId]);
+            l1TileMmadParamsId = (l1TileMmadParamsId + 1 < PRELOAD_STAGES) ? (l1TileMmadParamsId + 1) : 0;
+            --preloadCount;
+        }
+    }
+
+private:
+    template <class... CopyAArgs>
+    CATLASS_DEVICE
+    void LoadTiles(
+        AscendC::GlobalTensor<ElementA> const &gmBlockA, LayoutA const &layoutA,
+        AscendC::GlobalTensor<ElementB> const &gmBlockB, LayoutB const &layoutB,
+        AscendC::GlobalTensor<ElementC> const &gmBlockC, LayoutC const &layoutC,
+        GemmCoord const &actualShape, Callback const &callback, CopyAArgs const &...copyAArgs
+    )
     {
         uint32_t kTileCount = CeilDiv<L1TileShape::K>(actualShape.k());
 
@@ -195,7 +233,7 @@ public:
             // Load first matrix A tile from GM to L1
             AscendC::WaitFlag<AscendC::HardEvent::MTE1_MTE2>(l1AEventList[l1ListId]);
             auto layoutTileA = layoutA.GetTileLayout(MakeCoord(actualShape.m(), kActual));
-            copyGmToL1A(l1ATensorList[l1ListId], gmTileA, L1A_LAYOUT, layoutTileA);
+            copyGmToL1A(l1ATensorList[l1ListId], gmTileA, L1A_LAYOUT, layoutTileA, copyAArgs...);
             AscendC::SetFlag<AscendC::HardEvent::MTE2_MTE1>(l1AEventList[l1ListId]);
             // Load first matrix B tile from GM to L1
             AscendC::WaitFlag<AscendC::HardEvent::MTE1_MTE2>(l1BEventList[l1ListId]);
@@ -233,17 +271,6 @@ public:
         }
     }
 
-    CATLASS_DEVICE
-    void SynchronizeBlock()
-    {
-        while (preloadCount > 0) {
-            L1TileMmad(l1TileMmadParamsList[l1TileMmadParamsId]);
-            l1TileMmadParamsId = (l1TileMmadParamsId + 1 < PRELOAD_STAGES) ? (l1TileMmadParamsId + 1) : 0;
-            --preloadCount;
-        }
-    }
-
-private:
     struct L1TileMmadParams {
         uint32_t l1ListId;
         uint32_t mRound;
@@ -31,22 +31,22 @@ struct GemmIdentityBlockSwizzle {
 
     /// Methods
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     GemmIdentityBlockSwizzle() {}
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     GemmIdentityBlockSwizzle(GemmCoord const &problemShape_, MatrixCoord const &tileMN_)
         : problemShape(problemShape_), tileMN(tileMN_)
     {
         loopsMN = CeilDiv(MatrixCoord(problemShape.GetCoordMN()), tileMN);
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     GemmIdentityBlockSwizzle(GemmCoord const &problemShape_, MatrixCoord const &tileMN_,
         MatrixCoord const &loopsMN_)
         : problemShape(problemShape_), tileMN(tileMN_), loopsMN(loopsMN_) {}
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     void Update(GemmCoord const &problemShape_, MatrixCoord const &tileMN_)
     {
         problemShape = problemShape_;
@@ -55,7 +55,7 @@ struct GemmIdentityBlockSwizzle {
         loopsMN = CeilDiv(MatrixCoord(problemShape.GetCoordMN()), tileMN);
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     void Update(GemmCoord const &problemShape_, MatrixCoord const &tileMN_, MatrixCoord const &loopsMN_)
     {
         problemShape = problemShape_;
@@ -63,19 +63,19 @@ struct GemmIdentityBlockSwizzle {
         loopsMN = loopsMN_;
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     uint32_t GetCoreLoops() const
     {
         return loopsMN.row() * loopsMN.column();
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     uint32_t GetBatchIdx(uint32_t taskIdx)
     {
         return taskIdx / (GetCoreLoops());
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     GemmCoord GetBlockCoord(uint32_t taskIdx)
     {
         uint32_t innerIdx = taskIdx % GetCoreLoops();
@@ -112,7 +112,7 @@ struct GemmIdentityBlockSwizzle {
         }
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     GemmCoord GetActualBlockShape(GemmCoord blockCoord)
     {
         uint32_t mActual = (blockCoord.m() == (loopsMN.row() - 1)) ?
@@ -136,10 +136,10 @@ struct SplitkGemmIdentityBlockSwizzle {
 
     /// Methods
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     SplitkGemmIdentityBlockSwizzle() {}
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     SplitkGemmIdentityBlockSwizzle(
         GemmCoord const &problemShape_, GemmCoord const &tileShape_, uint32_t splitkFactor_ = 1
     ) : problemShape(problemShape_), tileShape(tileShape_), splitkFactor(splitkFactor_)
@@ -147,7 +147,7 @@ struct SplitkGemmIdentityBlockSwizzle {
         loopsMNK = CeilDiv(problemShape, tileShape);
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     uint32_t GetKIdxBySplitkSliceIdx(uint32_t splitkSliceIdx) const
     {
         if (splitkSliceIdx < loopsMNK.k() % splitkFactor) {
@@ -157,26 +157,26 @@ struct SplitkGemmIdentityBlockSwizzle {
         }
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     uint32_t GetSplitkSliceIdx(uint32_t taskIdx) const
     {
         uint32_t mnLoops = loopsMNK.m() * loopsMNK.n();
         return taskIdx % GetCoreLoops() / mnLoops;
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     uint32_t GetCoreLoops() const
     {
         return loopsMNK.m() * loopsMNK.n() * splitkFactor;
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     uint32_t GetBatchIdx(uint32_t taskIdx)
     {
         return taskIdx / GetCoreLoops();
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     GemmCoord GetBlockCoord(uint32_t taskIdx)
     {
         uint32_t splitkSliceIdx = GetSplitkSliceIdx(taskIdx);
@@ -216,7 +216,7 @@ struct SplitkGemmIdentityBlockSwizzle {
         }
     }
 
-    CATLASS_DEVICE
+    CATLASS_HOST_DEVICE
     GemmCoord GetActualBlockShape(GemmCoord blockCoord, uint32_t splitkSliceIdx)
     {
         uint32_t splitkSliceLen;
@@ -235,6 +235,326 @@ struct SplitkGemmIdentityBlockSwizzle {
     }
 };
 
+/// Block swizzling function for Stream-K Gemms
+///
+/// A MAC-iteration is the multiply-add of one L1 k tile of one output tile. Tiles of the full waves are data
+/// parallel and are computed whole, tasks [0, GetCoreLoops()) are distributed over the cores like the other swizzles.
+/// The tiles of the last partial wave, together with one full wave to make the segments longer, are stream-k tiles:
+/// their iterations are laid out tile by tile and split into contiguous ranges of equal length, one per core.
+/// A tile crossed by a range boundary is shared by consecutive cores. The segment holding its first k tile is the
+/// owner, the others leave partial sums in the workspace which a fix-up pass adds to the owner's result.
+/// Only the first segment of a core can start inside a tile, so one partial slot per core is enough.
+template <uint32_t SwizzleOffset = 1, uint32_t SwizzleDirection = 0>
+struct StreamkGemmIdentityBlockSwizzle {
+    /// Part of a stream-k tile computed by one core, k tiles [kTileBegin, kTileEnd) of tile taskIdx
+    struct Segment {
+        uint32_t taskIdx;
+        uint32_t kTileBegin;
+        uint32_t kTileEnd;
+    };
+
+    /// Data members
+
+    GemmCoord problemShape;
+    GemmCoord tileShape;
+    GemmCoord loopsMNK;
+    uint32_t coreNum = 1;
+    uint32_t dpTiles = 0;       // tiles [0, dpTiles) are data parallel, the others are stream-k tiles
+    uint32_t skCores = 0;       // cores sharing the iterations of the stream-k tiles
+    uint32_t skItersPerCore = 0;
+    uint32_t skItersTail = 0;   // the first skItersTail cores take one more iteration
+    GemmIdentityBlockSwizzle<SwizzleOffset, SwizzleDirection> tileSwizzle;
+
+    /// Methods
+
+    CATLASS_HOST_DEVICE
+    StreamkGemmIdentityBlockSwizzle() {}
+
+    CATLASS_HOST_DEVICE
+    StreamkGemmIdentityBlockSwizzle(GemmCoord const &problemShape_, GemmCoord const &tileShape_, uint32_t coreNum_)
+        : problemShape(problemShape_), tileShape(tileShape_), coreNum(coreNum_ == 0 ? 1 : coreNum_)
+    {
+        loopsMNK = CeilDiv(problemShape, tileShape);
+        tileSwizzle.Update(problemShape, MatrixCoord{tileShape.m(), tileShape.n()},
+            MatrixCoord{loopsMNK.m(), loopsMNK.n()});
+
+        uint32_t tiles = GetTileNum();
+        uint32_t skTiles = tiles % coreNum;
+        if (skTiles != 0 && tiles > coreNum) {
+            skTiles += coreNum;
+        }
+        dpTiles = tiles - skTiles;
+        uint32_t skIters = skTiles * loopsMNK.k();
+        skCores = Min(skIters, coreNum);
+        if (skCores > 0) {
+            skItersPerCore = skIters / skCores;
+            skItersTail = skIters % skCores;
+        }
+    }
+
+    CATLASS_HOST_DEVICE
+    uint32_t GetTileNum() const
+    {
+        return loopsMNK.m() * loopsMNK.n();
+    }
+
+    /// Number of data parallel tasks
+    CATLASS_HOST_DEVICE
+    uint32_t GetCoreLoops() const
+    {
+        return dpTiles;
+    }
+
+    CATLASS_HOST_DEVICE
+    uint32_t GetSkTileNum() const
+    {
+        return GetTileNum() - dpTiles;
+    }
+
+    /// Number of cores owning a partial slot in the workspace
+    CATLASS_HOST_DEVICE
+    uint32_t GetSkCoreNum() const
+    {
+        return skCores;
+    }
+
+    /// First stream-k iteration of a core, iterations are counted from the first stream-k tile
+    CATLASS_HOST_DEVICE
+    uint32_t GetSkIterBegin(uint32_t coreIdx) const
+    {
+        if (coreIdx > skCores) {
+            coreIdx = skCores;
+        }
+        if (coreIdx < skItersTail) {
+            return coreIdx * (skItersPerCore + 1);
+        }
+        return coreIdx * skItersPerCore + skItersTail;
+    }
+
+    CATLASS_HOST_DEVICE
+    uint32_t GetSkIterEnd(uint32_t coreIdx) const
+    {
+        return GetSkIterBegin(coreIdx + 1);
+    }
+
+    /// Core computing a stream-k iteration
+    CATLASS_HOST_DEVICE
+    uint32_t GetSkCoreIdx(uint32_t iterIdx) const
+    {
+        uint32_t tailIters = skItersTail * (skItersPerCore + 1);
+        if (iterIdx < tailIters) {
+            return iterIdx / (skItersPerCore + 1);
+        }
+        return skItersTail + (iterIdx - tailIters) / skItersPerCore;
+    }
+
+    CATLASS_HOST_DEVICE
+    uint32_t GetSkSegmentNum(uint32_t coreIdx) const
+    {
+        uint32_t iterBegin = GetSkIterBegin(coreIdx);
+        uint32_t iterEnd = GetSkIterEnd(coreIdx);
+        if (iterBegin >= iterEnd) {
+            return 0;
+        }
+        return (iterEnd - 1) / loopsMNK.k() - iterBegin / loopsMNK.k() + 1;
+    }
+
+    CATLASS_HOST_DEVICE
+    Segment GetSkSegment(uint32_t coreIdx, uint32_t segmentIdx) const
+    {
+        uint32_t iterBegin = GetSkIterBegin(coreIdx);
+        uint32_t iterEnd = GetSkIterEnd(coreIdx);
+        uint32_t skTileIdx = iterBegin / loopsMNK.k() + segmentIdx;
+        uint32_t tileIterBegin = skTileIdx * loopsMNK.k();
+        uint32_t tileIterEnd = tileIterBegin + loopsMNK.k();
+        Segment segment;
+        segment.taskIdx = dpTiles + skTileIdx;
+        segment.kTileBegin = Max(iterBegin, tileIterBegin) - tileIterBegin;
+        segment.kTileEnd = Min(iterEnd, tileIterEnd) - tileIterBegin;
+        return segment;
+    }
+
+    /// Cores sharing a stream-k tile are [GetSkOwnerCoreIdx(taskIdx), GetSkLastCoreIdx(taskIdx)], the cores after
+    /// the owner hold their partial sums of the tile in their own slots.
+    CATLASS_HOST_DEVICE
+    uint32_t GetSkOwnerCoreIdx(uint32_t taskIdx) const
+    {
+        return GetSkCoreIdx((taskIdx - dpTiles) * loopsMNK.k());
+    }
+
+    CATLASS_HOST_DEVICE
+    uint32_t GetSkLastCoreIdx(uint32_t taskIdx) const
+    {
+        return GetSkCoreIdx((taskIdx - dpTiles + 1) * loopsMNK.k() - 1);
+    }
+
+    CATLASS_HOST_DEVICE
+    GemmCoord GetBlockCoord(uint32_t taskIdx)
+    {
+        return tileSwizzle.GetBlockCoord(taskIdx);
+    }
+
+    CATLASS_HOST_DEVICE
+    GemmCoord GetBlockCoord(Segment const &segment)
+    {
+        GemmCoord blockCoord = tileSwizzle.GetBlockCoord(segment.taskIdx);
+        return GemmCoord{blockCoord.m(), blockCoord.n(), segment.kTileBegin};
+    }
+
+    CATLASS_HOST_DEVICE
+    GemmCoord GetActualBlockShape(GemmCoord blockCoord)
+    {
+        return tileSwizzle.GetActualBlockShape(blockCoord);
+    }
+
+    CATLASS_HOST_DEVICE
+    GemmCoord GetActualBlockShape(GemmCoord blockCoord, Segment const &segment)
+    {
+        GemmCoord tileBlockShape = tileSwizzle.GetActualBlockShape(blockCoord);
+        uint32_t kActual = (segment.kTileEnd == loopsMNK.k()) ?
+            (problemShape.k() - segment.kTileBegin * tileShape.k()) :
+            (segment.kTileEnd - segment.kTileBegin) * tileShape.k();
+        return GemmCoord{tileBlockShape.m(), tileBlockShape.n(), kActual};
+    }
+};
+
+/// Flat task table of grouped matmuls split along m, built on the host from the group list.
+/// The tiles of all groups are numbered one group after the other, in the order of TileSwizzle within a group, so the
+/// first task of a core is mapped to its group by a binary search on the prefix sum of the tiles, the following ones by
+/// walking the prefix sum forward, and empty groups take no task. Each core takes a contiguous range of tasks, the
+/// ranges are cut so that the estimated costs of the cores are balanced: a tile costs m * n * k, with m rounded up to
+/// the cube fractal since short tiles are padded.
+///
+/// Layout of the uint32_t table:
+///   [0]                                     number of cores the ranges are cut for
+///   [1, coreNum + 2)                        first task of every core, then the number of tasks
+///   [coreNum + 2, coreNum + groupCount + 3) first task of every group, then the number of tasks
+template <class TileSwizzle>
+struct GroupedMatmulTaskTable {
+    static constexpr uint32_t M_ALIGN = 16;
+
+    CATLASS_HOST_DEVICE
+    static uint32_t GetSize(uint32_t groupCount, uint32_t coreNum)
+    {
+        return coreNum + groupCount + 3;
+    }
+
+    CATLASS_HOST_DEVICE
+    static uint32_t GetCoreOffsetIdx(uint32_t coreIdx)
+    {
+        return 1 + coreIdx;
+    }
+
+    CATLASS_HOST_DEVICE
+    static uint32_t GetGroupOffsetIdx(uint32_t coreNum, uint32_t groupIdx)
+    {
+        return coreNum + 2 + groupIdx;
+    }
+
+    /// Group of a task, the last group whose first task is not after taskIdx. Table is read with GetValue, e.g. an
+    /// AscendC::GlobalTensor<uint32_t> on the device.
+    template <class Table>
+    CATLASS_HOST_DEVICE
+    static uint32_t FindGroup(Table &table, uint32_t coreNum, uint32_t groupCount, uint32_t taskIdx)
+    {
+        uint32_t base = GetGroupOffsetIdx(coreNum, 0);
+        uint32_t low = 0;
+        uint32_t high = groupCount;
+        while (high - low > 1) {
+            uint32_t mid = (low + high) / 2;
+            if (table.GetValue(base + mid) <= taskIdx) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    /// Move from group groupIdx, whose last task is done, to the group of the next task. groupTaskEnd holds the end
+    /// of groupIdx on entry, groupTaskBegin and groupTaskEnd hold the range of the new group on return. Empty groups
+    /// cost one read each, so a core walking its tasks in order reads every group offset once and calls FindGroup
+    /// only for its first task. There must be a task left after groupIdx.
+    template <class Table>
+    CATLASS_HOST_DEVICE
+    static uint32_t NextGroup(Table &table, uint32_t coreNum, uint32_t groupIdx, uint32_t &groupTaskBegin,
+        uint32_t &groupTaskEnd)
+    {
+        groupTaskBegin = groupTaskEnd;
+        do {
+            ++groupIdx;
+            groupTaskEnd = table.GetValue(GetGroupOffsetIdx(coreNum, groupIdx + 1));
+        } while (groupTaskEnd <= groupTaskBegin);
+        return groupIdx;
+    }
+
+    /// Fill table, of GetSize(groupCount, coreNum) elements. groupList holds the cumulative m of the groups as the
+    /// grouped matmul kernels take it.
+    template <class ElementGroupList>
+    static void Build(GemmCoord const &problemShape, MatrixCoord const &tileMN,
+        ElementGroupList const *groupList, uint32_t groupCount, uint32_t coreNum, uint32_t *table)
+    {
+        coreNum = coreNum == 0 ? 1 : coreNum;
+        table[0] = coreNum;
+        uint32_t taskNum = 0;
+        uint64_t totalCost = 0;
+        TileSwizzle tileSwizzle;
+        for (uint32_t groupIdx = 0; groupIdx < groupCount; ++groupIdx) {
+            table[GetGroupOffsetIdx(coreNum, groupIdx)] = taskNum;
+            tileSwizzle.Update(GetGroupShape(problemShape, groupList, groupIdx), tileMN);
+            taskNum += tileSwizzle.GetCoreLoops();
+            totalCost += GetGroupCost(tileSwizzle);
+        }
+        table[GetGroupOffsetIdx(coreNum, groupCount)] = taskNum;
+
+        // cut the task sequence where its prefix cost is nearest to every multiple of totalCost / coreNum
+        table[GetCoreOffsetIdx(0)] = 0;
+        uint32_t coreIdx = 0;
+        uint32_t taskIdx = 0;
+        uint64_t prefixCost = 0;
+        for (uint32_t groupIdx = 0; groupIdx < groupCount && coreIdx + 1 < coreNum; ++groupIdx) {
+            tileSwizzle.Update(GetGroupShape(problemShape, groupList, groupIdx), tileMN);
+            for (uint32_t loopIdx = 0; loopIdx < tileSwizzle.GetCoreLoops(); ++loopIdx, ++taskIdx) {
+                uint64_t cost = GetTileCost(tileSwizzle, loopIdx);
+                while (coreIdx + 1 < coreNum && (prefixCost + cost) * coreNum >= totalCost * (coreIdx + 1)) {
+                    uint64_t target = totalCost * (coreIdx + 1);
+                    bool cutBefore = target - prefixCost * coreNum < (prefixCost + cost) * coreNum - target;
+                    table[GetCoreOffsetIdx(++coreIdx)] = cutBefore ? taskIdx : taskIdx + 1;
+                }
+                prefixCost += cost;
+            }
+        }
+        while (coreIdx < coreNum) {
+            table[GetCoreOffsetIdx(++coreIdx)] = taskNum;
+        }
+    }
+
+    template <class ElementGroupList>
+    static GemmCoord GetGroupShape(GemmCoord const &problemShape, ElementGroupList const *groupList,
+        uint32_t groupIdx)
+    {
+        uint32_t mBegin = (groupIdx == 0) ? 0 : static_cast<uint32_t>(groupList[groupIdx - 1]);
+        uint32_t mEnd = static_cast<uint32_t>(groupList[groupIdx]);
+        return GemmCoord{mEnd > mBegin ? mEnd - mBegin : 0, problemShape.n(), problemShape.k()};
+    }
+
+    static uint64_t GetTileCost(TileSwizzle &tileSwizzle, uint32_t loopIdx)
+    {
+        GemmCoord actualBlockShape = tileSwizzle.GetActualBlockShape(tileSwizzle.GetBlockCoord(loopIdx));
+        return static_cast<uint64_t>(RoundUp(actualBlockShape.m(), M_ALIGN)) * actualBlockShape.n() *
+            actualBlockShape.k();
+    }
+
+    static uint64_t GetGroupCost(TileSwizzle &tileSwizzle)
+    {
+        uint64_t cost = 0;
+        for (uint32_t loopIdx = 0; loopIdx < tileSwizzle.GetCoreLoops(); ++loopIdx) {
+            cost += GetTileCost(tileSwizzle, loopIdx);
+        }
+        return cost;
+    }
+};
+
 /// Block swizzling function for Gemms
 template <uint32_t SwizzleOffset = 1, uint32_t SwizzleDirection = 0>
 struct GemmIdentityBlockSwizzleL1FullLoad {
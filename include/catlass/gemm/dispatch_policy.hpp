@@ -115,6 +115,13 @@ struct GemmAtlasA2 : public MmadAtlasA2 {
 struct GemvAtlasA2 : public MmadAtlasA2 {
     static constexpr uint32_t STAGES = 2;
 };
+
+// Gemv of up to MAX_BATCH vectors sharing the matrix, each tile of the matrix is read once for all of them
+template <uint32_t MAX_BATCH_ = 16>
+struct BatchedGemvAtlasA2 : public MmadAtlasA2 {
+    static constexpr uint32_t STAGES = 2;
+    static constexpr uint32_t MAX_BATCH = MAX_BATCH_;
+};
 ////////////////////
 
 template <bool ENABLE_UNIT_FLAG_ = false>
@@ -0,0 +1,428 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMM_KERNEL_GROUPED_MATMUL_M_PER_TOKEN_DEQUANT_MOE_HPP
+#define CATLASS_GEMM_KERNEL_GROUPED_MATMUL_M_PER_TOKEN_DEQUANT_MOE_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/cross_core_sync.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/coord.hpp"
+#include "catlass/detail/callback.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/gemm/kernel/splitk_matmul.hpp"
+#include "catlass/matrix_coord.hpp"
+
+namespace Catlass::Gemm::Kernel {
+
+/// Grouped matmul slicing M with per token dequant, with the MoE token permute and unpermute fused in.
+/// A holds the tokens in their original order. The m rows of the problem are the (token, expert) pairs sorted by
+/// expert: row i reads token tokenIndex[i] of A while A is loaded into L1, and its dequantized result is scaled by
+/// routingWeight[i] and added to row tokenIndex[i] of an fp32 combine buffer in the workspace, which has one row per
+/// token. Once every AIV is done, ReduceAdd casts the combine buffer to D, so the top k rows of a token are rounded
+/// to the output type once. The order of the fp32 atomic adds depends on the cores, D is not bitwise reproducible.
+/// BlockMmad needs a CopyGmToL1A that gathers rows (Tile::TileCopyGatherA), BlockEpilogue must be the
+/// EpilogueAtlasA2PerTokenDequantMoeCombine one with an fp32 D and ReduceAdd a Kernel::ReduceAdd from fp32 to D.
+template <
+    class BlockMmad_,
+    class BlockEpilogue_,
+    class BlockScheduler_,
+    class ReduceAdd_,
+    class ElementGroupList_
+>
+class GroupedMatmulSliceMPerTokenDequantMoe {
+public:
+    using BlockMmad = BlockMmad_;
+    using ArchTag = typename BlockMmad::ArchTag;
+    using L1TileShape = typename BlockMmad::L1TileShape;
+    using ElementA = typename BlockMmad::ElementA;
+    using LayoutA = typename BlockMmad::LayoutA;
+    using ElementB = typename BlockMmad::ElementB;
+    using LayoutB = typename BlockMmad::LayoutB;
+    using ElementC = typename BlockMmad::ElementC;
+    using LayoutC = typename BlockMmad::LayoutC;
+    using ElementAccumulator = typename BlockMmad::ElementAccumulator;
+
+    using BlockEpilogue = BlockEpilogue_;
+    using ElementScale = typename BlockEpilogue::ElementScale;
+    using LayoutScale = typename BlockEpilogue::LayoutScale;
+    using ElementPerTokenScale = typename BlockEpilogue::ElementPerTokenScale;
+    using LayoutPerTokenScale = typename BlockEpilogue::LayoutPerTokenScale;
+    using ElementTokenIndex = typename BlockEpilogue::ElementTokenIndex;
+    using ElementRoutingWeight = typename BlockEpilogue::ElementRoutingWeight;
+    using ElementCombine = typename BlockEpilogue::ElementD;
+    using LayoutD = typename BlockEpilogue::LayoutD;
+    using EpilogueParams = typename BlockEpilogue::Params;
+
+    using ReduceAdd = ReduceAdd_;
+    using ElementD = typename ReduceAdd::ElementOut;
+    static_assert(std::is_same_v<typename ReduceAdd::ElementAccumulator, ElementCombine>,
+        "ReduceAdd must read the combine buffer of BlockEpilogue");
+
+    using ElementGroupList = ElementGroupList_;
+
+    using BlockScheduler = BlockScheduler_;
+
+    friend class AicFinishSync;
+    friend class AivWaitSync;
+
+    struct AicFinishSync {
+        using MatmulKernel =
+            GroupedMatmulSliceMPerTokenDequantMoe<BlockMmad, BlockEpilogue, BlockScheduler, ReduceAdd, ElementGroupList>;
+
+        CATLASS_DEVICE
+        void operator()() const
+        {
+            Arch::CrossCoreSetFlagWithReverse<0x2, PIPE_FIX>(ptr->flagAicFinishStore);
+        }
+
+        MatmulKernel *ptr;
+    };
+
+    struct AivWaitSync {
+        using MatmulKernel =
+            GroupedMatmulSliceMPerTokenDequantMoe<BlockMmad, BlockEpilogue, BlockScheduler, ReduceAdd, ElementGroupList>;
+
+        CATLASS_DEVICE
+        void operator()() const
+        {
+            Arch::CrossCoreWaitFlagWithReverse<0x2, PIPE_MTE3>(ptr->flagAicFinishStore);
+        }
+
+        MatmulKernel *ptr;
+    };
+
+    /// Parameters structure
+    struct Params {
+        // Data members
+        GemmCoord problemShape;
+        uint32_t problemCount;
+        uint32_t tokenCount;
+        __gm__ ElementGroupList *ptrGroupList;
+        __gm__ ElementA *ptrA;
+        LayoutA layoutA;
+        __gm__ ElementTokenIndex *ptrTokenIndex;
+        __gm__ ElementB *ptrB;
+        LayoutB layoutB;
+        __gm__ ElementScale *ptrScale;
+        LayoutScale layoutScale;
+        __gm__ ElementPerTokenScale *ptrPerTokenScale;
+        LayoutPerTokenScale layoutPerTokenScale;
+        __gm__ ElementRoutingWeight *ptrRoutingWeight;
+        __gm__ ElementD *ptrD;
+        LayoutD layoutD;
+        GM_ADDR ptrWorkspace;
+
+        // Methods
+        CATLASS_HOST_DEVICE
+        Params() {}
+
+        CATLASS_HOST_DEVICE
+        Params(
+            GemmCoord problemShape_, uint32_t problemCount_, uint32_t tokenCount_, GM_ADDR ptrGroupList_,
+            GM_ADDR ptrA_, LayoutA layoutA_, GM_ADDR ptrTokenIndex_,
+            GM_ADDR ptrB_, LayoutB layoutB_,
+            GM_ADDR ptrScale_, LayoutScale layoutScale_,
+            GM_ADDR ptrPerTokenScale_, LayoutPerTokenScale layoutPerTokenScale_,
+            GM_ADDR ptrRoutingWeight_,
+            GM_ADDR ptrD_, LayoutD layoutD_,
+            GM_ADDR ptrWorkspace_
+        ) : problemShape(problemShape_), problemCount(problemCount_), tokenCount(tokenCount_),
+            ptrGroupList(reinterpret_cast<__gm__ ElementGroupList *>(ptrGroupList_)),
+            ptrA(reinterpret_cast<__gm__ ElementA *>(ptrA_)), layoutA(layoutA_),
+            ptrTokenIndex(reinterpret_cast<__gm__ ElementTokenIndex *>(ptrTokenIndex_)),
+            ptrB(reinterpret_cast<__gm__ ElementB *>(ptrB_)), layoutB(layoutB_),
+            ptrScale(reinterpret_cast<__gm__ ElementScale *>(ptrScale_)), layoutScale(layoutScale_),
+            ptrPerTokenScale(reinterpret_cast<__gm__ ElementPerTokenScale *>(ptrPerTokenScale_)),
+            layoutPerTokenScale(layoutPerTokenScale_),
+            ptrRoutingWeight(reinterpret_cast<__gm__ ElementRoutingWeight *>(ptrRoutingWeight_)),
+            ptrD(reinterpret_cast<__gm__ ElementD *>(ptrD_)), layoutD(layoutD_),
+            ptrWorkspace(ptrWorkspace_)
+        {
+        }
+    };
+
+    struct Arguments {
+        //
+        // Data members
+        //
+        GemmCoord problemShape;     // m is the number of (token, expert) pairs, i.e. tokenCount * topK
+        uint32_t problemCount;
+        uint32_t tokenCount;
+        uint8_t *ptrGroupList;
+        uint8_t *ptrA;              // tokenCount x k
+        uint8_t *ptrTokenIndex;     // m, the token of each row sorted by expert
+        uint8_t *ptrB;
+        uint8_t *ptrScale;
+        uint8_t *ptrPerTokenScale;  // tokenCount
+        uint8_t *ptrRoutingWeight;  // m, in the same order as ptrTokenIndex
+        uint8_t *ptrD;              // tokenCount x n
+    };
+
+    static bool CanImplement(const Arguments &args)
+    {
+        return args.tokenCount > 0;
+    }
+
+    // C of the sorted rows, then the fp32 combine buffer of the tokens
+    static size_t GetWorkspaceSize(const Arguments &args)
+    {
+        uint32_t m = args.problemShape.m();
+        uint32_t n = args.problemShape.n();
+        size_t sizeC = static_cast<size_t>(m) * n * sizeof(ElementC);
+        size_t sizeCombine = static_cast<size_t>(args.tokenCount) * n * sizeof(ElementCombine);
+        return sizeC + sizeCombine;
+    }
+
+    static Params ToUnderlyingArguments(const Arguments &args, uint8_t* workspace)
+    {
+        uint32_t n = args.problemShape.n();
+        uint32_t k = args.problemShape.k();
+
+        LayoutA layoutA{args.tokenCount, k};
+        LayoutB layoutB{k, n};
+        LayoutScale layoutScale{n};
+        LayoutPerTokenScale layoutPerTokenScale{args.tokenCount};
+        LayoutD layoutD{args.tokenCount, n};
+
+        Params params{args.problemShape, args.problemCount, args.tokenCount, args.ptrGroupList,
+            args.ptrA, layoutA, args.ptrTokenIndex,
+            args.ptrB, layoutB,
+            args.ptrScale, layoutScale,
+            args.ptrPerTokenScale, layoutPerTokenScale,
+            args.ptrRoutingWeight,
+            args.ptrD, layoutD, workspace};
+        return params;
+    }
+
+    // Methods
+    CATLASS_DEVICE
+    GroupedMatmulSliceMPerTokenDequantMoe() {}
+
+    CATLASS_DEVICE
+    ~GroupedMatmulSliceMPerTokenDequantMoe() {}
+
+    template <int32_t CORE_TYPE = g_coreType>
+    CATLASS_DEVICE
+    void operator()(Params const &params);
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIC>(Params const &params)
+    {
+        BlockScheduler blockScheduler;
+        BlockMmad blockMmad(resource);
+
+        // Represent the full gm
+        AscendC::GlobalTensor<ElementA> gmA;
+        gmA.SetGlobalBuffer(params.ptrA);
+        AscendC::GlobalTensor<ElementTokenIndex> gmTokenIndex;
+        gmTokenIndex.SetGlobalBuffer(params.ptrTokenIndex);
+        AscendC::GlobalTensor<ElementB> gmB;
+        gmB.SetGlobalBuffer(params.ptrB);
+        AscendC::GlobalTensor<ElementC> gmC;
+        gmC.SetGlobalBuffer(reinterpret_cast<__gm__ ElementC *>(params.ptrWorkspace));
+        AscendC::GlobalTensor<ElementGroupList> groupList;
+        groupList.SetGlobalBuffer(params.ptrGroupList);
+
+        uint32_t coreIdx = AscendC::GetBlockIdx();
+        uint32_t coreNum = AscendC::GetBlockNum();
+        int64_t gmGroupOffsetRow = 0;
+        int64_t gmGroupOffsetB = 0;
+        int64_t gmGroupOffsetC = 0;
+
+        AicFinishSync aicFinishSync{this};
+        uint32_t startCoreIdx = 0;
+        for (uint32_t groupIdx = 0; groupIdx < params.problemCount; ++groupIdx) {
+            uint32_t currentM = (groupIdx == 0) ? groupList.GetValue(groupIdx) :
+                (groupList.GetValue(groupIdx) - groupList.GetValue(groupIdx - 1));
+            GemmCoord inGroupProblemShape{currentM, params.problemShape.n(), params.problemShape.k()};
+
+            // The rows of A are gathered, so A keeps the layout of the whole token matrix
+            LayoutA layoutA = params.layoutA;
+            LayoutB layoutB = params.layoutB;
+            LayoutC layoutC = LayoutC(inGroupProblemShape.m(), inGroupProblemShape.n());
+
+            blockScheduler.Update(inGroupProblemShape, MakeCoord(L1TileShape::M, L1TileShape::N));
+            uint32_t coreLoops = blockScheduler.GetCoreLoops();
+
+            // Determine the starting loopIdx of the current core under the current groupIdx
+            uint32_t startLoopIdx = ((coreIdx < startCoreIdx) ? (coreIdx + coreNum) : coreIdx) - startCoreIdx;
+            // Loop through the matmul of each groupIdx
+            for (uint32_t loopIdx = startLoopIdx; loopIdx < coreLoops; loopIdx += coreNum) {
+                // Compute block location
+                GemmCoord blockCoord = blockScheduler.GetBlockCoord(loopIdx);
+                GemmCoord actualBlockShape = blockScheduler.GetActualBlockShape(blockCoord);
+
+                // Compute initial location in logical coordinates
+                MatrixCoord offsetA{0U, blockCoord.k() * L1TileShape::K};
+                MatrixCoord offsetB{blockCoord.k() * L1TileShape::K, blockCoord.n() * L1TileShape::N};
+                MatrixCoord offsetC{blockCoord.m() * L1TileShape::M, blockCoord.n() * L1TileShape::N};
+                int64_t gmOffsetA = layoutA.GetOffset(offsetA);
+                int64_t gmOffsetRow = gmGroupOffsetRow + blockCoord.m() * L1TileShape::M;
+                int64_t gmOffsetB = layoutB.GetOffset(offsetB);
+                int64_t gmOffsetC = layoutC.GetOffset(offsetC);
+
+                // Compute block-scoped matrix multiply-add
+                if constexpr (BlockMmad::DispatchPolicy::ASYNC) {
+                    blockMmad(
+                        gmA[gmOffsetA], layoutA, gmTokenIndex[gmOffsetRow],
+                        gmB[gmGroupOffsetB + gmOffsetB], layoutB,
+                        gmC[gmGroupOffsetC + gmOffsetC], layoutC,
+                        actualBlockShape, MakeCallback(&aicFinishSync)
+                    );
+                } else {
+                    blockMmad(
+                        gmA[gmOffsetA], layoutA, gmTokenIndex[gmOffsetRow],
+                        gmB[gmGroupOffsetB + gmOffsetB], layoutB,
+                        gmC[gmGroupOffsetC + gmOffsetC], layoutC,
+                        actualBlockShape
+                    );
+                    aicFinishSync();
+                }
+            }
+
+            gmGroupOffsetRow += inGroupProblemShape.m();
+            gmGroupOffsetB += inGroupProblemShape.k() * inGroupProblemShape.n();
+            gmGroupOffsetC += inGroupProblemShape.m() * inGroupProblemShape.n();
+
+            startCoreIdx = (startCoreIdx + coreLoops) % coreNum;
+        }
+
+        if constexpr (BlockMmad::DispatchPolicy::ASYNC) {
+            blockMmad.SynchronizeBlock();
+        }
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIV>(Params const &params)
+    {
+        uint64_t combineCount = static_cast<uint64_t>(params.tokenCount) * params.problemShape.n();
+        auto ptrCombine = reinterpret_cast<__gm__ ElementCombine *>(
+            params.ptrWorkspace + static_cast<uint64_t>(params.problemShape.m()) * params.problemShape.n() *
+            sizeof(ElementC));
+        AscendC::GlobalTensor<ElementCombine> gmCombine;
+        gmCombine.SetGlobalBuffer(ptrCombine);
+        ClearCombine(gmCombine, combineCount);
+        // No row is added before every AIV has cleared its part
+        Catlass::Arch::CrossCoreBarrier<0x0, PIPE_MTE3>();
+
+        Combine(params, ptrCombine);
+
+        // The combine buffer is complete once every AIV has added its rows
+        Catlass::Arch::CrossCoreBarrier<0x0, PIPE_MTE3>();
+        AscendC::GlobalTensor<ElementD> gmD;
+        gmD.SetGlobalBuffer(params.ptrD);
+        ReduceAdd reduceAdd(resource);
+        reduceAdd(gmD, gmCombine, combineCount, 1);
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+private:
+    // Elements cleared by one copy, from a zeroed UB buffer
+    static constexpr uint32_t CLEAR_LENGTH = 16 * 1024 / sizeof(ElementCombine);
+
+    CATLASS_DEVICE
+    void ClearCombine(AscendC::GlobalTensor<ElementCombine> const &gmCombine, uint64_t combineCount)
+    {
+        auto ubZero = resource.ubBuf.template GetBufferByByte<ElementCombine>(0);
+        AscendC::Duplicate(ubZero, ElementCombine(0), CLEAR_LENGTH);
+        AscendC::SetFlag<AscendC::HardEvent::V_MTE3>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE3>(EVENT_ID0);
+
+        uint32_t aivNum = AscendC::GetBlockNum() * AscendC::GetSubBlockNum();
+        uint64_t loops = CeilDiv(combineCount, static_cast<uint64_t>(CLEAR_LENGTH));
+        for (uint64_t loopIdx = AscendC::GetBlockIdx(); loopIdx < loops; loopIdx += aivNum) {
+            uint32_t actualLength = (loopIdx == loops - 1) ?
+                static_cast<uint32_t>(combineCount - loopIdx * CLEAR_LENGTH) : CLEAR_LENGTH;
+            AscendC::DataCopyExtParams dataCopyParams(1, actualLength * sizeof(ElementCombine), 0, 0, 0);
+            AscendC::DataCopyPad(gmCombine[loopIdx * CLEAR_LENGTH], ubZero, dataCopyParams);
+        }
+        // The UB buffer is handed to the epilogue
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID0);
+    }
+
+    CATLASS_DEVICE
+    void Combine(Params const &params, __gm__ ElementCombine *ptrCombine)
+    {
+        BlockScheduler blockScheduler;
+        BlockEpilogue blockEpilogue(resource);
+
+        uint32_t coreIdx = AscendC::GetBlockIdx() / AscendC::GetSubBlockNum();
+        uint32_t coreNum = AscendC::GetBlockNum();
+        int64_t gmGroupOffsetRow = 0;
+        int64_t gmGroupOffsetC = 0;
+        int64_t gmGroupOffsetScale = 0;
+
+        AscendC::GlobalTensor<ElementC> gmC;
+        gmC.SetGlobalBuffer(reinterpret_cast<__gm__ ElementC *>(params.ptrWorkspace));
+        AscendC::GlobalTensor<ElementGroupList> groupList;
+        groupList.SetGlobalBuffer(params.ptrGroupList);
+
+        AivWaitSync aicFinishSync{this};
+        uint32_t startCoreIdx = 0;
+        for (uint32_t groupIdx = 0; groupIdx < params.problemCount; ++groupIdx) {
+            uint32_t currentM = (groupIdx == 0) ? groupList.GetValue(groupIdx) :
+                (groupList.GetValue(groupIdx) - groupList.GetValue(groupIdx - 1));
+            GemmCoord inGroupProblemShape{currentM, params.problemShape.n(), params.problemShape.k()};
+
+            LayoutC layoutC = LayoutC(inGroupProblemShape.m(), inGroupProblemShape.n());
+
+            // The per token scale and the combine buffer are indexed by token and are not sliced by group
+            EpilogueParams epilogueParams{
+                params.ptrScale + gmGroupOffsetScale, params.layoutScale,
+                params.ptrPerTokenScale, params.layoutPerTokenScale,
+                params.ptrTokenIndex + gmGroupOffsetRow, params.ptrRoutingWeight + gmGroupOffsetRow,
+                ptrCombine, params.layoutD
+            };
+
+            blockScheduler.Update(inGroupProblemShape, L1TileShape::ToCoordMN());
+            blockEpilogue.UpdateParams(epilogueParams);
+            uint32_t coreLoops = blockScheduler.GetCoreLoops();
+
+            GemmCoord blockShapeMNK = L1TileShape::ToCoord();
+            uint32_t startLoopIdx = ((coreIdx < startCoreIdx) ? (coreIdx + coreNum) : coreIdx) - startCoreIdx;
+            for (uint32_t loopIdx = startLoopIdx; loopIdx < coreLoops; loopIdx += coreNum) {
+                GemmCoord blockCoordMNK = blockScheduler.GetBlockCoord(loopIdx);
+                GemmCoord actualBlockShapeMNK = blockScheduler.GetActualBlockShape(blockCoordMNK);
+
+                int64_t gmInGroupOffsetC = layoutC.GetOffset(blockCoordMNK.GetCoordMN() * blockShapeMNK.GetCoordMN());
+                auto gmBlockC = gmC[gmGroupOffsetC + gmInGroupOffsetC];
+                auto layoutBlockC = layoutC.GetTileLayout(actualBlockShapeMNK.GetCoordMN());
+
+                blockEpilogue(
+                    blockShapeMNK, blockCoordMNK,
+                    actualBlockShapeMNK, gmBlockC,
+                    layoutBlockC, MakeCallback(&aicFinishSync)
+                );
+            }
+
+            gmGroupOffsetRow += inGroupProblemShape.m();
+            gmGroupOffsetC += inGroupProblemShape.m() * inGroupProblemShape.n();
+            gmGroupOffsetScale += inGroupProblemShape.n();
+
+            startCoreIdx = (startCoreIdx + coreLoops) % coreNum;
+        }
+    }
+
+    static constexpr Arch::FlagID FLAG_AIC_FINISH_STORE = 0;
+    static constexpr Arch::FlagID RV_FLAG_AIC_FINISH_STORE = 1;
+    Arch::CrossCoreFlagWithReverse<> flagAicFinishStore{FLAG_AIC_FINISH_STORE, RV_FLAG_AIC_FINISH_STORE};
+    Arch::Resource<ArchTag> resource;
+};
+
+} // namespace Catlass::Gemm::Kernel
+
+#endif // CATLASS_GEMM_KERNEL_GROUPED_MATMUL_M_PER_TOKEN_DEQUANT_MOE_HPP
@@ -0,0 +1,241 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMM_KERNEL_GROUPED_MATMUL_M_TASK_TABLE_HPP
+#define CATLASS_GEMM_KERNEL_GROUPED_MATMUL_M_TASK_TABLE_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/coord.hpp"
+#include "catlass/gemm/block/block_swizzle.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/matrix_coord.hpp"
+
+inline __gm__ struct OpSystemRunCfg g_opSystemRunCfg{Catlass::L2_OFFSET};
+
+namespace Catlass::Gemm::Kernel {
+
+// Template for grouped matmul kernel split along m, scheduled by a task table. Compute grouped C = A * B
+// The table is built on the host by Block::GroupedMatmulTaskTable<BlockScheduler>::Build from the same group list.
+// Each core walks its range of tasks and finds the group of its first task by binary search. After that it moves
+// to the next group by walking the group offsets forward, reading the entry of each empty group it passes.
+template <
+    class BlockMmad_,
+    class BlockEpilogue_,
+    class BlockScheduler_,
+    class ElementGroupList_
+>
+class GroupedMatmulSliceMTaskTable {
+public:
+    using BlockMmad = BlockMmad_;
+    using ArchTag = typename BlockMmad::ArchTag;
+    using L1TileShape = typename BlockMmad::L1TileShape;
+    using ElementA = typename BlockMmad::ElementA;
+    using LayoutA = typename BlockMmad::LayoutA;
+    using ElementB = typename BlockMmad::ElementB;
+    using LayoutB = typename BlockMmad::LayoutB;
+    using ElementC = typename BlockMmad::ElementC;
+    using LayoutC = typename BlockMmad::LayoutC;
+    using ElementAccumulator = typename BlockMmad::ElementAccumulator;
+
+    using ElementGroupList = ElementGroupList_;
+
+    using BlockScheduler = BlockScheduler_;
+    using TaskTable = Block::GroupedMatmulTaskTable<BlockScheduler>;
+
+    /// Parameters structure
+    struct Params {
+        // Data members
+        GemmCoord problemShape;
+        uint32_t problemCount;
+        __gm__ ElementGroupList *ptrGroupList;
+        __gm__ uint32_t *ptrTaskTable;
+        __gm__ ElementA *ptrA;
+        LayoutA layoutA;
+        __gm__ ElementB *ptrB;
+        LayoutB layoutB;
+        __gm__ ElementC *ptrC;
+        LayoutC layoutC;
+
+        // Methods
+        CATLASS_HOST_DEVICE
+        Params() {}
+
+        CATLASS_HOST_DEVICE
+        Params(
+            GemmCoord const &problemShape_, uint32_t problemCount_, GM_ADDR ptrGroupList_, GM_ADDR ptrTaskTable_,
+            GM_ADDR ptrA_, LayoutA const &layoutA_,
+            GM_ADDR ptrB_, LayoutB const &layoutB_,
+            GM_ADDR ptrC_, LayoutC const &layoutC_
+        ) : problemShape(problemShape_),
+            problemCount(problemCount_), ptrGroupList(reinterpret_cast<__gm__ ElementGroupList *>(ptrGroupList_)),
+            ptrTaskTable(reinterpret_cast<__gm__ uint32_t *>(ptrTaskTable_)),
+            ptrA(reinterpret_cast<__gm__ ElementA *>(ptrA_)), layoutA(layoutA_),
+            ptrB(reinterpret_cast<__gm__ ElementB *>(ptrB_)), layoutB(layoutB_),
+            ptrC(reinterpret_cast<__gm__ ElementC *>(ptrC_)), layoutC(layoutC_)
+        {
+        }
+    };
+    struct Arguments{
+        GemmCoord problemShape;
+        uint32_t problemCount;
+        uint8_t *ptrGroupList;
+        uint8_t *ptrTaskTable;
+        uint8_t *ptrA;
+        uint8_t *ptrB;
+        uint8_t *ptrC;
+    };
+    static bool CanImplement(const Arguments &args)
+    {
+        return args.ptrTaskTable != nullptr;
+    }
+    static size_t GetWorkspaceSize(const Arguments &args)
+    {
+        return 0;
+    }
+    static Params ToUnderlyingArguments(const Arguments &args, void* workspace)
+    {
+        uint32_t m = args.problemShape.m();
+        uint32_t n = args.problemShape.n();
+        uint32_t k = args.problemShape.k();
+        LayoutA layoutA{m, k};
+        LayoutB layoutB{k, n};
+        LayoutC layoutC{m, n};
+        Params params{args.problemShape, args.problemCount, args.ptrGroupList, args.ptrTaskTable,
+            args.ptrA, layoutA,
+            args.ptrB, layoutB,
+            args.ptrC, layoutC};
+        return params;
+    }
+    // Methods
+    CATLASS_HOST_DEVICE
+    GroupedMatmulSliceMTaskTable() {}
+    // Methods
+    CATLASS_HOST_DEVICE
+    ~GroupedMatmulSliceMTaskTable(){}
+
+    template <int32_t CORE_TYPE = g_coreType>
+    CATLASS_DEVICE
+    void operator()(Params const &params);
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIC>(Params const &params)
+    {
+        BlockScheduler blockScheduler;
+        Arch::Resource<ArchTag> resource;
+        BlockMmad blockMmad(resource);
+
+        // Represent the full gm
+        AscendC::GlobalTensor<ElementA> gmA;
+        gmA.SetGlobalBuffer(params.ptrA);
+        AscendC::GlobalTensor<ElementC> gmC;
+        gmC.SetGlobalBuffer(params.ptrC);
+        AscendC::GlobalTensor<ElementGroupList> groupList;
+        groupList.SetGlobalBuffer(params.ptrGroupList);
+        AscendC::GlobalTensor<uint32_t> taskTable;
+        taskTable.SetGlobalBuffer(params.ptrTaskTable);
+
+        uint32_t coreIdx = AscendC::GetBlockIdx();
+        uint32_t coreNum = AscendC::GetBlockNum();
+        // the table may be cut for another number of cores, take its ranges round-robin
+        uint32_t tableCoreNum = taskTable.GetValue(0);
+        for (uint32_t rangeIdx = coreIdx; rangeIdx < tableCoreNum; rangeIdx += coreNum) {
+            uint32_t taskBegin = taskTable.GetValue(TaskTable::GetCoreOffsetIdx(rangeIdx));
+            uint32_t taskEnd = taskTable.GetValue(TaskTable::GetCoreOffsetIdx(rangeIdx + 1));
+            if (taskBegin >= taskEnd) {
+                continue;
+            }
+
+            uint32_t groupIdx = 0;
+            uint32_t groupTaskBegin = taskBegin;
+            uint32_t groupTaskEnd = taskBegin;
+            int64_t groupMBegin = 0;
+            int64_t groupMEnd = 0;
+            int64_t gmGroupOffsetA = 0;
+            int64_t gmGroupOffsetC = 0;
+            LayoutA layoutA = params.layoutA;
+            LayoutB layoutB = params.layoutB;
+            LayoutC layoutC = params.layoutC;
+            AscendC::GlobalTensor<ElementB> gmB;
+
+            for (uint32_t taskIdx = taskBegin; taskIdx < taskEnd; ++taskIdx) {
+                if (taskIdx >= groupTaskEnd) {
+                    // enter the next group holding tasks, empty groups share their first task with it
+                    if (taskIdx == taskBegin) {
+                        groupIdx = TaskTable::FindGroup(taskTable, tableCoreNum, params.problemCount, taskIdx);
+                        groupTaskBegin = taskTable.GetValue(TaskTable::GetGroupOffsetIdx(tableCoreNum, groupIdx));
+                        groupTaskEnd = taskTable.GetValue(TaskTable::GetGroupOffsetIdx(tableCoreNum, groupIdx + 1));
+                        groupMBegin = (groupIdx == 0) ? 0 : groupList.GetValue(groupIdx - 1);
+                    } else {
+                        groupIdx =
+                            TaskTable::NextGroup(taskTable, tableCoreNum, groupIdx, groupTaskBegin, groupTaskEnd);
+                        // the skipped groups are empty, the new group starts where the previous one ended
+                        groupMBegin = groupMEnd;
+                    }
+                    groupMEnd = groupList.GetValue(groupIdx);
+                    uint32_t currentM = static_cast<uint32_t>(groupMEnd - groupMBegin);
+                    GemmCoord inGroupProblemShape{currentM, params.problemShape.n(), params.problemShape.k()};
+
+                    layoutA = params.layoutA.GetTileLayout(inGroupProblemShape.GetCoordMK());
+                    layoutC = params.layoutC.GetTileLayout(inGroupProblemShape.GetCoordMN());
+                    gmGroupOffsetA = groupMBegin * params.problemShape.k();
+                    gmGroupOffsetC = groupMBegin * params.problemShape.n();
+
+                    blockScheduler.Update(inGroupProblemShape, MakeCoord(L1TileShape::M, L1TileShape::N));
+
+                    gmB.SetGlobalBuffer(params.ptrB +
+                        static_cast<int64_t>(groupIdx) * params.problemShape.k() * params.problemShape.n());
+                    if (CeilDiv(currentM, L1TileShape::M) == 1) {
+                        gmB.SetL2CacheHint(AscendC::CacheMode::CACHE_MODE_DISABLE);
+                    } else {
+                        gmB.SetL2CacheHint(AscendC::CacheMode::CACHE_MODE_NORMAL);
+                    }
+                }
+
+                // Compute block location
+                GemmCoord blockCoord = blockScheduler.GetBlockCoord(taskIdx - groupTaskBegin);
+                GemmCoord actualBlockShape = blockScheduler.GetActualBlockShape(blockCoord);
+
+                // Compute initial location in logical coordinates
+                MatrixCoord offsetA{blockCoord.m() * L1TileShape::M, blockCoord.k() * L1TileShape::K};
+                MatrixCoord offsetB{blockCoord.k() * L1TileShape::K, blockCoord.n() * L1TileShape::N};
+                MatrixCoord offsetC{blockCoord.m() * L1TileShape::M, blockCoord.n() * L1TileShape::N};
+                int64_t gmOffsetA = layoutA.GetOffset(offsetA);
+                int64_t gmOffsetB = layoutB.GetOffset(offsetB);
+                int64_t gmOffsetC = layoutC.GetOffset(offsetC);
+
+                // Compute block-scoped matrix multiply-add
+                blockMmad(
+                    gmA[gmGroupOffsetA + gmOffsetA], layoutA,
+                    gmB[gmOffsetB], layoutB,
+                    gmC[gmGroupOffsetC + gmOffsetC], layoutC,
+                    actualBlockShape
+                );
+            }
+        }
+
+        if constexpr (BlockMmad::DispatchPolicy::ASYNC) {
+            blockMmad.SynchronizeBlock();
+        }
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIV>(Params const &params)
+    {
+    }
+};
+
+} // namespace Catlass::Gemm::Kernel
+
+#endif // CATLASS_GEMM_KERNEL_GROUPED_MATMUL_M_TASK_TABLE_HPP
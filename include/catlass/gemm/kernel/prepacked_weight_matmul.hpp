@@ -0,0 +1,186 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMM_KERNEL_PREPACKED_WEIGHT_MATMUL_HPP
+#define CATLASS_GEMM_KERNEL_PREPACKED_WEIGHT_MATMUL_HPP
+
+#include <type_traits>
+
+#include "catlass/catlass.hpp"
+#include "catlass/coord.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/matrix_coord.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/layout/layout.hpp"
+
+namespace Catlass::Gemm::Kernel {
+
+// W4A8 and W8A16 matmul on a B packed offline, see examples/common/weight_prepack.hpp.
+// B is already int8 (W4A8) or fp16 (W8A16) in the zN or nZ layout it has in L1, so there is no AIV prologue, no
+// workspace and no cross core flag. BlockMmad is the MmadAtlasA2PingPongWithPrologue block without prologues, with
+// TileCopyWithPrologueDeqPerTensor the int32 accumulator of W4A8 is scaled by Arguments::scalar on its way out of
+// L0C, as in W4A8Matmul.
+template <
+    class BlockMmad_,
+    class BlockScheduler_
+>
+class PrepackedWeightMatmul {
+public:
+    using BlockMmad = BlockMmad_;
+    using ArchTag = typename BlockMmad::ArchTag;
+    using ElementA = typename BlockMmad::ElementA;
+    using LayoutA = typename BlockMmad::LayoutA;
+    using ElementB = typename BlockMmad::ElementB;
+    using LayoutB = typename BlockMmad::LayoutB;
+    using ElementC = typename BlockMmad::ElementC;
+    using LayoutC = typename BlockMmad::LayoutC;
+
+    using L1TileShape = typename BlockMmad::L1TileShape;
+    using MmadParams = typename BlockMmad::Params;
+    using CopyL0CToGmParams = typename BlockMmad::CopyL0CToGm::Params;
+
+    using BlockScheduler = BlockScheduler_;
+
+    static_assert(!BlockMmad::HAS_PROLOGUE_A && !BlockMmad::HAS_PROLOGUE_B,
+        "A prepacked B is consumed as it is, the block must not have a prologue");
+    static_assert(std::is_same_v<LayoutB, layout::zN> || std::is_same_v<LayoutB, layout::nZ>,
+        "A prepacked B is in zN or nZ layout");
+
+    /// Parameters structure
+    struct Params {
+        // Data members
+        GemmCoord problemShape;
+        GM_ADDR ptrA;
+        LayoutA layoutA;
+        GM_ADDR ptrB;
+        LayoutB layoutB;
+        GM_ADDR ptrC;
+        LayoutC layoutC;
+
+        MmadParams mmadParams;
+
+        // Methods
+        CATLASS_HOST_DEVICE
+        Params() {}
+
+        CATLASS_HOST_DEVICE
+        Params(
+            GemmCoord const &problemShape_,
+            GM_ADDR ptrA_, LayoutA const &layoutA_,
+            GM_ADDR ptrB_, LayoutB const &layoutB_,
+            GM_ADDR ptrC_, LayoutC const &layoutC_,
+            MmadParams const &mmadParams_
+        ):  problemShape(problemShape_),
+            ptrA(ptrA_), layoutA(layoutA_),
+            ptrB(ptrB_), layoutB(layoutB_),
+            ptrC(ptrC_), layoutC(layoutC_),
+            mmadParams(mmadParams_) {}
+    };
+
+    struct Arguments {
+        GemmCoord problemShape;
+        GM_ADDR deviceA;
+        LayoutA layoutA;
+        GM_ADDR deviceB;
+        LayoutB layoutB;
+        GM_ADDR deviceC;
+        LayoutC layoutC;
+        // dequant scale of the accumulator, used when the block dequantizes per tensor
+        float scalar{1.0f};
+    };
+
+    static bool CanImplement(const Arguments &args)
+    {
+        return args.layoutB.orgShape(0) == args.problemShape.k() &&
+            args.layoutB.orgShape(1) == args.problemShape.n();
+    }
+
+    static size_t GetWorkspaceSize(Arguments const &args)
+    {
+        return 0;
+    }
+
+    static Params ToUnderlyingArguments(const Arguments &args, uint8_t *workspace)
+    {
+        MmadParams mmadParams{};
+        if constexpr (std::is_constructible_v<CopyL0CToGmParams, float>) {
+            mmadParams.copyL0CToGm = CopyL0CToGmParams(args.scalar);
+        }
+        Params params{
+            args.problemShape,
+            args.deviceA, args.layoutA,
+            args.deviceB, args.layoutB,
+            args.deviceC, args.layoutC,
+            mmadParams
+        };
+        return params;
+    }
+
+    // Methods
+    CATLASS_DEVICE
+    PrepackedWeightMatmul() {}
+
+    template <int32_t CORE_TYPE = g_coreType>
+    CATLASS_DEVICE
+    void operator()(Params const &params);
+
+    /// Executes matmul
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIC>(Params const &params)
+    {
+        BlockMmad blockMmad(resource, params.mmadParams);
+
+        GemmCoord blockShape = L1TileShape::ToCoord();
+        BlockScheduler matmulBlockScheduler(params.problemShape, blockShape.GetCoordMN());
+        uint32_t coreLoops = matmulBlockScheduler.GetCoreLoops();
+
+        AscendC::GlobalTensor<ElementA> gmA;
+        gmA.SetGlobalBuffer(reinterpret_cast<__gm__ ElementA *>(params.ptrA));
+        AscendC::GlobalTensor<ElementB> gmB;
+        gmB.SetGlobalBuffer(reinterpret_cast<__gm__ ElementB *>(params.ptrB));
+        AscendC::GlobalTensor<ElementC> gmC;
+        gmC.SetGlobalBuffer(reinterpret_cast<__gm__ ElementC *>(params.ptrC));
+
+        for (uint32_t loopIdx = AscendC::GetBlockIdx(); loopIdx < coreLoops; loopIdx += AscendC::GetBlockNum()) {
+            auto blockIdxCoord = matmulBlockScheduler.GetBlockCoord(loopIdx);
+            auto actualBlockShape = matmulBlockScheduler.GetActualBlockShape(blockIdxCoord);
+            GemmCoord offsetCoord = blockIdxCoord * blockShape;
+
+            auto gmBlockA = gmA[params.layoutA.GetOffset(offsetCoord.GetCoordMK())];
+            auto layoutBlockA = params.layoutA.GetTileLayout(actualBlockShape.GetCoordMK());
+            // block offsets are whole fractals, the tile keeps the strides of the packed B
+            auto gmBlockB = gmB[params.layoutB.GetOffset(offsetCoord.GetCoordKN())];
+            auto layoutBlockB = params.layoutB.GetTileLayout(actualBlockShape.GetCoordKN());
+            auto gmBlockC = gmC[params.layoutC.GetOffset(offsetCoord.GetCoordMN())];
+            auto layoutBlockC = params.layoutC.GetTileLayout(actualBlockShape.GetCoordMN());
+
+            blockMmad(
+                gmBlockA, layoutBlockA,
+                gmBlockB, layoutBlockB,
+                gmBlockC, layoutBlockC,
+                actualBlockShape
+            );
+        }
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIV>(Params const &params) {}
+
+private:
+    Arch::Resource<ArchTag> resource;
+};
+
+} // namespace Catlass::Gemm::Kernel
+
+#endif // CATLASS_GEMM_KERNEL_PREPACKED_WEIGHT_MATMUL_HPP
@@ -0,0 +1,404 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMM_KERNEL_STREAMK_MATMUL_HPP
+#define CATLASS_GEMM_KERNEL_STREAMK_MATMUL_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/arch/cross_core_sync.hpp"
+#include "catlass/coord.hpp"
+#include "catlass/detail/alignment.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/matrix_coord.hpp"
+
+namespace Catlass::Gemm::Kernel {
+
+// Adds the partial sums of the cores sharing a stream-k tile to the owner's accumulator and casts the sum to C,
+// rows of the tile at a time.
+template<
+    class ArchTag_,
+    class ElementAccumulator_,
+    class ElementOut_,
+    uint32_t COMPUTE_LENGTH
+>
+struct StreamkFixup {
+    using ArchTag = ArchTag_;
+    using ElementAccumulator = ElementAccumulator_;
+    using ElementOut = ElementOut_;
+
+    static_assert(sizeof(ElementOut) <= sizeof(ElementAccumulator), "ElementOut is wider than ElementAccumulator!");
+
+    static constexpr uint32_t ELE_NUM_PER_BLK = BYTE_PER_BLK / sizeof(ElementAccumulator);
+    // rows in the ub are padded so that both the accumulator and the cast rows are 32 byte aligned
+    static constexpr uint32_t ROW_ALIGN = BYTE_PER_BLK / sizeof(ElementOut);
+
+    CATLASS_DEVICE
+    StreamkFixup(Arch::Resource<ArchTag> &resource)
+    {
+        accumulatorBuffer = resource.ubBuf.template GetBufferByByte<ElementAccumulator>(0);
+        inputBuffer = resource.ubBuf.template GetBufferByByte<ElementAccumulator>(
+            COMPUTE_LENGTH * sizeof(ElementAccumulator));
+        outputBuffer = resource.ubBuf.template GetBufferByByte<ElementOut>(
+            2 * COMPUTE_LENGTH * sizeof(ElementAccumulator));
+    }
+
+    /// Rows of a tile with tileN columns fixed up in one pass
+    CATLASS_HOST_DEVICE
+    static uint32_t GetRowsPerPass(uint32_t tileN)
+    {
+        return COMPUTE_LENGTH / RoundUp(tileN, ROW_ALIGN);
+    }
+
+    CATLASS_DEVICE
+    void Gm2Ub(AscendC::LocalTensor<ElementAccumulator> const &dst,
+        AscendC::GlobalTensor<ElementAccumulator> const &src,
+        uint32_t rows, uint32_t cols, uint32_t ldSrc)
+    {
+        uint32_t dstStride = (RoundUp(cols, ROW_ALIGN) - RoundUp(cols, ELE_NUM_PER_BLK)) / ELE_NUM_PER_BLK;
+        AscendC::DataCopyExtParams dataCopyParams(
+            rows, cols * sizeof(ElementAccumulator), (ldSrc - cols) * sizeof(ElementAccumulator), dstStride, 0);
+        AscendC::DataCopyPadExtParams<ElementAccumulator> padParams(false, 0, 0, 0);
+        AscendC::DataCopyPad(dst, src, dataCopyParams, padParams);
+    }
+
+    CATLASS_DEVICE
+    void Ub2Gm(AscendC::GlobalTensor<ElementOut> const &dst,
+        AscendC::LocalTensor<ElementOut> const &src,
+        uint32_t rows, uint32_t cols, uint32_t ldDst)
+    {
+        AscendC::DataCopyExtParams dataCopyParams(
+            rows, cols * sizeof(ElementOut), 0, (ldDst - cols) * sizeof(ElementOut), 0);
+        AscendC::DataCopyPad(dst, src, dataCopyParams);
+    }
+
+    /// dst = cast(owner + partials[0] + ... + partials[partialNum - 1]), all of rows x cols. Row i of dst starts at
+    /// dst[i * ldDst], the owner's accumulator is compact and partial j is compact at partials[j * partialStride].
+    CATLASS_DEVICE
+    void operator()(
+        AscendC::GlobalTensor<ElementOut> const &dst, uint32_t ldDst,
+        AscendC::GlobalTensor<ElementAccumulator> const &owner,
+        AscendC::GlobalTensor<ElementAccumulator> const &partials, uint64_t partialStride, uint32_t partialNum,
+        uint32_t rows, uint32_t cols)
+    {
+        uint32_t elementCount = rows * RoundUp(cols, ROW_ALIGN);
+
+        Gm2Ub(accumulatorBuffer, owner, rows, cols, cols);
+        for (uint32_t partialIdx = 0; partialIdx < partialNum; ++partialIdx) {
+            Gm2Ub(inputBuffer, partials[partialIdx * partialStride], rows, cols, cols);
+            AscendC::SetFlag<AscendC::HardEvent::MTE2_V>(EVENT_ID0);
+            AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>(EVENT_ID0);
+            AscendC::Add(accumulatorBuffer, accumulatorBuffer, inputBuffer, elementCount);
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID0);
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(EVENT_ID0);
+        }
+        AscendC::SetFlag<AscendC::HardEvent::MTE2_V>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>(EVENT_ID0);
+        AscendC::PipeBarrier<PIPE_V>();
+
+        if constexpr (!std::is_same_v<ElementAccumulator, ElementOut>) {
+            if constexpr (std::is_same_v<ElementOut, half>) {
+                AscendC::Cast(outputBuffer, accumulatorBuffer, AscendC::RoundMode::CAST_NONE, elementCount);
+            } else {
+                AscendC::Cast(outputBuffer, accumulatorBuffer, AscendC::RoundMode::CAST_RINT, elementCount);
+            }
+        } else {
+            AscendC::DataCopy(outputBuffer, accumulatorBuffer, elementCount);
+        }
+
+        AscendC::SetFlag<AscendC::HardEvent::V_MTE3>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE3>(EVENT_ID0);
+        Ub2Gm(dst, outputBuffer, rows, cols, ldDst);
+        // the next pass overwrites the ub buffers
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(EVENT_ID0);
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID0);
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_V>(EVENT_ID0);
+    }
+
+private:
+    AscendC::LocalTensor<ElementAccumulator> accumulatorBuffer;
+    AscendC::LocalTensor<ElementAccumulator> inputBuffer;
+    AscendC::LocalTensor<ElementOut> outputBuffer;
+    static_assert(COMPUTE_LENGTH * (2 * sizeof(ElementAccumulator) + sizeof(ElementOut)) <= ArchTag::UB_SIZE,
+        "Excedding the UB space!");
+};
+
+// Template for Stream-K Matmul kernel. Compute C = A * B
+//
+// The aic computes the data parallel tiles planned by BlockScheduler straight into C with BlockMmad. The stream-k
+// segments are computed with BlockMmadPartial, which writes ElementAccumulator: the owner of a tile into its
+// accumulator slot in the workspace, the other segments into per core partial slots behind them. Then the aiv add
+// the partial slots to the owners' accumulators and cast the sums to C. The workspace only holds the stream-k tiles,
+// without them the kernel needs no workspace and the aiv do nothing.
+// The kernel must be launched on the aicCoreNum cores given in the Arguments.
+template <
+    class BlockMmad_,
+    class BlockMmadPartial_,
+    class BlockEpilogue_,
+    class BlockScheduler_,
+    class StreamkFixup_
+>
+class StreamkMatmul {
+public:
+    using BlockMmad = BlockMmad_;
+    using BlockMmadPartial = BlockMmadPartial_;
+    using ArchTag = typename BlockMmad::ArchTag;
+    using L1TileShape = typename BlockMmad::L1TileShape;
+    using ElementA = typename BlockMmad::ElementA;
+    using LayoutA = typename BlockMmad::LayoutA;
+    using ElementB = typename BlockMmad::ElementB;
+    using LayoutB = typename BlockMmad::LayoutB;
+    using ElementC = typename BlockMmad::ElementC;
+    using LayoutC = typename BlockMmad::LayoutC;
+    using ElementAccumulator = typename BlockMmadPartial::ElementC;
+
+    using BlockScheduler = BlockScheduler_;
+    using StreamkFixup = StreamkFixup_;
+
+    static_assert(std::is_same_v<LayoutC, layout::RowMajor>, "The partial slots of StreamkMatmul are row major!");
+    static_assert(std::is_same_v<typename BlockMmadPartial::LayoutC, LayoutC> &&
+        std::is_same_v<typename BlockMmadPartial::L1TileShape, L1TileShape>,
+        "BlockMmadPartial must differ from BlockMmad in ElementC only!");
+    static_assert(std::is_same_v<typename StreamkFixup::ElementAccumulator, ElementAccumulator> &&
+        std::is_same_v<typename StreamkFixup::ElementOut, ElementC>,
+        "StreamkFixup must add ElementC of BlockMmadPartial and write ElementC of BlockMmad!");
+
+    /// Parameters structure
+    struct Params {
+        // Data members
+        GemmCoord problemShape;
+        GM_ADDR ptrA;
+        LayoutA layoutA;
+        GM_ADDR ptrB;
+        LayoutB layoutB;
+        GM_ADDR ptrC;
+        LayoutC layoutC;
+        GM_ADDR ptrWorkspace;
+        uint32_t aicCoreNum = 1;
+
+        // Methods
+        CATLASS_HOST_DEVICE
+        Params() {}
+
+        CATLASS_HOST_DEVICE
+        Params(GemmCoord const &problemShape_, GM_ADDR ptrA_, LayoutA layoutA_, GM_ADDR ptrB_,
+               LayoutB layoutB_, GM_ADDR ptrC_, LayoutC layoutC_, GM_ADDR ptrWorkspace_, uint32_t aicCoreNum_)
+            : problemShape(problemShape_), ptrA(ptrA_), layoutA(layoutA_), ptrB(ptrB_), layoutB(layoutB_),
+              ptrC(ptrC_), layoutC(layoutC_), ptrWorkspace(ptrWorkspace_), aicCoreNum(aicCoreNum_) {}
+    };
+
+    struct Arguments {
+        GemmCoord problemShape;
+        uint32_t aicCoreNum;
+        GM_ADDR ptrA;
+        GM_ADDR ptrB;
+        GM_ADDR ptrC;
+    };
+
+    static bool CanImplement(const Arguments &args)
+    {
+        return args.aicCoreNum > 0;
+    }
+
+    /// One tile sized slot per stream-k tile for the owners' accumulators, one per stream-k core for the partials
+    static size_t GetWorkspaceSize(const Arguments &args)
+    {
+        BlockScheduler matmulBlockScheduler(args.problemShape,
+            GemmCoord(L1TileShape::M, L1TileShape::N, L1TileShape::K), args.aicCoreNum);
+        size_t slotNum = static_cast<size_t>(matmulBlockScheduler.GetSkTileNum())
+            + matmulBlockScheduler.GetSkCoreNum();
+        return sizeof(ElementAccumulator) * slotNum * L1TileShape::M * L1TileShape::N;
+    }
+
+    static Params ToUnderlyingArguments(const Arguments &args, uint8_t *workspace)
+    {
+        LayoutA layoutA{args.problemShape.m(), args.problemShape.k()};
+        LayoutB layoutB{args.problemShape.k(), args.problemShape.n()};
+        LayoutC layoutC{args.problemShape.m(), args.problemShape.n()};
+        Params params{
+            args.problemShape,
+            args.ptrA,
+            layoutA,
+            args.ptrB,
+            layoutB,
+            args.ptrC,
+            layoutC,
+            workspace,
+            args.aicCoreNum};
+        return params;
+    }
+
+    // Methods
+    CATLASS_DEVICE
+    StreamkMatmul() {}
+
+    template <int32_t CORE_TYPE = g_coreType>
+    CATLASS_DEVICE
+    void operator()(Params const &params);
+
+    /// Executes one Matmul
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIC>(Params const &params)
+    {
+        BlockScheduler matmulBlockScheduler(params.problemShape,
+            GemmCoord(L1TileShape::M, L1TileShape::N, L1TileShape::K), params.aicCoreNum);
+        uint32_t coreLoops = matmulBlockScheduler.GetCoreLoops();
+        uint32_t skTileNum = matmulBlockScheduler.GetSkTileNum();
+        uint32_t coreIdx = AscendC::GetBlockIdx();
+
+        Arch::Resource<ArchTag> resource;
+
+        // Represent the full gm
+        AscendC::GlobalTensor<ElementA> gmA;
+        gmA.SetGlobalBuffer((__gm__ ElementA *)params.ptrA);
+        AscendC::GlobalTensor<ElementB> gmB;
+        gmB.SetGlobalBuffer((__gm__ ElementB *)params.ptrB);
+        AscendC::GlobalTensor<ElementC> gmC;
+        gmC.SetGlobalBuffer((__gm__ ElementC *)params.ptrC);
+
+        // Data parallel tiles, scoped as the two block mmads share the L1 and L0 buffers and their event ids
+        {
+            BlockMmad blockMmad(resource);
+            for (uint32_t loopIdx = coreIdx; loopIdx < coreLoops; loopIdx += params.aicCoreNum) {
+                // Compute block location
+                GemmCoord blockCoord = matmulBlockScheduler.GetBlockCoord(loopIdx);
+                GemmCoord actualBlockShape = matmulBlockScheduler.GetActualBlockShape(blockCoord);
+
+                // Compute initial location in logical coordinates
+                MatrixCoord offsetA{blockCoord.m() * L1TileShape::M, blockCoord.k() * L1TileShape::K};
+                MatrixCoord offsetB{blockCoord.k() * L1TileShape::K, blockCoord.n() * L1TileShape::N};
+                MatrixCoord offsetC{blockCoord.m() * L1TileShape::M, blockCoord.n() * L1TileShape::N};
+                int64_t gmOffsetA = params.layoutA.GetOffset(offsetA);
+                int64_t gmOffsetB = params.layoutB.GetOffset(offsetB);
+                int64_t gmOffsetC = params.layoutC.GetOffset(offsetC);
+
+                // Compute block-scoped matrix multiply-add
+                blockMmad(gmA[gmOffsetA], params.layoutA,
+                          gmB[gmOffsetB], params.layoutB,
+                          gmC[gmOffsetC], params.layoutC,
+                          actualBlockShape);
+            }
+        }
+
+        if (skTileNum == 0) {
+            AscendC::PipeBarrier<PIPE_ALL>();
+            return;
+        }
+
+        // Stream-k segments, the owner of a tile writes its accumulator slot, the others their partial slot
+        {
+            BlockMmadPartial blockMmadPartial(resource);
+            uint64_t slotSize = static_cast<uint64_t>(L1TileShape::M) * L1TileShape::N;
+            AscendC::GlobalTensor<ElementAccumulator> gmAccumulator;
+            gmAccumulator.SetGlobalBuffer((__gm__ ElementAccumulator *)params.ptrWorkspace);
+            AscendC::GlobalTensor<ElementAccumulator> gmPartial;
+            gmPartial.SetGlobalBuffer((__gm__ ElementAccumulator *)params.ptrWorkspace + skTileNum * slotSize);
+
+            uint32_t segmentNum = matmulBlockScheduler.GetSkSegmentNum(coreIdx);
+            for (uint32_t segmentIdx = 0; segmentIdx < segmentNum; ++segmentIdx) {
+                auto segment = matmulBlockScheduler.GetSkSegment(coreIdx, segmentIdx);
+                GemmCoord blockCoord = matmulBlockScheduler.GetBlockCoord(segment);
+                GemmCoord actualBlockShape = matmulBlockScheduler.GetActualBlockShape(blockCoord, segment);
+
+                MatrixCoord offsetA{blockCoord.m() * L1TileShape::M, blockCoord.k() * L1TileShape::K};
+                MatrixCoord offsetB{blockCoord.k() * L1TileShape::K, blockCoord.n() * L1TileShape::N};
+                int64_t gmOffsetA = params.layoutA.GetOffset(offsetA);
+                int64_t gmOffsetB = params.layoutB.GetOffset(offsetB);
+
+                LayoutC layoutSlot{actualBlockShape.m(), actualBlockShape.n()};
+                if (segment.kTileBegin == 0) {
+                    uint64_t gmOffsetSlot = (segment.taskIdx - coreLoops) * slotSize;
+                    blockMmadPartial(gmA[gmOffsetA], params.layoutA,
+                                     gmB[gmOffsetB], params.layoutB,
+                                     gmAccumulator[gmOffsetSlot], layoutSlot,
+                                     actualBlockShape);
+                } else {
+                    uint64_t gmOffsetSlot = coreIdx * slotSize;
+                    blockMmadPartial(gmA[gmOffsetA], params.layoutA,
+                                     gmB[gmOffsetB], params.layoutB,
+                                     gmPartial[gmOffsetSlot], layoutSlot,
+                                     actualBlockShape);
+                }
+            }
+        }
+
+        Catlass::Arch::CrossCoreSetFlag<0x2, PIPE_FIX>(flagAicFinish);
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIV>(Params const &params)
+    {
+        BlockScheduler matmulBlockScheduler(params.problemShape,
+            GemmCoord(L1TileShape::M, L1TileShape::N, L1TileShape::K), params.aicCoreNum);
+        uint32_t coreLoops = matmulBlockScheduler.GetCoreLoops();
+        uint32_t skTileNum = matmulBlockScheduler.GetSkTileNum();
+        // the data parallel tiles are already in C
+        if (skTileNum == 0) {
+            return;
+        }
+        uint32_t aivNum = AscendC::GetBlockNum() * AscendC::GetSubBlockNum();
+        uint32_t aivId = AscendC::GetBlockIdx();
+
+        // the fix-up reads the partial slots written by every aic
+        Catlass::Arch::CrossCoreWaitFlag(flagAicFinish);
+        Catlass::Arch::CrossCoreBarrier<0x0, PIPE_MTE3>();
+
+        uint64_t slotSize = static_cast<uint64_t>(L1TileShape::M) * L1TileShape::N;
+        AscendC::GlobalTensor<ElementC> gmC;
+        AscendC::GlobalTensor<ElementAccumulator> gmAccumulator;
+        AscendC::GlobalTensor<ElementAccumulator> gmPartial;
+        gmC.SetGlobalBuffer(reinterpret_cast<__gm__ ElementC*>(params.ptrC));
+        gmAccumulator.SetGlobalBuffer(reinterpret_cast<__gm__ ElementAccumulator*>(params.ptrWorkspace));
+        gmPartial.SetGlobalBuffer(reinterpret_cast<__gm__ ElementAccumulator*>(params.ptrWorkspace)
+            + skTileNum * slotSize);
+
+        // Fix-up of the stream-k tiles, split into row passes over all aiv
+        StreamkFixup streamkFixup(resource);
+        uint32_t rowsPerPass = StreamkFixup::GetRowsPerPass(L1TileShape::N);
+        uint32_t passesPerTile = CeilDiv(L1TileShape::M, rowsPerPass);
+        for (uint32_t passIdx = aivId; passIdx < skTileNum * passesPerTile; passIdx += aivNum) {
+            uint32_t taskIdx = coreLoops + passIdx / passesPerTile;
+            uint32_t ownerCoreIdx = matmulBlockScheduler.GetSkOwnerCoreIdx(taskIdx);
+            uint32_t partialNum = matmulBlockScheduler.GetSkLastCoreIdx(taskIdx) - ownerCoreIdx;
+            GemmCoord blockCoord = matmulBlockScheduler.GetBlockCoord(taskIdx);
+            GemmCoord actualBlockShape = matmulBlockScheduler.GetActualBlockShape(blockCoord);
+            uint32_t rowStart = passIdx % passesPerTile * rowsPerPass;
+            if (rowStart >= actualBlockShape.m()) {
+                continue;
+            }
+            uint32_t rows = Min(rowsPerPass, actualBlockShape.m() - rowStart);
+
+            MatrixCoord offsetC{blockCoord.m() * L1TileShape::M + rowStart, blockCoord.n() * L1TileShape::N};
+            int64_t gmOffsetC = params.layoutC.GetOffset(offsetC);
+            uint64_t rowOffset = static_cast<uint64_t>(rowStart) * actualBlockShape.n();
+            uint64_t gmOffsetAccumulator = (taskIdx - coreLoops) * slotSize + rowOffset;
+            uint64_t gmOffsetPartial = (ownerCoreIdx + 1) * slotSize + rowOffset;
+            streamkFixup(gmC[gmOffsetC], params.problemShape.n(), gmAccumulator[gmOffsetAccumulator],
+                gmPartial[gmOffsetPartial], slotSize, partialNum, rows, actualBlockShape.n());
+        }
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+private:
+    static constexpr Arch::FlagID FLAG_AIC_FINISH = 0;
+    Arch::CrossCoreFlag flagAicFinish{FLAG_AIC_FINISH};
+    Arch::Resource<ArchTag> resource;
+};
+
+} // namespace Catlass::Gemm::Kernel
+
+#endif // CATLASS_GEMM_KERNEL_STREAMK_MATMUL_HPP
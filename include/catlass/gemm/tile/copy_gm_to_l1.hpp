@@ -60,6 +60,16 @@ struct CopyGmToL1DynamicOptimized {
     static_assert(DEPENDENT_FALSE<ArchTag>, "Unsupported copy gm to l1, can not find the specialization.");
 };
 
+template <
+    class ArchTag,
+    /// GemmType for matrix operand
+    class GmType,
+    class L1Type = void
+>
+struct CopyGmToL1Gather {
+    static_assert(DEPENDENT_FALSE<ArchTag>, "Unsupported copy gm to l1, can not find the specialization.");
+};
+
 /// Partial specialization for AtlasA2, RowMajor in and zN out.
 template <class Element>
 struct CopyGmToL1DynamicOptimized<Arch::AtlasA2, Gemm::GemmType<Element, layout::RowMajor>> {
@@ -303,6 +313,66 @@ struct CopyGmToL1GMMPTD<Arch::AtlasA2, Gemm::GemmType<Element, layout::RowMajor>
     }
 };
 
+/// Partial specialization for AtlasA2, RowMajor in and zN out.
+/// Row i of the tile is read from row rowIndex[i] of srcTensor, so the rows of a matrix that is not sorted by group
+/// (e.g. MoE tokens that are not sorted by expert) are gathered while they are loaded into L1. Consecutive rows of
+/// srcTensor are moved by one copy.
+template <class Element>
+struct CopyGmToL1Gather<Arch::AtlasA2, Gemm::GemmType<Element, layout::RowMajor>> {
+    using LayoutDst = layout::zN;
+    using LayoutSrc = layout::RowMajor;
+
+    static constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(Element);
+
+    // Methods
+
+    CATLASS_DEVICE
+    CopyGmToL1Gather() {};
+
+    // layoutSrc gives the number of rows and columns of the tile and the row stride of srcTensor
+    template <class ElementIndex>
+    CATLASS_DEVICE
+    void operator()(
+        AscendC::LocalTensor<Element> const &dstTensor,
+        AscendC::GlobalTensor<Element> const &srcTensor,
+        LayoutDst const &layoutDst, LayoutSrc const &layoutSrc,
+        AscendC::GlobalTensor<ElementIndex> const &rowIndex)
+    {
+        uint32_t rows = layoutSrc.shape(0);
+        if (rows == 0) {
+            return;
+        }
+        AscendC::Nd2NzParams intriParams;
+
+        intriParams.ndNum = 1;
+        intriParams.dValue = layoutSrc.shape(1);
+        intriParams.srcNdMatrixStride = 0;
+        intriParams.srcDValue = layoutSrc.stride(0);
+        intriParams.dstNzC0Stride = layoutDst.stride(3) / ELE_NUM_PER_C0;
+        intriParams.dstNzNStride = 1;
+        intriParams.dstNzMatrixStride = 0;
+
+        // Every index is read once, the one ending a run starts the next
+        int64_t srcRow = static_cast<int64_t>(rowIndex.GetValue(0));
+        uint32_t runBegin = 0;
+        while (runBegin < rows) {
+            uint32_t runEnd = runBegin + 1;
+            int64_t nextRow = 0;
+            for (; runEnd < rows; ++runEnd) {
+                nextRow = static_cast<int64_t>(rowIndex.GetValue(runEnd));
+                if (nextRow != srcRow + (runEnd - runBegin)) {
+                    break;
+                }
+            }
+            intriParams.nValue = runEnd - runBegin;
+            AscendC::DataCopy(dstTensor[runBegin * ELE_NUM_PER_C0], srcTensor[srcRow * layoutSrc.stride(0)],
+                intriParams);
+            srcRow = nextRow;
+            runBegin = runEnd;
+        }
+    }
+};
+
 ////////////////////////////////////////
 /// Using the standard strided DataCopy interface to implement nd2nz
 /// transfer may achieve higher data transfer efficiency when the data block shape is short and wide
@@ -68,6 +68,18 @@ struct TileCopy {
             typename BiasTypeSelector::L0BiasType>>;
 };
 
+/// Same as TileCopy, but the rows of A are gathered by a row index list while they are loaded into L1
+template <
+    class ArchTag,
+    class AType,
+    class BType,
+    class CType,
+    class BiasType = void
+>
+struct TileCopyGatherA : public TileCopy<ArchTag, AType, BType, CType, BiasType> {
+    using CopyGmToL1A = Gemm::Tile::CopyGmToL1Gather<ArchTag, AType>;
+};
+
 template <
     class ArchTag,
     class AType,
@@ -0,0 +1,107 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMV_BATCHED_GEMV_DISPATCH_HPP
+#define CATLASS_GEMV_BATCHED_GEMV_DISPATCH_HPP
+
+#include <algorithm>
+
+#include "catlass/catlass.hpp"
+#include "catlass/gemv_coord.hpp"
+
+namespace Catlass::Gemv {
+
+// Host side choice between KernelBatchedGemvAiv and KernelBatchedGemvAic for a batch of gemvs on the same A.
+//
+// Both kernels read A once per pass of up to MAX_BATCH vectors, so the difference is the compute. The vector cores
+// do batch multiply-adds per element of A and are twice as many, the cube cores do the work of 16 vectors whatever
+// the batch but hand the result to the vector cores through a workspace. A single vector is bound by the stream of
+// A on AIV, a full batch by the vector units, where the cube path is still bound by the stream.
+
+enum class BatchedGemvCore : uint32_t {
+    AIV = 0,
+    AIC
+};
+
+// Rough figures of Atlas A2, in cycles and bytes per cycle, the defaults are those of a 910B
+struct BatchedGemvCostModel {
+    uint32_t aivNum{40};
+    uint32_t aicNum{20};
+    // multiply-adds a vector core retires per cycle, the accumulation is fp32 whatever the input
+    double aivMacPerCycle{64};
+    // multiply-adds of a cube core per cycle on 16 bit inputs, half of it on fp32
+    double aicMacPerCycleB16{4096};
+    // bandwidth of GM shared by all cores, and the part one core can draw
+    double gmBytesPerCycle{800};
+    double coreGmBytesPerCycle{64};
+    // workspace hand-over and cross core flag of the cube path
+    double aicFixedCycles{3000};
+    // rows of A per block of KernelBatchedGemvAiv and of KernelBatchedGemvAic
+    uint32_t aivTileM{32};
+    uint32_t aicTileM{256};
+    // vectors per pass of A, MAX_BATCH of the AIV block and L1TileShape::M of the AIC one
+    uint32_t aivMaxBatch{16};
+    uint32_t aicMaxBatch{16};
+};
+
+struct BatchedGemvEstimate {
+    double aivCycles{0};
+    double aicCycles{0};
+    BatchedGemvCore core{BatchedGemvCore::AIV};
+};
+
+// Estimates both kernels for batch gemvs of problemShape with elementBytes wide inputs
+inline BatchedGemvEstimate EstimateBatchedGemv(
+    GemvCoord const &problemShape, uint32_t batch, uint32_t elementBytes,
+    BatchedGemvCostModel const &model = BatchedGemvCostModel{})
+{
+    double m = problemShape.m();
+    double n = problemShape.n();
+    double bytesA = m * n * elementBytes;
+    auto streamCycles = [&](uint32_t blocks, uint32_t coreNum, double bytes) {
+        uint32_t cores = std::max(1u, std::min(blocks, coreNum));
+        return bytes / std::min(model.gmBytesPerCycle, cores * model.coreGmBytesPerCycle);
+    };
+
+    BatchedGemvEstimate estimate;
+    {
+        uint32_t passes = CeilDiv(batch, model.aivMaxBatch);
+        uint32_t blocks = CeilDiv(problemShape.m(), model.aivTileM) * passes;
+        double cores = std::max(1u, std::min(blocks, model.aivNum));
+        double compute = batch * m * n / (cores * model.aivMacPerCycle);
+        estimate.aivCycles = std::max(compute, streamCycles(blocks, model.aivNum, passes * bytesA));
+    }
+    {
+        uint32_t passes = CeilDiv(batch, model.aicMaxBatch);
+        uint32_t blocks = CeilDiv(problemShape.m(), model.aicTileM) * passes;
+        double cores = std::max(1u, std::min(blocks, model.aicNum));
+        double macPerCycle = model.aicMacPerCycleB16 * 2 / elementBytes;
+        // the rows of X are padded to a fractal
+        double compute = passes * RoundUp<C0_NUM_PER_FRACTAL>(std::min(batch, model.aicMaxBatch)) * m * n /
+            (cores * macPerCycle);
+        // fp32 accumulators out and in, y in and z out
+        double bytesW = batch * m * (2 * sizeof(float) + 2 * elementBytes);
+        estimate.aicCycles = std::max(compute, streamCycles(blocks, model.aicNum, passes * bytesA + bytesW)) +
+            model.aicFixedCycles;
+    }
+    estimate.core = (estimate.aicCycles < estimate.aivCycles) ? BatchedGemvCore::AIC : BatchedGemvCore::AIV;
+    return estimate;
+}
+
+inline BatchedGemvCore SelectBatchedGemvCore(
+    GemvCoord const &problemShape, uint32_t batch, uint32_t elementBytes,
+    BatchedGemvCostModel const &model = BatchedGemvCostModel{})
+{
+    return EstimateBatchedGemv(problemShape, batch, elementBytes, model).core;
+}
+
+} // namespace Catlass::Gemv
+
+#endif // CATLASS_GEMV_BATCHED_GEMV_DISPATCH_HPP
@@ -0,0 +1,252 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMV_BLOCK_BLOCK_BATCHED_GEMV_AIV_HPP
+#define CATLASS_GEMV_BLOCK_BLOCK_BATCHED_GEMV_AIV_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/coord.hpp"
+#include "catlass/gemv_coord.hpp"
+#include "catlass/gemv/helper.hpp"
+#include "catlass/gemm/helper.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/detail/alignment.hpp"
+#include "catlass/gemm/dispatch_policy.hpp"
+
+namespace Catlass::Gemv::Block {
+
+// Gemv of up to MAX_BATCH vectors against the same block of A, rows of A are split in UBTileShape::M and the
+// columns in UBTileShape::N. Each tile of A is moved to UB once, the x of every vector of the batch is moved with it
+// and TileVmad (a TileBatchedVmad, which keeps the tile intact) applies the tile to them one after the other.
+template <
+    uint32_t MAX_BATCH_,
+    class UBTileShape_,
+    class AType_,
+    class XType_,
+    class YType_,
+    class BiasType_,
+    class TileCopy_,
+    class TileVmad_,
+    class TileVmuls_
+>
+struct BlockGemv <
+    Gemm::BatchedGemvAtlasA2<MAX_BATCH_>,
+    UBTileShape_,
+    AType_,
+    XType_,
+    YType_,
+    BiasType_,
+    TileCopy_,
+    TileVmad_,
+    TileVmuls_
+> {
+public:
+    // Type Aliases
+    using DispatchPolicy = Gemm::BatchedGemvAtlasA2<MAX_BATCH_>;
+    using ArchTag = typename DispatchPolicy::ArchTag;
+    using UBTileShape = UBTileShape_;
+    using ElementA = typename AType_::Element;
+    using LayoutA = typename AType_::Layout;
+    using ElementX = typename XType_::Element;
+    using LayoutX = layout::RowMajor;
+    using ElementY = typename YType_::Element;
+    using LayoutY = layout::RowMajor;
+    using TileVmad = TileVmad_;
+    using TileVmuls = TileVmuls_;
+    using VecCopyGmToUb = typename TileCopy_::VecCopyGmToUb;
+    using VecCopyUbToGm = typename TileCopy_::VecCopyUbToGm;
+    using MatrixCopyGmToUb = typename TileCopy_::MatrixCopyGmToUb;
+    using ElementAccumulator =
+        typename Gemm::helper::ElementAccumulatorSelector<ElementA, ElementX>::ElementAccumulator;
+
+    using UBAlignHelper = Gemv::helper::UBAlignHelper<ElementA>;
+    using TensorCoord = layout::VectorLayout::TensorCoord;
+
+    static_assert(std::is_same_v<LayoutA, layout::RowMajor>, "The batched gemv on AIV only supports a RowMajor A");
+    static_assert(std::is_same_v<ElementA, ElementX> && std::is_same_v<ElementA, ElementY>,
+        "A, x and y must have the same element type");
+
+    static constexpr uint32_t STAGES = DispatchPolicy::STAGES;
+    static constexpr uint32_t MAX_BATCH = DispatchPolicy::MAX_BATCH;
+    static constexpr uint32_t TILE_M_ROUND = RoundUp<UBAlignHelper::ALIGN>(UBTileShape::M);
+    static constexpr uint32_t TILE_N_ROUND = RoundUp<UBAlignHelper::ALIGN>(UBTileShape::N);
+    static constexpr uint32_t A_BUF_SIZE = TILE_M_ROUND * TILE_N_ROUND * sizeof(ElementA);
+    // x of the vectors of the batch, one row of TILE_N_ROUND each
+    static constexpr uint32_t X_BUF_SIZE = MAX_BATCH * TILE_N_ROUND * sizeof(ElementX);
+    // y of the vectors of the batch, one row of TILE_M_ROUND each
+    static constexpr uint32_t Y_BUF_SIZE = MAX_BATCH * TILE_M_ROUND * sizeof(ElementY);
+    static constexpr uint32_t WORKSPACE_SIZE =
+        RoundUp<BYTE_PER_BLK>(TileVmad::GetTempLen(TILE_M_ROUND) * sizeof(ElementAccumulator));
+
+    static_assert((A_BUF_SIZE + X_BUF_SIZE + Y_BUF_SIZE) * STAGES + WORKSPACE_SIZE <= ArchTag::UB_SIZE,
+        "UBTileShape and MAX_BATCH exceeding the UB space!");
+
+    CATLASS_DEVICE
+    BlockGemv() {}
+
+    /// Construct
+    CATLASS_DEVICE
+    BlockGemv(Arch::Resource<ArchTag> &resource, uint32_t UBufAddrStart = 0)
+    {
+        uint32_t UbAOffset = UBufAddrStart;
+        uint32_t UbXOffset = UbAOffset + A_BUF_SIZE * STAGES;
+        uint32_t UbYOffset = UbXOffset + X_BUF_SIZE * STAGES;
+        uint32_t UbWOffset = UbYOffset + Y_BUF_SIZE * STAGES;
+        UbWTensor = resource.ubBuf.template GetBufferByByte<ElementAccumulator>(UbWOffset);
+        // Init buffers
+        for (uint32_t i = 0; i < STAGES; i++) {
+            UbATensorList[i] = resource.ubBuf.template GetBufferByByte<ElementA>(UbAOffset + i * A_BUF_SIZE);
+            UbXTensorList[i] = resource.ubBuf.template GetBufferByByte<ElementX>(UbXOffset + i * X_BUF_SIZE);
+            UbYTensorList[i] = resource.ubBuf.template GetBufferByByte<ElementY>(UbYOffset + i * Y_BUF_SIZE);
+
+            // Assign event ID for each stages
+            UbInAEventList[i] = i;
+            UbInXEventList[i] = i + STAGES;
+            UbOutEventList[i] = i;
+
+            // The event id that needs to be set before the loop
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(UbInAEventList[i]);
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>(UbInXEventList[i]);
+            AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>(UbOutEventList[i]);
+        }
+    }
+
+    /// Destructor
+    CATLASS_DEVICE
+    ~BlockGemv()
+    {
+        for (uint32_t i = 0; i < STAGES; i++) {
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(UbInAEventList[i]);
+            AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>(UbInXEventList[i]);
+            AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>(UbOutEventList[i]);
+        }
+    }
+
+    /// z[b] = alpha * A * x[b] + beta * y[b] for b < batch, x is batch x n, y and z are batch x m
+    CATLASS_DEVICE
+    void operator()(
+        AscendC::GlobalTensor<ElementA> const &gmA, LayoutA const &layoutA,
+        AscendC::GlobalTensor<ElementX> const &gmX, LayoutX const &layoutX,
+        AscendC::GlobalTensor<ElementY> const &gmY, LayoutY const &layoutY,
+        AscendC::GlobalTensor<ElementY> const &gmZ,
+        GemvCoord const &actualShape,
+        uint32_t batch,
+        float alpha,
+        float beta)
+    {
+        uint32_t m_actual = (actualShape.m() < TILE_M_ROUND) ? actualShape.m() : TILE_M_ROUND;
+        auto ubY = UbYTensorList[UbOutListId];
+
+        AscendC::WaitFlag<AscendC::HardEvent::MTE3_MTE2>((event_t)(UbOutEventList[UbOutListId]));
+        for (uint32_t b = 0; b < batch; b++) {
+            vecCopyGmToUb(ubY[b * TILE_M_ROUND], gmY[layoutY.GetOffset(MakeCoord(b, 0U))], m_actual);
+        }
+        AscendC::SetFlag<AscendC::HardEvent::MTE2_V>((event_t)(UbOutEventList[UbOutListId]));
+        AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>((event_t)(UbOutEventList[UbOutListId]));
+        tileVmuls(ubY, ubY, (ElementY)beta, batch * TILE_M_ROUND);
+
+        uint32_t strideA = layoutA.stride(1) * TILE_N_ROUND;
+        uint32_t Nloop = CeilDiv(actualShape.n(), TILE_N_ROUND);
+        uint32_t n_actual = (actualShape.n() < TILE_N_ROUND) ? actualShape.n() : TILE_N_ROUND;
+        LoadTile(gmA, layoutA, gmX, layoutX, batch, m_actual, n_actual, UbInListId);
+
+        // main loop
+        for (uint32_t LoopIdx = 0; LoopIdx < Nloop; LoopIdx++) {
+            n_actual = (LoopIdx == Nloop - 1) ? (actualShape.n() - LoopIdx * TILE_N_ROUND) : TILE_N_ROUND;
+
+            uint32_t UbInListIdNext = (UbInListId + 1 < STAGES) ? (UbInListId + 1) : 0;
+            if (LoopIdx < Nloop - 1) {
+                uint32_t LoopIdxNext = LoopIdx + 1;
+                uint32_t n_actual_next =
+                    (LoopIdxNext == Nloop - 1) ? (actualShape.n() - LoopIdxNext * TILE_N_ROUND) : TILE_N_ROUND;
+                LoadTile(gmA[LoopIdxNext * strideA], layoutA, gmX[LoopIdxNext * TILE_N_ROUND], layoutX, batch,
+                    m_actual, n_actual_next, UbInListIdNext);
+            }
+
+            auto ubX = UbXTensorList[UbInListId];
+            AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>((event_t)(UbInXEventList[UbInListId]));
+            tileVmuls(ubX, ubX, (ElementX)alpha, batch * TILE_N_ROUND);
+            AscendC::PipeBarrier<PIPE_V>();
+
+            AscendC::WaitFlag<AscendC::HardEvent::MTE2_V>((event_t)(UbInAEventList[UbInListId]));
+            auto layoutComputeInUb = layoutA.GetTileLayout(MakeCoord(TILE_M_ROUND, TILE_N_ROUND));
+            auto layoutTileCompute = layoutA.GetTileLayout(MakeCoord(m_actual, n_actual));
+            // the tile of A stays in UB for the whole batch
+            for (uint32_t b = 0; b < batch; b++) {
+                tileVmad(ubY[b * TILE_M_ROUND],
+                    ubX[b * TILE_N_ROUND],
+                    UbATensorList[UbInListId],
+                    UbWTensor,
+                    layoutComputeInUb,
+                    layoutTileCompute);
+            }
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>((event_t)(UbInAEventList[UbInListId]));
+            AscendC::SetFlag<AscendC::HardEvent::V_MTE2>((event_t)(UbInXEventList[UbInListId]));
+            UbInListId = UbInListIdNext;
+        }
+
+        AscendC::SetFlag<AscendC::HardEvent::V_MTE3>((event_t)(UbOutEventList[UbOutListId]));
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE3>((event_t)(UbOutEventList[UbOutListId]));
+        layout::VectorLayout layoutYInUb{m_actual};
+        for (uint32_t b = 0; b < batch; b++) {
+            vecCopyUbToGm(gmZ[layoutY.GetOffset(MakeCoord(b, 0U))], ubY[b * TILE_M_ROUND], layoutYInUb, layoutYInUb);
+        }
+        AscendC::SetFlag<AscendC::HardEvent::MTE3_MTE2>((event_t)(UbOutEventList[UbOutListId]));
+        UbOutListId = (UbOutListId + 1 < STAGES) ? (UbOutListId + 1) : 0;
+    }
+
+protected:
+    // Moves an m_actual x n_actual tile of A and the n_actual elements of x of every vector to the stage listId
+    CATLASS_DEVICE
+    void LoadTile(
+        AscendC::GlobalTensor<ElementA> const &gmA, LayoutA const &layoutA,
+        AscendC::GlobalTensor<ElementX> const &gmX, LayoutX const &layoutX,
+        uint32_t batch, uint32_t m_actual, uint32_t n_actual, uint32_t listId)
+    {
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>((event_t)(UbInXEventList[listId]));
+        for (uint32_t b = 0; b < batch; b++) {
+            vecCopyGmToUb(UbXTensorList[listId][b * TILE_N_ROUND], gmX[layoutX.GetOffset(MakeCoord(b, 0U))],
+                n_actual);
+        }
+        AscendC::SetFlag<AscendC::HardEvent::MTE2_V>((event_t)(UbInXEventList[listId]));
+
+        AscendC::WaitFlag<AscendC::HardEvent::V_MTE2>((event_t)(UbInAEventList[listId]));
+        auto layoutAInUb = layoutA.GetTileLayout(MakeCoord(TILE_M_ROUND, TILE_N_ROUND));
+        auto layoutTileA = layoutA.GetTileLayout(MakeCoord(m_actual, n_actual));
+        matrixCopyGmToUb(UbATensorList[listId], gmA, layoutAInUb, layoutTileA);
+        AscendC::SetFlag<AscendC::HardEvent::MTE2_V>((event_t)(UbInAEventList[listId]));
+    }
+
+    // Multi-stage tensors list
+    AscendC::LocalTensor<ElementA> UbATensorList[STAGES];
+    AscendC::LocalTensor<ElementX> UbXTensorList[STAGES];
+    AscendC::LocalTensor<ElementY> UbYTensorList[STAGES];
+    AscendC::LocalTensor<ElementAccumulator> UbWTensor;
+
+    // Multi-stage event id list
+    int32_t UbInAEventList[STAGES];
+    int32_t UbInXEventList[STAGES];
+    int32_t UbOutEventList[STAGES];
+
+    // The id of current stage
+    uint32_t UbOutListId{0};
+    uint32_t UbInListId{0};
+
+    TileVmad tileVmad;
+    TileVmuls tileVmuls;
+    MatrixCopyGmToUb matrixCopyGmToUb;
+    VecCopyGmToUb vecCopyGmToUb;
+    VecCopyUbToGm vecCopyUbToGm;
+};
+
+} // namespace Catlass::Gemv::Block
+
+#endif // CATLASS_GEMV_BLOCK_BLOCK_BATCHED_GEMV_AIV_HPP
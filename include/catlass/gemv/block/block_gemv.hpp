@@ -25,5 +25,6 @@ struct BlockGemv {
 
 #include "catlass/gemv/block/block_gemv_aiv.hpp"
 #include "catlass/gemv/block/block_gemv_aic.hpp"
+#include "catlass/gemv/block/block_batched_gemv_aiv.hpp"
 
 #endif
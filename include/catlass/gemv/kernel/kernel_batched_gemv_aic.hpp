@@ -0,0 +1,213 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMV_KERNEL_BATCHED_GEMV_AIC_HPP
+#define CATLASS_GEMV_KERNEL_BATCHED_GEMV_AIC_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/cross_core_sync.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/gemm_coord.hpp"
+#include "catlass/gemv_coord.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/matrix_coord.hpp"
+
+namespace Catlass::Gemv::Kernel {
+
+// Template for batched gemv kernel on AIC, Compute z[b] = αAx[b] + βy[b] for b < batch
+// x is batch x n and y, z are batch x m, all row major. The batch is the m of a matmul: X (batch x n) times the
+// transpose of A (n x m), so BlockMmad is a Gemm::Block::BlockMmad with X as its A, A read as its transpose as its
+// B and a RowMajor C in the workspace. The cube pads the rows of X to 16 anyway, so up to L1TileShape::M vectors
+// cost one stream of A and about the mmads of one. BlockEpilogue is the EpilogueAtlasA2Gemv epilogue, run on the
+// rows of every block of the workspace.
+template <
+    class BlockMmad_,
+    class BlockEpilogue_,
+    class BlockScheduler_
+>
+class KernelBatchedGemvAic {
+public:
+    using BlockMmad = BlockMmad_;
+    using ArchTag = typename BlockMmad::ArchTag;
+    using L1TileShape = typename BlockMmad::L1TileShape;
+    using ElementX = typename BlockMmad::ElementA;
+    using LayoutX = typename BlockMmad::LayoutA;
+    using ElementA = typename BlockMmad::ElementB;
+    // layout of the transpose of A
+    using LayoutAT = typename BlockMmad::LayoutB;
+    using ElementW = typename BlockMmad::ElementC;
+    using LayoutW = typename BlockMmad::LayoutC;
+
+    using BlockEpilogue = BlockEpilogue_;
+    using ElementY = typename BlockEpilogue::ElementY;
+    using ElementZ = typename BlockEpilogue::ElementZ;
+    using LayoutZ = typename BlockEpilogue::LayoutZ;
+    using EpilogueParams = typename BlockEpilogue::Params;
+
+    using BlockScheduler = BlockScheduler_;
+
+    static_assert(std::is_same_v<LayoutX, layout::RowMajor> && std::is_same_v<LayoutW, layout::RowMajor>,
+        "x and the workspace are RowMajor");
+
+    struct Params {
+        // Data members
+        GemmCoord problemShape;
+        GM_ADDR ptrX;
+        LayoutX layoutX;
+        GM_ADDR ptrA;
+        LayoutAT layoutA;
+        GM_ADDR ptrWorkspace;
+        LayoutW layoutW;
+        EpilogueParams epilogueParams;
+
+        // Methods
+        CATLASS_HOST_DEVICE
+        Params() {}
+
+        CATLASS_HOST_DEVICE
+        Params(GemmCoord const &problemShape_, GM_ADDR ptrX_, LayoutX layoutX_, GM_ADDR ptrA_, LayoutAT layoutA_,
+            GM_ADDR ptrWorkspace_, LayoutW layoutW_, EpilogueParams const &epilogueParams_)
+            : problemShape(problemShape_), ptrX(ptrX_), layoutX(layoutX_), ptrA(ptrA_), layoutA(layoutA_),
+              ptrWorkspace(ptrWorkspace_), layoutW(layoutW_), epilogueParams(epilogueParams_) {}
+    };
+
+    struct Arguments {
+        GemvCoord problemShape;
+        uint32_t batch;
+        float alpha;
+        float beta;
+        GM_ADDR ptrX;
+        GM_ADDR ptrA;
+        GM_ADDR ptrY;
+        GM_ADDR ptrZ;
+    };
+
+    static bool CanImplement(const Arguments &args)
+    {
+        return args.batch > 0;
+    }
+
+    static size_t GetWorkspaceSize(const Arguments &args)
+    {
+        return sizeof(ElementW) * args.batch * args.problemShape.m();
+    }
+
+    static Params ToUnderlyingArguments(const Arguments &args, uint8_t *workspace)
+    {
+        uint32_t m = args.problemShape.m();
+        uint32_t n = args.problemShape.n();
+        GemmCoord problemShape{args.batch, m, n};
+        LayoutX layoutX{args.batch, n};
+        // a RowMajor m x n A is a ColumnMajor n x m transpose and the other way round
+        LayoutAT layoutA{n, m};
+        LayoutW layoutW{args.batch, m};
+        // y and z are seen as one vector of batch * m
+        LayoutZ layoutZ{args.batch * m};
+        EpilogueParams epilogueParams{args.alpha, args.beta, args.ptrY, layoutZ, args.ptrZ, layoutZ};
+
+        Params params{problemShape, args.ptrX, layoutX, args.ptrA, layoutA, workspace, layoutW, epilogueParams};
+        return params;
+    }
+
+    // Methods
+    CATLASS_DEVICE
+    KernelBatchedGemvAic() {}
+
+    template <int32_t CORE_TYPE = g_coreType>
+    CATLASS_DEVICE
+    void operator()(Params const& params);
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIC>(Params const& params)
+    {
+        BlockScheduler blockScheduler(params.problemShape, MakeCoord(L1TileShape::M, L1TileShape::N));
+        uint32_t coreLoops = blockScheduler.GetCoreLoops();
+
+        BlockMmad blockMmad(resource);
+
+        // Represent the full gm
+        AscendC::GlobalTensor<ElementX> gmX;
+        gmX.SetGlobalBuffer((__gm__ ElementX *)params.ptrX);
+        AscendC::GlobalTensor<ElementA> gmA;
+        gmA.SetGlobalBuffer((__gm__ ElementA *)params.ptrA);
+        AscendC::GlobalTensor<ElementW> gmW;
+        gmW.SetGlobalBuffer((__gm__ ElementW *)params.ptrWorkspace);
+
+        for (uint32_t loopIdx = AscendC::GetBlockIdx(); loopIdx < coreLoops; loopIdx += AscendC::GetBlockNum()) {
+            // Compute block location
+            GemmCoord blockCoord = blockScheduler.GetBlockCoord(loopIdx);
+            GemmCoord actualBlockShape = blockScheduler.GetActualBlockShape(blockCoord);
+
+            MatrixCoord offsetX{blockCoord.m() * L1TileShape::M, 0U};
+            MatrixCoord offsetA{0U, blockCoord.n() * L1TileShape::N};
+            MatrixCoord offsetW{blockCoord.m() * L1TileShape::M, blockCoord.n() * L1TileShape::N};
+
+            // Compute block-scoped matrix multiply-add
+            blockMmad(gmX[params.layoutX.GetOffset(offsetX)], params.layoutX,
+                      gmA[params.layoutA.GetOffset(offsetA)], params.layoutA,
+                      gmW[params.layoutW.GetOffset(offsetW)], params.layoutW,
+                      actualBlockShape);
+
+            Arch::CrossCoreSetFlagWithReverse<0x2, PIPE_FIX>(flagAicFinishStore);
+        }
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIV>(Params const& params)
+    {
+        BlockScheduler blockScheduler(params.problemShape, MakeCoord(L1TileShape::M, L1TileShape::N));
+        uint32_t coreLoops = blockScheduler.GetCoreLoops();
+
+        BlockEpilogue blockEpilogue(resource, params.epilogueParams);
+
+        // Represent the full gm
+        AscendC::GlobalTensor<ElementW> gmW;
+        gmW.SetGlobalBuffer((__gm__ ElementW *)params.ptrWorkspace);
+
+        // Get aicore information
+        uint32_t aicoreIndex = AscendC::GetBlockIdx() / AscendC::GetSubBlockNum();
+        uint32_t aicoreNum = AscendC::GetBlockNum();
+
+        for (uint32_t loopIdx = aicoreIndex; loopIdx < coreLoops; loopIdx += aicoreNum) {
+            GemmCoord blockCoord = blockScheduler.GetBlockCoord(loopIdx);
+            GemmCoord actualBlockShape = blockScheduler.GetActualBlockShape(blockCoord);
+            layout::VectorLayout::TensorCoord actualRowShape{actualBlockShape.n()};
+
+            // Synchronize cross core
+            Arch::CrossCoreWaitFlagWithReverse<0x2, PIPE_MTE3>(flagAicFinishStore);
+
+            // each row of the block is a piece of one vector of y and z
+            for (uint32_t row = 0; row < actualBlockShape.m(); ++row) {
+                MatrixCoord offsetW{blockCoord.m() * L1TileShape::M + row, blockCoord.n() * L1TileShape::N};
+                int64_t gmOffsetW = params.layoutW.GetOffset(offsetW);
+                layout::VectorLayout layoutRowW{actualBlockShape.n()};
+                blockEpilogue(layout::VectorLayout::TensorCoord{static_cast<uint32_t>(gmOffsetW)},
+                    actualRowShape, gmW[gmOffsetW], layoutRowW);
+            }
+        }
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+
+private:
+    // ID used for inter-core synchronization
+    static constexpr Arch::FlagID FLAG_AIC_FINISH_STORE = 0;
+    static constexpr Arch::FlagID RV_FLAG_AIC_FINISH_STORE = 1;
+    Arch::CrossCoreFlagWithReverse<> flagAicFinishStore{FLAG_AIC_FINISH_STORE, RV_FLAG_AIC_FINISH_STORE};
+    Arch::Resource<ArchTag> resource;
+};
+
+}  // namespace Catlass::Gemv::Kernel
+
+#endif  // CATLASS_GEMV_KERNEL_BATCHED_GEMV_AIC_HPP
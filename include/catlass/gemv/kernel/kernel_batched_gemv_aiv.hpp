@@ -0,0 +1,171 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMV_KERNEL_BATCHED_GEMV_AIV_HPP
+#define CATLASS_GEMV_KERNEL_BATCHED_GEMV_AIV_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/resource.hpp"
+#include "catlass/coord.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/gemv_coord.hpp"
+#include "catlass/matrix_coord.hpp"
+
+namespace Catlass::Gemv::Kernel {
+
+// Template for batched gemv kernel on AIV, Compute z[b] = αAx[b] + βy[b] for b < batch
+// x is batch x n and y, z are batch x m, all row major. Each AIV takes blocks of UBTileShape::M rows of A and
+// streams them once for up to MAX_BATCH vectors, a larger batch is done in chunks of MAX_BATCH.
+template <
+    class BlockGemv_,
+    class BlockEpilogue_
+>
+class KernelBatchedGemvAiv {
+public:
+    using BlockGemv = BlockGemv_;
+    using ArchTag = typename BlockGemv::ArchTag;
+    using UBTileShape = typename BlockGemv::UBTileShape;
+    using ElementA = typename BlockGemv::ElementA;
+    using LayoutA = typename BlockGemv::LayoutA;
+    using ElementX = typename BlockGemv::ElementX;
+    using LayoutX = typename BlockGemv::LayoutX;
+    using ElementY = typename BlockGemv::ElementY;
+    using LayoutY = typename BlockGemv::LayoutY;
+    using ElementAccumulator = typename BlockGemv::ElementAccumulator;
+
+    static constexpr uint32_t MAX_BATCH = BlockGemv::MAX_BATCH;
+
+    /// Parameters structure
+    struct Params {
+        // Data members
+        GemvCoord problemShape;
+        uint32_t batch;
+        GM_ADDR ptrA;
+        LayoutA layoutA;
+        GM_ADDR ptrX;
+        LayoutX layoutX;
+        GM_ADDR ptrY;
+        LayoutY layoutY;
+        GM_ADDR ptrZ;
+        float alpha;
+        float beta;
+
+        // Methods
+        CATLASS_HOST_DEVICE
+        Params() {}
+
+        CATLASS_HOST_DEVICE
+        Params(GemvCoord const &problemShape_, uint32_t batch_, GM_ADDR ptrA_, LayoutA layoutA_,
+            GM_ADDR ptrX_, LayoutX layoutX_, GM_ADDR ptrY_, LayoutY layoutY_, GM_ADDR ptrZ_, float alpha_, float beta_)
+            : problemShape(problemShape_), batch(batch_), ptrA(ptrA_), layoutA(layoutA_), ptrX(ptrX_),
+            layoutX(layoutX_), ptrY(ptrY_), layoutY(layoutY_), ptrZ(ptrZ_), alpha(alpha_), beta(beta_) {}
+    };
+
+    struct Arguments {
+        GemvCoord problemShape;
+        uint32_t batch;
+        GM_ADDR ptrA;
+        GM_ADDR ptrX;
+        GM_ADDR ptrY;
+        GM_ADDR ptrZ;
+        float alpha;
+        float beta;
+    };
+
+    static bool CanImplement(const Arguments &args)
+    {
+        return args.batch > 0;
+    }
+
+    static size_t GetWorkspaceSize(const Arguments &args)
+    {
+        return 0;
+    }
+
+    static Params ToUnderlyingArguments(const Arguments &args, uint8_t *workspace)
+    {
+        uint32_t m = args.problemShape.m();
+        uint32_t n = args.problemShape.n();
+        LayoutA layoutA{m, n};
+        LayoutX layoutX{args.batch, n};
+        LayoutY layoutY{args.batch, m};
+        Params params{args.problemShape, args.batch, args.ptrA, layoutA, args.ptrX, layoutX,
+            args.ptrY, layoutY, args.ptrZ, args.alpha, args.beta};
+        return params;
+    }
+
+    // Methods
+    CATLASS_DEVICE
+    KernelBatchedGemvAiv() {}
+
+    template <int32_t CORE_TYPE = g_coreType>
+    CATLASS_DEVICE
+    void operator()(Params const &params) {};
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIC>(Params const &params) {}
+
+    template <>
+    CATLASS_DEVICE
+    void operator()<AscendC::AIV>(Params const &params)
+    {
+        AscendC::SetAtomicNone();
+        Arch::Resource<ArchTag> resource;
+        BlockGemv blockGemv(resource);
+
+        uint32_t maxMPerBlock = BlockGemv::TILE_M_ROUND;
+        uint32_t M = params.problemShape.m();
+        uint32_t N = params.problemShape.n();
+        uint32_t MLoops = CeilDiv(M, maxMPerBlock);
+        uint32_t batchLoops = CeilDiv(params.batch, MAX_BATCH);
+        // the chunks of a block of A run on neighbouring cores at the same time and share its reads through L2
+        uint32_t coreLoops = MLoops * batchLoops;
+
+        // Represent the full gm
+        AscendC::GlobalTensor<ElementA> gmA;
+        gmA.SetGlobalBuffer((__gm__ ElementA *)params.ptrA);
+        AscendC::GlobalTensor<ElementX> gmX;
+        gmX.SetGlobalBuffer((__gm__ ElementX *)params.ptrX);
+        AscendC::GlobalTensor<ElementY> gmY;
+        gmY.SetGlobalBuffer((__gm__ ElementY *)params.ptrY);
+        AscendC::GlobalTensor<ElementY> gmZ;
+        gmZ.SetGlobalBuffer((__gm__ ElementY *)params.ptrZ);
+
+        uint32_t aivNum = AscendC::GetBlockNum() * AscendC::GetTaskRation();
+        for (uint32_t loopIdx = AscendC::GetBlockIdx(); loopIdx < coreLoops; loopIdx += aivNum) {
+            uint32_t MBlockIdx = loopIdx / batchLoops;
+            uint32_t batchIdx = loopIdx % batchLoops;
+            uint32_t MActual = (MBlockIdx == MLoops - 1) ? (M - MBlockIdx * maxMPerBlock) : maxMPerBlock;
+            uint32_t batchActual =
+                (batchIdx == batchLoops - 1) ? (params.batch - batchIdx * MAX_BATCH) : MAX_BATCH;
+
+            MatrixCoord offsetA{MBlockIdx * maxMPerBlock, 0U};
+            MatrixCoord offsetX{batchIdx * MAX_BATCH, 0U};
+            MatrixCoord offsetY{batchIdx * MAX_BATCH, MBlockIdx * maxMPerBlock};
+            int64_t gmOffsetY = params.layoutY.GetOffset(offsetY);
+
+            blockGemv(gmA[params.layoutA.GetOffset(offsetA)], params.layoutA,
+                gmX[params.layoutX.GetOffset(offsetX)], params.layoutX,
+                gmY[gmOffsetY], params.layoutY,
+                gmZ[gmOffsetY],
+                GemvCoord{MActual, N},
+                batchActual,
+                params.alpha,
+                params.beta);
+        }
+
+        AscendC::PipeBarrier<PIPE_ALL>();
+    }
+};
+
+} // namespace Catlass::Gemv::Kernel
+
+#endif // CATLASS_GEMV_KERNEL_BATCHED_GEMV_AIV_HPP
@@ -0,0 +1,180 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_GEMV_TILE_TILE_BATCHED_VMAD_HPP
+#define CATLASS_GEMV_TILE_TILE_BATCHED_VMAD_HPP
+
+#include "catlass/catlass.hpp"
+#include "catlass/arch/arch.hpp"
+#include "catlass/gemm/helper.hpp"
+#include "catlass/layout/layout.hpp"
+#include "catlass/gemm/gemm_type.hpp"
+
+namespace Catlass::Gemv::Tile {
+
+template <
+    /// Tag indicating architecture
+    class ArchTag,
+    class AType,
+    class XType,
+    class YType
+>
+struct TileBatchedVmad
+{
+    static_assert(DEPENDENT_FALSE<ArchTag>, "Unsupported TileBatchedVmad, can not find the specialization.");
+};
+
+/// y += A * x for one vector of a batch. Unlike TileVmad the tile of A in UB is left intact, the products are
+/// accumulated in temp, so the tile is loaded once and applied to every vector of the batch.
+template <
+    class ElementA,
+    class ElementX,
+    class ElementY
+>
+struct TileBatchedVmad<Arch::AtlasA2,
+                       Gemm::GemmType<ElementA, layout::RowMajor>,
+                       Gemm::GemmType<ElementX, layout::VectorLayout>,
+                       Gemm::GemmType<ElementY, layout::VectorLayout>>
+{
+    using ElementAccumulator =
+        typename Gemm::helper::ElementAccumulatorSelector<ElementA, ElementX>::ElementAccumulator;
+
+    using LayoutDst = layout::RowMajor;
+    using LayoutSrc = layout::RowMajor;
+    static constexpr uint32_t ELE_NUM_PER_C0 = BYTE_PER_C0 / sizeof(ElementA);
+    // accumulators of one repeat, a row of the tile is folded into this many partial sums
+    static constexpr uint32_t ACC_NUM_PER_REPEAT = BYTE_PER_VECTOR_FRACTAL / sizeof(ElementAccumulator);
+    static constexpr bool NEED_CAST = !std::is_same_v<ElementY, ElementAccumulator>;
+
+    static_assert(std::is_same_v<ElementA, ElementX>, "A and x must have the same element type");
+
+    /// Elements of ElementAccumulator temp must hold for a tile of mRound rows
+    CATLASS_HOST_DEVICE
+    static constexpr uint32_t GetTempLen(uint32_t mRound)
+    {
+        uint32_t castLen = NEED_CAST ? CeilDiv(mRound * sizeof(ElementY), sizeof(ElementAccumulator)) : 0;
+        return mRound * ACC_NUM_PER_REPEAT + RoundUp(castLen, BYTE_PER_BLK / sizeof(ElementAccumulator));
+    }
+
+    // Mehtods
+
+    CATLASS_DEVICE
+    TileBatchedVmad() {};
+
+    CATLASS_DEVICE
+    void operator()(
+        AscendC::LocalTensor<ElementY> dstTensor,
+        AscendC::LocalTensor<ElementX> srcTensor_v,
+        AscendC::LocalTensor<ElementA> srcTensor_m,
+        AscendC::LocalTensor<ElementAccumulator> temp,
+        LayoutDst const &layoutDst, LayoutSrc const &layoutSrc
+    )
+    {
+        uint32_t m_actual = layoutSrc.shape(0);
+        uint32_t n_actual = layoutSrc.shape(1);
+        uint32_t m_round = layoutDst.shape(0);
+        uint32_t n_round = layoutDst.shape(1);
+
+        // temp may still be read by the previous vector
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::Duplicate<ElementAccumulator>(
+            temp,
+            (ElementAccumulator)0.0,
+            ACC_NUM_PER_REPEAT,
+            m_round,
+            1,
+            8
+        );
+
+        uint32_t repeat_num = n_actual / ACC_NUM_PER_REPEAT;
+        uint32_t remain = n_actual % ACC_NUM_PER_REPEAT;
+
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::BinaryRepeatParams params;
+        params.dstBlkStride = 1;
+        params.src0BlkStride = 1;
+        params.src1BlkStride = 1;
+        params.dstRepStride = BLK_NUM_PER_VECTOR_FRACTAL;
+        // a repeat per row of the tile, x is broadcast to every row
+        params.src0RepStride = n_round / ELE_NUM_PER_C0;
+        params.src1RepStride = 0;
+        AscendC::SetMaskCount();
+        AscendC::SetVectorMask<ElementAccumulator, AscendC::MaskMode::COUNTER>(m_actual * ACC_NUM_PER_REPEAT);
+        for (uint32_t i = 0; i < repeat_num; i++)
+        {
+            uint32_t offset = i * ACC_NUM_PER_REPEAT;
+            AscendC::MulAddDst<ElementAccumulator, ElementA, false>(
+                temp,
+                srcTensor_m[offset],
+                srcTensor_v[offset],
+                AscendC::MASK_PLACEHOLDER,
+                1,
+                params);
+            AscendC::PipeBarrier<PIPE_V>();
+        }
+        AscendC::SetMaskNorm();
+        AscendC::ResetMask();
+
+        if (remain > 0)
+        {
+            uint32_t offset = repeat_num * ACC_NUM_PER_REPEAT;
+            if (offset + remain > n_round)
+            {
+                remain = n_round - offset;
+            }
+            uint64_t remain_mask = remain;
+            AscendC::MulAddDst<ElementAccumulator, ElementA, true>(
+                temp,
+                srcTensor_m[offset],
+                srcTensor_v[offset],
+                remain_mask,
+                m_actual,
+                params);
+        }
+
+        uint64_t reduce_mask = (repeat_num == 0) ? remain : ACC_NUM_PER_REPEAT;
+        AscendC::PipeBarrier<PIPE_V>();
+        AscendC::WholeReduceSum<ElementAccumulator, true>(
+            temp,
+            temp,
+            reduce_mask,
+            m_actual,
+            1,
+            1,
+            BLK_NUM_PER_VECTOR_FRACTAL);
+        AscendC::PipeBarrier<PIPE_V>();
+
+        AscendC::BinaryRepeatParams addParams;
+        AscendC::SetMaskCount();
+        AscendC::SetVectorMask<ElementY, AscendC::MaskMode::COUNTER>(m_actual);
+        if constexpr (NEED_CAST) {
+            auto sum = temp[m_round * ACC_NUM_PER_REPEAT].template ReinterpretCast<ElementY>();
+            AscendC::UnaryRepeatParams castParams;
+            castParams.dstRepStride = BLK_NUM_PER_VECTOR_FRACTAL * sizeof(ElementY) / sizeof(ElementAccumulator);
+            AscendC::Cast<ElementY, ElementAccumulator, false>(
+                sum,
+                temp,
+                AscendC::RoundMode::CAST_NONE,
+                AscendC::MASK_PLACEHOLDER,
+                1,
+                castParams);
+            AscendC::PipeBarrier<PIPE_V>();
+            AscendC::Add<ElementY, false>(dstTensor, sum, dstTensor, AscendC::MASK_PLACEHOLDER, 1, addParams);
+        } else {
+            AscendC::Add<ElementY, false>(dstTensor, temp, dstTensor, AscendC::MASK_PLACEHOLDER, 1, addParams);
+        }
+        AscendC::SetMaskNorm();
+        AscendC::ResetMask();
+    }
+};
+
+} // namespace Catlass::Gemv::Tile
+
+#endif // CATLASS_GEMV_TILE_TILE_BATCHED_VMAD_HPP
@@ -14,6 +14,7 @@
 #ifdef ASCENDC_MODULE_OPERATOR_H
 #undef inline
 #endif
+#include <cstddef>
 #include <tuple>
 #ifdef ASCENDC_MODULE_OPERATOR_H
 #define inline __inline__ __attribute__((always_inline))
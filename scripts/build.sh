@@ -67,9 +67,27 @@ function show_help() {
     echo "  python_extension  Build Python extension"
     echo "  torch_library     Build Torch library"
     echo "  mstuner_catlass   Build msTuner for CATLASS. Use it with -DCATLASS_LIBRARY_KERNELS=<kernel_name>"
+    echo "  swizzle_simulator Build host simulator of block swizzles"
     echo "  <other>           Other specific targets, e.g. 00_basic_matmul"
     echo -e "\n{BLUE}Test targets:${NC}"
     echo "  test_self_contained_includes  Test for self contained includes"
+    echo "  golden_matmul_benchmark       Host benchmark of golden matmul engine"
+    echo "  manifest_benchmark            Host benchmark of catlass library manifest lookup"
+    echo "  streamk_planner_test          Host test of Stream-K block partition"
+    echo "  profiler_stress_test          Host stress test of mstuner_catlass profiling pipeline"
+    echo "  workspace_pool_test           Host test of shared_lib workspace pool"
+    echo "  launch_plan_cache_test        Host test of shared_lib launch plan cache"
+    echo "  grouped_task_table_test       Host test of grouped matmul task table"
+    echo "  fai_task_plan_test            Host test of flash attention infer task plan"
+    echo "  fai_workspace_plan_test       Host test of flash attention infer workspace plan"
+    echo "  tuner_simulate_test           Host test of mstuner_catlass on a simulated device"
+    echo "  weight_prepack_test           Host test of W4A8 and W8A16 weight prepacking"
+    echo "  batched_gemv_dispatch_test    Host test of the batched gemv golden and AIV/AIC selection"
+    echo "  conv_tile_planner_test        Host test of the conv2d/conv3d tile planner"
+    echo "  layout_convert_test           Host test and benchmark of the NC1HWC0/fractal Z/zN/nZ converters"
+    echo "  moe_routing_test              Host test of the MoE routing and MoE FFN golden"
+    echo "  kernel_selection_test         Host test of dynamic optimized matmul tiling and kernel selection"
+    echo "  tiling_cache_test             Host test of the dynamic optimized matmul tiling decision cache"
 }
 
 if [ "$1" = "-h" ] || [ "$1" = "--help" ]; then
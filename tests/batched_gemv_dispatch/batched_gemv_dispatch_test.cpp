@@ -0,0 +1,146 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the batched gemv golden and of the choice between KernelBatchedGemvAiv and KernelBatchedGemvAic.
+// ComputeGemvBatch is bit-exact with ComputeGemv run on every vector, one vector goes to AIV and a full batch on a
+// large matrix to AIC, and within one pass of A the choice flips at most once as the batch grows. The crossover batch
+// of a few shapes is printed for fp16 and fp32.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <opdev/fp16_t.h>
+
+#include "host_test.hpp"
+
+#include "catlass/gemv/batched_gemv_dispatch.hpp"
+#include "catlass/layout/layout.hpp"
+
+#include "golden.hpp"
+
+using namespace Catlass;
+using op::fp16_t;
+
+namespace {
+
+using HostTest::Check;
+
+// vectors per pass of A of both kernels in the default cost model
+constexpr uint32_t MAX_BATCH = 16;
+
+std::string ShapeStr(uint32_t batch, uint32_t m, uint32_t n)
+{
+    return std::to_string(batch) + "x" + std::to_string(m) + "x" + std::to_string(n);
+}
+
+template <class Element>
+void CheckGolden(uint32_t batch, uint32_t m, uint32_t n)
+{
+    GemvCoord problemShape{m, n};
+    layout::RowMajor layoutA{m, n};
+    layout::RowMajor layoutX{batch, n};
+    layout::RowMajor layoutY{batch, m};
+    float alpha = 0.75f;
+    float beta = -1.25f;
+
+    std::vector<Element> hostA(static_cast<size_t>(m) * n);
+    std::vector<Element> hostX(static_cast<size_t>(batch) * n);
+    std::vector<Element> hostY(static_cast<size_t>(batch) * m);
+    golden::FillRandomData<Element>(hostA, -1.0f, 1.0f);
+    golden::FillRandomData<Element>(hostX, -1.0f, 1.0f);
+    golden::FillRandomData<Element>(hostY, -1.0f, 1.0f);
+
+    std::vector<float> batched(static_cast<size_t>(batch) * m);
+    golden::ComputeGemvBatch(problemShape, batch, alpha, beta, hostA, layoutA, hostX, layoutX, hostY, layoutY,
+        batched, layoutY);
+
+    layout::VectorLayout layoutVx{n};
+    layout::VectorLayout layoutVy{m};
+    bool exact = true;
+    for (uint32_t b = 0; b < batch; ++b) {
+        auto xBegin = hostX.begin() + static_cast<size_t>(b) * n;
+        auto yBegin = hostY.begin() + static_cast<size_t>(b) * m;
+        std::vector<Element> x(xBegin, xBegin + n);
+        std::vector<Element> y(yBegin, yBegin + m);
+        std::vector<float> single(m);
+        golden::ComputeGemv(problemShape, alpha, beta, hostA, layoutA, x, layoutVx, y, layoutVy, single, layoutVy);
+        exact = exact && (std::memcmp(single.data(), batched.data() + static_cast<size_t>(b) * m,
+            m * sizeof(float)) == 0);
+    }
+    Check(exact, "ComputeGemvBatch equals ComputeGemv per vector, " + ShapeStr(batch, m, n) +
+        (std::is_same_v<Element, float> ? " fp32" : " fp16"));
+}
+
+void CheckSelection(uint32_t m, uint32_t n, uint32_t elementBytes)
+{
+    GemvCoord problemShape{m, n};
+    std::string tag = std::to_string(m) + "x" + std::to_string(n) + " " + std::to_string(elementBytes) + "B";
+    Check(Gemv::SelectBatchedGemvCore(problemShape, 1, elementBytes) == Gemv::BatchedGemvCore::AIV,
+        "one vector goes to AIV, " + tag);
+    Check(Gemv::SelectBatchedGemvCore(problemShape, MAX_BATCH, elementBytes) == Gemv::BatchedGemvCore::AIC,
+        "a full batch goes to AIC, " + tag);
+
+    // within one pass of A, once AIC wins a larger batch never goes back to AIV
+    bool seenAic = false;
+    bool monotonic = true;
+    for (uint32_t batch = 1; batch <= MAX_BATCH; ++batch) {
+        bool aic = Gemv::SelectBatchedGemvCore(problemShape, batch, elementBytes) == Gemv::BatchedGemvCore::AIC;
+        monotonic = monotonic && (aic || !seenAic);
+        seenAic = seenAic || aic;
+    }
+    Check(monotonic, "choice is monotonic in the batch, " + tag);
+}
+
+uint32_t Crossover(uint32_t m, uint32_t n, uint32_t elementBytes)
+{
+    for (uint32_t batch = 1; batch <= MAX_BATCH; ++batch) {
+        if (Gemv::SelectBatchedGemvCore(GemvCoord{m, n}, batch, elementBytes) == Gemv::BatchedGemvCore::AIC) {
+            return batch;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<std::pair<uint32_t, uint32_t>> goldenShapes = {{1, 1}, {7, 33}, {64, 128}, {100, 257}};
+    for (uint32_t batch : {1u, 3u, 16u, 17u}) {
+        for (auto const &shape : goldenShapes) {
+            CheckGolden<float>(batch, shape.first, shape.second);
+            CheckGolden<fp16_t>(batch, shape.first, shape.second);
+        }
+    }
+
+    const std::vector<std::pair<uint32_t, uint32_t>> largeShapes = {{4096, 4096}, {8192, 4096}, {4096, 11008}};
+    for (auto const &shape : largeShapes) {
+        CheckSelection(shape.first, shape.second, 2);
+        CheckSelection(shape.first, shape.second, 4);
+    }
+
+    printf("%-14s %-10s %-10s\n", "m x n", "fp16", "fp32");
+    const std::vector<std::pair<uint32_t, uint32_t>> tableShapes = {
+        {256, 512}, {1024, 1024}, {2048, 2048}, {4096, 4096}, {8192, 4096}, {4096, 11008}
+    };
+    for (auto const &shape : tableShapes) {
+        uint32_t fp16Batch = Crossover(shape.first, shape.second, 2);
+        uint32_t fp32Batch = Crossover(shape.first, shape.second, 4);
+        std::string name = std::to_string(shape.first) + "x" + std::to_string(shape.second);
+        printf("%-14s %-10s %-10s\n", name.c_str(),
+            fp16Batch ? (">=" + std::to_string(fp16Batch)).c_str() : "AIV",
+            fp32Batch ? (">=" + std::to_string(fp32Batch)).c_str() : "AIV");
+    }
+
+    return HostTest::Report();
+}
@@ -0,0 +1,65 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_TESTS_COMMON_HOST_TEST_HPP
+#define CATLASS_TESTS_COMMON_HOST_TEST_HPP
+
+// Shared by the host tests: a failure counter with its report, and the core queries of AscendC that the host side
+// of the block schedulers calls. Include it before the catlass headers.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#ifndef __CCE__
+// A host test runs as core 0 of one core
+namespace AscendC {
+inline int64_t GetBlockNum()
+{
+    return 1;
+}
+inline int64_t GetBlockIdx()
+{
+    return 0;
+}
+} // namespace AscendC
+#endif
+
+namespace HostTest {
+
+inline int &Failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+// Prints what failed and goes on, so one run reports every failed check
+inline void Check(bool condition, const std::string &what)
+{
+    if (!condition) {
+        printf("FAILED: %s\n", what.c_str());
+        ++Failures();
+    }
+}
+
+// Prints the result of the checks, returns the exit code of the test
+inline int Report()
+{
+    if (Failures() != 0) {
+        printf("%d check(s) failed\n", Failures());
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
+
+} // namespace HostTest
+
+#endif // CATLASS_TESTS_COMMON_HOST_TEST_HPP
@@ -0,0 +1,253 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the conv tile planner.
+// The footprints match the buffers BlockConv2d and BlockConv carve on hand-computed cases, a shape fits exactly when
+// its footprint is within L1, L0A, L0B, L0C and the bias table, and the plan of every layer of a ResNet-50 and UNet
+// mix fits and is the fitting menu shape of lowest estimated cycles. The conv3d plans keep a floor of predicted cube
+// utilisation. The plan of each layer is printed with its predicted utilisation next to the shape the examples used
+// to hardcode.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "host_test.hpp"
+
+#include "catlass/conv/conv_tile_planner.hpp"
+
+using namespace Catlass;
+using namespace Catlass::Conv;
+
+namespace {
+
+using HostTest::Check;
+
+struct Conv2dLayer {
+    const char *name;
+    uint32_t batch, hi, wi, cin, cout;
+    uint8_t k, pad, stride;
+};
+
+Conv2dParams MakeParams(Conv2dLayer const &layer)
+{
+    return Conv2dParams(layer.batch, layer.hi, layer.wi, layer.cin, layer.cout, layer.k, layer.k,
+        layer.pad, layer.pad, layer.pad, layer.pad, layer.stride, layer.stride, 1, 1);
+}
+
+// ResNet-50 and UNet layers at batch 8 and 1
+const std::vector<Conv2dLayer> CONV2D_LAYERS = {
+    {"resnet.stem", 8, 224, 224, 3, 64, 7, 3, 2},
+    {"resnet.l1.1x1", 8, 56, 56, 64, 64, 1, 0, 1},
+    {"resnet.l1.3x3", 8, 56, 56, 64, 64, 3, 1, 1},
+    {"resnet.l1.expand", 8, 56, 56, 64, 256, 1, 0, 1},
+    {"resnet.l2.3x3", 8, 28, 28, 128, 128, 3, 1, 1},
+    {"resnet.l2.down", 8, 56, 56, 128, 128, 3, 1, 2},
+    {"resnet.l3.3x3", 8, 14, 14, 256, 256, 3, 1, 1},
+    {"resnet.l3.expand", 8, 14, 14, 256, 1024, 1, 0, 1},
+    {"resnet.l4.3x3", 8, 7, 7, 512, 512, 3, 1, 1},
+    {"resnet.l4.reduce", 8, 7, 7, 2048, 512, 1, 0, 1},
+    {"unet.enc1", 1, 256, 256, 64, 64, 3, 1, 1},
+    {"unet.enc3", 1, 64, 64, 256, 256, 3, 1, 1},
+    {"unet.bottleneck", 1, 16, 16, 1024, 1024, 3, 1, 1},
+    {"unet.dec4", 1, 128, 128, 128, 64, 3, 1, 1},
+    {"unet.head", 1, 256, 256, 64, 2, 1, 0, 1},
+    {"example33", 2, 33, 43, 112, 80, 3, 2, 1},
+};
+
+void CheckConv2dFootprint()
+{
+    auto shapes = Conv2dTileMenuAtlasA2::GetShapes();
+    Conv2dTileShape const &hardcoded = shapes[0];
+
+    // the layer of examples/33_basic_conv2d on its former shape: a 10 x 14 halo of 8 cin1 and 8 x 3 x 3 x 96 filter
+    // per stage in L1, 96 x 144 of fmap and 144 x 80 of filter in L0, 96 x 80 accumulators in L0C
+    Conv2dParams params = MakeParams(CONV2D_LAYERS.back());
+    ConvTileFootprint footprint = GetConv2dTileFootprint(params, hardcoded);
+    Check(footprint.l1Bytes == (8 * 10 * 14 * 32 + 8 * 9 * 96 * 32) * 2, "example33 L1 bytes");
+    Check(footprint.l0aBytes == 96 * 144 * 2, "example33 L0A bytes");
+    Check(footprint.l0bBytes == 144 * 80 * 2, "example33 L0B bytes");
+    Check(footprint.l0cBytes == 96 * 80 * 4, "example33 L0C bytes");
+    Check(Conv2dTileFits(params, hardcoded), "example33 fits its former shape");
+
+    // a 3x3 of stride 2 needs a 17 x 25 halo, too much L1 beside the double buffered filter
+    Conv2dParams strided(1, 56, 56, 128, 128, 3, 3, 1, 1, 1, 1, 2, 2, 1, 1);
+    Check(GetConv2dTileFootprint(strided, hardcoded).l1Bytes == (8 * 17 * 25 * 32 + 8 * 9 * 96 * 32) * 2,
+        "stride 2 L1 bytes");
+    Check(!Conv2dTileFits(strided, hardcoded), "stride 2 does not fit the former shape");
+
+    // a 7x7 takes 784 of K for a single cin1, 96 rows of it overflow a buffer of L0A
+    Conv2dParams stem = MakeParams(CONV2D_LAYERS.front());
+    Check(GetConv2dTileFootprint(stem, hardcoded).l0aBytes == 96 * 784 * 2, "7x7 L0A bytes");
+    Check(!Conv2dTileFits(stem, hardcoded), "7x7 does not fit the former shape");
+
+    // a shape fits exactly when its footprint is within the buffers
+    for (auto const &layer : CONV2D_LAYERS) {
+        Conv2dParams layerParams = MakeParams(layer);
+        for (uint32_t i = 0; i < shapes.size(); ++i) {
+            ConvTileFootprint fp = GetConv2dTileFootprint(layerParams, shapes[i]);
+            bool within = (fp.l1Bytes <= Arch::AtlasA2::L1_SIZE) && (fp.l0aBytes <= Arch::AtlasA2::L0A_SIZE / 2) &&
+                (fp.l0bBytes <= Arch::AtlasA2::L0B_SIZE / 2) && (fp.l0cBytes <= Arch::AtlasA2::L0C_SIZE);
+            Check(within == Conv2dTileFits(layerParams, shapes[i]),
+                std::string(layer.name) + " fit of shape " + std::to_string(i) + " follows its footprint");
+        }
+    }
+
+    // static requirements of BlockConv2d
+    Conv2dTileShape bad = hardcoded;
+    bad.filterCin1 = 12;
+    Check(!Conv2dTileFits(params, bad), "filter cin1 not a multiple of the fmap one is rejected");
+    bad = hardcoded;
+    bad.filterCout = 88;
+    Check(!Conv2dTileFits(params, bad), "cout tile off the fractal is rejected");
+}
+
+void CheckConv2dPlans()
+{
+    auto shapes = Conv2dTileMenuAtlasA2::GetShapes();
+    printf("%-18s %-6s %-8s %-8s %-10s %-8s\n", "layer", "shape", "L1", "util", "former", "speedup");
+    for (auto const &layer : CONV2D_LAYERS) {
+        Conv2dParams params = MakeParams(layer);
+        ConvTilePlan plan = PlanConv2dTile(params, shapes.data(), shapes.size());
+        std::string name = layer.name;
+        Check(plan.index >= 0, name + " has a plan");
+        if (plan.index < 0) {
+            continue;
+        }
+        Check(Conv2dTileFits(params, shapes[plan.index]), name + " plan fits");
+        Check(plan.estimate.cubeUtilisation > 0 && plan.estimate.cubeUtilisation <= 1.0,
+            name + " utilisation in (0, 1]");
+        for (uint32_t i = 0; i < shapes.size(); ++i) {
+            ConvTileEstimate other = EstimateConv2dTile(params, shapes[i]);
+            Check(!other.fits || plan.estimate.cycles <= other.cycles, name + " plan is the fastest fitting shape");
+        }
+
+        ConvTileEstimate former = EstimateConv2dTile(params, shapes[0]);
+        std::string formerStr = former.fits ? std::to_string(static_cast<int>(former.cubeUtilisation * 100)) + "%" :
+            "no fit";
+        std::string speedup = former.fits ? std::to_string(former.cycles / plan.estimate.cycles).substr(0, 4) : "-";
+        printf("%-18s %-6d %-8s %-8s %-10s %-8s\n", layer.name, plan.index,
+            (std::to_string(static_cast<int>(plan.estimate.l1Utilisation * 100)) + "%").c_str(),
+            (std::to_string(static_cast<int>(plan.estimate.cubeUtilisation * 100)) + "%").c_str(),
+            formerStr.c_str(), speedup.c_str());
+    }
+
+    // small maps of many channels leave most of the former shape idle, the plan uses another one
+    ConvTilePlan small = PlanConv2dTile(MakeParams(CONV2D_LAYERS[8]), shapes.data(), shapes.size());
+    Check(small.index != 0, "resnet.l4.3x3 moves off the former shape");
+}
+
+struct Conv3dLayer {
+    const char *name;
+    uint32_t batch, di, cin1, hi, wi, cout;
+    uint32_t kd, kh, kw;
+    uint32_t pad, stride;
+};
+
+Conv3dParams MakeParams(Conv3dLayer const &layer)
+{
+    uint32_t fmapShape[6] = {layer.batch, layer.di, layer.cin1, layer.hi, layer.wi, 16};
+    uint32_t filterShape[4] = {layer.kd, layer.kh, layer.kw, layer.cout};
+    uint32_t pads[3] = {layer.pad, layer.pad, layer.pad};
+    uint32_t strides[3] = {layer.stride, layer.stride, layer.stride};
+    uint32_t dilations[3] = {1, 1, 1};
+    return Conv3dParams::MakeConvCoord(fmapShape, filterShape, pads, strides, dilations);
+}
+
+const std::vector<Conv3dLayer> CONV3D_LAYERS = {
+    {"example24", 32, 1, 4, 32, 48, 128, 1, 1, 1, 0, 1},
+    {"video.1x1", 2, 8, 4, 28, 28, 256, 1, 1, 1, 0, 1},
+    {"video.3x3x3", 1, 8, 4, 28, 28, 64, 3, 3, 3, 1, 1},
+    {"medical.3x3x3", 1, 32, 2, 64, 64, 32, 3, 3, 3, 1, 1},
+};
+
+// The 1x1 layers of CONV3D_LAYERS are bound by GM at about 15% of the cube, the former shapes got 1-6% on all of them
+constexpr double CONV3D_UTILISATION_FLOOR = 0.12;
+
+void CheckConv3d()
+{
+    auto shapes = Conv3dTileMenuAtlasA2::GetShapes();
+
+    // the layer of examples/24_conv_bias on its former shape, the L1 bound of its README: two rows of 48 of the
+    // fmap, a 1x1 filter of 16 cout and 16 floats of bias
+    Conv3dParams params = MakeParams(CONV3D_LAYERS[0]);
+    ConvTileFootprint footprint = GetConv3dTileFootprint(params, shapes[0]);
+    Check(footprint.l1Bytes == 2 * 48 * 32 + 512 + 64, "example24 L1 bytes");
+    Check(footprint.l0aBytes == 16 * 16 * 2 * 2, "example24 L0A bytes");
+    Check(footprint.btBytes == 16 * 4, "example24 bias table bytes");
+    Check(Conv3dTileFits(params, shapes[0]), "example24 fits its former shape");
+
+    // the L0 tiles must split the K of an L1 tile, 3x3x3 of 16 does not split in 32
+    Conv3dParams cube = MakeParams(CONV3D_LAYERS[2]);
+    Conv3dTileShape odd = shapes[0];
+    odd.kL0 = 32;
+    Check(!Conv3dTileFits(cube, odd), "kL0 not splitting kAL1 is rejected");
+    // the bias table holds 256 floats
+    odd = shapes[0];
+    odd.nBL1 = 512;
+    odd.nL0 = 512;
+    Check(GetConv3dTileFootprint(params, odd).btBytes > Arch::AtlasA2::BIAS_SIZE && !Conv3dTileFits(params, odd),
+        "nL0 over the bias table is rejected");
+
+    printf("%-18s %-6s %-8s %-8s %-10s\n", "layer", "shape", "L1", "util", "former");
+    for (auto const &layer : CONV3D_LAYERS) {
+        Conv3dParams layerParams = MakeParams(layer);
+        ConvTilePlan plan = PlanConv3dTile(layerParams, shapes.data(), shapes.size());
+        std::string name = layer.name;
+        Check(plan.index >= 0, name + " has a plan");
+        if (plan.index < 0) {
+            continue;
+        }
+        Check(Conv3dTileFits(layerParams, shapes[plan.index]), name + " plan fits");
+        Check(plan.estimate.cubeUtilisation > 0 && plan.estimate.cubeUtilisation <= 1.0,
+            name + " utilisation in (0, 1]");
+        Check(plan.estimate.cubeUtilisation >= CONV3D_UTILISATION_FLOOR,
+            name + " utilisation over " + std::to_string(static_cast<int>(CONV3D_UTILISATION_FLOOR * 100)) + "%");
+        for (uint32_t i = 0; i < shapes.size(); ++i) {
+            ConvTileEstimate other = EstimateConv3dTile(layerParams, shapes[i]);
+            Check(!other.fits || plan.estimate.cycles <= other.cycles, name + " plan is the fastest fitting shape");
+        }
+        ConvTileEstimate former = EstimateConv3dTile(layerParams, shapes[0]);
+        std::string formerStr = former.fits ? std::to_string(static_cast<int>(former.cubeUtilisation * 100)) + "%" :
+            "no fit";
+        printf("%-18s %-6d %-8s %-8s %-10s\n", layer.name, plan.index,
+            (std::to_string(static_cast<int>(plan.estimate.l1Utilisation * 100)) + "%").c_str(),
+            (std::to_string(static_cast<int>(plan.estimate.cubeUtilisation * 100)) + "%").c_str(),
+            formerStr.c_str());
+    }
+}
+
+void CheckDispatch()
+{
+    auto shapes = Conv2dTileMenuAtlasA2::GetShapes();
+    for (uint32_t i = 0; i < Conv2dTileMenuAtlasA2::SIZE; ++i) {
+        Conv2dTileShape seen;
+        bool dispatched = Conv2dTileMenuAtlasA2::Dispatch(i, [&](auto config) {
+            seen = decltype(config)::ToShape();
+        });
+        Check(dispatched && seen.fmapHo == shapes[i].fmapHo && seen.filterCout == shapes[i].filterCout &&
+            seen.l0K == shapes[i].l0K, "dispatch " + std::to_string(i) + " runs its config");
+    }
+    Check(!Conv2dTileMenuAtlasA2::Dispatch(Conv2dTileMenuAtlasA2::SIZE, [](auto) {}),
+        "dispatch out of the menu runs nothing");
+}
+
+} // namespace
+
+int main()
+{
+    CheckConv2dFootprint();
+    CheckConv2dPlans();
+    CheckConv3d();
+    CheckDispatch();
+
+    return HostTest::Report();
+}
@@ -0,0 +1,300 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the task plan of the flash attention infer example.
+// Usage: fai_task_plan_test
+// For every synthetic batch the tasks are planned and checked:
+//   - the pieces of every task of the kernel cover its kv once, a masked task never reads more kv than its batch
+//     holds, and only the last piece of a split task runs the masked stage,
+//   - the split tasks own disjoint partial output slots, listed once for the combine step,
+//   - the pieces of a core never go back in task order, and the batch walk of FAInferKernel finds every batch,
+//   - the busiest core exceeds the mean by at most the costliest piece, and never the round-robin walk.
+// The makespan is compared with the round-robin walk the kernel used before, and with the plan of whole tasks.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "fai_task_plan.hpp"
+
+using namespace FAInferTiling;
+
+namespace {
+
+struct PlanCase {
+    const char *name;
+    std::vector<int64_t> qSeqlen;
+    std::vector<int64_t> kvSeqlen;
+    uint32_t numHeads;
+    uint32_t kvHeads;
+    bool masked;
+    uint32_t coreNum;
+    double minSpeedup;      // round-robin makespan over the planned one
+    double minSplitGain;    // makespan of the plan of whole tasks over the planned one
+};
+
+FATaskPlanInfo GetPlanInfo(PlanCase const &planCase)
+{
+    FATaskPlanInfo info;
+    info.batch = planCase.qSeqlen.size();
+    info.numHeads = planCase.numHeads;
+    info.kvHeads = planCase.kvHeads;
+    info.blockSize = 128;
+    info.masked = planCase.masked;
+    info.qSeqlenList = planCase.qSeqlen.data();
+    info.kvSeqlenList = planCase.kvSeqlen.data();
+    info.coreNum = planCase.coreNum;
+    return info;
+}
+
+// A few long contexts among many short ones
+PlanCase MixedCase(const char *name, uint32_t batch, uint32_t longNum, int64_t qSeqlen, int64_t longKv,
+    int64_t shortKv, bool masked)
+{
+    PlanCase planCase{name, {}, {}, 8, 1, masked, 24, 1.0, 1.0};
+    for (uint32_t i = 0; i < batch; ++i) {
+        int64_t kvSeqlen = (i % (batch / longNum) == 0) ? longKv : shortKv;
+        planCase.qSeqlen.push_back(std::min(qSeqlen, kvSeqlen));
+        planCase.kvSeqlen.push_back(kvSeqlen);
+    }
+    return planCase;
+}
+
+PlanCase RandomCase(const char *name, uint32_t batch, int64_t qSeqlen, int64_t maxKv, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    PlanCase planCase{name, {}, {}, 16, 2, true, 20, 1.0, 1.0};
+    for (uint32_t i = 0; i < batch; ++i) {
+        // long tailed kv lengths, as in serving traffic
+        int64_t kvSeqlen = std::max<int64_t>(qSeqlen, static_cast<int64_t>(maxKv >> (rng() % 8)) - rng() % 100);
+        planCase.qSeqlen.push_back(qSeqlen);
+        planCase.kvSeqlen.push_back(kvSeqlen);
+    }
+    return planCase;
+}
+
+// Replays the batch walk of FAInferKernel over the pieces of one core.
+bool CheckKernelWalk(PlanCase const &planCase, FATaskPlan const &plan, std::vector<FATask> const &tasks,
+    uint32_t coreIdx)
+{
+    FATaskPlanInfo info = GetPlanInfo(planCase);
+    uint32_t groupSize = info.numHeads / info.kvHeads;
+    uint32_t curBatch = 0;
+    uint32_t preTotalTaskNum = 0;
+    auto batchTaskNum = [&](uint32_t batchIdx) {
+        uint32_t qNBlockTile = GetQNBlockTile(info.qSeqlenList[batchIdx], groupSize);
+        uint32_t qNBlockNum = (groupSize + qNBlockTile - 1) / qNBlockTile * info.kvHeads;
+        uint32_t qSBlockTile = GetQSBlockTile();
+        return qNBlockNum * static_cast<uint32_t>((info.qSeqlenList[batchIdx] + qSBlockTile - 1) / qSBlockTile);
+    };
+    uint32_t curTotalTaskNum = batchTaskNum(0);
+    for (uint32_t i = plan.coreOffsets[coreIdx]; i < plan.coreOffsets[coreIdx + 1]; ++i) {
+        uint32_t taskIdx = plan.tasks[i].taskIdx;
+        while (taskIdx >= curTotalTaskNum) {
+            ++curBatch;
+            preTotalTaskNum = curTotalTaskNum;
+            if (curBatch >= info.batch) {
+                printf("%s: core %u walked past the last batch at task %u\n", planCase.name, coreIdx, taskIdx);
+                return false;
+            }
+            curTotalTaskNum += batchTaskNum(curBatch);
+        }
+        if (curBatch != tasks[taskIdx].batchIdx || taskIdx < preTotalTaskNum) {
+            printf("%s: core %u found batch %u for task %u of batch %u\n", planCase.name, coreIdx, curBatch, taskIdx,
+                tasks[taskIdx].batchIdx);
+            return false;
+        }
+    }
+    return true;
+}
+
+// The pieces of a task cover [0, kvEnd) of the task once, in whole kv stacks but the last, which alone keeps the
+// masked stage. A split task owns splitNum partial slots no other task uses.
+bool CheckPieces(PlanCase const &planCase, FATaskPlan const &plan, std::vector<FATask> const &tasks)
+{
+    FATaskPlanInfo info = GetPlanInfo(planCase);
+    uint32_t stackKvS = KV_BLOCK_STACK_NUM * info.blockSize;
+    std::vector<std::vector<FATask>> pieces(tasks.size());
+    for (FATask const &piece : plan.tasks) {
+        pieces[piece.taskIdx].push_back(piece);
+    }
+    std::vector<uint32_t> slotOwners(plan.partialNum, 0);
+    uint32_t splitTaskNum = 0;
+    for (FATask const &task : tasks) {
+        std::vector<FATask> &curPieces = pieces[task.taskIdx];
+        std::sort(curPieces.begin(), curPieces.end(), [](FATask const &a, FATask const &b) {
+            return a.splitIdx < b.splitIdx;
+        });
+        if (curPieces.empty() || curPieces.size() != curPieces[0].splitNum || curPieces.size() > KV_SPLIT_MAX) {
+            printf("%s: task %u has %zu pieces\n", planCase.name, task.taskIdx, curPieces.size());
+            return false;
+        }
+        uint32_t splitNum = curPieces[0].splitNum;
+        uint32_t kvStart = 0;
+        for (uint32_t splitIdx = 0; splitIdx < splitNum; ++splitIdx) {
+            FATask const &piece = curPieces[splitIdx];
+            bool isLast = (splitIdx == splitNum - 1);
+            bool stackEnd = isLast || (piece.kvEnd % stackKvS == 0 && piece.kvEnd + Q_ROW_NUM_CEIL <= task.kvEnd);
+            if (piece.splitIdx != splitIdx || piece.splitNum != splitNum || piece.kvStart != kvStart ||
+                (piece.kvEnd <= piece.kvStart && task.kvEnd != 0) || !stackEnd || piece.masked != (task.masked && isLast) ||
+                piece.partialIdx != curPieces[0].partialIdx) {
+                printf("%s: piece %u of task %u covers [%u, %u) of %u\n", planCase.name, splitIdx, task.taskIdx,
+                    piece.kvStart, piece.kvEnd, task.kvEnd);
+                return false;
+            }
+            kvStart = piece.kvEnd;
+        }
+        if (kvStart != task.kvEnd) {
+            printf("%s: pieces of task %u end at %u of %u\n", planCase.name, task.taskIdx, kvStart, task.kvEnd);
+            return false;
+        }
+        if (splitNum == 1) {
+            continue;
+        }
+        if (splitTaskNum >= plan.splitTasks.size() || plan.splitTasks[splitTaskNum].taskIdx != task.taskIdx ||
+            plan.splitTasks[splitTaskNum].splitNum != splitNum ||
+            plan.splitTasks[splitTaskNum].partialIdx != curPieces[0].partialIdx ||
+            curPieces[0].partialIdx + splitNum > plan.partialNum || task.rowNum > plan.partialRowNum) {
+            printf("%s: split task %u is not in the combine list\n", planCase.name, task.taskIdx);
+            return false;
+        }
+        for (uint32_t slot = curPieces[0].partialIdx; slot < curPieces[0].partialIdx + splitNum; ++slot) {
+            slotOwners[slot]++;
+        }
+        splitTaskNum++;
+    }
+    if (splitTaskNum != plan.splitTasks.size() ||
+        std::any_of(slotOwners.begin(), slotOwners.end(), [](uint32_t count) { return count != 1; })) {
+        printf("%s: %zu split tasks listed, %u found, partial slots shared\n", planCase.name, plan.splitTasks.size(),
+            splitTaskNum);
+        return false;
+    }
+    return true;
+}
+
+bool CheckPlan(PlanCase const &planCase)
+{
+    FATaskPlanInfo info = GetPlanInfo(planCase);
+    std::vector<FATask> tasks = GetFATasks(info);
+    FATaskPlan plan = GetFATaskPlan(info);
+    bool success = true;
+    if (plan.taskNum != tasks.size() || plan.tasks.size() < tasks.size() ||
+        plan.coreOffsets.size() != info.coreNum + 1 || plan.coreOffsets.back() != plan.tasks.size()) {
+        printf("%s: %zu pieces planned in %zu ranges\n", planCase.name, plan.tasks.size(), plan.coreOffsets.size());
+        return false;
+    }
+    for (FATask const &task : tasks) {
+        if (task.kvEnd > info.kvSeqlenList[task.batchIdx]) {
+            printf("%s: task %u reads %u kv of %ld\n", planCase.name, task.taskIdx, task.kvEnd,
+                info.kvSeqlenList[task.batchIdx]);
+            success = false;
+        }
+    }
+    success = CheckPieces(planCase, plan, tasks) && success;
+
+    uint64_t totalCost = 0;
+    uint64_t maxTaskCost = 0;
+    for (uint32_t coreIdx = 0; coreIdx < info.coreNum; ++coreIdx) {
+        uint64_t coreCost = 0;
+        for (uint32_t i = plan.coreOffsets[coreIdx]; i < plan.coreOffsets[coreIdx + 1]; ++i) {
+            FATask const &task = plan.tasks[i];
+            if (i > plan.coreOffsets[coreIdx] && (task.taskIdx < plan.tasks[i - 1].taskIdx ||
+                (task.taskIdx == plan.tasks[i - 1].taskIdx && task.splitIdx <= plan.tasks[i - 1].splitIdx))) {
+                printf("%s: pieces of core %u go back in task order\n", planCase.name, coreIdx);
+                success = false;
+            }
+            coreCost += task.cost;
+            maxTaskCost = std::max(maxTaskCost, task.cost);
+        }
+        totalCost += coreCost;
+        if (coreCost != plan.coreCosts[coreIdx]) {
+            printf("%s: core %u costs %lu, plan says %lu\n", planCase.name, coreIdx, coreCost, plan.coreCosts[coreIdx]);
+            success = false;
+        }
+        success = CheckKernelWalk(planCase, plan, tasks, coreIdx) && success;
+    }
+
+    // the least loaded core takes each piece, so no core exceeds the mean by more than one piece
+    uint64_t maxCoreCost = plan.GetMakespan();
+    uint64_t combineCost = (plan.combineCost + info.coreNum - 1) / info.coreNum;
+    uint64_t bound = (totalCost + info.coreNum - 1) / info.coreNum + maxTaskCost + combineCost;
+    if (maxCoreCost > bound) {
+        printf("%s: busiest core costs %lu, bound %lu\n", planCase.name, maxCoreCost, bound);
+        success = false;
+    }
+    uint64_t roundRobin = GetRoundRobinMakespan(info);
+    double speedup = static_cast<double>(roundRobin) / maxCoreCost;
+    if (maxCoreCost > roundRobin || speedup < planCase.minSpeedup) {
+        printf("%s: makespan %lu, round-robin %lu, speedup %.2fx below %.2fx\n", planCase.name, maxCoreCost,
+            roundRobin, speedup, planCase.minSpeedup);
+        success = false;
+    }
+    // the plan of whole tasks, as without split-KV
+    FATaskPlanInfo wholeInfo = info;
+    wholeInfo.kvSplitMax = 1;
+    FATaskPlan wholePlan = GetFATaskPlan(wholeInfo);
+    double splitGain = static_cast<double>(wholePlan.GetMakespan()) / maxCoreCost;
+    if (splitGain < planCase.minSplitGain || !wholePlan.splitTasks.empty() || wholePlan.tasks.size() != tasks.size()) {
+        printf("%s: makespan %lu, whole tasks %lu, gain %.2fx below %.2fx\n", planCase.name, maxCoreCost,
+            wholePlan.GetMakespan(), splitGain, planCase.minSplitGain);
+        success = false;
+    }
+    double mean = static_cast<double>(totalCost + plan.combineCost) / info.coreNum;
+    printf("%-14s tasks=%-5u pieces=%-5zu cores=%-3u max/mean %.3f, speedup over round-robin %.2fx, "
+        "over whole tasks %.2fx\n", planCase.name, plan.taskNum, plan.tasks.size(), info.coreNum, maxCoreCost / mean,
+        speedup, splitGain);
+    return success;
+}
+
+// Without cores the plan is empty, it still has the leading offset the tiling reads
+bool CheckNoCore()
+{
+    PlanCase planCase = MixedCase("no-core", 4, 1, 1, 4096, 512, false);
+    planCase.coreNum = 0;
+    FATaskPlanInfo info = GetPlanInfo(planCase);
+    FATaskPlan plan = GetFATaskPlan(info);
+    bool success = plan.tasks.empty() && plan.coreOffsets.size() == 1 && plan.coreOffsets[0] == 0 &&
+        plan.GetMakespan() == 0 && GetRoundRobinMakespan(info) == 0;
+    if (!success) {
+        printf("no-core: %zu tasks planned in %zu ranges\n", plan.tasks.size(), plan.coreOffsets.size());
+    }
+    return success;
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<PlanCase> cases{
+        MixedCase("decode-32k", 64, 4, 1, 32768, 512, false),
+        MixedCase("spec-32k", 48, 3, 4, 32768, 512, true),
+        MixedCase("prefill-32k", 16, 2, 32768, 32768, 512, true),
+        MixedCase("decode-even", 48, 1, 1, 4096, 4096, false),
+        RandomCase("decode-random", 96, 1, 65536, 1),
+        RandomCase("spec-random", 40, 3, 16384, 2),
+        MixedCase("tiny", 2, 1, 7, 300, 5, true),
+        // q longer than kv: the first q rows of a masked batch see no kv
+        PlanCase{"q-over-kv", {4096, 1000, 300, 129}, {300, 64, 300, 1}, 8, 1, true, 24, 1.0, 1.0},
+    };
+    cases[0].minSpeedup = 5.0;
+    cases[0].minSplitGain = 3.0;
+    cases[1].minSpeedup = 3.0;
+    cases[1].minSplitGain = 3.0;
+    cases[4].minSpeedup = 1.2;
+    cases[5].minSpeedup = 2.5;
+    bool success = CheckNoCore();
+    for (auto const &planCase : cases) {
+        success = CheckPlan(planCase) && success;
+    }
+    printf(success ? "all checks passed\n" : "FAILED\n");
+    return success ? 0 : 1;
+}
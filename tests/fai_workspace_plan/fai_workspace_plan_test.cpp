@@ -0,0 +1,270 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the workspace plan of the flash attention infer example.
+// Usage: fai_workspace_plan_test
+// For every synthetic batch the workspace accesses of FAInferKernel are replayed on the planned tiling:
+//   - every stage of every piece uses a slot of its ring and reads and writes inside the slot,
+//   - the rings of a core stay inside the buffer of the core, the buffers inside the workspace,
+//   - the partial outputs and lse of the split tasks stay inside O_UPDATE,
+//   - the buffers do not overlap.
+// The planned size is compared with the fixed size the example allocated before.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "fai_task_plan.hpp"
+#include "fai_workspace_plan.hpp"
+
+using namespace FAInferTiling;
+
+namespace {
+
+constexpr uint64_t LEGACY_BLOCK_SIZE = 131072;
+constexpr uint32_t LEGACY_SLOT_NUM = 3;
+constexpr uint32_t ELEMENT_SIZE_S = 4;
+constexpr uint32_t ELEMENT_SIZE_P = 2;
+constexpr uint32_t ELEMENT_SIZE_O_TMP = 4;
+
+struct WorkspaceCase {
+    const char *name;
+    std::vector<int64_t> qSeqlen;
+    std::vector<int64_t> kvSeqlen;
+    uint32_t numHeads;
+    uint32_t kvHeads;
+    uint32_t embeddingSize;
+    bool masked;
+    uint32_t coreNum;
+    double minSaving;       // legacy size over the planned one
+};
+
+FATaskPlanInfo GetPlanInfo(WorkspaceCase const &workspaceCase)
+{
+    FATaskPlanInfo info;
+    info.batch = workspaceCase.qSeqlen.size();
+    info.numHeads = workspaceCase.numHeads;
+    info.kvHeads = workspaceCase.kvHeads;
+    info.blockSize = 128;
+    info.masked = workspaceCase.masked;
+    info.qSeqlenList = workspaceCase.qSeqlen.data();
+    info.kvSeqlenList = workspaceCase.kvSeqlen.data();
+    info.coreNum = workspaceCase.coreNum;
+    return info;
+}
+
+WorkspaceCase UniformCase(const char *name, uint32_t batch, int64_t qSeqlen, int64_t kvSeqlen, uint32_t numHeads,
+    uint32_t kvHeads, uint32_t embeddingSize, bool masked)
+{
+    WorkspaceCase workspaceCase{name, {}, {}, numHeads, kvHeads, embeddingSize, masked, 24, 1.0};
+    for (uint32_t i = 0; i < batch; ++i) {
+        workspaceCase.qSeqlen.push_back(qSeqlen);
+        workspaceCase.kvSeqlen.push_back(kvSeqlen);
+    }
+    return workspaceCase;
+}
+
+bool CheckRange(const char *name, const char *what, uint64_t begin, uint64_t end, uint64_t lower, uint64_t upper)
+{
+    if (begin < lower || end > upper) {
+        printf("%s: %s [%lu, %lu) leaves [%lu, %lu)\n", name, what, begin, end, lower, upper);
+        return false;
+    }
+    return true;
+}
+
+// Replays the stages of FAInferKernel for the tasks of every core and checks the slots they touch.
+bool CheckKernelAccess(WorkspaceCase const &workspaceCase, FAWorkspacePlan const &plan)
+{
+    const char *name = workspaceCase.name;
+    FATaskPlanInfo info = GetPlanInfo(workspaceCase);
+    FATaskPlan taskPlan = GetFATaskPlan(info);
+    uint32_t groupSize = info.numHeads / info.kvHeads;
+    uint32_t blockStackNum = 4;
+    uint32_t preLaunch = 2;
+    uint32_t stackSeqTilePad = blockStackNum * info.blockSize;
+    uint32_t embedRound = (workspaceCase.embeddingSize + 15) / 16 * 16;
+    uint64_t sRingSize = static_cast<uint64_t>(plan.sSlotSize) * plan.slotNum;
+    uint64_t oTmpRingSize = static_cast<uint64_t>(plan.oTmpSlotSize) * plan.slotNum;
+    bool success = true;
+
+    for (uint32_t coreIdx = 0; coreIdx < info.coreNum; ++coreIdx) {
+        for (uint32_t i = taskPlan.coreOffsets[coreIdx]; i < taskPlan.coreOffsets[coreIdx + 1]; ++i) {
+            uint32_t taskIdx = taskPlan.tasks[i].taskIdx;
+            // decode the task as the kernel does
+            uint32_t curBatch = 0;
+            uint32_t preTotalTaskNum = 0;
+            uint32_t curQNBlockNum = 0;
+            uint32_t qNBlockNumPerGroup = 0;
+            uint32_t curQNBlockTile = 0;
+            uint32_t curQSBlockTile = 0;
+            uint32_t curQSBlockNum = 0;
+            for (curBatch = 0; curBatch < info.batch; ++curBatch) {
+                curQNBlockTile = GetQNBlockTile(info.qSeqlenList[curBatch], groupSize);
+                qNBlockNumPerGroup = (groupSize + curQNBlockTile - 1) / curQNBlockTile;
+                curQNBlockNum = qNBlockNumPerGroup * info.kvHeads;
+                curQSBlockTile = GetQSBlockTile();
+                curQSBlockNum = (info.qSeqlenList[curBatch] + curQSBlockTile - 1) / curQSBlockTile;
+                if (taskIdx < preTotalTaskNum + curQNBlockNum * curQSBlockNum) {
+                    break;
+                }
+                preTotalTaskNum += curQNBlockNum * curQSBlockNum;
+            }
+            uint32_t qSeqlen = info.qSeqlenList[curBatch];
+            uint32_t kvSeqlen = info.kvSeqlenList[curBatch];
+            uint32_t qSBlockIdx = (taskIdx - preTotalTaskNum) / curQNBlockNum;
+            uint32_t qNBlockIdxCurGroup = (taskIdx - preTotalTaskNum - qSBlockIdx * curQNBlockNum) % qNBlockNumPerGroup;
+            uint32_t qSBlockSize = (qSBlockIdx == curQSBlockNum - 1) ? (qSeqlen - qSBlockIdx * curQSBlockTile)
+                                                                     : curQSBlockTile;
+            uint32_t qNBlockSize = (qNBlockIdxCurGroup == qNBlockNumPerGroup - 1)
+                                       ? (groupSize - qNBlockIdxCurGroup * curQNBlockTile)
+                                       : curQNBlockTile;
+            uint32_t rowNum = qSBlockSize * qNBlockSize;
+            uint32_t noSkipKvS = kvSeqlen;
+            uint32_t noMaskKvS = kvSeqlen;
+            bool masked = info.masked;
+            if (masked) {
+                noSkipKvS = std::min(kvSeqlen, (qSBlockIdx + 1) * curQSBlockTile + kvSeqlen - qSeqlen);
+                noMaskKvS = noSkipKvS - qSBlockSize;
+            }
+            // a piece of a split task runs the stages of its kv range
+            FATask const &piece = taskPlan.tasks[i];
+            if (piece.splitNum > 1) {
+                if (piece.kvEnd < noSkipKvS) {
+                    masked = false;
+                    noMaskKvS = piece.kvEnd;
+                }
+                noMaskKvS -= piece.kvStart;
+            }
+            uint32_t totalStackSeqNum = (noMaskKvS + stackSeqTilePad - 1) / stackSeqTilePad + (masked ? 1 : 0);
+
+            // stage stackSeqCount writes S and P, stage stackSeqCount - preLaunch reads P and writes OTmp
+            for (uint32_t stackSeqCount = 0; stackSeqCount < totalStackSeqNum + preLaunch; ++stackSeqCount) {
+                if (stackSeqCount < totalStackSeqNum) {
+                    uint32_t flag = stackSeqCount % (preLaunch + 1);
+                    uint64_t gmOffsetS = coreIdx * sRingSize + flag * plan.sSlotSize;
+                    if (flag >= plan.slotNum) {
+                        printf("%s: core %u task %u uses S slot %u of %u\n", name, coreIdx, taskIdx, flag,
+                            plan.slotNum);
+                        return false;
+                    }
+                    success = CheckRange(name, "S tile", gmOffsetS,
+                        gmOffsetS + static_cast<uint64_t>(rowNum) * stackSeqTilePad, coreIdx * sRingSize +
+                        flag * plan.sSlotSize, coreIdx * sRingSize + (flag + 1) * plan.sSlotSize) && success;
+                }
+                if (stackSeqCount >= preLaunch) {
+                    uint32_t flag = (stackSeqCount - preLaunch) % (preLaunch + 1);
+                    uint64_t gmOffsetOTmp = coreIdx * oTmpRingSize + flag * plan.oTmpSlotSize;
+                    if (flag >= plan.slotNum) {
+                        printf("%s: core %u task %u uses OTmp slot %u of %u\n", name, coreIdx, taskIdx, flag,
+                            plan.slotNum);
+                        return false;
+                    }
+                    success = CheckRange(name, "OTmp tile", gmOffsetOTmp,
+                        gmOffsetOTmp + static_cast<uint64_t>(rowNum) * embedRound, coreIdx * oTmpRingSize +
+                        flag * plan.oTmpSlotSize, coreIdx * oTmpRingSize + (flag + 1) * plan.oTmpSlotSize) && success;
+                }
+            }
+        }
+    }
+
+    // the rings of all cores in their buffers, the buffers in the workspace
+    WorkspaceBuffer const &s = plan.buffers[FA_WORKSPACE_S];
+    WorkspaceBuffer const &p = plan.buffers[FA_WORKSPACE_P];
+    WorkspaceBuffer const &oTmp = plan.buffers[FA_WORKSPACE_O_TMP];
+    success = CheckRange(name, "S rings", 0, info.coreNum * sRingSize * ELEMENT_SIZE_S, 0, s.size) && success;
+    success = CheckRange(name, "P rings", 0, info.coreNum * sRingSize * ELEMENT_SIZE_P, 0, p.size) && success;
+    success = CheckRange(name, "OTmp rings", 0, info.coreNum * oTmpRingSize * ELEMENT_SIZE_O_TMP, 0, oTmp.size) &&
+        success;
+    for (uint32_t i = 0; i < FA_WORKSPACE_BUFFER_NUM; ++i) {
+        WorkspaceBuffer const &buffer = plan.buffers[i];
+        if (buffer.offset % WORKSPACE_ALIGN != 0) {
+            printf("%s: buffer %u at %lu is not aligned\n", name, i, buffer.offset);
+            success = false;
+        }
+        success = CheckRange(name, "buffer", buffer.offset, buffer.offset + buffer.size, 0, plan.workSpaceSize) &&
+            success;
+        for (uint32_t j = i + 1; j < FA_WORKSPACE_BUFFER_NUM; ++j) {
+            WorkspaceBuffer const &other = plan.buffers[j];
+            if (buffer.size > 0 && other.size > 0 && buffer.offset < other.offset + other.size &&
+                other.offset < buffer.offset + buffer.size) {
+                printf("%s: buffers %u and %u overlap\n", name, i, j);
+                success = false;
+            }
+        }
+    }
+
+    // the last row of the last piece of every split task, and its lse after all partial outputs
+    if (plan.partialNum != taskPlan.partialNum || plan.partialRowNum != taskPlan.partialRowNum) {
+        printf("%s: %u partial slots planned, %u needed\n", name, plan.partialNum, taskPlan.partialNum);
+        return false;
+    }
+    uint64_t lseOffset = static_cast<uint64_t>(plan.partialNum) * plan.partialRowNum * embedRound;
+    for (FATask const &task : taskPlan.splitTasks) {
+        uint64_t lastRow = static_cast<uint64_t>(task.partialIdx) * plan.partialRowNum +
+            static_cast<uint64_t>(task.rowNum - 1) * task.splitNum + task.splitNum - 1;
+        success = CheckRange(name, "partial O", lastRow * embedRound * ELEMENT_SIZE_O_TMP,
+            (lastRow + 1) * embedRound * ELEMENT_SIZE_O_TMP, 0, lseOffset * ELEMENT_SIZE_O_TMP) && success;
+        success = CheckRange(name, "lse", (lseOffset + lastRow) * ELEMENT_SIZE_O_TMP,
+            (lseOffset + lastRow + 1) * ELEMENT_SIZE_O_TMP, lseOffset * ELEMENT_SIZE_O_TMP,
+            plan.buffers[FA_WORKSPACE_O_UPDATE].size) && success;
+    }
+    return success;
+}
+
+bool CheckPlan(WorkspaceCase const &workspaceCase)
+{
+    FATaskPlanInfo info = GetPlanInfo(workspaceCase);
+    FAWorkspacePlan plan = GetFAWorkspacePlan(info, workspaceCase.embeddingSize, ELEMENT_SIZE_S, ELEMENT_SIZE_P,
+        ELEMENT_SIZE_O_TMP);
+    if (plan.slotNum == 0 || plan.slotNum > PRE_LAUNCH + 1) {
+        printf("%s: %u slots per ring\n", workspaceCase.name, plan.slotNum);
+        return false;
+    }
+    bool success = CheckKernelAccess(workspaceCase, plan);
+    uint64_t legacySize = info.coreNum * LEGACY_BLOCK_SIZE * LEGACY_SLOT_NUM *
+        (ELEMENT_SIZE_S + ELEMENT_SIZE_P + ELEMENT_SIZE_O_TMP + ELEMENT_SIZE_O_TMP);
+    double saving = static_cast<double>(legacySize) / plan.workSpaceSize;
+    printf("%-14s slots=%u sSlot=%-6u oTmpSlot=%-6u partials=%-3u workspace %8.2f MB, before %8.2f MB, %.2fx "
+        "smaller\n", workspaceCase.name, plan.slotNum, plan.sSlotSize, plan.oTmpSlotSize, plan.partialNum,
+        plan.workSpaceSize / 1048576.0, legacySize / 1048576.0, saving);
+    if (saving < workspaceCase.minSaving) {
+        printf("%s: workspace %.2fx smaller, expected %.2fx\n", workspaceCase.name, saving, workspaceCase.minSaving);
+        success = false;
+    }
+    return success;
+}
+
+} // namespace
+
+int main()
+{
+    bool success = true;
+    std::vector<WorkspaceCase> cases{
+        UniformCase("decode-gqa8", 64, 1, 32768, 32, 4, 128, false),
+        UniformCase("decode-short", 64, 1, 600, 32, 4, 128, false),
+        UniformCase("spec-mtp4", 32, 4, 8192, 32, 8, 128, true),
+        UniformCase("prefill-2k", 4, 2048, 2048, 32, 32, 128, true),
+        UniformCase("prefill-e64", 2, 4096, 4096, 16, 16, 64, false),
+        UniformCase("tiny", 1, 5, 300, 1, 1, 72, true),
+        UniformCase("decode-split", 2, 1, 32768, 32, 4, 128, false),
+    };
+    cases[0].minSaving = 7.0;
+    cases[1].minSaving = 10.0;
+    cases[2].minSaving = 3.0;
+    cases[3].minSaving = 3.5;
+    cases[5].minSaving = 20.0;
+    for (auto const &workspaceCase : cases) {
+        success = CheckPlan(workspaceCase) && success;
+    }
+    printf(success ? "all checks passed\n" : "FAILED\n");
+    return success ? 0 : 1;
+}
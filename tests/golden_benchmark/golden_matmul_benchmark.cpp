@@ -0,0 +1,155 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host benchmark of the blocked golden engine against the reference loops.
+// Usage: golden_matmul_benchmark [m] [n] [k] [batch]
+// The number of engine threads can be set with CATLASS_GOLDEN_THREAD_NUM.
+
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include <opdev/fp16_t.h>
+
+#include "catlass/layout/layout.hpp"
+
+#include "golden.hpp"
+
+using namespace Catlass;
+using op::fp16_t;
+
+template <class Func>
+static double MeasureMs(Func &&func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static void Report(const char *name, double referenceMs, double engineMs, double flops, bool bitExact)
+{
+    printf("%-24s reference %10.2f ms (%7.2f GFLOPS)  engine %10.2f ms (%7.2f GFLOPS)  speedup %6.2fx  %s\n",
+        name, referenceMs, flops / referenceMs / 1e6, engineMs, flops / engineMs / 1e6, referenceMs / engineMs,
+        bitExact ? "bit-exact" : "MISMATCH");
+}
+
+static bool BitEqual(const std::vector<float> &lhs, const std::vector<float> &rhs)
+{
+    return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(float)) == 0;
+}
+
+template <class LayoutA, class LayoutB>
+static bool BenchmarkMatmul(const char *name, const GemmCoord &problemShape)
+{
+    uint32_t m = problemShape.m();
+    uint32_t n = problemShape.n();
+    uint32_t k = problemShape.k();
+    LayoutA layoutA{m, k};
+    LayoutB layoutB{k, n};
+    layout::RowMajor layoutC{m, n};
+
+    std::vector<fp16_t> hostA(static_cast<size_t>(m) * k);
+    std::vector<fp16_t> hostB(static_cast<size_t>(k) * n);
+    golden::FillRandomData<fp16_t>(hostA, -5.0f, 5.0f);
+    golden::FillRandomData<fp16_t>(hostB, -5.0f, 5.0f);
+
+    std::vector<float> reference(static_cast<size_t>(m) * n);
+    std::vector<float> engine(static_cast<size_t>(m) * n);
+    double referenceMs = MeasureMs([&]() {
+        golden::ReferenceMatmul(problemShape, hostA, layoutA, hostB, layoutB, reference, layoutC);
+    });
+    double engineMs = MeasureMs([&]() {
+        golden::ComputeMatmul(problemShape, hostA, layoutA, hostB, layoutB, engine, layoutC);
+    });
+    bool bitExact = BitEqual(reference, engine);
+    Report(name, referenceMs, engineMs, 2.0 * m * n * k, bitExact);
+    return bitExact;
+}
+
+static bool BenchmarkBatchedMatmul(const GemmCoord &problemShape, uint32_t batchCount)
+{
+    uint32_t m = problemShape.m();
+    uint32_t n = problemShape.n();
+    uint32_t k = problemShape.k();
+    layout::RowMajor layoutA{m, k};
+    layout::ColumnMajor layoutB{k, n};
+    layout::RowMajor layoutC{m, n};
+
+    std::vector<fp16_t> hostA(static_cast<size_t>(m) * k * batchCount);
+    std::vector<fp16_t> hostB(static_cast<size_t>(k) * n * batchCount);
+    golden::FillRandomData<fp16_t>(hostA, -5.0f, 5.0f);
+    golden::FillRandomData<fp16_t>(hostB, -5.0f, 5.0f);
+
+    std::vector<float> reference(static_cast<size_t>(m) * n * batchCount);
+    std::vector<float> engine(static_cast<size_t>(m) * n * batchCount);
+    double referenceMs = MeasureMs([&]() {
+        golden::ReferenceBatchedMatmul(batchCount, problemShape, hostA, layoutA, hostB, layoutB, reference, layoutC);
+    });
+    double engineMs = MeasureMs([&]() {
+        golden::ComputeBatchedMatmul(batchCount, problemShape, hostA, layoutA, hostB, layoutB, engine, layoutC);
+    });
+    bool bitExact = BitEqual(reference, engine);
+    Report("batched RowMajor x ColMajor", referenceMs, engineMs, 2.0 * m * n * k * batchCount, bitExact);
+    return bitExact;
+}
+
+static bool BenchmarkGemm(const GemmCoord &problemShape)
+{
+    uint32_t m = problemShape.m();
+    uint32_t n = problemShape.n();
+    uint32_t k = problemShape.k();
+    layout::RowMajor layoutA{m, k};
+    layout::RowMajor layoutB{k, n};
+    layout::RowMajor layoutC{m, n};
+    float alpha = 0.5f;
+    float beta = 2.0f;
+
+    std::vector<fp16_t> hostA(static_cast<size_t>(m) * k);
+    std::vector<fp16_t> hostB(static_cast<size_t>(k) * n);
+    std::vector<float> hostC(static_cast<size_t>(m) * n);
+    golden::FillRandomData<fp16_t>(hostA, -5.0f, 5.0f);
+    golden::FillRandomData<fp16_t>(hostB, -5.0f, 5.0f);
+    golden::FillRandomData<float>(hostC, -5.0f, 5.0f);
+
+    std::vector<float> reference(static_cast<size_t>(m) * n);
+    std::vector<float> engine(static_cast<size_t>(m) * n);
+    double referenceMs = MeasureMs([&]() {
+        golden::ReferenceGemm(problemShape, alpha, beta, hostA, layoutA, hostB, layoutB, hostC, layoutC,
+            reference, layoutC);
+    });
+    double engineMs = MeasureMs([&]() {
+        golden::ComputeGemm(problemShape, alpha, beta, hostA, layoutA, hostB, layoutB, hostC, layoutC,
+            engine, layoutC);
+    });
+    bool bitExact = BitEqual(reference, engine);
+    Report("gemm alpha/beta", referenceMs, engineMs, 2.0 * m * n * k, bitExact);
+    return bitExact;
+}
+
+int main(int argc, const char **argv)
+{
+    const uint32_t defaultShape = 1024;
+    const uint32_t defaultBatch = 4;
+    uint32_t m = argc > 1 ? std::stoul(argv[1]) : defaultShape;
+    uint32_t n = argc > 2 ? std::stoul(argv[2]) : defaultShape;
+    uint32_t k = argc > 3 ? std::stoul(argv[3]) : defaultShape;
+    uint32_t batch = argc > 4 ? std::stoul(argv[4]) : defaultBatch;
+    GemmCoord problemShape{m, n, k};
+
+    printf("m=%u n=%u k=%u batch=%u threads=%u\n", m, n, k, batch, golden::detail::GetGoldenThreadNum());
+    bool success = true;
+    success &= BenchmarkMatmul<layout::RowMajor, layout::RowMajor>("matmul RowMajor x RowMajor", problemShape);
+    success &= BenchmarkMatmul<layout::RowMajor, layout::ColumnMajor>("matmul RowMajor x ColMajor", problemShape);
+    success &= BenchmarkMatmul<layout::ColumnMajor, layout::RowMajor>("matmul ColMajor x RowMajor", problemShape);
+    success &= BenchmarkGemm(problemShape);
+    success &= BenchmarkBatchedMatmul(problemShape, batch);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the task table of GroupedMatmulSliceMTaskTable.
+// Usage: grouped_task_table_test
+// For every case the table is built by GroupedMatmulTaskTable::Build and the task loop of the kernel is replayed on
+// the host, also with another number of cores than the table is cut for. It checks that:
+//   - every output tile of every group is computed exactly once and empty groups are never entered,
+//   - the estimated cost of the busiest core exceeds the mean by at most one tile,
+//   - a core binary searches the group of its first task only and walks forward to the following groups.
+// The cost of the busiest core and the scalar reads of a core are compared with the round-robin walk of
+// GroupedMatmulSliceM.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "host_test.hpp"
+
+#include "catlass/gemm/block/block_swizzle.hpp"
+
+using namespace Catlass;
+
+namespace {
+
+using TileSwizzle = Gemm::Block::GemmIdentityBlockSwizzle<3, 1>;
+using TaskTable = Gemm::Block::GroupedMatmulTaskTable<TileSwizzle>;
+
+// What AscendC::GlobalTensor<uint32_t>::GetValue does on the device, counting the scalar reads.
+struct HostTable {
+    std::vector<uint32_t> data;
+    uint64_t reads{0};
+
+    uint32_t GetValue(uint32_t idx)
+    {
+        ++reads;
+        return data.at(idx);
+    }
+};
+
+struct TableCase {
+    const char *name;
+    std::vector<int64_t> groupList;
+    uint32_t n;
+    uint32_t k;
+    uint32_t coreNum;
+};
+
+std::vector<int64_t> Cumulate(std::vector<int64_t> const &groupM)
+{
+    std::vector<int64_t> groupList(groupM.size());
+    int64_t sum = 0;
+    for (size_t i = 0; i < groupM.size(); ++i) {
+        sum += groupM[i];
+        groupList[i] = sum;
+    }
+    return groupList;
+}
+
+// MoE routing: most experts get a handful of tokens or none, a few are hot.
+std::vector<int64_t> MoeGroupList(uint32_t experts, uint32_t tokens, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<int64_t> groupM(experts, 0);
+    for (uint32_t i = 0; i < tokens; ++i) {
+        uint32_t expert = rng() % 4 == 0 ? rng() % 4 : rng() % experts;
+        ++groupM[expert];
+    }
+    for (uint32_t i = 0; i < experts; i += 3) {
+        groupM[i] = std::min<int64_t>(groupM[i], rng() % 4);
+    }
+    return Cumulate(groupM);
+}
+
+uint64_t TileCost(GemmCoord const &shape)
+{
+    return static_cast<uint64_t>(RoundUp(shape.m(), TaskTable::M_ALIGN)) * shape.n() * shape.k();
+}
+
+// Max core cost of the walk of GroupedMatmulSliceM: the tiles of a group go round-robin, starting after the
+// core which took the last tile of the previous group.
+uint64_t RoundRobinMaxCost(TableCase const &tableCase, GemmCoord const &problemShape, MatrixCoord const &tileMN)
+{
+    std::vector<uint64_t> coreCost(tableCase.coreNum, 0);
+    uint32_t startCoreIdx = 0;
+    TileSwizzle tileSwizzle;
+    for (uint32_t groupIdx = 0; groupIdx < tableCase.groupList.size(); ++groupIdx) {
+        tileSwizzle.Update(TaskTable::GetGroupShape(problemShape, tableCase.groupList.data(), groupIdx), tileMN);
+        for (uint32_t loopIdx = 0; loopIdx < tileSwizzle.GetCoreLoops(); ++loopIdx) {
+            GemmCoord shape = tileSwizzle.GetActualBlockShape(tileSwizzle.GetBlockCoord(loopIdx));
+            coreCost[(startCoreIdx + loopIdx) % tableCase.coreNum] += TileCost(shape);
+        }
+        startCoreIdx = (startCoreIdx + tileSwizzle.GetCoreLoops()) % tableCase.coreNum;
+    }
+    return *std::max_element(coreCost.begin(), coreCost.end());
+}
+
+bool CheckTable(TableCase const &tableCase, MatrixCoord const &tileMN, uint32_t launchCoreNum)
+{
+    const uint32_t groupCount = tableCase.groupList.size();
+    const GemmCoord problemShape{static_cast<uint32_t>(tableCase.groupList.back()), tableCase.n, tableCase.k};
+    HostTable table;
+    table.data.assign(TaskTable::GetSize(groupCount, tableCase.coreNum), UINT32_MAX);
+    TaskTable::Build(problemShape, tileMN, tableCase.groupList.data(), groupCount, tableCase.coreNum,
+        table.data.data());
+    bool success = true;
+    if (std::count(table.data.begin(), table.data.end(), UINT32_MAX) != 0) {
+        printf("%s: table not filled\n", tableCase.name);
+        success = false;
+    }
+
+    // replay the task loop of GroupedMatmulSliceMTaskTable::operator()<AIC>
+    std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t> computed;
+    std::vector<uint64_t> coreCost(launchCoreNum, 0);
+    uint64_t maxTileCost = 0;
+    uint64_t groupListReads = 0;
+    uint32_t tableCoreNum = table.GetValue(0);
+    TileSwizzle blockScheduler;
+    for (uint32_t coreIdx = 0; coreIdx < launchCoreNum; ++coreIdx) {
+        for (uint32_t rangeIdx = coreIdx; rangeIdx < tableCoreNum; rangeIdx += launchCoreNum) {
+            uint64_t rangeReads = table.reads;
+            uint32_t taskBegin = table.GetValue(TaskTable::GetCoreOffsetIdx(rangeIdx));
+            uint32_t taskEnd = table.GetValue(TaskTable::GetCoreOffsetIdx(rangeIdx + 1));
+            uint32_t groupIdx = 0;
+            uint32_t firstGroupIdx = 0;
+            uint32_t groupTaskBegin = taskBegin;
+            uint32_t groupTaskEnd = taskBegin;
+            for (uint32_t taskIdx = taskBegin; taskIdx < taskEnd; ++taskIdx) {
+                if (taskIdx >= groupTaskEnd) {
+                    if (taskIdx == taskBegin) {
+                        groupIdx = TaskTable::FindGroup(table, tableCoreNum, groupCount, taskIdx);
+                        groupTaskBegin = table.GetValue(TaskTable::GetGroupOffsetIdx(tableCoreNum, groupIdx));
+                        groupTaskEnd = table.GetValue(TaskTable::GetGroupOffsetIdx(tableCoreNum, groupIdx + 1));
+                        groupListReads += (groupIdx == 0) ? 0 : 1;
+                        firstGroupIdx = groupIdx;
+                    } else {
+                        groupIdx = TaskTable::NextGroup(table, tableCoreNum, groupIdx, groupTaskBegin, groupTaskEnd);
+                    }
+                    GemmCoord groupShape =
+                        TaskTable::GetGroupShape(problemShape, tableCase.groupList.data(), groupIdx);
+                    if (groupShape.m() == 0 || taskIdx < groupTaskBegin) {
+                        printf("%s: task %u entered group %u of m %u\n", tableCase.name, taskIdx, groupIdx,
+                            groupShape.m());
+                        success = false;
+                    }
+                    blockScheduler.Update(groupShape, tileMN);
+                    ++groupListReads;
+                }
+                GemmCoord blockCoord = blockScheduler.GetBlockCoord(taskIdx - groupTaskBegin);
+                GemmCoord shape = blockScheduler.GetActualBlockShape(blockCoord);
+                ++computed[{groupIdx, blockCoord.m(), blockCoord.n()}];
+                coreCost[coreIdx] += TileCost(shape);
+                maxTileCost = std::max(maxTileCost, TileCost(shape));
+            }
+            // the range bounds, one binary search, then one read per group offset walked over
+            uint32_t searchReads = 0;
+            while ((1U << searchReads) < groupCount) {
+                ++searchReads;
+            }
+            uint64_t maxReads = 2 + searchReads + 2 + (groupIdx - firstGroupIdx);
+            if (taskBegin < taskEnd && table.reads - rangeReads > maxReads) {
+                printf("%s: range %u read the table %lu times, at most %lu expected\n", tableCase.name, rangeIdx,
+                    table.reads - rangeReads, maxReads);
+                success = false;
+            }
+        }
+    }
+
+    // every tile of every group exactly once
+    uint64_t totalCost = 0;
+    size_t expectedTiles = 0;
+    TileSwizzle tileSwizzle;
+    for (uint32_t groupIdx = 0; groupIdx < groupCount; ++groupIdx) {
+        tileSwizzle.Update(TaskTable::GetGroupShape(problemShape, tableCase.groupList.data(), groupIdx), tileMN);
+        for (uint32_t loopIdx = 0; loopIdx < tileSwizzle.GetCoreLoops(); ++loopIdx) {
+            GemmCoord blockCoord = tileSwizzle.GetBlockCoord(loopIdx);
+            totalCost += TileCost(tileSwizzle.GetActualBlockShape(blockCoord));
+            auto it = computed.find({groupIdx, blockCoord.m(), blockCoord.n()});
+            if (it == computed.end() || it->second != 1) {
+                printf("%s: group %u tile (%u, %u) computed %u times\n", tableCase.name, groupIdx, blockCoord.m(),
+                    blockCoord.n(), it == computed.end() ? 0 : it->second);
+                success = false;
+            }
+            ++expectedTiles;
+        }
+    }
+    if (computed.size() != expectedTiles) {
+        printf("%s: %zu tiles computed, %zu expected\n", tableCase.name, computed.size(), expectedTiles);
+        success = false;
+    }
+
+    uint64_t maxCost = *std::max_element(coreCost.begin(), coreCost.end());
+    if (launchCoreNum == tableCase.coreNum) {
+        // the cuts are at most half a tile from the targets, a core is off by less than one tile
+        uint64_t bound = (totalCost + tableCase.coreNum - 1) / tableCase.coreNum + maxTileCost;
+        if (maxCost > bound) {
+            printf("%s: busiest core costs %lu, bound %lu\n", tableCase.name, maxCost, bound);
+            success = false;
+        }
+        uint64_t roundRobin = RoundRobinMaxCost(tableCase, problemShape, tileMN);
+        double mean = static_cast<double>(totalCost) / tableCase.coreNum;
+        // scalar reads of GM per core, the group list is read once per group entered
+        double reads = static_cast<double>(table.reads + groupListReads) / launchCoreNum;
+        printf("%-10s groups=%-4u tiles=%-5zu cores=%-3u max/mean %.3f (round-robin %.3f), "
+            "scalar reads per core %.1f (round-robin %u)\n", tableCase.name, groupCount, expectedTiles,
+            tableCase.coreNum, maxCost / mean, roundRobin / mean, reads, 2 * groupCount);
+    }
+    return success;
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<TableCase> cases{
+        {"moe-256", MoeGroupList(256, 4096, 1), 4096, 7168, 24},
+        {"moe-256-s", MoeGroupList(256, 512, 2), 2048, 7168, 24},
+        {"moe-64", MoeGroupList(64, 8192, 3), 1536, 4096, 20},
+        {"dense", Cumulate(std::vector<int64_t>(8, 1024)), 1024, 1024, 24},
+        {"one-group", Cumulate({1000}), 1000, 512, 24},
+        {"all-empty", Cumulate(std::vector<int64_t>(16, 0)), 256, 256, 24},
+        {"tiny", Cumulate({0, 1, 0, 0, 2, 3, 0}), 128, 128, 24},
+        {"one-core", MoeGroupList(32, 700, 4), 512, 512, 1},
+    };
+    const std::vector<MatrixCoord> tiles{MatrixCoord{128U, 256U}, MatrixCoord{256U, 128U}, MatrixCoord{16U, 256U}};
+    bool success = true;
+    for (auto const &tableCase : cases) {
+        for (auto const &tileMN : tiles) {
+            if (tableCase.groupList.back() == 0) {
+                // nothing to compute, the ranges must all be empty
+                HostTable table;
+                table.data.resize(TaskTable::GetSize(tableCase.groupList.size(), tableCase.coreNum));
+                TaskTable::Build(GemmCoord{0, tableCase.n, tableCase.k}, tileMN, tableCase.groupList.data(),
+                    tableCase.groupList.size(), tableCase.coreNum, table.data.data());
+                success = table.data[TaskTable::GetCoreOffsetIdx(tableCase.coreNum)] == 0 && success;
+                continue;
+            }
+            for (uint32_t launchCoreNum : {tableCase.coreNum, tableCase.coreNum / 2 + 1, tableCase.coreNum + 3}) {
+                success = CheckTable(tableCase, tileMN, launchCoreNum) && success;
+            }
+        }
+    }
+    printf(success ? "all checks passed\n" : "FAILED\n");
+    return success ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the tiling and kernel selection of 102_dynamic_optimized_matmul.
+// Usage: kernel_selection_test
+// Every shape below is tiled and selected with the default cost model on a 24 core Atlas A2, the expected tile,
+// kernel, padding tags and blockDim are the ones of the hand written selection the cost model replaced.
+// The cost model file is checked too: a dumped model selects the same kernels once loaded, core_num overrides
+// the platform and malformed files are rejected without touching the model.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "host_test.hpp"
+
+#include "do_tiling_b16.h"
+#include "select_kernel_b16.h"
+
+namespace {
+
+using HostTest::Check;
+
+struct SelectionCase {
+    uint32_t m;
+    uint32_t n;
+    uint32_t k;
+    uint8_t layoutTagA;
+    uint8_t layoutTagB;
+    // expected tiling
+    uint16_t m1;
+    uint16_t n1;
+    uint16_t k1;
+    // expected kernel, 0 CommonMatmul, 1 SmallMatmul, 2 PaddingCommonMatmul
+    uint8_t kernelSerial;
+    uint8_t paddingTagA;
+    uint8_t paddingTagB;
+    uint8_t paddingTagC;
+    uint8_t blockDim;
+};
+
+const SelectionCase SELECTION_CASES[] = {
+    // m = 1 or n = 1 switch to the layout with the better bandwidth
+    {1, 1, 16, 0, 0, 16, 16, 1024, 1, 0, 0, 0, 1},
+    {1, 1, 4096, 0, 0, 16, 16, 1024, 0, 0, 0, 0, 1},
+    {1, 1024, 4096, 1, 0, 16, 128, 512, 0, 0, 0, 0, 8},
+    {4096, 1, 1024, 0, 0, 176, 16, 512, 0, 0, 0, 0, 24},
+    {100, 1, 200, 1, 1, 112, 16, 1024, 2, 3, 0, 0, 1},
+    // short inner dimensions are padded to zN
+    {1, 7, 1024, 0, 0, 16, 16, 1024, 2, 0, 3, 0, 1},
+    {1, 128, 1024, 1, 0, 16, 64, 1024, 2, 0, 3, 0, 2},
+    {1, 8192, 200, 0, 0, 16, 256, 256, 2, 3, 0, 0, 24},
+    {16, 8192, 200, 0, 1, 16, 352, 256, 2, 3, 3, 0, 24},
+    {100, 128, 16384, 1, 0, 48, 64, 1024, 2, 3, 3, 0, 6},
+    // large unaligned n pads C
+    {2048, 4095, 16, 0, 0, 128, 256, 256, 2, 0, 0, 1, 24},
+    {2048, 4095, 64, 0, 0, 128, 256, 256, 2, 0, 3, 1, 24},
+    {2048, 4095, 200, 0, 0, 128, 256, 256, 2, 3, 3, 1, 24},
+    // no padding pays off
+    {256, 1024, 1024, 0, 0, 48, 256, 256, 0, 0, 0, 0, 24},
+    {512, 300, 4096, 1, 1, 256, 32, 256, 0, 0, 0, 0, 20},
+    {1000, 1024, 64, 0, 1, 128, 176, 256, 0, 0, 0, 0, 24},
+    {8192, 8192, 16384, 0, 1, 128, 256, 256, 0, 0, 0, 0, 24},
+};
+
+std::string CaseStr(const SelectionCase &selectionCase)
+{
+    return std::to_string(selectionCase.m) + "x" + std::to_string(selectionCase.n) + "x" +
+        std::to_string(selectionCase.k) + " layout " + std::to_string(selectionCase.layoutTagA) +
+        std::to_string(selectionCase.layoutTagB);
+}
+
+TilingParams Select(const SelectionCase &selectionCase, PlatformInfo &platformInfo)
+{
+    TilingParams tilingParams{selectionCase.m, selectionCase.n, selectionCase.k,
+        static_cast<LayoutTag>(selectionCase.layoutTagA), static_cast<LayoutTag>(selectionCase.layoutTagB),
+        LayoutTag::TagRowMajor};
+    DoTilingB16[tilingParams.layoutTagA][tilingParams.layoutTagB](tilingParams, platformInfo);
+    SelectKernelB16(tilingParams, platformInfo);
+    return tilingParams;
+}
+
+void CheckSelection(const SelectionCase &selectionCase, PlatformInfo &platformInfo)
+{
+    std::string tag = CaseStr(selectionCase);
+    TilingParams tilingParams = Select(selectionCase, platformInfo);
+    Check(tilingParams.m1 == selectionCase.m1 && tilingParams.n1 == selectionCase.n1 &&
+        tilingParams.k1 == selectionCase.k1 && tilingParams.splitkFactor == 1,
+        "tile " + std::to_string(tilingParams.m1) + "x" + std::to_string(tilingParams.n1) + "x" +
+        std::to_string(tilingParams.k1) + ", " + tag);
+
+    const TilingKey &tilingKey = tilingParams.tilingKey;
+    Check(tilingKey.GetKernelSerial() == selectionCase.kernelSerial,
+        "kernel " + std::to_string(tilingKey.GetKernelSerial()) + ", " + tag);
+    Check(tilingKey.GetPaddingTagTagA() == selectionCase.paddingTagA &&
+        tilingKey.GetPaddingTagTagB() == selectionCase.paddingTagB &&
+        tilingKey.GetPaddingTagTagC() == selectionCase.paddingTagC, "padding tags, " + tag);
+    Check(tilingParams.blockDim == selectionCase.blockDim,
+        "blockDim " + std::to_string(tilingParams.blockDim) + ", " + tag);
+
+    // the TilingKey holds the layouts the kernel runs with, the caller's layouts are restored
+    uint8_t layoutTagA = (selectionCase.m == 1) ? 0 : selectionCase.layoutTagA;
+    uint8_t layoutTagB = (selectionCase.n == 1) ? 1 : selectionCase.layoutTagB;
+    Check(tilingKey.GetLayoutTagA() == layoutTagA && tilingKey.GetLayoutTagB() == layoutTagB &&
+        tilingParams.layoutTagA == selectionCase.layoutTagA && tilingParams.layoutTagB == selectionCase.layoutTagB,
+        "layout tags, " + tag);
+
+    // the estimate lists the padding of A and B, a kernel padding only C is listed as CommonMatmul
+    std::vector<KernelCandidate> candidates = EstimateKernelCandidates(tilingParams, platformInfo);
+    bool paddingAB = tilingKey.GetPaddingTagTagA() != 0 || tilingKey.GetPaddingTagTagB() != 0;
+    uint8_t kernelSerial = (tilingKey.GetKernelSerial() == 2 && !paddingAB) ? 0 : tilingKey.GetKernelSerial();
+    bool listed = false;
+    for (const auto &candidate : candidates) {
+        listed = listed || (candidate.kernelSerial == kernelSerial &&
+            candidate.paddingTagA == tilingKey.GetPaddingTagTagA() &&
+            candidate.paddingTagB == tilingKey.GetPaddingTagTagB() && candidate.feasible);
+    }
+    Check(listed, "the selected kernel is a feasible candidate, " + tag);
+}
+
+bool WriteFile(const std::string &path, const std::string &content)
+{
+    std::ofstream file(path);
+    file << content;
+    return file.good();
+}
+
+void CheckCostModelFile()
+{
+    const std::string path = "kernel_selection_test.cost_model";
+
+    // a dumped model loads back to the same selection
+    std::ostringstream dump;
+    DumpCostModel(dump, CostModel());
+    CostModel loaded;
+    loaded.aivBand = 1;
+    Check(WriteFile(path, dump.str()) && LoadCostModel(path, loaded), "load a dumped cost model");
+    PlatformInfo loadedPlatform(loaded);
+    for (const auto &selectionCase : SELECTION_CASES) {
+        CheckSelection(selectionCase, loadedPlatform);
+    }
+
+    // core_num overrides the platform, the tiles are balanced over 20 cores
+    CostModel model;
+    Check(WriteFile(path, "core_num 20 # fewer cores\n") && LoadCostModel(path, model) && model.coreNum == 20,
+        "load core_num");
+    PlatformInfo platformInfo(model);
+    const SelectionCase fewerCores{256, 1024, 1024, 0, 0, 64, 256, 256, 0, 0, 0, 0, 16};
+    Check(platformInfo.coreNum == 20, "core_num overrides the platform");
+    CheckSelection(fewerCores, platformInfo);
+
+    // alignments are divisors, a zero one is rejected and the model is kept
+    const char *badFiles[] = {
+        "row_curve 0 16 0.1 0.2 0.3\n",
+        "src_align_boost 0 2\n",
+        "aiv_band 20\nrow_curve 0.5 16 0.1 0.2\n",
+        "aiv_band\n",
+        "no_such_key 1\n",
+    };
+    for (const char *content : badFiles) {
+        CostModel rejected;
+        Check(WriteFile(path, content) && !LoadCostModel(path, rejected) && rejected.aivBand == CostModel().aivBand &&
+            rejected.rowCurves.size() == CostModel().rowCurves.size(), std::string("reject ") + content);
+    }
+    CostModel missing;
+    Check(!LoadCostModel(path + ".missing", missing), "reject a missing file");
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main()
+{
+    PlatformInfo platformInfo{CostModel()};
+    for (const auto &selectionCase : SELECTION_CASES) {
+        CheckSelection(selectionCase, platformInfo);
+    }
+    CheckCostModelFile();
+
+    return HostTest::Report();
+}
@@ -0,0 +1,254 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the launch plan cache of the shared library.
+// Usage: launch_plan_cache_test [calls]
+// A plan is built once per problem and every field of the key tells problems apart. The benchmark compares the host
+// work BasicMatmul did before every launch, filling a new KernelInfo, looking the shape up in a tuning database and
+// selecting the tiling, with a cache hit, on the shapes of a decode step. Runtime queries of the core count and the
+// FFTS address are left out, they need a device and are saved on top.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "host_test.hpp"
+
+#include "catlass/gemm_coord.hpp"
+#include "launch_plan_cache.hpp"
+#include "tuning.hpp"
+
+using namespace CatlassKernel;
+
+namespace {
+
+using HostTest::Check;
+
+using TileConfigs = std::tuple<
+    TileConfig<Catlass::GemmShape<128, 256, 256>, Catlass::GemmShape<128, 256, 64>, 0>,
+    TileConfig<Catlass::GemmShape<128, 256, 256>, Catlass::GemmShape<128, 256, 64>, 1>,
+    TileConfig<Catlass::GemmShape<256, 128, 256>, Catlass::GemmShape<256, 128, 64>, 0>,
+    TileConfig<Catlass::GemmShape<256, 128, 256>, Catlass::GemmShape<256, 128, 64>, 1>,
+    TileConfig<Catlass::GemmShape<128, 128, 256>, Catlass::GemmShape<128, 128, 64>, 0>,
+    TileConfig<Catlass::GemmShape<128, 128, 256>, Catlass::GemmShape<128, 128, 64>, 1>,
+    TileConfig<Catlass::GemmShape<64, 256, 256>, Catlass::GemmShape<64, 256, 64>, 0>,
+    TileConfig<Catlass::GemmShape<64, 256, 256>, Catlass::GemmShape<64, 256, 64>, 1>>;
+
+constexpr const char *DEVICE = "Ascend910B4";
+constexpr uint32_t BLOCK_NUM = 20;
+
+// stands for the launch plan of the shared library, which holds a launch function instead of the index
+struct Plan {
+    size_t configIdx{0};
+    size_t workspaceSize{0};
+    uint32_t blockNum{0};
+};
+
+// keeps the resolved plans of the benchmark from being optimized away
+volatile size_t g_sink = 0;
+
+KernelInfo MakeKernelInfo(uint32_t m, uint32_t n, uint32_t k)
+{
+    KernelInfo kernelInfo;
+    kernelInfo.m = m;
+    kernelInfo.n = n;
+    kernelInfo.k = k;
+    kernelInfo.inputAddr.resize(2);
+    kernelInfo.outputAddr.resize(1);
+    return kernelInfo;
+}
+
+LaunchPlanKey MakeKey(const KernelInfo &kernelInfo, int32_t deviceId, uint32_t blockNum)
+{
+    return {kernelInfo.m, kernelInfo.n, kernelInfo.k, kernelInfo.b,
+        static_cast<int32_t>(kernelInfo.inputDataType), static_cast<int32_t>(kernelInfo.outputDataType), deviceId,
+        blockNum, kernelInfo.transA, kernelInfo.transB};
+}
+
+// the per call work BasicMatmul did before its launch, as LookupTuning without the soc name query
+Plan Resolve(const Catlass::Library::TuningDatabase &db, const KernelInfo &kernelInfo)
+{
+    auto *record = db.Lookup("basic_matmul", GetTensorStr(kernelInfo.inputDataType, kernelInfo.transA),
+        GetTensorStr(kernelInfo.inputDataType, kernelInfo.transB), GetTensorStr(kernelInfo.outputDataType, false),
+        DEVICE, kernelInfo.m, kernelInfo.n, kernelInfo.k);
+    return {SelectTileConfig<TileConfigs>(record, 0), 0, BLOCK_NUM};
+}
+
+// records of the tiles of TileConfigs spread over the buckets, as mstuner_catlass --tuning_db writes them
+Catlass::Library::TuningDatabase MakeDatabase()
+{
+    const char *tiles[] = {"128x256x256_128x256x64", "256x128x256_256x128x64", "128x128x256_128x128x64",
+        "64x256x256_64x256x64"};
+    Catlass::Library::TuningDatabase db;
+    size_t i = 0;
+    for (uint32_t m = 1; m <= 8192; m *= 2) {
+        for (uint32_t n = 256; n <= 16384; n *= 2) {
+            for (uint32_t k = 256; k <= 16384; k *= 4, ++i) {
+                Catlass::Library::TuningRecord record;
+                record.A = record.B = record.C = "fp16:row";
+                record.device = DEVICE;
+                record.m = m;
+                record.n = n;
+                record.k = k;
+                record.taskDuration = 1;
+                record.description = std::string("catlass_gemm_basic_matmul_fp16_row_fp16_row_fp16_row_") +
+                    tiles[i % std::size(tiles)] + "_swizzle3x" + std::to_string(i / std::size(tiles) % 2);
+                if (Catlass::Library::TuningDatabase::ParseDescription(record)) {
+                    db.Update(record);
+                }
+            }
+        }
+    }
+    return db;
+}
+
+void TestBuildOnce()
+{
+    LaunchPlanCache<Plan> cache;
+    size_t builds = 0;
+    auto build = [&builds]() {
+        ++builds;
+        return Plan{builds, 0, BLOCK_NUM};
+    };
+    KernelInfo kernelInfo = MakeKernelInfo(16, 4096, 4096);
+    Plan first = cache.Get(MakeKey(kernelInfo, 0, BLOCK_NUM), build);
+    Plan again = cache.Get(MakeKey(kernelInfo, 0, BLOCK_NUM), build);
+    Check(builds == 1 && first.configIdx == again.configIdx, "a plan is built on the first call only");
+
+    // every field of the key is a different problem
+    LaunchPlanKey base = MakeKey(kernelInfo, 0, BLOCK_NUM);
+    std::vector<LaunchPlanKey> keys(11, base);
+    keys[1].m = 32;
+    keys[2].n = 2048;
+    keys[3].k = 2048;
+    keys[4].b = 2;
+    keys[5].inputDataType = ACL_BF16;
+    keys[6].outputDataType = ACL_FLOAT;
+    keys[7].deviceId = 1;
+    keys[8].blockNum = BLOCK_NUM / 2;
+    keys[9].transA = true;
+    keys[10].transB = true;
+    for (auto &key : keys) {
+        cache.Get(key, build);
+    }
+    LaunchPlanCacheStats stats = cache.GetStats();
+    Check(builds == keys.size() && stats.plans == keys.size(), "every field of the key tells problems apart");
+    Check(stats.hits == 2 && stats.misses == keys.size(), "hits and misses are counted");
+}
+
+void TestCapacity()
+{
+    constexpr size_t CAPACITY = 8;
+    LaunchPlanCache<Plan> cache(CAPACITY);
+    for (uint32_t m = 1; m <= 3 * CAPACITY; ++m) {
+        cache.Get(MakeKey(MakeKernelInfo(m, 1, 1), 0, BLOCK_NUM), [] { return Plan{}; });
+        Check(cache.GetStats().plans <= CAPACITY, "the cache holds at most capacity plans");
+    }
+    cache.Clear();
+    Check(cache.GetStats().plans == 0, "Clear drops all plans");
+}
+
+// every thread gets the plan built for its problem, whichever thread built it
+void TestThreads()
+{
+    constexpr size_t THREAD_NUM = 8;
+    constexpr uint32_t SHAPE_NUM = 64;
+    constexpr size_t ROUNDS = 2000;
+    LaunchPlanCache<Plan> cache;
+    std::atomic<size_t> builds{0};
+    std::atomic<size_t> wrong{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREAD_NUM; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < ROUNDS; ++i) {
+                uint32_t m = static_cast<uint32_t>((i * (t + 1)) % SHAPE_NUM) + 1;
+                Plan plan = cache.Get(MakeKey(MakeKernelInfo(m, 1, 1), 0, BLOCK_NUM), [&]() {
+                    builds.fetch_add(1);
+                    return Plan{m, 0, BLOCK_NUM};
+                });
+                wrong += plan.configIdx != m ? 1 : 0;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    Check(wrong == 0, "threads get the plans of their problems");
+    Check(builds >= SHAPE_NUM && builds < SHAPE_NUM * THREAD_NUM, "plans are built about once per problem");
+}
+
+template <class Run>
+double Measure(size_t calls, Run &&run)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+        run(i);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Benchmark(size_t calls)
+{
+    // projections of a decode step, m is the batch
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> shapes;
+    for (uint32_t m : {1, 4, 16, 64}) {
+        shapes.emplace_back(m, 4096, 4096);
+        shapes.emplace_back(m, 12288, 4096);
+        shapes.emplace_back(m, 4096, 11008);
+        shapes.emplace_back(m, 22016, 4096);
+    }
+    Catlass::Library::TuningDatabase db = MakeDatabase();
+    double uncached = Measure(calls, [&](size_t i) {
+        auto [m, n, k] = shapes[i % shapes.size()];
+        KernelInfo kernelInfo = MakeKernelInfo(m, n, k);
+        g_sink = Resolve(db, kernelInfo).configIdx;
+    });
+    LaunchPlanCache<Plan> cache;
+    KernelInfo kernelInfo;
+    bool same = true;
+    double cached = Measure(calls, [&](size_t i) {
+        auto [m, n, k] = shapes[i % shapes.size()];
+        kernelInfo.m = m;
+        kernelInfo.n = n;
+        kernelInfo.k = k;
+        kernelInfo.inputAddr.resize(2);
+        kernelInfo.outputAddr.resize(1);
+        Plan plan = cache.Get(MakeKey(kernelInfo, 0, BLOCK_NUM), [&] { return Resolve(db, kernelInfo); });
+        g_sink = plan.configIdx;
+        if (i < shapes.size()) {
+            same = same && plan.configIdx == Resolve(db, kernelInfo).configIdx;
+        }
+    });
+    LaunchPlanCacheStats stats = cache.GetStats();
+    printf("%zu tuning records, %zu shapes, %zu calls\n", db.Size(), shapes.size(), calls);
+    printf("resolve per call %8.1f ns/call\n", uncached / calls * 1e9);
+    printf("launch plan hit  %8.1f ns/call  (%zu plans built)\n", cached / calls * 1e9, stats.misses);
+    printf("speedup %.1fx\n", uncached / cached);
+    Check(same, "cached plans select the tiling of the tuning database");
+    Check(stats.misses == shapes.size(), "a plan per shape");
+}
+
+} // namespace
+
+int main(int argc, const char **argv)
+{
+    const size_t defaultCalls = 200000;
+    size_t calls = argc > 1 ? std::stoul(argv[1]) : defaultCalls;
+    TestBuildOnce();
+    TestCapacity();
+    TestThreads();
+    Benchmark(calls);
+    return HostTest::Report();
+}
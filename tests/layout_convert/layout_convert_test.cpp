@@ -0,0 +1,491 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the layout converters of examples/common/layout_convert.hpp.
+// Usage: layout_convert_test [rows] [cols]
+// Every conversion is bit-exact with a scalar loop over GetOffset of the layouts (the element order of gen_data.py
+// for the conv3d filter), pads with zeros, reads back, and gives the same bytes on any number of threads. The golden
+// conv2d on converted data is the plain NCHW convolution. The benchmark converts a rows x cols fp16 matrix and a
+// ResNet-sized fmap and filter on one thread and on all of them, in GB/s of bytes read and written.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opdev/fp16_t.h>
+
+#include "host_test.hpp"
+
+#include "catlass/layout/layout.hpp"
+
+#include "golden.hpp"
+#include "layout_convert.hpp"
+
+using namespace Catlass;
+using op::fp16_t;
+
+namespace {
+
+using HostTest::Check;
+
+std::string ShapeStr(std::vector<uint32_t> const &dims)
+{
+    std::string str;
+    for (size_t i = 0; i < dims.size(); ++i) {
+        str += (i == 0 ? "" : "x") + std::to_string(dims[i]);
+    }
+    return str;
+}
+
+template <class Element>
+void FillRandom(std::vector<Element> &data)
+{
+    for (auto &value : data) {
+        value = static_cast<Element>(rand() % 251 + 1);
+    }
+}
+
+template <class Element>
+const char *TypeName()
+{
+    if constexpr (sizeof(Element) == 1) {
+        return "b8";
+    } else if constexpr (sizeof(Element) == 2) {
+        return "b16";
+    } else {
+        return "b32";
+    }
+}
+
+/////////////////// Matrices ///////////////////
+
+// (rows, cols) leaving a partial fractal in either dimension, including a single element, and whole fractals
+const std::vector<std::pair<uint32_t, uint32_t>> SHAPES = {
+    {1, 1}, {7, 5}, {16, 32}, {33, 47}, {64, 31}, {130, 200}, {256, 512}, {517, 259}
+};
+
+// GetOffset of zZ and nN gives the origin of the fractal, the offset inside it follows the strides in the fractal
+template <class Layout>
+int64_t ElementOffset(Layout const &layout, uint32_t r, uint32_t c)
+{
+    int64_t offset = layout.GetOffset(MakeCoord(r, c));
+    if constexpr (std::is_same_v<Layout, layout::zZ> || std::is_same_v<Layout, layout::nN>) {
+        offset += (r % layout.shape(0)) * layout.stride(0) + (c % layout.shape(2)) * layout.stride(2);
+    }
+    return offset;
+}
+
+template <class Layout>
+size_t FractalCapacity(Layout const &layout)
+{
+    return static_cast<size_t>(layout.shape(0)) * layout.shape(1) * layout.shape(2) * layout.shape(3);
+}
+
+template <class LayoutNd>
+LayoutNd MakeNdLayout(uint32_t rows, uint32_t cols, uint32_t extra)
+{
+    if constexpr (std::is_same_v<LayoutNd, layout::RowMajor>) {
+        return LayoutNd{rows, cols, static_cast<int64_t>(cols + extra)};
+    } else {
+        return LayoutNd{rows, cols, static_cast<int64_t>(rows + extra)};
+    }
+}
+
+template <class Element, class LayoutNd, class LayoutFractal>
+void TestMatrix(const char *name)
+{
+    for (auto [rows, cols] : SHAPES) {
+        for (uint32_t extra : {0u, 3u}) {
+            std::string tag = std::string(name) + " " + TypeName<Element>() + " " + ShapeStr({rows, cols}) +
+                (extra ? " strided" : "");
+            LayoutNd layoutNd = MakeNdLayout<LayoutNd>(rows, cols, extra);
+            size_t ndSize = std::is_same_v<LayoutNd, layout::RowMajor> ? static_cast<size_t>(rows) * (cols + extra) :
+                static_cast<size_t>(cols) * (rows + extra);
+            std::vector<Element> src(ndSize);
+            FillRandom(src);
+
+            auto layoutFractal = LayoutFractal::template MakeLayout<Element>(rows, cols);
+            std::vector<Element> expected(FractalCapacity(layoutFractal), Element(0));
+            for (uint32_t r = 0; r < rows; ++r) {
+                for (uint32_t c = 0; c < cols; ++c) {
+                    expected[ElementOffset(layoutFractal, r, c)] = src[layoutNd.GetOffset(MakeCoord(r, c))];
+                }
+            }
+
+            std::vector<Element> packed(expected.size(), Element(7));
+            bool ok = convert::NdToFractal(src.data(), layoutNd, packed.data(), layoutFractal, 3);
+            Check(ok && (std::memcmp(packed.data(), expected.data(), expected.size() * sizeof(Element)) == 0),
+                tag + " to fractal matches GetOffset");
+
+            std::vector<Element> back(ndSize, Element(0));
+            ok = convert::FractalToNd(packed.data(), layoutFractal, back.data(), layoutNd, 3);
+            bool same = ok;
+            for (uint32_t r = 0; r < rows; ++r) {
+                for (uint32_t c = 0; c < cols; ++c) {
+                    int64_t offset = layoutNd.GetOffset(MakeCoord(r, c));
+                    same = same && (back[offset] == src[offset]);
+                }
+            }
+            Check(same, tag + " reads back");
+        }
+    }
+}
+
+template <class Element>
+void TestMatrices()
+{
+    TestMatrix<Element, layout::RowMajor, layout::zN>("RowMajor/zN");
+    TestMatrix<Element, layout::ColumnMajor, layout::zN>("ColumnMajor/zN");
+    TestMatrix<Element, layout::RowMajor, layout::nZ>("RowMajor/nZ");
+    TestMatrix<Element, layout::ColumnMajor, layout::nZ>("ColumnMajor/nZ");
+    TestMatrix<Element, layout::RowMajor, layout::zZ>("RowMajor/zZ");
+    TestMatrix<Element, layout::ColumnMajor, layout::zZ>("ColumnMajor/zZ");
+    TestMatrix<Element, layout::RowMajor, layout::nN>("RowMajor/nN");
+    TestMatrix<Element, layout::ColumnMajor, layout::nN>("ColumnMajor/nN");
+}
+
+/////////////////// Feature maps and filters ///////////////////
+
+template <class Element>
+void TestFmap2d(uint32_t n, uint32_t c, uint32_t h, uint32_t w)
+{
+    constexpr uint32_t C0 = BYTE_PER_C0 / sizeof(Element);
+    std::string tag = std::string("NCHW ") + TypeName<Element>() + " " + ShapeStr({n, c, h, w});
+    uint32_t c1 = CeilDiv(c, C0);
+    layout::NC1HWC0 layoutPacked{n, c1, h, w, C0};
+    std::vector<Element> src(static_cast<size_t>(n) * c * h * w);
+    FillRandom(src);
+
+    std::vector<Element> expected(layoutPacked.Capacity(), Element(0));
+    for (uint32_t in = 0; in < n; ++in) {
+        for (uint32_t ic = 0; ic < c; ++ic) {
+            for (uint32_t ih = 0; ih < h; ++ih) {
+                for (uint32_t iw = 0; iw < w; ++iw) {
+                    auto offset = layoutPacked.GetOffset(Conv2dFmapCoord{in, ic / C0, ih, iw, ic % C0});
+                    expected[offset] = src[((static_cast<size_t>(in) * c + ic) * h + ih) * w + iw];
+                }
+            }
+        }
+    }
+    std::vector<Element> packed(expected.size(), Element(7));
+    bool ok = convert::NchwToNc1hwc0(src.data(), n, c, h, w, packed.data(), layoutPacked, 3);
+    Check(ok && (packed == expected), tag + " to NC1HWC0 matches GetOffset");
+    std::vector<Element> back(src.size(), Element(0));
+    ok = convert::Nc1hwc0ToNchw(packed.data(), layoutPacked, back.data(), n, c, h, w, 3);
+    Check(ok && (back == src), tag + " reads back");
+}
+
+template <class Element>
+void TestFmap3d(uint32_t n, uint32_t c, uint32_t d, uint32_t h, uint32_t w)
+{
+    constexpr uint32_t C0 = BYTE_PER_C0 / sizeof(Element);
+    std::string tag = std::string("NCDHW ") + TypeName<Element>() + " " + ShapeStr({n, c, d, h, w});
+    uint32_t c1 = CeilDiv(c, C0);
+    auto layoutPacked = layout::NDC1HWC0::MakeLayout(n, d, c1, h, w, C0);
+    std::vector<Element> src(static_cast<size_t>(n) * c * d * h * w);
+    FillRandom(src);
+
+    std::vector<Element> expected(static_cast<size_t>(n) * d * c1 * h * w * C0, Element(0));
+    for (uint32_t in = 0; in < n; ++in) {
+        for (uint32_t ic = 0; ic < c; ++ic) {
+            for (uint32_t id = 0; id < d; ++id) {
+                for (uint32_t ihw = 0; ihw < h * w; ++ihw) {
+                    auto offset = layoutPacked.GetOffset(Conv3d6HdCoord{in, id, ic / C0, ihw}) + ic % C0;
+                    expected[offset] = src[((static_cast<size_t>(in) * c + ic) * d + id) * h * w + ihw];
+                }
+            }
+        }
+    }
+    std::vector<Element> packed(expected.size(), Element(7));
+    bool ok = convert::NcdhwToNdc1hwc0(src.data(), n, c, d, h, w, packed.data(), layoutPacked, 3);
+    Check(ok && (packed == expected), tag + " to NDC1HWC0 matches GetOffset");
+    std::vector<Element> back(src.size(), Element(0));
+    ok = convert::Ndc1hwc0ToNcdhw(packed.data(), layoutPacked, back.data(), n, c, d, h, w, 3);
+    Check(ok && (back == src), tag + " reads back");
+}
+
+template <class Element>
+void TestFilter2d(uint32_t cout, uint32_t cin, uint32_t kh, uint32_t kw, uint32_t coutPad)
+{
+    constexpr uint32_t C0 = BYTE_PER_C0 / sizeof(Element);
+    std::string tag = std::string("KCRS ") + TypeName<Element>() + " " + ShapeStr({cout, cin, kh, kw}) +
+        " to " + std::to_string(coutPad);
+    uint32_t c1 = CeilDiv(cin, C0);
+    layout::CI1KHKWCOCI0 layoutPacked{c1, kh, kw, coutPad, C0};
+    std::vector<Element> src(static_cast<size_t>(cout) * cin * kh * kw);
+    FillRandom(src);
+
+    std::vector<Element> expected(layoutPacked.Capacity(), Element(0));
+    for (uint32_t co = 0; co < cout; ++co) {
+        for (uint32_t ic = 0; ic < cin; ++ic) {
+            for (uint32_t ih = 0; ih < kh; ++ih) {
+                for (uint32_t iw = 0; iw < kw; ++iw) {
+                    auto offset = layoutPacked.GetOffset(Conv2dFilterCoord{ic / C0, ih, iw, co, ic % C0});
+                    expected[offset] = src[((static_cast<size_t>(co) * cin + ic) * kh + ih) * kw + iw];
+                }
+            }
+        }
+    }
+    std::vector<Element> packed(expected.size(), Element(7));
+    bool ok = convert::KcrsToFracZ(src.data(), cout, cin, kh, kw, packed.data(), layoutPacked, 3);
+    Check(ok && (packed == expected), tag + " to fractal Z matches GetOffset");
+    std::vector<Element> back(src.size(), Element(0));
+    ok = convert::FracZToKcrs(packed.data(), layoutPacked, back.data(), cout, cin, kh, kw, 3);
+    Check(ok && (back == src), tag + " reads back");
+}
+
+template <class Element>
+void TestFilter3d(uint32_t cout, uint32_t cin, uint32_t kd, uint32_t kh, uint32_t kw)
+{
+    constexpr uint32_t C0 = BYTE_PER_C0 / sizeof(Element);
+    constexpr uint32_t N0 = C0_NUM_PER_FRACTAL;
+    std::string tag = std::string("KCDRS ") + TypeName<Element>() + " " + ShapeStr({cout, cin, kd, kh, kw});
+    uint32_t c1 = CeilDiv(cin, C0);
+    uint32_t n1 = CeilDiv(cout, N0);
+    auto layoutPacked = layout::KDC1KHKWN1N0C0::MakeLayout(kd * c1 * kh * kw, n1, N0, C0);
+    std::vector<Element> src(static_cast<size_t>(cout) * cin * kd * kh * kw);
+    FillRandom(src);
+
+    // the order of gen_data.py of 24_conv_bias: (n1, n0, c1, c0, kd, kh, kw) transposed to (kd, c1, kh, kw, n1, n0, c0)
+    std::vector<Element> expected(static_cast<size_t>(kd) * c1 * kh * kw * n1 * N0 * C0, Element(0));
+    for (uint32_t co = 0; co < cout; ++co) {
+        for (uint32_t ic = 0; ic < cin; ++ic) {
+            for (uint32_t id = 0; id < kd; ++id) {
+                for (uint32_t ihw = 0; ihw < kh * kw; ++ihw) {
+                    size_t row = (static_cast<size_t>(id) * c1 + ic / C0) * kh * kw + ihw;
+                    size_t offset = ((row * n1 + co / N0) * N0 + co % N0) * C0 + ic % C0;
+                    expected[offset] = src[((static_cast<size_t>(co) * cin + ic) * kd + id) * kh * kw + ihw];
+                }
+            }
+        }
+    }
+    std::vector<Element> packed(expected.size(), Element(7));
+    bool ok = convert::KcdrsToFracZ3d(src.data(), cout, cin, kd, kh, kw, packed.data(), layoutPacked, 3);
+    Check(ok && (packed == expected), tag + " to fractal Z 3d matches gen_data.py");
+    std::vector<Element> back(src.size(), Element(0));
+    ok = convert::FracZ3dToKcdrs(packed.data(), layoutPacked, back.data(), cout, cin, kd, kh, kw, 3);
+    Check(ok && (back == src), tag + " reads back");
+}
+
+template <class Element>
+void TestConvLayouts()
+{
+    TestFmap2d<Element>(1, 1, 1, 1);
+    TestFmap2d<Element>(2, 3, 5, 7);
+    TestFmap2d<Element>(2, 40, 9, 13);
+    TestFmap2d<Element>(1, 64, 33, 35);
+    TestFmap3d<Element>(1, 3, 2, 5, 7);
+    TestFmap3d<Element>(2, 40, 3, 9, 6);
+    TestFilter2d<Element>(1, 1, 1, 1, 1);
+    TestFilter2d<Element>(5, 3, 3, 3, 5);
+    TestFilter2d<Element>(80, 112, 3, 3, 80);
+    TestFilter2d<Element>(70, 40, 1, 7, 80);
+    TestFilter3d<Element>(1, 1, 1, 1, 1);
+    TestFilter3d<Element>(20, 40, 3, 3, 3);
+    TestFilter3d<Element>(128, 64, 1, 1, 1);
+}
+
+// The golden conv2d of the examples on converted data is the convolution of the plain tensors
+void TestConv2dGolden()
+{
+    uint32_t batch = 2;
+    uint32_t hi = 9;
+    uint32_t wi = 11;
+    uint32_t cin = 20;
+    uint32_t cout = 32;
+    uint32_t k = 3;
+    Conv2dParams params(batch, hi, wi, cin, cout, k, k, 1, 1, 1, 1, 1, 1, 1, 1);
+    uint32_t ho = params.ho();
+    uint32_t wo = params.wo();
+
+    std::vector<fp16_t> fmap(static_cast<size_t>(batch) * cin * hi * wi);
+    std::vector<fp16_t> filter(static_cast<size_t>(cout) * cin * k * k);
+    // small integers keep every sum exact in fp32
+    for (auto &value : fmap) {
+        value = static_cast<fp16_t>(rand() % 5 - 2);
+    }
+    for (auto &value : filter) {
+        value = static_cast<fp16_t>(rand() % 5 - 2);
+    }
+
+    layout::NC1HWC0 layoutFmap{batch, params.cin1(), hi, wi, params.C0};
+    layout::CI1KHKWCOCI0 layoutFilter{params.cin1(), k, k, cout, params.C0};
+    layout::NC1HWC0 layoutOut{batch, params.cout1(), ho, wo, params.C0};
+    std::vector<fp16_t> fmapPacked(layoutFmap.Capacity());
+    std::vector<fp16_t> filterPacked(layoutFilter.Capacity());
+    bool ok = convert::NchwToNc1hwc0(fmap.data(), batch, cin, hi, wi, fmapPacked.data(), layoutFmap) &&
+        convert::KcrsToFracZ(filter.data(), cout, cin, k, k, filterPacked.data(), layoutFilter);
+    std::vector<float> golden(layoutOut.Capacity());
+    golden::ComputeConv2d(params, fmapPacked, layoutFmap, filterPacked, layoutFilter, golden, layoutOut);
+
+    // the fp32 output of the golden keeps the C0 of fp16, read it with the offsets of its layout
+    bool same = ok;
+    for (uint32_t n = 0; n < batch; ++n) {
+        for (uint32_t co = 0; co < cout; ++co) {
+            for (uint32_t oh = 0; oh < ho; ++oh) {
+                for (uint32_t ow = 0; ow < wo; ++ow) {
+                    float sum = 0;
+                    for (uint32_t ci = 0; ci < cin; ++ci) {
+                        for (uint32_t kh = 0; kh < k; ++kh) {
+                            for (uint32_t kw = 0; kw < k; ++kw) {
+                                int32_t ih = static_cast<int32_t>(oh + kh) - 1;
+                                int32_t iw = static_cast<int32_t>(ow + kw) - 1;
+                                if (ih < 0 || iw < 0 || ih >= static_cast<int32_t>(hi) ||
+                                    iw >= static_cast<int32_t>(wi)) {
+                                    continue;
+                                }
+                                sum += static_cast<float>(fmap[((static_cast<size_t>(n) * cin + ci) * hi + ih) * wi +
+                                    iw]) * static_cast<float>(filter[((static_cast<size_t>(co) * cin + ci) * k + kh) *
+                                    k + kw]);
+                            }
+                        }
+                    }
+                    auto offset = layoutOut.GetOffset(Conv2dFmapCoord{n, co / params.C0, oh, ow, co % params.C0});
+                    same = same && (golden[offset] == sum);
+                }
+            }
+        }
+    }
+    Check(same, "golden conv2d on converted fmap and filter is the NCHW convolution");
+}
+
+void TestThreadsAndErrors()
+{
+    uint32_t rows = 1000;
+    uint32_t cols = 777;
+    layout::ColumnMajor layoutNd{rows, cols};
+    std::vector<uint16_t> src(layoutNd.Capacity());
+    FillRandom(src);
+    auto layoutFractal = layout::zN::MakeLayout<uint16_t>(rows, cols);
+    std::vector<uint16_t> single(layoutFractal.Capacity());
+    convert::NdToFractal(src.data(), layoutNd, single.data(), layoutFractal, 1);
+    for (uint32_t threadNum : {2u, 5u, 16u, 0u}) {
+        std::vector<uint16_t> multi(single.size(), 7);
+        convert::NdToFractal(src.data(), layoutNd, multi.data(), layoutFractal, threadNum);
+        Check(multi == single, std::to_string(threadNum) + " threads convert as one does");
+    }
+
+    Check(!convert::NdToFractal(src.data(), layoutNd, single.data(), layout::zN::MakeLayout<uint16_t>(rows, cols + 1)),
+        "a fractal layout of another shape is rejected");
+    Check(!convert::NdToFractal(src.data(), layoutNd, single.data(), layout::zN::MakeLayout<float>(rows, cols)),
+        "a fractal layout of another element size is rejected");
+    layout::NC1HWC0 layoutFmap{1, 2, 4, 4, 16};
+    Check(!convert::NchwToNc1hwc0(src.data(), 1, 33, 4, 4, single.data(), layoutFmap),
+        "channels of another C1 are rejected");
+    layout::CI1KHKWCOCI0 layoutFilter{1, 3, 3, 16, 16};
+    Check(!convert::KcrsToFracZ(src.data(), 17, 16, 3, 3, single.data(), layoutFilter),
+        "more couts than the fractal Z holds are rejected");
+}
+
+/////////////////// Benchmark ///////////////////
+
+template <class Run>
+double Measure(Run &&run)
+{
+    // the first run touches the pages of the output
+    run();
+    auto start = std::chrono::steady_clock::now();
+    run();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Run>
+void Report(const char *name, double bytes, Run &&run)
+{
+    uint32_t threadNum = std::max(1u, std::thread::hardware_concurrency());
+    double single = Measure([&] { run(1); });
+    double multi = Measure([&] { run(threadNum); });
+    printf("%-28s %7.2f GB/s  %2u threads %7.2f GB/s  speedup %.1fx\n", name, bytes / single / 1e9, threadNum,
+        bytes / multi / 1e9, single / multi);
+}
+
+void Benchmark(uint32_t rows, uint32_t cols)
+{
+    printf("convert %ux%u b16 matrices, a 32x256x56x56 fmap and a 512x512x3x3 filter\n", rows, cols);
+    layout::RowMajor layoutRow{rows, cols};
+    layout::ColumnMajor layoutCol{rows, cols};
+    std::vector<uint16_t> nd(layoutRow.Capacity());
+    FillRandom(nd);
+    auto layoutZn = layout::zN::MakeLayout<uint16_t>(rows, cols);
+    auto layoutNz = layout::nZ::MakeLayout<uint16_t>(rows, cols);
+    std::vector<uint16_t> fractal(layoutZn.Capacity());
+    double bytes = (nd.size() + fractal.size()) * sizeof(uint16_t);
+    Report("RowMajor to zN", bytes, [&](uint32_t threads) {
+        convert::NdToFractal(nd.data(), layoutRow, fractal.data(), layoutZn, threads);
+    });
+    Report("zN to RowMajor", bytes, [&](uint32_t threads) {
+        convert::FractalToNd(fractal.data(), layoutZn, nd.data(), layoutRow, threads);
+    });
+    Report("ColumnMajor to zN", bytes, [&](uint32_t threads) {
+        convert::NdToFractal(nd.data(), layoutCol, fractal.data(), layoutZn, threads);
+    });
+    Report("RowMajor to nZ", bytes, [&](uint32_t threads) {
+        convert::NdToFractal(nd.data(), layoutRow, fractal.data(), layoutNz, threads);
+    });
+
+    uint32_t n = 32;
+    uint32_t c = 256;
+    uint32_t hw = 56;
+    layout::NC1HWC0 layoutFmap{n, c / 16, hw, hw, 16};
+    std::vector<uint16_t> fmap(static_cast<size_t>(n) * c * hw * hw);
+    std::vector<uint16_t> fmapPacked(layoutFmap.Capacity());
+    FillRandom(fmap);
+    Report("NCHW to NC1HWC0", (fmap.size() + fmapPacked.size()) * sizeof(uint16_t), [&](uint32_t threads) {
+        convert::NchwToNc1hwc0(fmap.data(), n, c, hw, hw, fmapPacked.data(), layoutFmap, threads);
+    });
+    Report("NC1HWC0 to NCHW", (fmap.size() + fmapPacked.size()) * sizeof(uint16_t), [&](uint32_t threads) {
+        convert::Nc1hwc0ToNchw(fmapPacked.data(), layoutFmap, fmap.data(), n, c, hw, hw, threads);
+    });
+
+    uint32_t k = 512;
+    layout::CI1KHKWCOCI0 layoutFilter{k / 16, 3, 3, k, 16};
+    std::vector<uint16_t> filter(static_cast<size_t>(k) * k * 9);
+    std::vector<uint16_t> filterPacked(layoutFilter.Capacity());
+    FillRandom(filter);
+    Report("KCRS to fractal Z", (filter.size() + filterPacked.size()) * sizeof(uint16_t), [&](uint32_t threads) {
+        convert::KcrsToFracZ(filter.data(), k, k, 3, 3, filterPacked.data(), layoutFilter, threads);
+    });
+
+    // the scalar loop over GetOffset this replaces
+    double scalar = Measure([&] {
+        for (uint32_t r = 0; r < rows; ++r) {
+            for (uint32_t col = 0; col < cols; ++col) {
+                fractal[layoutZn.GetOffset(MakeCoord(r, col))] = nd[layoutCol.GetOffset(MakeCoord(r, col))];
+            }
+        }
+    });
+    printf("%-28s %7.2f GB/s\n", "ColumnMajor to zN, scalar", bytes / scalar / 1e9);
+}
+
+} // namespace
+
+int main(int argc, const char **argv)
+{
+    const uint32_t defaultRows = 4096;
+    const uint32_t defaultCols = 11008;
+    uint32_t rows = argc > 1 ? std::stoul(argv[1]) : defaultRows;
+    uint32_t cols = argc > 2 ? std::stoul(argv[2]) : defaultCols;
+    srand(0);
+    TestMatrices<int8_t>();
+    TestMatrices<uint16_t>();
+    TestMatrices<float>();
+    TestConvLayouts<int8_t>();
+    TestConvLayouts<uint16_t>();
+    TestConvLayouts<float>();
+    TestConv2dGolden();
+    TestThreadsAndErrors();
+    Benchmark(rows, cols);
+
+    return HostTest::Report();
+}
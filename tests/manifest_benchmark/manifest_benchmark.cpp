@@ -0,0 +1,240 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host benchmark of Library::Manifest startup and lookup, against eager registration and name scans.
+// Usage: manifest_benchmark [operations per kind] [lookups]
+// The operations are synthetic, their descriptions are built like the generated ones of the catlass library.
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "catlass/library/manifest.h"
+
+using namespace Catlass::Library;
+
+namespace Catlass {
+namespace Library {
+
+namespace {
+
+class SyntheticOperation : public Operation {
+public:
+    SyntheticOperation(GemmKind gemmKind, char const *kernelName, TensorDescription const &A,
+        TensorDescription const &B, TensorDescription const &C, TileDescription const &tile)
+    {
+        description_.kind = OperationKind::Gemm;
+        description_.gemmKind = gemmKind;
+        description_.A = A;
+        description_.B = B;
+        description_.C = C;
+        description_.tileDescription = tile;
+        name_ = std::string("catlass_gemm_") + kernelName + "_" + TensorStr(A) + "_" + TensorStr(B) + "_" +
+            TensorStr(C) + "_" + ShapeStr(tile.L1TileShape) + "_" + ShapeStr(tile.L0TileShape) + "_swizzle" +
+            std::to_string(tile.blockSwizzle.offset) + "x" + std::to_string(tile.blockSwizzle.direction);
+        description_.name = name_.c_str();
+    }
+
+    Status CanImplement(void *, void *) override { return Status::kSuccess; }
+    size_t GetWorkspaceSize(void *, void *) override { return 0; }
+    Status Initialize(void *, void *, uint8_t *, aclrtStream) override { return Status::kSuccess; }
+    Status Run(aclrtStream, uint32_t, uint64_t) override { return Status::kSuccess; }
+    OperationDescription const &GetDescription() const override { return description_; }
+
+private:
+    static std::string TensorStr(TensorDescription const &tensor)
+    {
+        return std::to_string(static_cast<int>(tensor.element)) + "x" +
+            std::to_string(static_cast<int>(tensor.layout));
+    }
+
+    static std::string ShapeStr(GemmShapeDescription const &shape)
+    {
+        return std::to_string(shape.m) + "x" + std::to_string(shape.n) + "x" + std::to_string(shape.k);
+    }
+
+    GemmOperationDescription description_;
+    std::string name_;
+};
+
+size_t g_operationsPerKind = 2000;
+std::vector<std::unique_ptr<Operation>> g_operations;
+
+struct SyntheticKind {
+    GemmKind gemmKind;
+    char const *kernelName;
+};
+
+// kinds instantiated by the catlass library generator
+constexpr SyntheticKind SYNTHETIC_KINDS[] = {
+    {GemmKind::BasicMatmul, "basic_matmul"},
+    {GemmKind::GroupedMatmul, "grouped_matmul"},
+};
+
+// i-th key of a kind, dtype and layout vary slowest so that operations of one family are contiguous
+GemmOperationKey SyntheticKey(GemmKind gemmKind, size_t i)
+{
+    constexpr uint32_t TILE_NUM = 8;
+    constexpr uint32_t TILE_BASE = 16;
+    constexpr uint32_t SWIZZLE_OFFSETS = 4;
+    constexpr LayoutType LAYOUTS[] = {LayoutType::RowMajor, LayoutType::ColumnMajor};
+    constexpr DataType DATA_TYPES[] = {DataType::Fp16, DataType::Bf16, DataType::Fp32};
+
+    GemmOperationKey key;
+    key.gemmKind = gemmKind;
+    uint32_t l1m = TILE_BASE * (1 + i % TILE_NUM);
+    uint32_t l1n = TILE_BASE * (1 + i / TILE_NUM % TILE_NUM);
+    uint32_t l1k = TILE_BASE * (1 + i / (TILE_NUM * TILE_NUM) % TILE_NUM);
+    size_t rest = i / (TILE_NUM * TILE_NUM * TILE_NUM);
+    key.L1TileShape = GemmShapeDescription(l1m, l1n, l1k);
+    key.L0TileShape = GemmShapeDescription(l1m, l1n, l1k / 2);
+    key.blockSwizzle = BlockSwizzleDescription(rest % SWIZZLE_OFFSETS, rest / SWIZZLE_OFFSETS % 2);
+    rest /= SWIZZLE_OFFSETS * 2;
+    DataType dataType = DATA_TYPES[rest % std::size(DATA_TYPES)];
+    rest /= std::size(DATA_TYPES);
+    key.A = TensorDescription(dataType, LAYOUTS[rest % 2]);
+    key.B = TensorDescription(dataType, LAYOUTS[rest / 2 % 2]);
+    key.C = TensorDescription(dataType, LayoutType::RowMajor);
+    return key;
+}
+
+}
+
+// stands for the generated registration of tools/library/scripts/manifest.py
+void RegisterKernels(Manifest &manifest, OperationKind kind, uint32_t subKind)
+{
+    if (kind != OperationKind::Gemm) {
+        return;
+    }
+    for (auto const &syntheticKind : SYNTHETIC_KINDS) {
+        if (static_cast<uint32_t>(syntheticKind.gemmKind) != subKind) {
+            continue;
+        }
+        for (size_t i = 0; i < g_operationsPerKind; ++i) {
+            GemmOperationKey key = SyntheticKey(syntheticKind.gemmKind, i);
+            TileDescription tile;
+            tile.L1TileShape = key.L1TileShape;
+            tile.L0TileShape = key.L0TileShape;
+            tile.blockSwizzle = key.blockSwizzle;
+            g_operations.emplace_back(std::make_unique<SyntheticOperation>(
+                key.gemmKind, syntheticKind.kernelName, key.A, key.B, key.C, tile));
+            manifest.Append(g_operations.back().get());
+        }
+    }
+}
+
+}
+}
+
+template <class Func>
+static double MeasureUs(Func &&func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// the way the tuner used to find operations, by a substring scan of all names
+static Operation *ScanByName(std::vector<Operation *> const &operations, std::string const &name)
+{
+    for (auto *op : operations) {
+        if (std::string(op->GetDescription().name).find(name) != std::string::npos) {
+            return op;
+        }
+    }
+    return nullptr;
+}
+
+static size_t ScanFamily(std::vector<Operation *> const &operations, GemmOperationQuery const &query)
+{
+    size_t count = 0;
+    for (auto *op : operations) {
+        auto &desp = static_cast<GemmOperationDescription const &>(op->GetDescription());
+        std::string name = desp.name;
+        if (name.find("basic_matmul") != std::string::npos && desp.gemmKind == query.gemmKind &&
+            desp.A.element == query.A.element && desp.A.layout == query.A.layout &&
+            desp.B.element == query.B.element && desp.B.layout == query.B.layout &&
+            desp.C.element == query.C.element && desp.C.layout == query.C.layout) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+int main(int argc, const char **argv)
+{
+    const size_t defaultLookups = 10000;
+    g_operationsPerKind = argc > 1 ? std::stoul(argv[1]) : g_operationsPerKind;
+    size_t lookups = argc > 2 ? std::stoul(argv[2]) : defaultLookups;
+    printf("operations per kind=%zu kinds=%zu lookups=%zu\n", g_operationsPerKind, std::size(SYNTHETIC_KINDS),
+        lookups);
+
+    Manifest eager;
+    double eagerUs = MeasureUs([&]() { eager.Initialize(); });
+    Manifest lazy;
+    double lazyUs = MeasureUs([&]() { lazy.Initialize(GemmKind::BasicMatmul); });
+    printf("%-28s all kinds %10.1f us (%zu ops)  one kind %10.1f us (%zu ops)\n", "startup", eagerUs,
+        eager.GetOperations().size(), lazyUs, lazy.GetOperations().size());
+
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<size_t> dist(0, g_operationsPerKind - 1);
+    std::vector<GemmOperationKey> keys;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < lookups; ++i) {
+        keys.emplace_back(SyntheticKey(GemmKind::BasicMatmul, dist(rng)));
+        names.emplace_back(eager.Find(keys.back())->GetDescription().name);
+    }
+
+    size_t mismatch = 0;
+    double scanUs = MeasureUs([&]() {
+        for (size_t i = 0; i < lookups; ++i) {
+            mismatch += ScanByName(eager.GetOperations(), names[i]) == nullptr;
+        }
+    });
+    double findUs = MeasureUs([&]() {
+        for (size_t i = 0; i < lookups; ++i) {
+            mismatch += names[i] != eager.Find(keys[i])->GetDescription().name;
+        }
+    });
+    printf("%-28s name scan %10.3f us/op  Find     %10.3f us/op  speedup %8.1fx\n", "exact lookup",
+        scanUs / lookups, findUs / lookups, scanUs / findUs);
+
+    GemmOperationQuery query;
+    query.gemmKind = GemmKind::BasicMatmul;
+    query.A = keys[0].A;
+    query.B = keys[0].B;
+    query.C = keys[0].C;
+    const size_t queryRepeats = 100;
+    size_t scanned = 0;
+    size_t queried = 0;
+    double scanFamilyUs = MeasureUs([&]() {
+        for (size_t i = 0; i < queryRepeats; ++i) {
+            scanned = ScanFamily(eager.GetOperations(), query);
+        }
+    });
+    double queryUs = MeasureUs([&]() {
+        for (size_t i = 0; i < queryRepeats; ++i) {
+            queried = eager.Query(query).size();
+        }
+    });
+    printf("%-28s name scan %10.3f us/op  Query    %10.3f us/op  speedup %8.1fx  (%zu candidates)\n",
+        "candidates of (kind, A, B, C)", scanFamilyUs / queryRepeats, queryUs / queryRepeats,
+        scanFamilyUs / queryUs, queried);
+
+    bool success = mismatch == 0 && scanned == queried && eager.Find(GemmOperationKey{}) == nullptr;
+    if (!success) {
+        printf("MISMATCH: %zu lookups differ, scan found %zu candidates\n", mismatch, scanned);
+    }
+    return success ? 0 : 1;
+}
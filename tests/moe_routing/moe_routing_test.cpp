@@ -0,0 +1,166 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the MoE routing and golden used by GroupedMatmulSliceMPerTokenDequantMoe.
+// GenerateMoeRouting gives every token topK distinct experts with weights that sum to 1 and lists every
+// (token, expert) pair exactly once in expert order. ComputeMoeFfnPerTokenDequant, which works token by token, matches
+// the unfused pipeline the kernel replaces: gather the rows by expert, ComputeGroupedMatmulPerTokenDequant, then
+// scatter the weighted rows back to their tokens.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "host_test.hpp"
+
+#include "catlass/layout/layout.hpp"
+
+#include "golden.hpp"
+
+using namespace Catlass;
+
+namespace {
+
+using HostTest::Check;
+
+std::string CaseStr(uint32_t tokenCount, uint32_t topK, uint32_t expertCount)
+{
+    return std::to_string(tokenCount) + " tokens, top " + std::to_string(topK) + " of " +
+        std::to_string(expertCount) + " experts";
+}
+
+void CheckRouting(uint32_t tokenCount, uint32_t topK, uint32_t expertCount)
+{
+    std::string tag = CaseStr(tokenCount, topK, expertCount);
+    auto routing = golden::GenerateMoeRouting(tokenCount, topK, expertCount);
+    size_t rowCount = static_cast<size_t>(tokenCount) * topK;
+
+    bool distinct = true;
+    bool normalized = true;
+    for (uint32_t t = 0; t < tokenCount; ++t) {
+        std::vector<bool> used(expertCount, false);
+        float weightSum = 0.0f;
+        for (uint32_t s = 0; s < topK; ++s) {
+            int32_t expert = routing.tokenExpert[t * topK + s];
+            distinct = distinct && expert >= 0 && static_cast<uint32_t>(expert) < expertCount && !used[expert];
+            if (expert >= 0 && static_cast<uint32_t>(expert) < expertCount) {
+                used[expert] = true;
+            }
+            weightSum += routing.tokenWeight[t * topK + s];
+        }
+        normalized = normalized && std::fabs(weightSum - 1.0f) < 1e-5f;
+    }
+    Check(distinct, "every token has topK distinct experts, " + tag);
+    Check(normalized, "the weights of a token sum to 1, " + tag);
+
+    bool ascending = routing.groupList.size() == expertCount;
+    for (uint32_t e = 1; ascending && e < expertCount; ++e) {
+        ascending = routing.groupList[e - 1] <= routing.groupList[e];
+    }
+    Check(ascending && routing.groupList.back() == static_cast<int32_t>(rowCount),
+        "groupList is the cumulative row count, " + tag);
+
+    // every row of expert e is a (token, e) pair of the routing with its weight, and no pair is listed twice
+    std::vector<bool> seen(rowCount, false);
+    bool matched = ascending;
+    size_t row = 0;
+    for (uint32_t e = 0; matched && e < expertCount; ++e) {
+        int32_t previousToken = -1;
+        for (; row < static_cast<size_t>(routing.groupList[e]); ++row) {
+            int32_t token = routing.tokenIndex[row];
+            bool found = false;
+            for (uint32_t s = 0; s < topK && token >= 0 && static_cast<uint32_t>(token) < tokenCount; ++s) {
+                size_t pair = static_cast<size_t>(token) * topK + s;
+                if (routing.tokenExpert[pair] == static_cast<int32_t>(e) && !seen[pair] &&
+                    routing.tokenWeight[pair] == routing.routingWeight[row]) {
+                    seen[pair] = true;
+                    found = true;
+                }
+            }
+            matched = matched && found && token > previousToken;
+            previousToken = token;
+        }
+    }
+    Check(matched, "tokenIndex lists every (token, expert) pair once in expert order, " + tag);
+}
+
+void CheckGolden(uint32_t tokenCount, uint32_t topK, uint32_t expertCount, uint32_t n, uint32_t k)
+{
+    std::string tag = CaseStr(tokenCount, topK, expertCount) + ", n " + std::to_string(n) + ", k " +
+        std::to_string(k);
+    auto routing = golden::GenerateMoeRouting(tokenCount, topK, expertCount);
+    uint32_t m = tokenCount * topK;
+
+    std::vector<int8_t> hostA(static_cast<size_t>(tokenCount) * k);
+    std::vector<int8_t> hostB(static_cast<size_t>(expertCount) * k * n);
+    std::vector<float> hostScale(static_cast<size_t>(expertCount) * n);
+    std::vector<float> hostPerTokenScale(tokenCount);
+    golden::FillRandomData(hostA, -16, 16);
+    golden::FillRandomData(hostB, -16, 16);
+    golden::FillRandomData(hostScale, 0.0f, 1.0f);
+    golden::FillRandomData(hostPerTokenScale, 0.0f, 1.0f);
+
+    layout::RowMajor layoutA{tokenCount, k};
+    layout::RowMajor layoutB{k, n};
+    layout::RowMajor layoutD{tokenCount, n};
+    std::vector<float> fused(static_cast<size_t>(tokenCount) * n);
+    golden::ComputeMoeFfnPerTokenDequant(GemmCoord{tokenCount, n, k}, topK, routing.tokenExpert,
+        routing.tokenWeight, hostA, layoutA, hostB, layoutB, hostScale, hostPerTokenScale, fused, layoutD);
+
+    // gather, grouped matmul on the rows sorted by expert, weighted scatter
+    std::vector<int8_t> sortedA(static_cast<size_t>(m) * k);
+    std::vector<float> sortedPerTokenScale(m);
+    for (uint32_t row = 0; row < m; ++row) {
+        size_t token = static_cast<size_t>(routing.tokenIndex[row]);
+        std::copy(hostA.begin() + token * k, hostA.begin() + (token + 1) * k, sortedA.begin() + row * k);
+        sortedPerTokenScale[row] = hostPerTokenScale[token];
+    }
+    std::vector<float> sortedD(static_cast<size_t>(m) * n);
+    golden::ComputeGroupedMatmulPerTokenDequant(GemmCoord{m, n, k}, expertCount, routing.groupList,
+        sortedA, layout::RowMajor{m, k}, hostB, layoutB, hostScale, layout::VectorLayout{n},
+        sortedPerTokenScale, layout::VectorLayout{m}, sortedD, layout::RowMajor{m, n});
+    std::vector<float> unfused(static_cast<size_t>(tokenCount) * n, 0.0f);
+    std::vector<float> magnitude(static_cast<size_t>(tokenCount) * n, 0.0f);
+    for (uint32_t row = 0; row < m; ++row) {
+        size_t token = static_cast<size_t>(routing.tokenIndex[row]);
+        for (uint32_t j = 0; j < n; ++j) {
+            float term = routing.routingWeight[row] * sortedD[static_cast<size_t>(row) * n + j];
+            unfused[token * n + j] += term;
+            magnitude[token * n + j] += std::fabs(term);
+        }
+    }
+
+    // the two sums round in a different order, so the error is bounded by the magnitude of the terms
+    bool close = true;
+    for (size_t i = 0; i < fused.size(); ++i) {
+        close = close && std::fabs(fused[i] - unfused[i]) <= 1e-5f * std::max(1.0f, magnitude[i]);
+    }
+    Check(close, "MoE golden equals gather + grouped matmul + weighted scatter, " + tag);
+}
+
+} // namespace
+
+int main()
+{
+    CheckRouting(1, 1, 1);
+    CheckRouting(7, 2, 4);
+    CheckRouting(512, 8, 128);
+    CheckRouting(3, 8, 8);      // every expert of every token
+    CheckRouting(16, 2, 256);   // most experts get no row
+
+    CheckGolden(1, 1, 1, 16, 32);
+    CheckGolden(33, 2, 8, 64, 96);
+    CheckGolden(64, 8, 64, 128, 256);
+    CheckGolden(5, 4, 32, 48, 64);
+
+    return HostTest::Report();
+}
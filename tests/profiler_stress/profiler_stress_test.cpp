@@ -0,0 +1,290 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host stress test of the profiling pipeline of mstuner_catlass.
+// Usage: profiler_stress_test [buffers] [bytes per buffer]
+// The profile channel is a synthetic producer of task records, the real Profiler read thread
+// and ProfileDataHandler parser thread decode them while the main thread polls durations like the tuner does.
+// The same stream is also run through the former mutex + condition variable pipeline which copies every buffer.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "profiler.h"
+
+using namespace Catlass;
+
+namespace {
+
+constexpr uint16_t TASK_DURATION = 50;          // ticks between the start and end record of a task
+constexpr int64_t AICPU_FREQ = 50000;           // ticks per millisecond
+constexpr double EXPECTED_DURATION = static_cast<double>(TASK_DURATION) * 1000 / AICPU_FREQ;   // us
+constexpr uint16_t FUNC_TYPE_END = 1;
+constexpr size_t RECORD_SIZE = Profiler::RECORD_SIZE;
+
+// Endless stream of start and end records of AI core tasks, cut in reads of varying length so that records
+// straddle buffers.
+class SyntheticChannel {
+public:
+    void Reset(size_t bufferNum, size_t bufferSize)
+    {
+        // an even number of records, every start has its end
+        totalSize_ = (bufferNum * bufferSize + 2 * RECORD_SIZE - 1) / (2 * RECORD_SIZE) * (2 * RECORD_SIZE);
+        bufferSize_ = bufferSize;
+        pos_ = 0;
+        reads_ = 0;
+    }
+
+    bool HasData() const { return pos_ < totalSize_; }
+    size_t TaskNum() const { return totalSize_ / RECORD_SIZE / 2; }
+
+    int Read(char *out, size_t capacity)
+    {
+        constexpr size_t JITTER = 24;
+        size_t len = bufferSize_ - JITTER + JITTER * (reads_++ % 3);
+        len = std::min({len, capacity, totalSize_ - pos_});
+        for (size_t written = 0; written < len;) {
+            char record[RECORD_SIZE];
+            size_t recordIdx = (pos_ + written) / RECORD_SIZE;
+            MakeRecord(recordIdx, record);
+            size_t inRecord = (pos_ + written) % RECORD_SIZE;
+            size_t chunk = std::min(RECORD_SIZE - inRecord, len - written);
+            std::memcpy(out + written, record + inRecord, chunk);
+            written += chunk;
+        }
+        pos_ += len;
+        return static_cast<int>(len);
+    }
+
+private:
+    static void MakeRecord(size_t recordIdx, char *record)
+    {
+        std::memset(record, 0, RECORD_SIZE);
+        // task type 0 (AI core) in the high bits, function type 0 start or 1 end in the low bits
+        uint16_t type = recordIdx % 2 == 0 ? 0 : FUNC_TYPE_END;
+        uint64_t time = recordIdx / 2 * TASK_DURATION * 2 + (recordIdx % 2) * TASK_DURATION;
+        std::memcpy(record, &type, sizeof(type));
+        std::memcpy(record + sizeof(uint64_t), &time, sizeof(time));
+    }
+
+    size_t totalSize_{0};
+    size_t bufferSize_{0};
+    size_t pos_{0};
+    size_t reads_{0};
+};
+
+SyntheticChannel g_channel;
+
+// The mutex + condition variable queue of raw vectors the parser used before the lock-free rings.
+class LegacyPipeline {
+public:
+    void Start()
+    {
+        running_ = true;
+        finish_ = false;
+        readThread_ = std::thread([this]() {
+            std::vector<char> outBuf(2 * 1024 * 1024);
+            while (running_) {
+                if (!g_channel.HasData()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+                int curLen = g_channel.Read(outBuf.data(), outBuf.size());
+                std::vector<char> data(outBuf.begin(), outBuf.begin() + curLen);
+                {
+                    std::lock_guard<std::mutex> lock(mtx_);
+                    queue_.emplace(std::move(data));
+                }
+                cv_.notify_all();
+            }
+        });
+        parseThread_ = std::thread([this]() { Parse(); });
+    }
+
+    void Stop()
+    {
+        running_ = false;
+        readThread_.join();
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            finish_ = true;
+        }
+        cv_.notify_all();
+        parseThread_.join();
+    }
+
+    std::vector<double> GetDurations()
+    {
+        std::vector<double> durations;
+        durations_.DoTransaction<void>([&](auto &val) { durations.swap(val); });
+        return durations;
+    }
+
+private:
+    void Parse()
+    {
+        Profiler profiler;
+        std::vector<uint64_t> starts;
+        std::vector<uint64_t> ends;
+        std::vector<char> data;
+        for (bool finish = false; !finish;) {
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_.wait_for(lock, std::chrono::seconds(1), [this]() { return !queue_.empty() || finish_; });
+                finish = finish_;
+                while (!queue_.empty()) {
+                    auto front = queue_.front();
+                    data.insert(data.end(), front.begin(), front.end());
+                    queue_.pop();
+                }
+            }
+            size_t whole = data.size() / RECORD_SIZE * RECORD_SIZE;
+            for (size_t i = 0; i < whole; i += RECORD_SIZE) {
+                std::vector<char> record{&data[i], &data[i] + RECORD_SIZE};
+                profiler.GetDurations(record.data(), record.size(), starts, ends);
+            }
+            Erase(data, whole);
+            size_t n = std::min(starts.size(), ends.size());
+            durations_.DoTransaction<void>([&](auto &val) {
+                for (size_t i = 0; i < n; ++i) {
+                    val.emplace_back(static_cast<double>(ends[i] - starts[i]) * 1000 / AICPU_FREQ);
+                }
+            });
+            Erase(starts, n);
+            Erase(ends, n);
+        }
+    }
+
+    std::thread readThread_;
+    std::thread parseThread_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::queue<std::vector<char>> queue_;
+    MTVar<std::vector<double>> durations_{};
+    MTVar<bool> running_{false};
+    bool finish_{false};
+};
+
+struct StressResult {
+    double seconds{0};
+    size_t durations{0};
+    size_t wrong{0};
+    size_t polls{0};
+};
+
+// Poll durations the way CatlassTuner::UpdateMetrics does between kernel launches.
+template <class GetDurations>
+StressResult Collect(GetDurations &&getDurations, size_t expected, std::chrono::steady_clock::time_point start)
+{
+    constexpr auto TIMEOUT = std::chrono::seconds(120);
+    StressResult result;
+    while (result.durations < expected && std::chrono::steady_clock::now() - start < TIMEOUT) {
+        auto durations = getDurations();
+        ++result.polls;
+        for (double duration : durations) {
+            result.wrong += duration != EXPECTED_DURATION;
+        }
+        result.durations += durations.size();
+        if (durations.empty()) {
+            std::this_thread::yield();
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+bool Report(const char *name, StressResult const &result, size_t bufferNum, size_t bufferSize, size_t expected)
+{
+    constexpr double MEGA = 1024.0 * 1024.0;
+    printf("%-10s %10.0f buffers/s %10.1f MB/s %12.0f tasks/s  (%zu/%zu durations, %zu polls)\n", name,
+        bufferNum / result.seconds, bufferNum * bufferSize / MEGA / result.seconds, result.durations / result.seconds,
+        result.durations, expected, result.polls);
+    if (result.durations != expected || result.wrong != 0) {
+        printf("%s: FAILED, %zu durations of %zu expected, %zu wrong\n", name, result.durations, expected,
+            result.wrong);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// profile channel of the synthetic producer, in place of the one of the driver
+class SyntheticProfileChannel : public ProfileChannel {
+public:
+    bool Start(int32_t) override { return true; }
+    void Stop(int32_t) override {}
+
+    int Poll(ProfileChannelInfo *channels, int num, int) override
+    {
+        if (num <= 0 || !g_channel.HasData()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return 0;
+        }
+        channels[0] = {0, 0};
+        return 1;
+    }
+
+    int Read(const ProfileChannelInfo &, char *outBuf, uint32_t bufSize) override
+    {
+        return g_channel.Read(outBuf, bufSize);
+    }
+
+    int64_t GetAicpuFreq(int32_t) override { return AICPU_FREQ; }
+    std::pair<int64_t, int32_t> GetAicoreFreq(int32_t) override { return {0, 0}; }
+    bool GetChannelDeviceId(int32_t deviceId, int32_t &channelDeviceId) override
+    {
+        channelDeviceId = deviceId;
+        return true;
+    }
+};
+
+int main(int argc, const char **argv)
+{
+    const size_t defaultBufferNum = 20000;
+    const size_t defaultBufferSize = 16 * 1024;
+    size_t bufferNum = argc > 1 ? std::stoul(argv[1]) : defaultBufferNum;
+    size_t bufferSize = argc > 2 ? std::stoul(argv[2]) : defaultBufferSize;
+    printf("buffers=%zu bytes per buffer=%zu\n", bufferNum, bufferSize);
+
+    g_channel.Reset(bufferNum, bufferSize);
+    size_t expected = g_channel.TaskNum();
+    SyntheticProfileChannel profileChannel;
+    ProfileDataHandler handler;
+    handler.SetChannel(&profileChannel);
+    auto start = std::chrono::steady_clock::now();
+    if (!handler.Init()) {
+        printf("Init profile data handler failed\n");
+        return 1;
+    }
+    StressResult queued = Collect([&handler]() { return handler.GetDurations(); }, expected, start);
+    handler.Synchronize();
+    queued.durations += handler.GetDurations().size();
+    bool success = Report("spsc ring", queued, bufferNum, bufferSize, expected);
+
+    g_channel.Reset(bufferNum, bufferSize);
+    LegacyPipeline legacy;
+    start = std::chrono::steady_clock::now();
+    legacy.Start();
+    StressResult locked = Collect([&legacy]() { return legacy.GetDurations(); }, expected, start);
+    legacy.Stop();
+    locked.durations += legacy.GetDurations().size();
+    success = Report("mutex+cv", locked, bufferNum, bufferSize, expected) && success;
+    printf("speedup %.2fx\n", locked.seconds / queued.seconds);
+    return success ? 0 : 1;
+}
@@ -17,6 +17,38 @@ BUILD_SCRIPT_PATH=$(realpath "$SCRIPT_PATH"/../scripts/build.sh)
 
 bash "$SCRIPT_PATH/test_compile.sh"
 
+# host tests
+bash "$BUILD_SCRIPT_PATH" --tests streamk_planner_test || exit 1
+"$SCRIPT_PATH/../output/bin/streamk_planner_test"
+bash "$BUILD_SCRIPT_PATH" --tests profiler_stress_test || exit 1
+"$SCRIPT_PATH/../output/bin/profiler_stress_test"
+bash "$BUILD_SCRIPT_PATH" --tests workspace_pool_test || exit 1
+"$SCRIPT_PATH/../output/bin/workspace_pool_test"
+bash "$BUILD_SCRIPT_PATH" --tests launch_plan_cache_test || exit 1
+"$SCRIPT_PATH/../output/bin/launch_plan_cache_test"
+bash "$BUILD_SCRIPT_PATH" --tests grouped_task_table_test || exit 1
+"$SCRIPT_PATH/../output/bin/grouped_task_table_test"
+bash "$BUILD_SCRIPT_PATH" --tests fai_task_plan_test || exit 1
+"$SCRIPT_PATH/../output/bin/fai_task_plan_test"
+bash "$BUILD_SCRIPT_PATH" --tests fai_workspace_plan_test || exit 1
+"$SCRIPT_PATH/../output/bin/fai_workspace_plan_test"
+bash "$BUILD_SCRIPT_PATH" --tests tuner_simulate_test || exit 1
+"$SCRIPT_PATH/../output/bin/tuner_simulate_test"
+bash "$BUILD_SCRIPT_PATH" --tests weight_prepack_test || exit 1
+"$SCRIPT_PATH/../output/bin/weight_prepack_test"
+bash "$BUILD_SCRIPT_PATH" --tests batched_gemv_dispatch_test || exit 1
+"$SCRIPT_PATH/../output/bin/batched_gemv_dispatch_test"
+bash "$BUILD_SCRIPT_PATH" --tests conv_tile_planner_test || exit 1
+"$SCRIPT_PATH/../output/bin/conv_tile_planner_test"
+bash "$BUILD_SCRIPT_PATH" --tests layout_convert_test || exit 1
+"$SCRIPT_PATH/../output/bin/layout_convert_test"
+bash "$BUILD_SCRIPT_PATH" --tests moe_routing_test || exit 1
+"$SCRIPT_PATH/../output/bin/moe_routing_test"
+bash "$BUILD_SCRIPT_PATH" --tests kernel_selection_test || exit 1
+"$SCRIPT_PATH/../output/bin/kernel_selection_test"
+bash "$BUILD_SCRIPT_PATH" --tests tiling_cache_test || exit 1
+"$SCRIPT_PATH/../output/bin/tiling_cache_test"
+
 # example test
 python3 "$SCRIPT_PATH/test_example.py"
 
@@ -37,4 +69,5 @@ bash "$BUILD_SCRIPT_PATH" --clean torch_library || exit 1
 python3 "$SCRIPT_PATH/test_torch_lib.py"
 
 # mstuner_catlass
+python3 "$SCRIPT_PATH/test_tile_search.py"
 python3 "$SCRIPT_PATH/test_mstuner.py"
\ No newline at end of file
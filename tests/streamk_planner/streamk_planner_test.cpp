@@ -0,0 +1,189 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the Stream-K partition planned by StreamkGemmIdentityBlockSwizzle.
+// Usage: streamk_planner_test
+// For every case the kernel loops of StreamkMatmul are replayed on the host and checked:
+//   - every (m, n, k) MAC-iteration is computed exactly once,
+//   - the multiply-accumulates of the cores differ by at most one iteration in the stream-k part,
+//   - every stream-k tile has one owner, and the fix-up reads exactly the partial slots written for the tile,
+//   - without stream-k tiles no core has a slot, so the kernel needs no workspace.
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "host_test.hpp"
+
+#include "catlass/gemm/block/block_swizzle.hpp"
+
+using namespace Catlass;
+
+namespace {
+
+struct PlannerCase {
+    GemmCoord problemShape;
+    GemmCoord tileShape;
+    uint32_t coreNum;
+};
+
+template <uint32_t SwizzleOffset, uint32_t SwizzleDirection>
+bool CheckPartition(PlannerCase const &plannerCase)
+{
+    using Scheduler = Gemm::Block::StreamkGemmIdentityBlockSwizzle<SwizzleOffset, SwizzleDirection>;
+    Scheduler scheduler(plannerCase.problemShape, plannerCase.tileShape, plannerCase.coreNum);
+    const GemmCoord &problemShape = plannerCase.problemShape;
+    const GemmCoord &tileShape = plannerCase.tileShape;
+    const uint32_t coreNum = plannerCase.coreNum;
+    const GemmCoord loopsMNK = CeilDiv(problemShape, tileShape);
+    const uint32_t tiles = loopsMNK.m() * loopsMNK.n();
+
+    char caseStr[160];
+    snprintf(caseStr, sizeof(caseStr), "m=%u n=%u k=%u tile=%ux%ux%u cores=%u swizzle=%u,%u", problemShape.m(),
+        problemShape.n(), problemShape.k(), tileShape.m(), tileShape.n(), tileShape.k(), coreNum, SwizzleOffset,
+        SwizzleDirection);
+    auto fail = [&caseStr](const char *reason) {
+        printf("FAILED %s: %s\n", caseStr, reason);
+        return false;
+    };
+
+    // coverage[(mIdx * n + nIdx) * k + kIdx] counts the computations of a MAC-iteration
+    std::vector<uint32_t> coverage(static_cast<size_t>(tiles) * loopsMNK.k(), 0);
+    std::vector<uint32_t> elementK(static_cast<size_t>(tiles), 0);
+    std::vector<uint32_t> owners(static_cast<size_t>(tiles), 0);
+    std::vector<uint64_t> coreSkIters(coreNum, 0);
+    // writer[taskIdx * coreNum + coreIdx] marks the partial slot of coreIdx written for the tile
+    std::vector<uint8_t> writer(static_cast<size_t>(tiles) * coreNum, 0);
+
+    auto cover = [&](GemmCoord const &blockCoord, GemmCoord const &actualBlockShape) {
+        if (blockCoord.m() >= loopsMNK.m() || blockCoord.n() >= loopsMNK.n()) {
+            return false;
+        }
+        uint32_t kTiles = CeilDiv(actualBlockShape.k(), tileShape.k());
+        if (blockCoord.k() + kTiles > loopsMNK.k() ||
+            blockCoord.k() * tileShape.k() + actualBlockShape.k() > problemShape.k()) {
+            return false;
+        }
+        size_t tileIdx = static_cast<size_t>(blockCoord.m()) * loopsMNK.n() + blockCoord.n();
+        for (uint32_t kIdx = blockCoord.k(); kIdx < blockCoord.k() + kTiles; ++kIdx) {
+            ++coverage[tileIdx * loopsMNK.k() + kIdx];
+        }
+        elementK[tileIdx] += actualBlockShape.k();
+        return true;
+    };
+
+    for (uint32_t coreIdx = 0; coreIdx < coreNum; ++coreIdx) {
+        for (uint32_t taskIdx = coreIdx; taskIdx < scheduler.GetCoreLoops(); taskIdx += coreNum) {
+            GemmCoord blockCoord = scheduler.GetBlockCoord(taskIdx);
+            if (!cover(blockCoord, scheduler.GetActualBlockShape(blockCoord))) {
+                return fail("data parallel task out of range");
+            }
+        }
+        for (uint32_t segmentIdx = 0; segmentIdx < scheduler.GetSkSegmentNum(coreIdx); ++segmentIdx) {
+            auto segment = scheduler.GetSkSegment(coreIdx, segmentIdx);
+            if (segment.taskIdx < scheduler.GetCoreLoops() || segment.taskIdx >= tiles ||
+                segment.kTileBegin >= segment.kTileEnd) {
+                return fail("empty or data parallel stream-k segment");
+            }
+            GemmCoord blockCoord = scheduler.GetBlockCoord(segment);
+            if (!cover(blockCoord, scheduler.GetActualBlockShape(blockCoord, segment))) {
+                return fail("stream-k segment out of range");
+            }
+            coreSkIters[coreIdx] += segment.kTileEnd - segment.kTileBegin;
+            if (segment.kTileBegin == 0) {
+                ++owners[segment.taskIdx];
+            } else if (segmentIdx != 0 || coreIdx >= scheduler.GetSkCoreNum()) {
+                return fail("partial segment without a slot");
+            } else {
+                writer[static_cast<size_t>(segment.taskIdx) * coreNum + coreIdx] = 1;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < coverage.size(); ++i) {
+        if (coverage[i] != 1) {
+            return fail("MAC-iteration not computed exactly once");
+        }
+    }
+    for (size_t i = 0; i < elementK.size(); ++i) {
+        if (elementK[i] != problemShape.k()) {
+            return fail("k elements of a tile do not sum to k");
+        }
+    }
+
+    // the fix-up adds the slots of the cores after the owner
+    for (uint32_t taskIdx = scheduler.GetCoreLoops(); taskIdx < tiles; ++taskIdx) {
+        if (owners[taskIdx] != 1) {
+            return fail("stream-k tile without exactly one owner");
+        }
+        uint32_t ownerCoreIdx = scheduler.GetSkOwnerCoreIdx(taskIdx);
+        uint32_t lastCoreIdx = scheduler.GetSkLastCoreIdx(taskIdx);
+        for (uint32_t coreIdx = 0; coreIdx < coreNum; ++coreIdx) {
+            bool read = coreIdx > ownerCoreIdx && coreIdx <= lastCoreIdx;
+            if (read != (writer[static_cast<size_t>(taskIdx) * coreNum + coreIdx] == 1)) {
+                return fail("fix-up slots differ from the written partials");
+            }
+        }
+    }
+
+    if (scheduler.GetSkTileNum() == 0 && scheduler.GetSkCoreNum() != 0) {
+        return fail("partial slots without stream-k tiles");
+    }
+
+    // data parallel tasks are whole waves, so the balance is decided by the stream-k iterations
+    if (scheduler.GetCoreLoops() % coreNum != 0) {
+        return fail("data parallel tasks are not whole waves");
+    }
+    uint64_t minIters = UINT64_MAX;
+    uint64_t maxIters = 0;
+    for (uint32_t coreIdx = 0; coreIdx < scheduler.GetSkCoreNum(); ++coreIdx) {
+        minIters = coreSkIters[coreIdx] < minIters ? coreSkIters[coreIdx] : minIters;
+        maxIters = coreSkIters[coreIdx] > maxIters ? coreSkIters[coreIdx] : maxIters;
+    }
+    if (scheduler.GetSkCoreNum() > 0 && maxIters - minIters > 1) {
+        return fail("stream-k iterations are not balanced");
+    }
+    for (uint32_t coreIdx = scheduler.GetSkCoreNum(); coreIdx < coreNum; ++coreIdx) {
+        if (coreSkIters[coreIdx] != 0) {
+            return fail("stream-k iterations on a core without a slot");
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    const uint32_t shapes[] = {1, 15, 128, 255, 256, 1000, 2048};
+    const uint32_t ks[] = {1, 64, 256, 1000, 4096, 8192};
+    const GemmCoord tileShapes[] = {{128, 256, 256}, {256, 128, 256}, {64, 64, 128}};
+    const uint32_t coreNums[] = {1, 2, 7, 20, 24};
+
+    size_t cases = 0;
+    size_t failures = 0;
+    for (uint32_t m : shapes) {
+        for (uint32_t n : shapes) {
+            for (uint32_t k : ks) {
+                for (auto const &tileShape : tileShapes) {
+                    for (uint32_t coreNum : coreNums) {
+                        PlannerCase plannerCase{GemmCoord{m, n, k}, tileShape, coreNum};
+                        failures += CheckPartition<1, 0>(plannerCase) ? 0 : 1;
+                        failures += CheckPartition<3, 0>(plannerCase) ? 0 : 1;
+                        failures += CheckPartition<2, 1>(plannerCase) ? 0 : 1;
+                        cases += 3;
+                    }
+                }
+            }
+        }
+    }
+    printf("%zu cases checked, %zu failed\n", cases, failures);
+    return failures == 0 ? 0 : 1;
+}
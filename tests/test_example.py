@@ -110,6 +110,11 @@ normal_cases = ["00_basic_matmul 256 512 1024 0",
                 "30_w8a16_matmul 256 512 1024 0",
                 "31_small_matmul 256 1024 256 0",
                 "33_basic_conv2d 2 33 43 112 80 3 3 2 2 2 2 1 1 1 1 0",
+                "34_streamk_matmul 1000 2000 4096 0",
+                "35_grouped_matmul_slice_m_task_table 256 512 1024 2048 0",
+                "36_prepacked_weight_matmul 256 512 1024 0",
+                "37_batched_gemv 8 256 512 0",
+                "38_grouped_matmul_moe_fused_permute 128 512 1024 2048 0",
                 "102_dynamic_optimized_matmul 256 512 1024 0 0 0"
                 ]
 
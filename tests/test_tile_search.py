@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+# ----------------------------------------------------------------------------
+# This program is free software, you can redistribute it and/or modify.
+# Copyright (c) 2025 Huawei Technologies Co., Ltd.
+# This file is a part of the CANN Open Software.
+# Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+# Please refer to the License for details. You may not use this file except in compliance with the License.
+# THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+# See LICENSE in the root of the software repository for the full text of the License.
+# ----------------------------------------------------------------------------
+
+import os
+import sys
+import unittest
+
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tools", "library", "scripts"))
+
+import search_space  # noqa: E402
+import search_space_config  # noqa: E402
+
+
+class TileSearchTest(unittest.TestCase):
+    """Offline check of the mstuner_catlass search loop against a synthetic cost, no device is needed."""
+
+    # add custom test cases below, (m, n, k)
+    search_cases = [
+        (256, 512, 1024),
+        (4096, 4096, 4096),
+        (1000, 3000, 777),
+        (64, 8192, 300),
+    ]
+
+    # near-optimal within 2%, using less than 15% of the search space
+    COST_TOLERANCE = 1.02
+    BUDGET_RATIO = 0.15
+
+    @classmethod
+    def setUpClass(cls):
+        cls.candidates = search_space.generate_search_candidates(search_space_config.get_configuration())
+
+    def run_one_case(self, strategy, shape):
+        cost = search_space.synthetic_matmul_cost(*shape)
+        optimal_cost = min(cost(candidate) for candidate in self.candidates)
+        search = search_space.TileShapeSearch(self.candidates, strategy=strategy, seed=0)
+        best, best_cost = search_space.run_tile_search(
+            search, lambda batch: {candidate: cost(candidate) for candidate in batch})
+
+        self.assertIsNotNone(best, f'{strategy} found no candidate for {shape}')
+        self.assertLessEqual(
+            best_cost, optimal_cost * self.COST_TOLERANCE,
+            f'{strategy} best cost {best_cost} is far from the optimum {optimal_cost} for {shape}'
+        )
+        self.assertLessEqual(
+            len(search.observed), len(self.candidates) * self.BUDGET_RATIO,
+            f'{strategy} evaluated {len(search.observed)} of {len(self.candidates)} candidates for {shape}'
+        )
+
+    def test_surrogate_search(self):
+        for shape in self.search_cases:
+            self.run_one_case('surrogate', shape)
+
+    def test_evolution_search(self):
+        for shape in self.search_cases:
+            self.run_one_case('evolution', shape)
+
+    def test_failed_candidates(self):
+        # candidates missing from the evaluation result are failed builds or runs and are never the best
+        cost = search_space.synthetic_matmul_cost(256, 512, 1024)
+        search = search_space.TileShapeSearch(self.candidates, seed=0)
+        best, best_cost = search_space.run_tile_search(
+            search,
+            lambda batch: {candidate: cost(candidate) for candidate in batch if candidate.l1_tile_shape[0] != 128},
+            max_rounds=5
+        )
+        self.assertNotEqual(best.l1_tile_shape[0], 128)
+        self.assertEqual(best_cost, cost(best))
+
+    def test_prune_block_swizzles(self):
+        # a fake simulation that prefers larger offsets
+        swizzles = [f'Gemm::Block::GemmIdentityBlockSwizzle<{offset}, 0>' for offset in (1, 3, 5)]
+        candidates = [
+            search_space.TileCandidate(candidate.l1_tile_shape, candidate.l0_tile_shape, swizzle)
+            for candidate in self.candidates[:10] for swizzle in swizzles
+        ]
+        calls = []
+
+        def simulate(l1_tile_shape, block_swizzles):
+            calls.append(l1_tile_shape)
+            return {
+                search_space.normalize_block_swizzle(swizzle): 100.0 / int(swizzle.split('<')[1].split(',')[0])
+                for swizzle in block_swizzles
+            }
+
+        pruned = search_space.prune_block_swizzles(candidates, simulate, keep=1)
+        self.assertEqual(len(pruned), 10)
+        self.assertTrue(all(candidate.block_swizzle == swizzles[2] for candidate in pruned))
+        # one simulation per L1 tile shape
+        self.assertEqual(len(calls), len({candidate.l1_tile_shape for candidate in self.candidates[:10]}))
+
+        # within tolerance both swizzles survive, swizzles without prediction are kept
+        pruned = search_space.prune_block_swizzles(
+            candidates, lambda shape, block_swizzles: {'Gemm::Block::GemmIdentityBlockSwizzle<3,0>': 1.0,
+                                                      'Gemm::Block::GemmIdentityBlockSwizzle<5,0>': 1.05},
+            keep=2)
+        self.assertEqual(len(pruned), 30)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,280 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the tiling decision cache of 102_dynamic_optimized_matmul.
+// Usage: tiling_cache_test
+// Every decision of the cache is compared with the tiling and kernel selection run without it:
+//   - threads looking up and inserting the same shapes at once get the right decisions, count every call once and
+//     keep one entry per shape, also while a small cache evicts,
+//   - a saved file maps back with every decision and no tiling run, and saving it again writes the same bytes,
+//   - files of another version, platform or cost model, and truncated or corrupt files, are rejected.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "host_test.hpp"
+
+#include "do_tiling_b16.h"
+#include "select_kernel_b16.h"
+#include "tiling_cache.h"
+
+namespace {
+
+using HostTest::Check;
+
+constexpr uint32_t THREAD_NUM = 8;
+constexpr uint32_t ROUND_NUM = 4;
+
+std::vector<TilingParams> MakeShapes()
+{
+    const uint32_t sizes[] = {1, 16, 100, 256, 1000, 4095, 8192};
+    const uint32_t depths[] = {16, 200, 1024, 16384};
+    std::vector<TilingParams> shapes;
+    for (uint32_t m : sizes) {
+        for (uint32_t n : sizes) {
+            for (uint32_t k : depths) {
+                auto layoutTagA = static_cast<LayoutTag>((m + k) % 2);
+                auto layoutTagB = static_cast<LayoutTag>((n / 16) % 2);
+                shapes.emplace_back(m, n, k, layoutTagA, layoutTagB, LayoutTag::TagRowMajor);
+            }
+        }
+    }
+    return shapes;
+}
+
+void Compute(TilingParams &tilingParams, PlatformInfo &platformInfo)
+{
+    DoTilingB16[tilingParams.layoutTagA][tilingParams.layoutTagB](tilingParams, platformInfo);
+    SelectKernelB16(tilingParams, platformInfo);
+}
+
+bool SameDecision(const TilingParams &lhs, const TilingParams &rhs)
+{
+    return lhs.m == rhs.m && lhs.n == rhs.n && lhs.k == rhs.k && lhs.strideA == rhs.strideA &&
+        lhs.strideB == rhs.strideB && lhs.strideC == rhs.strideC && lhs.m1 == rhs.m1 && lhs.n1 == rhs.n1 &&
+        lhs.k1 == rhs.k1 && lhs.splitkFactor == rhs.splitkFactor && lhs.layoutTagA == rhs.layoutTagA &&
+        lhs.layoutTagB == rhs.layoutTagB && lhs.layoutTagC == rhs.layoutTagC &&
+        lhs.paddingTagA == rhs.paddingTagA && lhs.paddingTagB == rhs.paddingTagB &&
+        lhs.paddingTagC == rhs.paddingTagC && lhs.blockDim == rhs.blockDim &&
+        lhs.tilingKey.value == rhs.tilingKey.value;
+}
+
+std::vector<TilingParams> MakeReference(const std::vector<TilingParams> &shapes, PlatformInfo &platformInfo)
+{
+    std::vector<TilingParams> reference = shapes;
+    for (auto &tilingParams : reference) {
+        Compute(tilingParams, platformInfo);
+    }
+    return reference;
+}
+
+// Looks every shape up through the cache, returns how many decisions differ from the reference
+uint32_t LookUpAll(TilingCache &tilingCache, const std::vector<TilingParams> &shapes,
+    const std::vector<TilingParams> &reference, PlatformInfo &platformInfo, std::atomic<uint32_t> &computeNum,
+    uint32_t start = 0)
+{
+    uint32_t wrong = 0;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        size_t idx = (start + i) % shapes.size();
+        TilingParams tilingParams = shapes[idx];
+        tilingCache.GetOrCompute<uint16_t>(tilingParams, [&platformInfo, &computeNum](TilingParams &params) {
+            computeNum.fetch_add(1, std::memory_order_relaxed);
+            Compute(params, platformInfo);
+        });
+        wrong += SameDecision(tilingParams, reference[idx]) ? 0 : 1;
+    }
+    return wrong;
+}
+
+// THREAD_NUM threads look up all shapes ROUND_NUM times, each starting at another shape
+void CheckConcurrent(size_t capacity, uint32_t shardNum, const std::vector<TilingParams> &shapes,
+    const std::vector<TilingParams> &reference)
+{
+    std::string tag = "capacity " + std::to_string(capacity) + ", " + std::to_string(shardNum) + " shards";
+    TilingCache tilingCache(capacity, shardNum);
+    std::atomic<uint32_t> computeNum{0};
+    std::atomic<uint32_t> wrong{0};
+    std::vector<std::thread> threads;
+    for (uint32_t threadIdx = 0; threadIdx < THREAD_NUM; ++threadIdx) {
+        threads.emplace_back([&, threadIdx]() {
+            PlatformInfo platformInfo{CostModel()};
+            for (uint32_t round = 0; round < ROUND_NUM; ++round) {
+                uint32_t start = static_cast<uint32_t>(shapes.size() * threadIdx / THREAD_NUM) + round;
+                wrong += LookUpAll(tilingCache, shapes, reference, platformInfo, computeNum, start);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    TilingCacheStats stats = tilingCache.GetStats();
+    uint64_t callNum = static_cast<uint64_t>(shapes.size()) * THREAD_NUM * ROUND_NUM;
+    Check(wrong == 0, std::to_string(wrong.load()) + " wrong decisions, " + tag);
+    Check(stats.hits + stats.misses == callNum && stats.misses == computeNum,
+        "hits " + std::to_string(stats.hits) + " and misses " + std::to_string(stats.misses) + " of " +
+        std::to_string(callNum) + " calls, " + tag);
+    Check(stats.misses >= shapes.size(), "every shape is computed at least once, " + tag);
+    Check(stats.entries <= std::min(capacity, shapes.size()),
+        std::to_string(stats.entries) + " entries, " + tag);
+    if (capacity / shardNum >= shapes.size()) {
+        // nothing is evicted, a shape is computed again only by threads missing it at the same time
+        Check(stats.entries == shapes.size() && stats.misses <= shapes.size() * THREAD_NUM,
+            "one entry per shape, " + tag);
+        PlatformInfo platformInfo{CostModel()};
+        computeNum = 0;
+        Check(LookUpAll(tilingCache, shapes, reference, platformInfo, computeNum) == 0 && computeNum == 0,
+            "every shape hits once cached, " + tag);
+    }
+}
+
+std::string ReadFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool WriteFile(const std::string &path, const std::string &content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    return file.good();
+}
+
+void CheckSaveLoad(const std::vector<TilingParams> &shapes, const std::vector<TilingParams> &reference)
+{
+    const std::string path = "tiling_cache_test.bin";
+    const std::string copyPath = "tiling_cache_test.copy.bin";
+    PlatformInfo platformInfo{CostModel()};
+    std::atomic<uint32_t> computeNum{0};
+
+    TilingCache saved;
+    LookUpAll(saved, shapes, reference, platformInfo, computeNum);
+    Check(saved.Save(path, platformInfo), "save the cache");
+    std::string content = ReadFile(path);
+    Check(content.size() == sizeof(TilingCacheFileHeader) + shapes.size() * sizeof(TilingCacheRecord),
+        "file of " + std::to_string(content.size()) + " bytes holds every shape");
+
+    // the mapped file answers every shape without running the tiling
+    TilingCache loaded;
+    Check(loaded.Load(path, platformInfo), "load the saved file");
+    computeNum = 0;
+    uint32_t wrong = LookUpAll(loaded, shapes, reference, platformInfo, computeNum);
+    TilingCacheStats stats = loaded.GetStats();
+    Check(wrong == 0 && computeNum == 0 && stats.mappedEntries == shapes.size() && stats.entries == 0,
+        "the loaded file holds every decision, " + std::to_string(wrong) + " wrong, " +
+        std::to_string(computeNum.load()) + " computed");
+
+    // the records are written field by field, saving the mapped decisions again gives the same file
+    Check(loaded.Save(copyPath, platformInfo) && ReadFile(copyPath) == content, "save a loaded file byte for byte");
+
+    // a new shape found after the load is kept with the mapped ones
+    std::vector<TilingParams> extra{TilingParams{333, 777, 555, LayoutTag::TagRowMajor, LayoutTag::TagColumnMajor,
+        LayoutTag::TagRowMajor}};
+    std::vector<TilingParams> extraReference = MakeReference(extra, platformInfo);
+    LookUpAll(loaded, extra, extraReference, platformInfo, computeNum);
+    TilingCache merged;
+    computeNum = 0;
+    Check(loaded.Save(copyPath, platformInfo) && merged.Load(copyPath, platformInfo) &&
+        LookUpAll(merged, shapes, reference, platformInfo, computeNum) == 0 &&
+        LookUpAll(merged, extra, extraReference, platformInfo, computeNum) == 0 && computeNum == 0,
+        "save the mapped and the new decisions together");
+
+    std::remove(path.c_str());
+    std::remove(copyPath.c_str());
+}
+
+// A rejected file maps nothing, and the cache still computes and caches decisions
+void CheckRejected(const std::string &content, PlatformInfo &platformInfo, const std::string &what,
+    const std::vector<TilingParams> &shapes, const std::vector<TilingParams> &reference)
+{
+    const std::string path = "tiling_cache_test.bad.bin";
+    TilingCache tilingCache;
+    std::atomic<uint32_t> computeNum{0};
+    bool loaded = WriteFile(path, content) && tilingCache.Load(path, platformInfo);
+    uint32_t wrong = LookUpAll(tilingCache, shapes, reference, platformInfo, computeNum);
+    Check(!loaded && tilingCache.GetStats().mappedEntries == 0, "reject " + what);
+    Check(wrong == 0 && computeNum == shapes.size(), "compute the decisions after rejecting " + what);
+    std::remove(path.c_str());
+}
+
+void CheckInvalidFiles(const std::vector<TilingParams> &shapes, const std::vector<TilingParams> &reference)
+{
+    const std::string path = "tiling_cache_test.bin";
+    PlatformInfo platformInfo{CostModel()};
+    std::atomic<uint32_t> computeNum{0};
+    TilingCache saved;
+    LookUpAll(saved, shapes, reference, platformInfo, computeNum);
+    Check(saved.Save(path, platformInfo), "save the cache");
+    const std::string content = ReadFile(path);
+    std::remove(path.c_str());
+    if (content.size() <= sizeof(TilingCacheFileHeader)) {
+        Check(false, "the saved file holds records");
+        return;
+    }
+
+    std::string wrongVersion = content;
+    wrongVersion[offsetof(TilingCacheFileHeader, version)] ^= 1;
+    CheckRejected(wrongVersion, platformInfo, "a file of another version", shapes, reference);
+
+    std::string wrongMagic = content;
+    wrongMagic[0] ^= 0x20;
+    CheckRejected(wrongMagic, platformInfo, "a file with another magic", shapes, reference);
+
+    std::string wrongRecordSize = content;
+    wrongRecordSize[offsetof(TilingCacheFileHeader, recordSize)] ^= 8;
+    CheckRejected(wrongRecordSize, platformInfo, "a file of another record size", shapes, reference);
+
+    CheckRejected(content.substr(0, content.size() - 1), platformInfo, "a truncated file", shapes, reference);
+    CheckRejected(content + std::string(sizeof(TilingCacheRecord), '\0'), platformInfo,
+        "a file with more records than its header", shapes, reference);
+    CheckRejected(content.substr(0, sizeof(TilingCacheFileHeader) - 1), platformInfo, "a file shorter than a header",
+        shapes, reference);
+    CheckRejected("", platformInfo, "an empty file", shapes, reference);
+
+    // the decisions depend on the platform and the cost model they were made with
+    CostModel fewerCores;
+    fewerCores.coreNum = 20;
+    PlatformInfo otherPlatform(fewerCores);
+    CheckRejected(content, otherPlatform, "a file of another platform", shapes,
+        MakeReference(shapes, otherPlatform));
+    CostModel slowerAiv;
+    slowerAiv.aivBand /= 2;
+    PlatformInfo otherModel(slowerAiv);
+    CheckRejected(content, otherModel, "a file of another cost model", shapes, MakeReference(shapes, otherModel));
+
+    TilingCache missing;
+    Check(!missing.Load(path + ".missing", platformInfo) && missing.GetStats().mappedEntries == 0,
+        "reject a missing file");
+}
+
+} // namespace
+
+int main()
+{
+    PlatformInfo platformInfo{CostModel()};
+    std::vector<TilingParams> shapes = MakeShapes();
+    std::vector<TilingParams> reference = MakeReference(shapes, platformInfo);
+
+    CheckConcurrent(TilingCache::DEFAULT_CAPACITY, TilingCache::DEFAULT_SHARD_NUM, shapes, reference);
+    CheckConcurrent(shapes.size(), 1, shapes, reference);
+    CheckConcurrent(16, 4, shapes, reference);
+    CheckSaveLoad(shapes, reference);
+    CheckInvalidFiles(shapes, reference);
+
+    return HostTest::Report();
+}
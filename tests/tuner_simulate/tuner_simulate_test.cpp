@@ -0,0 +1,551 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the simulated device of mstuner_catlass.
+// Usage: tuner_simulate_test [soc]
+// CatlassTuner runs synthetic basic and grouped matmul operations on a SimulatedDevice. Every task duration in the
+// csv must be the modelled duration of its operation and no device memory may be left allocated. With noise, the
+// median of the adaptive runs must stay closer to the model than a single run, the fastest measured operation must
+// be within 2% of the fastest modelled one, and stopping slow operations early must save runs. The operations tuned
+// per second and the runs saved are reported.
+// Then the operations are tuned on 4 simulated devices, each slower than the one before. Every operation must be in
+// the csv once with the duration of the first device after the correction. A simulated device takes no wall time,
+// so how the operations spread over the devices is only reported; the work-stealing queue is checked on its own
+// with workers of different speeds.
+// Last, a weighted list of shapes is swept in one run. The best operation of every shape must be the fastest
+// modelled one, the cover set must be within 2% of the best of every shape, and the sweep must allocate device
+// memory no more often than a run of its largest shape alone. Its time is reported against one run per shape.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catlass/library/manifest.h"
+#include "catlass_tuner.h"
+#include "simulated_device.h"
+#include "work_stealing_queue.h"
+
+using namespace Catlass;
+using namespace Catlass::Library;
+
+namespace Catlass {
+namespace Library {
+
+namespace {
+
+class SyntheticOperation : public Operation {
+public:
+    SyntheticOperation(GemmKind gemmKind, char const *kernelName, TileDescription const &tile)
+    {
+        TensorDescription tensor(DataType::Fp16, LayoutType::RowMajor);
+        description_.kind = OperationKind::Gemm;
+        description_.gemmKind = gemmKind;
+        description_.A = tensor;
+        description_.B = tensor;
+        description_.C = tensor;
+        description_.tileDescription = tile;
+        name_ = std::string("catlass_gemm_") + kernelName + "_fp16_row_fp16_row_fp16_row_" +
+            ShapeStr(tile.L1TileShape) + "_" + ShapeStr(tile.L0TileShape) + "_swizzle" +
+            std::to_string(tile.blockSwizzle.offset) + "x" + std::to_string(tile.blockSwizzle.direction);
+        description_.name = name_.c_str();
+    }
+
+    Status CanImplement(void *, void *) override { return Status::kSuccess; }
+    size_t GetWorkspaceSize(void *, void *) override { return 0; }
+    Status Initialize(void *, void *, uint8_t *, aclrtStream) override { return Status::kSuccess; }
+    Status Run(aclrtStream, uint32_t, uint64_t) override { return Status::kSuccess; }
+    OperationDescription const &GetDescription() const override { return description_; }
+
+private:
+    static std::string ShapeStr(GemmShapeDescription const &shape)
+    {
+        return std::to_string(shape.m) + "x" + std::to_string(shape.n) + "x" + std::to_string(shape.k);
+    }
+
+    GemmOperationDescription description_;
+    std::string name_;
+};
+
+// every tuner registers the same operations of a kind again
+std::map<GemmKind, std::vector<std::unique_ptr<Operation>>> g_operations;
+
+}
+
+// stands for the generated registration of tools/library/scripts/manifest.py
+void RegisterKernels(Manifest &manifest, OperationKind kind, uint32_t subKind)
+{
+    const GemmShapeDescription L1_TILES[] = {
+        {128, 256, 256}, {256, 128, 256}, {128, 128, 256}, {64, 256, 512}, {256, 256, 128}, {128, 512, 128},
+    };
+    const BlockSwizzleDescription SWIZZLES[] = {{1, 0}, {3, 0}, {1, 1}, {3, 1}};
+    if (kind != OperationKind::Gemm) {
+        return;
+    }
+    auto gemmKind = static_cast<GemmKind>(subKind);
+    char const *kernelName = gemmKind == GemmKind::BasicMatmul ? "basic_matmul" :
+        gemmKind == GemmKind::GroupedMatmul ? "grouped_matmul" : nullptr;
+    if (kernelName == nullptr) {
+        return;
+    }
+    constexpr uint32_t L0_K = 64;
+    auto &operations = g_operations[gemmKind];
+    for (size_t i = operations.size(); i < std::size(L1_TILES) * std::size(SWIZZLES); ++i) {
+        TileDescription tile;
+        tile.L1TileShape = L1_TILES[i / std::size(SWIZZLES)];
+        tile.L0TileShape = GemmShapeDescription(tile.L1TileShape.m, tile.L1TileShape.n, L0_K);
+        tile.blockSwizzle = SWIZZLES[i % std::size(SWIZZLES)];
+        operations.emplace_back(std::make_unique<SyntheticOperation>(gemmKind, kernelName, tile));
+    }
+    for (auto &op : operations) {
+        manifest.Append(op.get());
+    }
+}
+
+}
+}
+
+namespace {
+
+constexpr double TOLERANCE = 0.02;  // us, a tick of the records and the precision of the csv
+
+struct TuneCase {
+    const char *kernel;
+    GemmKind gemmKind;
+    uint32_t m;
+    uint32_t n;
+    uint32_t k;
+    uint32_t groupCount;
+};
+
+struct TuneResult {
+    std::map<std::string, double> durations;  // csv task duration of every description
+    std::map<std::string, int> devices;       // csv device id of every description
+    size_t lines{0};
+    uint64_t taskNum{0};                      // tasks run on all devices, the L2 cache clears included
+    double seconds{0};
+    double deviceSeconds{0};                  // modelled time of the busiest device
+    uint64_t mallocNum{0};                    // device memory allocations of all devices
+};
+
+std::vector<std::string> Split(const std::string &s)
+{
+    std::vector<std::string> cells;
+    std::stringstream ss(s);
+    for (std::string cell; std::getline(ss, cell, ',');) {
+        cells.emplace_back(cell);
+    }
+    return cells;
+}
+
+bool ReadCsv(const std::string &path, TuneResult &result)
+{
+    std::ifstream file(path);
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line)) {
+        printf("Read %s failed\n", path.c_str());
+        return false;
+    }
+    auto head = Split(line);
+    size_t durationIdx = head.size();
+    size_t descriptionIdx = head.size();
+    size_t deviceIdx = head.size();
+    for (size_t i = 0; i < head.size(); ++i) {
+        durationIdx = head[i] == "task_duration(us)" ? i : durationIdx;
+        descriptionIdx = head[i] == "description" ? i : descriptionIdx;
+        deviceIdx = head[i] == "device_id" ? i : deviceIdx;
+    }
+    while (std::getline(file, line)) {
+        auto cells = Split(line);
+        if (std::max({durationIdx, descriptionIdx, deviceIdx}) >= cells.size()) {
+            printf("Bad line of %s: %s\n", path.c_str(), line.c_str());
+            return false;
+        }
+        result.durations[cells[descriptionIdx]] = std::stod(cells[durationIdx]);
+        result.devices[cells[descriptionIdx]] = std::stoi(cells[deviceIdx]);
+        ++result.lines;
+    }
+    return true;
+}
+
+bool Tune(const std::string &soc, TuneCase const &tuneCase, const std::vector<std::string> &options,
+    TuneResult &result)
+{
+    std::string output = std::string("tuner_simulate_output/") + tuneCase.kernel + ".csv";
+    std::vector<std::string> args{
+        "tuner_simulate_test",
+        "--simulate=" + soc,
+        "--kernels=" + std::string(tuneCase.kernel),
+        "--m=" + std::to_string(tuneCase.m),
+        "--n=" + std::to_string(tuneCase.n),
+        "--k=" + std::to_string(tuneCase.k),
+        "--group_count=" + std::to_string(tuneCase.groupCount),
+        "--output=" + output,
+    };
+    args.insert(args.end(), options.begin(), options.end());
+    std::vector<const char *> argv;
+    for (auto &arg : args) {
+        argv.emplace_back(arg.c_str());
+    }
+    CommandLineParser parser;
+    parser.Parse(static_cast<int>(argv.size()), argv.data());
+    std::vector<std::shared_ptr<SimulatedDevice>> devices;
+    auto createDevice = [&devices](CommandLineParser &p, int32_t deviceId) {
+        auto device = SimulatedDevice::Create(p, deviceId);
+        devices.emplace_back(device);
+        return device;
+    };
+    auto start = std::chrono::steady_clock::now();
+    {
+        CatlassTuner tuner(parser, createDevice);
+        tuner.Run();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (auto &device : devices) {
+        if (!device) {
+            return false;
+        }
+        if (device->GetMemorySize() != 0) {
+            printf("%s: %zu bytes of device memory are not freed\n", tuneCase.kernel, device->GetMemorySize());
+            return false;
+        }
+        result.deviceSeconds = std::max(result.deviceSeconds, device->GetDeviceTime() / 1e6);
+        result.taskNum += device->GetTaskNum();
+        result.mallocNum += device->GetMallocNum();
+    }
+    return !devices.empty() && ReadCsv(output, result);
+}
+
+double Estimate(SimulatedDevice const &device, TuneCase const &tuneCase, Operation *op)
+{
+    if (tuneCase.gemmKind == GemmKind::BasicMatmul) {
+        BasicMatmulGemmConfiguration config{tuneCase.m, tuneCase.n, tuneCase.k};
+        return device.EstimateDuration(op->GetDescription(), &config);
+    }
+    GroupedMatmulGemmConfiguration config{tuneCase.m, tuneCase.n, tuneCase.k, tuneCase.groupCount};
+    return device.EstimateDuration(op->GetDescription(), &config);
+}
+
+bool CheckCase(const std::string &soc, TuneCase const &tuneCase)
+{
+    SimulatedDeviceSpec spec;
+    SimulatedDevice::GetSpec(soc, spec);
+    SimulatedDevice model(spec);
+    TuneResult exact;
+    TuneResult noisy;
+    TuneResult exhaustive;
+    constexpr double NOISE = 0.05;
+    std::string noise = "--simulate_noise=" + std::to_string(NOISE);
+    if (!Tune(soc, tuneCase, {}, exact) || !Tune(soc, tuneCase, {noise}, noisy) ||
+        !Tune(soc, tuneCase, {noise, "--early_stop=0"}, exhaustive)) {
+        return false;
+    }
+    size_t checked = 0;
+    double relative = 0;
+    std::string best;
+    double bestUs = 0;
+    std::string measuredBest;
+    for (auto &op : g_operations[tuneCase.gemmKind]) {
+        std::string name = op->GetDescription().name;
+        double expected = Estimate(model, tuneCase, op.get());
+        auto it = exact.durations.find(name);
+        if (it == exact.durations.end() || noisy.durations.count(name) == 0) {
+            printf("%s: %s is not in the csv\n", tuneCase.kernel, name.c_str());
+            return false;
+        }
+        if (expected <= 0 || std::fabs(it->second - expected) > TOLERANCE) {
+            printf("%s: %s took %.3f us, modelled %.3f us\n", tuneCase.kernel, name.c_str(), it->second, expected);
+            return false;
+        }
+        relative += std::fabs(noisy.durations[name] / expected - 1);
+        if (best.empty() || expected < bestUs) {
+            best = name;
+            bestUs = expected;
+        }
+        if (measuredBest.empty() || noisy.durations[name] < noisy.durations[measuredBest]) {
+            measuredBest = name;
+        }
+        ++checked;
+    }
+    // the mean deviation of a single run is 0.8 noise, as the mean of |N(0, 1)| is 0.8
+    relative /= std::max<size_t>(checked, 1);
+    if (checked == 0 || relative > NOISE * 0.8) {
+        printf("%s: mean relative deviation %.4f with noise %.2f\n", tuneCase.kernel, relative, NOISE);
+        return false;
+    }
+    auto measuredOp = std::find_if(g_operations[tuneCase.gemmKind].begin(), g_operations[tuneCase.gemmKind].end(),
+        [&](auto &op) { return measuredBest == op->GetDescription().name; });
+    double measuredBestUs = Estimate(model, tuneCase, measuredOp->get());
+    constexpr double BEST_TOLERANCE = 0.02;
+    if (measuredBestUs > bestUs * (1 + BEST_TOLERANCE)) {
+        printf("%s: picked %s of %.3f us, the best is %s of %.3f us\n", tuneCase.kernel, measuredBest.c_str(),
+            measuredBestUs, best.c_str(), bestUs);
+        return false;
+    }
+    if (noisy.taskNum >= exhaustive.taskNum) {
+        printf("%s: %lu tasks with early stop, %lu without\n", tuneCase.kernel, noisy.taskNum, exhaustive.taskNum);
+        return false;
+    }
+    printf("%-16s %ux%ux%u groups=%-4u %zu operations, %8.1f operations/s, best %s %.3f us, picked %.3f us, "
+        "deviation %.3f, early stop ran %lu of %lu tasks\n", tuneCase.kernel, tuneCase.m, tuneCase.n, tuneCase.k,
+        tuneCase.groupCount, checked, checked / exact.seconds, best.c_str(), bestUs, measuredBestUs, relative,
+        noisy.taskNum, exhaustive.taskNum);
+    return true;
+}
+
+bool CheckParallel(const std::string &soc, TuneCase const &tuneCase)
+{
+    SimulatedDeviceSpec spec;
+    SimulatedDevice::GetSpec(soc, spec);
+    SimulatedDevice model(spec);
+    TuneResult single;
+    TuneResult parallel;
+    constexpr int32_t DEVICE_NUM = 4;
+    if (!Tune(soc, tuneCase, {}, single) ||
+        !Tune(soc, tuneCase, {"--device=0,1,2,3", "--simulate_skew=0.1"}, parallel)) {
+        return false;
+    }
+    auto &operations = g_operations[tuneCase.gemmKind];
+    if (parallel.lines != operations.size()) {
+        printf("%s: %zu lines in the csv of %zu operations\n", tuneCase.kernel, parallel.lines, operations.size());
+        return false;
+    }
+    std::map<int, size_t> perDevice;
+    for (auto &op : operations) {
+        std::string name = op->GetDescription().name;
+        double expected = Estimate(model, tuneCase, op.get());
+        auto it = parallel.durations.find(name);
+        if (it == parallel.durations.end()) {
+            printf("%s: %s is not in the csv\n", tuneCase.kernel, name.c_str());
+            return false;
+        }
+        // the ratios of the devices are measured on rounded durations too
+        if (std::fabs(it->second - expected) > TOLERANCE + expected * 1e-4) {
+            printf("%s: %s took %.3f us corrected, modelled %.3f us\n", tuneCase.kernel, name.c_str(), it->second,
+                expected);
+            return false;
+        }
+        ++perDevice[parallel.devices[name]];
+    }
+    std::string spread;
+    for (auto &[device, num] : perDevice) {
+        if (device < 0 || device >= DEVICE_NUM) {
+            printf("%s: %zu operations ran on device %d\n", tuneCase.kernel, num, device);
+            return false;
+        }
+        spread += " " + std::to_string(device) + ":" + std::to_string(num);
+    }
+    printf("%-16s %d devices, operations per device%s, %8.1f operations/s, modelled device time %.3f s of %.3f s\n",
+        tuneCase.kernel, DEVICE_NUM, spread.c_str(), operations.size() / parallel.seconds, parallel.deviceSeconds,
+        single.deviceSeconds);
+    return true;
+}
+
+// rows of a csv by column name
+bool ReadTable(const std::string &path, std::vector<std::map<std::string, std::string>> &rows)
+{
+    std::ifstream file(path);
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line)) {
+        printf("Read %s failed\n", path.c_str());
+        return false;
+    }
+    auto head = Split(line);
+    while (std::getline(file, line)) {
+        auto cells = Split(line);
+        if (cells.size() != head.size()) {
+            printf("Bad line of %s: %s\n", path.c_str(), line.c_str());
+            return false;
+        }
+        auto &row = rows.emplace_back();
+        for (size_t i = 0; i < head.size(); ++i) {
+            row[head[i]] = cells[i];
+        }
+    }
+    return true;
+}
+
+bool CheckSweep(const std::string &soc)
+{
+    SimulatedDeviceSpec spec;
+    SimulatedDevice::GetSpec(soc, spec);
+    SimulatedDevice model(spec);
+    struct Shape {
+        uint32_t m;
+        uint32_t n;
+        uint32_t k;
+        double weight;
+    };
+    // the first shape is listed twice, it is tuned once with the weights added
+    const std::vector<Shape> shapes{
+        {128, 4096, 4096, 20}, {4096, 4096, 4096, 4}, {1, 4096, 11008, 300}, {2048, 1024, 512, 10},
+        {384, 8192, 1024, 50},
+    };
+    std::string path = "tuner_simulate_output/shapes.csv";
+    {
+        std::ofstream file(path);
+        file << "# shapes of a trace\nm,n,k,weight\n";
+        for (auto &s : shapes) {
+            file << s.m << "," << s.n << "," << s.k << "," << s.weight << "\n";
+        }
+        file << "128, 4096, 4096, 10\n";
+    }
+    double totalWeight = 10;
+    for (auto &s : shapes) {
+        totalWeight += s.weight;
+    }
+    auto &operations = g_operations[GemmKind::BasicMatmul];
+    TuneCase largest{"basic_matmul", GemmKind::BasicMatmul, 4096, 4096, 4096, 1};
+    TuneResult sweep;
+    TuneResult single;
+    if (!Tune(soc, largest, {"--shapes=" + path}, sweep) || !Tune(soc, largest, {}, single)) {
+        return false;
+    }
+    if (sweep.lines != operations.size() * shapes.size() || sweep.mallocNum != single.mallocNum) {
+        printf("sweep: %zu lines of %zu shapes, %lu allocations, %lu of the largest shape alone\n", sweep.lines,
+            shapes.size(), sweep.mallocNum, single.mallocNum);
+        return false;
+    }
+    // modelled durations and the modelled best of every shape
+    std::map<std::string, std::vector<double>> modelled;
+    std::vector<double> best(shapes.size(), 0);
+    for (auto &op : operations) {
+        auto &durations = modelled[op->GetDescription().name];
+        for (auto &s : shapes) {
+            durations.emplace_back(Estimate(model, {"basic_matmul", GemmKind::BasicMatmul, s.m, s.n, s.k, 1},
+                op.get()));
+            size_t i = durations.size() - 1;
+            best[i] = best[i] == 0 ? durations[i] : std::min(best[i], durations[i]);
+        }
+    }
+    std::vector<std::map<std::string, std::string>> shapeRows;
+    std::vector<std::map<std::string, std::string>> rankingRows;
+    if (!ReadTable("tuner_simulate_output/basic_matmul_shapes.csv", shapeRows) ||
+        !ReadTable("tuner_simulate_output/basic_matmul_ranking.csv", rankingRows)) {
+        return false;
+    }
+    if (shapeRows.size() != shapes.size() || rankingRows.size() != operations.size()) {
+        printf("sweep: %zu shapes and %zu operations ranked\n", shapeRows.size(), rankingRows.size());
+        return false;
+    }
+    for (auto &row : shapeRows) {
+        auto shape = std::find_if(shapes.begin(), shapes.end(), [&](const Shape &s) {
+            return std::to_string(s.m) == row["m"] && std::to_string(s.n) == row["n"] &&
+                std::to_string(s.k) == row["k"];
+        });
+        size_t i = shape - shapes.begin();
+        if (shape == shapes.end() || modelled.count(row["description"]) == 0 ||
+            modelled[row["description"]][i] > best[i] + TOLERANCE) {
+            printf("sweep: %s,%s,%s picked %s\n", row["m"].c_str(), row["n"].c_str(), row["k"].c_str(),
+                row["description"].c_str());
+            return false;
+        }
+    }
+    // the modelled weighted slowdown of the cover set
+    std::vector<double> covered(shapes.size(), 0);
+    size_t coverNum = 0;
+    for (auto &row : rankingRows) {
+        if (std::stoi(row["cover_order"]) == 0) {
+            continue;
+        }
+        ++coverNum;
+        auto &durations = modelled[row["description"]];
+        for (size_t i = 0; i < shapes.size(); ++i) {
+            covered[i] = covered[i] == 0 ? durations[i] : std::min(covered[i], durations[i]);
+        }
+    }
+    double slowdown = 0;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        double weight = shapes[i].weight + (i == 0 ? 10 : 0);
+        slowdown += weight * (covered[i] > 0 ? covered[i] / best[i] : 0) / totalWeight;
+    }
+    constexpr double COVER_TOLERANCE = 0.02;
+    if (coverNum == 0 || slowdown > 1 + COVER_TOLERANCE + 1e-3) {
+        printf("sweep: %zu operations cover the shapes with slowdown %.4f\n", coverNum, slowdown);
+        return false;
+    }
+    double separate = 0;
+    uint64_t separateMallocNum = 0;
+    for (auto &s : shapes) {
+        TuneResult result;
+        if (!Tune(soc, {"basic_matmul", GemmKind::BasicMatmul, s.m, s.n, s.k, 1}, {}, result)) {
+            return false;
+        }
+        separate += result.seconds;
+        separateMallocNum += result.mallocNum;
+    }
+    printf("sweep            %zu shapes, %zu operations cover them with slowdown %.4f, %.3f s and %lu allocations, "
+        "%.3f s and %lu allocations one run per shape\n", shapes.size(), coverNum, slowdown, sweep.seconds,
+        sweep.mallocNum, separate, separateMallocNum);
+    return true;
+}
+
+// worker i takes (i + 1) * 20 us per task, the first one runs out of its own tasks first and has to steal
+bool CheckQueue()
+{
+    constexpr size_t WORKER_NUM = 4;
+    constexpr size_t TASK_NUM = 1000;
+    WorkStealingQueue queue(WORKER_NUM, TASK_NUM);
+    std::vector<std::atomic<uint32_t>> runs(TASK_NUM);
+    std::vector<size_t> perWorker(WORKER_NUM, 0);
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < WORKER_NUM; ++w) {
+        threads.emplace_back([&, w]() {
+            for (size_t task; queue.Pop(w, task);) {
+                runs[task].fetch_add(1);
+                ++perWorker[w];
+                std::this_thread::sleep_for(std::chrono::microseconds(20 * (w + 1)));
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (size_t i = 0; i < TASK_NUM; ++i) {
+        if (runs[i] != 1) {
+            printf("queue: task %zu ran %u times\n", i, runs[i].load());
+            return false;
+        }
+    }
+    if (queue.GetStealNum() == 0 || perWorker[0] <= TASK_NUM / WORKER_NUM) {
+        printf("queue: %zu steals, the fastest worker ran %zu tasks\n", queue.GetStealNum(), perWorker[0]);
+        return false;
+    }
+    printf("queue            %zu tasks on %zu workers, tasks per worker %zu %zu %zu %zu, %zu steals\n", TASK_NUM,
+        WORKER_NUM, perWorker[0], perWorker[1], perWorker[2], perWorker[3], queue.GetStealNum());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, const char **argv)
+{
+    std::string soc = argc > 1 ? argv[1] : "Ascend910B4";
+    std::vector<TuneCase> tuneCases{
+        {"basic_matmul", GemmKind::BasicMatmul, 4096, 4096, 4096, 1},
+        {"grouped_matmul", GemmKind::GroupedMatmul, 512, 1024, 8192, 16},
+    };
+    bool success = CheckQueue();
+    for (auto &tuneCase : tuneCases) {
+        success = CheckCase(soc, tuneCase) && success;
+        success = CheckParallel(soc, tuneCase) && success;
+    }
+    success = CheckSweep(soc) && success;
+    printf(success ? "all checks passed\n" : "FAILED\n");
+    return success ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the offline weight packer of W4A8 and W8A16 matmul.
+// Usage: weight_prepack_test [k] [n]
+// Packed weights read back to the values the AIV prologues compute, and the golden QuantMatmul and matmul on the
+// packed B are bit-exact with the same golden on the unpacked B. The benchmark packs a k x n int4 weight on one
+// thread and on all of them.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opdev/fp16_t.h>
+
+#include "host_test.hpp"
+
+#include "catlass/layout/layout.hpp"
+
+#include "golden.hpp"
+#include "weight_prepack.hpp"
+
+using namespace Catlass;
+using op::fp16_t;
+
+namespace {
+
+using HostTest::Check;
+
+std::string ShapeStr(uint32_t k, uint32_t n)
+{
+    return std::to_string(k) + "x" + std::to_string(n);
+}
+
+// (k, n) of the weights: odd k that splits an int4 byte, k and n off the 16 x 32 and 16 x 64 fractals, and whole ones
+const std::vector<std::pair<uint32_t, uint32_t>> SHAPES = {
+    {1, 1}, {7, 5}, {16, 32}, {33, 47}, {64, 31}, {130, 200}, {256, 512}, {517, 259}
+};
+
+// int4 values in [-8, 7] and their packing in the layout of W4A8Matmul, two per byte with the lower offset in the
+// low nibble, every line starting at a byte
+template <class Layout>
+void MakeInt4(Layout const &layout, std::vector<int8_t> &values, std::vector<uint8_t> &packed)
+{
+    values.assign(layout.Capacity(), 0);
+    packed.assign((layout.Capacity() + 1) / 2, 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int8_t>(rand() % 16 - 8);
+        packed[i / 2] |= static_cast<uint8_t>((values[i] & 0xF) << ((i % 2) * 4));
+    }
+}
+
+template <class Layout>
+Layout MakeInt4Layout(uint32_t k, uint32_t n)
+{
+    if constexpr (std::is_same_v<Layout, layout::RowMajor>) {
+        return Layout{k, n, (n + 1) / 2 * 2};
+    } else {
+        return Layout{k, n, (k + 1) / 2 * 2};
+    }
+}
+
+template <class Layout>
+void TestInt4RoundTrip(const char *name)
+{
+    for (auto [k, n] : SHAPES) {
+        Layout layoutSrc = MakeInt4Layout<Layout>(k, n);
+        std::vector<int8_t> values;
+        std::vector<uint8_t> src;
+        MakeInt4(layoutSrc, values, src);
+
+        auto layoutPacked = prepack::MakePackedLayout<int8_t, Layout>(k, n);
+        std::vector<int8_t> packed(layoutPacked.Capacity(), 1);
+        bool ok = prepack::PackInt4ToInt8(src.data(), layoutSrc, packed.data(), layoutPacked);
+        Layout layoutBack{k, n};
+        std::vector<int8_t> back(layoutBack.Capacity());
+        prepack::Unpack(packed.data(), layoutPacked, back.data(), layoutBack);
+
+        bool same = ok;
+        long sumValues = 0;
+        long sumPacked = 0;
+        for (uint32_t r = 0; r < k; ++r) {
+            for (uint32_t c = 0; c < n; ++c) {
+                int8_t value = values[layoutSrc.GetOffset(MakeCoord(r, c))];
+                same = same && back[layoutBack.GetOffset(MakeCoord(r, c))] == value;
+                sumValues += std::abs(value);
+            }
+        }
+        for (auto v : packed) {
+            sumPacked += std::abs(v);
+        }
+        Check(same, std::string(name) + " int4 " + ShapeStr(k, n) + " reads back");
+        Check(sumPacked == sumValues, std::string(name) + " int4 " + ShapeStr(k, n) + " pads with zeros");
+    }
+}
+
+// W4A8: the golden QuantMatmul on the packed B is the one on the int8 B the AIV prologue writes
+template <class Layout>
+void TestW4A8Golden(const char *name)
+{
+    for (auto [k, n] : SHAPES) {
+        uint32_t m = 19;
+        GemmCoord problemShape{m, n, k};
+        Layout layoutSrc = MakeInt4Layout<Layout>(k, n);
+        std::vector<int8_t> values;
+        std::vector<uint8_t> src;
+        MakeInt4(layoutSrc, values, src);
+
+        auto layoutPacked = prepack::MakePackedLayout<int8_t, Layout>(k, n);
+        std::vector<int8_t> packed(layoutPacked.Capacity());
+        prepack::PackInt4ToInt8(src.data(), layoutSrc, packed.data(), layoutPacked);
+
+        layout::RowMajor layoutA{m, k};
+        std::vector<int8_t> dataA(layoutA.Capacity());
+        golden::FillRandomData<int8_t>(dataA, -128, 127);
+        std::vector<float> scale(n);
+        std::vector<float> perTokenScale(m);
+        golden::FillRandomData<float>(scale, 0.0f, 1.0f);
+        golden::FillRandomData<float>(perTokenScale, 0.0f, 1.0f);
+        layout::RowMajor layoutC{m, n};
+        std::vector<float> expected(layoutC.Capacity());
+        std::vector<float> actual(layoutC.Capacity());
+        golden::QuantMatmul(problemShape, dataA, layoutA, values, layoutSrc, scale, layout::VectorLayout{n},
+            perTokenScale, layout::VectorLayout{m}, expected, layoutC);
+        golden::QuantMatmul(problemShape, dataA, layoutA, packed, layoutPacked, scale, layout::VectorLayout{n},
+            perTokenScale, layout::VectorLayout{m}, actual, layoutC);
+        Check(memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)) == 0,
+            std::string(name) + " W4A8 " + ShapeStr(k, n) + " QuantMatmul is bit-exact");
+    }
+}
+
+// W8A16: the packed B reads back to the fp16 of TileCastInt8ToFp16Dequant, one rounding per step
+template <class Layout>
+void TestW8A16(const char *name, prepack::DequantGranularity granularity, uint32_t groupSize, bool zeroPoint)
+{
+    for (auto [k, n] : SHAPES) {
+        uint32_t m = 7;
+        GemmCoord problemShape{m, n, k};
+        Layout layoutSrc{k, n};
+        std::vector<int8_t> src(layoutSrc.Capacity());
+        golden::FillRandomData<int8_t>(src, -128, 127);
+
+        prepack::DequantParams params;
+        params.granularity = granularity;
+        params.groupSize = groupSize;
+        size_t scaleNum = granularity == prepack::DequantGranularity::PER_TENSOR ? 1 :
+            granularity == prepack::DequantGranularity::PER_CHANNEL ? n :
+            static_cast<size_t>(CeilDiv(k, groupSize)) * n;
+        params.scale.resize(scaleNum);
+        golden::FillRandomData<float>(params.scale, 0.001f, 0.1f);
+        if (zeroPoint) {
+            params.zeroPoint.resize(scaleNum);
+            golden::FillRandomData<float>(params.zeroPoint, -2.0f, 2.0f);
+        }
+
+        Layout layoutB{k, n};
+        std::vector<fp16_t> expectedB(layoutB.Capacity());
+        for (uint32_t r = 0; r < k; ++r) {
+            for (uint32_t c = 0; c < n; ++c) {
+                size_t s = granularity == prepack::DequantGranularity::PER_TENSOR ? 0 :
+                    granularity == prepack::DequantGranularity::PER_CHANNEL ? c :
+                    static_cast<size_t>(r / groupSize) * n + c;
+                fp16_t q = static_cast<fp16_t>(static_cast<float>(src[layoutSrc.GetOffset(MakeCoord(r, c))]));
+                fp16_t zp = static_cast<fp16_t>(zeroPoint ? params.zeroPoint[s] : 0.0f);
+                fp16_t shifted = static_cast<fp16_t>(static_cast<float>(q) + static_cast<float>(zp));
+                expectedB[layoutB.GetOffset(MakeCoord(r, c))] = static_cast<fp16_t>(
+                    static_cast<float>(shifted) * static_cast<float>(static_cast<fp16_t>(params.scale[s])));
+            }
+        }
+
+        auto layoutPacked = prepack::MakePackedLayout<fp16_t, Layout>(k, n);
+        std::vector<fp16_t> packed(layoutPacked.Capacity());
+        bool ok = prepack::PackInt8ToFp16(src.data(), layoutSrc, params, packed.data(), layoutPacked);
+        std::vector<fp16_t> back(layoutB.Capacity());
+        prepack::Unpack(packed.data(), layoutPacked, back.data(), layoutB);
+        std::string what = std::string(name) + " W8A16 " + ShapeStr(k, n) + " granularity " +
+            std::to_string(static_cast<int>(granularity)) + (zeroPoint ? " with zero point" : "");
+        Check(ok && memcmp(back.data(), expectedB.data(), back.size() * sizeof(fp16_t)) == 0, what + " reads back");
+
+        layout::RowMajor layoutA{m, k};
+        std::vector<fp16_t> dataA(layoutA.Capacity());
+        golden::FillRandomData<fp16_t>(dataA, -5.0f, 5.0f);
+        layout::RowMajor layoutC{m, n};
+        std::vector<float> expected(layoutC.Capacity());
+        std::vector<float> actual(layoutC.Capacity());
+        golden::ReferenceMatmul(problemShape, dataA, layoutA, expectedB, layoutB, expected, layoutC);
+        golden::ReferenceMatmul(problemShape, dataA, layoutA, packed, layoutPacked, actual, layoutC);
+        Check(memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)) == 0,
+            what + " matmul is bit-exact");
+    }
+}
+
+void TestThreadsAndErrors()
+{
+    uint32_t k = 1000;
+    uint32_t n = 3000;
+    auto layoutSrc = MakeInt4Layout<layout::RowMajor>(k, n);
+    std::vector<int8_t> values;
+    std::vector<uint8_t> src;
+    MakeInt4(layoutSrc, values, src);
+    auto layoutPacked = prepack::MakePackedLayout<int8_t, layout::RowMajor>(k, n);
+    std::vector<int8_t> single(layoutPacked.Capacity());
+    prepack::PackInt4ToInt8(src.data(), layoutSrc, single.data(), layoutPacked, 1);
+    for (uint32_t threadNum : {2u, 3u, 8u, 64u}) {
+        std::vector<int8_t> multi(layoutPacked.Capacity(), 1);
+        prepack::PackInt4ToInt8(src.data(), layoutSrc, multi.data(), layoutPacked, threadNum);
+        Check(multi == single, std::to_string(threadNum) + " threads pack as one does");
+    }
+
+    // the packed layout of fp16 has 16 elements per C0, the one of int8 32
+    auto layoutFp16 = prepack::MakePackedLayout<fp16_t, layout::RowMajor>(k, n);
+    Check(!prepack::PackInt4ToInt8(src.data(), layoutSrc, single.data(), layoutFp16), "int4 rejects a fp16 layout");
+    Check(!prepack::PackInt4ToInt8(src.data(), layoutSrc, single.data(),
+        prepack::MakePackedLayout<int8_t, layout::RowMajor>(k, n + 1)), "int4 rejects the layout of another shape");
+    Check(!prepack::PackInt4ToInt8(src.data(), layout::RowMajor{k, n, n + 1}, single.data(), layoutPacked),
+        "int4 rejects rows that do not start at a byte");
+
+    layout::RowMajor layoutInt8{k, n};
+    std::vector<int8_t> int8Src(layoutInt8.Capacity());
+    std::vector<fp16_t> packed(layoutFp16.Capacity());
+    prepack::DequantParams params;
+    params.granularity = prepack::DequantGranularity::PER_CHANNEL;
+    params.scale.assign(n - 1, 1.0f);
+    Check(!prepack::PackInt8ToFp16(int8Src.data(), layoutInt8, params, packed.data(), layoutFp16),
+        "too few channel scales are rejected");
+    params.scale.assign(n, 1.0f);
+    params.zeroPoint.assign(1, 0.0f);
+    Check(!prepack::PackInt8ToFp16(int8Src.data(), layoutInt8, params, packed.data(), layoutFp16),
+        "zero points of another count are rejected");
+    params.granularity = prepack::DequantGranularity::PER_GROUP;
+    params.zeroPoint.clear();
+    Check(!prepack::PackInt8ToFp16(int8Src.data(), layoutInt8, params, packed.data(), layoutFp16),
+        "a group size of zero is rejected");
+}
+
+template <class Run>
+double Measure(Run &&run)
+{
+    auto start = std::chrono::steady_clock::now();
+    run();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Benchmark(uint32_t k, uint32_t n)
+{
+    auto layoutSrc = MakeInt4Layout<layout::RowMajor>(k, n);
+    std::vector<uint8_t> src(layoutSrc.Capacity() / 2);
+    for (auto &byte : src) {
+        byte = static_cast<uint8_t>(rand());
+    }
+    auto layoutPacked = prepack::MakePackedLayout<int8_t, layout::RowMajor>(k, n);
+    std::vector<int8_t> packed(layoutPacked.Capacity());
+    uint32_t threadNum = std::max(1u, std::thread::hardware_concurrency());
+    double bytes = static_cast<double>(packed.size());
+    double single = Measure([&] { prepack::PackInt4ToInt8(src.data(), layoutSrc, packed.data(), layoutPacked, 1); });
+    double multi = Measure([&] {
+        prepack::PackInt4ToInt8(src.data(), layoutSrc, packed.data(), layoutPacked, threadNum);
+    });
+    printf("pack int4 %ux%u to int8 zN\n", k, n);
+    printf(" 1 threads %8.2f ms  %6.2f GB/s\n", single * 1e3, bytes / single / 1e9);
+    printf("%2u threads %8.2f ms  %6.2f GB/s  speedup %.1fx\n", threadNum, multi * 1e3, bytes / multi / 1e9,
+        single / multi);
+}
+
+} // namespace
+
+int main(int argc, const char **argv)
+{
+    const uint32_t defaultK = 4096;
+    const uint32_t defaultN = 11008;
+    uint32_t k = argc > 1 ? std::stoul(argv[1]) : defaultK;
+    uint32_t n = argc > 2 ? std::stoul(argv[2]) : defaultN;
+    srand(0);
+    TestInt4RoundTrip<layout::RowMajor>("RowMajor");
+    TestInt4RoundTrip<layout::ColumnMajor>("ColumnMajor");
+    TestW4A8Golden<layout::RowMajor>("RowMajor");
+    TestW4A8Golden<layout::ColumnMajor>("ColumnMajor");
+    for (bool zeroPoint : {false, true}) {
+        TestW8A16<layout::RowMajor>("RowMajor", prepack::DequantGranularity::PER_TENSOR, 0, zeroPoint);
+        TestW8A16<layout::RowMajor>("RowMajor", prepack::DequantGranularity::PER_CHANNEL, 0, zeroPoint);
+        TestW8A16<layout::RowMajor>("RowMajor", prepack::DequantGranularity::PER_GROUP, 32, zeroPoint);
+        TestW8A16<layout::ColumnMajor>("ColumnMajor", prepack::DequantGranularity::PER_CHANNEL, 0, zeroPoint);
+        TestW8A16<layout::ColumnMajor>("ColumnMajor", prepack::DequantGranularity::PER_GROUP, 64, zeroPoint);
+    }
+    TestThreadsAndErrors();
+    Benchmark(k, n);
+    return HostTest::Report();
+}
@@ -0,0 +1,407 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host test of the stream ordered workspace pool of the shared library.
+// Usage: workspace_pool_test [launches]
+// Streams run on a fake device: kernels complete when the test says so, or after a fixed time in the benchmark,
+// which compares the pool with the former malloc, launch, synchronize and free of every RunAdapter call.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "host_test.hpp"
+
+#include "workspace_pool.hpp"
+
+using namespace CatlassKernel;
+
+namespace {
+
+using HostTest::Check;
+
+using Stream = WorkspaceAllocator::Stream;
+using Event = WorkspaceAllocator::Event;
+
+Stream GetStream(size_t idx)
+{
+    return reinterpret_cast<Stream>(idx + 1);
+}
+
+// Kernels queued on a stream complete in order when Complete is called.
+class ManualDevice : public WorkspaceAllocator {
+public:
+    explicit ManualDevice(size_t capacity = SIZE_MAX) : capacity_(capacity) {}
+
+    // the pool leaves its blocks to the device, as the context frees them on a real one
+    ~ManualDevice() override
+    {
+        for (auto &[ptr, size] : sizes_) {
+            std::free(ptr);
+        }
+    }
+
+    void *Malloc(size_t size) override
+    {
+        if (used_ + size > capacity_) {
+            return nullptr;
+        }
+        used_ += size;
+        void *ptr = std::malloc(size);
+        sizes_[ptr] = size;
+        return ptr;
+    }
+
+    void Free(void *ptr) override
+    {
+        used_ -= sizes_.at(ptr);
+        sizes_.erase(ptr);
+        std::free(ptr);
+    }
+
+    Event CreateEvent() override
+    {
+        events_.emplace_back();
+        ++liveEvents_;
+        return reinterpret_cast<Event>(events_.size());
+    }
+
+    void DestroyEvent(Event event) override
+    {
+        (void)GetEvent(event);
+        --liveEvents_;
+    }
+
+    void RecordEvent(Event event, Stream stream) override
+    {
+        GetEvent(event) = {stream, streams_[stream].launched};
+    }
+
+    bool QueryEvent(Event event) override
+    {
+        const RecordedEvent &recorded = GetEvent(event);
+        return streams_[recorded.stream].completed >= recorded.launched;
+    }
+
+    // returns the sequence number of the kernel on stream
+    size_t Launch(Stream stream)
+    {
+        return ++streams_[stream].launched;
+    }
+
+    void Complete(Stream stream, size_t kernelNum = SIZE_MAX)
+    {
+        StreamState &state = streams_[stream];
+        state.completed = kernelNum == SIZE_MAX ? state.launched : std::min(state.launched, state.completed + kernelNum);
+    }
+
+    bool IsCompleted(Stream stream, size_t seq)
+    {
+        return streams_[stream].completed >= seq;
+    }
+
+    size_t UsedBytes() const { return used_; }
+    size_t LiveBlocks() const { return sizes_.size(); }
+    size_t LiveEvents() const { return liveEvents_; }
+
+private:
+    struct StreamState {
+        size_t launched{0};
+        size_t completed{0};
+    };
+    struct RecordedEvent {
+        Stream stream{nullptr};
+        size_t launched{0};
+    };
+
+    RecordedEvent &GetEvent(Event event)
+    {
+        return events_.at(reinterpret_cast<size_t>(event) - 1);
+    }
+
+    size_t capacity_;
+    size_t used_{0};
+    size_t liveEvents_{0};
+    std::map<void *, size_t> sizes_;
+    std::map<Stream, StreamState> streams_;
+    std::vector<RecordedEvent> events_;
+};
+
+void TestSizeClass()
+{
+    constexpr size_t MB = 1024 * 1024;
+    Check(WorkspacePool::GetSizeClass(1) == 512, "size class of 1 byte");
+    Check(WorkspacePool::GetSizeClass(513) == 1024, "size class of 513 bytes");
+    Check(WorkspacePool::GetSizeClass(MB + 1) == 2 * MB, "size class of 1MB + 1");
+    Check(WorkspacePool::GetSizeClass(2 * MB) == 2 * MB, "size class of 2MB");
+    Check(WorkspacePool::GetSizeClass(5 * MB + 3) == 6 * MB, "size class of 5MB + 3");
+}
+
+void TestSameStreamReuse()
+{
+    ManualDevice device;
+    WorkspacePool pool(device);
+    Stream stream = GetStream(0);
+    uint8_t *first = pool.Allocate(3000, stream);
+    device.Launch(stream);
+    pool.Release(first, stream);
+    // the kernel is still running, the next one on the same stream runs after it
+    uint8_t *second = pool.Allocate(4000, stream);
+    Check(second == first, "same stream reuses a block of a running kernel");
+    Check(pool.GetStats().mallocs == 1 && pool.GetStats().sameStreamHits == 1, "same stream reuse counted");
+    Check(pool.Allocate(4000, stream) != first, "a block in use is not handed out twice");
+    Check(pool.Allocate(0, stream) == nullptr, "empty workspace");
+}
+
+void TestCrossStreamReuse()
+{
+    ManualDevice device;
+    WorkspacePool pool(device);
+    Stream stream0 = GetStream(0);
+    Stream stream1 = GetStream(1);
+    uint8_t *first = pool.Allocate(1 << 20, stream0);
+    device.Launch(stream0);
+    pool.Release(first, stream0);
+    uint8_t *second = pool.Allocate(1 << 20, stream1);
+    Check(second != first, "other stream does not take the block of a running kernel");
+    device.Launch(stream1);
+    pool.Release(second, stream1);
+    device.Complete(stream0);
+    uint8_t *third = pool.Allocate(1 << 20, GetStream(2));
+    Check(third == first, "other stream takes the block once its kernel completed");
+    Check(pool.GetStats().crossStreamHits == 1, "cross stream reuse counted");
+    Check(pool.GetStats().mallocs == 2, "two blocks allocated");
+}
+
+void TestEmptyCache()
+{
+    ManualDevice device;
+    WorkspacePool pool(device);
+    Stream stream = GetStream(0);
+    std::vector<uint8_t *> blocks;
+    for (size_t size = 100; size < (16 << 20); size *= 3) {
+        blocks.push_back(pool.Allocate(size, stream));
+    }
+    device.Launch(stream);
+    for (uint8_t *ptr : blocks) {
+        pool.Release(ptr, stream);
+    }
+    pool.EmptyCache();
+    Check(device.LiveBlocks() == blocks.size(), "blocks of a running kernel are kept");
+    device.Complete(stream);
+    pool.EmptyCache();
+    WorkspacePoolStats stats = pool.GetStats();
+    Check(device.LiveBlocks() == 0 && device.LiveEvents() == 0, "all blocks and events freed");
+    Check(stats.frees == stats.mallocs && stats.allocatedBytes == 0 && stats.cachedBytes == 0, "empty cache stats");
+}
+
+void TestOutOfMemory()
+{
+    constexpr size_t MB = 1024 * 1024;
+    ManualDevice device(8 * MB);
+    WorkspacePool pool(device);
+    Stream stream = GetStream(0);
+    uint8_t *small = pool.Allocate(3 * MB, stream);
+    device.Launch(stream);
+    pool.Release(small, stream);
+    uint8_t *large = pool.Allocate(6 * MB, stream);
+    Check(large == nullptr, "out of memory while the cached block is in use by a kernel");
+    device.Complete(stream);
+    large = pool.Allocate(6 * MB, stream);
+    Check(large != nullptr, "completed cached blocks are freed when out of memory");
+    Check(device.UsedBytes() == 6 * MB, "only the new block is left");
+}
+
+// Random launches on several streams: a block is never handed out while a kernel of another stream may still use
+// it, and never to two users at once.
+void TestRandomSchedule()
+{
+    constexpr size_t STREAM_NUM = 4;
+    constexpr size_t STEPS = 20000;
+    ManualDevice device;
+    WorkspacePool pool(device);
+    std::mt19937 rng(2025);
+    const std::vector<size_t> sizes{256, 700, 4096, 100000, 1 << 20, 3 << 20};
+    struct Use {
+        Stream stream;
+        size_t seq;
+    };
+    std::map<uint8_t *, std::vector<Use>> uses;
+    std::map<uint8_t *, size_t> blockSizes;
+    std::set<uint8_t *> inUse;
+    size_t violations = 0;
+    for (size_t step = 0; step < STEPS; ++step) {
+        Stream stream = GetStream(rng() % STREAM_NUM);
+        if (rng() % 4 == 0) {
+            device.Complete(stream, rng() % 3);
+            continue;
+        }
+        // a kernel with one or two workspaces, like a padding kernel followed by the matmul
+        std::vector<uint8_t *> workspaces;
+        for (size_t i = 0; i < 1 + rng() % 2; ++i) {
+            size_t size = sizes[rng() % sizes.size()];
+            uint8_t *ptr = pool.Allocate(size, stream);
+            violations += ptr == nullptr || !inUse.insert(ptr).second;
+            size_t sizeClass = WorkspacePool::GetSizeClass(size);
+            violations += blockSizes.count(ptr) != 0 && blockSizes[ptr] != sizeClass;
+            blockSizes[ptr] = sizeClass;
+            for (const Use &use : uses[ptr]) {
+                violations += use.stream != stream && !device.IsCompleted(use.stream, use.seq);
+            }
+            workspaces.push_back(ptr);
+        }
+        size_t seq = device.Launch(stream);
+        for (uint8_t *ptr : workspaces) {
+            uses[ptr].push_back({stream, seq});
+            inUse.erase(ptr);
+            pool.Release(ptr, stream);
+        }
+    }
+    WorkspacePoolStats stats = pool.GetStats();
+    printf("random schedule: %zu mallocs, %zu same stream hits, %zu cross stream hits, %zu bytes cached\n",
+        stats.mallocs, stats.sameStreamHits, stats.crossStreamHits, stats.cachedBytes);
+    Check(violations == 0, "random schedule: " + std::to_string(violations) + " unsafe handouts");
+    Check(stats.crossStreamHits > 0, "random schedule reuses blocks across streams");
+    for (size_t i = 0; i < STREAM_NUM; ++i) {
+        device.Complete(GetStream(i));
+    }
+    pool.EmptyCache();
+    Check(device.LiveBlocks() == 0 && device.LiveEvents() == 0, "random schedule leaves no blocks");
+}
+
+void Spin(std::chrono::nanoseconds duration)
+{
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// Device whose kernels run for a fixed time after the previous kernel of the stream, malloc and free cost time.
+class TimedDevice : public WorkspaceAllocator {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::chrono::microseconds MALLOC_TIME{20};
+    static constexpr std::chrono::microseconds FREE_TIME{15};
+    static constexpr std::chrono::microseconds LAUNCH_TIME{5};
+    static constexpr std::chrono::microseconds KERNEL_TIME{30};
+
+    void *Malloc(size_t size) override
+    {
+        Spin(MALLOC_TIME);
+        return std::malloc(size);
+    }
+
+    void Free(void *ptr) override
+    {
+        Spin(FREE_TIME);
+        std::free(ptr);
+    }
+
+    Event CreateEvent() override
+    {
+        events_.emplace_back();
+        return reinterpret_cast<Event>(events_.size());
+    }
+
+    void DestroyEvent(Event) override {}
+
+    void RecordEvent(Event event, Stream stream) override
+    {
+        events_.at(reinterpret_cast<size_t>(event) - 1) = busyUntil_[stream];
+    }
+
+    bool QueryEvent(Event event) override
+    {
+        return Clock::now() >= events_.at(reinterpret_cast<size_t>(event) - 1);
+    }
+
+    void Launch(Stream stream)
+    {
+        Spin(LAUNCH_TIME);
+        Clock::time_point &busyUntil = busyUntil_[stream];
+        busyUntil = std::max(busyUntil, Clock::now()) + KERNEL_TIME;
+    }
+
+    void Synchronize(Stream stream)
+    {
+        while (Clock::now() < busyUntil_[stream]) {
+        }
+    }
+
+private:
+    std::map<Stream, Clock::time_point> busyUntil_;
+    std::vector<Clock::time_point> events_;
+};
+
+template <class Run>
+double Measure(size_t launches, Run &&run)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < launches; ++i) {
+        run(i);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Benchmark(size_t launches)
+{
+    constexpr size_t STREAM_NUM = 2;
+    const std::vector<size_t> sizes{64 * 1024, 96 * 1024, 3 << 20};
+    TimedDevice device;
+    double blocking = Measure(launches, [&](size_t i) {
+        Stream stream = GetStream(i % STREAM_NUM);
+        void *ptr = device.Malloc(sizes[i % sizes.size()]);
+        device.Launch(stream);
+        device.Synchronize(stream);
+        device.Free(ptr);
+    });
+    WorkspacePool pool(device);
+    // the last launch waits for all kernels, as the caller reading the outputs does
+    double pooled = Measure(launches, [&](size_t i) {
+        Stream stream = GetStream(i % STREAM_NUM);
+        uint8_t *ptr = pool.Allocate(sizes[i % sizes.size()], stream);
+        device.Launch(stream);
+        pool.Release(ptr, stream);
+        if (i + 1 == launches) {
+            for (size_t j = 0; j < STREAM_NUM; ++j) {
+                device.Synchronize(GetStream(j));
+            }
+        }
+    });
+    WorkspacePoolStats stats = pool.GetStats();
+    printf("malloc+sync+free %10.0f launches/s\n", launches / blocking);
+    printf("workspace pool   %10.0f launches/s  (%zu mallocs for %zu launches)\n", launches / pooled, stats.mallocs,
+        launches);
+    printf("speedup %.2fx\n", blocking / pooled);
+    Check(stats.mallocs < launches / 10, "pool allocates a small number of blocks");
+    pool.EmptyCache();
+}
+
+} // namespace
+
+int main(int argc, const char **argv)
+{
+    const size_t defaultLaunches = 20000;
+    size_t launches = argc > 1 ? std::stoul(argv[1]) : defaultLaunches;
+    TestSizeClass();
+    TestSameStreamReuse();
+    TestCrossStreamReuse();
+    TestEmptyCache();
+    TestOutOfMemory();
+    TestRandomSchedule();
+    Benchmark(launches);
+    return HostTest::Report();
+}
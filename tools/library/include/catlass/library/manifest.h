@@ -11,6 +11,10 @@
 #ifndef CATLASS_LIBRARY_MANIFEST_H
 #define CATLASS_LIBRARY_MANIFEST_H
 
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "catlass/library/operation.h"
@@ -20,16 +24,63 @@
 namespace Catlass {
 namespace Library {
 
+// Identifies one instantiated gemm operation, key of the Manifest index.
+struct GemmOperationKey {
+    GemmKind gemmKind{GemmKind::Invalid};
+    TensorDescription A;
+    TensorDescription B;
+    TensorDescription C;
+    GemmShapeDescription L1TileShape;
+    GemmShapeDescription L0TileShape;
+    BlockSwizzleDescription blockSwizzle;
+
+    static GemmOperationKey FromDescription(GemmOperationDescription const &desp);
+    bool operator==(GemmOperationKey const &other) const;
+};
+
+struct GemmOperationKeyHash {
+    size_t operator()(GemmOperationKey const &key) const;
+};
+
+// Candidate filter of Manifest::Query, Invalid types and zero shapes match any operation.
+struct GemmOperationQuery {
+    GemmKind gemmKind{GemmKind::Invalid};
+    TensorDescription A;
+    TensorDescription B;
+    TensorDescription C;
+    GemmShapeDescription L1TileShape;
+    GemmShapeDescription L0TileShape;
+};
+
 class Manifest {
 public:
     Manifest() = default;
 
+    // Register operations of all kinds
     Status Initialize();
+    // Register operations of one kind only, later calls for the same kind do nothing
+    Status Initialize(GemmKind gemmKind);
     void Append(Operation *operation_ptr);
+    // Operations registered so far
     std::vector<Operation *> const &GetOperations() const;
 
+    // Operation with exactly this key, registers its kind on first use, nullptr when not instantiated
+    Operation *Find(GemmOperationKey const &key);
+    // Operations matching the query, registers the queried kind (all kinds for GemmKind::Invalid) on first use
+    std::vector<Operation *> Query(GemmOperationQuery const &query);
+
 private:
+    static constexpr size_t GEMM_KIND_NUM = static_cast<size_t>(GemmKind::Invalid);
+
+    static uint64_t FamilyKey(GemmKind gemmKind, TensorDescription const &A, TensorDescription const &B,
+        TensorDescription const &C);
+
     std::vector<Operation *> operationList_;
+    std::bitset<GEMM_KIND_NUM> registeredGemmKinds_;
+    std::unordered_map<GemmOperationKey, Operation *, GemmOperationKeyHash> gemmIndex_;
+    // operations of one (kind, A, B, C), and of one kind
+    std::unordered_map<uint64_t, std::vector<Operation *>> gemmFamilies_;
+    std::vector<Operation *> gemmKinds_[GEMM_KIND_NUM];
 };
 
 }
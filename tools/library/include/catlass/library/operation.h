@@ -86,13 +86,24 @@ struct GemmShapeDescription {
     ) : m(m), n(n), k(k) {}
 };
 
+struct BlockSwizzleDescription {
+    uint32_t offset;
+    uint32_t direction;
+    BlockSwizzleDescription(
+        uint32_t offset = 0U,
+        uint32_t direction = 0U
+    ) : offset(offset), direction(direction) {}
+};
+
 struct TileDescription {
     GemmShapeDescription L1TileShape;
     GemmShapeDescription L0TileShape;
+    BlockSwizzleDescription blockSwizzle;
     TileDescription()
     {
         L1TileShape = GemmShapeDescription(0, 0, 0);
         L0TileShape = GemmShapeDescription(0, 0, 0);
+        blockSwizzle = BlockSwizzleDescription(0, 0);
     }
 };
 
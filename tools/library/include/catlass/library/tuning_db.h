@@ -0,0 +1,318 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_LIBRARY_TUNING_DB_H
+#define CATLASS_LIBRARY_TUNING_DB_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Catlass {
+namespace Library {
+
+// Fastest operation measured by mstuner_catlass for one shape bucket.
+struct TuningRecord {
+    std::string kernel;         // basic_matmul, grouped_matmul_slice_m, ...
+    std::string A;              // dtype:layout, e.g. fp16:row
+    std::string B;
+    std::string C;
+    std::string device;         // soc name, e.g. Ascend910B4
+    uint32_t m{0};              // measured problem shape
+    uint32_t n{0};
+    uint32_t k{0};
+    double taskDuration{0};     // us
+    std::string description;    // catlass_{op}_{kernel}_{A}_{B}_{C}_{l1}_{l0}_swizzle{offset}x{direction}
+
+    // parsed from description
+    std::array<uint32_t, 3> l1TileShape{};
+    std::array<uint32_t, 3> l0TileShape{};
+    uint32_t swizzleOffset{0};
+    uint32_t swizzleDirection{0};
+};
+
+/*
+ * Versioned text database of tuned tilings, written by mstuner_catlass --tuning_db and read at runtime.
+ *
+ *   # catlass tuning database v1
+ *   kernel,A,B,C,device,m_bucket,n_bucket,k_bucket,m,n,k,task_duration(us),description
+ *   basic_matmul,fp16:row,fp16:row,fp16:row,Ascend910B4,8,9,10,256,512,1024,12.340,catlass_gemm_...
+ *
+ * Shapes are grouped by power of two buckets of m, n and k, one record is kept per
+ * (kernel, A, B, C, device, bucket) and a faster measurement replaces the stored one.
+ */
+class TuningDatabase {
+public:
+    static constexpr const char *MAGIC = "# catlass tuning database v";
+    static constexpr uint32_t VERSION = 1;
+    static constexpr const char *HEAD = "kernel,A,B,C,device,m_bucket,n_bucket,k_bucket,m,n,k,task_duration(us),"
+                                        "description";
+    // Lookup falls back to the nearest record within this distance, in log2 units summed over m, n and k.
+    static constexpr double DEFAULT_MAX_DISTANCE = 3.0;
+
+    // Index of the smallest power of two not less than x, 0 for x <= 1.
+    static uint32_t Bucket(uint32_t x)
+    {
+        uint32_t bucket = 0;
+        while (bucket < 32 && (static_cast<uint64_t>(1) << bucket) < x) {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    // Fill kernel, tile shapes and swizzle of the record from its description.
+    static bool ParseDescription(TuningRecord &record)
+    {
+        std::vector<std::string> segments;
+        std::stringstream ss(record.description);
+        for (std::string segment; std::getline(ss, segment, '_');) {
+            segments.emplace_back(segment);
+        }
+        // catlass, op, kernel (at least one segment), A, B, C, l1, l0, swizzle
+        constexpr size_t MIN_SEGMENTS = 9;
+        constexpr size_t TAIL_SEGMENTS = 6;
+        if (segments.size() < MIN_SEGMENTS || segments[0] != "catlass") {
+            return false;
+        }
+        const std::string &swizzle = segments[segments.size() - 1];
+        const std::string prefix = "swizzle";
+        if (swizzle.compare(0, prefix.size(), prefix) != 0 ||
+            !ParseShape(segments[segments.size() - 3], record.l1TileShape) ||
+            !ParseShape(segments[segments.size() - 2], record.l0TileShape)) {
+            return false;
+        }
+        std::array<uint32_t, 2> swizzleParams{};
+        if (!ParseShape(swizzle.substr(prefix.size()), swizzleParams)) {
+            return false;
+        }
+        record.swizzleOffset = swizzleParams[0];
+        record.swizzleDirection = swizzleParams[1];
+        record.kernel.clear();
+        for (size_t i = 2; i < segments.size() - TAIL_SEGMENTS; ++i) {
+            record.kernel.append(i == 2 ? "" : "_").append(segments[i]);
+        }
+        return true;
+    }
+
+    // Keep the record if its bucket is empty or it is faster than the stored one.
+    bool Update(const TuningRecord &record)
+    {
+        if (record.taskDuration <= 0 || record.kernel.empty()) {
+            return false;
+        }
+        auto &buckets = records_[FamilyKey(record.kernel, record.A, record.B, record.C, record.device)];
+        auto [it, inserted] = buckets.emplace(BucketKey(record.m, record.n, record.k), record);
+        if (!inserted && record.taskDuration < it->second.taskDuration) {
+            it->second = record;
+            return true;
+        }
+        return inserted;
+    }
+
+    // Record of the bucket of (m, n, k), else the record nearest to (m, n, k) in log2 space.
+    const TuningRecord *Lookup(const std::string &kernel, const std::string &a, const std::string &b,
+        const std::string &c, const std::string &device, uint32_t m, uint32_t n, uint32_t k,
+        double maxDistance = DEFAULT_MAX_DISTANCE) const
+    {
+        auto family = records_.find(FamilyKey(kernel, a, b, c, device));
+        if (family == records_.end() || m == 0 || n == 0 || k == 0) {
+            return nullptr;
+        }
+        if (auto it = family->second.find(BucketKey(m, n, k)); it != family->second.end()) {
+            return &it->second;
+        }
+        const TuningRecord *nearest = nullptr;
+        double nearestDistance = maxDistance;
+        for (auto &bucket : family->second) {
+            const TuningRecord &record = bucket.second;
+            double distance = std::fabs(std::log2(static_cast<double>(record.m) / m)) +
+                              std::fabs(std::log2(static_cast<double>(record.n) / n)) +
+                              std::fabs(std::log2(static_cast<double>(record.k) / k));
+            if (distance <= nearestDistance) {
+                nearest = &record;
+                nearestDistance = distance;
+            }
+        }
+        return nearest;
+    }
+
+    bool Read(std::istream &is)
+    {
+        std::string line;
+        if (!std::getline(is, line)) {
+            error_ = "empty tuning database";
+            return false;
+        }
+        StripCarriageReturn(line);
+        std::string magic{MAGIC};
+        if (line.compare(0, magic.size(), magic) != 0) {
+            error_ = "not a tuning database";
+            return false;
+        } else if (line.substr(magic.size()) != std::to_string(VERSION)) {
+            error_ = "unsupported tuning database version " + line.substr(magic.size()) +
+                     ", expect " + std::to_string(VERSION);
+            return false;
+        }
+        size_t lineNo = 1;
+        while (std::getline(is, line)) {
+            ++lineNo;
+            StripCarriageReturn(line);
+            if (line.empty() || line[0] == '#' || line == HEAD) {
+                continue;
+            }
+            TuningRecord record;
+            if (!ParseLine(line, record)) {
+                error_ = "invalid record at line " + std::to_string(lineNo);
+                return false;
+            }
+            Update(record);
+        }
+        return true;
+    }
+
+    void Write(std::ostream &os) const
+    {
+        os << MAGIC << VERSION << "\n" << HEAD << "\n";
+        for (auto &family : records_) {
+            for (auto &bucket : family.second) {
+                const TuningRecord &r = bucket.second;
+                os << r.kernel << "," << r.A << "," << r.B << "," << r.C << "," << r.device << ","
+                   << bucket.first[0] << "," << bucket.first[1] << "," << bucket.first[2] << ","
+                   << r.m << "," << r.n << "," << r.k << "," << FormatDuration(r.taskDuration) << ","
+                   << r.description << "\n";
+            }
+        }
+    }
+
+    bool Load(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            error_ = "open " + path + " failed";
+            return false;
+        }
+        return Read(file);
+    }
+
+    size_t Size() const
+    {
+        size_t size = 0;
+        for (auto &family : records_) {
+            size += family.second.size();
+        }
+        return size;
+    }
+
+    const std::string &Error() const { return error_; }
+
+private:
+    using BucketKeyType = std::array<uint32_t, 3>;
+
+    static std::string FamilyKey(const std::string &kernel, const std::string &a, const std::string &b,
+        const std::string &c, const std::string &device)
+    {
+        return kernel + "," + a + "," + b + "," + c + "," + device;
+    }
+
+    static BucketKeyType BucketKey(uint32_t m, uint32_t n, uint32_t k)
+    {
+        return {Bucket(m), Bucket(n), Bucket(k)};
+    }
+
+    template <size_t N>
+    static bool ParseShape(const std::string &str, std::array<uint32_t, N> &shape)
+    {
+        std::stringstream ss(str);
+        std::string val;
+        for (size_t i = 0; i < N; ++i) {
+            if (!std::getline(ss, val, 'x') || !ParseUint(val, shape[i])) {
+                return false;
+            }
+        }
+        return !std::getline(ss, val, 'x');
+    }
+
+    static bool ParseUint(const std::string &str, uint32_t &val)
+    {
+        if (str.empty() || str.size() > 10 || str.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        uint64_t v = std::stoull(str);
+        if (v > UINT32_MAX) {
+            return false;
+        }
+        val = static_cast<uint32_t>(v);
+        return true;
+    }
+
+    static bool ParseLine(const std::string &line, TuningRecord &record)
+    {
+        std::vector<std::string> columns;
+        std::stringstream ss(line);
+        for (std::string column; std::getline(ss, column, ',');) {
+            columns.emplace_back(column);
+        }
+        constexpr size_t COLUMNS = 13;
+        if (columns.size() != COLUMNS) {
+            return false;
+        }
+        record.kernel = columns[0];
+        record.A = columns[1];
+        record.B = columns[2];
+        record.C = columns[3];
+        record.device = columns[4];
+        // columns 5 to 7 are the buckets, recomputed from m, n and k
+        if (!ParseUint(columns[8], record.m) || !ParseUint(columns[9], record.n) ||
+            !ParseUint(columns[10], record.k)) {
+            return false;
+        }
+        char *end = nullptr;
+        record.taskDuration = std::strtod(columns[11].c_str(), &end);
+        if (end == columns[11].c_str() || *end != '\0') {
+            return false;
+        }
+        record.description = columns[12];
+        std::string kernel = record.kernel;
+        return ParseDescription(record) && record.kernel == kernel;
+    }
+
+    static std::string FormatDuration(double duration)
+    {
+        std::stringstream ss;
+        constexpr int PREC = 3;
+        ss.setf(std::ios::fixed);
+        ss.precision(PREC);
+        ss << duration;
+        return ss.str();
+    }
+
+    static void StripCarriageReturn(std::string &line)
+    {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+    }
+
+    std::map<std::string, std::map<BucketKeyType, TuningRecord>> records_;
+    std::string error_;
+};
+
+} // namespace Library
+} // namespace Catlass
+
+#endif // CATLASS_LIBRARY_TUNING_DB_H
@@ -10,6 +10,7 @@
 # See LICENSE in the root of the software repository for the full text of the License.
 # ----------------------------------------------------------------------------
 
+import os
 import sys
 import logging
 import argparse
@@ -39,6 +40,24 @@ def main():
         default='AtlasA2',
         help="Target ascend hardware architectures",
     )
+    parser.add_argument(
+        '--compile-units',
+        type=int,
+        default=64,
+        help="Maximum number of compilation units operations of one type are sharded into",
+    )
+    parser.add_argument(
+        '--jobs',
+        type=int,
+        default=0,
+        help="Number of processes generating the compilation units, 0 for the number of cpus",
+    )
+    parser.add_argument(
+        '--search-candidates',
+        type=str,
+        default='',
+        help="Only generate the tile search candidates listed in this json file",
+    )
 
     logging.basicConfig(level=logging.INFO)
     args = parser.parse_args()
@@ -46,8 +65,18 @@ def main():
     LOGGER.debug(f'args.kernels={args.kernels}')
     LOGGER.debug(f'args.workspace_dir={args.workspace_dir}')
     LOGGER.debug(f'args.arch={args.arch}')
+    LOGGER.debug(f'args.search_candidates={args.search_candidates}')
+
+    if args.compile_units <= 0:
+        LOGGER.error('--compile-units must be a positive integer')
+        return 1
+    if args.jobs <= 0:
+        args.jobs = os.cpu_count() or 1
 
-    manifest = Manifest(args)
+    register_functions = None
+    if args.search_candidates:
+        register_functions = search_space.search_candidate_register_functions(args.search_candidates)
+    manifest = Manifest(args, register_functions)
     manifest.generate_code()
 
     return 0
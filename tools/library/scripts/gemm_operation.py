@@ -12,8 +12,10 @@
 
 import os
 import re
+from concurrent.futures import ProcessPoolExecutor
+
 import library
-from utils import KernelGroupFile
+from utils import KernelGroupFile, shard_by_name
 
 
 class GemmOperation:
@@ -85,6 +87,12 @@ void Register_{kernel_name}(Manifest &manifest)
             block_swizzle=self.get_block_swizzle_name()
         )
 
+    def get_sub_kind(self):
+        # C++ enum of the kind, operations are registered lazily per kind
+        if self.kernel_type in self.kernel_instance_generators:
+            return self.kernel_instance_generators[self.kernel_type].gemm_kind
+        raise Exception(f'no kernel instance registered for {self.kernel_type}')
+
     def get_block_swizzle_name(self):
         match = re.search(r'<(\d+)\s*,\s*(\d+)\s*>', self.block_swizzle)
         if not match:
@@ -109,16 +117,27 @@ void Register_{kernel_name}(Manifest &manifest)
         return instance_geneorator.custom_headers, instance_geneorator.custom_common_decls, body_src
 
 
+def render_kernel_group(file_name, headers, operations):
+    # runs in the worker processes of GemmOperationGenerator
+    file = KernelGroupFile(file_name)
+    file.add_headers(headers)
+    for operation in operations:
+        file.add_instance(*operation.generate_src())
+    return file_name, file.render()
+
+
 class GemmOperationGenerator:
-    def __init__(self, operation_type, generated_dir):
+    def __init__(self, operation_type, generated_dir, writer, unit_num=64, jobs=1):
         self.generated_dir = generated_dir
         self.operation_type = operation_type
+        self.writer = writer
         self.kernel_names = []
-        self.kernel_instances = []
+        self.operations = {}
 
         # critical: avoid creating too many files that bisheng-compiler cannot not handle
-        self.kernel_group_files = []
-        self.curr_file_id = 0
+        self.unit_num = unit_num
+        self.jobs = jobs
+        self.generated_unit_num = 0
 
         self.function_decl_template = """void Register_{kernel_name}(Manifest &manifest);\n"""
         self.function_call_template = """    Register_{kernel_name}(manifest);\n"""
@@ -161,33 +180,35 @@ void RegisterCatlass{operation_type}Operations(Manifest &manifest)
         return self
 
     def __exit__(self, exception_type, exception_value, traceback):
-        for file in self.kernel_group_files:
-            save_dir = os.path.join(self.generated_dir, self.operation_type)
-            file.write_in_dir(save_dir)
+        if exception_type is not None:
+            return
+        # operations keep their compilation unit when others are added or removed,
+        # so only the units that really changed are rewritten and recompiled
+        shards = shard_by_name(list(self.operations.keys()), self.unit_num)
+        groups = {}
+        for name in sorted(self.operations):
+            groups.setdefault(shards[name], []).append(self.operations[name])
+        tasks = [
+            (f'catlass_{self.operation_type}_kernel_group_{shard}.cpp', self.gemm_headers, operations)
+            for shard, operations in sorted(groups.items())
+        ]
+        if self.jobs > 1 and len(tasks) > 1:
+            with ProcessPoolExecutor(max_workers=min(self.jobs, len(tasks))) as executor:
+                results = list(executor.map(render_kernel_group, *zip(*tasks)))
+        else:
+            results = [render_kernel_group(*task) for task in tasks]
+        for file_name, content in results:
+            self.writer.write(os.path.join(self.operation_type, file_name), content)
+        self.generated_unit_num = len(results)
 
     def gen(self, name, operation):
-        kernel_name = name
-        self.kernel_names.append(kernel_name)
-
-        headers, decls, body = operation.generate_src()
-        file = self.get_next_kernel_group_file()
-        file.add_instance(headers, decls, body)
-
-    def get_next_kernel_group_file(self):
-        GROUP_FILE_NUM = 64
-        if len(self.kernel_group_files) < GROUP_FILE_NUM:
-            file = KernelGroupFile(f'catlass_{self.operation_type}_kernel_group_{self.curr_file_id}.cpp')
-            file.add_headers(self.gemm_headers)
-            self.kernel_group_files.append(file)
-            self.curr_file_id = (self.curr_file_id + 1) % GROUP_FILE_NUM
-            return self.kernel_group_files[-1]
-
-        file = self.kernel_group_files[self.curr_file_id]
-        self.curr_file_id = (self.curr_file_id + 1) % GROUP_FILE_NUM
-        return file
+        self.kernel_names.append(name)
+        self.operations[name] = operation
 
 
 class BasicMatmulKernelInstance:
+    gemm_kind = 'GemmKind::BasicMatmul'
+
     def __init__(self):
         self.cpp_instance = 'BasicMatmulGemmOperation'
         self.custom_headers = '#include "catlass/gemm/kernel/basic_matmul.hpp"'
@@ -229,6 +250,8 @@ class BasicMatmulKernelInstance:
 
 
 class GroupedMatmulKernelInstance:
+    gemm_kind = 'GemmKind::GroupedMatmul'
+
     def __init__(self):
         self.cpp_instance = 'GroupedMatmulGemmOperation'
         self.custom_headers = '#include "catlass/gemm/kernel/grouped_matmul.hpp"'
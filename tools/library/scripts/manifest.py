@@ -11,9 +11,10 @@
 # ----------------------------------------------------------------------------
 
 import os
-import shutil
+import time
 import logging
 import gemm_operation
+from utils import GeneratedFileWriter
 
 LOGGER = logging.getLogger(__name__)
 
@@ -39,7 +40,7 @@ class OperationRegistry:
 
 class Manifest:
 
-    def __init__(self, args):
+    def __init__(self, args, register_functions=None):
         self.args = args
         self.operations = []
         self.operations_dict = {}
@@ -49,16 +50,24 @@ class Manifest:
         self.target_generator = {
             'gemm': gemm_operation.GemmOperationGenerator
         }
-        for _, func in OperationRegistry.register_functions_high_priority.items():
-            func(self)
-        for name, func in OperationRegistry.register_functions.items():
-            if name in OperationRegistry.register_functions_high_priority:
-                LOGGER.info(
-                    f'skip seach space registration of {name} in search_space.py'
-                    f' due to a duplicate registration in seach_sapce_config.py'
-                )
-            else:
+        self.operation_kinds = {
+            'gemm': 'OperationKind::Gemm'
+        }
+        if register_functions is not None:
+            # e.g. candidates of one tile search round, the registry is bypassed
+            for _, func in register_functions.items():
+                func(self)
+        else:
+            for _, func in OperationRegistry.register_functions_high_priority.items():
                 func(self)
+            for name, func in OperationRegistry.register_functions.items():
+                if name in OperationRegistry.register_functions_high_priority:
+                    LOGGER.info(
+                        f'skip seach space registration of {name} in search_space.py'
+                        f' due to a duplicate registration in seach_sapce_config.py'
+                    )
+                else:
+                    func(self)
         LOGGER.info(f'operations that will be generated in total: {len(self.operations)}')
 
         if len(self.operations) > 10000:
@@ -75,9 +84,13 @@ namespace Library {{
 
 {api_decl_src}
 
-void RegisterAllKernels(Manifest &manifest)
+void RegisterKernels(Manifest &manifest, OperationKind kind, uint32_t subKind)
 {{
-    {api_call_src}
+    switch (kind) {{
+{api_call_src}
+        default:
+            break;
+    }}
 }}
 
 }}
@@ -85,7 +98,8 @@ void RegisterAllKernels(Manifest &manifest)
 """
 
         self.function_decl_template = """void Register_{kernel_name}(Manifest &manifest);\n"""
-        self.function_call_template = """    Register_{kernel_name}(manifest);\n"""
+        self.function_call_template = """            Register_{kernel_name}(manifest);\n"""
+        self.sub_kind_case_template = """        case static_cast<uint32_t>({sub_kind}):\n{function_calls}            break;\n"""
 
         self.register_template = """
 #include "catlass/library/operation.h"
@@ -96,9 +110,13 @@ namespace Library {{
 
 {function_decls}
 
-void RegisterCatlass{operation_type}Operations(Manifest &manifest)
+void RegisterCatlass{operation_type}Operations(Manifest &manifest, uint32_t subKind)
 {{
+    switch (subKind) {{
 {function_calls}
+        default:
+            break;
+    }}
 }}
 
 }}
@@ -126,80 +144,72 @@ void RegisterCatlass{operation_type}Operations(Manifest &manifest)
         return True
 
     def generate_code(self):
+        start_time = time.perf_counter()
         workspace_dir = self.args.workspace_dir
         generated_dir = os.path.join(workspace_dir, 'generated')
+        unit_num = getattr(self.args, 'compile_units', 64)
+        jobs = getattr(self.args, 'jobs', 1)
 
         LOGGER.debug(f'generated_dir={generated_dir}')
 
-        if os.path.exists(generated_dir) and not os.path.islink(generated_dir):
-            shutil.rmtree(generated_dir)
-        elif os.path.islink(generated_dir):
+        # the directory is kept between runs, unchanged files are not rewritten to avoid recompilation
+        if os.path.islink(generated_dir):
             raise PermissionError(
-                f'generated directory {generated_dir} is a soft link, which is not allowed to be removed.'
+                f'generated directory {generated_dir} is a soft link, which is not allowed to be used.'
             )
-        else:
-            pass
+        os.makedirs(generated_dir, exist_ok=True)
+        writer = GeneratedFileWriter(generated_dir)
 
-        os.mkdir(generated_dir)
         api_decl_src = []
         api_call_src = []
+        generated_unit_num = 0
         for operation_type, names in self.operations_dict.items():
-            api_decl_src.append('void RegisterCatlass{}Operations(Manifest &manifest);'.format(operation_type))
-            api_call_src.append('  RegisterCatlass{}Operations(manifest);'.format(operation_type))
-
-            # save kernel names of this operation type in here
-            kernel_names = []
-
-            # create subfolder for each type of operations
-            operation_subdir = os.path.join(generated_dir, operation_type)
-            if not os.path.exists(operation_subdir):
-                os.mkdir(operation_subdir) # e.g. create generated/gemm
-
-            with self.target_generator[operation_type](operation_type, generated_dir) as generator:
+            api_decl_src.append(
+                'void RegisterCatlass{}Operations(Manifest &manifest, uint32_t subKind);'.format(operation_type))
+            api_call_src.append(
+                '        case {}:\n            RegisterCatlass{}Operations(manifest, subKind);\n            break;'.format(
+                    self.operation_kinds[operation_type], operation_type))
+
+            # save kernel names of each sub kind of this operation type in here
+            kernel_names = {}
+
+            with self.target_generator[operation_type](
+                operation_type, generated_dir, writer, unit_num, jobs
+            ) as generator:
                 for name, operation in names.items():
                     LOGGER.info(f'generating kernel: {name}')
-                    kernel_names.append(name)
+                    kernel_names.setdefault(operation.get_sub_kind(), []).append(name)
                     generator.gen(name, operation) # generate kernel instance
+            generated_unit_num += generator.generated_unit_num
 
             function_calls = ''
             function_decls = ''
-            for kernel_name in kernel_names:
-                function_calls += self.function_call_template.format(kernel_name=kernel_name)
-                function_decls += self.function_decl_template.format(kernel_name=kernel_name)
+            for sub_kind, sub_kind_kernel_names in kernel_names.items():
+                sub_kind_calls = ''
+                for kernel_name in sub_kind_kernel_names:
+                    sub_kind_calls += self.function_call_template.format(kernel_name=kernel_name)
+                    function_decls += self.function_decl_template.format(kernel_name=kernel_name)
+                function_calls += self.sub_kind_case_template.format(
+                    sub_kind=sub_kind, function_calls=sub_kind_calls)
             operation_register_src = self.register_template.format(
                 operation_type=operation_type,
                 function_calls=function_calls,
                 function_decls=function_decls
             )
             # e.g. create generated/gemm/register_all_gemm_operations.cpp
-            self._write_to_register_file(
-                os.path.join(operation_subdir, 
-                    f'register_all_{operation_type}_operations.cpp'),
+            writer.write(
+                os.path.join(operation_type, f'register_all_{operation_type}_operations.cpp'),
                 operation_register_src)
 
         register_all_kernels_src = self.register_all_operations_template.format(
             api_decl_src='\n'.join(api_decl_src), api_call_src='\n'.join(api_call_src)
         )
 
-        self._write_to_register_file(
-            os.path.join(generated_dir, 'register_all_kernels_generated.cpp'), 
-            register_all_kernels_src)
-
-    @staticmethod
-    def _write_to_register_file(reg_filename, content):
-        try: 
-            os.remove(reg_filename) # remove previous auto-gen
-        except FileNotFoundError: 
-            pass
-
-        fd = None
-        try:
-            fd = os.open(reg_filename, 
-                        os.O_CREAT | os.O_WRONLY | os.O_TRUNC, 
-                        0o550)
-            with os.fdopen(fd, "w") as f:
-                f.write(content)
-                fd = None
-        finally:
-            if fd is not None:
-                os.close(fd)
\ No newline at end of file
+        writer.write('register_all_kernels_generated.cpp', register_all_kernels_src)
+        writer.finalize()
+
+        LOGGER.info(
+            f'code generation finished in {time.perf_counter() - start_time:.2f}s with {jobs} jobs: '
+            f'{len(self.operations)} operations in {generated_unit_num} compilation units, '
+            f'files written={writer.written}, unchanged={writer.unchanged}, removed={writer.removed}'
+        )
@@ -10,7 +10,14 @@
 # See LICENSE in the root of the software repository for the full text of the License.
 # ----------------------------------------------------------------------------
 
+import os
+import csv
+import json
+import math
+import random
 import logging
+import tempfile
+import subprocess
 from itertools import product
 from dataclasses import dataclass
 
@@ -37,7 +44,10 @@ class SearchSpaceConfiguration:
     l1_tile_n_range: tuple
     l1_tile_k_range: tuple
 
-    block_swizzle: str # e.g. 'Gemm::Block::GemmIdentityBlockSwizzle<3, 0>'
+    block_swizzle: str # e.g. 'Gemm::Block::GemmIdentityBlockSwizzle<3, 0>', or a list of them
+
+    def get_block_swizzles(self):
+        return [self.block_swizzle] if isinstance(self.block_swizzle, str) else list(self.block_swizzle)
 
 
 def generate_tile_shape_default(
@@ -77,7 +87,7 @@ def register_custom_kernel(
 
     LOGGER.info(f'{config.kernel_type} tile_shapes size={len(tile_shapes)}')
 
-    for tile_shape in tile_shapes:
+    for tile_shape, block_swizzle in product(tile_shapes, config.get_block_swizzles()):
         l1_tile_shape, l0_tile_shape = tile_shape
         tensor_a = library.GemmTypeDescription(config.data_type_a, config.layout_a)
         tensor_b = library.GemmTypeDescription(config.data_type_b, config.layout_b)
@@ -89,7 +99,7 @@ def register_custom_kernel(
             a_type=tensor_a,
             b_type=tensor_b,
             c_type=tensor_c,
-            block_swizzle=config.block_swizzle,
+            block_swizzle=block_swizzle,
         )
         manifest.append(op)
 
@@ -235,6 +245,355 @@ def generate_tile_shapes(
 ############### search space generation methods end ###############
 
 
+############### search-driven generation ###############
+@dataclass(frozen=True)
+class TileCandidate:
+    l1_tile_shape: tuple
+    l0_tile_shape: tuple
+    block_swizzle: str
+
+    def get_tile_name(self):
+        return library.TileDescription(self.l1_tile_shape, self.l0_tile_shape).get_name()
+
+
+class TileShapeSearch:
+    """
+    Iterative search over a tile shape space, only the proposed candidates need to be instantiated.
+
+    strategy='evolution': offspring of the best candidates (mutation to a nearby shape and crossover)
+    strategy='surrogate': many offspring are scored by an inverse distance weighted k-nearest-neighbour
+        model of the observed costs, the ones with the lowest predicted cost minus an exploration bonus
+        for unexplored regions are proposed
+    Costs are task durations, lower is better, float('inf') marks a failed candidate.
+    """
+
+    def __init__(
+        self,
+        candidates: list,
+        strategy: str = 'surrogate',
+        population_size: int = 16,
+        batch_size: int = 8,
+        step: int = 16,
+        seed: int = 0,
+    ):
+        if strategy not in ('evolution', 'surrogate'):
+            raise ValueError(f'unknown search strategy {strategy}')
+        if not candidates:
+            raise ValueError('search space is empty')
+        self.candidates = list(candidates)
+        self.strategy = strategy
+        self.population_size = population_size
+        self.batch_size = batch_size
+        self.step = step
+        self.random = random.Random(seed)
+        self.swizzles = sorted({candidate.block_swizzle for candidate in self.candidates})
+        self.features = {candidate: self._to_features(candidate) for candidate in self.candidates}
+        self.observed = {}
+        self.history = []
+        # (parent, radius) -> candidates within radius, parents are revisited every round
+        self.neighbors = {}
+        # crossover target -> closest valid candidate
+        self.snapped = {}
+
+    def _to_features(self, candidate):
+        # tile dims in units of the search step, the swizzle is a categorical dimension
+        dims = tuple(val / self.step for val in candidate.l1_tile_shape + candidate.l0_tile_shape)
+        return dims + (self.swizzles.index(candidate.block_swizzle),)
+
+    @staticmethod
+    def _distance(lhs, rhs):
+        distance = 0 if lhs[-1] == rhs[-1] else 1
+        for idx in range(len(lhs) - 1):
+            distance += abs(lhs[idx] - rhs[idx])
+        return distance
+
+    def _untried(self, candidates):
+        return [candidate for candidate in candidates if candidate not in self.observed]
+
+    def initial_population(self):
+        # farthest point sampling spreads the first generation over the whole space
+        pool = self._untried(self.candidates)
+        if not pool:
+            return []
+        population = [self.random.choice(pool)]
+        nearest = {candidate: self._distance(self.features[candidate], self.features[population[0]])
+                   for candidate in pool}
+        while len(population) < min(self.population_size, len(pool)):
+            farthest = max(pool, key=lambda candidate: nearest[candidate])
+            population.append(farthest)
+            for candidate in pool:
+                nearest[candidate] = min(
+                    nearest[candidate], self._distance(self.features[candidate], self.features[farthest]))
+        return population
+
+    def observe(self, candidate, cost):
+        if candidate not in self.observed:
+            self.history.append(candidate)
+        self.observed[candidate] = cost
+
+    def best(self):
+        finished = [(cost, candidate) for candidate, cost in self.observed.items() if math.isfinite(cost)]
+        if not finished:
+            return None, float('inf')
+        cost, candidate = min(finished, key=lambda item: item[0])
+        return candidate, cost
+
+    def _parents(self):
+        ranked = sorted(
+            (candidate for candidate, cost in self.observed.items() if math.isfinite(cost)),
+            key=lambda candidate: self.observed[candidate]
+        )
+        return ranked[:self.population_size]
+
+    def _mutate(self, parent, radius):
+        key = (parent, radius)
+        if key not in self.neighbors:
+            origin = self.features[parent]
+            self.neighbors[key] = [candidate for candidate in self.candidates
+                if candidate != parent and self._distance(self.features[candidate], origin) <= radius]
+        nearby = self.neighbors[key]
+        return self.random.choice(nearby) if nearby else None
+
+    def _crossover(self, lhs, rhs):
+        # take each dimension from either parent, then snap to the closest valid shape
+        target = tuple(self.random.choice(pair) for pair in zip(self.features[lhs], self.features[rhs]))
+        if target not in self.snapped:
+            self.snapped[target] = min(
+                self.candidates, key=lambda candidate: self._distance(self.features[candidate], target))
+        return self.snapped[target]
+
+    def _offspring(self, count):
+        parents = self._parents()
+        if not parents:
+            return self._untried(self.initial_population())
+        children = []
+        attempts = 0
+        while len(children) < count and attempts < count * 8:
+            attempts += 1
+            # rank based selection, the best candidates have more offspring
+            parent = parents[min(int(self.random.expovariate(3.0 / len(parents))), len(parents) - 1)]
+            if len(parents) > 1 and self.random.random() < 0.3:
+                child = self._crossover(parent, self.random.choice(parents))
+            else:
+                child = self._mutate(parent, self.random.choice((1, 2, 4)))
+            if child is not None and child not in self.observed and child not in children:
+                children.append(child)
+        return children
+
+    def predict(self, candidate, neighbors=4):
+        """Return (predicted cost, distance to the nearest observed candidate)."""
+        origin = self.features[candidate]
+        known = sorted(
+            (self._distance(self.features[other], origin), cost)
+            for other, cost in self.observed.items() if math.isfinite(cost)
+        )[:neighbors]
+        if not known:
+            return float('inf'), float('inf')
+        if known[0][0] == 0:
+            return known[0][1], 0.0
+        weights = [1.0 / (distance * distance) for distance, _ in known]
+        predicted = sum(weight * cost for weight, (_, cost) in zip(weights, known)) / sum(weights)
+        return predicted, known[0][0]
+
+    def propose(self):
+        if not self.observed:
+            return self.initial_population()
+        if self.strategy == 'evolution':
+            return self._offspring(self.batch_size)
+        pool = self._offspring(self.batch_size * 8)
+        _, best_cost = self.best()
+        scale = best_cost if math.isfinite(best_cost) else 1.0
+
+        def acquisition(candidate):
+            predicted, distance = self.predict(candidate)
+            # lower is better, far away candidates get a bonus proportional to the best cost
+            return predicted - 0.02 * scale * min(distance, 8.0)
+
+        pool.sort(key=acquisition)
+        return pool[:self.batch_size]
+
+
+def run_tile_search(search: TileShapeSearch, evaluate: callable, max_rounds: int = 20, patience: int = 4):
+    """
+    Propose, evaluate and observe until max_rounds or until the best cost has not improved for
+    patience rounds. evaluate(list of TileCandidate) returns {TileCandidate: cost}, missing
+    candidates are treated as failed.
+    """
+    stale_rounds = 0
+    best_cost = float('inf')
+    for round_idx in range(max_rounds):
+        batch = search.propose()
+        if not batch:
+            break
+        costs = evaluate(batch)
+        for candidate in batch:
+            search.observe(candidate, costs.get(candidate, float('inf')))
+        _, cost = search.best()
+        LOGGER.info(f'search round {round_idx}: evaluated {len(search.observed)}, best cost {cost}')
+        if cost < best_cost * 0.999:
+            best_cost = cost
+            stale_rounds = 0
+        else:
+            stale_rounds += 1
+            if stale_rounds >= patience:
+                break
+    return search.best()
+
+
+def generate_search_candidates(config: SearchSpaceConfiguration):
+    return [
+        TileCandidate(tuple(l1_tile_shape), tuple(l0_tile_shape), block_swizzle)
+        for (l1_tile_shape, l0_tile_shape), block_swizzle in product(
+            generate_tile_shape_default(config.l1_tile_m_range, config.l1_tile_n_range, config.l1_tile_k_range),
+            config.get_block_swizzles()
+        )
+    ]
+
+
+class SwizzleSimulator:
+    """
+    Predicted cost of the block swizzles of one L1 tile shape, by the host simulator of
+    tools/swizzle_simulator, which replays the swizzle for every core through an L2 model.
+    The cost is the predicted HBM traffic scaled by the per-core load imbalance, lower is better.
+    """
+
+    LAYOUT_NAMES = {library.LayoutType.RowMajor: 'row', library.LayoutType.ColumnMajor: 'column'}
+
+    def __init__(self, simulator: str, m: int, n: int, k: int, config: SearchSpaceConfiguration,
+                 extra_args: list = None):
+        self.simulator = simulator
+        self.shape_args = [f'--m={m}', f'--n={n}', f'--k={k}']
+        self.tensor_args = [
+            f'--A={config.data_type_a.get_name()}:{self.LAYOUT_NAMES.get(config.layout_a, "row")}',
+            f'--B={config.data_type_b.get_name()}:{self.LAYOUT_NAMES.get(config.layout_b, "row")}',
+        ]
+        self.extra_args = list(extra_args or [])
+
+    def __call__(self, l1_tile_shape: tuple, block_swizzles: list):
+        # only simulate the offsets of the given swizzles, e.g. 3 of 'Gemm::Block::GemmIdentityBlockSwizzle<3, 0>'
+        offsets = sorted({
+            swizzle.split('<')[1].split(',')[0].strip() for swizzle in block_swizzles if '<' in swizzle
+        })
+        fd, output = tempfile.mkstemp(suffix='.csv')
+        os.close(fd)
+        try:
+            cmd = [self.simulator, f'--l1_tile={"x".join(str(val) for val in l1_tile_shape)}',
+                   f'--output={output}'] + self.shape_args + self.tensor_args + self.extra_args
+            if offsets:
+                cmd.append(f'--swizzle_offsets={",".join(offsets)}')
+            result = subprocess.run(cmd, capture_output=True, text=True)
+            if result.returncode != 0:
+                LOGGER.warning(f'swizzle simulation of {l1_tile_shape} failed: {result.stdout}{result.stderr}')
+                return {}
+            with open(output, newline='') as f:
+                return {
+                    normalize_block_swizzle(row['block_swizzle']):
+                        float(row['hbm_bytes']) * float(row['load_imbalance'])
+                    for row in csv.DictReader(f)
+                }
+        finally:
+            os.remove(output)
+
+
+def normalize_block_swizzle(block_swizzle: str):
+    return block_swizzle.replace(' ', '')
+
+
+def prune_block_swizzles(candidates: list, simulate: callable, keep: int = 2, tolerance: float = 1.1):
+    """
+    Keep at most keep block swizzles per tile shape, those predicted within tolerance of the best one,
+    so only they are compiled. simulate(l1_tile_shape, block_swizzles) returns {normalized block swizzle: cost},
+    candidates it has no prediction for are kept.
+    """
+    groups = {}
+    for candidate in candidates:
+        groups.setdefault((candidate.l1_tile_shape, candidate.l0_tile_shape), []).append(candidate)
+    predictions = {}
+    pruned = []
+    for (l1_tile_shape, _), group in groups.items():
+        if len(group) <= keep:
+            pruned.extend(group)
+            continue
+        # the swizzle order only depends on the L1 tile shape, candidates differing in L0 share a simulation
+        if l1_tile_shape not in predictions:
+            predictions[l1_tile_shape] = simulate(l1_tile_shape, sorted({c.block_swizzle for c in group}))
+        costs = predictions[l1_tile_shape]
+        known = sorted(
+            (candidate for candidate in group if normalize_block_swizzle(candidate.block_swizzle) in costs),
+            key=lambda candidate: costs[normalize_block_swizzle(candidate.block_swizzle)]
+        )
+        if known:
+            best_cost = costs[normalize_block_swizzle(known[0].block_swizzle)]
+            pruned.extend(
+                candidate for candidate in known[:keep]
+                if costs[normalize_block_swizzle(candidate.block_swizzle)] <= best_cost * tolerance
+            )
+        pruned.extend(candidate for candidate in group if normalize_block_swizzle(candidate.block_swizzle) not in costs)
+    LOGGER.info(f'swizzle pruning kept {len(pruned)} of {len(candidates)} candidates')
+    return pruned
+
+
+def synthetic_matmul_cost(m: int, n: int, k: int, core_num: int = 24):
+    """
+    Roofline like cost of a tile shape for offline testing of the search loop: per core rounds of
+    L1 tiles, each bounded by cube throughput or GM bandwidth, plus per K step and L0 step overheads.
+    """
+    def cost(candidate):
+        l1_m, l1_n, l1_k = candidate.l1_tile_shape
+        _, _, l0_k = candidate.l0_tile_shape
+        rounds = math.ceil(math.ceil(m / l1_m) * math.ceil(n / l1_n) / core_num)
+        compute = l1_m * l1_n * k / 4096.0
+        memory = (l1_m + l1_n) * k * 2 / 64.0
+        overhead = math.ceil(k / l1_k) * 40.0 + math.ceil(k / l0_k) * 6.0
+        return rounds * (max(compute, memory) + overhead) / 1000.0
+    return cost
+
+
+def save_search_candidates(path: str, config: SearchSpaceConfiguration, candidates: list):
+    content = {
+        'kernel_type': config.kernel_type,
+        'data_types': [dtype.get_name() for dtype in (config.data_type_a, config.data_type_b, config.data_type_c)],
+        'layouts': [layout.get_name() for layout in (config.layout_a, config.layout_b, config.layout_c)],
+        'candidates': [
+            {
+                'l1_tile_shape': list(candidate.l1_tile_shape),
+                'l0_tile_shape': list(candidate.l0_tile_shape),
+                'block_swizzle': candidate.block_swizzle,
+            }
+            for candidate in candidates
+        ],
+    }
+    with open(path, 'w') as f:
+        json.dump(content, f, indent=2)
+
+
+def search_candidate_register_functions(path: str):
+    """
+    Registration functions that instantiate only the candidates of a file written by
+    save_search_candidates, used instead of the registry when a search round is compiled.
+    """
+    with open(path) as f:
+        content = json.load(f)
+    data_types = [library.DataType[name] for name in content['data_types']]
+    layouts = [library.LayoutType[name] for name in content['layouts']]
+
+    def register(manifest):
+        for item in content['candidates']:
+            op = GemmOperation(
+                kernel_type=content['kernel_type'],
+                l1_tile_shape=tuple(item['l1_tile_shape']),
+                l0_tile_shape=tuple(item['l0_tile_shape']),
+                a_type=library.GemmTypeDescription(data_types[0], layouts[0]),
+                b_type=library.GemmTypeDescription(data_types[1], layouts[1]),
+                c_type=library.GemmTypeDescription(data_types[2], layouts[2]),
+                block_swizzle=item['block_swizzle'],
+            )
+            manifest.append(op)
+    LOGGER.info(f'{content["kernel_type"]} search candidates size={len(content["candidates"])}')
+    return {content['kernel_type']: register}
+############### search-driven generation end ###############
+
+
 ################## basic_matmul ##################
 @OperationRegistry.register('basic_matmul')
 def register_gemm_basic_matmul_operation(manifest):
@@ -339,4 +698,4 @@ def register_gemm_grouped_matmul_operation(manifest):
             block_swizzle=block_swizzle,
         )
         manifest.append(op)
-################## grouped_matmul end ##################
\ No newline at end of file
+################## grouped_matmul end ##################
\ No newline at end of file
@@ -28,9 +28,8 @@ Pruning strategies and parameter combination strategies are customizable.
 """
 
 
-@OperationRegistry.register_high_priority('basic_matmul')
-def register(manifest):
-    config = search_space.SearchSpaceConfiguration(
+def get_configuration():
+    return search_space.SearchSpaceConfiguration(
         kernel_type='basic_matmul',
 
         data_type_a=library.DataType.fp16,
@@ -45,7 +44,12 @@ def register(manifest):
         l1_tile_n_range=(128, 256),
         l1_tile_k_range=(128, 256),
 
+        # a list of swizzles is also accepted, mstuner_search.py --swizzle-simulator prunes them per tile shape
         block_swizzle='Gemm::Block::GemmIdentityBlockSwizzle<3, 0>',
     )
 
-    search_space.register_custom_kernel(config, manifest)
+
+@OperationRegistry.register_high_priority('basic_matmul')
+def register(manifest):
+    # get_configuration() is also the search space of tools/tuner/scripts/mstuner_search.py
+    search_space.register_custom_kernel(get_configuration(), manifest)
@@ -11,6 +11,93 @@
 # ----------------------------------------------------------------------------
 
 import os
+import json
+import math
+import hashlib
+import logging
+
+LOGGER = logging.getLogger(__name__)
+
+
+def stable_hash(text):
+    # hash() of str is salted per process, compilation units must not change between runs
+    return int(hashlib.md5(text.encode('utf-8')).hexdigest(), 16)
+
+
+def shard_by_name(names, unit_num, balance_factor=1.1):
+    """
+    Assign names to at most unit_num shards, return {name: shard}.
+
+    A name goes to the shard of its hash, or the next shard with room when that one is full, so adding or
+    removing a few names only changes a few shards and every shard holds about len(names) / unit_num names.
+    """
+    unit_num = max(1, unit_num)
+    capacity = max(1, math.ceil(len(names) * balance_factor / unit_num))
+    loads = [0] * unit_num
+    shards = {}
+    for name in sorted(names):
+        shard = stable_hash(name) % unit_num
+        while loads[shard] >= capacity:
+            shard = (shard + 1) % unit_num
+        loads[shard] += 1
+        shards[name] = shard
+    return shards
+
+
+class GeneratedFileWriter:
+    """
+    Write generated files only when their content changes, so the build system does not recompile
+    unchanged compilation units. Content hashes are kept in generated/generated_files.json, files of
+    previous generations that are not written again are removed in finalize().
+    """
+
+    MANIFEST_NAME = 'generated_files.json'
+
+    def __init__(self, generated_dir):
+        self.generated_dir = generated_dir
+        self.manifest_path = os.path.join(generated_dir, self.MANIFEST_NAME)
+        self.hashes = {}
+        self.kept = set()
+        self.written = 0
+        self.unchanged = 0
+        self.removed = 0
+        if os.path.isfile(self.manifest_path):
+            try:
+                with open(self.manifest_path) as f:
+                    self.hashes = json.load(f)
+            except (OSError, ValueError):
+                LOGGER.warning(f'ignore broken {self.manifest_path}, all files will be written')
+                self.hashes = {}
+
+    def write(self, rel_path, content):
+        digest = hashlib.sha256(content.encode('utf-8')).hexdigest()
+        path = os.path.join(self.generated_dir, rel_path)
+        self.kept.add(rel_path)
+        if self.hashes.get(rel_path) == digest and os.path.isfile(path):
+            self.unchanged += 1
+            return
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        try:
+            os.remove(path)
+        except FileNotFoundError:
+            pass
+        fd = os.open(path, os.O_CREAT | os.O_WRONLY | os.O_TRUNC, 0o550) # r-xr-x---
+        with os.fdopen(fd, 'w') as f:
+            f.write(content)
+        self.hashes[rel_path] = digest
+        self.written += 1
+
+    def finalize(self):
+        for root, _, files in os.walk(self.generated_dir):
+            for file in files:
+                path = os.path.join(root, file)
+                rel_path = os.path.relpath(path, self.generated_dir)
+                if rel_path != self.MANIFEST_NAME and rel_path not in self.kept:
+                    os.remove(path)
+                    self.removed += 1
+        self.hashes = {rel_path: digest for rel_path, digest in self.hashes.items() if rel_path in self.kept}
+        with open(self.manifest_path, 'w') as f:
+            json.dump(self.hashes, f, indent=1, sort_keys=True)
 
 
 class KernelGroupFile:
@@ -46,30 +133,20 @@ using namespace Catlass;
         self.custom_common_decls.add(custom_common_decls)
         self.body_src.append(body)
 
-    def write_in_dir(self, workspace_dir):
+    def render(self):
+        # sets are iterated in sorted order, the content must be identical between runs
         operation_headers = ''
-        for header in self.operation_headers:
+        for header in sorted(self.operation_headers):
             operation_headers += header + '\n'
         kernel_instance_headers = ''
-        for header in self.kernel_instance_headers:
+        for header in sorted(self.kernel_instance_headers):
             kernel_instance_headers += header + '\n'
         custom_common_decls_src = ''
-        for decl in self.custom_common_decls:
+        for decl in sorted(self.custom_common_decls):
             custom_common_decls_src += decl + '\n'
         headers = self.header_template.format(
             operation_headers=operation_headers,
             kernel_instance_headers=kernel_instance_headers,
             custom_common_decls=custom_common_decls_src
         )
-
-        fname = os.path.join(workspace_dir, self.file_name)
-        try: os.remove(fname)
-        except FileNotFoundError: pass
-
-        fd = os.open(fname, os.O_CREAT | os.O_WRONLY | \
-                            os.O_TRUNC, 0o550) # r-xr-x---
-        with os.fdopen(fd, "w") as f:
-            f.write(headers)
-            for body in self.body_src:
-                f.write(body)
-            f.write(self.tail)
+        return headers + ''.join(self.body_src) + self.tail
@@ -50,6 +50,8 @@ public:
             GemmShapeDescription(L1TileShape::M, L1TileShape::N, L1TileShape::K);
         this->description_.tileDescription.L0TileShape =
             GemmShapeDescription(L0TileShape::M, L0TileShape::N, L0TileShape::K);
+        this->description_.tileDescription.blockSwizzle = BlockSwizzleDescription(
+            BlockSwizzleMap<BlockScheduler>::offset, BlockSwizzleMap<BlockScheduler>::direction);
     }
 
     virtual OperationDescription const &GetDescription() const override
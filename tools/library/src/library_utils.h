@@ -12,6 +12,7 @@
 #define CATLASS_LIBRARY_LIBRARY_UTILS_H
 
 #include "catlass/library/operation.h"
+#include "catlass/gemm/block/block_swizzle.hpp"
 
 namespace Catlass {
 namespace Library {
@@ -77,6 +78,17 @@ template <> struct LayoutMap<Catlass::layout::nN> {
     static LayoutType const typeId = LayoutType::nN;
 };
 
+template <typename BlockScheduler> struct BlockSwizzleMap {
+    static uint32_t const offset = 0;
+    static uint32_t const direction = 0;
+};
+
+template <uint32_t SwizzleOffset, uint32_t SwizzleDirection>
+struct BlockSwizzleMap<Gemm::Block::GemmIdentityBlockSwizzle<SwizzleOffset, SwizzleDirection>> {
+    static uint32_t const offset = SwizzleOffset;
+    static uint32_t const direction = SwizzleDirection;
+};
+
 template <typename Element, typename Layout>
 TensorDescription MakeTensorDescription()
 {
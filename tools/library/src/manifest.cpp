@@ -15,17 +15,135 @@ namespace Library {
 
 using namespace Catlass;
 
-void RegisterAllKernels(Manifest &manifest);
+// generated, registers the operations of one kind, subKind is e.g. GemmKind for OperationKind::Gemm
+void RegisterKernels(Manifest &manifest, OperationKind kind, uint32_t subKind);
+
+namespace {
+
+inline bool SameTensor(TensorDescription const &lhs, TensorDescription const &rhs)
+{
+    return lhs.element == rhs.element && lhs.layout == rhs.layout;
+}
+
+inline bool SameShape(GemmShapeDescription const &lhs, GemmShapeDescription const &rhs)
+{
+    return lhs.m == rhs.m && lhs.n == rhs.n && lhs.k == rhs.k;
+}
+
+inline bool MatchTensor(TensorDescription const &query, TensorDescription const &tensor)
+{
+    return (query.element == DataType::Invalid || query.element == tensor.element) &&
+        (query.layout == LayoutType::Invalid || query.layout == tensor.layout);
+}
+
+inline bool MatchShape(GemmShapeDescription const &query, GemmShapeDescription const &shape)
+{
+    return (query.m == 0 || query.m == shape.m) && (query.n == 0 || query.n == shape.n) &&
+        (query.k == 0 || query.k == shape.k);
+}
+
+inline bool IsFullTensor(TensorDescription const &tensor)
+{
+    return tensor.element != DataType::Invalid && tensor.layout != LayoutType::Invalid;
+}
+
+inline void HashCombine(size_t &seed, size_t value)
+{
+    constexpr size_t GOLDEN_RATIO = 0x9e3779b9;
+    constexpr size_t LEFT_SHIFT = 6;
+    constexpr size_t RIGHT_SHIFT = 2;
+    seed ^= value + GOLDEN_RATIO + (seed << LEFT_SHIFT) + (seed >> RIGHT_SHIFT);
+}
+
+}
+
+GemmOperationKey GemmOperationKey::FromDescription(GemmOperationDescription const &desp)
+{
+    GemmOperationKey key;
+    key.gemmKind = desp.gemmKind;
+    key.A = desp.A;
+    key.B = desp.B;
+    key.C = desp.C;
+    key.L1TileShape = desp.tileDescription.L1TileShape;
+    key.L0TileShape = desp.tileDescription.L0TileShape;
+    key.blockSwizzle = desp.tileDescription.blockSwizzle;
+    return key;
+}
+
+bool GemmOperationKey::operator==(GemmOperationKey const &other) const
+{
+    return gemmKind == other.gemmKind && SameTensor(A, other.A) && SameTensor(B, other.B) &&
+        SameTensor(C, other.C) && SameShape(L1TileShape, other.L1TileShape) &&
+        SameShape(L0TileShape, other.L0TileShape) && blockSwizzle.offset == other.blockSwizzle.offset &&
+        blockSwizzle.direction == other.blockSwizzle.direction;
+}
+
+size_t GemmOperationKeyHash::operator()(GemmOperationKey const &key) const
+{
+    size_t seed = static_cast<size_t>(key.gemmKind);
+    for (auto const *tensor : {&key.A, &key.B, &key.C}) {
+        HashCombine(seed, static_cast<size_t>(tensor->element));
+        HashCombine(seed, static_cast<size_t>(tensor->layout));
+    }
+    for (auto const *shape : {&key.L1TileShape, &key.L0TileShape}) {
+        HashCombine(seed, shape->m);
+        HashCombine(seed, shape->n);
+        HashCombine(seed, shape->k);
+    }
+    HashCombine(seed, key.blockSwizzle.offset);
+    HashCombine(seed, key.blockSwizzle.direction);
+    return seed;
+}
+
+uint64_t Manifest::FamilyKey(GemmKind gemmKind, TensorDescription const &A, TensorDescription const &B,
+    TensorDescription const &C)
+{
+    constexpr uint32_t BITS = 8;
+    uint64_t key = static_cast<uint64_t>(gemmKind);
+    for (auto const *tensor : {&A, &B, &C}) {
+        key = (key << BITS) | static_cast<uint64_t>(tensor->element);
+        key = (key << BITS) | static_cast<uint64_t>(tensor->layout);
+    }
+    return key;
+}
 
 Status Manifest::Initialize()
 {
-    RegisterAllKernels(*this);
+    for (size_t i = 0; i < GEMM_KIND_NUM; ++i) {
+        Initialize(static_cast<GemmKind>(i));
+    }
+    return Status::kSuccess;
+}
+
+Status Manifest::Initialize(GemmKind gemmKind)
+{
+    size_t idx = static_cast<size_t>(gemmKind);
+    if (idx >= GEMM_KIND_NUM) {
+        return Status::kInvalid;
+    }
+    if (!registeredGemmKinds_.test(idx)) {
+        registeredGemmKinds_.set(idx);
+        RegisterKernels(*this, OperationKind::Gemm, static_cast<uint32_t>(idx));
+    }
     return Status::kSuccess;
 }
 
 void Manifest::Append(Operation *op)
 {
     operationList_.emplace_back(op);
+    auto &desp = op->GetDescription();
+    if (desp.kind != OperationKind::Gemm) {
+        return;
+    }
+    auto &gemmDesp = static_cast<GemmOperationDescription const &>(desp);
+    size_t idx = static_cast<size_t>(gemmDesp.gemmKind);
+    if (idx >= GEMM_KIND_NUM) {
+        return;
+    }
+    // the first registered operation wins on duplicated keys
+    gemmIndex_.emplace(GemmOperationKey::FromDescription(gemmDesp), op);
+    gemmFamilies_[FamilyKey(gemmDesp.gemmKind, gemmDesp.A, gemmDesp.B, gemmDesp.C)].emplace_back(op);
+    gemmKinds_[idx].emplace_back(op);
 }
 
 std::vector<Operation *> const &Manifest::GetOperations() const
@@ -33,5 +151,48 @@ std::vector<Operation *> const &Manifest::GetOperations() const
     return operationList_;
 }
 
+Operation *Manifest::Find(GemmOperationKey const &key)
+{
+    if (Initialize(key.gemmKind) != Status::kSuccess) {
+        return nullptr;
+    }
+    auto it = gemmIndex_.find(key);
+    return it == gemmIndex_.end() ? nullptr : it->second;
+}
+
+std::vector<Operation *> Manifest::Query(GemmOperationQuery const &query)
+{
+    std::vector<Operation *> const *candidates = &operationList_;
+    if (query.gemmKind == GemmKind::Invalid) {
+        Initialize();
+    } else if (Initialize(query.gemmKind) != Status::kSuccess) {
+        return {};
+    } else if (IsFullTensor(query.A) && IsFullTensor(query.B) && IsFullTensor(query.C)) {
+        auto it = gemmFamilies_.find(FamilyKey(query.gemmKind, query.A, query.B, query.C));
+        if (it == gemmFamilies_.end()) {
+            return {};
+        }
+        candidates = &it->second;
+    } else {
+        candidates = &gemmKinds_[static_cast<size_t>(query.gemmKind)];
+    }
+
+    std::vector<Operation *> result;
+    for (auto *op : *candidates) {
+        auto &desp = op->GetDescription();
+        if (desp.kind != OperationKind::Gemm) {
+            continue;
+        }
+        auto &gemmDesp = static_cast<GemmOperationDescription const &>(desp);
+        if ((query.gemmKind == GemmKind::Invalid || query.gemmKind == gemmDesp.gemmKind) &&
+            MatchTensor(query.A, gemmDesp.A) && MatchTensor(query.B, gemmDesp.B) &&
+            MatchTensor(query.C, gemmDesp.C) && MatchShape(query.L1TileShape, desp.tileDescription.L1TileShape) &&
+            MatchShape(query.L0TileShape, desp.tileDescription.L0TileShape)) {
+            result.emplace_back(op);
+        }
+    }
+    return result;
+}
+
 }
 }
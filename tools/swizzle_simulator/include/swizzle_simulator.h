@@ -0,0 +1,253 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_SWIZZLE_SIMULATOR_H
+#define CATLASS_SWIZZLE_SIMULATOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef __CCE__
+// Host stand-ins of the core queries used by the other schedulers of block_swizzle.hpp, which are not replayed.
+namespace AscendC {
+inline int64_t GetBlockNum()
+{
+    return 1;
+}
+inline int64_t GetBlockIdx()
+{
+    return 0;
+}
+} // namespace AscendC
+#endif
+
+#include "catlass/gemm/block/block_swizzle.hpp"
+
+namespace Catlass {
+
+struct L2CacheConfig {
+    uint64_t size{192ULL * 1024 * 1024};  // bytes
+    uint32_t ways{16};
+    uint32_t lineSize{512};               // bytes
+};
+
+// Set associative cache with LRU replacement, only tags are modeled.
+class L2CacheModel {
+public:
+    explicit L2CacheModel(const L2CacheConfig &config)
+        : ways_(std::max<uint32_t>(config.ways, 1)), lineSize_(std::max<uint32_t>(config.lineSize, 1))
+    {
+        setNum_ = std::max<uint64_t>(config.size / (static_cast<uint64_t>(lineSize_) * ways_), 1);
+        tags_.assign(setNum_ * ways_, INVALID_TAG);
+        stamps_.assign(setNum_ * ways_, 0);
+    }
+
+    // Touch the lines of [addr, addr + len), return the number of missed lines.
+    uint64_t Access(uint64_t addr, uint64_t len)
+    {
+        if (len == 0) {
+            return 0;
+        }
+        uint64_t misses = 0;
+        for (uint64_t line = addr / lineSize_; line <= (addr + len - 1) / lineSize_; ++line) {
+            misses += AccessLine(line) ? 0 : 1;
+        }
+        return misses;
+    }
+
+    uint32_t LineSize() const { return lineSize_; }
+
+private:
+    static constexpr uint64_t INVALID_TAG = UINT64_MAX;
+
+    bool AccessLine(uint64_t line)
+    {
+        uint64_t base = (line % setNum_) * ways_;
+        uint64_t victim = base;
+        ++clock_;
+        for (uint64_t i = base; i < base + ways_; ++i) {
+            if (tags_[i] == line) {
+                stamps_[i] = clock_;
+                return true;
+            }
+            if (stamps_[i] < stamps_[victim]) {
+                victim = i;
+            }
+        }
+        tags_[victim] = line;
+        stamps_[victim] = clock_;
+        return false;
+    }
+
+    uint32_t ways_;
+    uint32_t lineSize_;
+    uint64_t setNum_;
+    uint64_t clock_{0};
+    std::vector<uint64_t> tags_;
+    std::vector<uint64_t> stamps_;
+};
+
+struct SimulationProblem {
+    GemmCoord problemShape;
+    GemmCoord l1TileShape;
+    bool transA{false};             // A is column major
+    bool transB{false};             // B is column major
+    uint32_t elementSize{2};        // bytes of A and B elements
+    uint32_t coreNum{24};
+    uint32_t splitkFactor{1};       // > 1 replays SplitkGemmIdentityBlockSwizzle
+};
+
+struct SimulationResult {
+    uint32_t swizzleOffset{0};
+    uint32_t swizzleDirection{0};
+    uint64_t requestedBytesA{0};    // bytes of A read by all cores
+    uint64_t requestedBytesB{0};
+    uint64_t hbmBytesA{0};          // bytes of A fetched from HBM, i.e. missed in L2
+    uint64_t hbmBytesB{0};
+    uint64_t compulsoryBytes{0};    // bytes of A and B, fetched at least once
+    double loadImbalance{1.0};      // max over mean of the multiply-accumulates per core
+
+    uint64_t HbmBytes() const { return hbmBytesA + hbmBytesB; }
+    // how many times a panel fetched from HBM is read on average
+    double ReuseA() const { return hbmBytesA == 0 ? 0 : static_cast<double>(requestedBytesA) / hbmBytesA; }
+    double ReuseB() const { return hbmBytesB == 0 ? 0 : static_cast<double>(requestedBytesB) / hbmBytesB; }
+    double HitRate() const
+    {
+        uint64_t requested = requestedBytesA + requestedBytesB;
+        return requested == 0 ? 0 : 1.0 - static_cast<double>(HbmBytes()) / requested;
+    }
+};
+
+namespace detail {
+
+// Output tile and k range of one task, kIdx is the first k tile.
+struct SimulatedTask {
+    GemmCoord blockCoord;
+    GemmCoord actualBlockShape;
+};
+
+template <uint32_t SwizzleOffset, uint32_t SwizzleDirection>
+std::vector<SimulatedTask> ReplaySwizzle(const SimulationProblem &problem)
+{
+    std::vector<SimulatedTask> tasks;
+    if (problem.splitkFactor > 1) {
+        Gemm::Block::SplitkGemmIdentityBlockSwizzle<SwizzleOffset, SwizzleDirection> swizzle(
+            problem.problemShape, problem.l1TileShape, problem.splitkFactor);
+        for (uint32_t taskIdx = 0; taskIdx < swizzle.GetCoreLoops(); ++taskIdx) {
+            GemmCoord blockCoord = swizzle.GetBlockCoord(taskIdx);
+            tasks.push_back({blockCoord,
+                swizzle.GetActualBlockShape(blockCoord, swizzle.GetSplitkSliceIdx(taskIdx))});
+        }
+    } else {
+        Gemm::Block::GemmIdentityBlockSwizzle<SwizzleOffset, SwizzleDirection> swizzle(
+            problem.problemShape, MatrixCoord(problem.l1TileShape.GetCoordMN()));
+        for (uint32_t taskIdx = 0; taskIdx < swizzle.GetCoreLoops(); ++taskIdx) {
+            GemmCoord blockCoord = swizzle.GetBlockCoord(taskIdx);
+            tasks.push_back({blockCoord, swizzle.GetActualBlockShape(blockCoord)});
+        }
+    }
+    return tasks;
+}
+
+// Bytes missed in L2 when reading rows [row, row + rows) x columns [col, col + cols) of a matrix.
+inline uint64_t AccessTile(L2CacheModel &cache, uint64_t base, bool columnMajor, uint64_t ld, uint32_t elementSize,
+    uint32_t row, uint32_t col, uint32_t rows, uint32_t cols)
+{
+    uint32_t outer = columnMajor ? cols : rows;
+    uint32_t inner = columnMajor ? rows : cols;
+    uint64_t outerStart = columnMajor ? col : row;
+    uint64_t innerStart = columnMajor ? row : col;
+    uint64_t misses = 0;
+    for (uint32_t i = 0; i < outer; ++i) {
+        misses += cache.Access(base + ((outerStart + i) * ld + innerStart) * elementSize,
+            static_cast<uint64_t>(inner) * elementSize);
+    }
+    return misses * cache.LineSize();
+}
+
+} // namespace detail
+
+/*
+ * Replays a block swizzle for every core and predicts its L2 behavior.
+ *
+ * Core c runs tasks c, c + coreNum, ..., as the matmul kernels do. Cores advance in lockstep: in each round
+ * every core reads the A and B tiles of its task one L1 k tile at a time, interleaved with the other cores,
+ * through one shared L2. Only reads of A and B are modeled, C is written once whatever the swizzle is.
+ */
+template <uint32_t SwizzleOffset, uint32_t SwizzleDirection>
+SimulationResult SimulateSwizzle(const SimulationProblem &problem, const L2CacheConfig &l2Config)
+{
+    SimulationResult result;
+    result.swizzleOffset = SwizzleOffset;
+    result.swizzleDirection = SwizzleDirection;
+    const uint32_t m = problem.problemShape.m();
+    const uint32_t n = problem.problemShape.n();
+    const uint32_t k = problem.problemShape.k();
+    const uint32_t tileK = problem.l1TileShape.k();
+    const uint32_t coreNum = std::max<uint32_t>(problem.coreNum, 1);
+    if (m == 0 || n == 0 || k == 0 || problem.l1TileShape.m() == 0 || problem.l1TileShape.n() == 0 || tileK == 0) {
+        return result;
+    }
+    std::vector<detail::SimulatedTask> tasks = detail::ReplaySwizzle<SwizzleOffset, SwizzleDirection>(problem);
+
+    L2CacheModel cache(l2Config);
+    const uint64_t elementSize = problem.elementSize;
+    const uint64_t ldA = problem.transA ? m : k;
+    const uint64_t ldB = problem.transB ? k : n;
+    // B is placed right after A, aligned to a cache line
+    const uint64_t sizeA = static_cast<uint64_t>(m) * k * elementSize;
+    const uint64_t baseB = (sizeA + l2Config.lineSize - 1) / l2Config.lineSize * l2Config.lineSize;
+    result.compulsoryBytes = sizeA + static_cast<uint64_t>(k) * n * elementSize;
+
+    std::vector<uint64_t> coreMacs(coreNum, 0);
+    for (size_t roundStart = 0; roundStart < tasks.size(); roundStart += coreNum) {
+        size_t roundEnd = std::min(tasks.size(), roundStart + coreNum);
+        uint32_t maxKLoops = 0;
+        for (size_t i = roundStart; i < roundEnd; ++i) {
+            const GemmCoord &shape = tasks[i].actualBlockShape;
+            maxKLoops = std::max(maxKLoops, CeilDiv(shape.k(), tileK));
+            coreMacs[i - roundStart] += static_cast<uint64_t>(shape.m()) * shape.n() * shape.k();
+        }
+        for (uint32_t kLoop = 0; kLoop < maxKLoops; ++kLoop) {
+            for (size_t i = roundStart; i < roundEnd; ++i) {
+                const GemmCoord &coord = tasks[i].blockCoord;
+                const GemmCoord &shape = tasks[i].actualBlockShape;
+                uint32_t kStart = coord.k() * tileK + kLoop * tileK;
+                uint32_t kEnd = coord.k() * tileK + shape.k();
+                if (kStart >= kEnd) {
+                    continue;
+                }
+                uint32_t kActual = std::min(tileK, kEnd - kStart);
+                uint32_t mStart = coord.m() * problem.l1TileShape.m();
+                uint32_t nStart = coord.n() * problem.l1TileShape.n();
+                result.requestedBytesA += static_cast<uint64_t>(shape.m()) * kActual * elementSize;
+                result.requestedBytesB += static_cast<uint64_t>(kActual) * shape.n() * elementSize;
+                result.hbmBytesA += detail::AccessTile(cache, 0, problem.transA, ldA, problem.elementSize,
+                    mStart, kStart, shape.m(), kActual);
+                result.hbmBytesB += detail::AccessTile(cache, baseB, problem.transB, ldB, problem.elementSize,
+                    kStart, nStart, kActual, shape.n());
+            }
+        }
+    }
+
+    uint64_t maxMacs = *std::max_element(coreMacs.begin(), coreMacs.end());
+    uint64_t sumMacs = 0;
+    for (auto macs : coreMacs) {
+        sumMacs += macs;
+    }
+    result.loadImbalance = sumMacs == 0 ? 1.0 : static_cast<double>(maxMacs) * coreNum / sumMacs;
+    return result;
+}
+
+} // namespace Catlass
+
+#endif // CATLASS_SWIZZLE_SIMULATOR_H
@@ -0,0 +1,268 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include <array>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <utility>
+
+#include "command_line_parser.h"
+#include "log.h"
+#include "swizzle_simulator.h"
+
+using namespace Catlass;
+
+namespace {
+
+using SimulateFunc = SimulationResult (*)(const SimulationProblem &, const L2CacheConfig &);
+
+// swizzle offsets instantiated by the simulator, the same range as the search space of mstuner_catlass
+constexpr uint32_t MAX_SWIZZLE_OFFSET = 8;
+constexpr uint32_t SWIZZLE_DIRECTIONS = 2;
+
+template <size_t... I>
+constexpr auto MakeSimulateFuncs(std::index_sequence<I...>)
+{
+    return std::array<SimulateFunc, sizeof...(I)>{
+        &SimulateSwizzle<I / SWIZZLE_DIRECTIONS + 1, I % SWIZZLE_DIRECTIONS>...
+    };
+}
+
+constexpr auto SIMULATE_FUNCS = MakeSimulateFuncs(std::make_index_sequence<MAX_SWIZZLE_OFFSET * SWIZZLE_DIRECTIONS>{});
+
+void PrintHelp()
+{
+    LOGM("swizzle_simulator replays the block swizzles of catlass matmul kernels on the host and predicts\n"
+         "their L2 reuse, HBM traffic and per-core load imbalance, no device is needed.\n");
+    LOGM("Options:");
+    LOGM("   --help, -h                  <Optional> Help message.");
+    LOGM("   --m=<int>                   <Optional> Dimension m of the problem shape, default: 256.");
+    LOGM("   --n=<int>                   <Optional> Dimension n of the problem shape, default: 512.");
+    LOGM("   --k=<int>                   <Optional> Dimension k of the problem shape, default: 1024.");
+    LOGM("   --l1_tile=<MxNxK>           <Optional> L1 tile shape, default: 128x256x256.");
+    LOGM("   --A=<dtype:layout>          <Optional> Data type and layout of A, default: fp16:row.");
+    LOGM("   --B=<dtype:layout>          <Optional> Data type and layout of B, default: fp16:row.");
+    LOGM("   --core_num=<int>            <Optional> Number of AI cores, default: 24.");
+    LOGM("   --splitk_factor=<int>       <Optional> Replay SplitkGemmIdentityBlockSwizzle when > 1, default: 1.");
+    LOGM("   --swizzle_offsets=<list>    <Optional> Comma separated offsets in [1, %u], default: all.",
+         MAX_SWIZZLE_OFFSET);
+    LOGM("   --l2_size=<int>             <Optional> L2 size in bytes, default: 201326592.");
+    LOGM("   --l2_ways=<int>             <Optional> L2 associativity, default: 16.");
+    LOGM("   --l2_line=<int>             <Optional> L2 line size in bytes, default: 512.");
+    LOGM("   --output=<string>           <Optional> Csv file of the simulation results.");
+}
+
+bool ParseTileShape(const std::string &str, GemmCoord &shape)
+{
+    uint32_t dims[3] = {0, 0, 0};
+    std::stringstream ss(str);
+    std::string dim;
+    for (auto &d : dims) {
+        if (!std::getline(ss, dim, 'x') || dim.empty() || dim.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        d = static_cast<uint32_t>(std::stoul(dim));
+        if (d == 0) {
+            return false;
+        }
+    }
+    shape = GemmCoord{dims[0], dims[1], dims[2]};
+    return !std::getline(ss, dim, 'x');
+}
+
+// same format as the --A/--B options of mstuner_catlass, e.g. fp16:row
+bool ParseTensor(const std::string &str, uint32_t &elementSize, bool &columnMajor)
+{
+    static const std::pair<std::string, uint32_t> ELEMENT_SIZES[] = {
+        {"u8", 1}, {"int8", 1}, {"fp16", 2}, {"bf16", 2}, {"int32", 4}, {"fp32", 4}
+    };
+    auto pos = str.find(':');
+    if (pos == std::string::npos) {
+        return false;
+    }
+    std::string dtype = str.substr(0, pos);
+    std::string layout = str.substr(pos + 1);
+    if (layout != "row" && layout != "column") {
+        return false;
+    }
+    columnMajor = layout == "column";
+    for (auto &[name, size] : ELEMENT_SIZES) {
+        if (name == dtype) {
+            elementSize = size;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseOffsets(const std::string &str, std::set<uint32_t> &offsets)
+{
+    std::stringstream ss(str);
+    std::string offset;
+    while (std::getline(ss, offset, ',')) {
+        if (offset.empty() || offset.find_first_not_of("0123456789") != std::string::npos || offset.size() > 2) {
+            return false;
+        }
+        uint32_t val = static_cast<uint32_t>(std::stoul(offset));
+        if (val == 0 || val > MAX_SWIZZLE_OFFSET) {
+            return false;
+        }
+        offsets.insert(val);
+    }
+    return !offsets.empty();
+}
+
+std::string GetSwizzleName(const SimulationProblem &problem, const SimulationResult &result)
+{
+    return std::string("Gemm::Block::") + (problem.splitkFactor > 1 ? "Splitk" : "") + "GemmIdentityBlockSwizzle<" +
+        std::to_string(result.swizzleOffset) + ", " + std::to_string(result.swizzleDirection) + ">";
+}
+
+bool ParseOptions(CommandLineParser &parser, SimulationProblem &problem, L2CacheConfig &l2Config,
+    std::set<uint32_t> &offsets)
+{
+    uint32_t m = 256;
+    uint32_t n = 512;
+    uint32_t k = 1024;
+    std::string l1Tile = "128x256x256";
+    std::string tensorA = "fp16:row";
+    std::string tensorB = "fp16:row";
+    std::string swizzleOffsets;
+    const std::pair<const char *, uint32_t *> uintOptions[] = {
+        {"m", &m}, {"n", &n}, {"k", &k}, {"core_num", &problem.coreNum}, {"splitk_factor", &problem.splitkFactor},
+        {"l2_ways", &l2Config.ways}, {"l2_line", &l2Config.lineSize}
+    };
+    for (auto &[key, val] : uintOptions) {
+        if (parser.HasKey(key) && parser.Get<uint32_t>(key, *val) != CommandLineParser::ERROR_CODE::NONE) {
+            LOGE("Get key --%s failed, it should be an unsigned integer", key);
+            return false;
+        }
+    }
+    const std::pair<const char *, std::string *> strOptions[] = {
+        {"l1_tile", &l1Tile}, {"A", &tensorA}, {"B", &tensorB}, {"swizzle_offsets", &swizzleOffsets}
+    };
+    for (auto &[key, val] : strOptions) {
+        if (parser.HasKey(key) && parser.Get<std::string>(key, *val) != CommandLineParser::ERROR_CODE::NONE) {
+            LOGE("Get key --%s failed", key);
+            return false;
+        }
+    }
+    if (parser.HasKey("l2_size") &&
+        parser.Get<uint64_t>("l2_size", l2Config.size) != CommandLineParser::ERROR_CODE::NONE) {
+        LOGE("Get key --l2_size failed, it should be an unsigned integer");
+        return false;
+    }
+
+    uint32_t elementSizeB = 0;
+    if (m == 0 || n == 0 || k == 0) {
+        LOGE("--m, --n and --k should be positive");
+        return false;
+    } else if (!ParseTileShape(l1Tile, problem.l1TileShape)) {
+        LOGE("--l1_tile should be like 128x256x256");
+        return false;
+    } else if (!ParseTensor(tensorA, problem.elementSize, problem.transA) ||
+        !ParseTensor(tensorB, elementSizeB, problem.transB)) {
+        LOGE("--A and --B should be like fp16:row or fp16:column");
+        return false;
+    } else if (elementSizeB != problem.elementSize) {
+        LOGE("Data types of A and B should have the same size");
+        return false;
+    } else if (problem.coreNum == 0 || problem.splitkFactor == 0 || l2Config.ways == 0 || l2Config.lineSize == 0 ||
+        l2Config.size < static_cast<uint64_t>(l2Config.ways) * l2Config.lineSize) {
+        LOGE("--core_num, --splitk_factor, --l2_ways and --l2_line should be positive, and --l2_size should hold "
+             "at least one set");
+        return false;
+    }
+    problem.problemShape = GemmCoord{m, n, k};
+
+    if (swizzleOffsets.empty()) {
+        for (uint32_t offset = 1; offset <= MAX_SWIZZLE_OFFSET; ++offset) {
+            offsets.insert(offset);
+        }
+    } else if (!ParseOffsets(swizzleOffsets, offsets)) {
+        LOGE("--swizzle_offsets should be comma separated integers in [1, %u]", MAX_SWIZZLE_OFFSET);
+        return false;
+    }
+    return true;
+}
+
+bool DumpResults(const std::string &output, const SimulationProblem &problem,
+    const std::vector<SimulationResult> &results)
+{
+    std::ofstream file(output);
+    if (!file.is_open()) {
+        LOGE("Open output file %s failed", output.c_str());
+        return false;
+    }
+    file << "block_swizzle,swizzle_offset,swizzle_direction,m,n,k,hbm_bytes,hbm_bytes_a,hbm_bytes_b,"
+            "compulsory_bytes,l2_hit_rate,reuse_a,reuse_b,load_imbalance\n";
+    for (auto &r : results) {
+        file << "\"" << GetSwizzleName(problem, r) << "\"," << r.swizzleOffset << "," << r.swizzleDirection << ","
+             << problem.problemShape.m() << "," << problem.problemShape.n() << "," << problem.problemShape.k() << ","
+             << r.HbmBytes() << "," << r.hbmBytesA << "," << r.hbmBytesB << "," << r.compulsoryBytes << ","
+             << r.HitRate() << "," << r.ReuseA() << "," << r.ReuseB() << "," << r.loadImbalance << "\n";
+    }
+    LOGI("Save simulation results to %s", output.c_str());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, const char *argv[])
+{
+    CommandLineParser parser;
+    parser.Parse(argc, argv);
+    if (parser.Help()) {
+        PrintHelp();
+        return 0;
+    }
+    SimulationProblem problem;
+    L2CacheConfig l2Config;
+    std::set<uint32_t> offsets;
+    if (!ParseOptions(parser, problem, l2Config, offsets)) {
+        return 1;
+    }
+    std::string output;
+    if (parser.HasKey("output") && parser.Get<std::string>("output", output) != CommandLineParser::ERROR_CODE::NONE) {
+        LOGE("Get key --output failed");
+        return 1;
+    }
+    parser.PrintUnusedKeys();
+
+    std::vector<SimulationResult> results;
+    for (uint32_t offset : offsets) {
+        for (uint32_t direction = 0; direction < SWIZZLE_DIRECTIONS; ++direction) {
+            results.emplace_back(SIMULATE_FUNCS[(offset - 1) * SWIZZLE_DIRECTIONS + direction](problem, l2Config));
+        }
+    }
+    std::stable_sort(results.begin(), results.end(), [](const SimulationResult &lhs, const SimulationResult &rhs) {
+        return lhs.HbmBytes() < rhs.HbmBytes();
+    });
+
+    constexpr double MB = 1024.0 * 1024.0;
+    LOGM("m=%u n=%u k=%u l1_tile=%ux%ux%u core_num=%u splitk_factor=%u l2=%.1fMB/%uway/%uB",
+         problem.problemShape.m(), problem.problemShape.n(), problem.problemShape.k(), problem.l1TileShape.m(),
+         problem.l1TileShape.n(), problem.l1TileShape.k(), problem.coreNum, problem.splitkFactor,
+         l2Config.size / MB, l2Config.ways, l2Config.lineSize);
+    LOGM("%-48s %12s %10s %10s %10s %10s", "block_swizzle", "hbm(MB)", "hit_rate", "reuse_a", "reuse_b",
+         "imbalance");
+    for (auto &r : results) {
+        LOGM("%-48s %12.3f %10.4f %10.2f %10.2f %10.3f", GetSwizzleName(problem, r).c_str(), r.HbmBytes() / MB,
+             r.HitRate(), r.ReuseA(), r.ReuseB(), r.loadImbalance);
+    }
+    if (!results.empty()) {
+        LOGM("compulsory traffic %.3f MB", results.front().compulsoryBytes / MB);
+    }
+    if (!output.empty() && !DumpResults(output, problem, results)) {
+        return 1;
+    }
+    return 0;
+}
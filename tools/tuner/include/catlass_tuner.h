@@ -11,35 +11,38 @@
 #ifndef CATLASS_TUNER_CATLASS_TUNER_H
 #define CATLASS_TUNER_CATLASS_TUNER_H
 
-#include <condition_variable>
-#include <queue>
+#include <functional>
 #include "catlass/library/manifest.h"
-#include "profiler.h"
+#include "device_backend.h"
 #include "metrics.h"
-#include "op_launcher.h"
+#include "shape_sweep.h"
+#include "tune_worker.h"
 
 namespace Catlass {
 
+// creates the device of deviceId, the real one or a simulated one
+using DeviceBackendFactory = std::function<std::shared_ptr<DeviceBackend>(CommandLineParser &parser,
+    int32_t deviceId)>;
+
 class CatlassTuner {
 public:
-    explicit CatlassTuner(CommandLineParser parser);
-    ~CatlassTuner();
+    // one worker per device of --device, the operations are spread over them
+    CatlassTuner(CommandLineParser parser, const DeviceBackendFactory &createBackend);
     void Run();
 
 private:
+    bool ParseDevices(std::vector<int32_t> &deviceIds);
+    bool ParseShapes();
+    bool InitManifest(std::string_view kernel);
     bool InitOperators(OpConfigPool &pool);
-    void UpdateMetrics(bool readAll = false);
-    void Synchronize();
-    OpRunStatus RunOp(const std::shared_ptr<OpConfig>& opConfig, Library::Operation *op, uint32_t aicCoreNum);
+    void InitSchedule(OpConfigPool &pool, TuneSchedule &schedule);
 
-    aclrtStream stream_{nullptr};
     Library::Manifest manifest_{};
     CommandLineParser parser_{};
-    ProfileDataHandler profileHandler_{};
     Metrics metrics_{};
-    std::queue<std::vector<KernelType>> kernelsQueue_;
-    int32_t deviceId_{0};
-    std::vector<double> durations_{};
+    SamplingPolicy sampling_{};
+    ShapeSweep sweep_{};
+    std::vector<std::unique_ptr<TuneWorker>> workers_;
 };
 
 } // namespace Catlass
@@ -0,0 +1,55 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_TUNER_DEVICE_BACKEND_H
+#define CATLASS_TUNER_DEVICE_BACKEND_H
+
+#include <memory>
+#include <cstdint>
+#include <acl/acl.h>
+#include "catlass/library/operation.h"
+#include "profiler.h"
+
+namespace Catlass {
+
+// Device primitives used by DeviceMemoryManager, OpLauncher and the profiler. The ACL backend runs on a real
+// device, SimulatedDevice models one on the host so that the tuner runs without a device.
+class DeviceBackend {
+public:
+    virtual ~DeviceBackend() = default;
+
+    // returns the stream to launch on, nullptr on failure
+    virtual aclrtStream Initialize(int32_t deviceId) = 0;
+    virtual void Finalize(aclrtStream stream, int32_t deviceId) = 0;
+    // nullptr if unknown
+    virtual const char* GetSocName() = 0;
+    virtual uint32_t GetAicCoreNum() = 0;
+    virtual uint64_t GetFftsAddr() = 0;
+
+    virtual aclError Malloc(void **addr, size_t size) = 0;
+    virtual aclError Free(void *addr) = 0;
+    virtual aclError MemcpyAsync(void *dst, const void *src, size_t size, aclrtMemcpyKind kind,
+                                 aclrtStream stream) = 0;
+    virtual aclError Prefetch(void *addr, size_t size, aclrtStream stream) = 0;
+    // timeout in ms, a negative timeout waits until the stream is done
+    virtual aclError Synchronize(aclrtStream stream, int32_t timeout) = 0;
+
+    virtual void LaunchCacheClear(uint32_t blockDim, aclrtStream stream, void *buffer, void *tilingSize) = 0;
+    // config is the configuration the operation was initialized with
+    virtual Status Launch(Library::Operation *op, void *config, aclrtStream stream, uint32_t blockDim,
+                          uint64_t fftsAddr) = 0;
+
+    virtual ProfileChannel& GetProfileChannel() = 0;
+};
+
+std::shared_ptr<DeviceBackend> CreateAclBackend();
+
+} // namespace Catlass
+#endif // CATLASS_TUNER_DEVICE_BACKEND_H
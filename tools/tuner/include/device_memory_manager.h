@@ -17,9 +17,9 @@
 #include <cstdint>
 #include "log.h"
 #include "m_t_var.h"
+#include "device_backend.h"
 
 #include <acl/acl.h>
-#include <runtime/rt_ffts.h>
 
 namespace Catlass {
 
@@ -31,15 +31,6 @@ namespace Catlass {
         }                                                                       \
     } while (0)
 
-// Macro function for unwinding rt errors.
-#define RT_CHECK(status, func)                                                               \
-    do {                                                                                     \
-        rtError_t error = status;                                                            \
-        if (error != RT_ERROR_NONE) {                                                        \
-            LOGE("%s:%d call " func " rtError: %d", __FILE__, __LINE__, error);              \
-        }                                                                                    \
-    } while (0)
-
 struct DeviceMemoryParam {
     void **addr;
     size_t size;
@@ -47,10 +38,19 @@ struct DeviceMemoryParam {
 
 class DeviceMemoryManager {
 public:
+    // the manager bound to the calling thread, every device worker binds its own
     static DeviceMemoryManager& Instance()
     {
         static DeviceMemoryManager t;
-        return t;
+        return current_ != nullptr ? *current_ : t;
+    }
+
+    static inline void Bind(DeviceMemoryManager *manager) { current_ = manager; }
+
+    DeviceMemoryManager() = default;
+    ~DeviceMemoryManager()
+    {
+        Finalize();
     }
 
     DeviceMemoryManager(const DeviceMemoryManager&) = delete;
@@ -60,13 +60,22 @@ public:
 
     inline uint64_t GetFftsAddr()
     {
-        uint32_t fftsLen{0};
         if (fftsAddr_ == 0) {
-            RT_CHECK(rtGetC2cCtrlAddr(&fftsAddr_, &fftsLen), "rtGetC2cCtrlAddr");
+            fftsAddr_ = backend_->GetFftsAddr();
         }
         return fftsAddr_;
     }
 
+    // set before Initialize, the ACL backend of a real device or a simulated device
+    inline void SetBackend(std::shared_ptr<DeviceBackend> backend)
+    {
+        if (backend) {
+            backend_ = std::move(backend);
+        }
+    }
+
+    inline DeviceBackend& GetBackend() { return *backend_; }
+
     inline bool FreeWorkspace()
     {
         if (Free(workspace_)) {
@@ -95,12 +104,6 @@ private:
         uint64_t cacheSize{};
     };
 
-    DeviceMemoryManager() = default;
-    ~DeviceMemoryManager()
-    {
-        Finalize();
-    }
-
     inline uint64_t Align(uint64_t size) const { return ((size + 63) / 64) * 64; }
 
     bool Expand(void** addr, uint64_t &size, uint64_t target);
@@ -114,6 +117,9 @@ private:
     CacheClear cacheClear_{};
     uint64_t fftsAddr_{0};
     int32_t deviceId_{0};
+    std::shared_ptr<DeviceBackend> backend_{nullptr};
+
+    static inline thread_local DeviceMemoryManager *current_{nullptr};
 };
 
 } // namespace Catlass
@@ -52,6 +52,13 @@ public:
 
     void* GetConfig() override { return &config_; };
     void* GetArg() override { return &arg_; };
+    std::shared_ptr<OpConfig> Clone() const override
+    {
+        auto config = std::make_shared<BasicGemmOpConfig>(*this);
+        config->arg_ = {};
+        return config;
+    }
+    std::shared_ptr<OpConfig> ForShape(uint32_t m, uint32_t n, uint32_t k) const override;
 
 private:
     Library::BasicMatmulGemmArguments arg_{};
@@ -72,6 +79,15 @@ public:
     void SaveMetric(Metric &metric) override;
     void* GetConfig() override { return &config_; };
     void* GetArg() override { return &arg_; };
+    // the group list is copied, every device runs the same groups
+    std::shared_ptr<OpConfig> Clone() const override
+    {
+        auto config = std::make_shared<GroupedGemmOpConfig>(*this);
+        config->arg_ = {};
+        return config;
+    }
+    // with a new group list of the same group count
+    std::shared_ptr<OpConfig> ForShape(uint32_t m, uint32_t n, uint32_t k) const override;
 
 private:
     struct ArgumentSize {
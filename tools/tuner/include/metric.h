@@ -35,6 +35,10 @@ enum class ClassicMetric : uint32_t {
     A,
     B,
     C,
+    P10,            // percentiles and standard deviation of the runs, TASK_DURATION is their median
+    P90,
+    STDDEV,
+    RUNS,
     END
 };
 
@@ -54,6 +58,10 @@ struct ClassicMetricStr {
     static constexpr std::string_view A = "A";
     static constexpr std::string_view B = "B";
     static constexpr std::string_view C = "C";
+    static constexpr std::string_view P10 = "p10(us)";
+    static constexpr std::string_view P90 = "p90(us)";
+    static constexpr std::string_view STDDEV = "stddev(us)";
+    static constexpr std::string_view RUNS = "runs";
 };
 
 class Metric {
@@ -89,8 +97,11 @@ public:
                 classic_[static_cast<uint32_t>(ClassicMetric::L1)] = sv.substr(l + 1, r - l);
             }
         } else {
-            if constexpr (key == ClassicMetric::TASK_DURATION) {
-                taskDuration_ = value;
+            if constexpr (key == ClassicMetric::TASK_DURATION || key == ClassicMetric::P10 ||
+                          key == ClassicMetric::P90 || key == ClassicMetric::STDDEV) {
+                if constexpr (key == ClassicMetric::TASK_DURATION) {
+                    taskDuration_ = value;
+                }
                 std::stringstream ss;
                 constexpr size_t PREC = 3;
                 ss << std::fixed << std::setprecision(PREC) << value;
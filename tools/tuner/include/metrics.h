@@ -14,27 +14,41 @@
 #include <set>
 #include "metric.h"
 #include "op_config.h"
+#include "sampling.h"
 
 namespace Catlass {
 
 class Metrics {
 public:
     inline void SetDeviceId(int32_t device) { deviceId_ = device; }
+    inline void SetDeviceName(std::string_view name) { deviceName_ = name; }
 
     bool SetOutputPath(std::string_view output);
+    bool SetTuningDbPath(std::string_view tuningDb);
     void Dump();
-    void Add(const std::shared_ptr<OpConfig>& opConfig, Library::Operation *op);
-    void SetDurationAndPrint(double duration);
+    // caseId 0 numbers the operation after the last one added
+    void Add(const std::shared_ptr<OpConfig>& opConfig, Library::Operation *op, size_t caseId = 0);
+    // the median of stats is the task duration
+    void SetDurationAndPrint(const SampleStats &stats);
+    // Takes the metrics of the device workers, ordered by case id. The calibration cases ran on every device, the
+    // durations of a device are divided by its median ratio to the first device on them.
+    void Merge(const std::vector<Metrics *> &parts, const std::vector<size_t> &calibration);
+    inline const std::vector<Metric>& GetMetrics() const { return metrics_; }
+    // writes head and rows to the output file with suffix appended to its name, e.g. results_shapes.csv
+    void DumpTable(std::string_view suffix, std::string_view head, const std::vector<std::string> &rows) const;
 
 private:
     static constexpr std::string_view HEAD = "case_id,task_duration(us),device_id,operation,description,"
-                                             "m,n,k,A,B,C";
+                                             "m,n,k,A,B,C,p10(us),p90(us),stddev(us),runs";
     static constexpr std::string_view DIVIDE = "================================\n";
 
     void PrintTop10(const std::string &head);
     std::string GetHead();
+    void DumpTuningDb();
 
     std::string outputPath_;
+    std::string tuningDbPath_;
+    std::string deviceName_;
     std::vector<Metric> metrics_;
     std::set<std::string> extraHeads_;
     size_t durationIdx_{0};
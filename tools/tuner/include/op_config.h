@@ -88,6 +88,10 @@ public:
     virtual bool InitConfig(CommandLineParser &parser) = 0; // call once each OpConfig
     virtual bool InitArgument(Library::Operation *op) = 0; // call each Operator
     virtual void SaveMetric(Metric &metric) = 0;
+    // a config of the same problem for another device, its arguments are not allocated yet
+    virtual std::shared_ptr<OpConfig> Clone() const = 0;
+    // a config of the same operations for the problem m x n x k, nullptr if the kind has no such problem
+    virtual std::shared_ptr<OpConfig> ForShape(uint32_t m, uint32_t n, uint32_t k) const = 0;
 
     bool operator<(const OpConfig& other) const
     {
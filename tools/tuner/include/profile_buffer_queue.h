@@ -0,0 +1,142 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_TUNER_PROFILE_BUFFER_QUEUE_H
+#define CATLASS_TUNER_PROFILE_BUFFER_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Catlass {
+
+// Bounded lock-free ring with one producer thread and one consumer thread.
+template<typename T, size_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of 2");
+
+public:
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue& operator=(const SpscQueue &) = delete;
+
+    // producer only, value is left untouched when the ring is full
+    bool TryPush(T &&value)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == CAPACITY) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == CAPACITY) {
+                return false;
+            }
+        }
+        slots_[tail & (CAPACITY - 1)] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer only
+    bool TryPop(T &value)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+        value = std::move(slots_[head & (CAPACITY - 1)]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    // head and tail are written by different threads, keep them on different cache lines
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t tailCache_{0};   // consumer's last view of tail_
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t headCache_{0};   // producer's last view of head_
+    alignas(CACHE_LINE_SIZE) std::array<T, CAPACITY> slots_{};
+};
+
+// Raw profile data, data.size() is the capacity and size the bytes read.
+struct ProfileBuffer {
+    std::vector<char> data{};
+    size_t size{0};
+};
+
+// Moves profile buffers from the read thread of Profiler to the parser thread of ProfileDataHandler.
+// The parser returns decoded buffers through a second ring, so buffers are reused instead of being
+// allocated and copied for every read.
+class ProfileBufferQueue {
+public:
+    // read thread: an empty buffer of at least capacity bytes
+    ProfileBuffer Acquire(size_t capacity)
+    {
+        ProfileBuffer buffer;
+        if (!free_.TryPop(buffer)) {
+            allocated_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (buffer.data.size() < capacity) {
+            buffer.data.resize(capacity);
+        }
+        buffer.size = 0;
+        return buffer;
+    }
+
+    // read thread: waits while the parser is a whole ring behind, profile data is never dropped
+    void Push(ProfileBuffer &&buffer)
+    {
+        while (!filled_.TryPush(std::move(buffer))) {
+            std::this_thread::yield();
+        }
+    }
+
+    // parser thread
+    bool Pop(ProfileBuffer &buffer)
+    {
+        return filled_.TryPop(buffer);
+    }
+
+    // parser thread: hand a decoded buffer back for reuse, it is freed when enough buffers are spare
+    void Release(ProfileBuffer &&buffer)
+    {
+        (void)free_.TryPush(std::move(buffer));
+    }
+
+    bool Empty() const
+    {
+        return filled_.Empty();
+    }
+
+    // number of buffers allocated since construction
+    size_t AllocatedNum() const
+    {
+        return allocated_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t QUEUE_DEPTH = 64;
+    SpscQueue<ProfileBuffer, QUEUE_DEPTH> filled_;
+    SpscQueue<ProfileBuffer, QUEUE_DEPTH> free_;
+    std::atomic<size_t> allocated_{0};
+};
+
+} // namespace Catlass
+#endif // CATLASS_TUNER_PROFILE_BUFFER_QUEUE_H
@@ -11,36 +11,66 @@
 #ifndef CATLASS_TUNER_PROFILER_H
 #define CATLASS_TUNER_PROFILER_H
 
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <utility>
 #include <vector>
 #include <cstdint>
-#include <functional>
-#include <condition_variable>
-#include <queue>
 #include "m_t_var.h"
+#include "profile_buffer_queue.h"
 
 namespace Catlass {
 
+// A channel with data, as reported by ProfileChannel::Poll
+struct ProfileChannelInfo {
+    uint32_t deviceId;
+    uint32_t channelId;
+};
+
+// Source of the task records read by Profiler: the profile channel of the driver, or a simulated device.
+class ProfileChannel {
+public:
+    virtual ~ProfileChannel() = default;
+
+    virtual bool Start(int32_t deviceId) = 0;
+    virtual void Stop(int32_t deviceId) = 0;
+    // waits at most timeout seconds for data, returns the number of channels written to channels, at most num
+    virtual int Poll(ProfileChannelInfo *channels, int num, int timeout) = 0;
+    // returns the bytes read into outBuf, records may be cut between two reads
+    virtual int Read(const ProfileChannelInfo &channel, char *outBuf, uint32_t bufSize) = 0;
+    // ticks per millisecond of the timestamps of the records, 0 if unknown
+    virtual int64_t GetAicpuFreq(int32_t deviceId) = 0;
+    // rated and current frequency of the AI cores
+    virtual std::pair<int64_t, int32_t> GetAicoreFreq(int32_t deviceId) = 0;
+    // device id of the channel for a logic device id
+    virtual bool GetChannelDeviceId(int32_t deviceId, int32_t &channelDeviceId) = 0;
+};
+
 class Profiler {
 public:
-    using CallBackFunc = std::function<void(std::vector<char>&&)>;
+    // bytes of one task record of the profile channel
+    static constexpr size_t RECORD_SIZE = 64;
+
     explicit Profiler(int32_t deviceId = 0) : deviceId_(deviceId) {}
     ~Profiler();
 
     inline void SetDeviceId(int32_t deviceId) { deviceId_ = deviceId; }
-    inline void RegisterCallback(CallBackFunc callBackFunc) { callBack_ = std::move(callBackFunc); }
+    inline void SetChannel(ProfileChannel *channel) { channel_ = channel; }
+    // the read thread pushes every buffer read from the channel into queue
+    inline void RegisterQueue(ProfileBufferQueue *queue) { queue_ = queue; }
 
     bool Start();
     void Stop();
-    void GetDurations(const std::vector<char> &data, std::vector<uint64_t> &starts, std::vector<uint64_t> &ends);
+    // decode the whole records of data, size / RECORD_SIZE of them
+    void GetDurations(const char *data, size_t size, std::vector<uint64_t> &starts, std::vector<uint64_t> &ends);
 
 private:
     void CreateReadThread();
 
     std::thread readThread_{};
-    std::vector<char> data_{};
-    CallBackFunc callBack_{};
+    ProfileBufferQueue *queue_{nullptr};
+    ProfileChannel *channel_{nullptr};
     int32_t deviceId_;
     MTVar<bool> running_{false};
 };
@@ -57,6 +87,13 @@ public:
     std::pair<int64_t, int32_t> GetAicoreFreq();
     bool SetDeviceId(int32_t deviceId);
 
+    // the channel outlives the handler, it is set before SetDeviceId and Init
+    inline void SetChannel(ProfileChannel *channel)
+    {
+        channel_ = channel;
+        profiler_.SetChannel(channel);
+    }
+
     inline std::vector<double> GetDurations()
     {
         std::vector<double> durations{};
@@ -66,19 +103,22 @@ public:
         return durations;
     }
 
+    // moves decoded durations into durations until it holds num of them, false if they are not there in timeout
+    bool WaitDurations(std::vector<double> &durations, size_t num, std::chrono::milliseconds timeout);
+
 private:
     void ProfileDataThread();
     int64_t GetAicpuFreq();
 
     Profiler profiler_{};
-    std::condition_variable profileDataCV_;
-    std::mutex mtx_;
-    std::queue<std::vector<char>> profileDataQueue_;
+    ProfileChannel *channel_{nullptr};
+    // raw buffers from the read thread of profiler_, decoded by profileDataThread_ while kernels are launched
+    ProfileBufferQueue profileDataQueue_{};
     std::thread profileDataThread_;
     MTVar<std::vector<double>> durations_{};
-    MTVar<bool> finish_{false};
-    int64_t freq_;
-    int32_t deviceId_;
+    std::atomic<bool> finish_{true};
+    int64_t freq_{0};
+    int32_t deviceId_{0};
 };
 
 } // namespace Catlass
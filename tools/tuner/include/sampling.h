@@ -0,0 +1,51 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_TUNER_SAMPLING_H
+#define CATLASS_TUNER_SAMPLING_H
+
+#include <cstdint>
+#include <vector>
+#include "command_line_parser.h"
+
+namespace Catlass {
+
+// How often an operation runs. Runs are added in rungs of minRuns, 2 * minRuns, 4 * minRuns... up to maxRuns, and
+// stop once the 95% confidence interval of the duration is within ci of it. With earlyStop, an operation whose
+// lower bound is above the best duration of its problem so far stops after the rung.
+struct SamplingPolicy {
+    uint32_t minRuns{3};
+    uint32_t maxRuns{50};
+    double ci{0.01};
+    bool earlyStop{true};
+
+    // --min_runs, --max_runs, --ci and --early_stop
+    bool Parse(CommandLineParser &parser);
+};
+
+// Durations of the runs of an operation in us, outliers removed
+struct SampleStats {
+    double median{0};
+    double p10{0};
+    double p90{0};
+    double mean{0};
+    double stddev{0};
+    double ciHalf{0};    // half width of the 95% confidence interval of the mean
+    uint32_t runs{0};    // outliers included
+    uint32_t outliers{0};
+
+    inline double LowerBound() const { return mean - ciHalf; }
+
+    // drops the samples further than 3 scaled MADs from the median, then summarizes the others
+    static SampleStats Summarize(std::vector<double> samples);
+};
+
+} // namespace Catlass
+#endif // CATLASS_TUNER_SAMPLING_H
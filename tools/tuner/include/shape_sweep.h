@@ -0,0 +1,47 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_TUNER_SHAPE_SWEEP_H
+#define CATLASS_TUNER_SHAPE_SWEEP_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "metrics.h"
+
+namespace Catlass {
+
+struct SweepShape {
+    uint32_t m;
+    uint32_t n;
+    uint32_t k;
+    double weight;
+};
+
+// The problems of --shapes=<file>, one m,n,k or m,n,k,weight per line, where the weight is e.g. the call count of
+// the shape in a trace. Every operation is tuned on every shape in one run, then the operations are ranked by their
+// weighted slowdown to the fastest operation of each shape.
+class ShapeSweep {
+public:
+    bool Load(std::string_view path);
+
+    // largest problem first, the device buffers of the first shape are large enough for all the others
+    inline const std::vector<SweepShape>& GetShapes() const { return shapes_; }
+
+    // prints the best operation of every shape and the operations that cover all shapes, and dumps them with the
+    // ranking of all operations next to the output file of metrics
+    void Report(const Metrics &metrics) const;
+
+private:
+    std::vector<SweepShape> shapes_;
+};
+
+} // namespace Catlass
+#endif // CATLASS_TUNER_SHAPE_SWEEP_H
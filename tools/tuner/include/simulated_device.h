@@ -0,0 +1,138 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_TUNER_SIMULATED_DEVICE_H
+#define CATLASS_TUNER_SIMULATED_DEVICE_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include "command_line_parser.h"
+#include "device_backend.h"
+
+namespace Catlass {
+
+// Figures of a modelled soc, approximate, only the ranking of operations is meant to follow the hardware
+struct SimulatedDeviceSpec {
+    std::string socName;
+    uint32_t aicCoreNum{0};
+    uint32_t aicoreFreq{0};     // MHz
+    double hbmBandwidth{0};     // GB/s
+    uint64_t l2Size{0};         // bytes
+};
+
+// Device modelled on the host. Memory is an address range that is never touched, a launch returns at once and
+// appends the start and end records of a task to the profile channel, its duration taken from a roofline of the
+// operation description and the problem shape. Nothing of ACL or the driver is called.
+class SimulatedDevice : public DeviceBackend {
+public:
+    // ticks per millisecond of the timestamps of the records
+    static constexpr int64_t AICPU_FREQ = 50000;
+
+    // every duration is multiplied by scale, a slower or faster device of the same soc
+    explicit SimulatedDevice(const SimulatedDeviceSpec &spec, double noise = 0, uint32_t seed = 0, double scale = 1);
+    ~SimulatedDevice() override = default;
+
+    static bool GetSpec(std::string_view socName, SimulatedDeviceSpec &spec);
+    // device deviceId of --simulate=<soc>, with relative noise --simulate_noise on every duration, and durations
+    // (1 + deviceId * --simulate_skew) times the modelled ones
+    static std::shared_ptr<SimulatedDevice> Create(CommandLineParser &parser, int32_t deviceId = 0);
+
+    // modelled task duration in us of op for the problem of config, 0 if the operation is not modelled
+    double EstimateDuration(const Library::OperationDescription &desp, const void *config) const;
+
+    inline const SimulatedDeviceSpec& GetSpec() const { return spec_; }
+    inline uint64_t GetTaskNum() const { return taskNum_; }
+    // bytes allocated and not freed yet
+    inline size_t GetMemorySize() const { return memorySize_; }
+    // Malloc calls so far
+    inline uint64_t GetMallocNum() const { return mallocNum_; }
+    // us the modelled tasks took on the device
+    inline double GetDeviceTime() const { return static_cast<double>(clock_ - START_TICK) * 1000 / AICPU_FREQ; }
+
+    aclrtStream Initialize(int32_t deviceId) override;
+    void Finalize(aclrtStream stream, int32_t deviceId) override;
+    const char* GetSocName() override { return spec_.socName.c_str(); }
+    uint32_t GetAicCoreNum() override { return spec_.aicCoreNum; }
+    uint64_t GetFftsAddr() override { return FFTS_ADDR; }
+
+    aclError Malloc(void **addr, size_t size) override;
+    aclError Free(void *addr) override;
+    aclError MemcpyAsync(void *dst, const void *src, size_t size, aclrtMemcpyKind kind,
+                         aclrtStream stream) override;
+    aclError Prefetch(void *addr, size_t size, aclrtStream stream) override;
+    aclError Synchronize(aclrtStream stream, int32_t timeout) override;
+
+    void LaunchCacheClear(uint32_t blockDim, aclrtStream stream, void *buffer, void *tilingSize) override;
+    Status Launch(Library::Operation *op, void *config, aclrtStream stream, uint32_t blockDim,
+                  uint64_t fftsAddr) override;
+
+    ProfileChannel& GetProfileChannel() override { return channel_; }
+
+private:
+    static constexpr uint64_t START_TICK = 1;
+    static constexpr uint64_t FFTS_ADDR = 0x5a5a000;
+
+    // Records of the tasks launched while profiling, read by the read thread of Profiler
+    class Channel : public ProfileChannel {
+    public:
+        explicit Channel(const SimulatedDeviceSpec &spec) : spec_(spec) {}
+
+        void PushTask(uint64_t start, uint64_t end);
+
+        bool Start(int32_t deviceId) override;
+        void Stop(int32_t deviceId) override;
+        int Poll(ProfileChannelInfo *channels, int num, int timeout) override;
+        int Read(const ProfileChannelInfo &channel, char *outBuf, uint32_t bufSize) override;
+        int64_t GetAicpuFreq(int32_t) override { return AICPU_FREQ; }
+        std::pair<int64_t, int32_t> GetAicoreFreq(int32_t) override
+        {
+            return {spec_.aicoreFreq, static_cast<int32_t>(spec_.aicoreFreq)};
+        }
+        bool GetChannelDeviceId(int32_t deviceId, int32_t &channelDeviceId) override
+        {
+            channelDeviceId = deviceId;
+            return true;
+        }
+
+    private:
+        const SimulatedDeviceSpec &spec_;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::vector<char> records_;
+        size_t readPos_{0};
+        int32_t deviceId_{0};
+        uint16_t taskId_{0};
+        bool running_{false};
+    };
+
+    double EstimateGemm(const Library::GemmOperationDescription &desp, uint64_t m, uint64_t n, uint64_t k,
+                        uint64_t groupCount) const;
+    void RunTask(double duration);
+
+    SimulatedDeviceSpec spec_;
+    Channel channel_;
+    std::map<uintptr_t, size_t> allocations_;
+    uintptr_t nextAddr_;
+    size_t memorySize_{0};
+    size_t peakMemorySize_{0};
+    uint64_t mallocNum_{0};
+    std::mt19937 rng_;
+    double noise_;
+    double scale_;
+    uint64_t clock_{START_TICK};
+    uint64_t taskNum_{0};
+};
+
+} // namespace Catlass
+#endif // CATLASS_TUNER_SIMULATED_DEVICE_H
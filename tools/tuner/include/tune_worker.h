@@ -0,0 +1,94 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_TUNER_TUNE_WORKER_H
+#define CATLASS_TUNER_TUNE_WORKER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "device_backend.h"
+#include "device_memory_manager.h"
+#include "metrics.h"
+#include "op_launcher.h"
+#include "profiler.h"
+#include "sampling.h"
+#include "work_stealing_queue.h"
+
+namespace Catlass {
+
+struct TuneTask {
+    std::shared_ptr<OpConfig> opConfig;
+    Library::Operation *op;
+    size_t caseId;
+};
+
+// Tasks of one run, shared by the workers of all devices
+struct TuneSchedule {
+    SamplingPolicy sampling;
+    std::vector<TuneTask> tasks;
+    // tasks run by every worker before the queued ones, they tell the speed of the devices apart
+    std::vector<size_t> calibration;
+    // an operation holds its arguments from Initialize to Run, a calibration task runs on one device at a time
+    std::unique_ptr<std::mutex[]> calibrationLocks;
+    // tasks[queued[i]] is the i-th task of queue
+    std::vector<size_t> queued;
+    std::unique_ptr<WorkStealingQueue> queue;
+};
+
+// Runs operations on one device with its own stream, DeviceMemoryManager, profiling channel and metrics. The
+// device is set up, used and released on the thread that calls Run, ACL binds a device to the calling thread.
+class TuneWorker {
+public:
+    TuneWorker(int32_t deviceId, std::shared_ptr<DeviceBackend> backend)
+        : backend_(std::move(backend)), deviceId_(deviceId) {}
+
+    // runs the calibration tasks, then the tasks popped from the queue of schedule until none is left
+    void Run(TuneSchedule &schedule, size_t worker);
+
+    inline int32_t GetDeviceId() const { return deviceId_; }
+    inline const std::string& GetSocName() const { return socName_; }
+    inline Metrics& GetMetrics() { return metrics_; }
+    // runs of all operations, and the operations stopped early as slower than the best one of their problem
+    inline uint64_t GetRunNum() const { return runNum_; }
+    inline uint64_t GetStoppedNum() const { return stoppedNum_; }
+
+private:
+    struct Problem {
+        // the arguments of a config are allocated on the device, every worker runs on clones of the configs
+        std::shared_ptr<OpConfig> config;
+        // median duration of the fastest operation so far
+        double best{0};
+    };
+
+    bool Initialize();
+    bool RunTask(const TuneTask &task, const SamplingPolicy &policy);
+    OpRunStatus RunOp(OpLauncher &launcher, const SamplingPolicy &policy, double best, SampleStats &stats);
+    OpRunStatus WarmUp(OpLauncher &launcher);
+    // launches runs of the operation, each after clearing L2 cache, and appends their durations to samples
+    OpRunStatus Measure(OpLauncher &launcher, uint32_t runs, std::vector<double> &samples);
+
+    std::shared_ptr<DeviceBackend> backend_;
+    DeviceMemoryManager manager_{};
+    ProfileDataHandler profileHandler_{};
+    Metrics metrics_{};
+    std::unordered_map<const OpConfig*, Problem> problems_;
+    std::string socName_;
+    uint64_t runNum_{0};
+    uint64_t stoppedNum_{0};
+    aclrtStream stream_{nullptr};
+    uint32_t aicCoreNum_{0};
+    int32_t deviceId_;
+};
+
+} // namespace Catlass
+#endif // CATLASS_TUNER_TUNE_WORKER_H
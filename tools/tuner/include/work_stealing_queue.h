@@ -0,0 +1,103 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef CATLASS_TUNER_WORK_STEALING_QUEUE_H
+#define CATLASS_TUNER_WORK_STEALING_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace Catlass {
+
+// Task indices of the device workers. The tasks are split into one contiguous range per worker, a worker pops from
+// the front of its own range and, once it is empty, steals the back half of the largest range left. Neighbouring
+// tasks share their problem buffers, so they mostly stay on one device.
+class WorkStealingQueue {
+public:
+    WorkStealingQueue(size_t workerNum, size_t taskNum)
+        : ranges_(std::make_unique<Range[]>(workerNum)), workerNum_(workerNum)
+    {
+        for (size_t i = 0; i < workerNum; ++i) {
+            ranges_[i].begin = taskNum * i / workerNum;
+            ranges_[i].end = taskNum * (i + 1) / workerNum;
+        }
+    }
+
+    // false once every range is empty
+    bool Pop(size_t worker, size_t &task)
+    {
+        while (true) {
+            {
+                Range &own = ranges_[worker];
+                std::lock_guard<std::mutex> lock(own.mtx);
+                if (own.begin < own.end) {
+                    task = own.begin++;
+                    return true;
+                }
+            }
+            if (!Steal(worker)) {
+                return false;
+            }
+        }
+    }
+
+    inline size_t GetStealNum() const { return stealNum_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Range {
+        std::mutex mtx;
+        size_t begin{0};
+        size_t end{0};
+    };
+
+    bool Steal(size_t worker)
+    {
+        size_t victim = workerNum_;
+        size_t victimSize = 0;
+        for (size_t i = 0; i < workerNum_; ++i) {
+            std::lock_guard<std::mutex> lock(ranges_[i].mtx);
+            if (i != worker && ranges_[i].end - ranges_[i].begin > victimSize) {
+                victim = i;
+                victimSize = ranges_[i].end - ranges_[i].begin;
+            }
+        }
+        if (victim == workerNum_) {
+            return false;
+        }
+        size_t begin;
+        size_t end;
+        {
+            // the range may have shrunk since it was picked, an empty one is simply looked for again
+            Range &range = ranges_[victim];
+            std::lock_guard<std::mutex> lock(range.mtx);
+            end = range.end;
+            // the larger half, a single task left is taken too
+            begin = end - (range.end - range.begin + 1) / 2;
+            range.end = begin;
+        }
+        if (begin < end) {
+            stealNum_.fetch_add(1, std::memory_order_relaxed);
+        }
+        Range &own = ranges_[worker];
+        std::lock_guard<std::mutex> lock(own.mtx);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+
+    std::unique_ptr<Range[]> ranges_;
+    size_t workerNum_;
+    std::atomic<size_t> stealNum_{0};
+};
+
+} // namespace Catlass
+#endif // CATLASS_TUNER_WORK_STEALING_QUEUE_H
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+# ----------------------------------------------------------------------------
+# This program is free software, you can redistribute it and/or modify.
+# Copyright (c) 2025 Huawei Technologies Co., Ltd.
+# This file is a part of the CANN Open Software.
+# Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+# Please refer to the License for details. You may not use this file except in compliance with the License.
+# THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+# See LICENSE in the root of the software repository for the full text of the License.
+# ----------------------------------------------------------------------------
+
+"""
+Search driven tiling tuning with mstuner_catlass.
+
+Instead of instantiating the whole search space of search_space_config.py, every round only the
+candidates proposed by search_space.TileShapeSearch are compiled and profiled, the measured task
+durations guide the next round.
+
+    python3 tools/tuner/scripts/mstuner_search.py --m=256 --n=512 --k=1024 --device=0 --output=search.csv
+
+--synthetic replaces compilation and profiling with search_space.synthetic_matmul_cost, so the
+search loop can be checked without a device.
+
+When search_space_config.py lists several block swizzles, --swizzle-simulator=output/bin/swizzle_simulator
+keeps only the swizzles of each tile shape with the least predicted HBM traffic before the search starts.
+"""
+
+import os
+import sys
+import csv
+import logging
+import argparse
+import subprocess
+
+CATLASS_ROOT = os.path.realpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..'))
+sys.path.append(os.path.join(CATLASS_ROOT, 'tools', 'library', 'scripts'))
+
+import library  # noqa: E402
+import search_space  # noqa: E402
+import search_space_config  # noqa: E402
+from gemm_operation import GemmOperation  # noqa: E402
+
+LOGGER = logging.getLogger(__name__)
+
+
+def get_operation_name(config, candidate):
+    return GemmOperation(
+        kernel_type=config.kernel_type,
+        l1_tile_shape=candidate.l1_tile_shape,
+        l0_tile_shape=candidate.l0_tile_shape,
+        a_type=library.GemmTypeDescription(config.data_type_a, config.layout_a),
+        b_type=library.GemmTypeDescription(config.data_type_b, config.layout_b),
+        c_type=library.GemmTypeDescription(config.data_type_c, config.layout_c),
+        block_swizzle=candidate.block_swizzle,
+    ).get_name()
+
+
+class MsTunerEvaluator:
+    """Compile the candidates of one round into libcatlass_kernels.so and profile them with mstuner_catlass."""
+
+    def __init__(self, config, args, extra_args):
+        self.config = config
+        self.args = args
+        self.extra_args = extra_args
+        self.round_idx = 0
+        os.makedirs(args.work_dir, exist_ok=True)
+
+    def __call__(self, candidates):
+        candidates_file = os.path.join(self.args.work_dir, f'round_{self.round_idx}.json')
+        csv_file = os.path.join(self.args.work_dir, f'round_{self.round_idx}.csv')
+        self.round_idx += 1
+        search_space.save_search_candidates(candidates_file, self.config, candidates)
+
+        build_cmd = [
+            'bash', os.path.join(CATLASS_ROOT, 'scripts', 'build.sh'),
+            f'-DCATLASS_LIBRARY_KERNELS={self.config.kernel_type}',
+            f'-DCATLASS_LIBRARY_SEARCH_CANDIDATES={candidates_file}',
+            'mstuner_catlass'
+        ]
+        result = subprocess.run(build_cmd, cwd=CATLASS_ROOT, capture_output=True, text=True)
+        if result.returncode != 0:
+            LOGGER.error(f'build of round {self.round_idx - 1} failed: {result.stderr}')
+            return {}
+
+        env = dict(os.environ)
+        lib_path = os.path.join(CATLASS_ROOT, 'output', 'lib64')
+        env['LD_LIBRARY_PATH'] = lib_path + (':' + env['LD_LIBRARY_PATH'] if 'LD_LIBRARY_PATH' in env else '')
+        mstuner_cmd = [
+            os.path.join(CATLASS_ROOT, 'output', 'bin', 'mstuner_catlass'),
+            f'--m={self.args.m}', f'--n={self.args.n}', f'--k={self.args.k}',
+            f'--device={self.args.device}', f'--kernels={self.config.kernel_type}', f'--output={csv_file}'
+        ] + self.extra_args
+        result = subprocess.run(mstuner_cmd, env=env, capture_output=True, text=True)
+        if result.returncode != 0 or not os.path.exists(csv_file):
+            LOGGER.error(f'mstuner_catlass of round {self.round_idx - 1} failed: {result.stderr}')
+            return {}
+
+        names = {get_operation_name(self.config, candidate): candidate for candidate in candidates}
+        costs = {}
+        with open(csv_file, newline='') as f:
+            for row in csv.DictReader(f):
+                candidate = names.get(row.get('description'))
+                if candidate is not None:
+                    costs[candidate] = float(row['task_duration(us)'])
+        return costs
+
+
+def main():
+    parser = argparse.ArgumentParser(description='search driven tiling tuning with mstuner_catlass')
+    parser.add_argument('--m', type=int, default=256)
+    parser.add_argument('--n', type=int, default=512)
+    parser.add_argument('--k', type=int, default=1024)
+    parser.add_argument('--device', type=int, default=0)
+    parser.add_argument('--strategy', choices=('surrogate', 'evolution'), default='surrogate')
+    parser.add_argument('--population-size', type=int, default=16, help='candidates of the first round')
+    parser.add_argument('--batch-size', type=int, default=8, help='candidates of the following rounds')
+    parser.add_argument('--max-rounds', type=int, default=20)
+    parser.add_argument('--patience', type=int, default=4, help='stop after rounds without improvement')
+    parser.add_argument('--seed', type=int, default=0)
+    parser.add_argument('--work-dir', default=os.path.join(CATLASS_ROOT, 'build', 'mstuner_search'))
+    parser.add_argument('--output', default='', help='csv file of all evaluated candidates')
+    parser.add_argument('--synthetic', action='store_true', help='score candidates with a synthetic cost')
+    parser.add_argument('--swizzle-simulator', default='', help='path of swizzle_simulator to prune block swizzles')
+    parser.add_argument('--swizzles-per-tile', type=int, default=2, help='block swizzles kept per tile shape')
+    logging.basicConfig(level=logging.INFO)
+    # unknown arguments, e.g. --A=fp16:row, are passed to mstuner_catlass
+    args, extra_args = parser.parse_known_args()
+
+    config = search_space_config.get_configuration()
+    candidates = search_space.generate_search_candidates(config)
+    LOGGER.info(f'{config.kernel_type} search space size={len(candidates)}')
+    if args.swizzle_simulator:
+        simulator = search_space.SwizzleSimulator(args.swizzle_simulator, args.m, args.n, args.k, config)
+        candidates = search_space.prune_block_swizzles(candidates, simulator, keep=args.swizzles_per_tile)
+    search = search_space.TileShapeSearch(
+        candidates,
+        strategy=args.strategy,
+        population_size=args.population_size,
+        batch_size=args.batch_size,
+        seed=args.seed,
+    )
+
+    if args.synthetic:
+        cost = search_space.synthetic_matmul_cost(args.m, args.n, args.k)
+
+        def evaluate(batch):
+            return {candidate: cost(candidate) for candidate in batch}
+    else:
+        evaluate = MsTunerEvaluator(config, args, extra_args)
+
+    best, best_cost = search_space.run_tile_search(search, evaluate, args.max_rounds, args.patience)
+    if best is None:
+        LOGGER.error('no candidate was evaluated successfully')
+        return 1
+    LOGGER.info(f'evaluated {len(search.observed)} of {len(candidates)} candidates')
+    LOGGER.info(f'best: {get_operation_name(config, best)} task_duration(us)={best_cost:.3f}')
+
+    if args.output:
+        with open(args.output, 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(['round_order', 'task_duration(us)', 'description', 'm', 'n', 'k'])
+            for order, candidate in enumerate(search.history):
+                writer.writerow([order, f'{search.observed[candidate]:.3f}',
+                                 get_operation_name(config, candidate), args.m, args.n, args.k])
+        LOGGER.info(f'save search result to {args.output}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,350 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include "device_backend.h"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+#include <runtime/dev.h>
+#include <runtime/rt_ffts.h>
+#include "log.h"
+
+#include "tiling/platform/platform_ascendc.h"
+
+namespace {
+constexpr uint32_t STARS_ENABLE_FLAG = 1;
+constexpr uint32_t PROF_CFG_PERIOD = 0;
+constexpr uint32_t PROF_REAL = 1;
+
+enum class PROF_CHANNEL_TYPE {
+    PROF_TS_TYPE,
+    PROF_PERIPHERAL_TYPE,
+    PROF_CHANNEL_TYPE_MAX,
+};
+
+using ProfStartParaT = struct prof_start_para {
+    PROF_CHANNEL_TYPE channelType;
+    uint32_t samplePeriod;
+    uint32_t realTime;
+    void *userData;
+    uint32_t userDataSize;
+};
+
+// ts data code
+using StarsSocLogConfigT = struct TagStarsSocLogConfig {
+    uint32_t acsqTask;         // 1-enable,2-disable
+    uint32_t accPmu;           // 1-enable,2-disable
+    uint32_t cdqmReg;          // 1-enable,2-disable
+    uint32_t dvppVpcBlock;     // 1-enable,2-disable
+    uint32_t dvppJpegdBlock;   // 1-enable,2-disable
+    uint32_t dvppJpedeBlock;   // 1-enable,2-disable
+    uint32_t fftsThreadTask;   // 1-enable,2-disable
+    uint32_t fftsBlock;        // 1-enable,2-disable
+    uint32_t sdmaDmu;          // 1-enable,2-disable
+};
+
+using ProfPollInfoT = struct prof_poll_info {
+    uint32_t deviceId;
+    uint32_t channelId;
+};
+
+constexpr uint32_t CHANNEL_STARS_SOC_LOG_BUFFER = 50;   /* add for ascend910B */
+
+bool GetStarsTask(ProfStartParaT &starsProfStartPara)
+{
+    uint32_t starsConfigSize = sizeof(StarsSocLogConfigT);
+    auto *starsConfigPtr = static_cast<StarsSocLogConfigT *>(malloc(starsConfigSize));
+    starsProfStartPara.userData = nullptr;
+    if (starsConfigPtr == nullptr) {
+        LOGE("Can not get user data pointer while getting stars task");
+        return false;
+    }
+    std::fill_n(reinterpret_cast<uint8_t *>(starsConfigPtr), starsConfigSize, 0);
+
+    starsConfigPtr->acsqTask = STARS_ENABLE_FLAG;
+    starsConfigPtr->fftsThreadTask = STARS_ENABLE_FLAG;
+    starsConfigPtr->accPmu = STARS_ENABLE_FLAG;
+
+    starsProfStartPara.channelType = PROF_CHANNEL_TYPE::PROF_TS_TYPE;
+    starsProfStartPara.samplePeriod = PROF_CFG_PERIOD;
+    starsProfStartPara.realTime = PROF_REAL;
+    starsProfStartPara.userData = starsConfigPtr;
+    starsProfStartPara.userDataSize = starsConfigSize;
+    return true;
+}
+}
+
+extern "C" {
+int prof_drv_start(unsigned int deviceId, unsigned int channelId, struct prof_start_para *startPara);
+int prof_channel_read(unsigned int deviceId, unsigned int channelId, char *outBuf, unsigned int bufSize);
+int prof_stop(unsigned int deviceId, unsigned int channelId);
+int prof_channel_poll(struct prof_poll_info *outBuf, int num, int timeout);
+int halGetDeviceInfo(uint32_t devId, int32_t moduleType, int32_t infoType, int64_t *value);
+int halGetDeviceInfoByBuff(uint32_t deviceId, int32_t aicoreType, int32_t frequeType, void* freq, int32_t* size);
+}
+
+namespace Catlass {
+
+void DoClearL2Cache(uint32_t blockDim, uint8_t* l2ctrl, uint8_t* stream, uint8_t* buffer, uint8_t* tilingSize);
+
+namespace {
+
+// The stars soc log channel of the driver
+class DriverProfileChannel : public ProfileChannel {
+public:
+    bool Start(int32_t deviceId) override
+    {
+        ProfStartParaT starsProfStartPara;
+        if (!GetStarsTask(starsProfStartPara)) {
+            LOGE("Set stars task data failed.");
+            return false;
+        }
+        int drvRes = prof_drv_start(deviceId, CHANNEL_STARS_SOC_LOG_BUFFER, &starsProfStartPara);
+        free(starsProfStartPara.userData);
+        if (drvRes != 0) {
+            LOGE("Start channel %u failed", CHANNEL_STARS_SOC_LOG_BUFFER);
+            return false;
+        }
+        deviceId_ = deviceId;
+        return true;
+    }
+
+    void Stop(int32_t deviceId) override
+    {
+        int drvRes = prof_stop(deviceId, CHANNEL_STARS_SOC_LOG_BUFFER);
+        if (drvRes != 0) {
+            LOGE("Channel %u prof_stop failed, %d", CHANNEL_STARS_SOC_LOG_BUFFER, drvRes);
+        }
+    }
+
+    // the driver polls the channels of all devices, those of the other device workers are left to them
+    int Poll(ProfileChannelInfo *channels, int num, int timeout) override
+    {
+        std::vector<ProfPollInfoT> polled(std::max(num, 0));
+        int ret = prof_channel_poll(polled.data(), num, timeout);
+        int own = 0;
+        for (int i = 0; i < ret && i < num; ++i) {
+            if (static_cast<int32_t>(polled[i].deviceId) == deviceId_) {
+                channels[own++] = {polled[i].deviceId, polled[i].channelId};
+            }
+        }
+        return ret < 0 ? ret : own;
+    }
+
+    int Read(const ProfileChannelInfo &channel, char *outBuf, uint32_t bufSize) override
+    {
+        return prof_channel_read(channel.deviceId, channel.channelId, outBuf, bufSize);
+    }
+
+    int64_t GetAicpuFreq(int32_t deviceId) override
+    {
+        constexpr int32_t MODULE_TYPE_SYSTEM = 0;
+        constexpr int32_t INFO_TYPE_DEV_OSC_FREQUE = 25;
+        int64_t freq = 0;
+        int ret = halGetDeviceInfo(deviceId, MODULE_TYPE_SYSTEM, INFO_TYPE_DEV_OSC_FREQUE, &freq);
+        return ret == 0 ? freq : 0;
+    }
+
+    std::pair<int64_t, int32_t> GetAicoreFreq(int32_t deviceId) override
+    {
+        constexpr int32_t MODULE_TYPE_AICORE = 4;
+        constexpr int32_t INFO_TYPE_FREQUE = 4;
+        constexpr int32_t INFO_TYPE_CURRENT_FREQ = 32;
+        if (ratedFreq_ == 0) {
+            // get rated freq
+            auto ret = halGetDeviceInfo(deviceId, MODULE_TYPE_AICORE, INFO_TYPE_FREQUE, &ratedFreq_);
+            if (ret != 0) {
+                LOGW("Get device rated freq failed, ret %d", ret);
+                ratedFreq_ = 0;
+            }
+        }
+        // get current freq
+        int32_t curFreq;
+        int32_t size = sizeof(int32_t);
+        auto ret = halGetDeviceInfoByBuff(deviceId, MODULE_TYPE_AICORE, INFO_TYPE_CURRENT_FREQ,
+                                          static_cast<void*>(&curFreq), &size);
+        if (ret != 0) {
+            LOGW("Get device current freq failed, ret %d", ret);
+            curFreq = 0;
+        }
+        return {ratedFreq_, curFreq};
+    }
+
+    bool GetChannelDeviceId(int32_t deviceId, int32_t &channelDeviceId) override
+    {
+        constexpr char const *VIS = "ASCEND_RT_VISIBLE_DEVICES";
+        channelDeviceId = deviceId;
+        if (getenv(VIS)) {
+            auto error = rtGetVisibleDeviceIdByLogicDeviceId(deviceId, &channelDeviceId);
+            if (error != RT_ERROR_NONE) {
+                LOGE("Call rtGetVisibleDeviceIdByLogicDeviceId failed, error: %d. Please disable %s or try again.",
+                     error, VIS);
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    int64_t ratedFreq_{0};
+    int32_t deviceId_{-1};
+};
+
+class AclBackend : public DeviceBackend {
+public:
+    aclrtStream Initialize(int32_t deviceId) override
+    {
+        if (!AclInit()) {
+            return nullptr;
+        }
+        aclError err = aclrtSetDevice(deviceId);
+        if (err != ACL_SUCCESS) {
+            LOGE("Call aclrtSetDevice failed: %d, device id: %d", err, deviceId);
+            AclFinalize();
+            return nullptr;
+        }
+        aclrtStream stream = nullptr;
+        err = aclrtCreateStream(&stream);
+        if (err != ACL_SUCCESS) {
+            LOGE("Call aclrtCreateStream failed: %d", err);
+            AclFinalize();
+            return nullptr;
+        }
+        initialized_ = true;
+        return stream;
+    }
+
+    void Finalize(aclrtStream stream, int32_t deviceId) override
+    {
+        aclError err = aclrtDestroyStream(stream);
+        if (err != ACL_SUCCESS) {
+            LOGE("Call aclrtDestroyStream failed: %d", err);
+        }
+        err = aclrtResetDevice(deviceId);
+        if (err != ACL_SUCCESS) {
+            LOGE("Call aclrtResetDevice failed: %d", err);
+        }
+        if (initialized_) {
+            AclFinalize();
+            initialized_ = false;
+        }
+    }
+
+    const char* GetSocName() override
+    {
+        return aclrtGetSocName();
+    }
+
+    uint32_t GetAicCoreNum() override
+    {
+        return platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
+    }
+
+    uint64_t GetFftsAddr() override
+    {
+        uint64_t fftsAddr{0};
+        uint32_t fftsLen{0};
+        rtError_t error = rtGetC2cCtrlAddr(&fftsAddr, &fftsLen);
+        if (error != RT_ERROR_NONE) {
+            LOGE("Call rtGetC2cCtrlAddr failed, rtError: %d", error);
+            return 0;
+        }
+        return fftsAddr;
+    }
+
+    aclError Malloc(void **addr, size_t size) override
+    {
+        return aclrtMalloc(addr, size, ACL_MEM_MALLOC_HUGE_FIRST);
+    }
+
+    aclError Free(void *addr) override
+    {
+        return aclrtFree(addr);
+    }
+
+    aclError MemcpyAsync(void *dst, const void *src, size_t size, aclrtMemcpyKind kind, aclrtStream stream) override
+    {
+        return aclrtMemcpyAsync(dst, size, src, size, kind, stream);
+    }
+
+    aclError Prefetch(void *addr, size_t size, aclrtStream stream) override
+    {
+        return aclrtCmoAsync(addr, size, ACL_RT_CMO_TYPE_PREFETCH, stream);
+    }
+
+    aclError Synchronize(aclrtStream stream, int32_t timeout) override
+    {
+        if (timeout < 0) {
+            return aclrtSynchronizeStream(stream);
+        }
+        return aclrtSynchronizeStreamWithTimeout(stream, timeout);
+    }
+
+    void LaunchCacheClear(uint32_t blockDim, aclrtStream stream, void *buffer, void *tilingSize) override
+    {
+        DoClearL2Cache(blockDim, nullptr, reinterpret_cast<uint8_t*>(stream), reinterpret_cast<uint8_t*>(buffer),
+                       reinterpret_cast<uint8_t*>(tilingSize));
+    }
+
+    Status Launch(Library::Operation *op, void *config, aclrtStream stream, uint32_t blockDim,
+                  uint64_t fftsAddr) override
+    {
+        (void)config;
+        return op->Run(stream, blockDim, fftsAddr);
+    }
+
+    ProfileChannel& GetProfileChannel() override
+    {
+        return profileChannel_;
+    }
+
+private:
+    // ACL is initialized once per process, the backends of all devices share it
+    static bool AclInit()
+    {
+        std::lock_guard<std::mutex> lock(aclMtx_);
+        if (aclUsers_ == 0) {
+            aclError err = aclInit(nullptr);
+            if (err != ACL_SUCCESS) {
+                LOGE("Call aclInit failed: %d", err);
+                return false;
+            }
+        }
+        ++aclUsers_;
+        return true;
+    }
+
+    static void AclFinalize()
+    {
+        std::lock_guard<std::mutex> lock(aclMtx_);
+        if (--aclUsers_ > 0) {
+            return;
+        }
+        aclError err = aclFinalize();
+        if (err != ACL_SUCCESS) {
+            LOGE("Call aclFinalize failed: %d", err);
+        }
+    }
+
+    static inline std::mutex aclMtx_;
+    static inline uint32_t aclUsers_{0};
+
+    DriverProfileChannel profileChannel_{};
+    bool initialized_{false};
+};
+} // namespace
+
+std::shared_ptr<DeviceBackend> CreateAclBackend()
+{
+    return std::make_shared<AclBackend>();
+}
+
+} // namespace Catlass
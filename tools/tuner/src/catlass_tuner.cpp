@@ -9,29 +9,26 @@
  */
  
 #include "catlass_tuner.h"
-#include "m_t_var.h"
 
-#include "tiling/platform/platform_ascendc.h"
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "m_t_var.h"
 
 namespace Catlass {
 
-static constexpr int RUN_TIMES = 5;
+// operations run on every device to correct the durations of the others
+static constexpr size_t CALIBRATION_NUM = 4;
 
-CatlassTuner::CatlassTuner(CommandLineParser parser) : parser_(std::move(parser))
+CatlassTuner::CatlassTuner(CommandLineParser parser, const DeviceBackendFactory &createBackend)
+    : parser_(std::move(parser))
 {
-    if (parser_.HasKey("device")) {
-        deviceId_ = -1;
-        GET_CHECK(parser_.Get<decltype(deviceId_)>("device", deviceId_), "device");
-        if (deviceId_ == -1) {
-            return;
-        }
-        metrics_.SetDeviceId(deviceId_);
-    }
-    // 调优通道需要做device id映射
-    if (!profileHandler_.SetDeviceId(deviceId_)) {
+    std::vector<int32_t> deviceIds;
+    if (!ParseDevices(deviceIds) || !sampling_.Parse(parser_) || !ParseShapes()) {
         return;
     }
-
     if (parser_.HasKey("output")) {
         std::string_view output;
         GET_CHECK(parser_.Get<std::string_view>("output", output), "output");
@@ -39,19 +36,97 @@ CatlassTuner::CatlassTuner(CommandLineParser parser) : parser_(std::move(parser)
             return;
         }
     }
-    if (!profileHandler_.Init()) {
-        LOGE("Start profile channel failed, will not run operators");
-        return;
-    } else if (stream_ = DeviceMemoryManager::Instance().Initialize(deviceId_); !stream_) {
-        LOGE("Initialize device failed, will not run kernels");
-    } else if (!DeviceMemoryManager::Instance().InitCacheClear()) {
-        LOGW("Init resource for clear l2cache failed, won't clear l2cache before each kernel");
+    if (parser_.HasKey("tuning_db")) {
+        std::string_view tuningDb;
+        GET_CHECK(parser_.Get<std::string_view>("tuning_db", tuningDb), "tuning_db");
+        if (tuningDb.empty() || !metrics_.SetTuningDbPath(tuningDb)) {
+            return;
+        }
+    }
+    for (auto deviceId : deviceIds) {
+        auto backend = createBackend(parser_, deviceId);
+        if (!backend) {
+            LOGE("No device %d to run operators on", deviceId);
+            workers_.clear();
+            return;
+        }
+        workers_.emplace_back(std::make_unique<TuneWorker>(deviceId, std::move(backend)));
     }
 }
 
-CatlassTuner::~CatlassTuner()
+// --device=0, or a list of devices to tune on in parallel, --device=0,1,2,3
+bool CatlassTuner::ParseDevices(std::vector<int32_t> &deviceIds)
 {
-    DeviceMemoryManager::Instance().Finalize();
+    deviceIds = {0};
+    if (!parser_.HasKey("device")) {
+        return true;
+    }
+    std::string_view devices;
+    GET_CHECK(parser_.Get<std::string_view>("device", devices), "device");
+    deviceIds.clear();
+    for (size_t begin = 0; begin <= devices.size();) {
+        size_t end = std::min(devices.find(',', begin), devices.size());
+        auto id = devices.substr(begin, end - begin);
+        constexpr size_t MAX_DIGITS = 9;
+        bool valid = !id.empty() && id.size() <= MAX_DIGITS &&
+            std::all_of(id.begin(), id.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+        int32_t deviceId = valid ? std::stoi(std::string(id)) : -1;
+        if (!valid || std::find(deviceIds.begin(), deviceIds.end(), deviceId) != deviceIds.end()) {
+            LOGE("--device should be a device id or a list of different device ids, e.g. --device=0,1,2,3");
+            return false;
+        }
+        deviceIds.emplace_back(deviceId);
+        begin = end + 1;
+    }
+    return true;
+}
+
+// --shapes=<file> tunes every operation on the shapes listed in the file instead of --m --n --k
+bool CatlassTuner::ParseShapes()
+{
+    if (!parser_.HasKey("shapes")) {
+        return true;
+    }
+    std::string_view path;
+    GET_CHECK(parser_.Get<std::string_view>("shapes", path), "shapes");
+    if (path.empty() || !sweep_.Load(path)) {
+        return false;
+    }
+    if (parser_.HasKey("m") || parser_.HasKey("n") || parser_.HasKey("k")) {
+        LOGW("--m --n --k are ignored, the shapes of --shapes are tuned");
+    }
+    return true;
+}
+
+// Only register the kinds --kernels can match, kernel names are those of the operation descriptions.
+bool CatlassTuner::InitManifest(std::string_view kernel)
+{
+    static constexpr std::pair<std::string_view, Library::GemmKind> KERNEL_KINDS[] = {
+        {"basic_matmul", Library::GemmKind::BasicMatmul},
+        {"grouped_matmul", Library::GemmKind::GroupedMatmul},
+    };
+    auto start = std::chrono::steady_clock::now();
+    bool matched = false;
+    for (auto &[name, gemmKind] : KERNEL_KINDS) {
+        if (kernel.empty() || (name.find(kernel) == std::string_view::npos &&
+            kernel.find(name) == std::string_view::npos)) {
+            continue;
+        }
+        matched = true;
+        if (manifest_.Initialize(gemmKind) != Status::kSuccess) {
+            LOGE("Initialize operator manifest failed");
+            return false;
+        }
+    }
+    // --kernels only matches dtypes or tile shapes, e.g. fp16 or 128x256x256
+    if (!matched && manifest_.Initialize() != Status::kSuccess) {
+        LOGE("Initialize operator manifest failed");
+        return false;
+    }
+    auto end = std::chrono::steady_clock::now();
+    LOGI("Registered %lu operations in %.3f ms", manifest_.GetOperations().size(),
+        std::chrono::duration<double, std::milli>(end - start).count());
+    return true;
 }
 
 bool CatlassTuner::InitOperators(OpConfigPool &pool)
@@ -67,6 +142,9 @@ bool CatlassTuner::InitOperators(OpConfigPool &pool)
             }
         }
     }
+    if (!InitManifest(kernel)) {
+        return false;
+    }
 
     for (auto op : manifest_.GetOperations()) {
         if (!pool.Register(op, parser_, kernel)) {
@@ -83,139 +161,105 @@ bool CatlassTuner::InitOperators(OpConfigPool &pool)
     return true;
 }
 
-void CatlassTuner::Run()
+// Tasks are numbered in the order of the pool, as a single device would run them. With several devices a few tasks
+// spread over the pool run on every device, the others are split among the devices. A sweep repeats the pool for
+// every shape, largest first, so the buffers allocated for the first shape are reused by all later ones.
+void CatlassTuner::InitSchedule(OpConfigPool &pool, TuneSchedule &schedule)
 {
-    if (!stream_) {
-        return;
-    }
-
-    OpConfigPool pool;
-    if (manifest_.Initialize() != Status::kSuccess) {
-        LOGE("Initialize operator manifest failed");
-        return;
-    } else if (!InitOperators(pool)) {
-        return;
-    }
-
-    parser_.PrintUnusedKeys();
-    // Get the number of cube cores of the current hardware
-    uint32_t aicCoreNum = platform_ascendc::PlatformAscendCManager::GetInstance()->GetCoreNumAic();
-    for (auto &p : pool.GetPool()) {
-        auto &opConfig = p.first;
-        if (!opConfig || opConfig->Invalid()) {
-            continue;
-        }
-        for (auto op : p.second) {
-            metrics_.Add(opConfig, op);
-            auto stat = RunOp(opConfig, op, aicCoreNum);
-            UpdateMetrics();
-            if (stat != OpRunStatus::FATAL) {
+    schedule.sampling = sampling_;
+    auto addTasks = [&](const std::optional<SweepShape> &shape) {
+        for (auto &p : pool.GetPool()) {
+            auto opConfig = p.first;
+            if (!opConfig || opConfig->Invalid()) {
                 continue;
             }
-            LOGE("Running kernel %s failed, try restart profiling", op->GetDescription().name);
-            Synchronize();
-            if (!profileHandler_.Init()) {
-                LOGE("Restart profiling failed, end subsequent operator execution.");
-                break;
+            if (shape && !(opConfig = opConfig->ForShape(shape->m, shape->n, shape->k))) {
+                continue;
             }
-        }
-    }
-    Synchronize();
-    metrics_.Dump();
-}
-
-OpRunStatus CatlassTuner::RunOp(const std::shared_ptr<OpConfig>& opConfig, Library::Operation *op, uint32_t aicCoreNum)
-{
-    std::vector<KernelType> kernels;
-    std::shared_ptr<void> defer(nullptr, [&](void*) {
-        // all kernel type ran by current operator
-        kernelsQueue_.emplace(kernels);
-    });
-    OpLauncher launcher(opConfig, op, aicCoreNum);
-    if (launcher.Init() != OpRunStatus::SUCCESS) {
-        LOGE("Initialize operator %s failed", op->GetDescription().name);
-        return OpRunStatus::FAILED;
-    }
-    auto freq = profileHandler_.GetAicoreFreq();
-    if (freq.first > freq.second) {
-        LOGW("Current freq %d is lower than rated freq %ld, run warm up", freq.second, freq.first);
-        constexpr int TIMEOUT = 10;
-        for (int i = 0; i < TIMEOUT && freq.first > freq.second; ++i) {
-            constexpr size_t WARM_UP_TIMES = 10;
-            auto stat = launcher(stream_, WARM_UP_TIMES, false);
-            std::vector<KernelType> tmp(WARM_UP_TIMES, KernelType::OPERATOR);
-            kernels.insert(kernels.end(), tmp.begin(), tmp.end());
-            auto err = aclrtSynchronizeStream(stream_);
-            if (stat != OpRunStatus::SUCCESS || err != ACL_SUCCESS) {
-                LOGE("Warm up failed, aclrtSynchronizeStream ret: %d", err);
-                return OpRunStatus::FATAL;
+            for (auto op : p.second) {
+                schedule.tasks.push_back({opConfig, op, schedule.tasks.size() + 1});
             }
-            freq = profileHandler_.GetAicoreFreq();
         }
-        LOGI("Warm up finished, rated freq %ld, current freq %d", freq.first, freq.second);
+    };
+    if (sweep_.GetShapes().empty()) {
+        addTasks(std::nullopt);
     }
-    OpRunStatus stat = OpRunStatus::SUCCESS;
-    for (int i = 0; i < RUN_TIMES; ++i) {
-        if (DeviceMemoryManager::Instance().ClearL2Cache(aicCoreNum)) {
-            kernels.emplace_back(KernelType::CACHE_CLEAR);
-        }
-        stat = launcher(stream_);
-        kernels.emplace_back(KernelType::OPERATOR);
-        if (stat != OpRunStatus::SUCCESS) {
-            break;
+    for (auto &shape : sweep_.GetShapes()) {
+        addTasks(shape);
+    }
+    size_t taskNum = schedule.tasks.size();
+    size_t calibrationNum = workers_.size() > 1 ? std::min(CALIBRATION_NUM, taskNum) : 0;
+    for (size_t i = 0; i < calibrationNum; ++i) {
+        schedule.calibration.emplace_back(taskNum * i / calibrationNum);
+    }
+    for (size_t i = 0, c = 0; i < taskNum; ++i) {
+        if (c < calibrationNum && schedule.calibration[c] == i) {
+            ++c;
+        } else {
+            schedule.queued.emplace_back(i);
         }
     }
-    return stat;
+    schedule.calibrationLocks = std::make_unique<std::mutex[]>(calibrationNum);
+    schedule.queue = std::make_unique<WorkStealingQueue>(workers_.size(), schedule.queued.size());
 }
 
-void CatlassTuner::UpdateMetrics(bool readAll)
+void CatlassTuner::Run()
 {
-    auto tmp = profileHandler_.GetDurations();
-    durations_.insert(durations_.end(), tmp.begin(), tmp.end());
-    if (durations_.empty()) {
+    if (workers_.empty()) {
         return;
     }
-    size_t i = 0;
-    auto setDuration = [&](const std::vector<KernelType> &kernel) {
-        double time = 0;
-        size_t end = std::min(kernel.size(), std::max(durations_.size(), i) - i);
-        for (size_t j = 0; j < end; ++j) {
-            if (kernel[j] == KernelType::OPERATOR) {
-                // use task duration from the last execution,
-                // but the collected durations also includes warm up operators and ClearL2Cache
-                time = durations_[i + j];
-            }
-        }
-        metrics_.SetDurationAndPrint(time);
-        i += end;
-    };
 
-    while (!kernelsQueue_.empty() && durations_.size() >= kernelsQueue_.front().size() + i) {
-        auto kernel = std::move(kernelsQueue_.front());
-        kernelsQueue_.pop();
-        setDuration(kernel);
-    }
-    Erase(durations_, i);
-    i = 0;
-    if (!readAll) {
+    OpConfigPool pool;
+    if (!InitOperators(pool)) {
         return;
     }
 
-    while (!kernelsQueue_.empty()) {
-        auto kernel = std::move(kernelsQueue_.front());
-        kernelsQueue_.pop();
-        if (durations_.size() < kernel.size() + i + 1) {
-            LOGW("This operator's kernel run times are more than profile data collected");
+    parser_.PrintUnusedKeys();
+    TuneSchedule schedule;
+    InitSchedule(pool, schedule);
+    auto start = std::chrono::steady_clock::now();
+    if (workers_.size() == 1) {
+        workers_.front()->Run(schedule, 0);
+    } else {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            threads.emplace_back([&, i]() { workers_[i]->Run(schedule, i); });
+        }
+        for (auto &t : threads) {
+            t.join();
         }
-        setDuration(kernel);
+        auto end = std::chrono::steady_clock::now();
+        LOGI("Ran %lu operations on %lu devices in %.3f s, %lu ranges stolen", schedule.tasks.size(),
+            workers_.size(), std::chrono::duration<double>(end - start).count(), schedule.queue->GetStealNum());
     }
-    durations_.clear();
-}
 
-void CatlassTuner::Synchronize()
-{
-    profileHandler_.Synchronize();
-    UpdateMetrics(true);
+    std::vector<Metrics*> parts;
+    std::string socName;
+    uint64_t runNum = 0;
+    uint64_t stoppedNum = 0;
+    for (auto &worker : workers_) {
+        parts.emplace_back(&worker->GetMetrics());
+        socName = socName.empty() ? worker->GetSocName() : socName;
+        runNum += worker->GetRunNum();
+        stoppedNum += worker->GetStoppedNum();
+    }
+    LOGI("Ran %lu operations %lu times, %lu stopped early, at most %u runs each", schedule.tasks.size(), runNum,
+        stoppedNum, sampling_.maxRuns);
+    std::vector<size_t> calibration;
+    for (auto i : schedule.calibration) {
+        calibration.emplace_back(schedule.tasks[i].caseId);
+    }
+    metrics_.Merge(parts, calibration);
+    // records of the tuning database are only reused on the same soc
+    if (!socName.empty()) {
+        metrics_.SetDeviceName(socName);
+    } else {
+        LOGW("Get soc name failed, records of tuning database will have no device name");
+    }
+    metrics_.Dump();
+    if (!sweep_.GetShapes().empty()) {
+        sweep_.Report(metrics_);
+    }
 }
 
 } // namespace Catlass
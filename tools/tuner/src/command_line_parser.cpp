@@ -228,13 +228,30 @@ void CommandLineParser::PrintHelp() const
     LOGM("Options:");
     LOGM("   --help, -h                           <Optional> Help message.");
     LOGM("   --output=<string>                    <Optional> Path to output file containing profiling data.");
-    LOGM("   --device=<int>                       <Optional> Device id, a positive integer, default: 0.");
+    LOGM("   --tuning_db=<string>                 <Optional> Path to tuning database, the fastest operation of "
+         "each shape bucket is merged into it.");
+    LOGM("   --device=<int list>                  <Optional> Device id, a positive integer, default: 0. "
+         "A list such as 0,1,2,3 tunes on the devices in parallel.");
+    LOGM("   --simulate=<string>                  <Optional> Run on a device of the soc simulated on the host instead "
+         "of a real device, e.g. Ascend910B4.");
+    LOGM("   --simulate_noise=<float>             <Optional> Relative noise of the simulated durations, default: 0.");
+    LOGM("   --simulate_skew=<float>              <Optional> Simulated device i runs (1 + i * skew) times the modelled "
+         "durations, default: 0.");
+    LOGM("   --min_runs=<int>                     <Optional> Runs of an operation before its duration is judged, "
+         "default: 3.");
+    LOGM("   --max_runs=<int>                     <Optional> Most runs of an operation, default: 50.");
+    LOGM("   --ci=<float>                         <Optional> An operation stops once the 95%% confidence interval "
+         "of its duration is within this ratio of it, default: 0.01.");
+    LOGM("   --early_stop=<bool>                  <Optional> Stop an operation once it is surely slower than the "
+         "best one of the problem, default: true.");
     LOGM("   --m=<int>                            <Optional> Specify dimension m for matmul problem shape, "
          "default: 256.");
     LOGM("   --n=<int>                            <Optional> Specify dimension n for matmul problem shape, "
          "default: 512.");
     LOGM("   --k=<int>                            <Optional> Specify dimension k for matmul problem shape, "
          "default: 1024.");
+    LOGM("   --shapes=<string>                    <Optional> Path to a file of matmul shapes, one m,n,k or "
+         "m,n,k,weight per line, tuned instead of --m --n --k and ranked by weight.");
     LOGM("   --group_count=<int>                  <Optional> Specify group count for grouped-matmul-like operations, "
          "default: 128.");
     LOGM("   --kernels=<string>                   <Optional> Filter operations by kernel name.");
@@ -12,15 +12,13 @@
 
 namespace Catlass {
 
-void DoClearL2Cache(uint32_t blockDim, uint8_t* l2ctrl, uint8_t* stream, uint8_t* buffer, uint8_t* tilingSize);
-
 namespace {
 struct L2CacheClearTiling {
     uint64_t clearSizePerCore; // B
     uint32_t aicCoreNum;
 };
 
-bool GetTiling(L2CacheClearTiling &tiling)
+bool GetTiling(DeviceBackend &backend, L2CacheClearTiling &tiling)
 {
     const static std::unordered_map<std::string_view, L2CacheClearTiling> TILING_MAP = {
         {"Ascend910B1", {8388608, 24}},
@@ -30,7 +28,7 @@ bool GetTiling(L2CacheClearTiling &tiling)
         {"Ascend910B4", {5242880, 20}},
         {"Ascend910B4-1", {10485760, 20}},
     };
-    auto soc = aclrtGetSocName();
+    auto soc = backend.GetSocName();
     if (!soc) {
         LOGW("Call aclrtGetSocName failed");
         return false;
@@ -92,21 +90,14 @@ aclrtStream DeviceMemoryManager::Initialize(int32_t deviceId)
     if (stream_) {
         return stream_;
     }
-    LOGI("Start to initialize device %d", deviceId);
-    aclError err = aclInit(nullptr);
-    if (err != ACL_SUCCESS) {
-        LOGE("Call aclInit failed: %d", err);
+    if (!backend_) {
+        LOGE("No device backend is set");
         return nullptr;
     }
+    LOGI("Start to initialize device %d", deviceId);
     deviceId_ = deviceId;
-    err = aclrtSetDevice(deviceId_);
-    if (err != ACL_SUCCESS) {
-        LOGE("Call aclrtSetDevice failed: %d, device id: %d", err, deviceId_);
-        return nullptr;
-    }
-    err = aclrtCreateStream(&stream_);
-    if (err != ACL_SUCCESS) {
-        LOGE("Call aclrtCreateStream failed: %d", err);
+    stream_ = backend_->Initialize(deviceId_);
+    if (!stream_) {
         return nullptr;
     }
     LOGI("Initializing device %d success", deviceId_);
@@ -123,9 +114,16 @@ void DeviceMemoryManager::Finalize()
     Free(cacheClear_.buffer);
     Free(cacheClear_.tilingSize);
     Free(cacheClear_.flushBuffer);
-    ACL_CHECK(aclrtDestroyStream(stream_), "aclrtDestroyStream");
-    ACL_CHECK(aclrtResetDevice(deviceId_), "aclrtResetDevice");
-    ACL_CHECK(aclFinalize(), "aclFinalize");
+    for (auto &cmoBuffer : cacheClear_.cmoBuffers) {
+        Free(cmoBuffer);
+    }
+    arg_ = nullptr;
+    argSize_ = 0;
+    workspace_ = nullptr;
+    workspaceSize_ = 0;
+    cacheClear_ = CacheClear{};
+    fftsAddr_ = 0;
+    backend_->Finalize(stream_, deviceId_);
     stream_ = nullptr;
 }
 
@@ -139,7 +137,7 @@ bool DeviceMemoryManager::Expand(void **addr, uint64_t &size, uint64_t target)
         return false;
     }
     *addr = nullptr;
-    auto err = aclrtMalloc(addr, target, ACL_MEM_MALLOC_HUGE_FIRST);
+    auto err = backend_->Malloc(addr, target);
     if (err != ACL_SUCCESS) {
         LOGE("Call aclrtMalloc failed, %d, size %lu", err, target);
         size = 0;
@@ -152,7 +150,7 @@ bool DeviceMemoryManager::Expand(void **addr, uint64_t &size, uint64_t target)
 bool DeviceMemoryManager::Free(void *addr)
 {
     if (addr) {
-        auto err = aclrtFree(addr);
+        auto err = backend_->Free(addr);
         if (err != ACL_SUCCESS) {
             LOGE("Call aclrtFree failed, %d, release memory for 0x%lx failed", err, (uint64_t)addr);
             return false;
@@ -164,11 +162,11 @@ bool DeviceMemoryManager::Free(void *addr)
 bool DeviceMemoryManager::InitCacheClear()
 {
     L2CacheClearTiling tiling{};
-    if (!GetTiling(tiling)) {
+    if (!GetTiling(*backend_, tiling)) {
         return false;
     }
     cacheClear_.cacheSize = tiling.clearSizePerCore * tiling.aicCoreNum;
-    int err = aclrtMalloc(&cacheClear_.buffer, cacheClear_.cacheSize, ACL_MEM_MALLOC_HUGE_FIRST);
+    int err = backend_->Malloc(&cacheClear_.buffer, cacheClear_.cacheSize);
     std::shared_ptr<void> defer(nullptr, [&](void*) {
         if (err != ACL_SUCCESS) {
             Free(cacheClear_.buffer);
@@ -187,7 +185,7 @@ bool DeviceMemoryManager::InitCacheClear()
         LOGE("Call aclrtMalloc failed, err %d, size %lu", err, cacheClear_.cacheSize);
         return false;
     }
-    err = aclrtMalloc(&cacheClear_.flushBuffer, cacheClear_.cacheSize, ACL_MEM_MALLOC_HUGE_FIRST);
+    err = backend_->Malloc(&cacheClear_.flushBuffer, cacheClear_.cacheSize);
     if (err != ACL_SUCCESS) {
         LOGE("Call aclrtMalloc failed, err %d, size %lu", err, cacheClear_.cacheSize);
         return false;
@@ -200,7 +198,7 @@ bool DeviceMemoryManager::InitCacheClear()
     constexpr int CACHE_CLEAR_BUFF = 1;
     cacheClear_.cmoBuffers.resize(CACHE_CLEAR_BUFF);
     for (int i = 0; i < CACHE_CLEAR_BUFF; ++i) {
-        err = aclrtMalloc(&cacheClear_.cmoBuffers[i], cacheClear_.cacheSize, ACL_MEM_MALLOC_HUGE_FIRST);
+        err = backend_->Malloc(&cacheClear_.cmoBuffers[i], cacheClear_.cacheSize);
         if (err != ACL_SUCCESS) {
             LOGE("Call aclrtMalloc failed, err: %d, size 32", err);
             return false;
@@ -212,26 +210,16 @@ bool DeviceMemoryManager::InitCacheClear()
 aclError DeviceMemoryManager::SetCacheClearTiling(uint64_t clearSizePerCore)
 {
     constexpr size_t TILING_SIZE = 32;
-    auto err = aclrtMalloc(&cacheClear_.tilingSize, TILING_SIZE, ACL_MEM_MALLOC_HUGE_FIRST);
+    auto err = backend_->Malloc(&cacheClear_.tilingSize, TILING_SIZE);
     if (err != ACL_SUCCESS) {
         LOGE("Call aclrtMalloc failed, err: %d, size %lu", err, TILING_SIZE);
         return err;
     }
 
-    void *host_tilingSize;
-    err = aclrtMallocHost(&host_tilingSize, TILING_SIZE);
-    if (err != ACL_SUCCESS) {
-        LOGE("Call aclrtMallocHost failed, err: %d, size %lu", err, TILING_SIZE);
-        return err;
-    }
-    std::shared_ptr<void> deferC(nullptr, [&host_tilingSize](void*) {
-        aclrtFreeHost(host_tilingSize);
-    });
-
-    *reinterpret_cast<uint64_t*>(host_tilingSize) = clearSizePerCore;
-    err = aclrtMemcpyAsync(cacheClear_.tilingSize, sizeof(uint64_t), host_tilingSize, sizeof(uint64_t),
-                           ACL_MEMCPY_HOST_TO_DEVICE, stream_);
-    if (err != ACL_SUCCESS || (err = aclrtSynchronizeStream(stream_)) != ACL_SUCCESS) {
+    uint64_t hostTilingSize = clearSizePerCore;
+    err = backend_->MemcpyAsync(cacheClear_.tilingSize, &hostTilingSize, sizeof(uint64_t),
+                                ACL_MEMCPY_HOST_TO_DEVICE, stream_);
+    if (err != ACL_SUCCESS || (err = backend_->Synchronize(stream_, -1)) != ACL_SUCCESS) {
         LOGE("Set cache clear data failed, err: %d", err);
         return err;
     }
@@ -243,23 +231,21 @@ bool DeviceMemoryManager::ClearL2Cache(uint32_t blockDim)
 {
     bool res = false;
     if (cacheClear_.buffer && cacheClear_.tilingSize && cacheClear_.flushBuffer) {
-        DoClearL2Cache(blockDim, nullptr, reinterpret_cast<uint8_t*>(stream_),
-                       reinterpret_cast<uint8_t*>(cacheClear_.buffer),
-                       reinterpret_cast<uint8_t*>(cacheClear_.tilingSize));
-        ACL_CHECK(aclrtMemcpyAsync(cacheClear_.flushBuffer, cacheClear_.cacheSize,
-                                   cacheClear_.buffer, cacheClear_.cacheSize, ACL_MEMCPY_DEVICE_TO_DEVICE, stream_),
+        backend_->LaunchCacheClear(blockDim, stream_, cacheClear_.buffer, cacheClear_.tilingSize);
+        ACL_CHECK(backend_->MemcpyAsync(cacheClear_.flushBuffer, cacheClear_.buffer, cacheClear_.cacheSize,
+                                        ACL_MEMCPY_DEVICE_TO_DEVICE, stream_),
                   "aclrtMemcpyAsync");
-        ACL_CHECK(aclrtSynchronizeStream(stream_), "aclrtSynchronizeStream");
+        ACL_CHECK(backend_->Synchronize(stream_, -1), "aclrtSynchronizeStream");
         res = true;
     }
     for (auto &cmoBuffer : cacheClear_.cmoBuffers) {
-        int err = aclrtCmoAsync(cmoBuffer, cacheClear_.cacheSize, ACL_RT_CMO_TYPE_PREFETCH, stream_);
+        int err = backend_->Prefetch(cmoBuffer, cacheClear_.cacheSize, stream_);
         if (err != ACL_SUCCESS) {
             LOGE("Call aclrtCmoAsync failed, err %d", err);
             break;
         }
     }
-    ACL_CHECK(aclrtSynchronizeStream(stream_), "aclrtSynchronizeStream");
+    ACL_CHECK(backend_->Synchronize(stream_, -1), "aclrtSynchronizeStream");
     return res;
 }
 
@@ -272,12 +258,12 @@ bool DeviceMemoryManager::FillDeviceData(void *dst, size_t size, void *host) con
         LOGE("Try to copy host data to invalid addr 0x%lx, size %lu", d, size);
         return false;
     }
-    auto err = aclrtMemcpyAsync(dst, size, host, size, ACL_MEMCPY_HOST_TO_DEVICE, stream_);
+    auto err = backend_->MemcpyAsync(dst, host, size, ACL_MEMCPY_HOST_TO_DEVICE, stream_);
     if (err != ACL_SUCCESS) {
         LOGE("Fill device data failed when call aclrtMemcpyAsync, err: %d", err);
         return false;
     }
-    err = aclrtSynchronizeStream(stream_);
+    err = backend_->Synchronize(stream_, -1);
     if (err != ACL_SUCCESS) {
         LOGE("Fill device data failed when call aclrtSynchronizeStream, err: %d", err);
         return false;
@@ -83,6 +83,16 @@ bool BasicGemmOpConfig::InitConfig(CommandLineParser &parser)
     return true;
 }
 
+std::shared_ptr<OpConfig> BasicGemmOpConfig::ForShape(uint32_t m, uint32_t n, uint32_t k) const
+{
+    auto config = std::make_shared<BasicGemmOpConfig>(*this);
+    config->arg_ = {};
+    config->m_ = config->config_.m = m;
+    config->n_ = config->config_.n = n;
+    config->k_ = config->config_.k = k;
+    return config;
+}
+
 bool BasicGemmOpConfig::InitArgument(Library::Operation *op)
 {
     auto &mdesp = static_cast<const Library::GemmOperationDescription &>(op->GetDescription());
@@ -153,6 +163,17 @@ bool GroupedGemmOpConfig::InitConfig(CommandLineParser &parser)
     return true;
 }
 
+std::shared_ptr<OpConfig> GroupedGemmOpConfig::ForShape(uint32_t m, uint32_t n, uint32_t k) const
+{
+    auto config = std::make_shared<GroupedGemmOpConfig>(*this);
+    config->arg_ = {};
+    config->m_ = config->config_.m = m;
+    config->n_ = config->config_.n = n;
+    config->k_ = config->config_.k = k;
+    config->groupList_ = GenGroupList<int32_t>(config_.groupCount, m);
+    return config;
+}
+
 bool GroupedGemmOpConfig::CheckArgument(const Library::GemmOperationDescription &mdesp, ArgumentSize &argSize)
 {
     argSize.layoutASize = LibraryHelper::GetLayoutSize(mdesp.A.layout);
@@ -9,6 +9,7 @@
  */
  
 #include "catlass_tuner.h"
+#include "simulated_device.h"
 
 using namespace Catlass;
 
@@ -20,7 +21,11 @@ int main(int argc, const char* argv[])
         parser.PrintHelp();
         return 0;
     }
-    CatlassTuner tuner(parser);
+    DeviceBackendFactory createBackend = [](CommandLineParser &, int32_t) { return CreateAclBackend(); };
+    if (parser.HasKey("simulate")) {
+        createBackend = [](CommandLineParser &p, int32_t deviceId) { return SimulatedDevice::Create(p, deviceId); };
+    }
+    CatlassTuner tuner(parser, createBackend);
     tuner.Run();
     return 0;
 }
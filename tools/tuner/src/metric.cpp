@@ -44,6 +44,10 @@ const std::unordered_map<std::string, ClassicMetric> Metric::CLASSIC_STR_TO_E =
     {"A", ClassicMetric::A},
     {"B", ClassicMetric::B},
     {"C", ClassicMetric::C},
+    {"p10(us)", ClassicMetric::P10},
+    {"p90(us)", ClassicMetric::P90},
+    {"stddev(us)", ClassicMetric::STDDEV},
+    {"runs", ClassicMetric::RUNS},
 };
 
 void Metric::SaveOperator(Library::Operation *op)
@@ -66,7 +70,8 @@ std::string Metric::ToString() const
        << Field(ClassicMetric::DEVICE_ID) << "," << Field(ClassicMetric::OPERATION) << ","
        << Field(ClassicMetric::DESCRIPTION) << "," << Field(ClassicMetric::M) << ","
        << Field(ClassicMetric::N) << "," << Field(ClassicMetric::K) << "," << Field(ClassicMetric::A) << ","
-       << Field(ClassicMetric::B) << "," << Field(ClassicMetric::C);
+       << Field(ClassicMetric::B) << "," << Field(ClassicMetric::C) << "," << Field(ClassicMetric::P10) << ","
+       << Field(ClassicMetric::P90) << "," << Field(ClassicMetric::STDDEV) << "," << Field(ClassicMetric::RUNS);
     for (const auto &p : fields_) {
         ss << "," << p.second;
     }
@@ -95,6 +100,10 @@ std::string Metric::ToTerminalString() const
     format(ClassicMetricStr::A, ClassicMetric::A);
     format(ClassicMetricStr::B, ClassicMetric::B);
     format(ClassicMetricStr::C, ClassicMetric::C);
+    format(ClassicMetricStr::P10, ClassicMetric::P10);
+    format(ClassicMetricStr::P90, ClassicMetric::P90);
+    format(ClassicMetricStr::STDDEV, ClassicMetric::STDDEV);
+    format(ClassicMetricStr::RUNS, ClassicMetric::RUNS);
     for (const auto &p : fields_) {
         ss << std::setw(LEFT_ALIGN) << p.first << " : " << p.second << std::endl;
     }
@@ -117,6 +126,10 @@ Metric::Metric()
     SetField<ClassicMetric::A>("");
     SetField<ClassicMetric::B>("");
     SetField<ClassicMetric::C>("");
+    SetField<ClassicMetric::P10>(0.0);
+    SetField<ClassicMetric::P90>(0.0);
+    SetField<ClassicMetric::STDDEV>(0.0);
+    SetField<ClassicMetric::RUNS>(0);
 }
 
 void Metric::SetField(const std::string &key, const std::string &value)
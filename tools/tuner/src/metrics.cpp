@@ -15,6 +15,10 @@
 #include <unistd.h>
 #include <fstream>
 #include <iterator>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include "catlass/library/tuning_db.h"
 #include "library_helper.h"
 
 namespace Catlass {
@@ -172,48 +176,127 @@ bool MkdirRecursively(std::string_view path)
     }
     return true;
 }
-} // namespace
-
-void Metrics::Add(const std::shared_ptr<OpConfig>& opConfig, Library::Operation *op)
+bool CheckOutputFile(std::string_view path, std::string_view key, std::string_view suffix, std::string &absPath)
 {
-    Metric metric{};
-    metric.SetField<ClassicMetric::DEVICE_ID>(deviceId_);
-    metric.SetField<ClassicMetric::CASE_ID>(metrics_.size() + 1);
-    metric.SaveOperator(op);
-    opConfig->SaveMetric(metric);
-    metrics_.emplace_back(metric);
-    for (auto &field : metric.Fields()) {
-        extraHeads_.insert(field.first);
-    }
-}
-
-bool Metrics::SetOutputPath(std::string_view output)
-{
-    std::string absPath = StandardizePath(output);
+    absPath = StandardizePath(path);
     if (absPath.empty() || absPath.back() == '/') {
-        LOGE("--output is not a valid file path");
+        LOGE("--%s is not a valid file path", key.data());
         return false;
     }
-    constexpr size_t TAIL_LEN = 4;
-    if (absPath.size() < TAIL_LEN || absPath.find(".csv", absPath.size() - TAIL_LEN) == std::string::npos) {
-        absPath.append(".csv");
+    if (absPath.size() < suffix.size() ||
+        absPath.compare(absPath.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        absPath.append(suffix);
     }
     // check file security
     if (IsExist(absPath)) {
         if (IsSoftLink(absPath)) {
-            LOGE("--output cannot be a soft link");
+            LOGE("--%s cannot be a soft link", key.data());
             return false;
         } else if (!IsSafePath(absPath)) {
             return false;
         } else if (std::error_code ec; std::filesystem::is_directory(absPath, ec) && !ec) {
-            LOGE("--output cannot be an existing directory: %s", absPath.c_str());
+            LOGE("--%s cannot be an existing directory: %s", key.data(), absPath.c_str());
             return false;
         }
     }
     std::string_view absView = absPath;
     auto sep = absView.rfind(PATH_SEP);
     std::string_view dir = absView.substr(0, sep);
-    if (!CheckInvalidChar(absView) || !IsSafePath(dir) || !MkdirRecursively(dir)) {
+    return CheckInvalidChar(absView) && IsSafePath(dir) && MkdirRecursively(dir);
+}
+} // namespace
+
+void Metrics::Add(const std::shared_ptr<OpConfig>& opConfig, Library::Operation *op, size_t caseId)
+{
+    Metric metric{};
+    metric.SetField<ClassicMetric::DEVICE_ID>(deviceId_);
+    metric.SetField<ClassicMetric::CASE_ID>(caseId == 0 ? metrics_.size() + 1 : caseId);
+    metric.SaveOperator(op);
+    opConfig->SaveMetric(metric);
+    metrics_.emplace_back(metric);
+    for (auto &field : metric.Fields()) {
+        extraHeads_.insert(field.first);
+    }
+}
+
+void Metrics::Merge(const std::vector<Metrics *> &parts, const std::vector<size_t> &calibration)
+{
+    auto getCaseId = [](const Metric &metric) {
+        return static_cast<size_t>(std::strtoul(metric.Field(ClassicMetric::CASE_ID).c_str(), nullptr, 10));
+    };
+    auto median = [](std::vector<double> values) {
+        auto mid = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), mid, values.end());
+        return *mid;
+    };
+    // durations of the calibration cases on every device, 0 if they did not run
+    std::vector<std::vector<double>> calibrated(parts.size(), std::vector<double>(calibration.size(), 0));
+    size_t ref = parts.size();
+    for (size_t p = 0; p < parts.size(); ++p) {
+        for (auto &metric : parts[p]->metrics_) {
+            auto it = std::find(calibration.begin(), calibration.end(), getCaseId(metric));
+            if (it != calibration.end() && metric.GetTaskDuration() > 0) {
+                calibrated[p][it - calibration.begin()] = metric.GetTaskDuration();
+                ref = std::min(ref, p);
+            }
+        }
+    }
+    std::vector<double> factors(parts.size(), 1.0);
+    for (size_t p = 0; p < parts.size() && ref < parts.size(); ++p) {
+        std::vector<double> ratios;
+        for (size_t i = 0; i < calibration.size(); ++i) {
+            if (calibrated[p][i] > 0 && calibrated[ref][i] > 0) {
+                ratios.emplace_back(calibrated[p][i] / calibrated[ref][i]);
+            }
+        }
+        if (!ratios.empty()) {
+            factors[p] = median(ratios);
+        }
+        LOGI("Device %d ran %lu operations, %.4fx the durations of device %d", parts[p]->deviceId_,
+             parts[p]->metrics_.size(), factors[p], parts[ref]->deviceId_);
+    }
+
+    std::map<size_t, Metric> merged;
+    std::map<size_t, std::vector<double>> calibrationDurations;
+    for (size_t p = 0; p < parts.size(); ++p) {
+        for (auto &metric : parts[p]->metrics_) {
+            size_t caseId = getCaseId(metric);
+            Metric corrected = metric;
+            if (metric.GetTaskDuration() > 0) {
+                auto correct = [&](ClassicMetric key) {
+                    return std::strtod(metric.Field(key).c_str(), nullptr) / factors[p];
+                };
+                corrected.SetField<ClassicMetric::TASK_DURATION>(metric.GetTaskDuration() / factors[p]);
+                corrected.SetField<ClassicMetric::P10>(correct(ClassicMetric::P10));
+                corrected.SetField<ClassicMetric::P90>(correct(ClassicMetric::P90));
+                corrected.SetField<ClassicMetric::STDDEV>(correct(ClassicMetric::STDDEV));
+                if (std::find(calibration.begin(), calibration.end(), caseId) != calibration.end()) {
+                    calibrationDurations[caseId].emplace_back(corrected.GetTaskDuration());
+                }
+            }
+            // a failed run of a calibration case is replaced by one of another device
+            auto [it, inserted] = merged.emplace(caseId, corrected);
+            if (!inserted && it->second.GetTaskDuration() == 0) {
+                it->second = std::move(corrected);
+            }
+        }
+        extraHeads_.insert(parts[p]->extraHeads_.begin(), parts[p]->extraHeads_.end());
+    }
+    // a calibration case keeps the record of one device and the median duration of all
+    for (auto &[caseId, durations] : calibrationDurations) {
+        merged[caseId].SetField<ClassicMetric::TASK_DURATION>(median(durations));
+    }
+    metrics_.clear();
+    for (auto &p : merged) {
+        metrics_.emplace_back(std::move(p.second));
+    }
+    durationIdx_ = metrics_.size();
+}
+
+bool Metrics::SetOutputPath(std::string_view output)
+{
+    std::string absPath;
+    if (!CheckOutputFile(output, "output", ".csv", absPath)) {
         return false;
     }
     outputPath_ = std::move(absPath);
@@ -221,6 +304,17 @@ bool Metrics::SetOutputPath(std::string_view output)
     return true;
 }
 
+bool Metrics::SetTuningDbPath(std::string_view tuningDb)
+{
+    std::string absPath;
+    if (!CheckOutputFile(tuningDb, "tuning_db", ".db", absPath)) {
+        return false;
+    }
+    tuningDbPath_ = std::move(absPath);
+    LOGI("Set tuning database file %s", tuningDbPath_.c_str());
+    return true;
+}
+
 void Metrics::PrintTop10(const std::string &head)
 {
     std::vector<Metric> tmp = metrics_;
@@ -248,6 +342,7 @@ void Metrics::Dump()
         }
     }
     PrintTop10(head);
+    DumpTuningDb();
     if (outputPath_.empty()) {
         return;
     }
@@ -265,13 +360,91 @@ void Metrics::Dump()
     LOGI("Save profile data to %s success", outputPath_.c_str());
 }
 
-void Metrics::SetDurationAndPrint(double duration)
+void Metrics::DumpTable(std::string_view suffix, std::string_view head, const std::vector<std::string> &rows) const
+{
+    constexpr std::string_view CSV = ".csv";
+    if (outputPath_.empty()) {
+        return;
+    }
+    std::string path = outputPath_.substr(0, outputPath_.size() - CSV.size()) + std::string(suffix);
+    std::string absPath;
+    if (!CheckOutputFile(path, "output", CSV, absPath)) {
+        return;
+    }
+    std::ofstream file(absPath);
+    if (!file.is_open() || chmod(absPath.c_str(), SAVE_DATA_FILE_AUTHORITY) != 0) {
+        LOGE("Create file %s failed", absPath.c_str());
+        return;
+    }
+    file << head << "\n";
+    for (auto &row : rows) {
+        file << row << "\n";
+    }
+    file.close();
+    LOGI("Save table to %s success", absPath.c_str());
+}
+
+void Metrics::DumpTuningDb()
+{
+    if (tuningDbPath_.empty()) {
+        return;
+    }
+    TuningDatabase db;
+    if (IsExist(tuningDbPath_) && !db.Load(tuningDbPath_)) {
+        LOGE("Load tuning database %s failed: %s, skip updating it", tuningDbPath_.c_str(), db.Error().c_str());
+        return;
+    }
+    size_t updated = 0;
+    for (auto &metric : metrics_) {
+        // operations with extra problem fields, e.g. group_count, are not determined by m, n and k
+        TuningRecord record;
+        record.description = metric.Field(ClassicMetric::DESCRIPTION);
+        if (metric.GetTaskDuration() == 0 || !metric.Fields().empty() ||
+            !TuningDatabase::ParseDescription(record)) {
+            continue;
+        }
+        record.A = metric.Field(ClassicMetric::A);
+        record.B = metric.Field(ClassicMetric::B);
+        record.C = metric.Field(ClassicMetric::C);
+        record.device = deviceName_;
+        record.m = static_cast<uint32_t>(std::strtoul(metric.Field(ClassicMetric::M).c_str(), nullptr, 10));
+        record.n = static_cast<uint32_t>(std::strtoul(metric.Field(ClassicMetric::N).c_str(), nullptr, 10));
+        record.k = static_cast<uint32_t>(std::strtoul(metric.Field(ClassicMetric::K).c_str(), nullptr, 10));
+        record.taskDuration = metric.GetTaskDuration();
+        if (db.Update(record)) {
+            ++updated;
+        }
+    }
+    // write to a temporary file and rename it, an interrupted dump never truncates the database
+    std::string tmpPath = tuningDbPath_ + ".tmp";
+    std::ofstream file(tmpPath);
+    if (!file.is_open() || chmod(tmpPath.c_str(), SAVE_DATA_FILE_AUTHORITY) != 0) {
+        LOGE("Create file %s failed", tmpPath.c_str());
+        return;
+    }
+    db.Write(file);
+    file.close();
+    if (file.fail() || std::rename(tmpPath.c_str(), tuningDbPath_.c_str()) != 0) {
+        LOGE("Save tuning database %s failed", tuningDbPath_.c_str());
+        std::remove(tmpPath.c_str());
+        return;
+    }
+    LOGI("Update %lu records of tuning database %s, %lu records in total", updated, tuningDbPath_.c_str(),
+         db.Size());
+}
+
+void Metrics::SetDurationAndPrint(const SampleStats &stats)
 {
     if (durationIdx_ >= metrics_.size()) {
         LOGE("SetDuration idx %lu > metrics size", durationIdx_);
         return;
     }
-    metrics_[durationIdx_].SetField<ClassicMetric::TASK_DURATION>(duration);
+    auto &metric = metrics_[durationIdx_];
+    metric.SetField<ClassicMetric::TASK_DURATION>(stats.median);
+    metric.SetField<ClassicMetric::P10>(stats.p10);
+    metric.SetField<ClassicMetric::P90>(stats.p90);
+    metric.SetField<ClassicMetric::STDDEV>(stats.stddev);
+    metric.SetField<ClassicMetric::RUNS>(stats.runs);
     LOGM("%s\n%s", DIVIDE.data(), metrics_[durationIdx_].ToTerminalString().c_str());
     ++durationIdx_;
 }
@@ -16,15 +16,17 @@ namespace Catlass {
 
 OpRunStatus OpLauncher::operator()(void* stream, int times, bool sync)
 {
+    auto &manager = DeviceMemoryManager::Instance();
     for (int i = 0; i < times; ++i) {
-        auto status = op_->Run(stream, aicCoreNum_, DeviceMemoryManager::Instance().GetFftsAddr());
+        auto status = manager.GetBackend().Launch(op_, opConfig_->GetConfig(), stream, aicCoreNum_,
+                                                  manager.GetFftsAddr());
         if (status != Status::kSuccess) {
             LOGE("Operator %s run failed", op_->GetDescription().name);
             return OpRunStatus::FATAL;
         }
         if (sync) {
             constexpr int SYNC_TIME = 1000;
-            auto err = aclrtSynchronizeStreamWithTimeout(stream, SYNC_TIME);
+            auto err = manager.GetBackend().Synchronize(stream, SYNC_TIME);
             if (err != ACL_SUCCESS) {
                 LOGE("Operator %s run failed, aclrtSynchronizeStreamWithTimeout ret: %d",
                      op_->GetDescription().name, err);
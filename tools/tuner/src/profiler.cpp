@@ -10,47 +10,9 @@
  
 #include "profiler.h"
 #include <algorithm>
-#include <runtime/dev.h>
 #include "log.h"
 
 namespace {
-constexpr uint32_t STARS_ENABLE_FLAG = 1;
-constexpr uint32_t PROF_CFG_PERIOD = 0;
-constexpr uint32_t PROF_REAL = 1;
-
-enum class PROF_CHANNEL_TYPE {
-    PROF_TS_TYPE,
-    PROF_PERIPHERAL_TYPE,
-    PROF_CHANNEL_TYPE_MAX,
-};
-
-using ProfStartParaT = struct prof_start_para {
-    PROF_CHANNEL_TYPE channelType;
-    uint32_t samplePeriod;
-    uint32_t realTime;
-    void *userData;
-    uint32_t userDataSize;
-};
-
-// ts data code
-using StarsSocLogConfigT = struct TagStarsSocLogConfig {
-    uint32_t acsqTask;         // 1-enable,2-disable
-    uint32_t accPmu;           // 1-enable,2-disable
-    uint32_t cdqmReg;          // 1-enable,2-disable
-    uint32_t dvppVpcBlock;     // 1-enable,2-disable
-    uint32_t dvppJpegdBlock;   // 1-enable,2-disable
-    uint32_t dvppJpedeBlock;   // 1-enable,2-disable
-    uint32_t fftsThreadTask;   // 1-enable,2-disable
-    uint32_t fftsBlock;        // 1-enable,2-disable
-    uint32_t sdmaDmu;          // 1-enable,2-disable
-};
-
-using ProfPollInfoT = struct prof_poll_info {
-    uint32_t deviceId;
-    uint32_t channelId;
-};
-
-constexpr uint32_t CHANNEL_STARS_SOC_LOG_BUFFER = 50;   /* add for ascend910B */
 
 enum class TimeType : uint16_t {
     START = 0,
@@ -60,7 +22,7 @@ enum class TimeType : uint16_t {
 
 struct AcsqBean {
 public:
-    explicit AcsqBean(const std::vector<char> &bin)
+    explicit AcsqBean(const char *bin)
     {
         constexpr uint16_t typeIndex = 0;
         constexpr uint16_t streamIdIndex = 2;
@@ -69,7 +31,7 @@ public:
         constexpr uint16_t taskTypeOffset = 10;
         constexpr uint16_t funcTypeAndOperation = 63;
         constexpr uint16_t systemTimeIndex = 0;
-        auto ptr = reinterpret_cast<const AcsqConstruct*>(&bin[0]);
+        auto ptr = reinterpret_cast<const AcsqConstruct*>(bin);
         acsqData_.taskType = ptr->shortNums1[typeIndex] >> taskTypeOffset;
         acsqData_.funcType = ptr->shortNums1[typeIndex] & funcTypeAndOperation;
         acsqData_.systemTime = ptr->longlongNums[systemTimeIndex];
@@ -135,38 +97,6 @@ private:
         uint64_t systemTime;
     } acsqData_{};
 };
-
-bool GetStarsTask(ProfStartParaT &starsProfStartPara)
-{
-    uint32_t starsConfigSize = sizeof(StarsSocLogConfigT);
-    auto *starsConfigPtr = static_cast<StarsSocLogConfigT *>(malloc(starsConfigSize));
-    starsProfStartPara.userData = nullptr;
-    if (starsConfigPtr == nullptr) {
-        LOGE("Can not get user data pointer while getting stars task");
-        return false;
-    }
-    std::fill_n(reinterpret_cast<uint8_t *>(starsConfigPtr), starsConfigSize, 0);
-
-    starsConfigPtr->acsqTask = STARS_ENABLE_FLAG;
-    starsConfigPtr->fftsThreadTask = STARS_ENABLE_FLAG;
-    starsConfigPtr->accPmu = STARS_ENABLE_FLAG;
-
-    starsProfStartPara.channelType = PROF_CHANNEL_TYPE::PROF_TS_TYPE;
-    starsProfStartPara.samplePeriod = PROF_CFG_PERIOD;
-    starsProfStartPara.realTime = PROF_REAL;
-    starsProfStartPara.userData = starsConfigPtr;
-    starsProfStartPara.userDataSize = starsConfigSize;
-    return true;
-}
-}
-
-extern "C" {
-int prof_drv_start(unsigned int deviceId, unsigned int channelId, struct prof_start_para *startPara);
-int prof_channel_read(unsigned int deviceId, unsigned int channelId, char *outBuf, unsigned int bufSize);
-int prof_stop(unsigned int deviceId, unsigned int channelId);
-int prof_channel_poll(struct prof_poll_info *outBuf, int num, int timeout);
-int halGetDeviceInfo(uint32_t devId, int32_t moduleType, int32_t infoType, int64_t *value);
-int halGetDeviceInfoByBuff(uint32_t deviceId, int32_t aicoreType, int32_t frequeType, void* freq, int32_t* size);
 }
 
 namespace Catlass {
@@ -176,19 +106,13 @@ bool Profiler::Start()
     if (running_) {
         Stop();
     }
-    data_.clear();
-    ProfStartParaT starsProfStartPara;
-    if (!GetStarsTask(starsProfStartPara)) {
-        LOGE("Set stars task data failed.");
+    if (channel_ == nullptr) {
+        LOGE("No profile channel to start");
         return false;
     }
-    int drvRes = prof_drv_start(deviceId_, CHANNEL_STARS_SOC_LOG_BUFFER, &starsProfStartPara);
-    if (drvRes != 0) {
-        free(starsProfStartPara.userData);
-        LOGE("Start channel %u failed", CHANNEL_STARS_SOC_LOG_BUFFER);
+    if (!channel_->Start(deviceId_)) {
         return false;
     }
-    free(starsProfStartPara.userData);
     running_ = true;
     CreateReadThread();
     return true;
@@ -200,22 +124,19 @@ void Profiler::Stop()
         return;
     }
 
-    int drvRes = prof_stop(deviceId_, CHANNEL_STARS_SOC_LOG_BUFFER);
-    if (drvRes != 0) {
-        LOGE("Channel %u prof_stop failed, %d", CHANNEL_STARS_SOC_LOG_BUFFER, drvRes);
-    }
+    channel_->Stop(deviceId_);
     running_ = false;
     if (readThread_.joinable()) {
         readThread_.join();
     }
 }
 
-void Profiler::GetDurations(const std::vector<char> &data, std::vector<uint64_t> &starts, std::vector<uint64_t> &ends)
+void Profiler::GetDurations(const char *data, size_t size, std::vector<uint64_t> &starts,
+    std::vector<uint64_t> &ends)
 {
-    constexpr uint16_t ACSQ_LENGTH = 64;
-    for (size_t i = 0; i + ACSQ_LENGTH <= data.size(); i += ACSQ_LENGTH) {
-        std::vector<char> splitBinData{&data[i], &data[i] + ACSQ_LENGTH};
-        AcsqBean acsqBean(splitBinData);
+    static_assert(RECORD_SIZE == 64, "AcsqBean is 64 bytes");
+    for (size_t i = 0; i + RECORD_SIZE <= size; i += RECORD_SIZE) {
+        AcsqBean acsqBean(data + i);
         uint16_t taskType = acsqBean.GetTaskType();
         TimeType timeType = acsqBean.GetTimeType();
         uint64_t systemTime = acsqBean.GetSystemTime();
@@ -235,22 +156,26 @@ void Profiler::CreateReadThread()
     readThread_ = std::thread([&]() {
         constexpr int PROF_CHANNEL_NUM = 2;
         static constexpr int PROF_CHANNEL_BUFFER_SIZE = 1024 * 1024 * 2;
-        std::vector<ProfPollInfoT> channels(PROF_CHANNEL_NUM);
-        std::vector<char> outBuf_ = std::vector<char>(PROF_CHANNEL_BUFFER_SIZE);
+        std::vector<ProfileChannelInfo> channels(PROF_CHANNEL_NUM);
+        // channels are read straight into pooled buffers, which are handed over without copy
+        ProfileBuffer buffer;
         for (bool read = true; running_ || read;) {
-            std::vector<char> data;
             if (!running_) {
                 // try poll once more when stopped
                 read = false;
             }
-            int ret = prof_channel_poll(channels.data(), PROF_CHANNEL_NUM, 1);
-            for (int i = 0; i < ret; ++i) {
-                int curLen = prof_channel_read(channels[i].deviceId, channels[i].channelId,
-                    &outBuf_[0], outBuf_.size());
-                data.insert(data.end(), outBuf_.begin(), outBuf_.begin() + curLen);
-            }
-            if (!data.empty() && callBack_) {
-                callBack_(std::move(data));
+            int ret = channel_->Poll(channels.data(), PROF_CHANNEL_NUM, 1);
+            for (int i = 0; i < ret && queue_ != nullptr; ++i) {
+                if (buffer.data.empty()) {
+                    buffer = queue_->Acquire(PROF_CHANNEL_BUFFER_SIZE);
+                }
+                int curLen = channel_->Read(channels[i], buffer.data.data(), buffer.data.size());
+                if (curLen <= 0) {
+                    continue;
+                }
+                buffer.size = static_cast<size_t>(curLen);
+                queue_->Push(std::move(buffer));
+                buffer = ProfileBuffer{};
             }
         }
     });
@@ -265,20 +190,24 @@ void ProfileDataHandler::ProfileDataThread()
 {
     std::vector<uint64_t> starts;
     std::vector<uint64_t> ends;
-    std::vector<char> data;
-    auto flush = [&]() {
-        while (!profileDataQueue_.empty()) {
-            auto front = profileDataQueue_.front();
-            data.insert(data.end(), front.begin(), front.end());
-            profileDataQueue_.pop();
+    // a record split over two buffers is completed here
+    std::vector<char> record;
+    ProfileBuffer buffer;
+    auto decode = [&]() {
+        size_t offset = 0;
+        if (!record.empty()) {
+            offset = std::min(Profiler::RECORD_SIZE - record.size(), buffer.size);
+            record.insert(record.end(), buffer.data.begin(), buffer.data.begin() + offset);
+            if (record.size() == Profiler::RECORD_SIZE) {
+                profiler_.GetDurations(record.data(), record.size(), starts, ends);
+                record.clear();
+            }
         }
+        size_t wholeSize = (buffer.size - offset) / Profiler::RECORD_SIZE * Profiler::RECORD_SIZE;
+        profiler_.GetDurations(buffer.data.data() + offset, wholeSize, starts, ends);
+        record.insert(record.end(), buffer.data.begin() + offset + wholeSize, buffer.data.begin() + buffer.size);
     };
     auto getDuration = [&]() {
-        if (data.empty()) {
-            return;
-        }
-        profiler_.GetDurations(data, starts, ends);
-        data.clear();
         size_t i = 0;
         auto freq = static_cast<double>(GetAicpuFreq());
         durations_.DoTransaction<void>([&](auto &val) {
@@ -292,34 +221,32 @@ void ProfileDataHandler::ProfileDataThread()
         Erase(ends, i);
     };
 
-    while (!finish_) {
-        {
-            std::unique_lock<decltype(mtx_)> lock(mtx_);
-            (void)profileDataCV_.wait_for(lock, std::chrono::seconds(1), [this]() {
-                return !profileDataQueue_.empty() || finish_;
-            });
-            flush();
+    for (bool finish = false; !finish;) {
+        // read before draining, everything pushed before finish_ is set is decoded by the last round
+        finish = finish_.load(std::memory_order_acquire);
+        bool decoded = false;
+        while (profileDataQueue_.Pop(buffer)) {
+            decode();
+            profileDataQueue_.Release(std::move(buffer));
+            buffer = ProfileBuffer{};
+            decoded = true;
+        }
+        if (decoded) {
+            getDuration();
+        } else if (!finish) {
+            constexpr int IDLE_WAIT_TIME = 200;
+            std::this_thread::sleep_for(std::chrono::microseconds(IDLE_WAIT_TIME));
         }
-        getDuration();
     }
-    // finish时profileDataQueue不会有其他线程访问
-    flush();
-    getDuration();
 }
 
 bool ProfileDataHandler::Init()
 {
     finish_ = false;
-    Profiler::CallBackFunc callback = [&](std::vector<char> &&data) {
-        {
-            std::lock_guard<decltype(mtx_)> lock(mtx_);
-            profileDataQueue_.emplace(std::move(data));
-        }
-        profileDataCV_.notify_all();
-    };
-    profiler_.RegisterCallback(callback);
+    profiler_.RegisterQueue(&profileDataQueue_);
     if (!profiler_.Start()) {
         LOGE("Start profiling failed");
+        finish_ = true;
         return false;
     }
     profileDataThread_ = std::thread([this]() { ProfileDataThread(); });
@@ -335,38 +262,37 @@ void ProfileDataHandler::Synchronize()
     // 等待所有数据获取更新完成
     constexpr int SLEEP_TIME = 100;
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME));
+    // read thread已退出，不会再有数据入队
     profiler_.Stop();
-    finish_ = true;
-    profileDataCV_.notify_all();
+    finish_.store(true, std::memory_order_release);
     if (profileDataThread_.joinable()) {
         profileDataThread_.join();
     }
 }
 
-std::pair<int64_t, int32_t> ProfileDataHandler::GetAicoreFreq()
+bool ProfileDataHandler::WaitDurations(std::vector<double> &durations, size_t num, std::chrono::milliseconds timeout)
 {
-    constexpr int32_t MODULE_TYPE_AICORE = 4;
-    constexpr int32_t INFO_TYPE_FREQUE = 4;
-    constexpr int32_t INFO_TYPE_CURRENT_FREQ = 32;
-    static int64_t aicoreFreq = 0;
-    if (aicoreFreq == 0) {
-        // get rated freq
-        auto ret = halGetDeviceInfo(deviceId_, MODULE_TYPE_AICORE, INFO_TYPE_FREQUE, &aicoreFreq);
-        if (ret != 0) {
-            LOGW("Get device rated freq failed, ret %d", ret);
-            aicoreFreq = 0;
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto tmp = GetDurations();
+        durations.insert(durations.end(), tmp.begin(), tmp.end());
+        if (durations.size() >= num) {
+            return true;
+        }
+        if (finish_ || std::chrono::steady_clock::now() > deadline) {
+            return false;
         }
+        constexpr int IDLE_WAIT_TIME = 200;
+        std::this_thread::sleep_for(std::chrono::microseconds(IDLE_WAIT_TIME));
     }
-    // get current freq
-    int32_t curFreq;
-    int32_t size = sizeof(int32_t);
-    auto ret = halGetDeviceInfoByBuff(deviceId_, MODULE_TYPE_AICORE, INFO_TYPE_CURRENT_FREQ,
-                                      static_cast<void*>(&curFreq), &size);
-    if (ret != 0) {
-        LOGW("Get device current freq failed, ret %d", ret);
-        curFreq = 0;
+}
+
+std::pair<int64_t, int32_t> ProfileDataHandler::GetAicoreFreq()
+{
+    if (channel_ == nullptr) {
+        return {0, 0};
     }
-    return {aicoreFreq, curFreq};
+    return channel_->GetAicoreFreq(deviceId_);
 }
 
 int64_t ProfileDataHandler::GetAicpuFreq()
@@ -375,29 +301,19 @@ int64_t ProfileDataHandler::GetAicpuFreq()
         return freq_;
     }
     constexpr int64_t DEFAULT_TSCPU_FREQ = 50000;
-    constexpr int32_t MODULE_TYPE_SYSTEM = 0;
-    constexpr int32_t INFO_TYPE_DEV_OSC_FREQUE = 25;
-    int ret = halGetDeviceInfo(0, MODULE_TYPE_SYSTEM, INFO_TYPE_DEV_OSC_FREQUE, &freq_);
-    if (ret != 0 || freq_ == 0) {
+    freq_ = channel_ != nullptr ? channel_->GetAicpuFreq(deviceId_) : 0;
+    if (freq_ == 0) {
         LOGW("Get device freq failed, use default freq");
         freq_ = DEFAULT_TSCPU_FREQ;
-        return freq_;
     }
     return freq_;
 }
 
 bool ProfileDataHandler::SetDeviceId(int32_t deviceId)
 {
-    constexpr char const *VIS = "ASCEND_RT_VISIBLE_DEVICES";
     int32_t convertedId = deviceId;
-    auto env = getenv(VIS);
-    if (env) {
-        auto error = rtGetVisibleDeviceIdByLogicDeviceId(deviceId, &convertedId);
-        if (error != RT_ERROR_NONE) {
-            LOGE("Call rtGetVisibleDeviceIdByLogicDeviceId failed, error: %d. Please disable %s or try again.",
-                 error, VIS);
-            return false;
-        }
+    if (channel_ != nullptr && !channel_->GetChannelDeviceId(deviceId, convertedId)) {
+        return false;
     }
     deviceId_ = convertedId;
     profiler_.SetDeviceId(convertedId);
@@ -0,0 +1,113 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include "sampling.h"
+
+#include <algorithm>
+#include <cmath>
+#include "log.h"
+
+namespace Catlass {
+
+namespace {
+// two-sided 95% quantiles of the student t distribution, by degrees of freedom from 1
+constexpr double T_95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+constexpr double Z_95 = 1.960;
+constexpr double OUTLIER_MADS = 3;
+// MAD of a normal distribution times it is the standard deviation
+constexpr double MAD_SCALE = 1.4826;
+// durations are measured in ticks of the profile records, samples this close to the median are never outliers
+constexpr double MIN_OUTLIER_DISTANCE = 1e-3;
+
+// linear interpolation between the closest ranks of sorted values
+double Percentile(const std::vector<double> &sorted, double p)
+{
+    double rank = p * static_cast<double>(sorted.size() - 1);
+    auto lo = static_cast<size_t>(rank);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - static_cast<double>(lo));
+}
+}
+
+bool SamplingPolicy::Parse(CommandLineParser &parser)
+{
+    if (parser.HasKey("min_runs")) {
+        GET_CHECK(parser.Get<uint32_t>("min_runs", minRuns), "min_runs");
+    }
+    if (parser.HasKey("max_runs")) {
+        GET_CHECK(parser.Get<uint32_t>("max_runs", maxRuns), "max_runs");
+    }
+    if (parser.HasKey("ci")) {
+        GET_CHECK(parser.Get<double>("ci", ci), "ci");
+    }
+    if (parser.HasKey("early_stop")) {
+        GET_CHECK(parser.Get<bool>("early_stop", earlyStop), "early_stop");
+    }
+    if (minRuns == 0 || maxRuns < minRuns) {
+        LOGE("--min_runs should be positive and not larger than --max_runs, got %u and %u", minRuns, maxRuns);
+        return false;
+    }
+    if (ci < 0) {
+        LOGE("--ci should not be negative");
+        return false;
+    }
+    return true;
+}
+
+SampleStats SampleStats::Summarize(std::vector<double> samples)
+{
+    SampleStats stats;
+    stats.runs = static_cast<uint32_t>(samples.size());
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    double median = Percentile(samples, 0.5);
+    std::vector<double> deviations;
+    for (auto s : samples) {
+        deviations.emplace_back(std::fabs(s - median));
+    }
+    std::sort(deviations.begin(), deviations.end());
+    double limit = std::max(OUTLIER_MADS * MAD_SCALE * Percentile(deviations, 0.5), median * MIN_OUTLIER_DISTANCE);
+    auto kept = std::remove_if(samples.begin(), samples.end(), [&](double s) {
+        return std::fabs(s - median) > limit;
+    });
+    stats.outliers = static_cast<uint32_t>(samples.end() - kept);
+    samples.erase(kept, samples.end());
+
+    size_t n = samples.size();
+    stats.median = Percentile(samples, 0.5);
+    stats.p10 = Percentile(samples, 0.1);
+    stats.p90 = Percentile(samples, 0.9);
+    double sum = 0;
+    for (auto s : samples) {
+        sum += s;
+    }
+    stats.mean = sum / static_cast<double>(n);
+    if (n < 2) {
+        // a single run tells nothing of its spread
+        stats.ciHalf = stats.mean;
+        return stats;
+    }
+    double sq = 0;
+    for (auto s : samples) {
+        sq += (s - stats.mean) * (s - stats.mean);
+    }
+    stats.stddev = std::sqrt(sq / static_cast<double>(n - 1));
+    double t = n - 1 <= std::size(T_95) ? T_95[n - 2] : Z_95;
+    stats.ciHalf = t * stats.stddev / std::sqrt(static_cast<double>(n));
+    return stats;
+}
+
+} // namespace Catlass
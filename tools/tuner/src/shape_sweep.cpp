@@ -0,0 +1,310 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include "shape_sweep.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include "log.h"
+
+namespace Catlass {
+
+namespace {
+// the cover set stops growing once its weighted slowdown to the best operation of every shape is within it
+constexpr double COVER_TOLERANCE = 0.02;
+constexpr size_t PREC = 3;
+
+using ShapeKey = std::tuple<uint32_t, uint32_t, uint32_t>;
+
+std::string_view Trim(std::string_view sv)
+{
+    auto l = sv.find_first_not_of(" \t\r");
+    if (l == std::string_view::npos) {
+        return {};
+    }
+    auto r = sv.find_last_not_of(" \t\r");
+    return sv.substr(l, r - l + 1);
+}
+
+bool ParseDim(std::string_view sv, uint32_t &value)
+{
+    std::string str(sv);
+    if (str.empty() || str[0] == '-') {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long v = std::strtoull(str.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || v == 0 || v > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    value = static_cast<uint32_t>(v);
+    return true;
+}
+
+bool ParseWeight(std::string_view sv, double &value)
+{
+    std::string str(sv);
+    if (str.empty()) {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    value = std::strtod(str.c_str(), &end);
+    return errno == 0 && *end == '\0' && std::isfinite(value) && value > 0;
+}
+
+// elements of A, B and C, the device buffers of a problem grow with it
+double ProblemSize(const SweepShape &s)
+{
+    double m = s.m;
+    double n = s.n;
+    double k = s.k;
+    return m * k + k * n + m * n;
+}
+
+std::string Fixed(double value)
+{
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(PREC) << value;
+    return ss.str();
+}
+
+struct Ranking {
+    std::string description;
+    std::vector<double> durations;    // by shape, 0 if the operation did not run on it
+    double coverage{0};               // weight of the shapes it ran on, of the total weight
+    double slowdown{0};               // weighted mean of its duration over the best one, on the shapes it ran on
+    double duration{0};               // weighted mean duration on the shapes it ran on
+    size_t bestNum{0};
+    size_t coverOrder{0};             // 1-based position in the cover set, 0 if not in it
+};
+}
+
+bool ShapeSweep::Load(std::string_view path)
+{
+    std::ifstream file{std::string(path)};
+    if (!file.is_open()) {
+        LOGE("Open shape file %s failed", path.data());
+        return false;
+    }
+    std::map<ShapeKey, double> weights;
+    size_t lineNo = 0;
+    for (std::string line; std::getline(file, line);) {
+        ++lineNo;
+        std::string_view sv = Trim(line);
+        if (sv.empty() || sv.front() == '#') {
+            continue;
+        }
+        std::vector<std::string_view> cells;
+        for (size_t pos = 0;;) {
+            auto sep = sv.find(',', pos);
+            cells.emplace_back(Trim(sv.substr(pos, sep == std::string_view::npos ? sv.npos : sep - pos)));
+            if (sep == std::string_view::npos) {
+                break;
+            }
+            pos = sep + 1;
+        }
+        // an optional header such as m,n,k,weight
+        if (weights.empty() && !cells.empty() && (cells[0] == "m" || cells[0] == "M")) {
+            continue;
+        }
+        SweepShape shape{0, 0, 0, 1};
+        constexpr size_t DIMS = 3;
+        if ((cells.size() != DIMS && cells.size() != DIMS + 1) || !ParseDim(cells[0], shape.m) ||
+            !ParseDim(cells[1], shape.n) || !ParseDim(cells[2], shape.k) ||
+            (cells.size() > DIMS && !ParseWeight(cells[DIMS], shape.weight))) {
+            LOGE("Line %lu of %s should be m,n,k or m,n,k,weight with positive values: %s",
+                 lineNo, path.data(), line.c_str());
+            return false;
+        }
+        // a shape listed twice is tuned once with both weights
+        weights[{shape.m, shape.n, shape.k}] += shape.weight;
+    }
+    if (weights.empty()) {
+        LOGE("No shape in %s", path.data());
+        return false;
+    }
+    shapes_.clear();
+    for (auto &[key, weight] : weights) {
+        shapes_.push_back({std::get<0>(key), std::get<1>(key), std::get<2>(key), weight});
+    }
+    std::stable_sort(shapes_.begin(), shapes_.end(), [](const SweepShape &a, const SweepShape &b) {
+        return ProblemSize(a) > ProblemSize(b);
+    });
+    LOGI("Load %lu shapes from %s", shapes_.size(), path.data());
+    return true;
+}
+
+void ShapeSweep::Report(const Metrics &metrics) const
+{
+    size_t shapeNum = shapes_.size();
+    std::map<ShapeKey, size_t> shapeIds;
+    double totalWeight = 0;
+    for (size_t s = 0; s < shapeNum; ++s) {
+        shapeIds[{shapes_[s].m, shapes_[s].n, shapes_[s].k}] = s;
+        totalWeight += shapes_[s].weight;
+    }
+
+    // the duration of every operation on every shape
+    std::map<std::string, Ranking> rankings;
+    for (auto &metric : metrics.GetMetrics()) {
+        double duration = metric.GetTaskDuration();
+        uint32_t m = 0;
+        uint32_t n = 0;
+        uint32_t k = 0;
+        if (duration <= 0 || !ParseDim(metric.Field(ClassicMetric::M), m) ||
+            !ParseDim(metric.Field(ClassicMetric::N), n) || !ParseDim(metric.Field(ClassicMetric::K), k)) {
+            continue;
+        }
+        auto it = shapeIds.find({m, n, k});
+        if (it == shapeIds.end()) {
+            continue;
+        }
+        auto &description = metric.Field(ClassicMetric::DESCRIPTION);
+        auto &ranking = rankings[description];
+        if (ranking.durations.empty()) {
+            ranking.description = description;
+            ranking.durations.resize(shapeNum, 0);
+        }
+        double &d = ranking.durations[it->second];
+        d = d > 0 ? std::min(d, duration) : duration;
+    }
+
+    std::vector<double> best(shapeNum, 0);
+    std::vector<const Ranking*> bestOps(shapeNum, nullptr);
+    for (auto &[description, ranking] : rankings) {
+        for (size_t s = 0; s < shapeNum; ++s) {
+            double d = ranking.durations[s];
+            if (d > 0 && (best[s] == 0 || d < best[s])) {
+                best[s] = d;
+                bestOps[s] = &ranking;
+            }
+        }
+    }
+    for (auto &[description, ranking] : rankings) {
+        double weight = 0;
+        double slowdown = 0;
+        double duration = 0;
+        for (size_t s = 0; s < shapeNum; ++s) {
+            double d = ranking.durations[s];
+            if (d <= 0) {
+                continue;
+            }
+            weight += shapes_[s].weight;
+            slowdown += shapes_[s].weight * d / best[s];
+            duration += shapes_[s].weight * d;
+            ranking.bestNum += bestOps[s] == &ranking ? 1 : 0;
+        }
+        ranking.coverage = weight / totalWeight;
+        ranking.slowdown = slowdown / weight;
+        ranking.duration = duration / weight;
+    }
+
+    // Greedy cover: every step adds the operation that lowers the uncovered weight most, then the weighted slowdown
+    // of the set, where a shape runs the fastest operation of the set that ran on it.
+    std::vector<double> current(shapeNum, 0);
+    std::vector<Ranking*> cover;
+    double coverSlowdown = 0;
+    double uncovered = totalWeight;
+    auto evaluate = [&](const Ranking *candidate, double &slowdown, double &left) {
+        slowdown = 0;
+        left = 0;
+        for (size_t s = 0; s < shapeNum; ++s) {
+            double d = current[s];
+            if (double c = candidate ? candidate->durations[s] : 0; c > 0 && (d == 0 || c < d)) {
+                d = c;
+            }
+            if (d > 0) {
+                slowdown += shapes_[s].weight * d / best[s];
+            } else {
+                left += shapes_[s].weight;
+            }
+        }
+        slowdown = totalWeight > left ? slowdown / (totalWeight - left) : 0;
+    };
+    while (uncovered > 0 || coverSlowdown > 1 + COVER_TOLERANCE) {
+        Ranking *next = nullptr;
+        double nextSlowdown = coverSlowdown;
+        double nextUncovered = uncovered;
+        for (auto &[description, ranking] : rankings) {
+            if (ranking.coverOrder > 0) {
+                continue;
+            }
+            double slowdown;
+            double left;
+            evaluate(&ranking, slowdown, left);
+            if (left < nextUncovered || (left == nextUncovered && slowdown < nextSlowdown)) {
+                next = &ranking;
+                nextSlowdown = slowdown;
+                nextUncovered = left;
+            }
+        }
+        if (next == nullptr) {
+            break;
+        }
+        cover.emplace_back(next);
+        next->coverOrder = cover.size();
+        for (size_t s = 0; s < shapeNum; ++s) {
+            if (double c = next->durations[s]; c > 0 && (current[s] == 0 || c < current[s])) {
+                current[s] = c;
+            }
+        }
+        coverSlowdown = nextSlowdown;
+        uncovered = nextUncovered;
+    }
+
+    std::vector<std::string> shapeRows;
+    LOGM("Best operation of %lu shapes:", shapeNum);
+    for (size_t s = 0; s < shapeNum; ++s) {
+        auto &shape = shapes_[s];
+        std::string description = bestOps[s] ? bestOps[s]->description : "";
+        std::stringstream ss;
+        ss << shape.m << "," << shape.n << "," << shape.k << "," << shape.weight << "," << Fixed(best[s]) << ","
+           << description;
+        shapeRows.emplace_back(ss.str());
+        LOGM("m=%u, n=%u, k=%u, weight=%g, task_duration=%.3fus, %s", shape.m, shape.n, shape.k, shape.weight,
+             best[s], bestOps[s] ? description.c_str() : "no operation ran");
+    }
+    LOGM("%lu operations cover %.1f%% of the weight within %.3fx of the best of each shape:", cover.size(),
+         (totalWeight - uncovered) / totalWeight * 100, coverSlowdown);
+    for (auto *ranking : cover) {
+        LOGM("%s", ranking->description.c_str());
+    }
+
+    std::vector<const Ranking*> sorted;
+    for (auto &[description, ranking] : rankings) {
+        sorted.emplace_back(&ranking);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Ranking *a, const Ranking *b) {
+        return a->coverage != b->coverage ? a->coverage > b->coverage : a->slowdown < b->slowdown;
+    });
+    std::vector<std::string> rankingRows;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        auto *r = sorted[i];
+        std::stringstream ss;
+        ss << i + 1 << "," << r->description << "," << Fixed(r->coverage) << "," << Fixed(r->slowdown) << ","
+           << Fixed(r->duration) << "," << r->bestNum << "," << r->coverOrder;
+        rankingRows.emplace_back(ss.str());
+    }
+    metrics.DumpTable("_shapes", "m,n,k,weight,task_duration(us),description", shapeRows);
+    metrics.DumpTable("_ranking", "rank,description,coverage,weighted_slowdown,weighted_duration(us),best_shapes,"
+                      "cover_order", rankingRows);
+}
+
+} // namespace Catlass
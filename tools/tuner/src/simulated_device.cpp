@@ -0,0 +1,348 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include "simulated_device.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include "library_helper.h"
+#include "log.h"
+
+namespace Catlass {
+
+namespace {
+constexpr uint64_t MB = 1024 * 1024;
+
+const SimulatedDeviceSpec SPECS[] = {
+    {"Ascend910B1", 24, 1800, 1600, 192 * MB},
+    {"Ascend910B2", 24, 1800, 1600, 192 * MB},
+    {"Ascend910B2C", 24, 1800, 1600, 192 * MB},
+    {"Ascend910B3", 20, 1800, 1600, 192 * MB},
+    {"Ascend910B4", 20, 1650, 800, 96 * MB},
+    {"Ascend910B4-1", 20, 1650, 1600, 192 * MB},
+};
+
+constexpr uintptr_t BASE_ADDR = 0x100000000000;
+constexpr uintptr_t ADDR_ALIGN = 512;
+constexpr uint64_t TASK_GAP = 50;           // ticks between two tasks of the stream
+constexpr double LAUNCH_US = 3;             // head of a task, scheduling of the blocks on the cores
+constexpr uint32_t FRACTAL = 16;            // a cube cycle is a 16 x 16 x (32 bytes) fractal
+constexpr uint32_t FRACTAL_BYTES = 32;
+constexpr double L0_ITER_CYCLES = 32;       // switch of the L0 buffers
+constexpr double TILE_CYCLES = 200;         // head of an L1 tile, the first load and the store of C
+constexpr double CORE_LOAD_BYTES = 128;     // bytes per cycle a core loads into L1
+
+template <class T>
+inline T CeilDiv(T a, T b)
+{
+    return (a + b - 1) / b;
+}
+}
+
+SimulatedDevice::SimulatedDevice(const SimulatedDeviceSpec &spec, double noise, uint32_t seed, double scale)
+    : spec_(spec), channel_(spec_), nextAddr_(BASE_ADDR), rng_(seed), noise_(std::max(noise, 0.0)), scale_(scale)
+{
+}
+
+bool SimulatedDevice::GetSpec(std::string_view socName, SimulatedDeviceSpec &spec)
+{
+    for (auto &s : SPECS) {
+        if (s.socName == socName) {
+            spec = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<SimulatedDevice> SimulatedDevice::Create(CommandLineParser &parser, int32_t deviceId)
+{
+    std::string_view soc;
+    GET_CHECK(parser.Get<std::string_view>("simulate", soc), "simulate");
+    SimulatedDeviceSpec spec;
+    if (!GetSpec(soc, spec)) {
+        std::string socs;
+        for (auto &s : SPECS) {
+            socs += " " + s.socName;
+        }
+        LOGE("Soc %s can not be simulated, supported socs:%s", std::string(soc).c_str(), socs.c_str());
+        return nullptr;
+    }
+    double noise = 0;
+    if (parser.HasKey("simulate_noise")) {
+        GET_CHECK(parser.Get<double>("simulate_noise", noise), "simulate_noise");
+        if (noise < 0) {
+            LOGW("--simulate_noise should not be negative, use 0");
+            noise = 0;
+        }
+    }
+    double skew = 0;
+    if (parser.HasKey("simulate_skew")) {
+        GET_CHECK(parser.Get<double>("simulate_skew", skew), "simulate_skew");
+    }
+    double scale = 1 + skew * deviceId;
+    if (scale <= 0) {
+        LOGE("Device %d would run in no time with --simulate_skew=%.3f", deviceId, skew);
+        return nullptr;
+    }
+    LOGI("Simulate %s as device %d, %u AI cores at %u MHz, %.0f GB/s, noise %.3f, %.3fx the modelled durations",
+        spec.socName.c_str(), deviceId, spec.aicCoreNum, spec.aicoreFreq, spec.hbmBandwidth, noise, scale);
+    // devices draw different noise
+    return std::make_shared<SimulatedDevice>(spec, noise, static_cast<uint32_t>(deviceId), scale);
+}
+
+double SimulatedDevice::EstimateDuration(const Library::OperationDescription &desp, const void *config) const
+{
+    if (desp.kind != Library::OperationKind::Gemm || config == nullptr) {
+        return 0;
+    }
+    auto &mDesp = static_cast<const Library::GemmOperationDescription &>(desp);
+    switch (mDesp.gemmKind) {
+        case Library::GemmKind::BasicMatmul: {
+            auto c = static_cast<const Library::BasicMatmulGemmConfiguration *>(config);
+            return EstimateGemm(mDesp, c->m, c->n, c->k, 1);
+        }
+        case Library::GemmKind::GroupedMatmul: {
+            auto c = static_cast<const Library::GroupedMatmulGemmConfiguration *>(config);
+            return EstimateGemm(mDesp, c->m, c->n, c->k, std::max(c->groupCount, 1U));
+        }
+        default:
+            return 0;
+    }
+}
+
+// Every L1 tile is computed by one core, the cores run in waves. A wave takes the longer of the cube time of a
+// tile and the time HBM needs for the bytes of the wave; the blocks of a wave that the swizzle keeps on the same
+// rows of A or columns of B share them in L2.
+double SimulatedDevice::EstimateGemm(const Library::GemmOperationDescription &desp, uint64_t m, uint64_t n,
+                                     uint64_t k, uint64_t groupCount) const
+{
+    auto &tile = desp.tileDescription;
+    uint64_t l1M = tile.L1TileShape.m;
+    uint64_t l1N = tile.L1TileShape.n;
+    uint64_t l1K = tile.L1TileShape.k;
+    uint64_t l0M = tile.L0TileShape.m;
+    uint64_t l0N = tile.L0TileShape.n;
+    uint64_t l0K = tile.L0TileShape.k;
+    double sizeA = LibraryHelper::GetDataTypeSize(desp.A.element);
+    double sizeB = LibraryHelper::GetDataTypeSize(desp.B.element);
+    double sizeC = LibraryHelper::GetDataTypeSize(desp.C.element);
+    if (l1M == 0 || l1N == 0 || l1K == 0 || l0M == 0 || l0N == 0 || l0K == 0 || sizeA == 0 || sizeB == 0 ||
+        sizeC == 0 || m == 0 || n == 0 || k == 0 || spec_.aicCoreNum == 0) {
+        return 0;
+    }
+    // the groups split k, every group is a full m x n problem
+    uint64_t kPer = CeilDiv(k, groupCount);
+    uint64_t mTiles = CeilDiv(m, l1M);
+    uint64_t nTiles = CeilDiv(n, l1N);
+    uint64_t tiles = groupCount * mTiles * nTiles;
+
+    uint64_t k0 = std::max<uint64_t>(FRACTAL_BYTES / static_cast<uint64_t>(sizeA), 1);
+    double mmadCycles = static_cast<double>(CeilDiv(l1M, uint64_t{FRACTAL}) * CeilDiv(l1N, uint64_t{FRACTAL}) *
+        CeilDiv(kPer, k0));
+    double l0Cycles = static_cast<double>(CeilDiv(l1M, l0M) * CeilDiv(l1N, l0N) * CeilDiv(kPer, l0K)) *
+        L0_ITER_CYCLES;
+    double tileBytesA = static_cast<double>(l1M * kPer) * sizeA;
+    double tileBytesB = static_cast<double>(l1N * kPer) * sizeB;
+    double tileBytesC = static_cast<double>(l1M * l1N) * sizeC;
+    double loadCycles = (tileBytesA + tileBytesB) / CORE_LOAD_BYTES;
+    double tileUs = (std::max(mmadCycles + l0Cycles, loadCycles) + TILE_CYCLES) / spec_.aicoreFreq;
+
+    uint64_t offset = std::max<uint64_t>(tile.blockSwizzle.offset, 1);
+    bool alongN = tile.blockSwizzle.direction == 0;
+    double bytesPerUs = spec_.hbmBandwidth * 1000;
+    auto waveUs = [&](uint64_t blocks) {
+        // direction 0 walks n inside a band of offset rows of tiles, direction 1 walks m inside a band of columns
+        uint64_t bandTiles = alongN ? mTiles : nTiles;
+        uint64_t crossTiles = alongN ? nTiles : mTiles;
+        uint64_t band = std::min({offset, bandTiles, blocks});
+        uint64_t cross = std::min(crossTiles, CeilDiv(blocks, band));
+        uint64_t distinctM = alongN ? band : cross;
+        uint64_t distinctN = alongN ? cross : band;
+        double uniqueBytes = distinctM * tileBytesA + distinctN * tileBytesB;
+        double naiveBytes = blocks * (tileBytesA + tileBytesB);
+        double readBytes = uniqueBytes <= spec_.l2Size / 2.0 ? uniqueBytes : naiveBytes;
+        double hbmUs = (readBytes + blocks * tileBytesC) / bytesPerUs;
+        return std::max(tileUs, hbmUs);
+    };
+    uint64_t fullWaves = tiles / spec_.aicCoreNum;
+    uint64_t tailBlocks = tiles % spec_.aicCoreNum;
+    double duration = LAUNCH_US + fullWaves * waveUs(spec_.aicCoreNum);
+    if (tailBlocks > 0) {
+        duration += waveUs(tailBlocks);
+    }
+    return duration;
+}
+
+aclrtStream SimulatedDevice::Initialize(int32_t deviceId)
+{
+    (void)deviceId;
+    // never dereferenced, only checked against nullptr and handed back
+    return static_cast<aclrtStream>(this);
+}
+
+void SimulatedDevice::Finalize(aclrtStream stream, int32_t deviceId)
+{
+    (void)stream;
+    LOGI("Simulated device %d ran %lu tasks, %.3f ms of device time, peak memory %.3f MB in %lu allocations, "
+        "%lu buffers leaked", deviceId, taskNum_, GetDeviceTime() / 1000, static_cast<double>(peakMemorySize_) / MB,
+        mallocNum_, allocations_.size());
+}
+
+aclError SimulatedDevice::Malloc(void **addr, size_t size)
+{
+    if (addr == nullptr || size == 0) {
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    uintptr_t base = nextAddr_;
+    nextAddr_ += CeilDiv(static_cast<uintptr_t>(size), ADDR_ALIGN) * ADDR_ALIGN;
+    allocations_.emplace(base, size);
+    ++mallocNum_;
+    memorySize_ += size;
+    peakMemorySize_ = std::max(peakMemorySize_, memorySize_);
+    *addr = reinterpret_cast<void *>(base);
+    return ACL_SUCCESS;
+}
+
+aclError SimulatedDevice::Free(void *addr)
+{
+    auto it = allocations_.find(reinterpret_cast<uintptr_t>(addr));
+    if (it == allocations_.end()) {
+        LOGE("Free address %p which is not allocated by the simulated device", addr);
+        return ACL_ERROR_INVALID_PARAM;
+    }
+    memorySize_ -= it->second;
+    allocations_.erase(it);
+    return ACL_SUCCESS;
+}
+
+aclError SimulatedDevice::MemcpyAsync(void *dst, const void *src, size_t size, aclrtMemcpyKind kind,
+                                      aclrtStream stream)
+{
+    (void)dst, (void)src, (void)size, (void)kind, (void)stream;
+    return ACL_SUCCESS;
+}
+
+aclError SimulatedDevice::Prefetch(void *addr, size_t size, aclrtStream stream)
+{
+    (void)addr, (void)size, (void)stream;
+    return ACL_SUCCESS;
+}
+
+aclError SimulatedDevice::Synchronize(aclrtStream stream, int32_t timeout)
+{
+    (void)stream, (void)timeout;
+    return ACL_SUCCESS;
+}
+
+void SimulatedDevice::LaunchCacheClear(uint32_t blockDim, aclrtStream stream, void *buffer, void *tilingSize)
+{
+    (void)blockDim, (void)stream, (void)buffer, (void)tilingSize;
+    // the whole L2 is written back once
+    RunTask(LAUNCH_US + spec_.l2Size / (spec_.hbmBandwidth * 1000));
+}
+
+Status SimulatedDevice::Launch(Library::Operation *op, void *config, aclrtStream stream, uint32_t blockDim,
+                               uint64_t fftsAddr)
+{
+    (void)stream, (void)blockDim, (void)fftsAddr;
+    double duration = EstimateDuration(op->GetDescription(), config);
+    if (duration <= 0) {
+        LOGW("Operation %s is not modelled by the simulated device", op->GetDescription().name);
+        duration = LAUNCH_US;
+    }
+    if (noise_ > 0) {
+        constexpr double MIN_SCALE = 0.5;
+        std::normal_distribution<double> normal(0, 1);
+        duration *= std::max(MIN_SCALE, 1 + noise_ * normal(rng_));
+    }
+    RunTask(duration);
+    return Status::kSuccess;
+}
+
+void SimulatedDevice::RunTask(double duration)
+{
+    auto ticks = static_cast<uint64_t>(std::llround(duration * scale_ * AICPU_FREQ / 1000));
+    channel_.PushTask(clock_, clock_ + ticks);
+    clock_ += ticks + TASK_GAP;
+    ++taskNum_;
+}
+
+void SimulatedDevice::Channel::PushTask(uint64_t start, uint64_t end)
+{
+    constexpr uint16_t FUNC_TYPE_END = 1;
+    constexpr size_t SYSTEM_TIME_OFFSET = 8;
+    char record[2][Profiler::RECORD_SIZE]{};
+    uint16_t head[2][4] = {{0, 0, 0, taskId_}, {FUNC_TYPE_END, 0, 0, taskId_}};
+    uint64_t time[2] = {start, end};
+    for (int i = 0; i < 2; ++i) {
+        std::memcpy(record[i], head[i], sizeof(head[i]));
+        std::memcpy(record[i] + SYSTEM_TIME_OFFSET, &time[i], sizeof(time[i]));
+    }
+    ++taskId_;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        // like the driver, tasks are only recorded while the channel is started
+        if (!running_) {
+            return;
+        }
+        records_.insert(records_.end(), record[0], record[0] + sizeof(record));
+    }
+    cv_.notify_all();
+}
+
+bool SimulatedDevice::Channel::Start(int32_t deviceId)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    deviceId_ = deviceId;
+    records_.clear();
+    readPos_ = 0;
+    running_ = true;
+    return true;
+}
+
+void SimulatedDevice::Channel::Stop(int32_t deviceId)
+{
+    (void)deviceId;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        running_ = false;
+    }
+    cv_.notify_all();
+}
+
+int SimulatedDevice::Channel::Poll(ProfileChannelInfo *channels, int num, int timeout)
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait_for(lock, std::chrono::seconds(timeout), [this]() { return readPos_ < records_.size() || !running_; });
+    if (num <= 0 || readPos_ >= records_.size()) {
+        return 0;
+    }
+    channels[0] = {static_cast<uint32_t>(deviceId_), 0};
+    return 1;
+}
+
+int SimulatedDevice::Channel::Read(const ProfileChannelInfo &channel, char *outBuf, uint32_t bufSize)
+{
+    (void)channel;
+    std::lock_guard<std::mutex> lock(mtx_);
+    size_t len = std::min<size_t>(bufSize, records_.size() - readPos_);
+    std::copy_n(records_.begin() + readPos_, len, outBuf);
+    readPos_ += len;
+    if (readPos_ == records_.size()) {
+        records_.clear();
+        readPos_ = 0;
+    }
+    return static_cast<int>(len);
+}
+
+} // namespace Catlass
@@ -0,0 +1,185 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include "tune_worker.h"
+
+#include <algorithm>
+
+namespace Catlass {
+
+// profile records of the kernels of a stream that finished
+static constexpr std::chrono::milliseconds PROFILE_TIMEOUT{1000};
+
+void TuneWorker::Run(TuneSchedule &schedule, size_t worker)
+{
+    DeviceMemoryManager::Bind(&manager_);
+    if (Initialize()) {
+        bool running = true;
+        size_t calibrationNum = schedule.calibration.size();
+        for (size_t i = 0; i < calibrationNum && running; ++i) {
+            // every worker starts at another case, they seldom wait for each other
+            size_t c = (worker + i) % calibrationNum;
+            std::lock_guard<std::mutex> lock(schedule.calibrationLocks[c]);
+            running = RunTask(schedule.tasks[schedule.calibration[c]], schedule.sampling);
+        }
+        // a worker that stops leaves its queued tasks to the others
+        for (size_t i = 0; running && schedule.queue->Pop(worker, i);) {
+            running = RunTask(schedule.tasks[schedule.queued[i]], schedule.sampling);
+        }
+        profileHandler_.Synchronize();
+    }
+    manager_.Finalize();
+    DeviceMemoryManager::Bind(nullptr);
+}
+bool TuneWorker::Initialize()
+{
+    manager_.SetBackend(backend_);
+    profileHandler_.SetChannel(&backend_->GetProfileChannel());
+    metrics_.SetDeviceId(deviceId_);
+    // 调优通道需要做device id映射
+    if (!profileHandler_.SetDeviceId(deviceId_)) {
+        return false;
+    }
+    if (!profileHandler_.Init()) {
+        LOGE("Start profile channel of device %d failed, will not run operators", deviceId_);
+        return false;
+    }
+    if (stream_ = manager_.Initialize(deviceId_); !stream_) {
+        LOGE("Initialize device %d failed, will not run kernels", deviceId_);
+        profileHandler_.Synchronize();
+        return false;
+    }
+    if (!manager_.InitCacheClear()) {
+        LOGW("Init resource for clear l2cache failed, won't clear l2cache before each kernel");
+    }
+    // records of the tuning database are only reused on the same soc
+    if (const char *soc = backend_->GetSocName(); soc != nullptr) {
+        socName_ = soc;
+    }
+    // Get the number of cube cores of the current hardware
+    aicCoreNum_ = backend_->GetAicCoreNum();
+    return true;
+}
+
+bool TuneWorker::RunTask(const TuneTask &task, const SamplingPolicy &policy)
+{
+    auto &problem = problems_[task.opConfig.get()];
+    if (!problem.config) {
+        problem.config = task.opConfig->Clone();
+    }
+    metrics_.Add(problem.config, task.op, task.caseId);
+    SampleStats stats;
+    OpLauncher launcher(problem.config, task.op, aicCoreNum_);
+    auto stat = launcher.Init();
+    if (stat != OpRunStatus::SUCCESS) {
+        LOGE("Initialize operator %s failed", task.op->GetDescription().name);
+    } else {
+        stat = RunOp(launcher, policy, problem.best, stats);
+    }
+    metrics_.SetDurationAndPrint(stats);
+    runNum_ += stats.runs;
+    if (stat == OpRunStatus::SUCCESS && stats.median > 0 && (problem.best == 0 || stats.median < problem.best)) {
+        problem.best = stats.median;
+    }
+    if (stat != OpRunStatus::FATAL) {
+        return true;
+    }
+    LOGE("Running kernel %s failed on device %d, try restart profiling", task.op->GetDescription().name, deviceId_);
+    // records left of the failed runs are dropped with the channel
+    profileHandler_.Synchronize();
+    if (!profileHandler_.Init()) {
+        LOGE("Restart profiling failed, end subsequent operator execution on device %d.", deviceId_);
+        return false;
+    }
+    return true;
+}
+
+// Successive halving over the operations of a problem: runs are added in rungs of doubling size, an operation
+// leaves once its duration is known well enough, or once even its lower bound is slower than the best one.
+OpRunStatus TuneWorker::RunOp(OpLauncher &launcher, const SamplingPolicy &policy, double best, SampleStats &stats)
+{
+    if (auto stat = WarmUp(launcher); stat != OpRunStatus::SUCCESS) {
+        return stat;
+    }
+    std::vector<double> samples;
+    for (uint32_t rung = policy.minRuns;; rung = std::min(rung * 2, policy.maxRuns)) {
+        auto stat = Measure(launcher, rung - static_cast<uint32_t>(samples.size()), samples);
+        stats = SampleStats::Summarize(samples);
+        if (stat != OpRunStatus::SUCCESS) {
+            return stat;
+        }
+        if (samples.size() >= policy.maxRuns || stats.ciHalf <= policy.ci * stats.mean) {
+            break;
+        }
+        if (policy.earlyStop && best > 0 && stats.LowerBound() > best) {
+            ++stoppedNum_;
+            break;
+        }
+    }
+    return OpRunStatus::SUCCESS;
+}
+
+OpRunStatus TuneWorker::WarmUp(OpLauncher &launcher)
+{
+    auto freq = profileHandler_.GetAicoreFreq();
+    if (freq.first <= freq.second) {
+        return OpRunStatus::SUCCESS;
+    }
+    LOGW("Current freq %d is lower than rated freq %ld, run warm up", freq.second, freq.first);
+    constexpr int TIMEOUT = 10;
+    for (int i = 0; i < TIMEOUT && freq.first > freq.second; ++i) {
+        constexpr size_t WARM_UP_TIMES = 10;
+        auto stat = launcher(stream_, WARM_UP_TIMES, false);
+        auto err = backend_->Synchronize(stream_, -1);
+        if (stat != OpRunStatus::SUCCESS || err != ACL_SUCCESS) {
+            LOGE("Warm up failed, synchronize stream ret: %d", err);
+            return OpRunStatus::FATAL;
+        }
+        // the records of the warm up runs are not samples
+        std::vector<double> durations;
+        if (!profileHandler_.WaitDurations(durations, WARM_UP_TIMES, PROFILE_TIMEOUT)) {
+            LOGE("Got profile data of %lu of %lu warm up kernels", durations.size(), WARM_UP_TIMES);
+            return OpRunStatus::FATAL;
+        }
+        freq = profileHandler_.GetAicoreFreq();
+    }
+    LOGI("Warm up finished, rated freq %ld, current freq %d", freq.first, freq.second);
+    return OpRunStatus::SUCCESS;
+}
+
+OpRunStatus TuneWorker::Measure(OpLauncher &launcher, uint32_t runs, std::vector<double> &samples)
+{
+    std::vector<KernelType> kernels;
+    for (uint32_t i = 0; i < runs; ++i) {
+        if (manager_.ClearL2Cache(aicCoreNum_)) {
+            kernels.emplace_back(KernelType::CACHE_CLEAR);
+        }
+        // synchronizes the stream after the run
+        if (auto stat = launcher(stream_); stat != OpRunStatus::SUCCESS) {
+            return stat;
+        }
+        kernels.emplace_back(KernelType::OPERATOR);
+    }
+    std::vector<double> durations;
+    if (!profileHandler_.WaitDurations(durations, kernels.size(), PROFILE_TIMEOUT)) {
+        LOGE("Got profile data of %lu of %lu kernels", durations.size(), kernels.size());
+        return OpRunStatus::FATAL;
+    }
+    // records of earlier kernels come first, the last ones are of these runs
+    size_t offset = durations.size() - kernels.size();
+    for (size_t i = 0; i < kernels.size(); ++i) {
+        if (kernels[i] == KernelType::OPERATOR) {
+            samples.emplace_back(durations[offset + i]);
+        }
+    }
+    return OpRunStatus::SUCCESS;
+}
+
+} // namespace Catlass